@@ -0,0 +1,95 @@
+/*
+ * Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cmlibs/zinc/fieldderivatives.hpp>
+#include <cmlibs/zinc/fieldvectoroperators.hpp>
+
+#include "zincbenchmarksetup.hpp"
+
+namespace {
+
+// 3-point Gauss-Legendre locations on [0, 1]
+const double gaussXi[3] = { 0.1127016653792583, 0.5, 0.8872983346207417 };
+
+void evaluateAtNodes(benchmark::State& state, ZincBenchmarkCubeModel& model, const Field& field)
+{
+	const int componentsCount = field.getNumberOfComponents();
+	std::vector<double> values(componentsCount);
+	Fieldcache fieldcache = model.fm.createFieldcache();
+	for (auto _ : state)
+	{
+		Nodeiterator nodeiterator = model.nodes.createNodeiterator();
+		Node node;
+		while ((node = nodeiterator.next()).isValid())
+		{
+			fieldcache.setNode(node);
+			field.evaluateReal(fieldcache, componentsCount, values.data());
+			benchmark::DoNotOptimize(values.data());
+		}
+	}
+	state.SetItemsProcessed(state.iterations()*model.getNodesCount());
+	model.setBenchmarkCounters(state);
+}
+
+void evaluateAtGaussPoints(benchmark::State& state, ZincBenchmarkCubeModel& model, const Field& field)
+{
+	const int componentsCount = field.getNumberOfComponents();
+	std::vector<double> values(componentsCount);
+	Fieldcache fieldcache = model.fm.createFieldcache();
+	for (auto _ : state)
+	{
+		Elementiterator elementiterator = model.mesh3d.createElementiterator();
+		Element element;
+		while ((element = elementiterator.next()).isValid())
+		{
+			for (int k = 0; k < 3; ++k)
+				for (int j = 0; j < 3; ++j)
+					for (int i = 0; i < 3; ++i)
+					{
+						const double xi[3] = { gaussXi[i], gaussXi[j], gaussXi[k] };
+						fieldcache.setMeshLocation(element, 3, xi);
+						field.evaluateReal(fieldcache, componentsCount, values.data());
+						benchmark::DoNotOptimize(values.data());
+					}
+		}
+	}
+	state.SetItemsProcessed(state.iterations()*model.getElementsCount()*27);
+	model.setBenchmarkCounters(state);
+}
+
+}
+
+static void BM_FieldEvaluateNodes(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	evaluateAtNodes(state, model, model.coordinates);
+}
+BENCHMARK(BM_FieldEvaluateNodes)->Apply(cubeMeshArguments);
+
+static void BM_FieldEvaluateNodesMagnitude(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	FieldMagnitude magnitude = model.fm.createFieldMagnitude(model.coordinates);
+	evaluateAtNodes(state, model, magnitude);
+}
+BENCHMARK(BM_FieldEvaluateNodesMagnitude)->Apply(cubeMeshArguments);
+
+static void BM_FieldEvaluateGaussPoints(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	evaluateAtGaussPoints(state, model, model.coordinates);
+}
+BENCHMARK(BM_FieldEvaluateGaussPoints)->Apply(cubeMeshArguments);
+
+static void BM_FieldEvaluateGaussPointsGradient(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	FieldGradient gradient = model.fm.createFieldGradient(model.coordinates, model.coordinates);
+	evaluateAtGaussPoints(state, model, gradient);
+}
+BENCHMARK(BM_FieldEvaluateGaussPointsGradient)->Apply(smallCubeMeshArguments);
@@ -0,0 +1,87 @@
+/*
+ * Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include "zincbenchmarksetup.hpp"
+
+namespace {
+
+const int dataPointsCountPerAxis = 10;
+
+/**
+ * Add data points with "data_coordinates" on a regular grid scaled about the
+ * centre of the unit cube, so points are outside the mesh if scale > 1.
+ */
+FieldFiniteElement createDataPoints(ZincBenchmarkCubeModel& model, double scale)
+{
+	model.fm.beginChange();
+	FieldFiniteElement dataCoordinates = model.fm.createFieldFiniteElement(3);
+	dataCoordinates.setName("data_coordinates");
+	Nodeset datapoints = model.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_DATAPOINTS);
+	Nodetemplate nodetemplate = datapoints.createNodetemplate();
+	nodetemplate.defineField(dataCoordinates);
+	Fieldcache fieldcache = model.fm.createFieldcache();
+	int identifier = 1;
+	for (int k = 0; k < dataPointsCountPerAxis; ++k)
+		for (int j = 0; j < dataPointsCountPerAxis; ++j)
+			for (int i = 0; i < dataPointsCountPerAxis; ++i)
+			{
+				Node datapoint = datapoints.createNode(identifier++, nodetemplate);
+				fieldcache.setNode(datapoint);
+				// offset so points are not on element boundaries
+				const double x[3] = {
+					0.5 + scale*((i + 0.37)/dataPointsCountPerAxis - 0.5),
+					0.5 + scale*((j + 0.61)/dataPointsCountPerAxis - 0.5),
+					0.5 + scale*((k + 0.19)/dataPointsCountPerAxis - 0.5) };
+				dataCoordinates.assignReal(fieldcache, 3, x);
+			}
+	model.fm.endChange();
+	return dataCoordinates;
+}
+
+void findMeshLocations(benchmark::State& state, FieldFindMeshLocation::SearchMode searchMode, double scale)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	FieldFiniteElement dataCoordinates = createDataPoints(model, scale);
+	FieldFindMeshLocation findMeshLocation = model.fm.createFieldFindMeshLocation(dataCoordinates, model.coordinates, model.mesh3d);
+	findMeshLocation.setSearchMode(searchMode);
+	Nodeset datapoints = model.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_DATAPOINTS);
+	Fieldcache fieldcache = model.fm.createFieldcache();
+	double xi[3];
+	int foundCount = 0;
+	for (auto _ : state)
+	{
+		foundCount = 0;
+		Nodeiterator nodeiterator = datapoints.createNodeiterator();
+		Node datapoint;
+		while ((datapoint = nodeiterator.next()).isValid())
+		{
+			fieldcache.setNode(datapoint);
+			Element element = findMeshLocation.evaluateMeshLocation(fieldcache, 3, xi);
+			if (element.isValid())
+				++foundCount;
+			benchmark::DoNotOptimize(xi);
+		}
+	}
+	state.SetItemsProcessed(state.iterations()*datapoints.getSize());
+	state.counters["found"] = static_cast<double>(foundCount);
+	model.setBenchmarkCounters(state);
+}
+
+}
+
+static void BM_FindMeshLocationExact(benchmark::State& state)
+{
+	findMeshLocations(state, FieldFindMeshLocation::SEARCH_MODE_EXACT, 0.9);
+}
+BENCHMARK(BM_FindMeshLocationExact)->Apply(cubeMeshArguments);
+
+static void BM_FindMeshLocationNearest(benchmark::State& state)
+{
+	findMeshLocations(state, FieldFindMeshLocation::SEARCH_MODE_NEAREST, 1.2);
+}
+BENCHMARK(BM_FindMeshLocationNearest)->Apply(smallCubeMeshArguments);
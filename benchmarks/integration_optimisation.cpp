@@ -0,0 +1,70 @@
+/*
+ * Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cmlibs/zinc/fieldarithmeticoperators.hpp>
+#include <cmlibs/zinc/fieldconstant.hpp>
+#include <cmlibs/zinc/fieldmeshoperators.hpp>
+#include <cmlibs/zinc/optimisation.hpp>
+
+#include "zincbenchmarksetup.hpp"
+
+static void BM_MeshIntegralVolume(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	const double one = 1.0;
+	FieldConstant integrand = model.fm.createFieldConstant(1, &one);
+	FieldMeshIntegral volume = model.fm.createFieldMeshIntegral(integrand, model.coordinates, model.mesh3d);
+	const int pointsCount = 3;
+	volume.setNumbersOfPoints(1, &pointsCount);
+	Fieldcache fieldcache = model.fm.createFieldcache();
+	double volumeValue = 0.0;
+	for (auto _ : state)
+	{
+		// evaluation at same location is cached so clear location each time
+		fieldcache.clearLocation();
+		volume.evaluateReal(fieldcache, 1, &volumeValue);
+		benchmark::DoNotOptimize(volumeValue);
+	}
+	state.SetItemsProcessed(state.iterations()*model.getElementsCount());
+	model.setBenchmarkCounters(state);
+}
+BENCHMARK(BM_MeshIntegralVolume)->Apply(cubeMeshArguments);
+
+// One Newton iteration of least squares fit of coordinates to scaled
+// reference coordinates, integrated over the mesh.
+static void BM_OptimisationNewtonFit(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	const std::string buffer = writeRegionToMemory(model.region);
+	model.coordinates.setName("reference_coordinates");
+	readRegionFromMemory(model.region, buffer);
+	Field referenceCoordinates = model.fm.findFieldByName("reference_coordinates");
+	Field coordinates = model.fm.findFieldByName("coordinates");
+	const double scale = 1.1;
+	FieldConstant scaleField = model.fm.createFieldConstant(1, &scale);
+	FieldSubtract delta = coordinates - referenceCoordinates*scaleField;
+	FieldMeshIntegralSquares objective = model.fm.createFieldMeshIntegralSquares(delta, referenceCoordinates, model.mesh3d);
+	const int pointsCount = 4;
+	objective.setNumbersOfPoints(1, &pointsCount);
+	Optimisation optimisation = model.fm.createOptimisation();
+	optimisation.setMethod(Optimisation::METHOD_NEWTON);
+	optimisation.addObjectiveField(objective);
+	optimisation.addDependentField(coordinates);
+	optimisation.setAttributeInteger(Optimisation::ATTRIBUTE_MAXIMUM_ITERATIONS, 1);
+	int result = RESULT_OK;
+	for (auto _ : state)
+	{
+		result = optimisation.optimise();
+		benchmark::DoNotOptimize(result);
+	}
+	if (result != RESULT_OK)
+		state.SkipWithError("Optimisation failed");
+	state.SetItemsProcessed(state.iterations()*model.getElementsCount());
+	model.setBenchmarkCounters(state);
+}
+BENCHMARK(BM_OptimisationNewtonFit)->Apply(smallCubeMeshArguments)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,120 @@
+/*
+ * Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cstdio>
+#include <memory>
+
+#include "zincbenchmarksetup.hpp"
+
+namespace {
+
+/** Temporary file in the working directory, removed on destruction. */
+class BenchmarkTemporaryFile
+{
+	std::string fileName;
+
+public:
+	explicit BenchmarkTemporaryFile(const char *fileNameIn) :
+		fileName(fileNameIn)
+	{
+	}
+
+	~BenchmarkTemporaryFile()
+	{
+		std::remove(this->fileName.c_str());
+	}
+
+	const char *getFileName() const
+	{
+		return this->fileName.c_str();
+	}
+};
+
+}
+
+static void BM_RegionWriteEX(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	size_t bytes = 0;
+	for (auto _ : state)
+	{
+		const std::string buffer = writeRegionToMemory(model.region);
+		bytes = buffer.size();
+	}
+	if (bytes == 0)
+		state.SkipWithError("Failed to write EX");
+	state.SetBytesProcessed(state.iterations()*static_cast<int64_t>(bytes));
+	model.setBenchmarkCounters(state);
+}
+BENCHMARK(BM_RegionWriteEX)->Apply(cubeMeshArguments)->Unit(benchmark::kMillisecond);
+
+static void BM_RegionReadEX(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	const std::string buffer = writeRegionToMemory(model.region);
+	int result = RESULT_OK;
+	for (auto _ : state)
+	{
+		// read into a new region each time as merging into existing data differs
+		state.PauseTiming();
+		std::unique_ptr<Context> context(new Context("benchmark_read"));
+		Region region = context->getDefaultRegion();
+		state.ResumeTiming();
+		result = readRegionFromMemory(region, buffer);
+		state.PauseTiming();
+		region = Region();
+		context.reset();
+		state.ResumeTiming();
+	}
+	if (result != RESULT_OK)
+		state.SkipWithError("Failed to read EX");
+	state.SetBytesProcessed(state.iterations()*static_cast<int64_t>(buffer.size()));
+	model.setBenchmarkCounters(state);
+}
+BENCHMARK(BM_RegionReadEX)->Apply(cubeMeshArguments)->Unit(benchmark::kMillisecond);
+
+static void BM_RegionWriteFieldML(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	BenchmarkTemporaryFile file("zinc_benchmark_write.fieldml");
+	int result = RESULT_OK;
+	for (auto _ : state)
+	{
+		StreaminformationRegion streaminformation = model.region.createStreaminformationRegion();
+		streaminformation.setFileFormat(StreaminformationRegion::FILE_FORMAT_FIELDML);
+		StreamresourceFile resource = streaminformation.createStreamresourceFile(file.getFileName());
+		result = model.region.write(streaminformation);
+	}
+	if (result != RESULT_OK)
+		state.SkipWithError("Failed to write FieldML");
+	model.setBenchmarkCounters(state);
+}
+BENCHMARK(BM_RegionWriteFieldML)->Apply(smallCubeMeshArguments)->Unit(benchmark::kMillisecond);
+
+static void BM_RegionReadFieldML(benchmark::State& state)
+{
+	ZincBenchmarkCubeModel model(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1)));
+	BenchmarkTemporaryFile file("zinc_benchmark_read.fieldml");
+	int result = model.region.writeFile(file.getFileName());
+	for (auto _ : state)
+	{
+		state.PauseTiming();
+		std::unique_ptr<Context> context(new Context("benchmark_read"));
+		Region region = context->getDefaultRegion();
+		state.ResumeTiming();
+		result = region.readFile(file.getFileName());
+		state.PauseTiming();
+		region = Region();
+		context.reset();
+		state.ResumeTiming();
+	}
+	if (result != RESULT_OK)
+		state.SkipWithError("Failed to read FieldML");
+	model.setBenchmarkCounters(state);
+}
+BENCHMARK(BM_RegionReadFieldML)->Apply(smallCubeMeshArguments)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,142 @@
+/*
+ * Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#include <cmlibs/zinc/fieldcomposite.hpp>
+#include <cmlibs/zinc/fieldvectoroperators.hpp>
+#include <cmlibs/zinc/glyph.hpp>
+#include <cmlibs/zinc/graphics.hpp>
+#include <cmlibs/zinc/scene.hpp>
+#include <cmlibs/zinc/scenefilter.hpp>
+#include <cmlibs/zinc/stream.hpp>
+#include <cmlibs/zinc/streamscene.hpp>
+
+#include "zincbenchmarksetup.hpp"
+
+namespace {
+
+/**
+ * Cube model with a scene and an identity of the coordinates field to
+ * alternate with the coordinates so graphics are rebuilt on each iteration.
+ */
+class ZincBenchmarkCubeScene : public ZincBenchmarkCubeModel
+{
+public:
+	Scene scene;
+	Field alternateCoordinates;
+
+	ZincBenchmarkCubeScene(benchmark::State& state) :
+		ZincBenchmarkCubeModel(static_cast<int>(state.range(0)), static_cast<CubeMeshBasis>(state.range(1))),
+		scene(region.getScene())
+	{
+		this->context.getGlyphmodule().defineStandardGlyphs();
+		this->alternateCoordinates = this->fm.createFieldIdentity(this->coordinates);
+	}
+
+	/** Build graphics, changing coordinate field first so they are rebuilt. */
+	void build(Graphics& graphics, int64_t iteration)
+	{
+		graphics.setCoordinateField((iteration % 2) ? this->alternateCoordinates : this->coordinates);
+		double minimums[3], maximums[3];
+		this->scene.getCoordinatesRange(Scenefilter(), minimums, maximums);
+		benchmark::DoNotOptimize(minimums);
+	}
+
+	void createExteriorSurfaces()
+	{
+		GraphicsSurfaces surfaces = this->scene.createGraphicsSurfaces();
+		surfaces.setCoordinateField(this->coordinates);
+		surfaces.setExterior(true);
+	}
+};
+
+void buildGraphics(benchmark::State& state, ZincBenchmarkCubeScene& cubeScene, Graphics graphics)
+{
+	int64_t iteration = 0;
+	for (auto _ : state)
+		cubeScene.build(graphics, iteration++);
+	cubeScene.setBenchmarkCounters(state);
+}
+
+void exportScene(benchmark::State& state, StreaminformationScene::IOFormat ioFormat)
+{
+	ZincBenchmarkCubeScene cubeScene(state);
+	cubeScene.createExteriorSurfaces();
+	int result = RESULT_OK;
+	int64_t bytes = 0;
+	for (auto _ : state)
+	{
+		StreaminformationScene streaminformation = cubeScene.scene.createStreaminformationScene();
+		streaminformation.setIOFormat(ioFormat);
+		const int resourcesCount = streaminformation.getNumberOfResourcesRequired();
+		std::vector<StreamresourceMemory> resources;
+		for (int r = 0; r < resourcesCount; ++r)
+			resources.push_back(streaminformation.createStreamresourceMemory());
+		result = cubeScene.scene.write(streaminformation);
+		bytes = 0;
+		for (auto& resource : resources)
+		{
+			const void *buffer = nullptr;
+			unsigned int bufferLength = 0;
+			resource.getBuffer(&buffer, &bufferLength);
+			bytes += bufferLength;
+		}
+	}
+	if (result != RESULT_OK)
+		state.SkipWithError("Failed to export scene");
+	state.SetBytesProcessed(state.iterations()*bytes);
+	cubeScene.setBenchmarkCounters(state);
+}
+
+}
+
+static void BM_GraphicsSurfacesExterior(benchmark::State& state)
+{
+	ZincBenchmarkCubeScene cubeScene(state);
+	GraphicsSurfaces surfaces = cubeScene.scene.createGraphicsSurfaces();
+	surfaces.setExterior(true);
+	buildGraphics(state, cubeScene, surfaces);
+}
+BENCHMARK(BM_GraphicsSurfacesExterior)->Apply(cubeMeshArguments)->Unit(benchmark::kMillisecond);
+
+static void BM_GraphicsContoursIsoSurface(benchmark::State& state)
+{
+	ZincBenchmarkCubeScene cubeScene(state);
+	FieldMagnitude magnitude = cubeScene.fm.createFieldMagnitude(cubeScene.coordinates);
+	GraphicsContours contours = cubeScene.scene.createGraphicsContours();
+	contours.setIsoscalarField(magnitude);
+	const double isovalues[3] = { 0.4, 0.8, 1.2 };
+	contours.setListIsovalues(3, isovalues);
+	buildGraphics(state, cubeScene, contours);
+}
+BENCHMARK(BM_GraphicsContoursIsoSurface)->Apply(cubeMeshArguments)->Unit(benchmark::kMillisecond);
+
+static void BM_GraphicsPointsGlyphs(benchmark::State& state)
+{
+	ZincBenchmarkCubeScene cubeScene(state);
+	GraphicsPoints points = cubeScene.scene.createGraphicsPoints();
+	points.setFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Graphicspointattributes pointattributes = points.getGraphicspointattributes();
+	pointattributes.setGlyphShapeType(Glyph::SHAPE_TYPE_SPHERE);
+	const double baseSize = 0.01;
+	pointattributes.setBaseSize(1, &baseSize);
+	pointattributes.setOrientationScaleField(cubeScene.coordinates);
+	buildGraphics(state, cubeScene, points);
+}
+BENCHMARK(BM_GraphicsPointsGlyphs)->Apply(cubeMeshArguments)->Unit(benchmark::kMillisecond);
+
+static void BM_SceneExportThreejs(benchmark::State& state)
+{
+	exportScene(state, StreaminformationScene::IO_FORMAT_THREEJS);
+}
+BENCHMARK(BM_SceneExportThreejs)->Apply(smallCubeMeshArguments)->Unit(benchmark::kMillisecond);
+
+static void BM_SceneExportSTL(benchmark::State& state)
+{
+	exportScene(state, StreaminformationScene::IO_FORMAT_ASCII_STL);
+}
+BENCHMARK(BM_SceneExportSTL)->Apply(smallCubeMeshArguments)->Unit(benchmark::kMillisecond);
@@ -0,0 +1,229 @@
+/*
+ * Zinc Library Benchmarks
+ *
+ * This Source Code Form is subject to the terms of the Mozilla Public
+ * License, v. 2.0. If a copy of the MPL was not distributed with this
+ * file, You can obtain one at http://mozilla.org/MPL/2.0/.
+ */
+
+#ifndef __ZINCBENCHMARKSETUP_HPP__
+#define __ZINCBENCHMARKSETUP_HPP__
+
+#include <benchmark/benchmark.h>
+
+#include <cmlibs/zinc/context.hpp>
+#include <cmlibs/zinc/element.hpp>
+#include <cmlibs/zinc/elementbasis.hpp>
+#include <cmlibs/zinc/elementfieldtemplate.hpp>
+#include <cmlibs/zinc/elementtemplate.hpp>
+#include <cmlibs/zinc/fieldcache.hpp>
+#include <cmlibs/zinc/fieldfiniteelement.hpp>
+#include <cmlibs/zinc/fieldmodule.hpp>
+#include <cmlibs/zinc/mesh.hpp>
+#include <cmlibs/zinc/node.hpp>
+#include <cmlibs/zinc/nodeset.hpp>
+#include <cmlibs/zinc/nodetemplate.hpp>
+#include <cmlibs/zinc/region.hpp>
+#include <cmlibs/zinc/result.hpp>
+#include <cmlibs/zinc/streamregion.hpp>
+
+#include <string>
+#include <vector>
+
+using namespace CMLibs::Zinc;
+
+/** Bases of generated cube meshes, used as benchmark argument */
+enum CubeMeshBasis
+{
+	CUBE_MESH_BASIS_LINEAR_LAGRANGE = 0,
+	CUBE_MESH_BASIS_QUADRATIC_LAGRANGE = 1,
+	CUBE_MESH_BASIS_CUBIC_LAGRANGE = 2,
+	CUBE_MESH_BASIS_CUBIC_HERMITE = 3
+};
+
+inline const char *getCubeMeshBasisName(CubeMeshBasis basis)
+{
+	switch (basis)
+	{
+	case CUBE_MESH_BASIS_LINEAR_LAGRANGE:
+		return "linear_lagrange";
+	case CUBE_MESH_BASIS_QUADRATIC_LAGRANGE:
+		return "quadratic_lagrange";
+	case CUBE_MESH_BASIS_CUBIC_LAGRANGE:
+		return "cubic_lagrange";
+	case CUBE_MESH_BASIS_CUBIC_HERMITE:
+		return "cubic_hermite";
+	}
+	return "unknown";
+}
+
+/**
+ * Model of a unit cube divided into elementsCountPerAxis^3 hexahedral
+ * elements with 3-component "coordinates" field interpolated with the given
+ * basis, plus faces. Lagrange bases have (order*elementsCountPerAxis + 1)^3
+ * nodes; tricubic Hermite has (elementsCountPerAxis + 1)^3 nodes with all
+ * 8 derivative parameters, cross derivatives zero.
+ */
+class ZincBenchmarkCubeModel
+{
+public:
+	Context context;
+	Region region;
+	Fieldmodule fm;
+	FieldFiniteElement coordinates;
+	Mesh mesh3d;
+	Nodeset nodes;
+	const int elementsCountPerAxis;
+	const CubeMeshBasis basis;
+
+	ZincBenchmarkCubeModel(int elementsCountPerAxisIn, CubeMeshBasis basisIn) :
+		context("benchmark"),
+		region(context.getDefaultRegion()),
+		fm(region.getFieldmodule()),
+		elementsCountPerAxis(elementsCountPerAxisIn),
+		basis(basisIn)
+	{
+		this->generate();
+	}
+
+	int getNodesCount() const
+	{
+		return this->nodes.getSize();
+	}
+
+	int getElementsCount() const
+	{
+		return this->mesh3d.getSize();
+	}
+
+	/** Add benchmark label and element/node counters describing model. */
+	void setBenchmarkCounters(benchmark::State& state) const
+	{
+		state.SetLabel(getCubeMeshBasisName(this->basis));
+		state.counters["elements"] = static_cast<double>(this->getElementsCount());
+		state.counters["nodes"] = static_cast<double>(this->getNodesCount());
+	}
+
+private:
+	void generate()
+	{
+		this->fm.beginChange();
+		this->coordinates = this->fm.createFieldFiniteElement(3);
+		this->coordinates.setName("coordinates");
+		this->coordinates.setManaged(true);
+		this->coordinates.setTypeCoordinate(true);
+		this->nodes = this->fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+		this->mesh3d = this->fm.findMeshByDimension(3);
+
+		const bool hermite = (this->basis == CUBE_MESH_BASIS_CUBIC_HERMITE);
+		const int order = hermite ? 1 : (static_cast<int>(this->basis) + 1);
+		const int nodesCountPerAxis = order*this->elementsCountPerAxis + 1;
+		const double nodeSpacing = 1.0/(order*this->elementsCountPerAxis);
+
+		Nodetemplate nodetemplate = this->nodes.createNodetemplate();
+		nodetemplate.defineField(this->coordinates);
+		const Node::ValueLabel derivativeLabels[7] = {
+			Node::VALUE_LABEL_D_DS1, Node::VALUE_LABEL_D_DS2, Node::VALUE_LABEL_D2_DS1DS2,
+			Node::VALUE_LABEL_D_DS3, Node::VALUE_LABEL_D2_DS1DS3, Node::VALUE_LABEL_D2_DS2DS3,
+			Node::VALUE_LABEL_D3_DS1DS2DS3 };
+		if (hermite)
+		{
+			for (int d = 0; d < 7; ++d)
+				nodetemplate.setValueNumberOfVersions(this->coordinates, -1, derivativeLabels[d], 1);
+		}
+		Fieldcache fieldcache = this->fm.createFieldcache();
+		int nodeIdentifier = 1;
+		for (int k = 0; k < nodesCountPerAxis; ++k)
+			for (int j = 0; j < nodesCountPerAxis; ++j)
+				for (int i = 0; i < nodesCountPerAxis; ++i)
+				{
+					Node node = this->nodes.createNode(nodeIdentifier++, nodetemplate);
+					fieldcache.setNode(node);
+					const double x[3] = { i*nodeSpacing, j*nodeSpacing, k*nodeSpacing };
+					this->coordinates.setNodeParameters(fieldcache, -1, Node::VALUE_LABEL_VALUE, 1, 3, x);
+					if (hermite)
+					{
+						double derivatives[7][3] = { { 0.0 } };
+						derivatives[0][0] = nodeSpacing;  // D_DS1
+						derivatives[1][1] = nodeSpacing;  // D_DS2
+						derivatives[3][2] = nodeSpacing;  // D_DS3
+						for (int d = 0; d < 7; ++d)
+							this->coordinates.setNodeParameters(fieldcache, -1, derivativeLabels[d], 1, 3, derivatives[d]);
+					}
+				}
+
+		Elementbasis elementbasis = this->fm.createElementbasis(3,
+			hermite ? Elementbasis::FUNCTION_TYPE_CUBIC_HERMITE :
+			(order == 1) ? Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE :
+			(order == 2) ? Elementbasis::FUNCTION_TYPE_QUADRATIC_LAGRANGE :
+			Elementbasis::FUNCTION_TYPE_CUBIC_LAGRANGE);
+		Elementfieldtemplate eft = this->mesh3d.createElementfieldtemplate(elementbasis);
+		Elementtemplate elementtemplate = this->mesh3d.createElementtemplate();
+		elementtemplate.setElementShapeType(Element::SHAPE_TYPE_CUBE);
+		elementtemplate.defineField(this->coordinates, -1, eft);
+		const int localNodesCountPerAxis = order + 1;
+		std::vector<int> nodeIdentifiers(localNodesCountPerAxis*localNodesCountPerAxis*localNodesCountPerAxis);
+		int elementIdentifier = 1;
+		for (int ek = 0; ek < this->elementsCountPerAxis; ++ek)
+			for (int ej = 0; ej < this->elementsCountPerAxis; ++ej)
+				for (int ei = 0; ei < this->elementsCountPerAxis; ++ei)
+				{
+					int n = 0;
+					for (int c = 0; c < localNodesCountPerAxis; ++c)
+						for (int b = 0; b < localNodesCountPerAxis; ++b)
+							for (int a = 0; a < localNodesCountPerAxis; ++a)
+								nodeIdentifiers[n++] = 1 + (ei*order + a) +
+									nodesCountPerAxis*((ej*order + b) + nodesCountPerAxis*(ek*order + c));
+					Element element = this->mesh3d.createElement(elementIdentifier++, elementtemplate);
+					element.setNodesByIdentifier(eft, static_cast<int>(nodeIdentifiers.size()), nodeIdentifiers.data());
+				}
+		this->fm.defineAllFaces();
+		this->fm.endChange();
+	}
+};
+
+/** @return  EX format serialisation of region, or empty string on failure. */
+inline std::string writeRegionToMemory(Region& region)
+{
+	StreaminformationRegion streaminformation = region.createStreaminformationRegion();
+	streaminformation.setFileFormat(StreaminformationRegion::FILE_FORMAT_EX);
+	StreamresourceMemory memory = streaminformation.createStreamresourceMemory();
+	if (RESULT_OK != region.write(streaminformation))
+		return std::string();
+	const void *buffer = nullptr;
+	unsigned int bufferLength = 0;
+	memory.getBuffer(&buffer, &bufferLength);
+	return std::string(static_cast<const char *>(buffer), bufferLength);
+}
+
+/** Read EX format serialisation into region. */
+inline int readRegionFromMemory(Region& region, const std::string& buffer)
+{
+	StreaminformationRegion streaminformation = region.createStreaminformationRegion();
+	streaminformation.setFileFormat(StreaminformationRegion::FILE_FORMAT_EX);
+	StreamresourceMemory memory = streaminformation.createStreamresourceMemoryBuffer(
+		buffer.data(), static_cast<unsigned int>(buffer.size()));
+	return region.read(streaminformation);
+}
+
+/** Add standard cube model arguments: elements per axis and basis. */
+inline void cubeMeshArguments(benchmark::internal::Benchmark *benchmark)
+{
+	benchmark->ArgNames({ "elements_per_axis", "basis" });
+	const int elementsCountsPerAxis[3] = { 4, 8, 16 };
+	for (int e = 0; e < 3; ++e)
+		for (int b = CUBE_MESH_BASIS_LINEAR_LAGRANGE; b <= CUBE_MESH_BASIS_CUBIC_HERMITE; ++b)
+			benchmark->Args({ elementsCountsPerAxis[e], b });
+}
+
+/** Add smaller cube model arguments for expensive benchmarks. */
+inline void smallCubeMeshArguments(benchmark::internal::Benchmark *benchmark)
+{
+	benchmark->ArgNames({ "elements_per_axis", "basis" });
+	const int elementsCountsPerAxis[2] = { 2, 4 };
+	for (int e = 0; e < 2; ++e)
+		for (int b = CUBE_MESH_BASIS_LINEAR_LAGRANGE; b <= CUBE_MESH_BASIS_CUBIC_HERMITE; ++b)
+			benchmark->Args({ elementsCountsPerAxis[e], b });
+}
+
+#endif // __ZINCBENCHMARKSETUP_HPP__
@@ -99,6 +99,88 @@ ZINC_API int cmzn_context_set_default_region(cmzn_context_id context,
  */
 ZINC_API cmzn_region_id cmzn_context_create_region(cmzn_context_id context);
 
+/**
+ * Get the number of threads the context uses for parallel operations.
+ * @see cmzn_context_set_number_of_threads
+ *
+ * @param context  The context to query.
+ * @return  Number of threads, 0 meaning the number of hardware threads, or
+ * -1 if invalid context.
+ */
+ZINC_API int cmzn_context_get_number_of_threads(cmzn_context_id context);
+
+/**
+ * Set the number of threads in the context's thread pool, used by parallel
+ * operations including field assignment, streamlines, contours and image
+ * filters. Their own number of threads settings are limited to this number.
+ * Set to 1 to run all operations single-threaded, e.g. for reproducibility
+ * when debugging; parallel results are designed not to depend on the number
+ * of threads. Default is 0 which uses the number of hardware threads.
+ * Must not be changed while any parallel operation is in progress.
+ *
+ * @param context  The context to modify.
+ * @param numberOfThreads  The number of threads >= 1, or 0 to use the number
+ * of hardware threads.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_context_set_number_of_threads(cmzn_context_id context,
+	int numberOfThreads);
+
+/**
+ * Query whether performance counters are enabled.
+ * Performance counters are process-wide: this reports the state shared by
+ * all contexts, and the context argument is only validated.
+ * @see cmzn_context_set_performance_counters_enabled
+ *
+ * @param context  The context to query.
+ * @return  True if enabled, false if disabled or invalid context.
+ */
+ZINC_API bool cmzn_context_is_performance_counters_enabled(
+	cmzn_context_id context);
+
+/**
+ * Set whether performance counters are enabled. When enabled, counts and
+ * times are accumulated for field evaluations by field type, field cache hits
+ * and misses, element field evaluations, find mesh location element tests,
+ * graphics builds by graphics name, region read and write phases and change
+ * notification. Disabled by default, when the cost is negligible.
+ * Performance counters are process-wide, not per context: enabling or
+ * disabling them through any context does so for all contexts in the
+ * process, and counts include work done in all of them. The context argument
+ * is only validated.
+ *
+ * @param context  The context to modify.
+ * @param enabled  True to enable counters, false to disable.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_context_set_performance_counters_enabled(
+	cmzn_context_id context, bool enabled);
+
+/**
+ * Reset all performance counts and times to zero.
+ * Performance counters are process-wide, so this resets counts and times
+ * seen through all contexts in the process; the context argument is only
+ * validated.
+ *
+ * @param context  The context to modify.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_context_reset_performance_counters(cmzn_context_id context);
+
+/**
+ * Get a report of performance counters accumulated since last reset, as a
+ * JSON object with "enabled" flag and "counters" object mapping category to
+ * counter name to object with "count" and, for timed counters, total "time"
+ * in seconds. Only counters with non-zero count are included.
+ * Performance counters are process-wide, so the report includes work done in
+ * all contexts in the process; the context argument is only validated.
+ *
+ * @param context  The context to query.
+ * @return  On success, allocated string containing JSON report; up to
+ * caller to free using cmzn_deallocate(). Returns NULL on failure.
+ */
+ZINC_API char *cmzn_context_get_performance_report(cmzn_context_id context);
+
 /**
  * Get the font module which manages fonts for rendering text in graphics.
  *
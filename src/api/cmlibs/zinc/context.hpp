@@ -112,6 +112,36 @@ public:
 		return cmzn_context_get_version_string(id);
 	}
 
+	int getNumberOfThreads() const
+	{
+		return cmzn_context_get_number_of_threads(id);
+	}
+
+	int setNumberOfThreads(int numberOfThreads)
+	{
+		return cmzn_context_set_number_of_threads(id, numberOfThreads);
+	}
+
+	bool isPerformanceCountersEnabled() const
+	{
+		return cmzn_context_is_performance_counters_enabled(id);
+	}
+
+	int setPerformanceCountersEnabled(bool enabled)
+	{
+		return cmzn_context_set_performance_counters_enabled(id, enabled);
+	}
+
+	int resetPerformanceCounters()
+	{
+		return cmzn_context_reset_performance_counters(id);
+	}
+
+	char *getPerformanceReport() const
+	{
+		return cmzn_context_get_performance_report(id);
+	}
+
 	inline Region createRegion();
 
 	inline Region getDefaultRegion() const;
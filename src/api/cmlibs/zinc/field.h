@@ -71,6 +71,26 @@ ZINC_API enum cmzn_field_domain_type cmzn_field_domain_type_enum_from_string(
 ZINC_API char *cmzn_field_domain_type_enum_to_string(
 	enum cmzn_field_domain_type type);
 
+/**
+ * Convert a short name into an enum if the name matches any of the members in
+ * the enum.
+ *
+ * @param name  Enumeration name string.
+ * @return  Enumeration value or INVALID if not found.
+ */
+ZINC_API enum cmzn_field_domain_ordering cmzn_field_domain_ordering_enum_from_string(
+	const char *name);
+
+/**
+ * Return an allocated short name of the enum type from the provided enum.
+ * User must call cmzn_deallocate to destroy the successfully returned string.
+ *
+ * @param ordering  enum to be converted into string
+ * @return  an allocated string of the short name of the enum.
+ */
+ZINC_API char *cmzn_field_domain_ordering_enum_to_string(
+	enum cmzn_field_domain_ordering ordering);
+
 /**
  * Get the number of components of the field.
  *
@@ -149,6 +149,14 @@ public:
 	 */
 	typedef int DomainTypes;
 
+	enum DomainOrdering
+	{
+		DOMAIN_ORDERING_INVALID = CMZN_FIELD_DOMAIN_ORDERING_INVALID,
+		DOMAIN_ORDERING_HILBERT = CMZN_FIELD_DOMAIN_ORDERING_HILBERT,
+		DOMAIN_ORDERING_MORTON = CMZN_FIELD_DOMAIN_ORDERING_MORTON,
+		DOMAIN_ORDERING_REVERSE_CUTHILL_MCKEE = CMZN_FIELD_DOMAIN_ORDERING_REVERSE_CUTHILL_MCKEE
+	};
+
 	enum ValueType
 	{
 		VALUE_TYPE_INVALID = CMZN_FIELD_VALUE_TYPE_INVALID,
@@ -231,6 +239,16 @@ public:
 		return cmzn_field_domain_type_enum_to_string(static_cast<cmzn_field_domain_type>(type));
 	}
 
+	static DomainOrdering DomainOrderingEnumFromString(const char *name)
+	{
+		return static_cast<DomainOrdering>(cmzn_field_domain_ordering_enum_from_string(name));
+	}
+
+	static char *DomainOrderingEnumToString(DomainOrdering ordering)
+	{
+		return cmzn_field_domain_ordering_enum_to_string(static_cast<cmzn_field_domain_ordering>(ordering));
+	}
+
 	inline Fieldparameters getFieldparameters() const;
 
 	int getNumberOfComponents() const
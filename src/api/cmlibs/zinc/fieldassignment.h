@@ -114,6 +114,37 @@ ZINC_API cmzn_nodeset_id cmzn_fieldassignment_get_nodeset(
 ZINC_API int cmzn_fieldassignment_set_nodeset(
 	cmzn_fieldassignment_id fieldassignment, cmzn_nodeset_id nodeset);
 
+/**
+ * Get the number of threads used to evaluate the source field.
+ * @see cmzn_fieldassignment_set_number_of_threads
+ *
+ * @param fieldassignment  The field assignment object to query.
+ * @return  Number of threads, 0 meaning all context threads, or -1 if
+ * invalid field assignment object.
+ */
+ZINC_API int cmzn_fieldassignment_get_number_of_threads(
+	cmzn_fieldassignment_id fieldassignment);
+
+/**
+ * Set the number of threads used to evaluate the source field. Default is 1
+ * for serial evaluation. With more than one thread, real source values for
+ * batches of nodes are evaluated concurrently, each thread with its own field
+ * cache, and all values are assigned in one change. Results are the same as
+ * serial assignment provided the source field at each node does not depend on
+ * target field values at other nodes. Mesh location and string valued fields
+ * and direct copies between finite element fields are always serial.
+ * Threads are taken from the context's thread pool, so the number used is
+ * limited by the context number of threads.
+ * @see cmzn_context_set_number_of_threads
+ *
+ * @param fieldassignment  The field assignment object to modify.
+ * @param numberOfThreads  The number of threads >= 1, or 0 to use all
+ * context threads.
+ * @return  Result OK on success, otherwise ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_fieldassignment_set_number_of_threads(
+	cmzn_fieldassignment_id fieldassignment, int numberOfThreads);
+
 /**
 * Get the source field for the field assignment.
 *
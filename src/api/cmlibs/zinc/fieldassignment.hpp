@@ -96,6 +96,16 @@ public:
 		return cmzn_fieldassignment_set_nodeset(this->id, nodeset.getId());
 	}
 
+	int getNumberOfThreads() const
+	{
+		return cmzn_fieldassignment_get_number_of_threads(this->id);
+	}
+
+	int setNumberOfThreads(int numberOfThreads)
+	{
+		return cmzn_fieldassignment_set_number_of_threads(this->id, numberOfThreads);
+	}
+
 	Field getSourceField() const
 	{
 		return Field(cmzn_fieldassignment_get_source_field(this->id));
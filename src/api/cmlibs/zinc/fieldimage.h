@@ -563,6 +563,59 @@ ZINC_API int cmzn_field_image_get_buffer(cmzn_field_image_id image_field,
 ZINC_API int cmzn_field_image_set_buffer(cmzn_field_image_id image_field,
 	const void *buffer, unsigned int buffer_length);
 
+/**
+ * Get the number of chunk levels available for an image read with chunked
+ * out-of-core storage, i.e. with streaminformation image attribute
+ * CHUNK_SIZE_PIXELS set. Level 0 is full resolution and each following level
+ * halves the size in every direction, down to 1 pixel.
+ *
+ * @param image_field  The image field to query.
+ * @return  Number of chunk levels, or 0 if image not chunked or invalid field.
+ */
+ZINC_API int cmzn_field_image_get_number_of_chunk_levels(cmzn_field_image_id image_field);
+
+/**
+ * Get the chunk level the image is currently evaluated at.
+ *
+ * @param image_field  The image field to query.
+ * @return  Current chunk level, or 0 if image not chunked or invalid field.
+ */
+ZINC_API int cmzn_field_image_get_chunk_level(cmzn_field_image_id image_field);
+
+/**
+ * Set the chunk level to evaluate an image with chunked storage at. Coarser
+ * levels are built on demand by averaging 2x2x2 pixels of the next finer
+ * level, and the size in pixels of the image changes to that of the level.
+ * Useful for previewing and processing very large images at lower resolution.
+ *
+ * @param image_field  The image field to modify.
+ * @param level  The chunk level from 0 to number of chunk levels - 1.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT if image
+ * not chunked or invalid level.
+ */
+ZINC_API int cmzn_field_image_set_chunk_level(cmzn_field_image_id image_field,
+	int level);
+
+/**
+ * Get the maximum memory for caching chunks of an image with chunked storage.
+ *
+ * @param image_field  The image field to query.
+ * @return  Memory budget in megabytes, or 0 if image not chunked or invalid field.
+ */
+ZINC_API int cmzn_field_image_get_chunk_memory_budget(cmzn_field_image_id image_field);
+
+/**
+ * Set the maximum memory for caching chunks of an image with chunked storage.
+ * Least recently used chunks are released to meet the budget.
+ *
+ * @param image_field  The image field to modify.
+ * @param megabytes  The memory budget in megabytes, > 0.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT if image
+ * not chunked or invalid budget.
+ */
+ZINC_API int cmzn_field_image_set_chunk_memory_budget(cmzn_field_image_id image_field,
+	int megabytes);
+
 #ifdef __cplusplus
 }
 #endif
@@ -267,6 +267,31 @@ public:
 		return cmzn_field_image_set_buffer(getDerivedId(), buffer, buffer_length);
 	}
 
+	int getNumberOfChunkLevels()
+	{
+		return cmzn_field_image_get_number_of_chunk_levels(getDerivedId());
+	}
+
+	int getChunkLevel()
+	{
+		return cmzn_field_image_get_chunk_level(getDerivedId());
+	}
+
+	int setChunkLevel(int level)
+	{
+		return cmzn_field_image_set_chunk_level(getDerivedId(), level);
+	}
+
+	int getChunkMemoryBudget()
+	{
+		return cmzn_field_image_get_chunk_memory_budget(getDerivedId());
+	}
+
+	int setChunkMemoryBudget(int megabytes)
+	{
+		return cmzn_field_image_set_chunk_memory_budget(getDerivedId(), megabytes);
+	}
+
 	inline StreaminformationImage createStreaminformationImage();
 
 };
@@ -11,6 +11,7 @@
 #ifndef CMZN_FIELDIMAGEPROCESSING_H__
 #define CMZN_FIELDIMAGEPROCESSING_H__
 
+#include "types/fieldcacheid.h"
 #include "types/fieldid.h"
 #include "types/fieldimageprocessingid.h"
 #include "types/fieldmoduleid.h"
@@ -22,10 +23,86 @@ extern "C" {
 #endif
 
 /**
- * Creates a field performing ITK binary dilate image filter on scalar source
- * field image. Sets number of components to same number as <source_field>.
- * The <radius> and <dilate_value> specify the radius of pixels to use
- * for dilation and what pixel value to use for dilation
+ * Get how the output image of an image filter field is sampled between
+ * pixel centres.
+ *
+ * @param field  Handle to any image filter field.
+ * @return  The interpolation mode, or INTERPOLATION_MODE_INVALID if field
+ * is not an image filter.
+ */
+ZINC_API enum cmzn_field_imagefilter_interpolation_mode
+	cmzn_field_imagefilter_get_interpolation_mode(cmzn_field_id field);
+
+/**
+ * Set how the output image of an image filter field is sampled between
+ * pixel centres. With LINEAR or CUBIC interpolation, first derivatives with
+ * respect to the image mesh are evaluated analytically from the interpolant
+ * instead of by finite differences. Not supported by the histogram filter.
+ * @see cmzn_field_imagefilter_interpolation_mode
+ *
+ * @param field  Handle to any image filter field.
+ * @param interpolation_mode  The interpolation mode to set.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_field_imagefilter_set_interpolation_mode(cmzn_field_id field,
+	enum cmzn_field_imagefilter_interpolation_mode interpolation_mode);
+
+/**
+ * Get the number of threads an image filter field's output is computed with.
+ *
+ * @param field  Handle to any image filter field.
+ * @return  The number of threads, 0 meaning all context threads,
+ * or -1 if field is not an image filter.
+ */
+ZINC_API int cmzn_field_imagefilter_get_number_of_threads(cmzn_field_id field);
+
+/**
+ * Set the number of threads to compute an image filter field's output with.
+ * Only used by the built-in binary dilate, binary erode, binary threshold,
+ * discrete gaussian, gradient magnitude recursive gaussian and mean filters,
+ * which process image buffers directly for any number of components, and
+ * give the same output for any number of threads. Output is cached until
+ * the source field or filter parameters change. Default is 1 thread.
+ * Threads are taken from the context's thread pool, so the number used is
+ * limited by the context number of threads.
+ * @see cmzn_context_set_number_of_threads
+ *
+ * @param field  Handle to any image filter field.
+ * @param number_of_threads  The number of threads >= 0, where 0 uses all
+ * context threads.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_field_imagefilter_set_number_of_threads(cmzn_field_id field,
+	int number_of_threads);
+
+/**
+ * Sample the output image of an image filter field at many xi locations in
+ * one call, using the current interpolation mode. This avoids setting a
+ * field cache location per point. The cache is only used to update the
+ * filter output if needed, so must have a location where the source image
+ * can be evaluated, e.g. in an element of the image mesh.
+ *
+ * @param field  Handle to any image filter field except histogram.
+ * @param cache  Field cache used to update the filter output if required.
+ * @param number_of_points  The number of xi locations to sample, > 0.
+ * @param xi_values  Array of number_of_points x image dimension xi values,
+ * with xi varying fastest. Image xi ranges from 0 to 1 across all pixels.
+ * @param values_count  Size of values array, which must be at least
+ * number_of_points x number of field components.
+ * @param values  Array to receive field values at each point, with
+ * components varying fastest.
+ * @return  Status CMZN_OK on success, CMZN_ERROR_ARGUMENT if invalid
+ * arguments, or CMZN_ERROR_GENERAL if filter could not be evaluated.
+ */
+ZINC_API int cmzn_field_imagefilter_evaluate_real_xi_points(cmzn_field_id field,
+	cmzn_fieldcache_id cache, int number_of_points, const double *xi_values,
+	int values_count, double *values);
+
+/**
+ * Creates a field performing binary dilate image filter on source field
+ * image. Sets number of components to same number as <source_field>, each
+ * filtered independently. Pixels within a ball of <radius> pixels of any
+ * pixel with <dilate_value> are set to <dilate_value>; others are unchanged.
  * @return  Handle to new field, or NULL/invalid handle on failure.
  */
 ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_imagefilter_binary_dilate(
@@ -33,10 +110,11 @@ ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_imagefilter_binary_dilate(
 	int radius, double dilate_value);
 
 /**
- * Creates a field performing ITK binary erode image filter on scalar source
- * field image. Sets number of components to same number as <source_field>.
- * The <radius> and <erode_value> specify the radius of pixels to use
- * for dilation and what pixel value to use for dilation
+ * Creates a field performing binary erode image filter on source field
+ * image. Sets number of components to same number as <source_field>, each
+ * filtered independently. Pixels with <erode_value> are set to 0 if any pixel
+ * within a ball of <radius> pixels inside the image does not have
+ * <erode_value>; others are unchanged.
  * @return  Handle to new field, or NULL/invalid handle on failure.
  */
 ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_imagefilter_binary_erode(
@@ -44,7 +122,7 @@ ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_imagefilter_binary_erode(
 	int radius, double erode_value);
 
 /**
- * Creates a field which applies an ITK binary threshold image filter on source.
+ * Creates a field which applies a binary threshold image filter on source.
  * The newly created field consists of binary values (either 0 or 1) which are
  * determined by applying the threshold range to the source field.
  * Input values with an intensity range between lower_threshold and the
@@ -173,8 +251,8 @@ ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_imagefilter_curvature_aniso
 	double timeStep, double conductance, int numIterations);
 
 /**
- * Creates a field applying the ITK discrete gaussian image filter to the source
- * field. This means that each pixel value in the new field
+ * Creates a field applying a discrete gaussian image filter to the source
+ * field, with the kernel of the ITK discrete gaussian filter. This means that each pixel value in the new field
  * is based on a weighted average of the pixel and the surrounding pixel values
  * from the source field. Pixels further away are given a lower weighting.
  * Increasing the variance increases the width of the gaussian distribution
@@ -276,9 +354,10 @@ ZINC_API int cmzn_field_imagefilter_discrete_gaussian_destroy(
 		cmzn_field_imagefilter_discrete_gaussian_id *imagefilter_discrete_gaussian_address);
 
 /**
- * Creates a field performing ITK gradient magnitude recursive gaussian image
- * filter on scalar source field image.
- * Sets number of components to same number as <source_field>.
+ * Creates a field giving the magnitude of the image gradient in pixel units
+ * of the source field image smoothed by a gaussian of standard deviation
+ * <sigma> pixels. Sets number of components to same number as <source_field>,
+ * each filtered independently.
  * @return  Handle to new field, or NULL/invalid handle on failure.
  */
 ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_imagefilter_gradient_magnitude_recursive_gaussian(
@@ -286,7 +365,8 @@ ZINC_API cmzn_field_id cmzn_fieldmodule_create_field_imagefilter_gradient_magnit
 	double sigma);
 
 /**
- * Creates a field performing ITK mean image filter on source_field image.
+ * Creates a field performing mean image filter on source_field image, giving
+ * the average of pixels in a box of +/- radius size pixels in each axis.
  * Sets number of components to same number as <source_field>.
  *
  * @param field_module  The field module for the region to own the new field.
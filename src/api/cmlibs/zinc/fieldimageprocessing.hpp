@@ -10,6 +10,7 @@
 #define CMZN_FIELDIMAGEPROCESSING_HPP__
 
 #include "cmlibs/zinc/field.hpp"
+#include "cmlibs/zinc/fieldcache.hpp"
 #include "cmlibs/zinc/fieldimageprocessing.h"
 #include "cmlibs/zinc/fieldmodule.hpp"
 
@@ -18,6 +19,59 @@ namespace CMLibs
 namespace Zinc
 {
 
+/**
+ * Base field handle for API common to all image filter fields.
+ */
+class FieldImagefilter : public Field
+{
+public:
+
+	FieldImagefilter() : Field(0)
+	{	}
+
+	// shares handle of any image filter field
+	explicit FieldImagefilter(const Field& field) : Field(field)
+	{	}
+
+	enum InterpolationMode
+	{
+		INTERPOLATION_MODE_INVALID = CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_INVALID,
+		INTERPOLATION_MODE_NEAREST = CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_NEAREST,
+		INTERPOLATION_MODE_LINEAR = CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_LINEAR,
+		INTERPOLATION_MODE_CUBIC = CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_CUBIC
+	};
+
+	InterpolationMode getInterpolationMode() const
+	{
+		return static_cast<InterpolationMode>(
+			cmzn_field_imagefilter_get_interpolation_mode(id));
+	}
+
+	int setInterpolationMode(InterpolationMode interpolationMode)
+	{
+		return cmzn_field_imagefilter_set_interpolation_mode(id,
+			static_cast<cmzn_field_imagefilter_interpolation_mode>(interpolationMode));
+	}
+
+	int getNumberOfThreads() const
+	{
+		return cmzn_field_imagefilter_get_number_of_threads(id);
+	}
+
+	int setNumberOfThreads(int numberOfThreads)
+	{
+		return cmzn_field_imagefilter_set_number_of_threads(id, numberOfThreads);
+	}
+
+	int evaluateRealXiPoints(const Fieldcache& cache, int numberOfPoints,
+		const double *xiValues, int valuesCount, double *valuesOut)
+	{
+		return cmzn_field_imagefilter_evaluate_real_xi_points(id, cache.getId(),
+			numberOfPoints, xiValues, valuesCount, valuesOut);
+	}
+
+};
+
 class FieldImagefilterBinaryDilate : public Field
 {
 
@@ -347,6 +347,62 @@ ZINC_API cmzn_field_id cmzn_graphics_get_tessellation_field(
 ZINC_API int cmzn_graphics_set_tessellation_field(cmzn_graphics_id graphics,
 	cmzn_field_id tessellation_field);
 
+/**
+ * Get the number of levels of detail the graphics may be rendered at.
+ *
+ * @param graphics  The graphics to query.
+ * @return  The number of levels of detail >= 1, or 0 if invalid argument.
+ */
+ZINC_API int cmzn_graphics_get_lod_levels_count(cmzn_graphics_id graphics);
+
+/**
+ * Set the number of levels of detail the graphics may be rendered at. Level
+ * 0 is the full detail graphics; each coarser level halves the element
+ * divisions from the tessellation down to a minimum of 1. Coarser levels are
+ * built on demand, incrementally with the render timeout, when a scene viewer
+ * renders the graphics with a projected size smaller than the LOD threshold,
+ * and are discarded when the graphics change or to fit the scene viewer's
+ * LOD memory budget. Until a wanted level is built, the nearest finer built
+ * level is drawn. Only affects graphics with a tessellation. Levels drawn in
+ * the current frame are kept even if they exceed the memory budget.
+ * Points and streamlines are unaffected by element divisions so may only
+ * have 1 level.
+ * The default is 1, meaning the graphics are always rendered at full detail.
+ * @see cmzn_graphics_set_lod_threshold
+ * @see cmzn_sceneviewer_set_lod_memory_budget
+ *
+ * @param graphics  The graphics to modify.
+ * @param levelsCount  The number of levels of detail, from 1 to 8; only 1
+ * for points and streamlines.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_set_lod_levels_count(cmzn_graphics_id graphics,
+	int levelsCount);
+
+/**
+ * Get the projected size below which the graphics are rendered at coarser
+ * levels of detail.
+ *
+ * @param graphics  The graphics to query.
+ * @return  The LOD threshold in pixels, or 0.0 if invalid argument.
+ */
+ZINC_API double cmzn_graphics_get_lod_threshold(cmzn_graphics_id graphics);
+
+/**
+ * Set the projected size below which the graphics are rendered at coarser
+ * levels of detail. The projected size is the larger of the width and height
+ * in pixels of the graphics' coordinate range on screen. The full detail
+ * graphics are drawn at or above the threshold, level 1 below it, level 2
+ * below half of it and so on, limited by the number of levels.
+ * The default threshold is 256.0 pixels.
+ *
+ * @param graphics  The graphics to modify.
+ * @param threshold  The LOD threshold in pixels > 0.0.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_set_lod_threshold(cmzn_graphics_id graphics,
+	double threshold);
+
 /**
  * Get the texture coordinate field of the graphics.
  * Caller must destroy handle.
@@ -708,6 +764,62 @@ ZINC_API int cmzn_graphics_contours_set_range_isovalues(
 	cmzn_graphics_contours_id contours, int number_of_isovalues,
 	double first_isovalue, double last_isovalue);
 
+/**
+ * Gets whether iso-surfaces are built with vertices shared between elements.
+ *
+ * @param contours  The contours graphics to query.
+ * @return  Boolean true if vertices are shared, false if not or invalid
+ * contours graphics.
+ */
+ZINC_API bool cmzn_graphics_contours_get_shared_vertices_flag(
+	cmzn_graphics_contours_id contours);
+
+/**
+ * Sets whether iso-surfaces on 3-D elements are built as a single indexed
+ * triangle mesh with vertices shared between neighbouring elements, averaging
+ * normals for smooth shading. Vertices are only shared across element faces
+ * if faces are defined on the mesh and the discretizations of the elements
+ * match on them. This removes cracks between elements and greatly reduces the
+ * number of vertices, but any change to the model rebuilds all iso-surfaces.
+ * Default is false: vertices are not shared and normals are flat.
+ *
+ * @param contours  The contours graphics to modify.
+ * @param shared_vertices_flag  Boolean true to share vertices, false to not.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_contours_set_shared_vertices_flag(
+	cmzn_graphics_contours_id contours, bool shared_vertices_flag);
+
+/**
+ * Gets the number of threads iso-surfaces with shared vertices are built with.
+ *
+ * @param contours  The contours graphics to query.
+ * @return  The number of threads, 0 meaning all context threads,
+ * or -1 if invalid contours graphics.
+ */
+ZINC_API int cmzn_graphics_contours_get_number_of_threads(
+	cmzn_graphics_contours_id contours);
+
+/**
+ * Sets the number of threads to build iso-surfaces with shared vertices with.
+ * With more than one thread, elements are swept concurrently then merged in
+ * element order, giving the same graphics as with one thread. Only use
+ * multiple threads if the coordinate, isoscalar, data and texture coordinate
+ * fields are safe to evaluate concurrently; this is true for finite element
+ * fields and most fields computed from them. Not used if vertices are not
+ * shared. Default is 1 thread.
+ * Threads are taken from the context's thread pool, so the number used is
+ * limited by the context number of threads.
+ * @see cmzn_graphics_contours_set_shared_vertices_flag
+ *
+ * @param contours  The contours graphics to modify.
+ * @param number_of_threads  The number of threads >= 0, where 0 uses all
+ * context threads.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_contours_set_number_of_threads(
+	cmzn_graphics_contours_id contours, int number_of_threads);
+
 /**
  * If the graphics is of type lines then this function returns
  * the derived lines graphics handle.
@@ -776,6 +888,36 @@ ZINC_C_INLINE cmzn_graphics_id cmzn_graphics_points_base_cast(cmzn_graphics_poin
  */
 ZINC_API int cmzn_graphics_points_destroy(cmzn_graphics_points_id *points_address);
 
+/**
+ * Gets the number of threads points on nodes or data points are built with.
+ *
+ * @param points  The points graphics to query.
+ * @return  The number of threads, 0 meaning all context threads,
+ * or -1 if invalid points graphics.
+ */
+ZINC_API int cmzn_graphics_points_get_number_of_threads(
+	cmzn_graphics_points_id points);
+
+/**
+ * Sets the number of threads to build points on nodes or data points with.
+ * With more than one thread, glyph positions, orientations, scales, data and
+ * labels are evaluated at different nodes concurrently then gathered in node
+ * order, giving the same graphics as with one thread. Only use multiple
+ * threads if the coordinate, orientation scale, signed scale, data, label and
+ * subgroup fields are safe to evaluate concurrently; this is true for finite
+ * element fields and most fields computed from them. Not used for other
+ * domain types. Default is 1 thread.
+ * Threads are taken from the context's thread pool, so the number used is
+ * limited by the context number of threads.
+ *
+ * @param points  The points graphics to modify.
+ * @param number_of_threads  The number of threads >= 0, where 0 uses all
+ * context threads.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_points_set_number_of_threads(
+	cmzn_graphics_points_id points, int number_of_threads);
+
 /**
  * If the graphics is of type streamlines then this function returns
  * the derived streamlines graphics handle.
@@ -945,6 +1087,34 @@ ZINC_API double cmzn_graphics_streamlines_get_track_length(
 ZINC_API int cmzn_graphics_streamlines_set_track_length(
 	cmzn_graphics_streamlines_id streamlines, double length);
 
+/**
+ * Gets the number of threads streamlines are tracked with.
+ *
+ * @param streamlines  The streamlines graphics to query.
+ * @return  The number of threads, 0 meaning all context threads,
+ * or -1 if invalid streamlines graphics.
+ */
+ZINC_API int cmzn_graphics_streamlines_get_number_of_threads(
+	cmzn_graphics_streamlines_id streamlines);
+
+/**
+ * Sets the number of threads to track streamlines with. With more than one
+ * thread, streamlines from different seed points are tracked concurrently then
+ * merged in seed order, giving the same graphics as with one thread.
+ * Only use multiple threads if the coordinate, stream vector and data fields
+ * are safe to evaluate concurrently; this is true for finite element fields
+ * and most fields computed from them. Default is 1 thread.
+ * Threads are taken from the context's thread pool, so the number used is
+ * limited by the context number of threads.
+ *
+ * @param streamlines  The streamlines graphics to modify.
+ * @param number_of_threads  The number of threads >= 0, where 0 uses all
+ * context threads.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_graphics_streamlines_set_number_of_threads(
+	cmzn_graphics_streamlines_id streamlines, int number_of_threads);
+
 /**
  * If the graphics is of type surfaces then this function returns
  * the derived surfaces graphics handle.
@@ -291,6 +291,26 @@ public:
 		return cmzn_graphics_set_tessellation_field(id, tessellationField.getId());
 	}
 
+	int getLodLevelsCount() const
+	{
+		return cmzn_graphics_get_lod_levels_count(id);
+	}
+
+	int setLodLevelsCount(int levelsCount)
+	{
+		return cmzn_graphics_set_lod_levels_count(id, levelsCount);
+	}
+
+	double getLodThreshold() const
+	{
+		return cmzn_graphics_get_lod_threshold(id);
+	}
+
+	int setLodThreshold(double threshold)
+	{
+		return cmzn_graphics_set_lod_threshold(id, threshold);
+	}
+
 	bool getVisibilityFlag() const
 	{
 		return cmzn_graphics_get_visibility_flag(id);
@@ -448,6 +468,26 @@ public:
 			numberOfValues, firstIsovalue, lastIsovalue);
 	}
 
+	bool getSharedVerticesFlag() const
+	{
+		return cmzn_graphics_contours_get_shared_vertices_flag(this->getDerivedId());
+	}
+
+	int setSharedVerticesFlag(bool sharedVerticesFlag)
+	{
+		return cmzn_graphics_contours_set_shared_vertices_flag(this->getDerivedId(), sharedVerticesFlag);
+	}
+
+	int getNumberOfThreads() const
+	{
+		return cmzn_graphics_contours_get_number_of_threads(this->getDerivedId());
+	}
+
+	int setNumberOfThreads(int numberOfThreads)
+	{
+		return cmzn_graphics_contours_set_number_of_threads(this->getDerivedId(), numberOfThreads);
+	}
+
 };
 
 class GraphicsLines : public Graphics
@@ -470,12 +510,27 @@ friend class Scene;
 private:
 	explicit GraphicsPoints(cmzn_graphics_id graphics_id) : Graphics(graphics_id) {}
 
+	inline cmzn_graphics_points_id getDerivedId() const
+	{
+		return reinterpret_cast<cmzn_graphics_points_id>(this->id);
+	}
+
 public:
 	GraphicsPoints() : Graphics(0) {}
 
 	explicit GraphicsPoints(cmzn_graphics_points_id points_id)
 		: Graphics(reinterpret_cast<cmzn_graphics_id>(points_id))
 	{}
+
+	int getNumberOfThreads() const
+	{
+		return cmzn_graphics_points_get_number_of_threads(this->getDerivedId());
+	}
+
+	int setNumberOfThreads(int numberOfThreads)
+	{
+		return cmzn_graphics_points_set_number_of_threads(this->getDerivedId(), numberOfThreads);
+	}
 };
 
 class GraphicsStreamlines : public Graphics
@@ -577,6 +632,16 @@ public:
 		return cmzn_graphics_streamlines_set_track_length(this->getDerivedId(), length);
 	}
 
+	int getNumberOfThreads() const
+	{
+		return cmzn_graphics_streamlines_get_number_of_threads(this->getDerivedId());
+	}
+
+	int setNumberOfThreads(int numberOfThreads)
+	{
+		return cmzn_graphics_streamlines_set_number_of_threads(this->getDerivedId(), numberOfThreads);
+	}
+
 };
 
 class GraphicsSurfaces : public Graphics
@@ -83,6 +83,44 @@ ZINC_API cmzn_mesh_id cmzn_mesh_access(cmzn_mesh_id mesh);
  */
 ZINC_API int cmzn_mesh_destroy(cmzn_mesh_id *mesh_address);
 
+/**
+ * Reclaim memory left by destroyed elements by renumbering the internal
+ * storage of remaining elements densely, moving all element data held by the
+ * mesh, its fields and groups. Element identifiers, field values and group
+ * membership are unchanged, but all element iterators for the mesh or its
+ * groups are invalidated. Consider calling after destroying a large fraction
+ * of the elements. Face meshes are not compacted by this call.
+ * Clients are notified of changes to all elements and fields.
+ *
+ * @param mesh  Handle to the mesh to compact. If a mesh group, its master
+ * mesh is compacted.
+ * @return  Result OK on success, ERROR_IN_USE if region is frozen, otherwise
+ * any other error code.
+ */
+ZINC_API int cmzn_mesh_compact(cmzn_mesh_id mesh);
+
+/**
+ * Reorder the internal storage of elements so elements close in space or
+ * connectivity are stored close together, improving memory locality when
+ * iterating over the mesh e.g. for integration or graphics. The mesh is
+ * compacted first. Element identifiers, iteration order (by identifier),
+ * field values and group membership are unchanged, but all element
+ * iterators for the mesh or its groups are invalidated.
+ * Clients are notified of changes to all elements and fields.
+ *
+ * @param mesh  Handle to the mesh to reorder. If a mesh group, its master
+ * mesh is reordered.
+ * @param coordinate_field  Field with 1 to 3 real components evaluated at
+ * element centres for space-filling curve orderings, or NULL/invalid for
+ * REVERSE_CUTHILL_MCKEE. Elements where it is not defined are stored last.
+ * @param ordering  The ordering to apply. REVERSE_CUTHILL_MCKEE connects
+ * elements sharing nodes in element field templates.
+ * @return  Result OK on success, ERROR_IN_USE if region is frozen,
+ * ERROR_ARGUMENT if invalid arguments, otherwise any other error code.
+ */
+ZINC_API int cmzn_mesh_reorder(cmzn_mesh_id mesh,
+	cmzn_field_id coordinate_field, enum cmzn_field_domain_ordering ordering);
+
 /**
  * Returns whether the element is from the mesh.
  *
@@ -74,6 +74,17 @@ public:
 
 	inline MeshGroup castGroup();
 
+	int compact()
+	{
+		return cmzn_mesh_compact(id);
+	}
+
+	int reorder(const Field& coordinateField, Field::DomainOrdering ordering)
+	{
+		return cmzn_mesh_reorder(id, coordinateField.getId(),
+			static_cast<cmzn_field_domain_ordering>(ordering));
+	}
+
 	bool containsElement(const Element& element) const
 	{
 		return cmzn_mesh_contains_element(id, element.getId());
@@ -77,6 +77,44 @@ ZINC_API cmzn_nodeset_id cmzn_nodeset_access(cmzn_nodeset_id nodeset);
  */
 ZINC_API int cmzn_nodeset_destroy(cmzn_nodeset_id *nodeset_address);
 
+/**
+ * Reclaim memory left by destroyed nodes by renumbering the internal storage
+ * of remaining nodes densely, moving all node data held by the nodeset, its
+ * groups, and meshes using or embedding its nodes. Node identifiers, field
+ * values and group membership are unchanged, but all node iterators for the
+ * nodeset or its groups are invalidated. Consider calling after destroying a
+ * large fraction of the nodes.
+ * Clients are notified of changes to all nodes and fields.
+ *
+ * @param nodeset  Handle to the nodeset to compact. If a nodeset group, its
+ * master nodeset is compacted.
+ * @return  Result OK on success, ERROR_IN_USE if region is frozen, otherwise
+ * any other error code.
+ */
+ZINC_API int cmzn_nodeset_compact(cmzn_nodeset_id nodeset);
+
+/**
+ * Reorder the internal storage of nodes so nodes close in space or
+ * connectivity are stored close together, improving memory locality when
+ * accessing nodes from neighbouring elements. The nodeset is compacted
+ * first. Node identifiers, iteration order (by identifier), field values and
+ * group membership are unchanged, but all node iterators for the nodeset or
+ * its groups are invalidated.
+ * Clients are notified of changes to all nodes and fields.
+ *
+ * @param nodeset  Handle to the nodeset to reorder. If a nodeset group, its
+ * master nodeset is reordered.
+ * @param coordinate_field  Field with 1 to 3 real components evaluated at
+ * nodes for space-filling curve orderings, or NULL/invalid for
+ * REVERSE_CUTHILL_MCKEE. Nodes where it is not defined are stored last.
+ * @param ordering  The ordering to apply. REVERSE_CUTHILL_MCKEE connects
+ * nodes used by the same element in any mesh.
+ * @return  Result OK on success, ERROR_IN_USE if region is frozen,
+ * ERROR_ARGUMENT if invalid arguments, otherwise any other error code.
+ */
+ZINC_API int cmzn_nodeset_reorder(cmzn_nodeset_id nodeset,
+	cmzn_field_id coordinate_field, enum cmzn_field_domain_ordering ordering);
+
 /**
  * Returns whether the node is from the nodeset.
  *
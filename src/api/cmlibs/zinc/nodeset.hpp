@@ -71,6 +71,17 @@ public:
 
 	inline NodesetGroup castGroup();
 
+	int compact()
+	{
+		return cmzn_nodeset_compact(id);
+	}
+
+	int reorder(const Field& coordinateField, Field::DomainOrdering ordering)
+	{
+		return cmzn_nodeset_reorder(id, coordinateField.getId(),
+			static_cast<cmzn_field_domain_ordering>(ordering));
+	}
+
 	bool containsNode(const Node& node) const
 	{
 		return cmzn_nodeset_contains_node(id, node.getId());
@@ -106,6 +106,51 @@ ZINC_API int cmzn_region_begin_hierarchical_change(cmzn_region_id region);
  */
 ZINC_API int cmzn_region_end_hierarchical_change(cmzn_region_id region);
 
+/**
+ * Begin or increment freeze level of region tree, during which fields in
+ * this region and its subregions may be evaluated concurrently from multiple
+ * threads, each using its own field cache created on that thread. Field
+ * caches and other handles such as iterators must not be shared between
+ * threads, and all regions containing fields evaluated, e.g. by apply fields,
+ * must be in the frozen tree so it is usual to freeze the root region.
+ * While frozen, the region tree must not be modified: setting region names,
+ * creating, adding or removing child regions, reading into regions, creating fields,
+ * creating, merging or destroying nodes and elements, and assigning field
+ * values all fail with CMZN_ERROR_IN_USE, except internal assignments made
+ * only to a field cache's own values. Other modifications are not
+ * checked but must not be made. Evaluating derivatives with respect to field
+ * parameters is not supported concurrently.
+ * Can be nested; must call region end freeze method for each begin freeze.
+ * @see cmzn_region_end_freeze
+ *
+ * @param region  The root of the region tree to freeze.
+ * @return  Status CMZN_OK on success, CMZN_ERROR_IN_USE if region is caching
+ * changes, any other value on failure.
+ */
+ZINC_API int cmzn_region_begin_freeze(cmzn_region_id region);
+
+/**
+ * Decrement freeze level of region tree. Region tree may be modified again
+ * once the freeze level of it and all its ancestors is zero.
+ * All threads evaluating fields in the region tree must have finished first.
+ * @see cmzn_region_begin_freeze
+ *
+ * @param region  The root of the region tree to end freeze on.
+ * @return  Status CMZN_OK on success, CMZN_ERROR_ARGUMENT if region is not
+ * frozen by begin freeze on it, any other value on failure.
+ */
+ZINC_API int cmzn_region_end_freeze(cmzn_region_id region);
+
+/**
+ * Query whether region is frozen for concurrent evaluation by begin freeze
+ * on it or any ancestor region.
+ * @see cmzn_region_begin_freeze
+ *
+ * @param region  The region to query.
+ * @return  Boolean true if region is frozen, otherwise false.
+ */
+ZINC_API bool cmzn_region_is_frozen(cmzn_region_id region);
+
 /**
  * Get the owning context for the region.
  *
@@ -501,6 +546,101 @@ ZINC_API int cmzn_regionnotifier_set_callback(
 ZINC_API void *cmzn_regionnotifier_get_callback_user_data(
 	cmzn_regionnotifier_id notifier);
 
+/**
+ * Create a transaction caching all changes to the region and its subregions
+ * until it is committed. Equivalent to a region hierarchical change which is
+ * ended on commit, but also records the time spent notifying clients.
+ * Changes to nodes, elements and fields are accumulated per domain and
+ * field, and each region notifier and field module notifier receives at most
+ * one merged event per region on commit.
+ * Transactions can be nested with each other and with hierarchical changes
+ * and changes on ancestor regions; notifications are only sent when the
+ * outermost is ended.
+ * @see cmzn_regiontransaction_commit
+ *
+ * @param region  The root of the region tree to cache changes in.
+ * @return  Handle to new region transaction, or NULL/invalid handle on failure.
+ */
+ZINC_API cmzn_regiontransaction_id cmzn_region_create_regiontransaction(
+	cmzn_region_id region);
+
+/**
+ * Returns a new handle to the region transaction with reference count
+ * incremented.
+ *
+ * @param transaction  The region transaction to obtain a new handle to.
+ * @return  New handle to region transaction, or NULL/invalid handle on failure.
+ */
+ZINC_API cmzn_regiontransaction_id cmzn_regiontransaction_access(
+	cmzn_regiontransaction_id transaction);
+
+/**
+ * Destroys handle to the region transaction and sets it to NULL.
+ * Internally this decrements the reference count. If this is the last
+ * handle and the transaction has not been committed, a warning is displayed
+ * and change caching is ended, but the transaction is not committed so no
+ * timings or event counts are recorded. Always commit transactions.
+ *
+ * @param transaction_address  Address of region transaction handle to destroy.
+ * @return  Result OK on success, otherwise ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_regiontransaction_destroy(
+	cmzn_regiontransaction_id *transaction_address);
+
+/**
+ * End caching changes and notify clients of all changes made since the
+ * transaction was created, recording the time taken.
+ *
+ * @param transaction  Handle to the region transaction.
+ * @return  Result OK on success, ERROR_ARGUMENT if invalid transaction,
+ * ERROR_ALREADY_EXISTS if already committed.
+ */
+ZINC_API int cmzn_regiontransaction_commit(
+	cmzn_regiontransaction_id transaction);
+
+/**
+ * Query whether the region transaction has been committed.
+ *
+ * @param transaction  Handle to the region transaction.
+ * @return  True if committed, false if not or invalid transaction.
+ */
+ZINC_API bool cmzn_regiontransaction_is_committed(
+	cmzn_regiontransaction_id transaction);
+
+/**
+ * Get the number of field module events sent to field module notifiers,
+ * including those of scenes, when the transaction was committed.
+ *
+ * @param transaction  Handle to the region transaction.
+ * @return  Number of events, or 0 if not committed or invalid transaction.
+ */
+ZINC_API int cmzn_regiontransaction_get_number_of_fieldmoduleevents(
+	cmzn_regiontransaction_id transaction);
+
+/**
+ * Get the number of region events sent to region notifiers when the
+ * transaction was committed.
+ *
+ * @param transaction  Handle to the region transaction.
+ * @return  Number of events, or 0 if not committed or invalid transaction.
+ */
+ZINC_API int cmzn_regiontransaction_get_number_of_regionevents(
+	cmzn_regiontransaction_id transaction);
+
+/**
+ * Get time spent in part of committing the region transaction. Times are
+ * only recorded if this is the outermost transaction or change on the region
+ * and its ancestors, otherwise they are zero as notification is deferred.
+ * Time in callbacks nested in other callbacks is only counted once.
+ *
+ * @param transaction  Handle to the region transaction.
+ * @param timing  The part of the commit to get time for.
+ * @return  Time in seconds, or 0.0 if not committed or invalid arguments.
+ */
+ZINC_API double cmzn_regiontransaction_get_timing(
+	cmzn_regiontransaction_id transaction,
+	enum cmzn_regiontransaction_timing timing);
+
 #ifdef __cplusplus
 }
 #endif
@@ -21,6 +21,7 @@ class Fieldmodule;
 class Scene;
 class StreaminformationRegion;
 class Regionnotifier;
+class Regiontransaction;
 
 class Region
 {
@@ -88,6 +89,23 @@ public:
 		return cmzn_region_end_hierarchical_change(id);
 	}
 
+	int beginFreeze()
+	{
+		return cmzn_region_begin_freeze(id);
+	}
+
+	int endFreeze()
+	{
+		return cmzn_region_end_freeze(id);
+	}
+
+	bool isFrozen() const
+	{
+		return cmzn_region_is_frozen(id);
+	}
+
+	inline Regiontransaction createRegiontransaction();
+
 	Region createChild(const char *name)
 	{
 		return Region(cmzn_region_create_child(id, name));
@@ -382,6 +400,95 @@ inline Regionnotifier Region::createRegionnotifier()
 	return Regionnotifier(cmzn_region_create_regionnotifier(id));
 }
 
+class Regiontransaction
+{
+protected:
+	cmzn_regiontransaction_id id;
+
+public:
+
+	Regiontransaction() : id(0)
+	{  }
+
+	// takes ownership of C handle, responsibility for destroying it
+	explicit Regiontransaction(cmzn_regiontransaction_id in_regiontransaction_id) :
+		id(in_regiontransaction_id)
+	{  }
+
+	Regiontransaction(const Regiontransaction& regiontransaction) :
+		id(cmzn_regiontransaction_access(regiontransaction.id))
+	{  }
+
+	Regiontransaction& operator=(const Regiontransaction& regiontransaction)
+	{
+		cmzn_regiontransaction_id temp_id = cmzn_regiontransaction_access(regiontransaction.id);
+		if (0 != id)
+		{
+			cmzn_regiontransaction_destroy(&id);
+		}
+		id = temp_id;
+		return *this;
+	}
+
+	~Regiontransaction()
+	{
+		if (0 != id)
+		{
+			cmzn_regiontransaction_destroy(&id);
+		}
+	}
+
+	enum Timing
+	{
+		TIMING_INVALID = CMZN_REGIONTRANSACTION_TIMING_INVALID,
+		TIMING_TOTAL = CMZN_REGIONTRANSACTION_TIMING_TOTAL,
+		TIMING_FIELD_CHANGES = CMZN_REGIONTRANSACTION_TIMING_FIELD_CHANGES,
+		TIMING_FIELDMODULE_CALLBACKS = CMZN_REGIONTRANSACTION_TIMING_FIELDMODULE_CALLBACKS,
+		TIMING_REGION_CALLBACKS = CMZN_REGIONTRANSACTION_TIMING_REGION_CALLBACKS
+	};
+
+	bool isValid() const
+	{
+		return (0 != id);
+	}
+
+	cmzn_regiontransaction_id getId() const
+	{
+		return id;
+	}
+
+	int commit()
+	{
+		return cmzn_regiontransaction_commit(id);
+	}
+
+	bool isCommitted()
+	{
+		return cmzn_regiontransaction_is_committed(id);
+	}
+
+	int getNumberOfFieldmoduleevents()
+	{
+		return cmzn_regiontransaction_get_number_of_fieldmoduleevents(id);
+	}
+
+	int getNumberOfRegionevents()
+	{
+		return cmzn_regiontransaction_get_number_of_regionevents(id);
+	}
+
+	double getTiming(Timing timing)
+	{
+		return cmzn_regiontransaction_get_timing(id,
+			static_cast<cmzn_regiontransaction_timing>(timing));
+	}
+};
+
+inline Regiontransaction Region::createRegiontransaction()
+{
+	return Regiontransaction(cmzn_region_create_regiontransaction(id));
+}
+
 }  // namespace Zinc
 }
 
@@ -78,6 +78,98 @@ ZINC_API double cmzn_sceneviewer_get_render_timeout(cmzn_sceneviewer_id scenevie
  */
 ZINC_API int cmzn_sceneviewer_set_render_timeout(cmzn_sceneviewer_id sceneviewer, double timeout);
 
+/**
+ * Get the memory budget for coarser graphics levels of detail cached for
+ * rendering in the scene viewer.
+ * @see cmzn_graphics_set_lod_levels_count
+ *
+ * @param sceneviewer  The scene viewer to query.
+ * @return  The memory budget in megabytes >= 0.0, or 0.0 if invalid argument.
+ */
+ZINC_API double cmzn_sceneviewer_get_lod_memory_budget(cmzn_sceneviewer_id sceneviewer);
+
+/**
+ * Set the memory budget for coarser graphics levels of detail cached for
+ * rendering in the scene viewer. After each render, coarser levels of all
+ * graphics the scene viewer has wanted them for are discarded, least recently
+ * used first, until their estimated memory is within the budget, including
+ * levels of graphics since drawn at full detail or not drawn at all; they are rebuilt if needed
+ * again. Levels drawn in the latest render are never discarded, so the budget
+ * may be exceeded if they need more. The full detail graphics are not counted
+ * and never discarded.
+ * The default memory budget is 256.0 megabytes.
+ *
+ * @param sceneviewer  The scene viewer to modify.
+ * @param budget  The memory budget in megabytes >= 0.0.
+ * @return  Result OK on success, or ERROR_ARGUMENT if invalid sceneviewer or
+ * budget.
+ */
+ZINC_API int cmzn_sceneviewer_set_lod_memory_budget(cmzn_sceneviewer_id sceneviewer, double budget);
+
+/**
+ * Query whether graphics being rebuilt incrementally over several renders are
+ * drawn partially built.
+ * @see cmzn_sceneviewer_set_render_timeout
+ *
+ * @param sceneviewer  The scene viewer to query.
+ * @return  Boolean true if partially built graphics are drawn, otherwise
+ * false. Also false if invalid sceneviewer.
+ */
+ZINC_API bool cmzn_sceneviewer_get_show_partial_graphics_flag(
+	cmzn_sceneviewer_id sceneviewer);
+
+/**
+ * Set whether graphics being rebuilt incrementally over several renders are
+ * drawn partially built. If false, graphics which were completely built
+ * before being changed continue to be drawn as before until the rebuild is
+ * complete, then the new graphics are drawn together, at the cost of holding
+ * both in memory meanwhile. A further change during the rebuild discards the
+ * partially built graphics and restarts the rebuild. Has no effect if
+ * incremental build is disabled by a negative render timeout.
+ * The default is true: partially built graphics are drawn.
+ * @see cmzn_sceneviewer_set_render_timeout
+ *
+ * @param sceneviewer  The scene viewer to modify.
+ * @param value  New value of show partial graphics flag.
+ * @return  Result OK on success, or ERROR_ARGUMENT if invalid sceneviewer.
+ */
+ZINC_API int cmzn_sceneviewer_set_show_partial_graphics_flag(
+	cmzn_sceneviewer_id sceneviewer, bool value);
+
+/**
+ * Query whether graphics are rebuilt on background threads where possible.
+ * @see cmzn_sceneviewer_set_build_in_background_flag
+ *
+ * @param sceneviewer  The scene viewer to query.
+ * @return  Boolean true if building graphics in the background, otherwise
+ * false. Also false if invalid sceneviewer.
+ */
+ZINC_API bool cmzn_sceneviewer_get_build_in_background_flag(
+	cmzn_sceneviewer_id sceneviewer);
+
+/**
+ * Set whether graphics are rebuilt on background threads where possible,
+ * so rendering is not held up by long rebuilds. Applies to lines, surfaces
+ * and contours on elements without adaptive tessellation; other graphics
+ * are built as before. Has no effect if incremental build is disabled by a
+ * negative render timeout.
+ * Each render waits up to the render timeout for background builds to
+ * finish, drawing the previously built graphics until the new graphics are
+ * swapped in; the scene viewer is redrawn until all builds are complete.
+ * The region is frozen while building; a build is stopped before the region
+ * or its ancestors are modified, or when the graphics are changed, and is
+ * restarted on the next render. Fields used by the graphics must be safe to
+ * evaluate concurrently with other field evaluations in the region.
+ * The default is false: graphics are built during render.
+ * @see cmzn_sceneviewer_set_render_timeout
+ *
+ * @param sceneviewer  The scene viewer to modify.
+ * @param value  New value of build in background flag.
+ * @return  Result OK on success, or ERROR_ARGUMENT if invalid sceneviewer.
+ */
+ZINC_API int cmzn_sceneviewer_set_build_in_background_flag(
+	cmzn_sceneviewer_id sceneviewer, bool value);
+
 /**
  * Gets the mouse and keyboard interaction mode of the scene viewer.
  * @see cmzn_sceneviewer_interact_mode
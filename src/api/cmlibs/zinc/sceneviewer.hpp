@@ -305,6 +305,36 @@ public:
 		return cmzn_sceneviewer_set_render_timeout(id, timeout);
 	}
 
+	double getLodMemoryBudget()
+	{
+		return cmzn_sceneviewer_get_lod_memory_budget(id);
+	}
+
+	int setLodMemoryBudget(double budget)
+	{
+		return cmzn_sceneviewer_set_lod_memory_budget(id, budget);
+	}
+
+	bool getShowPartialGraphicsFlag()
+	{
+		return cmzn_sceneviewer_get_show_partial_graphics_flag(id);
+	}
+
+	int setShowPartialGraphicsFlag(bool value)
+	{
+		return cmzn_sceneviewer_set_show_partial_graphics_flag(id, value);
+	}
+
+	bool getBuildInBackgroundFlag()
+	{
+		return cmzn_sceneviewer_get_build_in_background_flag(id);
+	}
+
+	int setBuildInBackgroundFlag(bool value)
+	{
+		return cmzn_sceneviewer_set_build_in_background_flag(id, value);
+	}
+
 	int setScene(const Scene& scene)
 	{
 		return cmzn_sceneviewer_set_scene(id, scene.getId());
@@ -46,7 +46,10 @@ public:
 		ATTRIBUTE_RAW_WIDTH_PIXELS = CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_RAW_WIDTH_PIXELS,
 		ATTRIBUTE_RAW_HEIGHT_PIXELS = CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_RAW_HEIGHT_PIXELS,
 		ATTRIBUTE_BITS_PER_COMPONENT = CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_BITS_PER_COMPONENT,
-		ATTRIBUTE_COMPRESSION_QUALITY = CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_COMPRESSION_QUALITY
+		ATTRIBUTE_COMPRESSION_QUALITY = CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_COMPRESSION_QUALITY,
+		ATTRIBUTE_RAW_DEPTH_PIXELS = CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_RAW_DEPTH_PIXELS,
+		ATTRIBUTE_CHUNK_SIZE_PIXELS = CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_CHUNK_SIZE_PIXELS,
+		ATTRIBUTE_CHUNK_MEMORY_BUDGET_MEGABYTES = CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_CHUNK_MEMORY_BUDGET_MEGABYTES
 	};
 
 	enum FileFormat
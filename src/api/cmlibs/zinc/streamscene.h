@@ -180,6 +180,40 @@ ZINC_API int cmzn_streaminformation_scene_get_number_of_time_steps(
 ZINC_API int cmzn_streaminformation_scene_set_number_of_time_steps(
 	cmzn_streaminformation_scene_id streaminformation,	int numberOfTimeSteps);
 
+/**
+ * Gets the number of threads time steps are exported with.
+ *
+ * @param streaminformation  The streaminformation_scene to query.
+ * @return  The number of threads, 0 meaning all context threads,
+ * or -1 if invalid streaminformation.
+ */
+ZINC_API int cmzn_streaminformation_scene_get_number_of_threads(
+	cmzn_streaminformation_scene_id streaminformation);
+
+/**
+ * Sets the number of threads to export time steps with. With more than one
+ * thread, time dependent lines, surfaces and contours without adaptive
+ * tessellation are built for all time steps concurrently, each time step on
+ * its own thread with its own copy of the graphics and field cache at that
+ * time, while the region is frozen. Graphics depending on time value fields
+ * and other graphics types are built at each time step in turn. The vertex,
+ * colour and normal morph targets of each time step are then formatted
+ * concurrently and written in time step order, giving output identical to
+ * export with one thread. Fields used by the graphics must be safe to
+ * evaluate concurrently.
+ * Only used for THREEJS export with more than one time step. Default is 1
+ * thread.
+ * Formatting threads are taken from the context's thread pool, and at most
+ * the context number of threads builds run at once when 0 is set.
+ *
+ * @param streaminformation  The streaminformation_scene to modify.
+ * @param numberOfThreads  The number of threads >= 0, where 0 uses all
+ * context threads.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_streaminformation_scene_set_number_of_threads(
+	cmzn_streaminformation_scene_id streaminformation, int numberOfThreads);
+
 /**
  * Get the last time step to export.
  *
@@ -336,6 +370,29 @@ ZINC_API int cmzn_streaminformation_scene_set_output_is_inline(
 	cmzn_streaminformation_scene_id streaminformation,
 	int outputIsInline);
 
+/**
+ * Get the flag which specifies if vertices at identical positions are welded.
+ *
+ * @param streaminformation  The streaminformation_scene to query.
+ * @return  1 if vertices are set to be welded, otherwise 0.
+ */
+ZINC_API int cmzn_streaminformation_scene_get_output_weld_vertices(
+	cmzn_streaminformation_scene_id streaminformation);
+
+/**
+ * Set the flag which specifies if vertices at identical positions are merged
+ * and shared by the faces using them, reducing output size. This option is
+ * only applicable to binary PLY export; STL has no shared vertices.
+ * The default value is 0.
+ *
+ * @param streaminformation  The streaminformation_scene to modify.
+ * @param outputWeldVertices  value to be assigned to the flag.
+ * @return  Status CMZN_OK on success, any other value on failure.
+ */
+ZINC_API int cmzn_streaminformation_scene_set_output_weld_vertices(
+	cmzn_streaminformation_scene_id streaminformation,
+	int outputWeldVertices);
+
 
 #ifdef __cplusplus
 }
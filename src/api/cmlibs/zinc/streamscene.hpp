@@ -56,7 +56,9 @@ public:
 		IO_FORMAT_THREEJS = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS,
         IO_FORMAT_DESCRIPTION = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION,
         IO_FORMAT_ASCII_STL = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_ASCII_STL,
-        IO_FORMAT_WAVEFRONT = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_WAVEFRONT
+        IO_FORMAT_WAVEFRONT = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_WAVEFRONT,
+        IO_FORMAT_BINARY_STL = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_STL,
+        IO_FORMAT_BINARY_PLY = CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_PLY
 	};
 
 	Scenefilter getScenefilter() const
@@ -101,6 +103,16 @@ public:
 		return cmzn_streaminformation_scene_set_number_of_time_steps(getDerivedId(), numberOfTimeSteps);
 	}
 
+	int getNumberOfThreads() const
+	{
+		return cmzn_streaminformation_scene_get_number_of_threads(getDerivedId());
+	}
+
+	int setNumberOfThreads(int numberOfThreads)
+	{
+		return cmzn_streaminformation_scene_set_number_of_threads(getDerivedId(), numberOfThreads);
+	}
+
 	double getFinishTime() const
 	{
 		return cmzn_streaminformation_scene_get_finish_time(getDerivedId());
@@ -174,6 +186,16 @@ public:
 	{
 		return cmzn_streaminformation_scene_set_output_is_inline(getDerivedId(), outputIsInline);
 	}
+
+	int getOutputWeldVertices() const
+	{
+		return cmzn_streaminformation_scene_get_output_weld_vertices(getDerivedId());
+	}
+
+	int setOutputWeldVertices(int outputWeldVertices)
+	{
+		return cmzn_streaminformation_scene_set_output_weld_vertices(getDerivedId(), outputWeldVertices);
+	}
 };
 
 inline StreaminformationScene Streaminformation::castScene()
@@ -259,6 +259,36 @@ ZINC_API char *cmzn_tessellation_get_name(cmzn_tessellation_id tessellation);
  */
 ZINC_API int cmzn_tessellation_set_name(cmzn_tessellation_id tessellation, const char *name);
 
+/**
+ * Gets the adaptive tolerance which, if positive, varies the divisions of
+ * surfaces and contours per element.
+ *
+ * @see cmzn_tessellation_set_adaptive_tolerance
+ * @param tessellation  The tessellation to query.
+ * @return  The adaptive tolerance, or 0.0 if not adaptive or invalid argument.
+ */
+ZINC_API double cmzn_tessellation_get_adaptive_tolerance(
+    cmzn_tessellation_id tessellation);
+
+/**
+ * Sets the adaptive tolerance which, if positive, varies the divisions of
+ * surfaces and contours per element between the minimum divisions and the
+ * minimum divisions multiplied by the refinement factors, so that the
+ * deviation of the coordinate field (or tessellation field if set on the
+ * graphics), and of the iso-scalar field for contours, from linear
+ * interpolation between samples is within the tolerance. Deviation is measured relative to the range of the field over
+ * the element, so e.g. 0.01 means within 1% of the element size.
+ * Divisions are made to agree across faces and lines shared by neighbouring
+ * elements so there are no cracks between them; faces must be defined on the
+ * mesh for this. The default value of 0.0 gives uniform tessellation.
+ *
+ * @param tessellation  The tessellation to modify.
+ * @param adaptiveTolerance  The relative tolerance >= 0.0, or 0.0 to turn off.
+ * @return  Status CMZN_OK on success, otherwise CMZN_ERROR_ARGUMENT.
+ */
+ZINC_API int cmzn_tessellation_set_adaptive_tolerance(
+    cmzn_tessellation_id tessellation, double adaptiveTolerance);
+
 /**
  * Gets the minimum number of line segments used to approximate curves in each
  * element dimension for coarse tessellation.
@@ -94,6 +94,16 @@ public:
 		return cmzn_tessellation_set_managed(id, value);
 	}
 
+	double getAdaptiveTolerance() const
+	{
+		return cmzn_tessellation_get_adaptive_tolerance(id);
+	}
+
+	int setAdaptiveTolerance(double adaptiveTolerance)
+	{
+		return cmzn_tessellation_set_adaptive_tolerance(id, adaptiveTolerance);
+	}
+
 	int getCircleDivisions() const
 	{
 		return cmzn_tessellation_get_circle_divisions(id);
@@ -156,6 +156,28 @@ enum cmzn_field_domain_type
  */
 typedef int cmzn_field_domain_types;
 
+/**
+ * An enumeration specifying how to order the internal storage of elements
+ * in a mesh or nodes in a nodeset for locality of access.
+ * @see cmzn_mesh_reorder
+ * @see cmzn_nodeset_reorder
+ */
+enum cmzn_field_domain_ordering
+{
+	CMZN_FIELD_DOMAIN_ORDERING_INVALID = 0,
+		/*!< Unspecified ordering */
+	CMZN_FIELD_DOMAIN_ORDERING_HILBERT = 1,
+		/*!< Order along a Hilbert space-filling curve through the coordinates
+		 * of element centres or nodes. Best spatial locality. */
+	CMZN_FIELD_DOMAIN_ORDERING_MORTON = 2,
+		/*!< Order along a Morton (Z-order) space-filling curve through the
+		 * coordinates of element centres or nodes. */
+	CMZN_FIELD_DOMAIN_ORDERING_REVERSE_CUTHILL_MCKEE = 3
+		/*!< Reverse Cuthill-McKee order of the graph of elements sharing nodes
+		 * or nodes sharing elements, minimising the spread of neighbouring
+		 * indexes. Does not use coordinates. */
+};
+
 /**
  * The types of values fields may produce.
  * @see cmzn_field_get_value_type
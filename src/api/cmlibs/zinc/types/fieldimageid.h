@@ -296,12 +296,33 @@ enum cmzn_streaminformation_image_attribute
 	/*!< Integer specifies the number of bytes per component for binary data using
 	 * this stream information. Only 8 and 16 bits are supported at the moment.
 	 */
-	CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_COMPRESSION_QUALITY = 4
+	CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_COMPRESSION_QUALITY = 4,
 	/*!< Real number specifies the quality for binary data using this stream information.
 	 * This parameter controls compression for compressed lossy formats,
 	 * where a quality of 1.0 specifies the least lossy output for a given format and a
 	 * quality of 0.0 specifies the most compression.
 	 */
+	CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_RAW_DEPTH_PIXELS = 5,
+	/*!< Integer specifies the pixel depth for binary data reading in using this
+	 * stream information. Only used for chunked reading. Default 1.
+	 */
+	CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_CHUNK_SIZE_PIXELS = 6,
+	/*!< Integer specifies the edge size in pixels of cubic chunks for reading
+	 * raw binary data out-of-core: chunks are read from the file or memory
+	 * buffer only when sampled and cached within a memory budget, so images
+	 * much larger than available memory can be evaluated. Requires the raw
+	 * width, height and optionally depth, bits per component and pixel format
+	 * to be set, with one file or memory resource holding pixels packed with
+	 * components fastest then x, y, z without row padding, and 16-bit
+	 * components in native byte order. Memory buffers are not copied and must
+	 * remain valid while the image uses them. Chunked images are not rendered
+	 * and cannot be written. Valid values are 4 to 1024; default 0 reads the
+	 * whole image into memory.
+	 */
+	CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_CHUNK_MEMORY_BUDGET_MEGABYTES = 7
+	/*!< Integer specifies the maximum memory in megabytes for caching chunks
+	 * of images read with chunk size set. Default 256.
+	 */
 };
 
 #endif
@@ -60,4 +60,20 @@ enum cmzn_field_imagefilter_threshold_condition
 		/*!< Assign where pixel values are outside the lower to upper threshold range */
 };
 
+/**
+ * How image filter field outputs are sampled between pixel centres.
+ */
+enum cmzn_field_imagefilter_interpolation_mode
+{
+	CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_INVALID = 0,
+		/*!< Unspecified imagefilter interpolation mode */
+	CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_NEAREST = 1,
+		/*!< Take value of pixel containing the location, with zero derivatives.
+		     This is the default interpolation mode. */
+	CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_LINEAR = 2,
+		/*!< Linear, bilinear or trilinear interpolation between pixel centres */
+	CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_CUBIC = 3
+		/*!< Catmull-Rom cubic interpolation between pixel centres */
+};
+
 #endif
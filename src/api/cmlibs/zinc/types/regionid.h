@@ -43,6 +43,37 @@ typedef struct cmzn_regionnotifier *cmzn_regionnotifier_id;
 typedef void(*cmzn_regionnotifier_callback_function)(
 	cmzn_regionevent_id event, void *client_data);
 
+/**
+ * @brief Caches all changes to a region tree until committed.
+ *
+ * A region transaction caches changes to a region and all its subregions
+ * from creation until commit, so each region notifier and field module
+ * notifier receives at most one merged event per region. Records time spent
+ * in notifying changes at commit.
+ */
+struct cmzn_regiontransaction;
+typedef struct cmzn_regiontransaction *cmzn_regiontransaction_id;
+
+/**
+ * Parts of the time spent committing a region transaction.
+ * @see cmzn_regiontransaction_get_timing
+ */
+enum cmzn_regiontransaction_timing
+{
+	CMZN_REGIONTRANSACTION_TIMING_INVALID = 0,
+	/*!< Invalid timing */
+	CMZN_REGIONTRANSACTION_TIMING_TOTAL = 1,
+	/*!< Total time to commit the transaction */
+	CMZN_REGIONTRANSACTION_TIMING_FIELD_CHANGES = 2,
+	/*!< Time merging domain changes, propagating field changes and clearing
+	 * field caches: total time less time in notifier callbacks */
+	CMZN_REGIONTRANSACTION_TIMING_FIELDMODULE_CALLBACKS = 3,
+	/*!< Time in field module notifier callbacks, including scenes updating
+	 * their graphics */
+	CMZN_REGIONTRANSACTION_TIMING_REGION_CALLBACKS = 4
+	/*!< Time in region notifier callbacks */
+};
+
 /**
  * @brief A region-specific stream information object.
  *
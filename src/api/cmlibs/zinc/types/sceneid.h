@@ -61,8 +61,13 @@ enum cmzn_streaminformation_scene_io_format
 	/*!< Import/export scene configurations into the scene */
     CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_ASCII_STL = 3,
     /*!< Export scene into STL text file.*/
-    CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_WAVEFRONT = 4
+    CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_WAVEFRONT = 4,
     /*!< Export scene into wavefront file.*/
+    CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_STL = 5,
+    /*!< Export surface triangles into binary STL file, streamed from graphics.*/
+    CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_PLY = 6
+    /*!< Export surface triangles into little endian binary PLY file, streamed
+     * from graphics, optionally with welded vertices.*/
 };
 
 #endif
@@ -15,6 +15,7 @@ SET( GENERAL_SRCS
   ${CMAKE_CURRENT_SOURCE_DIR}/general/error_handler.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/geometry.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/image_utilities.cpp
+  ${CMAKE_CURRENT_SOURCE_DIR}/general/index_ordering.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/indexed_multi_range.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/integration.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/io_stream.cpp
@@ -26,7 +27,9 @@ SET( GENERAL_SRCS
   ${CMAKE_CURRENT_SOURCE_DIR}/general/myio.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/mystring.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/octree.cpp
+  ${CMAKE_CURRENT_SOURCE_DIR}/general/performance_counters.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/statistics.cpp
+  ${CMAKE_CURRENT_SOURCE_DIR}/general/thread_pool.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/time.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/value.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/jsoncpp/jsoncpp.cpp
@@ -51,6 +54,7 @@ SET( GENERAL_HDRS
   ${CMAKE_CURRENT_SOURCE_DIR}/general/image_utilities.h
   ${CMAKE_CURRENT_SOURCE_DIR}/general/indexed_list_private.h
   ${CMAKE_CURRENT_SOURCE_DIR}/general/indexed_list_stl_private.hpp
+  ${CMAKE_CURRENT_SOURCE_DIR}/general/index_ordering.hpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/indexed_multi_range.h
   ${CMAKE_CURRENT_SOURCE_DIR}/general/integration.h
   ${CMAKE_CURRENT_SOURCE_DIR}/general/io_stream.h
@@ -69,11 +73,13 @@ SET( GENERAL_HDRS
   ${CMAKE_CURRENT_SOURCE_DIR}/general/mystring.h
   ${CMAKE_CURRENT_SOURCE_DIR}/general/object.h
   ${CMAKE_CURRENT_SOURCE_DIR}/general/octree.h
+  ${CMAKE_CURRENT_SOURCE_DIR}/general/performance_counters.hpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/random.h
   ${CMAKE_CURRENT_SOURCE_DIR}/general/refcounted.hpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/refhandle.hpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/simple_list.h
   ${CMAKE_CURRENT_SOURCE_DIR}/general/statistics.h
+  ${CMAKE_CURRENT_SOURCE_DIR}/general/thread_pool.hpp
   ${CMAKE_CURRENT_SOURCE_DIR}/general/time.h
   ${CMAKE_CURRENT_SOURCE_DIR}/general/value.h
   ${CMAKE_CURRENT_SOURCE_DIR}/jsoncpp/json.h
@@ -53,6 +53,7 @@ SET( GRAPHICS_SRCS
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/spectrum_component.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/tessellation.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/texture.cpp
+  ${CMAKE_CURRENT_SOURCE_DIR}/graphics/texture_brick_cache.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/texture_line.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/threejs_export.cpp
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/triangle_mesh.cpp
@@ -114,6 +115,7 @@ SET( GRAPHICS_HDRS
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/tessellation.hpp
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/texture.h
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/texture.hpp
+  ${CMAKE_CURRENT_SOURCE_DIR}/graphics/texture_brick_cache.hpp
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/texture_line.h
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/threejs_export.hpp
   ${CMAKE_CURRENT_SOURCE_DIR}/graphics/triangle_mesh.hpp
@@ -8,9 +8,11 @@
 # file, You can obtain one at http://mozilla.org/MPL/2.0/.
 
 SET( IMAGE_PROCESSING_SRCS
-  ${CMAKE_CURRENT_SOURCE_DIR}/image_processing/computed_field_image_resample.cpp )
+  ${CMAKE_CURRENT_SOURCE_DIR}/image_processing/computed_field_image_resample.cpp
+  ${CMAKE_CURRENT_SOURCE_DIR}/image_processing/native_image_filters.cpp )
 SET( IMAGE_PROCESSING_HDRS
-  ${CMAKE_CURRENT_SOURCE_DIR}/image_processing/computed_field_image_resample.h )
+  ${CMAKE_CURRENT_SOURCE_DIR}/image_processing/computed_field_image_resample.h
+  ${CMAKE_CURRENT_SOURCE_DIR}/image_processing/native_image_filters.hpp )
 
 IF( ZINC_USE_ITK )
 	SET( IMAGE_PROCESSING_SRCS ${IMAGE_PROCESSING_SRCS}
@@ -36,6 +36,7 @@ owned by field, of which Finite Element field is one type.
 #include "general/value.h"
 #include "general/message.h"
 #include "general/enumerator_conversion.hpp"
+#include <atomic>
 #include <typeinfo>
 
 /*
@@ -43,16 +44,35 @@ Module functions
 ----------------
 */
 
-/** override to set change status of fields which depend on changed fields */
+namespace {
+
+/* source of unique stamps for dependency updates, shared by all threads */
+std::atomic<unsigned int> lastDependencyCheckStamp(0);
+/* stamp of dependency update in progress on this thread, or 0 if none */
+thread_local unsigned int currentDependencyCheckStamp = 0;
+
+}
+
+/** override to set change status of fields which depend on changed fields.
+ * Each field's sources are checked once per update however many fields
+ * share them, so the cost is linear in the number of fields */
 inline void MANAGER_UPDATE_DEPENDENCIES(cmzn_field)(
 	struct MANAGER(cmzn_field) *manager)
 {
+	const unsigned int previousStamp = currentDependencyCheckStamp;
+	unsigned int stamp;
+	do
+	{
+		stamp = ++lastDependencyCheckStamp;
+	} while (stamp == 0);
+	currentDependencyCheckStamp = stamp;
 	cmzn_set_cmzn_field *all_fields = reinterpret_cast<cmzn_set_cmzn_field *>(manager->object_list);
 	for (cmzn_set_cmzn_field::iterator iter = all_fields->begin(); iter != all_fields->end(); iter++)
 	{
 		cmzn_field_id field = *iter;
 		field->core->check_dependency();
 	}
+	currentDependencyCheckStamp = previousStamp;
 }
 
 inline struct cmzn_field_change_detail *MANAGER_EXTRACT_CHANGE_DETAIL(cmzn_field)(
@@ -91,6 +111,7 @@ cmzn_field::cmzn_field() :
 	fieldparameters(nullptr),
 	manager(nullptr),
 	manager_change_status(MANAGER_CHANGE_NONE(cmzn_field)),
+	dependency_check_stamp(0),
 	attribute_flags(0),
 	access_count(1)
 {
@@ -139,14 +160,14 @@ void cmzn_field::deaccess(cmzn_field*& field_ref)
 	{
 		cmzn_field* field = field_ref;
 		field_ref = nullptr; // clear client's pointer ASAP in case manager message sent below
-		--(field->access_count);
-		if (field->access_count <= 0)
+		const int access_count = --(field->access_count);
+		if (access_count <= 0)
 		{
 			delete field;
 		}
 		else if ((0 == (field->attribute_flags & COMPUTED_FIELD_ATTRIBUTE_IS_MANAGED_BIT)) &&
-			(field->manager) && ((1 == field->access_count) ||
-			((2 == field->access_count) &&
+			(field->manager) && ((1 == access_count) ||
+			((2 == access_count) &&
 				(MANAGER_CHANGE_NONE(cmzn_field) != field->manager_change_status))) &&
 			field->core->not_in_use())
 		{
@@ -439,6 +460,10 @@ cmzn_field *Computed_field_create_generic(
 	{
 		int return_code = 1;
 		cmzn_region *region = cmzn_fieldmodule_get_region_internal(fieldmodule);
+		if (region->checkModify("Computed_field_create_generic") != CMZN_OK)
+		{
+			return_code = 0;
+		}
 		for (int i = 0; i < number_of_source_fields; i++)
 		{
 			if (NULL != source_fields[i])
@@ -1315,6 +1340,13 @@ int cmzn_field_assign_mesh_location(cmzn_field_id field,
 		(number_of_chart_coordinates >= get_FE_element_dimension(element)) &&
 		(CMZN_FIELD_VALUE_TYPE_MESH_LOCATION == cmzn_field_get_value_type(field)))
 	{
+		// assigning only in the cache does not modify the region so is allowed when frozen
+		if (!cache->assignInCacheOnly())
+		{
+			const int frozenResult = field->getRegion()->checkModify("cmzn_field_assign_mesh_location");
+			if (frozenResult != CMZN_OK)
+				return frozenResult;
+		}
 		MeshLocationFieldValueCache *valueCache = MeshLocationFieldValueCache::cast(field->getValueCache(*cache));
 		valueCache->setMeshLocation(element, chart_coordinates);
 		enum FieldAssignmentResult result = field->assign(*cache, *valueCache);
@@ -1331,6 +1363,12 @@ int cmzn_field_assign_real(cmzn_field_id field, cmzn_fieldcache_id cache,
 	if (cmzn_fieldcache_check(field, cache) && field->isNumerical() &&
 		(number_of_values >= field->number_of_components) && values)
 	{
+		if (!cache->assignInCacheOnly())
+		{
+			const int frozenResult = field->getRegion()->checkModify("cmzn_field_assign_real");
+			if (frozenResult != CMZN_OK)
+				return frozenResult;
+		}
 		RealFieldValueCache *valueCache = RealFieldValueCache::cast(field->getValueCache(*cache));
 		valueCache->setValues(values);
 		enum FieldAssignmentResult result = field->assign(*cache, *valueCache);
@@ -1347,6 +1385,12 @@ int cmzn_field_assign_string(cmzn_field_id field, cmzn_fieldcache_id cache,
 	if (cmzn_fieldcache_check(field, cache) && string_value &&
 		(CMZN_FIELD_VALUE_TYPE_STRING == cmzn_field_get_value_type(field)))
 	{
+		if (!cache->assignInCacheOnly())
+		{
+			const int frozenResult = field->getRegion()->checkModify("cmzn_field_assign_string");
+			if (frozenResult != CMZN_OK)
+				return frozenResult;
+		}
 		StringFieldValueCache *valueCache = StringFieldValueCache::cast(field->getValueCache(*cache));
 		valueCache->setString(string_value);
 		enum FieldAssignmentResult result = field->assign(*cache, *valueCache);
@@ -2268,7 +2312,7 @@ Writes the properties of the <field> to the command window.
 			display_message(INFORMATION_MESSAGE,"\n");
 		}
 		display_message(INFORMATION_MESSAGE,"  (access count = %d)\n",
-			field->access_count);
+			field->access_count.load());
 	}
 	else
 	{
@@ -2445,6 +2489,13 @@ int Computed_field_core::check_dependency()
 {
 	if (field)
 	{
+		if (currentDependencyCheckStamp)
+		{
+			// sources already checked in this dependency update
+			if (field->dependency_check_stamp == currentDependencyCheckStamp)
+				return field->manager_change_status;
+			field->dependency_check_stamp = currentDependencyCheckStamp;
+		}
 		if (0 == (field->manager_change_status & MANAGER_CHANGE_FULL_RESULT(cmzn_field)))
 		{
 			for (int i = 0; i < field->number_of_source_fields; i++)
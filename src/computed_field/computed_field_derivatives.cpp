@@ -588,6 +588,187 @@ int cmzn_field_derivative_set_xi_index(
 
 namespace {
 
+/** Get index of the derivative term for the directions in tuple whose bits
+ * are set in mask, ordered as in tuple with the first changing slowest. */
+inline int get_mesh_derivative_subtuple_index(int dimension, int order,
+	const int *tuple, int mask)
+{
+	int index = 0;
+	for (int k = 0; k < order; ++k)
+		if (mask & (1 << k))
+			index = index*dimension + tuple[k];
+	return index;
+}
+
+inline int get_mask_bit_count(int mask)
+{
+	int count = 0;
+	for (; mask; mask >>= 1)
+		count += mask & 1;
+	return count;
+}
+
+/**
+ * Determine whether mesh derivatives of the gradient of a field with respect
+ * to coordinateField can be evaluated analytically at the location in cache:
+ * must be a mesh-only derivative w.r.t. the mesh of a top-level element with
+ * the same dimension as the number of coordinate components, and be at least
+ * one order below the maximum mesh derivative order.
+ */
+bool gradient_mesh_derivatives_are_analytic(cmzn_fieldcache& cache,
+	cmzn_field *coordinateField, const FieldDerivative& fieldDerivative)
+{
+	const Field_location_element_xi *element_xi_location = cache.get_location_element_xi();
+	if (!element_xi_location)
+		return false;
+	cmzn_element *element = element_xi_location->get_element();
+	FE_mesh *mesh = element->getMesh();
+	return (fieldDerivative.isMeshOnly()) && (fieldDerivative.getMesh() == mesh)
+		&& (!mesh->getParentMesh())
+		&& (fieldDerivative.getMeshOrder() < MAXIMUM_MESH_DERIVATIVE_ORDER)
+		&& (element_xi_location->get_element_dimension() == coordinateField->number_of_components);
+}
+
+/**
+ * Evaluate mesh derivatives of the gradient of sourceField w.r.t. RC
+ * coordinateField analytically in a single pass. With J = dx/dxi and
+ * K = dxi/dx its inverse, gradient dS/dx = dS/dxi.K is differentiated by the
+ * product rule over all subsets of the derivative directions, with
+ * derivatives of K from differentiating K.J = I:
+ * D(K) = -sum(D'(K).D''(J)).K over proper subsets D' of D.
+ * Needs source and coordinate derivatives one order higher than fieldDerivative.
+ * Call only if gradient_mesh_derivatives_are_analytic returns true.
+ * @param derivatives  Array to receive derivatives of gradient: source
+ * components slowest, then coordinate components, then mesh derivative terms.
+ * @return  1 on success, 0 on failure. If dx/dxi cannot be inverted, as may
+ * happen at the apex of a heart, derivatives are set to zero with a warning.
+ */
+int evaluate_gradient_mesh_derivatives(cmzn_fieldcache& cache, cmzn_field *sourceField,
+	cmzn_field *coordinateField, const FieldDerivative& fieldDerivative, FE_value *derivatives)
+{
+	static_assert(MAXIMUM_MESH_DERIVATIVE_ORDER <= 3, "Increase size of dK array");
+	const int dimension = fieldDerivative.getMeshDimension();
+	const int meshOrder = fieldDerivative.getMeshOrder();
+	const int sourceComponentCount = sourceField->number_of_components;
+	FE_mesh *mesh = fieldDerivative.getMesh();
+	// term counts are powers of dimension
+	int termCounts[MAXIMUM_MESH_DERIVATIVE_ORDER + 1];
+	termCounts[0] = 1;
+	// derivatives of source and coordinates for orders 1 to meshOrder + 1
+	const FE_value *sourceDerivatives[MAXIMUM_MESH_DERIVATIVE_ORDER];
+	const FE_value *coordinateDerivatives[MAXIMUM_MESH_DERIVATIVE_ORDER];
+	for (int q = 1; q <= meshOrder + 1; ++q)
+	{
+		termCounts[q] = termCounts[q - 1]*dimension;
+		const FieldDerivative *orderDerivative = mesh->getFieldDerivative(q);
+		const DerivativeValueCache *sourceDerivativeCache = sourceField->evaluateDerivative(cache, *orderDerivative);
+		const DerivativeValueCache *coordinateDerivativeCache = coordinateField->evaluateDerivative(cache, *orderDerivative);
+		if (!((sourceDerivativeCache) && (coordinateDerivativeCache)))
+			return 0;
+		sourceDerivatives[q - 1] = sourceDerivativeCache->values;
+		coordinateDerivatives[q - 1] = coordinateDerivativeCache->values;
+	}
+	const int matrixSize = dimension*dimension;
+	// K and its derivatives for all term tuples up to meshOrder, in order
+	FE_value dK[1 + 3 + 9][9];
+	int orderOffsets[MAXIMUM_MESH_DERIVATIVE_ORDER];
+	orderOffsets[0] = 0;
+	for (int o = 1; o < meshOrder + 1; ++o)
+		orderOffsets[o] = orderOffsets[o - 1] + termCounts[o - 1];
+	bool inverted = false;
+	if (dimension == 3)
+		inverted = invert_matrix3(coordinateDerivatives[0], dK[0]);
+	else if (dimension == 2)
+		inverted = invert_matrix2(coordinateDerivatives[0], dK[0]);
+	else if (fabs(coordinateDerivatives[0][0]) > 0.0)
+	{
+		dK[0][0] = 1.0 / coordinateDerivatives[0][0];
+		inverted = true;
+	}
+	const int derivativeCount = sourceComponentCount*dimension*termCounts[meshOrder];
+	if (!inverted)
+	{
+		display_message(WARNING_MESSAGE,
+			"Gradient evaluate derivative.  Could not invert coordinate derivatives; setting derivatives to 0");
+		for (int v = 0; v < derivativeCount; ++v)
+			derivatives[v] = 0.0;
+		return 1;
+	}
+	const FE_value *K = dK[0];
+	int tuple[MAXIMUM_MESH_DERIVATIVE_ORDER];
+	FE_value sum[9];
+	for (int o = 1; o <= meshOrder; ++o)
+	{
+		const int fullMask = (1 << o) - 1;
+		for (int t = 0; t < termCounts[o]; ++t)
+		{
+			for (int k = 0; k < o; ++k)
+				tuple[k] = (t / termCounts[o - 1 - k]) % dimension;
+			for (int m = 0; m < matrixSize; ++m)
+				sum[m] = 0.0;
+			// sum D'(K).D''(J) over proper subsets D' of derivative directions
+			for (int mask = 0; mask < fullMask; ++mask)
+			{
+				const int s = get_mask_bit_count(mask);
+				const FE_value *dKs = dK[orderOffsets[s] + get_mesh_derivative_subtuple_index(dimension, o, tuple, mask)];
+				// D''(J) comes from coordinate derivatives of order r + 1
+				const int r = o - s;
+				const FE_value *dJr = coordinateDerivatives[r];
+				const int rIndex = get_mesh_derivative_subtuple_index(dimension, o, tuple, fullMask & ~mask);
+				for (int i = 0; i < dimension; ++i)
+					for (int l = 0; l < dimension; ++l)
+					{
+						FE_value value = 0.0;
+						for (int c = 0; c < dimension; ++c)
+							value += dKs[i*dimension + c]*dJr[c*termCounts[r + 1] + l*termCounts[r] + rIndex];
+						sum[i*dimension + l] += value;
+					}
+			}
+			FE_value *dKo = dK[orderOffsets[o] + t];
+			for (int i = 0; i < dimension; ++i)
+				for (int j = 0; j < dimension; ++j)
+				{
+					FE_value value = 0.0;
+					for (int l = 0; l < dimension; ++l)
+						value -= sum[i*dimension + l]*K[l*dimension + j];
+					dKo[i*dimension + j] = value;
+				}
+		}
+	}
+	// gradient derivatives: sum D'(dS/dxi).D''(K) over all subsets D' of derivative directions
+	const int termCount = termCounts[meshOrder];
+	const int fullMask = (1 << meshOrder) - 1;
+	for (int t = 0; t < termCount; ++t)
+	{
+		for (int k = 0; k < meshOrder; ++k)
+			tuple[k] = (t / termCounts[meshOrder - 1 - k]) % dimension;
+		for (int i = 0; i < sourceComponentCount; ++i)
+			for (int j = 0; j < dimension; ++j)
+				derivatives[(i*dimension + j)*termCount + t] = 0.0;
+		for (int mask = 0; mask <= fullMask; ++mask)
+		{
+			const int s = get_mask_bit_count(mask);
+			const int sIndex = get_mesh_derivative_subtuple_index(dimension, meshOrder, tuple, mask);
+			const int r = meshOrder - s;
+			const FE_value *dKr = dK[orderOffsets[r] + get_mesh_derivative_subtuple_index(dimension, meshOrder, tuple, fullMask & ~mask)];
+			// D'(dS/dxi) comes from source derivatives of order s + 1
+			const FE_value *dAs = sourceDerivatives[s];
+			for (int i = 0; i < sourceComponentCount; ++i)
+			{
+				const FE_value *dAsi = dAs + i*termCounts[s + 1] + sIndex;
+				for (int j = 0; j < dimension; ++j)
+				{
+					FE_value value = 0.0;
+					for (int k = 0; k < dimension; ++k)
+						value += dAsi[k*termCounts[s]]*dKr[k*dimension + j];
+					derivatives[(i*dimension + j)*termCount + t] += value;
+				}
+			}
+		}
+	}
+	return 1;
+}
+
 const char computed_field_curl_type_string[] = "curl";
 
 class Computed_field_curl : public Computed_field_core
@@ -627,10 +808,7 @@ private:
 
 	virtual int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
-	virtual int evaluateDerivative(cmzn_fieldcache& cache, RealFieldValueCache& inValueCache, const FieldDerivative& fieldDerivative)
-	{
-		return this->evaluateDerivativeFiniteDifference(cache, inValueCache, fieldDerivative);
-	}
+	virtual int evaluateDerivative(cmzn_fieldcache& cache, RealFieldValueCache& inValueCache, const FieldDerivative& fieldDerivative);
 
 	int list();
 
@@ -732,6 +910,33 @@ int Computed_field_curl::evaluate(cmzn_fieldcache& cache, FieldValueCache& inVal
 	return 0;
 }
 
+/**
+ * Evaluates derivatives of the curl analytically from derivatives of the
+ * vector field gradient if RC coordinates, otherwise by finite differences.
+ */
+int Computed_field_curl::evaluateDerivative(cmzn_fieldcache& cache, RealFieldValueCache& inValueCache, const FieldDerivative& fieldDerivative)
+{
+	cmzn_field_id coordinateField = this->getSourceField(1);
+	if (!((RECTANGULAR_CARTESIAN == coordinateField->coordinate_system.type)
+		&& gradient_mesh_derivatives_are_analytic(cache, coordinateField, fieldDerivative)))
+		return this->evaluateDerivativeFiniteDifference(cache, inValueCache, fieldDerivative);
+	FE_value gradientDerivatives[9*9];
+	if (!evaluate_gradient_mesh_derivatives(cache, this->getSourceField(0), coordinateField, fieldDerivative, gradientDerivatives))
+		return 0;
+	DerivativeValueCache *derivativeCache = inValueCache.getDerivativeValueCache(fieldDerivative);
+	const int termCount = derivativeCache->getTermCount();
+	FE_value *derivatives = derivativeCache->values;
+	// curl[i] = dV[i + 2]/dx[i + 1] - dV[i + 1]/dx[i + 2], indexes cycling
+	for (int i = 0; i < 3; ++i)
+	{
+		const FE_value *plus = gradientDerivatives + (((i + 2) % 3)*3 + (i + 1) % 3)*termCount;
+		const FE_value *minus = gradientDerivatives + (((i + 1) % 3)*3 + (i + 2) % 3)*termCount;
+		for (int t = 0; t < termCount; ++t)
+			derivatives[i*termCount + t] = plus[t] - minus[t];
+	}
+	return 1;
+}
+
 int Computed_field_curl::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -876,10 +1081,7 @@ private:
 
 	virtual int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
-	virtual int evaluateDerivative(cmzn_fieldcache& cache, RealFieldValueCache& inValueCache, const FieldDerivative& fieldDerivative)
-	{
-		return this->evaluateDerivativeFiniteDifference(cache, inValueCache, fieldDerivative);
-	}
+	virtual int evaluateDerivative(cmzn_fieldcache& cache, RealFieldValueCache& inValueCache, const FieldDerivative& fieldDerivative);
 
 	int list();
 
@@ -989,6 +1191,33 @@ int Computed_field_divergence::evaluate(cmzn_fieldcache& cache, FieldValueCache&
 	return 0;
 }
 
+/**
+ * Evaluates derivatives of the divergence analytically from derivatives of
+ * the vector field gradient if RC coordinates, otherwise by finite differences.
+ */
+int Computed_field_divergence::evaluateDerivative(cmzn_fieldcache& cache, RealFieldValueCache& inValueCache, const FieldDerivative& fieldDerivative)
+{
+	cmzn_field_id coordinateField = this->getSourceField(1);
+	if (!((RECTANGULAR_CARTESIAN == coordinateField->coordinate_system.type)
+		&& gradient_mesh_derivatives_are_analytic(cache, coordinateField, fieldDerivative)))
+		return this->evaluateDerivativeFiniteDifference(cache, inValueCache, fieldDerivative);
+	FE_value gradientDerivatives[9*9];
+	if (!evaluate_gradient_mesh_derivatives(cache, this->getSourceField(0), coordinateField, fieldDerivative, gradientDerivatives))
+		return 0;
+	DerivativeValueCache *derivativeCache = inValueCache.getDerivativeValueCache(fieldDerivative);
+	const int termCount = derivativeCache->getTermCount();
+	const int componentCount = coordinateField->number_of_components;
+	FE_value *derivatives = derivativeCache->values;
+	for (int t = 0; t < termCount; ++t)
+	{
+		FE_value sum = 0.0;
+		for (int i = 0; i < componentCount; ++i)
+			sum += gradientDerivatives[(i*componentCount + i)*termCount + t];
+		derivatives[t] = sum;
+	}
+	return 1;
+}
+
 int Computed_field_divergence::list()
 /*******************************************************************************
 LAST MODIFIED : 24 August 2006
@@ -1481,9 +1710,17 @@ int Computed_field_gradient::evaluateDerivative(cmzn_fieldcache& cache, RealFiel
 	const Field_location_element_xi* element_xi_location = cache.get_location_element_xi();
 	cmzn_field_id coordinateField = this->getSourceField(1);
 	const int coordinateOrder = coordinateField->getDerivativeTreeOrder(fieldDerivative);
-	if ((!element_xi_location) || (coordinateOrder > 1) || (coordinateOrder > fieldDerivative.getMeshOrder()))
+	if (!element_xi_location)
 		return this->evaluateDerivativeFiniteDifference(cache, inValueCache, fieldDerivative);
 	cmzn_field_id sourceField = this->getSourceField(0);
+	// all orders in one pass if dx/dxi is square and coordinates vary with derivative
+	if ((coordinateOrder > 0) && gradient_mesh_derivatives_are_analytic(cache, coordinateField, fieldDerivative))
+	{
+		DerivativeValueCache *derivativeCache = inValueCache.getDerivativeValueCache(fieldDerivative);
+		return evaluate_gradient_mesh_derivatives(cache, sourceField, coordinateField, fieldDerivative, derivativeCache->values);
+	}
+	if ((coordinateOrder > 1) || (coordinateOrder > fieldDerivative.getMeshOrder()))
+		return this->evaluateDerivativeFiniteDifference(cache, inValueCache, fieldDerivative);
 	const int sourceComponentCount = sourceField->number_of_components;
 	const int coordinateComponentCount = coordinateField->number_of_components;
 	cmzn_element* element = element_xi_location->get_element();
@@ -26,6 +26,7 @@ lookup of the element.
 #include "finite_element/finite_element_mesh_field_ranges.hpp"
 #include "finite_element/finite_element_region.h"
 #include "general/message.h"
+#include "general/performance_counters.hpp"
 #include "mesh/mesh.hpp"
 
 #define MAX_FIND_XI_ITERATIONS 50
@@ -64,6 +65,12 @@ int Computed_field_iterative_element_conditional(struct FE_element *element,
 
 	if (element && data)
 	{
+		if (cmzn::PerformanceCounters::isEnabled())
+		{
+			static cmzn::PerformanceCounter *elementTestCounter =
+				cmzn::PerformanceCounters::getCounter("find_xi", "element_tests");
+			elementTestCounter->increment();
+		}
 		const int number_of_xi = element->getDimension();
 		if (number_of_xi <= data->number_of_values)
 		{
@@ -1660,9 +1660,12 @@ cmzn_field_id cmzn_fieldmodule_create_field_finite_element_internal(
 	cmzn_fieldmodule_id field_module, enum Value_type value_type, int number_of_components)
 {
 	cmzn_field_id field = 0;
+	cmzn_region *region = cmzn_fieldmodule_get_region_internal(field_module);
+	// check first as the FE_field is added to the region before the wrapper
+	if (region->checkModify("cmzn_fieldmodule_create_field_finite_element") != CMZN_OK)
+		return nullptr;
 	// cache changes to ensure FE_field not automatically wrapped already
 	cmzn_fieldmodule_begin_change(field_module);
-	cmzn_region *region = cmzn_fieldmodule_get_region_internal(field_module);
 	FE_region *fe_region = region->get_FE_region();
 	// ensure FE_field and Computed_field have same name
 	char *fieldName = Computed_field_manager_get_unique_field_name(region->getFieldManager());
@@ -27,6 +27,8 @@
 #include "general/image_utilities.h"
 #include "graphics/material.hpp"
 #include "graphics/texture.h"
+#include "graphics/texture.hpp"
+#include "graphics/texture_brick_cache.hpp"
 #include "general/message.h"
 #include "computed_field/computed_field_image.h"
 #include "computed_field/computed_field_find_xi.h"
@@ -1073,6 +1075,52 @@ int cmzn_field_image_set_texture_coordinate_sizes(cmzn_field_image_id image,
 	return CMZN_ERROR_ARGUMENT;
 }
 
+int Computed_field_image_get_grid_values(struct Computed_field *field,
+	struct Computed_field *grid_coordinate_field, int dimension, const int *sizes,
+	ZnReal *values)
+{
+	Computed_field_image *image_core = (field) ? dynamic_cast<Computed_field_image*>(field->core) : 0;
+	if (!((image_core) && (0 < dimension) && (dimension <= 3) && (sizes) && (values)))
+		return 0;
+	Computed_field *texture_coordinate_field = field->source_fields[0];
+	if (grid_coordinate_field)
+	{
+		if (texture_coordinate_field != grid_coordinate_field)
+			return 0;
+	}
+	else if (!Computed_field_is_type_xi_coordinates(texture_coordinate_field, (void *)NULL))
+		return 0;
+	Texture *texture = image_core->get_texture();
+	int texture_dimension = 0;
+	int original_sizes[3];
+	ZnReal physical_sizes[3];
+	if ((!texture) || (!Texture_get_dimension(texture, &texture_dimension)) ||
+		(texture_dimension != dimension) ||
+		(Texture_get_number_of_components(texture) != field->number_of_components) ||
+		(!Texture_get_original_size(texture, &original_sizes[0], &original_sizes[1], &original_sizes[2])) ||
+		(!Texture_get_physical_size(texture, &physical_sizes[0], &physical_sizes[1], &physical_sizes[2])))
+		return 0;
+	for (int i = 0; i < 3; ++i)
+	{
+		// texel centres are only sampled exactly if texture coordinates span [0,1]
+		if ((original_sizes[i] != ((i < dimension) ? sizes[i] : 1)) ||
+			((i < dimension) && (physical_sizes[i] != 1.0)))
+			return 0;
+	}
+	if (!Texture_get_original_texel_values(texture, values))
+		return 0;
+	if ((image_core->minimum != 0.0) || (image_core->maximum != 1.0))
+	{
+		const ZnReal minimum = image_core->minimum;
+		const ZnReal range = image_core->maximum - image_core->minimum;
+		const size_t valuesCount = static_cast<size_t>(original_sizes[0])*original_sizes[1]*
+			original_sizes[2]*field->number_of_components;
+		for (size_t i = 0; i < valuesCount; ++i)
+			values[i] = minimum + values[i]*range;
+	}
+	return 1;
+}
+
 int Computed_field_is_image_type(struct Computed_field *field,
 	void *dummy_void)
 {
@@ -2118,3 +2166,66 @@ int cmzn_field_image_set_buffer(cmzn_field_image_id image_field, const void *buf
 	return CMZN_RESULT_ERROR_ARGUMENT;
 }
 
+int cmzn_field_image_get_number_of_chunk_levels(cmzn_field_image_id image_field)
+{
+	if (image_field)
+	{
+		TextureBrickCache *brick_cache = Texture_get_brick_cache(
+			cmzn_field_image_get_texture(image_field));
+		if (brick_cache)
+			return brick_cache->getLevelCount();
+	}
+	return 0;
+}
+
+int cmzn_field_image_get_chunk_level(cmzn_field_image_id image_field)
+{
+	if (image_field)
+		return Texture_get_brick_level(cmzn_field_image_get_texture(image_field));
+	return 0;
+}
+
+int cmzn_field_image_set_chunk_level(cmzn_field_image_id image_field, int level)
+{
+	if (image_field)
+	{
+		cmzn_texture *texture = cmzn_field_image_get_texture(image_field);
+		if (Texture_get_brick_level(texture) == level)
+			return (Texture_get_brick_cache(texture)) ? CMZN_OK : CMZN_ERROR_ARGUMENT;
+		if (Texture_set_brick_level(texture, level))
+		{
+			cmzn_field_image_base_cast(image_field)->setChanged();
+			return CMZN_OK;
+		}
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_field_image_get_chunk_memory_budget(cmzn_field_image_id image_field)
+{
+	if (image_field)
+	{
+		TextureBrickCache *brick_cache = Texture_get_brick_cache(
+			cmzn_field_image_get_texture(image_field));
+		if (brick_cache)
+			return static_cast<int>(brick_cache->getMemoryBudget()/(1024*1024));
+	}
+	return 0;
+}
+
+int cmzn_field_image_set_chunk_memory_budget(cmzn_field_image_id image_field,
+	int megabytes)
+{
+	if ((image_field) && (0 < megabytes))
+	{
+		TextureBrickCache *brick_cache = Texture_get_brick_cache(
+			cmzn_field_image_get_texture(image_field));
+		if (brick_cache)
+		{
+			brick_cache->setMemoryBudget(static_cast<size_t>(megabytes)*1024*1024);
+			return CMZN_OK;
+		}
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
@@ -50,6 +50,23 @@ int Computed_field_is_image_type(struct Computed_field *field,
 int cmzn_field_image_set_texture(cmzn_field_image_id image_field,
 		struct Texture *texture);
 
+/**
+ * If field is an image field whose texels are sampled exactly at their centres
+ * by a regular grid of pixels located at (index + 0.5)/size, gets the field
+ * values at all grid pixels directly from its texture. Used by image filters to
+ * bulk copy image inputs instead of evaluating the field at each pixel.
+ * @param grid_coordinate_field  Field set to the grid locations, which must be
+ * the image's texture coordinate field, or NULL if grid locations are element
+ * xi, for which the texture coordinate field must be the xi field.
+ * @param values  Array of size product of sizes times number of components of
+ * field to receive values, with component varying fastest, then x, y and z.
+ * @return  1 if values were obtained, 0 if not an image field sampled exactly by
+ * the grid.
+ */
+int Computed_field_image_get_grid_values(struct Computed_field *field,
+	struct Computed_field *grid_coordinate_field, int dimension, const int *sizes,
+	ZnReal *values);
+
 /***************************************************************************//**
  * A function to list information of the texture in an image field.
  */
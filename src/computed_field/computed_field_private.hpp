@@ -28,7 +28,9 @@ Types used only internally to computed fields.
 #include "computed_field/field_cache.hpp"
 #include "general/debug.h"
 #include "general/manager_private.h"
+#include "general/performance_counters.hpp"
 #include "region/cmiss_region.hpp"
+#include <atomic>
 
 /**
  * Base class of type-specific field change details.
@@ -403,11 +405,14 @@ struct cmzn_field
 	/* Keep a reference to the objects manager */
 	struct MANAGER(cmzn_field) *manager;
 	int manager_change_status;
+	// stamp of last manager dependency update which checked this field
+	unsigned int dependency_check_stamp;
 
 	/** bit flag attributes. @see Computed_field_attribute_flags. */
 	int attribute_flags;
 
-	int access_count;
+	// atomic as evaluation from concurrent threads in a frozen region accesses it
+	std::atomic_int access_count;
 
 protected:
 
@@ -807,11 +812,25 @@ inline const FieldValueCache *cmzn_field::evaluate(cmzn_fieldcache& cache)
 	if ((valueCache->evaluationCounter < cache.getLocationCounter())
 		|| cache.hasRegionModifications())
 	{
+		if (cmzn::PerformanceCounters::isEnabled())
+		{
+			static cmzn::PerformanceCounter *missCounter =
+				cmzn::PerformanceCounters::getCounter("fieldcache", "misses");
+			missCounter->increment();
+			cmzn::PerformanceCounters::getStaticNameCounter("field_evaluations",
+				this->core->get_type_string())->increment();
+		}
 		if (this->core->evaluate(cache, *valueCache))
 			valueCache->evaluationCounter = cache.getLocationCounter();
 		else
 			return nullptr;
 	}
+	else if (cmzn::PerformanceCounters::isEnabled())
+	{
+		static cmzn::PerformanceCounter *hitCounter =
+			cmzn::PerformanceCounters::getCounter("fieldcache", "hits");
+		hitCounter->increment();
+	}
 	return valueCache;
 }
 
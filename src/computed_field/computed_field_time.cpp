@@ -525,3 +525,16 @@ cmzn_field_id cmzn_fieldmodule_create_field_time_value(
 	return (field);
 }
 
+bool Computed_field_depends_on_time_value(cmzn_field *field)
+{
+	if (!field)
+		return false;
+	if (dynamic_cast<Computed_field_time_value*>(field->core))
+		return true;
+	for (int i = 0; i < field->number_of_source_fields; ++i)
+	{
+		if (Computed_field_depends_on_time_value(field->source_fields[i]))
+			return true;
+	}
+	return false;
+}
@@ -16,4 +16,12 @@ Implements computed fields that control the time behaviour.
 
 #include "time/time_keeper.hpp"
 
+struct cmzn_field;
+
+/**
+ * @return  True if field is or depends on a time value field, which evaluates
+ * to the time of its timekeeper rather than the time in the field cache.
+ */
+bool Computed_field_depends_on_time_value(cmzn_field *field);
+
 #endif /* !defined (COMPUTED_FIELD_TIME_H) */
@@ -23,21 +23,337 @@ Functions for updating values of one computed field from those of another.
 #include "computed_field/computed_field_finite_element.h"
 #include "computed_field/computed_field_update.h"
 #include "computed_field/field_cache.hpp"
+#include "computed_field/field_module.hpp"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_private.h"
 #include "finite_element/finite_element_region.h"
 #include "finite_element/finite_element_discretization.h"
 #include "general/debug.h"
 #include "general/message.h"
+#include "general/thread_pool.hpp"
 #include "mesh/mesh.hpp"
+#include <vector>
+
+namespace {
+
+/** Fields and settings common to all nodes in a nodeset field assignment */
+struct NodeAssignmentFields
+{
+	cmzn_field *destinationField;
+	cmzn_field *sourceField;
+	cmzn_field *conditionalField;  // optional
+	cmzn_field *dx_dX;  // optional gradient for transforming derivatives
+	FE_field *feField;  // set if destination is a finite element field
+	int componentCount;
+	FE_value time;
+};
+
+/**
+ * Source values evaluated at a node, staged for assignment to the destination
+ * field afterwards. Separating evaluation from assignment allows source values
+ * to be evaluated for many nodes concurrently with separate field caches, with
+ * assignments committed serially. Objects are reused between nodes to avoid
+ * reallocating buffers.
+ */
+class NodeAssignmentSourceValues
+{
+	cmzn_node *node;  // not accessed
+	bool selected;  // true if no conditional field or it is true at node
+	bool defined;  // true if selected and destination field is defined at node
+	int valueVersionsCount;
+	int evaluateValueVersionsCount;
+	int FCount;
+	// for finite element destination: coordinate arrays, source arrays, F arrays, each by version
+	// otherwise: source values only
+	std::vector<FE_value> valuesBuffer;
+
+public:
+
+	NodeAssignmentSourceValues() :
+		node(nullptr),
+		selected(false),
+		defined(false),
+		valueVersionsCount(0),
+		evaluateValueVersionsCount(0),
+		FCount(0)
+	{
+	}
+
+	bool isSelected() const
+	{
+		return this->selected;
+	}
+
+	bool isEvaluated() const
+	{
+		return this->evaluateValueVersionsCount > 0;
+	}
+
+	/** Evaluate conditional, source field and any dx_dX at node in fieldcache.
+	 * Only modifies values in fieldcache, hence safe to call concurrently with
+	 * different field caches provided no other changes are being made. */
+	void evaluate(cmzn_fieldcache *fieldcache, const NodeAssignmentFields& fields, cmzn_node *nodeIn);
+
+	/** Assign staged values to destination field at node.
+	 * @param fieldcache  Field cache to use for assigning non-finite element fields.
+	 * @param values, values2  Working arrays of size componentCount.
+	 * @return  True if any values were assigned. */
+	bool assign(cmzn_fieldcache *fieldcache, const NodeAssignmentFields& fields,
+		FE_value *values, FE_value *values2);
+};
+
+void NodeAssignmentSourceValues::evaluate(cmzn_fieldcache *fieldcache, const NodeAssignmentFields& fields, cmzn_node *nodeIn)
+{
+	this->node = nodeIn;
+	this->selected = false;
+	this->defined = false;
+	this->valueVersionsCount = 0;
+	this->evaluateValueVersionsCount = 0;
+	this->FCount = 0;
+	fieldcache->setNode(this->node);
+	if ((fields.conditionalField) && (!cmzn_field_evaluate_boolean(fields.conditionalField, fieldcache)))
+	{
+		return;
+	}
+	this->selected = true;
+	if (!cmzn_field_is_defined_at_location(fields.destinationField, fieldcache))
+	{
+		return;
+	}
+	this->defined = true;
+	const int componentCount = fields.componentCount;
+	if (!fields.feField)
+	{
+		this->valuesBuffer.resize(componentCount);
+		if (CMZN_OK == cmzn_field_evaluate_real(fields.sourceField, fieldcache, componentCount, this->valuesBuffer.data()))
+		{
+			this->valueVersionsCount = this->evaluateValueVersionsCount = 1;
+		}
+		return;
+	}
+	const FE_node_field *node_field = this->node->getNodeField(fields.feField);
+	if (!node_field)
+	{
+		return;
+	}
+	const FE_value time = fields.time;
+	const int FSize = componentCount*componentCount;
+	this->valueVersionsCount = node_field->getValueMaximumVersionsCount(CMZN_NODE_VALUE_LABEL_VALUE);
+	// buffer for storing values for all versions for value and F = dx/dX for transforming derivatives
+	this->valuesBuffer.resize((componentCount*2 + FSize)*this->valueVersionsCount);
+	FE_value *coordinateArrays = this->valuesBuffer.data();
+	FE_value *sourceArrays = coordinateArrays + componentCount*this->valueVersionsCount;
+	FE_value *FArrays = sourceArrays + componentCount*this->valueVersionsCount;
+	// get destination coordinate value versions
+	for (int v = 0; v < this->valueVersionsCount; ++v)
+	{
+		const int result = get_FE_nodal_FE_value_value(this->node, fields.feField, /*componentNumber*/-1,
+			CMZN_NODE_VALUE_LABEL_VALUE, v, time, coordinateArrays + v*componentCount);
+		if ((result == CMZN_WARNING_PART_DONE) && (v > 0))
+		{
+			// fall back to version 1 for undefined components
+			for (int c = 0; c < componentCount; ++c)
+			{
+				const FE_node_field_template *component = node_field->getComponent(c);
+				if (component->getValueNumberOfVersions(CMZN_NODE_VALUE_LABEL_VALUE) < (v + 1))
+				{
+					(coordinateArrays + v*componentCount)[c] = coordinateArrays[c];
+				}
+			}
+		}
+		else if (result != CMZN_OK)
+		{
+			break;
+		}
+		++this->evaluateValueVersionsCount;
+	}
+	const bool evaluateDerivatives = (node_field->getMaximumDerivativeNumber() > 0) && (fields.dx_dX);
+	if (this->evaluateValueVersionsCount > 0)
+	{
+		// evaluate dx_dX before assigning value as original value is used in finite difference calculation
+		for (int v = 0; v < this->evaluateValueVersionsCount; ++v)
+		{
+			if (v > 0)
+			{
+				fieldcache->setAssignInCacheOnly(true);
+				cmzn_field_assign_real(fields.destinationField, fieldcache, componentCount, coordinateArrays + v*componentCount);
+			}
+			if (CMZN_OK != cmzn_field_evaluate_real(fields.sourceField, fieldcache, componentCount, sourceArrays + v*componentCount))
+			{
+				this->evaluateValueVersionsCount = v;
+				break;
+			}
+			if (evaluateDerivatives && (CMZN_OK == cmzn_field_evaluate_real(fields.dx_dX, fieldcache, FSize, FArrays + v*FSize)))
+			{
+				++this->FCount;
+			}
+		}
+		fieldcache->setAssignInCacheOnly(false);
+	}
+}
+
+bool NodeAssignmentSourceValues::assign(cmzn_fieldcache *fieldcache, const NodeAssignmentFields& fields,
+	FE_value *values, FE_value *values2)
+{
+	if (this->evaluateValueVersionsCount <= 0)
+	{
+		return false;
+	}
+	const int componentCount = fields.componentCount;
+	if (!fields.feField)
+	{
+		fieldcache->setNode(this->node);
+		return (CMZN_OK == cmzn_field_assign_real(fields.destinationField, fieldcache, componentCount, this->valuesBuffer.data()));
+	}
+	const FE_node_field *node_field = this->node->getNodeField(fields.feField);
+	const FE_value time = fields.time;
+	const int FSize = componentCount*componentCount;
+	const FE_value *sourceArrays = this->valuesBuffer.data() + componentCount*this->valueVersionsCount;
+	const FE_value *FArrays = sourceArrays + componentCount*this->valueVersionsCount;
+	int assign_count = 0;
+	int result = CMZN_OK;
+	// assign source values to destination
+	for (int v = 0; v < this->valueVersionsCount; ++v)
+	{
+		const FE_value *sourceValues = (v < this->evaluateValueVersionsCount) ? sourceArrays + v*componentCount : sourceArrays;
+		result = set_FE_nodal_FE_value_value(this->node, fields.feField, /*componentNumber*/-1,
+			CMZN_NODE_VALUE_LABEL_VALUE, v, time, sourceValues);
+		if ((result == CMZN_OK) || (result == CMZN_WARNING_PART_DONE))
+		{
+			result = CMZN_OK;
+			++assign_count;
+		}
+		else
+		{
+			break;
+		}
+	}
+	if ((this->FCount > 0) && (result == CMZN_OK))
+	{
+		const int maximumDerivativeNumber = node_field->getMaximumDerivativeNumber();
+		for (int d = 1; d <= maximumDerivativeNumber; ++d)
+		{
+			const cmzn_node_value_label valueLabel = static_cast<cmzn_node_value_label>(CMZN_NODE_VALUE_LABEL_VALUE + d);
+			const int derivativeVersionsCount = node_field->getValueMaximumVersionsCount(valueLabel);
+			for (int v = 0; v < derivativeVersionsCount; ++v)
+			{
+				result = get_FE_nodal_FE_value_value(this->node, fields.feField, /*componentNumber*/-1, valueLabel, v, time, values);
+				if ((result == CMZN_OK) || (result == CMZN_WARNING_PART_DONE))
+				{
+					// transform derivative by F = dx/dX
+					// assume same version of value & F as derivative, falling back to version 1
+					// may need to provide control in future
+					const FE_value *F = (v < this->FCount) ? FArrays + v*FSize : FArrays;
+					for (int c2 = 0; c2 < componentCount; ++c2)
+					{
+						const FE_value *f = F + c2*componentCount;
+						double sum = 0.0;
+						for (int c = 0; c < componentCount; ++c)
+						{
+							sum += f[c]*values[c];
+						}
+						values2[c2] = sum;
+					}
+					result = set_FE_nodal_FE_value_value(this->node, fields.feField, /*componentNumber*/-1,
+						valueLabel, v, time, values2);
+					if ((result == CMZN_OK) || (result == CMZN_WARNING_PART_DONE))
+					{
+						result = CMZN_OK;
+						++assign_count;
+					}
+					else
+					{
+						break;
+					}
+				}
+			}
+			if (result != CMZN_OK)
+			{
+				break;
+			}
+		}
+	}
+	return (assign_count > 0) && (result == CMZN_OK);
+}
+
+/**
+ * Evaluate source values for nodes on thread pool threads, each with its own
+ * field cache, then assign them serially in node order. Nodes are processed in
+ * batches so staging memory is bounded; each batch is evaluated after the
+ * previous batch has been assigned, as in serial evaluation.
+ * @param threadCount  Maximum number of threads, 0 for all pool threads.
+ * @param assignFieldcache  Field cache for assigning non-finite element fields,
+ * also giving time for evaluation.
+ */
+void nodeset_assign_real_field_from_source_parallel(cmzn_nodeset *nodeset,
+	const NodeAssignmentFields& fields, cmzn::ThreadPool& threadPool, int threadCount,
+	cmzn_fieldcache *assignFieldcache, int& selected_count, int& success_count)
+{
+	std::vector<cmzn_node *> nodes;
+	nodes.reserve(cmzn_nodeset_get_size(nodeset));
+	cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
+	cmzn_node_id node = 0;
+	while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
+	{
+		nodes.push_back(node);
+	}
+	cmzn_nodeiterator_destroy(&iterator);
+	const size_t nodesCount = nodes.size();
+	if (nodesCount == 0)
+	{
+		return;
+	}
+	const size_t chunkSize = 256;
+	threadCount = threadPool.getLoopThreadCount(threadCount, (nodesCount + chunkSize - 1)/chunkSize);
+	cmzn_fieldcache *evaluateFieldcache = cmzn_fieldcache::create(assignFieldcache->getRegion());
+	evaluateFieldcache->setTime(assignFieldcache->getTime());
+	FieldcacheThreadSet fieldcaches(evaluateFieldcache, threadCount);
+	fieldcaches.createValueCaches(fields.destinationField);
+	fieldcaches.createValueCaches(fields.sourceField);
+	fieldcaches.createValueCaches(fields.conditionalField);
+	fieldcaches.createValueCaches(fields.dx_dX);
+	const size_t batchSize = chunkSize*16*threadCount;
+	std::vector<NodeAssignmentSourceValues> sourceValuesBatch((nodesCount < batchSize) ? nodesCount : batchSize);
+	FE_value *values = new FE_value[fields.componentCount*2];
+	FE_value *values2 = values + fields.componentCount;
+	for (size_t batchStart = 0; batchStart < nodesCount; batchStart += batchSize)
+	{
+		const size_t batchNodesCount = ((nodesCount - batchStart) < batchSize) ? nodesCount - batchStart : batchSize;
+		threadPool.parallelFor(static_cast<size_t>(0), batchNodesCount, chunkSize, threadCount,
+			[&](size_t chunkStart, size_t chunkEnd, int threadIndex)
+			{
+				cmzn_fieldcache *fieldcache = fieldcaches.getFieldcache(threadIndex);
+				for (size_t i = chunkStart; i < chunkEnd; ++i)
+				{
+					sourceValuesBatch[i].evaluate(fieldcache, fields, nodes[batchStart + i]);
+				}
+			});
+		for (size_t i = 0; i < batchNodesCount; ++i)
+		{
+			NodeAssignmentSourceValues& sourceValues = sourceValuesBatch[i];
+			if (sourceValues.isSelected())
+			{
+				if (sourceValues.assign(assignFieldcache, fields, values, values2))
+				{
+					++success_count;
+				}
+				++selected_count;
+			}
+		}
+	}
+	delete[] values;
+	cmzn_fieldcache::deaccess(evaluateFieldcache);
+}
+
+}
 
 int cmzn_nodeset_assign_field_from_source(
 	cmzn_nodeset_id nodeset, cmzn_field_id destination_field,
 	cmzn_field_id source_field, cmzn_field_id conditional_field,
-	FE_value time)
+	FE_value time, int threadCount)
 {
 	int return_code = CMZN_OK;
-	if (nodeset && destination_field && source_field)
+	if (nodeset && destination_field && source_field && (threadCount >= 0))
 	{
 		cmzn_field_value_type value_type = cmzn_field_get_value_type(destination_field);
 		if (value_type == CMZN_FIELD_VALUE_TYPE_MESH_LOCATION)
@@ -99,63 +415,103 @@ int cmzn_nodeset_assign_field_from_source(
 			FE_value *values2 = values + componentCount;
 			// all fields evaluated at same time so set once
 			cmzn_fieldcache_set_time(fieldcache, time);
-			cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
-			cmzn_node_id node = 0;
 			int selected_count = 0;
 			int success_count = 0;
-			while ((return_code == CMZN_OK) && (0 != (node = cmzn_nodeiterator_next_non_access(iterator))))
+			// real values evaluated from a computed source field are staged so they can be evaluated in parallel
+			const bool stageSourceValues = (value_type == CMZN_FIELD_VALUE_TYPE_REAL) && (!((feField) && (sourceFeField)));
+			NodeAssignmentFields fields = { destination_field, source_field, conditional_field, dx_dX, feField, componentCount, time };
+			cmzn::ThreadPool& threadPool = cmzn_fieldmodule_get_region_internal(fieldmodule)->getThreadPool();
+			if (stageSourceValues && (threadPool.getLoopThreadCount(threadCount, cmzn_nodeset_get_size(nodeset)) > 1))
 			{
-				cmzn_fieldcache_set_node(fieldcache, node);
-				if ((!conditional_field) || cmzn_field_evaluate_boolean(conditional_field, fieldcache))
+				nodeset_assign_real_field_from_source_parallel(nodeset, fields, threadPool, threadCount,
+					fieldcache, selected_count, success_count);
+			}
+			else
+			{
+				NodeAssignmentSourceValues sourceValues;
+				cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
+				cmzn_node_id node = 0;
+				while ((return_code == CMZN_OK) && (0 != (node = cmzn_nodeiterator_next_non_access(iterator))))
 				{
-					if ((cmzn_field_is_defined_at_location(destination_field, fieldcache)))
+					if (stageSourceValues)
 					{
-						switch (value_type)
+						sourceValues.evaluate(fieldcache, fields, node);
+						if (sourceValues.isSelected())
 						{
-						case CMZN_FIELD_VALUE_TYPE_MESH_LOCATION:
+							if (sourceValues.assign(fieldcache, fields, values, values2))
 							{
-								FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
-								cmzn_element_id element = cmzn_field_evaluate_mesh_location(
-									source_field, fieldcache, MAXIMUM_ELEMENT_XI_DIMENSIONS, xi);
-								if (element)
+								++success_count;
+							}
+							++selected_count;
+						}
+						continue;
+					}
+					cmzn_fieldcache_set_node(fieldcache, node);
+					if ((!conditional_field) || cmzn_field_evaluate_boolean(conditional_field, fieldcache))
+					{
+						if ((cmzn_field_is_defined_at_location(destination_field, fieldcache)))
+						{
+							switch (value_type)
+							{
+							case CMZN_FIELD_VALUE_TYPE_MESH_LOCATION:
 								{
-									if ((CMZN_OK == cmzn_field_assign_mesh_location(destination_field, fieldcache,
-										element, MAXIMUM_ELEMENT_XI_DIMENSIONS, xi)))
+									FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+									cmzn_element_id element = cmzn_field_evaluate_mesh_location(
+										source_field, fieldcache, MAXIMUM_ELEMENT_XI_DIMENSIONS, xi);
+									if (element)
 									{
-										++success_count;
+										if ((CMZN_OK == cmzn_field_assign_mesh_location(destination_field, fieldcache,
+											element, MAXIMUM_ELEMENT_XI_DIMENSIONS, xi)))
+										{
+											++success_count;
+										}
+										cmzn_element_destroy(&element);
 									}
-									cmzn_element_destroy(&element);
-								}
-							} break;
-						case CMZN_FIELD_VALUE_TYPE_REAL:
-							{
-								if (feField)
+								} break;
+							case CMZN_FIELD_VALUE_TYPE_REAL:
 								{
-									const FE_node_field *node_field = node->getNodeField(feField);
-									if (node_field)
+									// special case for assigning finite element parameters directly
+									const FE_node_field *node_field = (feField) ? node->getNodeField(feField) : nullptr;
+									const FE_node_field *source_node_field = (node_field) ? node->getNodeField(sourceFeField) : nullptr;
+									if (source_node_field)
 									{
 										int assign_count = 0;
 										int result = CMZN_OK;
 										const int maximumDerivativeNumber = node_field->getMaximumDerivativeNumber();
-										if (sourceFeField)
+										for (int d = 0; d <= maximumDerivativeNumber; ++d)
 										{
-											// special case for assigning finite element parameters directly
-											const FE_node_field *source_node_field = node->getNodeField(sourceFeField);
-											if (source_node_field)
+											const cmzn_node_value_label valueLabel = static_cast<cmzn_node_value_label>(CMZN_NODE_VALUE_LABEL_VALUE + d);
+											const int versionsCount = node_field->getValueMaximumVersionsCount(valueLabel);
+											for (int v = 0; v < versionsCount; ++v)
 											{
-												for (int d = 0; d <= maximumDerivativeNumber; ++d)
+												result = get_FE_nodal_FE_value_value(node, sourceFeField, /*componentNumber*/-1, valueLabel, v, time, values);
+												if (result == CMZN_OK)
 												{
-													const cmzn_node_value_label valueLabel = static_cast<cmzn_node_value_label>(CMZN_NODE_VALUE_LABEL_VALUE + d);
-													const int versionsCount = node_field->getValueMaximumVersionsCount(valueLabel);
-													for (int v = 0; v < versionsCount; ++v)
+													result = set_FE_nodal_FE_value_value(node, feField, /*componentNumber*/-1, valueLabel, v, time, values);
+													if ((result == CMZN_OK) || (result == CMZN_WARNING_PART_DONE))
 													{
-														result = get_FE_nodal_FE_value_value(node, sourceFeField, /*componentNumber*/-1, valueLabel, v, time, values);
-														if (result == CMZN_OK)
+														result = CMZN_OK;
+														++assign_count;
+													}
+													else if (result == CMZN_ERROR_NOT_FOUND)
+													{
+														result = CMZN_OK;
+													}
+													else
+													{
+														break;
+													}
+												}
+												else if (result == CMZN_WARNING_PART_DONE)
+												{
+													// assign components individually
+													for (int c = 0; c < componentCount; ++c)
+													{
+														if (v < source_node_field->getComponent(c)->getValueNumberOfVersions(valueLabel))
 														{
-															result = set_FE_nodal_FE_value_value(node, feField, /*componentNumber*/-1, valueLabel, v, time, values);
-															if ((result == CMZN_OK) || (result == CMZN_WARNING_PART_DONE))
+															result = set_FE_nodal_FE_value_value(node, feField, c, valueLabel, v, time, values + c);
+															if (result == CMZN_OK)
 															{
-																result = CMZN_OK;
 																++assign_count;
 															}
 															else if (result == CMZN_ERROR_NOT_FOUND)
@@ -167,214 +523,55 @@ int cmzn_nodeset_assign_field_from_source(
 																break;
 															}
 														}
-														else if (result == CMZN_WARNING_PART_DONE)
-														{
-															// assign components individually
-															for (int c = 0; c < componentCount; ++c)
-															{
-																if (v < source_node_field->getComponent(c)->getValueNumberOfVersions(valueLabel))
-																{
-																	result = set_FE_nodal_FE_value_value(node, feField, c, valueLabel, v, time, values + c);
-																	if (result == CMZN_OK)
-																	{
-																		++assign_count;
-																	}
-																	else if (result == CMZN_ERROR_NOT_FOUND)
-																	{
-																		result = CMZN_OK;
-																	}
-																	else
-																	{
-																		break;
-																	}
-																}
-															}
-															if (result != CMZN_OK)
-															{
-																break;
-															}
-														}
 													}
 													if (result != CMZN_OK)
 													{
 														break;
 													}
 												}
-												if (result != CMZN_OK)
-												{
-													display_message(ERROR_MESSAGE,
-														"cmzn_nodeset_assign_field_from_source.  Failed to evaluate or assign from finite element node field.");
-													return_code = result;
-												}
-											}
-										}
-										else
-										{
-											const int FSize = componentCount*componentCount;
-											int valueVersionsCount = node_field->getValueMaximumVersionsCount(CMZN_NODE_VALUE_LABEL_VALUE);
-											// buffer for storing values for all versions for value and F = dx/dX for transforming derivatives
-											FE_value *valuesBuffer = new double[(componentCount*2 + FSize)*valueVersionsCount];
-											FE_value *coordinateArrays = valuesBuffer;
-											FE_value *sourceArrays = coordinateArrays + componentCount*valueVersionsCount;
-											FE_value *FArrays = sourceArrays + componentCount*valueVersionsCount;
-											if (!valuesBuffer)
-											{
-												display_message(ERROR_MESSAGE,
-													"cmzn_nodeset_assign_field_from_source.  Failed to allocate real valuesBuffer.");
-												return_code = result = CMZN_ERROR_MEMORY;
-											}
-											int evaluateValueVersionsCount = 0;
-											if (return_code == CMZN_OK)
-											{
-												// get destination coordinate value versions
-												for (int v = 0; v < valueVersionsCount; ++v)
-												{
-													result = get_FE_nodal_FE_value_value(node, feField, /*componentNumber*/-1,
-														CMZN_NODE_VALUE_LABEL_VALUE, v, time, coordinateArrays + v*componentCount);
-													if ((result == CMZN_WARNING_PART_DONE) && (v > 0))
-													{
-														// fall back to version 1 for undefined components
-														for (int c = 0; c < componentCount; ++c)
-														{
-															const FE_node_field_template *component = node_field->getComponent(c);
-															if (component->getValueNumberOfVersions(CMZN_NODE_VALUE_LABEL_VALUE) < (v + 1))
-															{
-																(coordinateArrays + v*componentCount)[c] = coordinateArrays[c];
-															}
-														}
-													}
-													else if (result != CMZN_OK)
-													{
-														break;
-													}
-													++evaluateValueVersionsCount;
-												}
 											}
-											int FCount = 0;
-											const bool evaluateDerivatives = (maximumDerivativeNumber > 0) && (dx_dX);
-											if ((evaluateValueVersionsCount > 0) && (return_code == CMZN_OK))
+											if (result != CMZN_OK)
 											{
-												// evaluate dx_dX before assigning value as original value is used in finite difference calculation
-												for (int v = 0; v < evaluateValueVersionsCount; ++v)
-												{
-													if (v > 0)
-													{
-														fieldcache->setAssignInCacheOnly(true);
-														cmzn_field_assign_real(destination_field, fieldcache, componentCount, coordinateArrays + v*componentCount);
-													}
-													if (CMZN_OK != cmzn_field_evaluate_real(source_field, fieldcache, componentCount, sourceArrays + v*componentCount))
-													{
-														evaluateValueVersionsCount = v;
-														break;
-													}
-													if (evaluateDerivatives && (CMZN_OK == cmzn_field_evaluate_real(dx_dX, fieldcache, FSize, FArrays + v*FSize)))
-													{
-														++FCount;
-													}
-												}
-												fieldcache->setAssignInCacheOnly(false);
+												break;
 											}
-											if ((evaluateValueVersionsCount > 0) && (return_code == CMZN_OK))
-											{
-												// evaluate source values and assign to destination
-												for (int v = 0; v < valueVersionsCount; ++v)
-												{
-													const FE_value *sourceValues = (v < evaluateValueVersionsCount) ? sourceArrays + v*componentCount : sourceArrays;
-													result = set_FE_nodal_FE_value_value(node, feField, /*componentNumber*/-1,
-														CMZN_NODE_VALUE_LABEL_VALUE, v, time, sourceValues);
-													if ((result == CMZN_OK) || (result == CMZN_WARNING_PART_DONE))
-													{
-														result = CMZN_OK;
-														++assign_count;
-													}
-													else
-													{
-														break;
-													}
-												}
-												if ((FCount > 0) && (result == CMZN_OK))
-												{
-													for (int d = 1; d <= maximumDerivativeNumber; ++d)
-													{
-														const cmzn_node_value_label valueLabel = static_cast<cmzn_node_value_label>(CMZN_NODE_VALUE_LABEL_VALUE + d);
-														const int derivativeVersionsCount = node_field->getValueMaximumVersionsCount(valueLabel);
-														for (int v = 0; v < derivativeVersionsCount; ++v)
-														{
-															result = get_FE_nodal_FE_value_value(node, feField, /*componentNumber*/-1, valueLabel, v, time, values);
-															if ((result == CMZN_OK) || (result == CMZN_WARNING_PART_DONE))
-															{
-																// transform derivative by F = dx/dX
-																// assume same version of value & F as derivative, falling back to version 1
-																// may need to provide control in future
-																const FE_value *F = (v < FCount) ? FArrays + v*FSize : FArrays;
-																for (int c2 = 0; c2 < componentCount; ++c2)
-																{
-																	const FE_value *f = F + c2*componentCount;
-																	double sum = 0.0;
-																	for (int c = 0; c < componentCount; ++c)
-																	{
-																		sum += f[c]*values[c];
-																	}
-																	values2[c2] = sum;
-																}
-																result = set_FE_nodal_FE_value_value(node, feField, /*componentNumber*/-1,
-																	valueLabel, v, time, values2);
-																if ((result == CMZN_OK) || (result == CMZN_WARNING_PART_DONE))
-																{
-																	result = CMZN_OK;
-																	++assign_count;
-																}
-																else
-																{
-																	break;
-																}
-															}
-														}
-														if (result != CMZN_OK)
-														{
-															break;
-														}
-													}
-												}
-											}
-											delete[] valuesBuffer;
+										}
+										if (result != CMZN_OK)
+										{
+											display_message(ERROR_MESSAGE,
+												"cmzn_nodeset_assign_field_from_source.  Failed to evaluate or assign from finite element node field.");
+											return_code = result;
 										}
 										if ((assign_count > 0) && (result == CMZN_OK))
 										{
 											++success_count;
 										}
 									}
-								}
-								else if ((CMZN_OK == cmzn_field_evaluate_real(source_field, fieldcache, componentCount, values))
-									&& (CMZN_OK == cmzn_field_assign_real(destination_field, fieldcache, componentCount, values)))
-								{
-									++success_count;
-								}
-							} break;
-						case CMZN_FIELD_VALUE_TYPE_STRING:
-							{
-								char *string_value = cmzn_field_evaluate_string(source_field, fieldcache);
-								if (string_value)
+								} break;
+							case CMZN_FIELD_VALUE_TYPE_STRING:
 								{
-									if ((CMZN_OK == cmzn_field_assign_string(destination_field, fieldcache, string_value)))
+									char *string_value = cmzn_field_evaluate_string(source_field, fieldcache);
+									if (string_value)
 									{
-										++success_count;
+										if ((CMZN_OK == cmzn_field_assign_string(destination_field, fieldcache, string_value)))
+										{
+											++success_count;
+										}
+										DEALLOCATE(string_value);
 									}
-									DEALLOCATE(string_value);
-								}
-							} break;
-						default:
-							{
-								display_message(ERROR_MESSAGE,
-									"cmzn_nodeset_assign_field_from_source.  Unsupported value type.");
-								return_code = CMZN_ERROR_NOT_IMPLEMENTED;
-							} break;
+								} break;
+							default:
+								{
+									display_message(ERROR_MESSAGE,
+										"cmzn_nodeset_assign_field_from_source.  Unsupported value type.");
+									return_code = CMZN_ERROR_NOT_IMPLEMENTED;
+								} break;
+							}
 						}
+						++selected_count;
 					}
-					++selected_count;
 				}
+				cmzn_nodeiterator_destroy(&iterator);
 			}
-			cmzn_nodeiterator_destroy(&iterator);
 			if (success_count != selected_count)
 			{
 				display_message(WARNING_MESSAGE,
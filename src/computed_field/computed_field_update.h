@@ -35,13 +35,19 @@ Global types
  * @param conditional_field  If supplied, only assigns to nodes for which this
  * field evaluates to true. If NULL, assigns to all nodes in nodeset.
  * @param time  The time to assign values at
+ * @param threadCount  Number of threads to evaluate real source fields with:
+ * 1 for serial evaluation, 0 to use all hardware threads. When using multiple
+ * threads, source values for batches of nodes are evaluated concurrently with
+ * separate field caches, then assigned serially in node order. This gives the
+ * same result as serial assignment provided source values at each node do not
+ * depend on destination values at other nodes in the same batch.
  * @return  Result OK on success, WARNING_PART_DONE if only some values assigned,
  * otherwise any other error.
  */
 int cmzn_nodeset_assign_field_from_source(
 	cmzn_nodeset_id nodeset, cmzn_field_id destination_field,
 	cmzn_field_id source_field, cmzn_field_id conditional_field,
-	FE_value time);
+	FE_value time, int threadCount = 1);
 
 /*******************************************************************************
  * Assign values of source field to grid-based destination field for elements in
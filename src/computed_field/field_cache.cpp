@@ -10,6 +10,8 @@
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include <cstdio>
+#include <set>
+#include <utility>
 #include "cmlibs/zinc/field.h"
 #include "computed_field/computed_field_find_xi.h"
 #include "computed_field/field_module.hpp"
@@ -401,3 +403,52 @@ int cmzn_fieldcache_set_assign_in_cache(cmzn_fieldcache_id cache, int assign_in_
 	return 1;
 }
 
+namespace {
+
+/**
+ * Create value caches for field and its source fields in cache. Source fields
+ * are also given value caches in the shared working cache and any external
+ * cache they may be evaluated in; these are created here if not already.
+ * @param visited  Set of cache, field pairs already processed.
+ */
+void fieldcache_create_value_caches_recursive(cmzn_fieldcache& cache, cmzn_field *field,
+	std::set<std::pair<cmzn_fieldcache *, cmzn_field *> >& visited)
+{
+	if ((field->getRegion() != cache.getRegion()) ||
+		(!visited.insert(std::make_pair(&cache, field)).second))
+	{
+		return;
+	}
+	FieldValueCache *valueCache = field->getValueCache(cache);
+	if (0 == field->number_of_source_fields)
+	{
+		return;
+	}
+	cmzn_fieldcache *externalCache = valueCache->getExtraCache();
+	cmzn_fieldcache *workingCache = cache.getOrCreateSharedWorkingCache();
+	for (int i = 0; i < field->number_of_source_fields; ++i)
+	{
+		cmzn_field *sourceField = field->source_fields[i];
+		fieldcache_create_value_caches_recursive(cache, sourceField, visited);
+		fieldcache_create_value_caches_recursive(*workingCache, sourceField, visited);
+		if ((externalCache) && (externalCache != workingCache))
+		{
+			fieldcache_create_value_caches_recursive(*externalCache, sourceField, visited);
+		}
+	}
+}
+
+}
+
+void FieldcacheThreadSet::createValueCaches(cmzn_field *field)
+{
+	if (!field)
+	{
+		return;
+	}
+	std::set<std::pair<cmzn_fieldcache *, cmzn_field *> > visited;
+	for (size_t t = 0; t < this->fieldcaches.size(); ++t)
+	{
+		fieldcache_create_value_caches_recursive(*(this->fieldcaches[t]), field, visited);
+	}
+}
@@ -696,4 +696,53 @@ public:
 
 };
 
+/**
+ * Field caches for each thread of a thread pool loop. Thread 0 uses the
+ * supplied cache; others get new caches for the same region at the same time.
+ * Call createValueCaches for each field to be evaluated before starting the
+ * loop, as creating value and working caches is not thread safe.
+ */
+class FieldcacheThreadSet
+{
+	std::vector<cmzn_fieldcache *> fieldcaches;
+
+public:
+	FieldcacheThreadSet(cmzn_fieldcache *fieldcache, int threadCount) :
+		fieldcaches((threadCount > 1) ? threadCount : 1, fieldcache)
+	{
+		for (size_t t = 1; t < this->fieldcaches.size(); ++t)
+		{
+			this->fieldcaches[t] = cmzn_fieldcache::create(fieldcache->getRegion());
+			this->fieldcaches[t]->setTime(fieldcache->getTime());
+		}
+	}
+
+	~FieldcacheThreadSet()
+	{
+		for (size_t t = 1; t < this->fieldcaches.size(); ++t)
+			cmzn_fieldcache::deaccess(this->fieldcaches[t]);
+	}
+
+	FieldcacheThreadSet(const FieldcacheThreadSet&) = delete;
+	FieldcacheThreadSet& operator=(const FieldcacheThreadSet&) = delete;
+
+	int getThreadCount() const
+	{
+		return static_cast<int>(this->fieldcaches.size());
+	}
+
+	cmzn_fieldcache *getFieldcache(int threadIndex) const
+	{
+		return this->fieldcaches[threadIndex];
+	}
+
+	/**
+	 * Create value caches in all thread caches for the field and all fields it
+	 * depends on, including in the working caches they may be evaluated in.
+	 * @param field  Field to evaluate in loop. Ignored if nullptr.
+	 */
+	void createValueCaches(cmzn_field *field);
+
+};
+
 #endif /* !defined (FIELD_CACHE_HPP) */
@@ -25,6 +25,7 @@ cmzn_fieldassignment::cmzn_fieldassignment(cmzn_field *targetFieldIn, cmzn_field
 	sourceField(cmzn_field_access(sourceFieldIn)),
 	conditionalField(0),
 	nodeset(0),
+	threadCount(1),
 	access_count(1)
 {
 }
@@ -58,7 +59,7 @@ int cmzn_fieldassignment::assign()
 	cmzn_nodeset *useNodeset = (this->nodeset) ? cmzn_nodeset_access(this->nodeset)
 		: cmzn_fieldmodule_find_nodeset_by_field_domain_type(fm, CMZN_FIELD_DOMAIN_TYPE_NODES);
 	const int result = cmzn_nodeset_assign_field_from_source(useNodeset,
-		this->targetField, this->sourceField, this->conditionalField, /*time*/0.0);
+		this->targetField, this->sourceField, this->conditionalField, /*time*/0.0, this->threadCount);
 	if ((result != CMZN_RESULT_OK)
 		&& (result != CMZN_RESULT_WARNING_PART_DONE)
 		&& (result != CMZN_RESULT_ERROR_NOT_FOUND))
@@ -110,6 +111,17 @@ int cmzn_fieldassignment::setNodeset(cmzn_nodeset *nodesetIn)
 	return CMZN_RESULT_OK;
 }
 
+int cmzn_fieldassignment::setNumberOfThreads(int numberOfThreads)
+{
+	if (numberOfThreads < 0)
+	{
+		display_message(ERROR_MESSAGE, "Fieldassignment setNumberOfThreads:  Invalid number of threads");
+		return CMZN_RESULT_ERROR_ARGUMENT;
+	}
+	this->threadCount = numberOfThreads;
+	return CMZN_RESULT_OK;
+}
+
 /*
 Global functions
 ----------------
@@ -186,6 +198,28 @@ int cmzn_fieldassignment_set_nodeset(
 	return CMZN_RESULT_ERROR_ARGUMENT;
 }
 
+int cmzn_fieldassignment_get_number_of_threads(
+	cmzn_fieldassignment_id fieldassignment)
+{
+	if (fieldassignment)
+	{
+		return fieldassignment->getNumberOfThreads();
+	}
+	display_message(ERROR_MESSAGE, "Fieldassignment getNumberOfThreads:  Invalid field assignment object");
+	return -1;
+}
+
+int cmzn_fieldassignment_set_number_of_threads(
+	cmzn_fieldassignment_id fieldassignment, int numberOfThreads)
+{
+	if (fieldassignment)
+	{
+		return fieldassignment->setNumberOfThreads(numberOfThreads);
+	}
+	display_message(ERROR_MESSAGE, "Fieldassignment setNumberOfThreads:  Invalid field assignment object");
+	return CMZN_RESULT_ERROR_ARGUMENT;
+}
+
 cmzn_field_id cmzn_fieldassignment_get_source_field(
 	cmzn_fieldassignment_id fieldassignment)
 {
@@ -24,6 +24,7 @@ private:
 	cmzn_field *sourceField;
 	cmzn_field *conditionalField;
 	cmzn_nodeset *nodeset;
+	int threadCount;
 	int access_count;
 
 	cmzn_fieldassignment(cmzn_field *targetFieldIn, cmzn_field *sourceFieldIn);
@@ -75,6 +76,13 @@ public:
 
 	int setNodeset(cmzn_nodeset *nodesetIn);
 
+	int getNumberOfThreads() const
+	{
+		return this->threadCount;
+	}
+
+	int setNumberOfThreads(int numberOfThreads);
+
 	cmzn_field *getSourceField() const
 	{
 		return cmzn_field_access(this->sourceField);
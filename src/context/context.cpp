@@ -19,11 +19,13 @@
 #include "general/debug.h"
 #include "general/mystring.h"
 #include "general/object.h"
+#include "general/performance_counters.hpp"
 #include "graphics/scene_viewer.h"
 #include "graphics/graphics_module.hpp"
 #include "graphics/scene.hpp"
 #include "region/cmiss_region.hpp"
 #include "cmlibs/zinc/timekeeper.h"
+#include "jsoncpp/json.h"
 
 cmzn_context::cmzn_context(const char *nameIn) :
 	name(duplicate_string(nameIn)),
@@ -33,6 +35,8 @@ cmzn_context::cmzn_context(const char *nameIn) :
 	io_stream_package(0),
 	timekeepermodule(cmzn_timekeepermodule::create()),
 	graphics_module(cmzn_graphics_module::create(this)),
+	numberOfThreads(0),
+	threadPool(nullptr),
 	access_count(1)
 {
 }
@@ -56,6 +60,7 @@ cmzn_context::~cmzn_context()
 	if (this->io_stream_package)
 		DESTROY(IO_stream_package)(&this->io_stream_package);
 	cmzn_timekeepermodule::deaccess(this->timekeepermodule);
+	delete this->threadPool;
 
     cmzn_logger::deaccess(this->logger);
     DEALLOCATE(this->name);
@@ -94,6 +99,31 @@ void cmzn_context::removeRegion(cmzn_region *region)
 	}
 }
 
+int cmzn_context::setNumberOfThreads(int numberOfThreadsIn)
+{
+	if (numberOfThreadsIn < 0)
+	{
+		display_message(ERROR_MESSAGE, "Zinc Context setNumberOfThreads():  Invalid number of threads");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	std::lock_guard<std::mutex> lock(this->threadPoolMutex);
+	if (numberOfThreadsIn != this->numberOfThreads)
+	{
+		this->numberOfThreads = numberOfThreadsIn;
+		delete this->threadPool;
+		this->threadPool = nullptr;
+	}
+	return CMZN_OK;
+}
+
+cmzn::ThreadPool& cmzn_context::getThreadPool()
+{
+	std::lock_guard<std::mutex> lock(this->threadPoolMutex);
+	if (!this->threadPool)
+		this->threadPool = new cmzn::ThreadPool(this->numberOfThreads);
+	return *this->threadPool;
+}
+
 int cmzn_context::setDefaultRegion(cmzn_region *regionIn)
 {
 	if (regionIn && (regionIn->getContext() != this))
@@ -163,6 +193,74 @@ int cmzn_context_set_default_region(cmzn_context_id context,
 	return CMZN_ERROR_ARGUMENT;
 }
 
+int cmzn_context_get_number_of_threads(cmzn_context_id context)
+{
+	if (context)
+		return context->getNumberOfThreads();
+	return -1;
+}
+
+int cmzn_context_set_number_of_threads(cmzn_context_id context,
+	int numberOfThreads)
+{
+	if (context)
+		return context->setNumberOfThreads(numberOfThreads);
+	display_message(ERROR_MESSAGE, "Zinc Context setNumberOfThreads():  Missing context");
+	return CMZN_ERROR_ARGUMENT;
+}
+
+bool cmzn_context_is_performance_counters_enabled(cmzn_context_id context)
+{
+	if (context)
+		return cmzn::PerformanceCounters::isEnabled();
+	return false;
+}
+
+int cmzn_context_set_performance_counters_enabled(cmzn_context_id context,
+	bool enabled)
+{
+	if (context)
+	{
+		cmzn::PerformanceCounters::setEnabled(enabled);
+		return CMZN_OK;
+	}
+	display_message(ERROR_MESSAGE, "Zinc Context setPerformanceCountersEnabled():  Missing context");
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_context_reset_performance_counters(cmzn_context_id context)
+{
+	if (context)
+	{
+		cmzn::PerformanceCounters::reset();
+		return CMZN_OK;
+	}
+	display_message(ERROR_MESSAGE, "Zinc Context resetPerformanceCounters():  Missing context");
+	return CMZN_ERROR_ARGUMENT;
+}
+
+char *cmzn_context_get_performance_report(cmzn_context_id context)
+{
+	if (!context)
+	{
+		display_message(ERROR_MESSAGE, "Zinc Context getPerformanceReport():  Missing context");
+		return nullptr;
+	}
+	Json::Value root;
+	root["enabled"] = cmzn::PerformanceCounters::isEnabled();
+	Json::Value& counters = root["counters"];
+	counters = Json::Value(Json::objectValue);
+	const std::vector<cmzn::PerformanceCounters::Entry> entries = cmzn::PerformanceCounters::getEntries();
+	for (const auto& entry : entries)
+	{
+		Json::Value& counter = counters[entry.category][entry.name];
+		counter["count"] = static_cast<Json::UInt64>(entry.count);
+		if (entry.timed)
+			counter["time"] = static_cast<double>(entry.nanoseconds)*1.0E-9;
+	}
+	return duplicate_string(Json::StyledWriter().write(root).c_str());
+}
+
 cmzn_region_id cmzn_context_create_region(cmzn_context_id context)
 {
 	if (context)
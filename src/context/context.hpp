@@ -13,10 +13,12 @@
 #define CONTEXT_H
 
 #include <list>
+#include <mutex>
 #include "cmlibs/zinc/context.h"
 #include "cmlibs/zinc/status.h"
 #include "general/message_log.hpp"
 #include "general/manager.h"
+#include "general/thread_pool.hpp"
 
 struct cmzn_graphics_module;
 
@@ -36,6 +38,9 @@ private:
 	cmzn_timekeepermodule *timekeepermodule;
 	std::list<cmzn_region *> allRegions; // list of all regions created for context, not accessed
 	cmzn_graphics_module *graphics_module;
+	int numberOfThreads;  // 0 for number of hardware threads
+	cmzn::ThreadPool *threadPool;  // created on demand
+	std::mutex threadPoolMutex;  // guards threadPool creation
 	int access_count;
 
 	cmzn_context(const char *nameIn);
@@ -105,6 +110,23 @@ public:
 	{
 		return this->timekeepermodule;
 	}
+
+	int getNumberOfThreads() const
+	{
+		return this->numberOfThreads;
+	}
+
+	/** Set number of threads for parallel operations, recreating the thread
+	 * pool when next needed. Must not be called while parallel operations
+	 * are running.
+	 * @param numberOfThreadsIn  Number of threads >= 1, or 0 for number of
+	 * hardware threads.
+	 * @return  CMZN_OK on success, CMZN_ERROR_ARGUMENT if negative. */
+	int setNumberOfThreads(int numberOfThreadsIn);
+
+	/** @return  Thread pool for parallel operations, created on demand.
+	 * Safe to call from multiple threads. */
+	cmzn::ThreadPool& getThreadPool();
 	
 };
 
@@ -226,6 +226,126 @@ int DsLabels::removeLabelWithIdentifier(DsLabelIdentifier identifier)
 	return 0;
 }
 
+int DsLabels::compactIndexes(std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	oldToNewIndexes.clear();
+	if (!this->hasUnusedIndexes())
+		return CMZN_OK;
+	// contiguous labels never have holes
+	this->invalidateLabelIterators();
+	oldToNewIndexes.resize(this->indexSize, DS_LABEL_INDEX_INVALID);
+	bool consecutive = true;
+	DsLabelIdentifier firstIdentifier = DS_LABEL_IDENTIFIER_INVALID;
+	DsLabelIdentifier lastIdentifier = DS_LABEL_IDENTIFIER_INVALID;
+	DsLabelIndex newIndex = 0;
+	for (DsLabelIndex index = 0; index < this->indexSize; ++index)
+	{
+		DsLabelIdentifier identifier;
+		if (this->identifiers.getValue(index, identifier) && (identifier >= 0))
+		{
+			oldToNewIndexes[index] = newIndex;
+			// safe to move in place as newIndex <= index
+			this->identifiers.setValue(newIndex, identifier);
+			if (newIndex == 0)
+				firstIdentifier = identifier;
+			else if (identifier != (lastIdentifier + 1))
+				consecutive = false;
+			lastIdentifier = identifier;
+			++newIndex;
+		}
+	}
+	if (newIndex != this->labelsCount)
+	{
+		display_message(ERROR_MESSAGE, "DsLabels::compactIndexes.  Labels count is inconsistent");
+		oldToNewIndexes.clear();
+		return CMZN_ERROR_GENERAL;
+	}
+	if (newIndex == 0)
+	{
+		this->clear();
+		return CMZN_OK;
+	}
+	this->identifiers.destroyBlocksFrom(newIndex);
+	for (DsLabelIndex index = newIndex; index < this->indexSize; ++index)
+	{
+		DsLabelIdentifier *identifierAddress = this->identifiers.getAddress(index);
+		if (!identifierAddress)
+			break;
+		*identifierAddress = DS_LABEL_IDENTIFIER_INVALID;
+	}
+	this->indexSize = newIndex;
+	this->identifierToIndexMap.clear();
+	if (consecutive)
+	{
+		this->firstIdentifier = firstIdentifier;
+		this->lastIdentifier = lastIdentifier;
+		this->identifiers.clear();
+		this->contiguous = true;
+		this->firstFreeIdentifier = (firstIdentifier > 1) ? 1 : lastIdentifier + 1;
+	}
+	else
+	{
+		for (DsLabelIndex index = 0; index < this->indexSize; ++index)
+		{
+			if (!this->identifierToIndexMap.insert(*this, index))
+			{
+				display_message(ERROR_MESSAGE, "DsLabels::compactIndexes.  Failed to rebuild identifier map");
+				return CMZN_ERROR_MEMORY;
+			}
+		}
+	}
+	return CMZN_OK;
+}
+
+int DsLabels::permuteIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	if ((this->hasUnusedIndexes()) ||
+		(static_cast<DsLabelIndex>(oldToNewIndexes.size()) != this->indexSize))
+	{
+		display_message(ERROR_MESSAGE, "DsLabels::permuteIndexes.  Labels have holes or wrong number of new indexes");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	std::vector<bool> newIndexUsed(this->indexSize, false);
+	bool identity = true;
+	for (DsLabelIndex index = 0; index < this->indexSize; ++index)
+	{
+		const DsLabelIndex newIndex = oldToNewIndexes[index];
+		if ((newIndex < 0) || (newIndex >= this->indexSize) || (newIndexUsed[newIndex]))
+		{
+			display_message(ERROR_MESSAGE, "DsLabels::permuteIndexes.  New indexes are not a permutation");
+			return CMZN_ERROR_ARGUMENT;
+		}
+		newIndexUsed[newIndex] = true;
+		if (newIndex != index)
+			identity = false;
+	}
+	if (identity)
+		return CMZN_OK;
+	this->invalidateLabelIterators();
+	DsLabelIdentifierArray newIdentifiers;
+	for (DsLabelIndex index = 0; index < this->indexSize; ++index)
+	{
+		if (!newIdentifiers.setValue(oldToNewIndexes[index], this->getIdentifier(index)))
+		{
+			display_message(ERROR_MESSAGE, "DsLabels::permuteIndexes.  Failed to allocate identifiers");
+			return CMZN_ERROR_MEMORY;
+		}
+	}
+	this->identifiers.swap(newIdentifiers);
+	this->contiguous = false;
+	// map is ordered by identifier so must be rebuilt for new indexes
+	this->identifierToIndexMap.clear();
+	for (DsLabelIndex index = 0; index < this->indexSize; ++index)
+	{
+		if (!this->identifierToIndexMap.insert(*this, index))
+		{
+			display_message(ERROR_MESSAGE, "DsLabels::permuteIndexes.  Failed to rebuild identifier map");
+			return CMZN_ERROR_MEMORY;
+		}
+	}
+	return CMZN_OK;
+}
+
 /**
  * Safely changes the identifier at index to identifier, by removing index from
  * the identifier-to-index map and any other related maps, then changing the
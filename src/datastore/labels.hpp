@@ -73,7 +73,7 @@ class DsLabels : public cmzn::RefCounted
 	int indexSize; // allocated label array size; can have holes where labels removed
 
 	// linked-lists of active iterators, to invalidate when labels set changes
-	// including eventually when defragmenting memory
+	// including when compacting indexes
 	mutable DsLabelIterator *activeIterators;
 
 public:
@@ -143,6 +143,30 @@ public:
 
 	int removeLabelWithIdentifier(DsLabelIdentifier identifier);
 
+	/**
+	 * Renumber indexes densely in existing index order, removing holes left
+	 * by removed labels. Invalidates all iterators. Restores contiguous
+	 * storage if identifiers are then consecutive. Caller must remap all
+	 * data indexed by these labels with oldToNewIndexes.
+	 * @param oldToNewIndexes  On success, set to the new index for each old
+	 * index up to the old index size, or DS_LABEL_INDEX_INVALID for holes.
+	 * Left empty if there were no holes.
+	 * @return  CMZN_OK on success, any other error code on failure.
+	 */
+	int compactIndexes(std::vector<DsLabelIndex>& oldToNewIndexes);
+
+	/**
+	 * Reorder indexes of labels without holes, keeping their identifiers.
+	 * Invalidates all iterators; iteration remains in identifier order.
+	 * Storage becomes non-contiguous unless the permutation is the identity.
+	 * Caller must remap all data indexed by these labels with oldToNewIndexes.
+	 * @param oldToNewIndexes  New index for each index, a permutation of
+	 * 0..indexSize-1.
+	 * @return  CMZN_OK on success, CMZN_ERROR_ARGUMENT if labels have holes
+	 * or oldToNewIndexes is not a permutation, or other error code on failure.
+	 */
+	int permuteIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes);
+
 	DsLabelIdentifier getIdentifier(DsLabelIndex index) const
 	{
 		DsLabelIdentifier identifier = DS_LABEL_IDENTIFIER_INVALID;
@@ -49,6 +49,24 @@ void DsLabelsGroup::clear()
 	this->indexLimit = 0;
 }
 
+void DsLabelsGroup::compactIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	if (oldToNewIndexes.empty())
+		return;
+	this->labelsCount -= this->values.compactIndexes(oldToNewIndexes);
+	// exact limit is found when next queried
+	this->indexLimit = (this->labelsCount > 0) ? this->labels->getIndexSize() : 0;
+}
+
+bool DsLabelsGroup::permuteIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	if (!this->values.permuteIndexes(oldToNewIndexes))
+		return false;
+	// exact limit is found when next queried
+	this->indexLimit = (this->labelsCount > 0) ? this->labels->getIndexSize() : 0;
+	return true;
+}
+
 int DsLabelsGroup::addGroup(const DsLabelsGroup& otherGroup)
 {
 	if (otherGroup.labels != this->labels)
@@ -46,6 +46,21 @@ public:
 	
 	void clear();
 
+	/**
+	 * Move indexes in group to new indexes after labels have been compacted.
+	 * @param oldToNewIndexes  New index for each old index, as returned by
+	 * DsLabels::compactIndexes.
+	 */
+	void compactIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes);
+
+	/**
+	 * Move indexes in group to new indexes after labels have been permuted.
+	 * @param oldToNewIndexes  New index for each old index, as passed to
+	 * DsLabels::permuteIndexes.
+	 * @return  True on success, false if failed to allocate.
+	 */
+	bool permuteIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes);
+
 	DsLabelIndex getSize() const
 	{
 		return labelsCount;
@@ -125,6 +125,101 @@ public:
 		return array;
 	}
 
+	/**
+	 * Move arrays to new label indexes after labels have been compacted.
+	 * Arrays at removed indexes are discarded.
+	 * @param oldToNewIndexes  New index for each old index, increasing and
+	 * no greater than the old index, or negative if removed.
+	 * @return  True on success, false if failed to allocate.
+	 */
+	bool compactIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+	{
+		const DsLabelIndex oldIndexCount = static_cast<DsLabelIndex>(oldToNewIndexes.size());
+		DsLabelIndex indexLimit = this->values.getBlockCount()*this->arraysPerBlock;
+		if (indexLimit > oldIndexCount)
+			indexLimit = oldIndexCount;
+		DsLabelIndex newIndexCount = 0;
+		for (DsLabelIndex oldIndex = 0; oldIndex < oldIndexCount; ++oldIndex)
+		{
+			const DsLabelIndex newIndex = oldToNewIndexes[oldIndex];
+			if (newIndex >= 0)
+				newIndexCount = newIndex + 1;
+			if ((newIndex == oldIndex) || (oldIndex >= indexLimit))
+				continue;
+			ValueType *oldArray = this->getArray(oldIndex);
+			if (!oldArray)
+				continue;
+			// array at newIndex has already been moved from or cleared
+			if (newIndex >= 0)
+			{
+				ValueType *newArray = this->getOrCreateArray(newIndex);
+				if (!newArray)
+					return false;
+				// getting new array may have reallocated block list but not blocks
+				for (IndexType i = 0; i < this->arraySize; ++i)
+					newArray[i] = oldArray[i];
+			}
+			this->clearArray(oldIndex);
+		}
+		this->values.destroyBlocksFrom(static_cast<IndexType>(newIndexCount)*this->arraySize);
+		return true;
+	}
+
+	/**
+	 * Move arrays to new label indexes in any order after labels have been
+	 * permuted, building new blocks then swapping them in.
+	 * @param oldToNewIndexes  Unique new index for each old index, or
+	 * negative if removed.
+	 * @return  True on success, false if failed to allocate, in which case
+	 * arrays are unchanged.
+	 */
+	bool permuteIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+	{
+		block_array<IndexType, ValueType> newValues(this->arraysPerBlock*this->arraySize, this->initValue);
+		const DsLabelIndex oldIndexCount = static_cast<DsLabelIndex>(oldToNewIndexes.size());
+		for (DsLabelIndex oldIndex = 0; oldIndex < oldIndexCount; ++oldIndex)
+		{
+			const DsLabelIndex newIndex = oldToNewIndexes[oldIndex];
+			if (newIndex < 0)
+				continue;
+			const ValueType *oldArray = this->getArray(oldIndex);
+			if (!oldArray)
+				continue;
+			ValueType *newArray = newValues.getOrCreateAddressArrayInit(
+				static_cast<IndexType>(newIndex)*this->arraySize, this->unallocatedValue, this->arraySize);
+			if (!newArray)
+				return false;
+			for (IndexType i = 0; i < this->arraySize; ++i)
+				newArray[i] = oldArray[i];
+		}
+		this->values.swap(newValues);
+		return true;
+	}
+
+	/**
+	 * Replace values which are indexes into another labels set after that has
+	 * been compacted or permuted. Only valid for label index value types.
+	 * @param oldToNewValues  New index for each old index of the other labels,
+	 * or negative if removed.
+	 */
+	void remapValues(const std::vector<ValueType>& oldToNewValues)
+	{
+		const ValueType oldValueCount = static_cast<ValueType>(oldToNewValues.size());
+		const DsLabelIndex indexLimit = this->getIndexLimit();
+		for (DsLabelIndex index = 0; index < indexLimit; ++index)
+		{
+			ValueType *array = this->getArray(index);
+			if (array)
+			{
+				for (IndexType i = 0; i < this->arraySize; ++i)
+				{
+					if ((0 <= array[i]) && (array[i] < oldValueCount))
+						array[i] = oldToNewValues[array[i]];
+				}
+			}
+		}
+	}
+
 	/* get the highest index data is held for, minimum from allocated blocks or labels size */
 	DsLabelIndex getIndexLimit() const
 	{
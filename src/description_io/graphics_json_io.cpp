@@ -197,6 +197,13 @@ void GraphicsJsonIO::ioGeneralDoubleEntries(Json::Value &graphicsSettings)
 
 		value = graphics.getRenderPointSize();
 		graphicsSettings["RenderPointSize"] = value;
+
+		const int lodLevelsCount = graphics.getLodLevelsCount();
+		if (lodLevelsCount > 1)
+		{
+			graphicsSettings["LodLevelsCount"] = lodLevelsCount;
+			graphicsSettings["LodThreshold"] = graphics.getLodThreshold();
+		}
 	}
 	else
 	{
@@ -204,6 +211,10 @@ void GraphicsJsonIO::ioGeneralDoubleEntries(Json::Value &graphicsSettings)
 			graphics.setRenderLineWidth(graphicsSettings["RenderLineWidth"].asDouble());
 		if (graphicsSettings["RenderPointSize"].isDouble())
 			graphics.setRenderPointSize(graphicsSettings["RenderPointSize"].asDouble());
+		if (graphicsSettings["LodLevelsCount"].isInt())
+			graphics.setLodLevelsCount(graphicsSettings["LodLevelsCount"].asInt());
+		if (graphicsSettings["LodThreshold"].isNumeric())
+			graphics.setLodThreshold(graphicsSettings["LodThreshold"].asDouble());
 	}
 }
 
@@ -623,6 +634,9 @@ void GraphicsJsonIO::ioContoursEntries(Json::Value &graphicsSettings)
 				num = contours.getRangeNumberOfIsovalues();
 				attributesSettings["RangeNumberOfIsovalues"] = num;
 			}
+			// only written if set so existing descriptions are unchanged
+			if (contours.getSharedVerticesFlag())
+				attributesSettings["SharedVerticesFlag"] = true;
 			graphicsSettings["Contours"] = attributesSettings;
 		}
 		else if (graphicsSettings["Contours"].isObject())
@@ -654,6 +668,8 @@ void GraphicsJsonIO::ioContoursEntries(Json::Value &graphicsSettings)
 					attributesSettings["RangeFirstIsovalue"].asDouble(),
 					attributesSettings["RangeLastIsovalue"].asDouble());
 			}
+			if (attributesSettings["SharedVerticesFlag"].isBool())
+				contours.setSharedVerticesFlag(attributesSettings["SharedVerticesFlag"].asBool());
 		}
 	}
 }
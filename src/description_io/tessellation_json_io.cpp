@@ -23,6 +23,11 @@ void TessellationJsonIO::ioEntries(Json::Value &tessellationSettings)
 		tessellationSettings["Name"] = name;
 		DEALLOCATE(name);
 		tessellationSettings["CircleDivisions"] = tessellation.getCircleDivisions();
+		const double adaptiveTolerance = tessellation.getAdaptiveTolerance();
+		if (adaptiveTolerance > 0.0)
+		{
+			tessellationSettings["AdaptiveTolerance"] = adaptiveTolerance;
+		}
 		int valuesCount = tessellation.getMinimumDivisions(0, 0);
 		int *intValues = new int[valuesCount];
 		tessellation.getMinimumDivisions(valuesCount, intValues);
@@ -50,6 +55,10 @@ void TessellationJsonIO::ioEntries(Json::Value &tessellationSettings)
 		{
 			tessellation.setCircleDivisions(tessellationSettings["CircleDivisions"].asInt());
 		}
+		if (tessellationSettings["AdaptiveTolerance"].isNumeric())
+		{
+			tessellation.setAdaptiveTolerance(tessellationSettings["AdaptiveTolerance"].asDouble());
+		}
 		if (tessellationSettings["MinimumDivisions"].isArray())
 		{
 			int *intValues = new int[tessellationSettings["MinimumDivisions"].size()];
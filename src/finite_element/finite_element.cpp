@@ -2110,6 +2110,44 @@ char *cmzn_field_domain_type_enum_to_string(
 	return (string ? duplicate_string(string) : 0);
 }
 
+class cmzn_field_domain_ordering_conversion
+{
+public:
+	static const char *to_string(enum cmzn_field_domain_ordering ordering)
+	{
+		const char *enum_string = 0;
+		switch (ordering)
+		{
+		case CMZN_FIELD_DOMAIN_ORDERING_INVALID:
+			break;
+		case CMZN_FIELD_DOMAIN_ORDERING_HILBERT:
+			enum_string = "HILBERT";
+			break;
+		case CMZN_FIELD_DOMAIN_ORDERING_MORTON:
+			enum_string = "MORTON";
+			break;
+		case CMZN_FIELD_DOMAIN_ORDERING_REVERSE_CUTHILL_MCKEE:
+			enum_string = "REVERSE_CUTHILL_MCKEE";
+			break;
+		}
+		return enum_string;
+	}
+};
+
+enum cmzn_field_domain_ordering cmzn_field_domain_ordering_enum_from_string(
+	const char *name)
+{
+	return string_to_enum<enum cmzn_field_domain_ordering,
+		cmzn_field_domain_ordering_conversion>(name);
+}
+
+char *cmzn_field_domain_ordering_enum_to_string(
+	enum cmzn_field_domain_ordering ordering)
+{
+	const char *string = cmzn_field_domain_ordering_conversion::to_string(ordering);
+	return (string ? duplicate_string(string) : 0);
+}
+
 /**
  * Updates the pointer to <node_field_info_address> to point to a node_field info
  * which appends to the fields in <node_field_info_address> one <new_node_field>.
@@ -4455,7 +4493,7 @@ int list_FE_node(struct FE_node *node)
 #if defined (DEBUG_CODE)
 		/*???debug*/
 		display_message(INFORMATION_MESSAGE,"  access count = %d\n",
-			node->access_count);
+			node->access_count.load());
 #endif /* defined (DEBUG_CODE) */
 	}
 	else
@@ -6277,6 +6315,139 @@ int FE_element_get_number_of_change_to_adjacent_element_permutations(
 	return (number_of_permutations);
 }
 
+int FE_element_get_adjacent_face(struct FE_element *element, int face_number,
+	struct FE_element_adjacent_face *adjacent_face)
+{
+	FE_mesh *faceMesh, *fe_mesh;
+	if (!((element) && (fe_mesh = element->getMesh()) &&
+		(faceMesh = fe_mesh->getFaceMesh()) && (adjacent_face)))
+	{
+		display_message(ERROR_MESSAGE, "FE_element_get_adjacent_face.  Invalid argument(s)");
+		return 0;
+	}
+	adjacent_face->element = nullptr;
+	adjacent_face->face_number = -1;
+	adjacent_face->face_shape = nullptr;
+	adjacent_face->number_of_permutations = 0;
+	int new_face_number;
+	// following checks face_number is valid
+	const DsLabelIndex newElementIndex = fe_mesh->getElementFirstNeighbour(element->getIndex(), face_number, new_face_number);
+	if (newElementIndex < 0)
+	{
+		return 1;  // no adjacent element
+	}
+	const DsLabelIndex faceIndex = fe_mesh->getElementFace(element->getIndex(), face_number);
+	FE_element_shape *face_shape = faceMesh->getElementShape(faceIndex);
+	FE_element *new_element = fe_mesh->getElement(newElementIndex);
+	if (!((face_shape) && (new_element) && (0 <= new_face_number)))
+	{
+		display_message(ERROR_MESSAGE, "FE_element_get_adjacent_face.  "
+			"Invalid new element, face shape or face number");
+		return 0;
+	}
+	adjacent_face->element = new_element;
+	adjacent_face->face_number = new_face_number;
+	adjacent_face->face_shape = face_shape;
+	adjacent_face->number_of_permutations = 1;
+	switch (faceMesh->getDimension())
+	{
+		case 1:
+		{
+			adjacent_face->number_of_permutations = 2;
+		} break;
+		case 2:
+		{
+			// doesn't yet support all [8] permutations for square faces
+			if (FE_element_shape_is_triangle(face_shape))
+			{
+				adjacent_face->number_of_permutations = 6;
+			}
+		} break;
+	}
+	return 1;
+}
+
+int FE_element_adjacent_face_xi_to_xi(
+	const struct FE_element_adjacent_face *adjacent_face,
+	const FE_value *xi_face, int permutation, FE_value *xi)
+{
+	FE_element_shape *new_element_shape;
+	int dimension;
+	if (!((adjacent_face) && (adjacent_face->element) && (xi_face) && (xi) &&
+		(0 != (new_element_shape = adjacent_face->element->getElementShape())) &&
+		(0 < (dimension = get_FE_element_shape_dimension(new_element_shape)))))
+	{
+		display_message(ERROR_MESSAGE, "FE_element_adjacent_face_xi_to_xi.  Invalid argument(s)");
+		return 0;
+	}
+	FE_value local_xi_face[MAXIMUM_ELEMENT_XI_DIMENSIONS - 1];
+	for (int j = 0 ; j < dimension - 1 ; j++)
+		local_xi_face[j] = xi_face[j];
+	if (permutation > 0)
+	{
+		/* Try rotating the face_xi coordinates */
+		/* Only implementing the cases required so far and
+			enumerated by FE_element_get_adjacent_face */
+		FE_element_shape *face_shape = adjacent_face->face_shape;
+		switch (dimension - 1)
+		{
+			case 1:
+			{
+				if (FE_element_shape_is_line(face_shape))
+				{
+					local_xi_face[0] = 1.0 - xi_face[0];
+				}
+			} break;
+			case 2:
+			{
+				if (FE_element_shape_is_triangle(face_shape))
+				{
+					switch (permutation)
+					{
+						case 1:
+						{
+							local_xi_face[0] = xi_face[1];
+							local_xi_face[1] = 1.0 - xi_face[0] - xi_face[1];
+						} break;
+						case 2:
+						{
+							local_xi_face[0] = 1.0 - xi_face[0] - xi_face[1];
+							local_xi_face[1] = xi_face[0];
+						} break;
+						case 3:
+						{
+							local_xi_face[0] = xi_face[1];
+							local_xi_face[1] = xi_face[0];
+						} break;
+						case 4:
+						{
+							local_xi_face[0] = xi_face[0];
+							local_xi_face[1] = 1.0 - xi_face[0] - xi_face[1];
+						} break;
+						case 5:
+						{
+							local_xi_face[0] = 1.0 - xi_face[0] - xi_face[1];
+							local_xi_face[1] = xi_face[1];
+						} break;
+					}
+				}
+			} break;
+		}
+	}
+	const FE_value *face_to_element = get_FE_element_shape_face_to_element(new_element_shape, adjacent_face->face_number);
+	for (int i=0;i<dimension;i++)
+	{
+		xi[i]= *face_to_element;
+		face_to_element++;
+		for (int j=0;j<dimension-1;j++)
+		{
+			xi[i] += (*face_to_element)*local_xi_face[j];
+			face_to_element++;
+		}
+	}
+	return 1;
+}
+
 int FE_element_change_to_adjacent_element(struct FE_element **element_address,
 	FE_value *xi, FE_value *increment, int *face_number, FE_value *xi_face,
 	int permutation)
@@ -6285,17 +6456,13 @@ int FE_element_change_to_adjacent_element(struct FE_element **element_address,
 	int dimension = 0;
 	struct FE_element *element;
 	FE_element_shape *element_shape;
-	FE_mesh *faceMesh, *fe_mesh;
-	if ((element_address) && (element = *element_address) &&
-		(fe_mesh = element->getMesh()) &&
-		(faceMesh = fe_mesh->getFaceMesh()) &&
+	FE_element_adjacent_face adjacent_face;
+	if ((element_address) && (element = *element_address) && (face_number) &&
 		(0 != (element_shape = element->getElementShape())) &&
-		(0 < (dimension = get_FE_element_shape_dimension(element_shape))))
+		(0 < (dimension = get_FE_element_shape_dimension(element_shape))) &&
+		(FE_element_get_adjacent_face(element, *face_number, &adjacent_face)))
 	{
-		int new_face_number;
-		// following checks *face_number is valid
-		DsLabelIndex newElementIndex = fe_mesh->getElementFirstNeighbour(element->getIndex(), *face_number, new_face_number);
-		if (newElementIndex < 0)
+		if (!adjacent_face.element)
 		{
 			/* no adjacent element found */
 			*face_number = -1;
@@ -6303,165 +6470,91 @@ int FE_element_change_to_adjacent_element(struct FE_element **element_address,
 		}
 		else
 		{
-			DsLabelIndex faceIndex = fe_mesh->getElementFace(element->getIndex(), *face_number);
-			FE_element_shape *face_shape = faceMesh->getElementShape(faceIndex);
-			FE_element *new_element = fe_mesh->getElement(newElementIndex);
-			if (face_shape && new_element)
+			const int new_face_number = adjacent_face.face_number;
+			FE_value temp_increment[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+			FE_value face_normal[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+			/* change xi and increment into element coordinates */
+			FE_element_shape *new_element_shape = get_FE_element_shape(adjacent_face.element);
+			if (new_element_shape)
 			{
-				FE_value temp_increment[MAXIMUM_ELEMENT_XI_DIMENSIONS];
-				FE_value face_normal[MAXIMUM_ELEMENT_XI_DIMENSIONS];
-				FE_value local_xi_face[MAXIMUM_ELEMENT_XI_DIMENSIONS - 1];
-				/* change xi and increment into element coordinates */
-				FE_element_shape *new_element_shape = get_FE_element_shape(new_element);
-				if ((new_element_shape) && (0 <= new_face_number))
+				return_code = 1;
+				if (xi)
 				{
-					return_code = 1;
-					if (xi)
+					return_code = FE_element_adjacent_face_xi_to_xi(&adjacent_face, xi_face, permutation, xi);
+				}
+				if (return_code && increment)
+				{
+					/* convert increment into face+normal coordinates */
+					const FE_value *face_to_element = get_FE_element_shape_face_to_element(element_shape, *face_number);
+					return_code = FE_element_shape_calculate_face_xi_normal(element_shape,
+						*face_number, face_normal);
+					if (return_code)
 					{
-						for (int j = 0 ; j < dimension - 1 ; j++)
-							local_xi_face[j] = xi_face[j];
-						if (permutation > 0)
+						double dot_product;
+						for (int i=0;i<dimension;i++)
 						{
-							/* Try rotating the face_xi coordinates */
-							/* Only implementing the cases required so far and
-								enumerated by FE_element_change_get_number_of_permutations */
-							switch (dimension - 1)
+							temp_increment[i]=increment[i];
+						}
+						for (int i=1;i<dimension;i++)
+						{
+							dot_product=(double)0;
+							for (int j=0;j<dimension;j++)
 							{
-								case 1:
-								{
-									if (FE_element_shape_is_line(face_shape))
-									{
-										local_xi_face[0] = 1.0 - xi_face[0];
-									}
-								} break;
-								case 2:
-								{
-									if (FE_element_shape_is_triangle(face_shape))
-									{
-										switch (permutation)
-										{
-											case 1:
-											{
-												local_xi_face[0] = xi_face[1];
-												local_xi_face[1] = 1.0 - xi_face[0] - xi_face[1];
-											} break;
-											case 2:
-											{
-												local_xi_face[0] = 1.0 - xi_face[0] - xi_face[1];
-												local_xi_face[1] = xi_face[0];
-											} break;
-											case 3:
-											{
-												local_xi_face[0] = xi_face[1];
-												local_xi_face[1] = xi_face[0];
-											} break;
-											case 4:
-											{
-												local_xi_face[0] = xi_face[0];
-												local_xi_face[1] = 1.0 - xi_face[0] - xi_face[1];
-											} break;
-											case 5:
-											{
-												local_xi_face[0] = 1.0 - xi_face[0] - xi_face[1];
-												local_xi_face[1] = xi_face[1];
-											} break;
-										}
-									}
-								} break;
+								dot_product += (double)(temp_increment[j])*
+									(double)(face_to_element[j*dimension+i]);
 							}
+							increment[i-1]=(FE_value)dot_product;
 						}
-						const FE_value *face_to_element = get_FE_element_shape_face_to_element(new_element_shape, new_face_number);
+						dot_product=(double)0;
 						for (int i=0;i<dimension;i++)
 						{
-							xi[i]= *face_to_element;
-							face_to_element++;
-							for (int j=0;j<dimension-1;j++)
-							{
-								xi[i] += (*face_to_element)*local_xi_face[j];
-								face_to_element++;
-							}
+							dot_product += (double)(temp_increment[i])*(double)(face_normal[i]);
 						}
-					}
-					if (increment)
-					{
-						/* convert increment into face+normal coordinates */
-						const FE_value *face_to_element = get_FE_element_shape_face_to_element(element_shape, *face_number);
-						return_code = FE_element_shape_calculate_face_xi_normal(element_shape,
-							*face_number, face_normal);
+						increment[dimension-1]=(FE_value)dot_product;
+
+						/* Convert this back to an increment in the new element */
+						return_code = FE_element_shape_calculate_face_xi_normal(new_element_shape,
+							new_face_number, face_normal);
 						if (return_code)
 						{
-							double dot_product;
 							for (int i=0;i<dimension;i++)
 							{
 								temp_increment[i]=increment[i];
 							}
-							for (int i=1;i<dimension;i++)
-							{
-								dot_product=(double)0;
-								for (int j=0;j<dimension;j++)
-								{
-									dot_product += (double)(temp_increment[j])*
-										(double)(face_to_element[j*dimension+i]);
-								}
-								increment[i-1]=(FE_value)dot_product;
-							}
-							dot_product=(double)0;
+							const FE_value *face_to_element = get_FE_element_shape_face_to_element(new_element_shape, new_face_number);
 							for (int i=0;i<dimension;i++)
 							{
-								dot_product += (double)(temp_increment[i])*(double)(face_normal[i]);
-							}
-							increment[dimension-1]=(FE_value)dot_product;
-
-							/* Convert this back to an increment in the new element */
-							return_code = FE_element_shape_calculate_face_xi_normal(new_element_shape,
-								new_face_number, face_normal);
-							if (return_code)
-							{
-								for (int i=0;i<dimension;i++)
-								{
-									temp_increment[i]=increment[i];
-								}
-								const FE_value *face_to_element = get_FE_element_shape_face_to_element(new_element_shape, new_face_number);
-								for (int i=0;i<dimension;i++)
+								increment[i]=temp_increment[dimension-1]*face_normal[i];
+								face_to_element++;
+								for (int j=0;j<dimension-1;j++)
 								{
-									increment[i]=temp_increment[dimension-1]*face_normal[i];
+									increment[i] += (*face_to_element)*temp_increment[j];
 									face_to_element++;
-									for (int j=0;j<dimension-1;j++)
-									{
-										increment[i] += (*face_to_element)*temp_increment[j];
-										face_to_element++;
-									}
 								}
 							}
-							else
-							{
-								display_message(ERROR_MESSAGE,"FE_element_change_to_adjacent_element.  "
-									"Unable to calculate face_normal for new element and face");
-							}
 						}
 						else
 						{
 							display_message(ERROR_MESSAGE,"FE_element_change_to_adjacent_element.  "
-								"Unable to calculate face_normal for old element and face");
+								"Unable to calculate face_normal for new element and face");
 						}
 					}
-					if (return_code)
+					else
 					{
-						*element_address=new_element;
-						*face_number=new_face_number;
+						display_message(ERROR_MESSAGE,"FE_element_change_to_adjacent_element.  "
+							"Unable to calculate face_normal for old element and face");
 					}
 				}
-				else
+				if (return_code)
 				{
-					display_message(ERROR_MESSAGE,"FE_element_change_to_adjacent_element.  "
-						"Invalid new element shape or face number");
-					return_code = 0;
+					*element_address=adjacent_face.element;
+					*face_number=new_face_number;
 				}
 			}
 			else
 			{
 				display_message(ERROR_MESSAGE,"FE_element_change_to_adjacent_element.  "
-					"Invalid new element or element shape");
+					"Invalid new element shape");
 				return_code = 0;
 			}
 		}
@@ -6471,7 +6564,7 @@ int FE_element_change_to_adjacent_element(struct FE_element **element_address,
 		display_message(ERROR_MESSAGE,"FE_element_change_to_adjacent_element.  "
 			"Invalid argument(s).  %p %p %d %p %p %d %p",element_address,
 			element_address ? *element_address : 0, dimension,
-			xi,increment,*face_number,xi_face);
+			xi,increment,(face_number) ? *face_number : -1,xi_face);
 		return_code = 0;
 	}
 	return (return_code);
@@ -860,6 +860,40 @@ Gets the <field_order_info> field at the specified field_number
 int FE_element_get_number_of_change_to_adjacent_element_permutations(
 	struct FE_element *element, FE_value *xi, int face_number);
 
+/**
+ * Element adjacent to another across a face, looked up once so that several
+ * permutations of face xi can be tried when converting a location to it.
+ * @see FE_element_get_adjacent_face
+ */
+struct FE_element_adjacent_face
+{
+	struct FE_element *element; // adjacent element, not accessed; NULL if none
+	int face_number; // number of the shared face in the adjacent element
+	FE_element_shape *face_shape;
+	int number_of_permutations; // of face xi to try, 0 if no adjacent element
+};
+
+/**
+ * Gets the element adjacent to <element> across its face <face_number> with the
+ * number of the face in the adjacent element and number of face xi permutations
+ * supported by FE_element_adjacent_face_xi_to_xi.
+ * @param adjacent_face  On success, filled with adjacent element details;
+ * element is NULL if there is no adjacent element.
+ * @return  1 on success, 0 on error.
+ */
+int FE_element_get_adjacent_face(struct FE_element *element, int face_number,
+	struct FE_element_adjacent_face *adjacent_face);
+
+/**
+ * Converts <xi_face> coordinates on the shared face into <xi> in the adjacent
+ * element. <permutation> from 0 to adjacent_face->number_of_permutations - 1
+ * resolves the possible rotation and flipping of face xi between the parents.
+ * @return  1 on success, 0 on error.
+ */
+int FE_element_adjacent_face_xi_to_xi(
+	const struct FE_element_adjacent_face *adjacent_face,
+	const FE_value *xi_face, int permutation, FE_value *xi);
+
 /**
  * Steps into the adjacent element through face <face_number>, updating the
  * <element_address> location.
@@ -17,16 +17,20 @@ Functions for discretizing finite elements into points and simple sub-domains.
 
 #include "cmlibs/zinc/element.h"
 #include "cmlibs/zinc/fieldcache.h"
+#include "cmlibs/zinc/mesh.h"
 #include "cmlibs/zinc/status.h"
 #include "computed_field/field_cache.hpp"
 #include "element/element_operations.h"
 #include "finite_element/finite_element_discretization.h"
+#include "finite_element/finite_element_mesh.hpp"
+#include "finite_element/finite_element_shape.hpp"
 #include "general/debug.h"
 #include "general/matrix_vector.h"
 #include "general/random.h"
 #include "graphics/graphics_object.h"
 #include "general/message.h"
 #include "general/statistics.h"
+#include "mesh/mesh.hpp"
 
 /*
 Module types
@@ -2516,3 +2520,246 @@ parent elements where necessary.
 
 	return (return_code);
 } /* convert_xi_points_from_element_to_parent */
+
+FE_mesh_adaptive_discretization::FE_mesh_adaptive_discretization(FE_mesh *meshIn) :
+	mesh(meshIn),
+	dimension(meshIn->getDimension())
+{
+}
+
+/**
+ * Estimate numbers in xi for element from deviation of the fields from linear
+ * interpolation at midpoints of a sample lattice, assuming deviation reduces
+ * with the square of the spacing.
+ */
+bool FE_mesh_adaptive_discretization::estimateElementNumberInXi(
+	cmzn_element *element, cmzn_fieldcache *fieldCache,
+	int fieldsCount, cmzn_field * const *fields, const int *minimumNumberInXi,
+	const int *maximumNumberInXi, FE_value tolerance, int *numberInXiOut)
+{
+	const int maximumSampleDivisions = 4;
+	FE_element_shape *shape = element->getElementShape();
+	int sampleDivisions[MAXIMUM_ELEMENT_XI_DIMENSIONS] = { 1, 1, 1 };
+	int pointsInXi[MAXIMUM_ELEMENT_XI_DIMENSIONS] = { 1, 1, 1 };
+	int pointsCount = 1;
+	for (int d = 0; d < this->dimension; ++d)
+	{
+		numberInXiOut[d] = minimumNumberInXi[d];
+		sampleDivisions[d] = (minimumNumberInXi[d] < maximumSampleDivisions) ?
+			minimumNumberInXi[d] : maximumSampleDivisions;
+		pointsInXi[d] = 2*sampleDivisions[d] + 1;
+		pointsCount *= pointsInXi[d];
+	}
+	int pointStep[MAXIMUM_ELEMENT_XI_DIMENSIONS] = { 1, pointsInXi[0], pointsInXi[0]*pointsInXi[1] };
+	FE_value maximumRelativeDeviation[MAXIMUM_ELEMENT_XI_DIMENSIONS] = { 0.0, 0.0, 0.0 };
+	std::vector<bool> pointInElement(pointsCount);
+	std::vector<FE_value> values;
+	for (int f = 0; f < fieldsCount; ++f)
+	{
+		const int componentsCount = cmzn_field_get_number_of_components(fields[f]);
+		values.resize(pointsCount*componentsCount);
+		FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+		std::vector<FE_value> minimums(componentsCount), maximums(componentsCount);
+		bool first = true;
+		for (int p = 0; p < pointsCount; ++p)
+		{
+			int q = p;
+			for (int d = 0; d < this->dimension; ++d)
+			{
+				xi[d] = static_cast<FE_value>(q % pointsInXi[d]) / static_cast<FE_value>(pointsInXi[d] - 1);
+				q /= pointsInXi[d];
+			}
+			// skip points outside simplex and polygon shapes
+			pointInElement[p] = !FE_element_shape_limit_xi_to_element(shape, xi, /*tolerance*/1.0E-12);
+			if (!pointInElement[p])
+				continue;
+			FE_value *value = values.data() + p*componentsCount;
+			if ((CMZN_OK != cmzn_fieldcache_set_mesh_location(fieldCache, element, this->dimension, xi)) ||
+				(CMZN_OK != cmzn_field_evaluate_real(fields[f], fieldCache, componentsCount, value)))
+				return false;
+			for (int c = 0; c < componentsCount; ++c)
+			{
+				if (first || (value[c] < minimums[c]))
+					minimums[c] = value[c];
+				if (first || (value[c] > maximums[c]))
+					maximums[c] = value[c];
+			}
+			first = false;
+		}
+		FE_value range = 0.0;
+		for (int c = 0; c < componentsCount; ++c)
+			range += (maximums[c] - minimums[c])*(maximums[c] - minimums[c]);
+		range = sqrt(range);
+		if (range <= 0.0)
+			continue;
+		for (int d = 0; d < this->dimension; ++d)
+		{
+			// midpoints of sample segments along xi direction d
+			const int step = pointStep[d];
+			for (int p = step; p < pointsCount; ++p)
+			{
+				const int index = (p / step) % pointsInXi[d];
+				if (0 == (index % 2))
+					continue;
+				// only lattice lines through sample points in other directions
+				bool onLine = true;
+				for (int e = 0; e < this->dimension; ++e)
+					if ((e != d) && (0 != ((p / pointStep[e]) % pointsInXi[e]) % 2))
+						onLine = false;
+				if ((!onLine) || (!pointInElement[p - step]) || (!pointInElement[p]) || (!pointInElement[p + step]))
+					continue;
+				const FE_value *valueA = values.data() + (p - step)*componentsCount;
+				const FE_value *valueM = values.data() + p*componentsCount;
+				const FE_value *valueB = values.data() + (p + step)*componentsCount;
+				FE_value deviation = 0.0;
+				for (int c = 0; c < componentsCount; ++c)
+				{
+					const FE_value delta = valueM[c] - 0.5*(valueA[c] + valueB[c]);
+					deviation += delta*delta;
+				}
+				const FE_value relativeDeviation = sqrt(deviation) / range;
+				if (relativeDeviation > maximumRelativeDeviation[d])
+					maximumRelativeDeviation[d] = relativeDeviation;
+			}
+		}
+	}
+	for (int d = 0; d < this->dimension; ++d)
+	{
+		if (maximumRelativeDeviation[d] > tolerance)
+		{
+			const FE_value number = ceil(static_cast<FE_value>(sampleDivisions[d])*
+				sqrt(maximumRelativeDeviation[d] / tolerance));
+			numberInXiOut[d] = (number < static_cast<FE_value>(maximumNumberInXi[d])) ?
+				static_cast<int>(number) : maximumNumberInXi[d];
+			if (numberInXiOut[d] < minimumNumberInXi[d])
+				numberInXiOut[d] = minimumNumberInXi[d];
+		}
+	}
+	return true;
+}
+
+/**
+ * Raise numbers in xi of elements to the largest of any linked xi directions
+ * and of any element sharing a face, repeating until all agree. Converges as
+ * numbers only ever increase.
+ */
+void FE_mesh_adaptive_discretization::makeElementFacesAgree(
+	const std::vector<DsLabelIndex>& elementIndexes)
+{
+	FE_mesh *faceMesh = this->mesh->getFaceMesh();
+	const int faceDimension = this->dimension - 1;
+	std::vector<int> faceNumberInXi;
+	if ((faceMesh) && (faceDimension > 0))
+		faceNumberInXi.assign(faceMesh->getLabelsIndexSize()*faceDimension, 0);
+	bool changed = true;
+	while (changed)
+	{
+		changed = false;
+		for (auto elementIndexIter = elementIndexes.begin(); elementIndexIter != elementIndexes.end(); ++elementIndexIter)
+		{
+			const DsLabelIndex elementIndex = *elementIndexIter;
+			int *numberInXi = this->numberInXi.data() + elementIndex*this->dimension;
+			const FE_element_shape *shape = this->mesh->getElementShape(elementIndex);
+			const int facesCount = (faceNumberInXi.size() > 0) ? FE_element_shape_get_number_of_faces(shape) : 0;
+			for (int pass = 0; pass < 2; ++pass)
+			{
+				// pass 0 gets numbers from faces, pass 1 sets them on faces
+				for (int f = 0; f < facesCount; ++f)
+				{
+					const DsLabelIndex faceIndex = this->mesh->getElementFace(elementIndex, f);
+					if (faceIndex < 0)
+						continue;
+					const FE_value *faceToElement = get_FE_element_shape_face_to_element(shape, f);
+					int *faceNumbers = faceNumberInXi.data() + faceIndex*faceDimension;
+					for (int k = 0; k < faceDimension; ++k)
+						for (int d = 0; d < this->dimension; ++d)
+							if (0.0 != faceToElement[d*this->dimension + 1 + k])
+							{
+								if (0 == pass)
+								{
+									if (faceNumbers[k] > numberInXi[d])
+									{
+										numberInXi[d] = faceNumbers[k];
+										changed = true;
+									}
+								}
+								else if (numberInXi[d] > faceNumbers[k])
+								{
+									faceNumbers[k] = numberInXi[d];
+									changed = true;
+								}
+							}
+				}
+				if (0 == pass)
+				{
+					for (int d = 0; d < this->dimension; ++d)
+						for (int e = d + 1; e < this->dimension; ++e)
+						{
+							int linkage = 0;
+							if (get_FE_element_shape_xi_linkage_number(shape, d, e, &linkage) && linkage)
+							{
+								if (numberInXi[d] < numberInXi[e])
+									numberInXi[d] = numberInXi[e];
+								else
+									numberInXi[e] = numberInXi[d];
+							}
+						}
+				}
+			}
+		}
+	}
+}
+
+bool FE_mesh_adaptive_discretization::build(cmzn_mesh *iterationMesh,
+	cmzn_fieldcache *fieldCache, int fieldsCount, cmzn_field * const *fields,
+	const int *minimumNumberInXi, const int *maximumNumberInXi, FE_value tolerance)
+{
+	if ((!iterationMesh) || (iterationMesh->getFeMesh() != this->mesh) || (!fieldCache) ||
+		(fieldsCount < 1) || (!fields) || (!minimumNumberInXi) || (!maximumNumberInXi) ||
+		(!(tolerance > 0.0)))
+	{
+		display_message(ERROR_MESSAGE, "FE_mesh_adaptive_discretization::build.  Invalid argument(s)");
+		return false;
+	}
+	this->numberInXi.assign(this->mesh->getLabelsIndexSize()*this->dimension, 0);
+	std::vector<DsLabelIndex> elementIndexes;
+	cmzn_elementiterator *iterator = cmzn_mesh_create_elementiterator(iterationMesh);
+	cmzn_element *element;
+	bool success = true;
+	while (0 != (element = cmzn_elementiterator_next_non_access(iterator)))
+	{
+		const DsLabelIndex elementIndex = element->getIndex();
+		if (!this->estimateElementNumberInXi(element, fieldCache, fieldsCount, fields,
+			minimumNumberInXi, maximumNumberInXi, tolerance,
+			this->numberInXi.data() + elementIndex*this->dimension))
+		{
+			display_message(ERROR_MESSAGE, "FE_mesh_adaptive_discretization::build.  "
+				"Failed to evaluate fields in element %d", element->getIdentifier());
+			success = false;
+			break;
+		}
+		elementIndexes.push_back(elementIndex);
+	}
+	cmzn_elementiterator_destroy(&iterator);
+	cmzn_fieldcache_clear_location(fieldCache);
+	if (!success)
+	{
+		this->numberInXi.clear();
+		return false;
+	}
+	this->makeElementFacesAgree(elementIndexes);
+	return true;
+}
+
+bool FE_mesh_adaptive_discretization::getElementNumberInXi(
+	DsLabelIndex elementIndex, int *numberInXiOut) const
+{
+	if ((elementIndex < 0) || (static_cast<size_t>((elementIndex + 1)*this->dimension) > this->numberInXi.size()))
+		return false;
+	const int *numberInXi = this->numberInXi.data() + elementIndex*this->dimension;
+	if (0 == numberInXi[0])
+		return false;
+	for (int d = 0; d < this->dimension; ++d)
+		numberInXiOut[d] = numberInXi[d];
+	return true;
+}
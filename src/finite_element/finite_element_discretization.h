@@ -14,6 +14,7 @@ Functions for discretizing finite elements into points and simple sub-domains.
 #if !defined (FINITE_ELEMENT_DISCRETIZATION_H)
 #define FINITE_ELEMENT_DISCRETIZATION_H
 
+#include <vector>
 #include "computed_field/computed_field.h"
 #include "finite_element/finite_element.h"
 #include "graphics/auxiliary_graphics_types.h"
@@ -521,4 +522,53 @@ face_to_element member of struct FE_element_shape, and by function
 FE_element_get_top_level_element_conversion.)
 ==============================================================================*/
 
+/**
+ * Per-element discretizations adapted so fields sampled over each element
+ * deviate from linear interpolation between samples by no more than a
+ * tolerance relative to the field range over the element. Numbers in each xi
+ * direction are made to agree across faces shared by elements so that
+ * tessellations have no cracks; faces must be defined for this.
+ */
+class FE_mesh_adaptive_discretization
+{
+	FE_mesh *mesh;  // not accessed
+	const int dimension;
+	// dimension numbers in xi per element index, 0 if not set
+	std::vector<int> numberInXi;
+
+	bool estimateElementNumberInXi(cmzn_element *element, cmzn_fieldcache *fieldCache,
+		int fieldsCount, cmzn_field * const *fields, const int *minimumNumberInXi,
+		const int *maximumNumberInXi, FE_value tolerance, int *numberInXiOut);
+
+	void makeElementFacesAgree(const std::vector<DsLabelIndex>& elementIndexes);
+
+public:
+
+	FE_mesh_adaptive_discretization(FE_mesh *meshIn);
+
+	/**
+	 * Compute discretizations for all elements in the iteration mesh.
+	 *
+	 * @param iterationMesh  Mesh or mesh group from the mesh to discretize.
+	 * @param fieldCache  Field cache to evaluate fields with, time set.
+	 * @param fieldsCount  Number of fields > 0.
+	 * @param fields  Real-valued fields whose variation is to be resolved.
+	 * @param minimumNumberInXi  Minimum number in each xi direction >= 1.
+	 * @param maximumNumberInXi  Maximum number in each xi direction, which
+	 * may be exceeded to agree with neighbouring elements.
+	 * @param tolerance  Maximum deviation relative to field range > 0.0.
+	 * @return  True on success, false on failure.
+	 */
+	bool build(cmzn_mesh *iterationMesh, cmzn_fieldcache *fieldCache,
+		int fieldsCount, cmzn_field * const *fields, const int *minimumNumberInXi,
+		const int *maximumNumberInXi, FE_value tolerance);
+
+	/**
+	 * Get number in xi computed for element, if any.
+	 * @param numberInXiOut  Array to receive mesh dimension numbers in xi.
+	 * @return  True if element has a discretization, otherwise false.
+	 */
+	bool getElementNumberInXi(DsLabelIndex elementIndex, int *numberInXiOut) const;
+};
+
 #endif /* !defined (FINITE_ELEMENT_DISCRETIZATION_H) */
@@ -16,6 +16,7 @@
 #include "datastore/labelschangelog.hpp"
 #include "general/refcounted.hpp"
 #include <list>
+#include <vector>
 
 struct FE_region;
 
@@ -40,6 +41,17 @@ public:
 	/** Notify that a group of object indexes have been removed, so must ensure
 	 * indexes are not in callee group */
 	virtual void destroyedObjectGroup(const DsLabelsGroup& destroyedLabelsGroup) = 0;
+
+	/** Notify that object indexes have been renumbered densely to reclaim
+	 * memory, so any data held by index must be moved to its new index.
+	 * @param oldToNewIndexes  New index for each old index, or negative for
+	 * indexes not in use. */
+	virtual void compactedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes) = 0;
+
+	/** Notify that object indexes have been reordered for locality, so any
+	 * data held by index must be moved to its new index.
+	 * @param oldToNewIndexes  Unique new index for each old index. */
+	virtual void permutedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes) = 0;
 };
 
 /**
@@ -18,6 +18,8 @@
 #include "general/geometry.h"
 #include "general/value.h"
 #include "general/list.h"
+#include <atomic>
+#include <vector>
 
 /*
 Global types
@@ -117,8 +119,9 @@ private:
 	/* the number of computed fields wrapping this FE_field */
 	int number_of_wrappers;
 	/* the number of structures that point to this field.  The field cannot be
-		destroyed while this is greater than 0 */
-	int access_count;
+		destroyed while this is greater than 0. Atomic as evaluation from
+		concurrent threads in a frozen region accesses it */
+	std::atomic_int access_count;
 
 protected:
 
@@ -151,8 +154,7 @@ public:
 	{
 		if (field)
 		{
-			--(field->access_count);
-			if (field->access_count <= 0)
+			if (--(field->access_count) <= 0)
 				delete field;
 			field = nullptr;
 		}
@@ -228,6 +230,12 @@ public:
 		this->fe_field_parameters = nullptr;
 	}
 
+	/** Only to be called by FE_nodeset when node indexes have been compacted or
+	 * permuted, to move node indexes held by any field parameters.
+	 * @param oldToNewIndexes  New node index for each old index, negative if removed.
+	 * @param permute  True if indexes were permuted, false if compacted. */
+	void remappedNodeIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute);
+
 	/** Writes a text description of field to console/logger */
 	void list() const;
 
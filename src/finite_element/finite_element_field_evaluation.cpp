@@ -20,6 +20,7 @@
 #include "finite_element/finite_element_value_storage.hpp"
 #include "general/debug.h"
 #include "general/mystring.h"
+#include "general/performance_counters.hpp"
 #include "general/message.h"
 
 // function from finite_element.cpp
@@ -60,8 +61,7 @@ int FE_element_field_evaluation::deaccess(FE_element_field_evaluation* &element_
 {
 	if (!element_field_evaluation)
 		return CMZN_RESULT_ERROR_ARGUMENT;
-	--(element_field_evaluation->access_count);
-	if (element_field_evaluation->access_count <= 0)
+	if (--(element_field_evaluation->access_count) <= 0)
 		delete element_field_evaluation;
 	element_field_evaluation = 0;
 	return CMZN_RESULT_OK;
@@ -179,6 +179,9 @@ int FE_element_field_evaluation::calculate_values(FE_field *fieldIn,
 		**standard_basis_arguments_address;
 	Standard_basis_function **standard_basis_address;
 
+	static cmzn::PerformanceCounter *calculateValuesCounter =
+		cmzn::PerformanceCounters::getCounter("element_field_evaluation", "calculate_values");
+	cmzn::PerformanceTimer calculateValuesTimer(calculateValuesCounter);
 	if (this->element)
 		this->clear();
 	if (!((element) && (fieldIn)))
@@ -15,6 +15,7 @@
 #include "finite_element/finite_element_basis.hpp"
 #include "finite_element/finite_element_constants.hpp"
 #include "general/value.h"
+#include <atomic>
 
 /*
 Global types
@@ -102,7 +103,8 @@ class FE_element_field_evaluation
 	int parameterPerturbationIndex[MAXIMUM_PARAMETER_DERIVATIVE_ORDER];
 	// size of each perturbation for value -> value + delta*derivative
 	FE_value parameterPerturbationDelta[MAXIMUM_PARAMETER_DERIVATIVE_ORDER];
-	int access_count;
+	// atomic as evaluation from concurrent threads in a frozen region accesses it
+	std::atomic_int access_count;
 
 	FE_element_field_evaluation();
 
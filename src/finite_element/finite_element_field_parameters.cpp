@@ -382,6 +382,25 @@ int FE_field_parameters::getNumberOfElementParameters(cmzn_element *element, cmz
 	return 0;
 }
 
+void FE_field_parameters::remappedNodeIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute)
+{
+	const DsLabelIndex oldIndexCount = static_cast<DsLabelIndex>(oldToNewIndexes.size());
+	for (DsLabelIndex parameterIndex = 0; parameterIndex < this->parameterCount; ++parameterIndex)
+	{
+		DsLabelIndex nodeIndex;
+		if ((this->parameterNodeMap.getValue(parameterIndex, nodeIndex)) &&
+			(0 <= nodeIndex) && (nodeIndex < oldIndexCount))
+		{
+			this->parameterNodeMap.setValue(parameterIndex, oldToNewIndexes[nodeIndex]);
+		}
+	}
+	if (!block_array_remap_indexes(this->nodeParameterMap, oldToNewIndexes, permute))
+	{
+		// failed to allocate: rebuild maps from nodes at their new indexes
+		this->generateMaps();
+	}
+}
+
 int FE_field_parameters::getNumberOfParameters()
 {
 	// force parameter maps to be rebuilt as simpler than working out when it's changed
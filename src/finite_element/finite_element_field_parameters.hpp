@@ -16,6 +16,7 @@
 #include "cmlibs/zinc/zincconfigure.h"
 #include "datastore/labels.hpp"
 #include "general/block_array.hpp"
+#include <vector>
 
 struct FE_field;
 
@@ -133,6 +134,13 @@ public:
 	/** Set time at which parameters are to be used, must match a time held at nodes.
 	 * Client should call getNumberOfParameters() afterwards to re-generate map. */
 	int setTime(FE_value timeIn);
+
+	/** Only to be called by FE_field when node indexes have been compacted or
+	 * permuted. Moves parameter maps to the new node indexes; parameter
+	 * numbering follows node identifier order so is unchanged.
+	 * @param oldToNewIndexes  New node index for each old index, negative if removed.
+	 * @param permute  True if indexes were permuted, false if compacted. */
+	void remappedNodeIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute);
 };
 
 #endif /* !defined (FINITE_ELEMENT_FIELD_PARAMETERS_HPP) */
@@ -318,7 +318,7 @@ cmzn_element::~cmzn_element()
 	if (0 != this->access_count)
 	{
 		display_message(ERROR_MESSAGE, "~cmzn_element.  Element destroyed with non-zero access count %d. Dimension %d Index %d",
-			this->access_count, this->mesh ? this->mesh->getDimension() : -1, this->index);
+			this->access_count.load(), this->mesh ? this->mesh->getDimension() : -1, this->index);
 	}
 }
 
@@ -3691,6 +3691,22 @@ int FE_field_clear_element_varying_data(FE_field *field, void *mesh_and_element_
 	return 1;
 }
 
+struct FE_mesh_remap_element_indexes_data
+{
+	FE_mesh *mesh;
+	const std::vector<DsLabelIndex>& oldToNewIndexes;
+	bool permute;
+};
+
+int FE_field_remap_element_indexes(FE_field *field, void *remap_element_indexes_data_void)
+{
+	auto data = static_cast<FE_mesh_remap_element_indexes_data*>(remap_element_indexes_data_void);
+	FE_mesh_field_data *meshFieldData = field->getMeshFieldData(data->mesh);
+	if ((meshFieldData) && (!meshFieldData->remapElementIndexes(data->oldToNewIndexes, data->permute)))
+		return 0;
+	return 1;
+}
+
 }
 
 /** Clean up element label and objects. Called by element create functions when they fail part way. */
@@ -3894,6 +3910,195 @@ int FE_mesh::destroyElementsInGroup(DsLabelsGroup& labelsGroup)
 	return (numberDestroyed < labelsGroup.getSize()) ? CMZN_ERROR_GENERAL : CMZN_OK;
 }
 
+/**
+ * Move all per-element data held by the mesh, its fields, groups, and related
+ * face and parent meshes to new element indexes after labels have been
+ * compacted or permuted. Records an all-change to element identifiers and
+ * all fields changed so clients rebuild anything holding element indexes.
+ * Caller must begin/end change.
+ * @param oldToNewIndexes  New index for each old index, negative if removed.
+ * @param permute  True if labels were permuted, false if compacted.
+ * @return  CMZN_OK on success, CMZN_ERROR_MEMORY if failed part way.
+ */
+int FE_mesh::remapIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute)
+{
+	bool success = block_array_remap_indexes(this->fe_elements, oldToNewIndexes, permute);
+	const DsLabelIndex indexLimit = this->labels.getIndexSize();
+	cmzn_element *element;
+	for (DsLabelIndex elementIndex = 0; elementIndex < indexLimit; ++elementIndex)
+	{
+		if (this->fe_elements.getValue(elementIndex, element) && (element))
+			element->index = elementIndex;
+	}
+	success = success && block_array_remap_indexes(this->elementShapeMap, oldToNewIndexes, permute)
+		&& block_array_remap_indexes(this->parents, oldToNewIndexes, permute);
+	for (int i = 0; (success) && (i < this->elementShapeFacesCount); ++i)
+		success = this->elementShapeFacesArray[i]->remapElementIndexes(oldToNewIndexes, permute);
+	for (int i = 0; (success) && (i < this->elementFieldTemplateDataCount); ++i)
+	{
+		FE_mesh_element_field_template_data *eftData = this->elementFieldTemplateData[i];
+		if (eftData)
+		{
+			success = block_array_remap_indexes(eftData->localToGlobalNodes, oldToNewIndexes, permute)
+				&& block_array_remap_indexes(eftData->localToGlobalScaleFactors, oldToNewIndexes, permute)
+				&& block_array_remap_indexes(eftData->meshfieldtemplateUsageCount, oldToNewIndexes, permute);
+		}
+	}
+	for (auto mftIter = this->meshFieldTemplates.begin(); (success) && (mftIter != this->meshFieldTemplates.end()); ++mftIter)
+		success = block_array_remap_indexes((*mftIter)->eftDataMap, oldToNewIndexes, permute);
+	if ((success) && (this->fe_region))
+	{
+		FE_mesh_remap_element_indexes_data remapData = { this, oldToNewIndexes, permute };
+		success = 0 != FE_region_for_each_FE_field(this->fe_region, FE_field_remap_element_indexes, &remapData);
+	}
+	for (auto embeddedIter = this->embeddedNodeFields.begin(); (success) && (embeddedIter != this->embeddedNodeFields.end()); ++embeddedIter)
+		success = block_array_remap_indexes((*embeddedIter)->map, oldToNewIndexes, permute);
+	if (this->parentMesh)
+	{
+		for (int i = 0; i < this->parentMesh->elementShapeFacesCount; ++i)
+			this->parentMesh->elementShapeFacesArray[i]->remappedFaceIndexes(oldToNewIndexes);
+	}
+	if (this->faceMesh)
+	{
+		const DsLabelIndex faceIndexLimit = this->faceMesh->labels.getIndexSize();
+		DsLabelIndex *parentsArray;
+		for (DsLabelIndex faceIndex = 0; faceIndex < faceIndexLimit; ++faceIndex)
+		{
+			if (this->faceMesh->parents.getValue(faceIndex, parentsArray) && (parentsArray))
+			{
+				const int parentsCount = parentsArray[0];
+				for (int p = 1; p <= parentsCount; ++p)
+					parentsArray[p] = oldToNewIndexes[parentsArray[p]];
+			}
+		}
+	}
+	// groups and other mappers must move their data to the new indexes
+	for (std::list<FE_domain_mapper*>::iterator mapperIter = this->mappers.begin();
+		mapperIter != this->mappers.end(); ++mapperIter)
+	{
+		if (permute)
+			(*mapperIter)->permutedIndexes(oldToNewIndexes);
+		else
+			(*mapperIter)->compactedIndexes(oldToNewIndexes);
+	}
+	this->changeLog->setAllChange(DS_LABEL_CHANGE_TYPE_IDENTIFIER);
+	if (this->fe_region)
+		this->fe_region->FE_field_all_change(CHANGE_LOG_RELATED_OBJECT_CHANGED(FE_field));
+	if (!success)
+	{
+		display_message(ERROR_MESSAGE, "FE_mesh::remapIndexes.  Failed to move element data to new indexes");
+		return CMZN_ERROR_MEMORY;
+	}
+	return CMZN_OK;
+}
+
+/**
+ * Renumber element indexes densely in their current order to reclaim memory
+ * left by destroyed elements, moving all per-element data to the new indexes.
+ * Element identifiers are unchanged, but all element iterators are
+ * invalidated.
+ * @return  CMZN_OK on success, CMZN_ERROR_MEMORY if failed part way.
+ */
+int FE_mesh::compactIndexes()
+{
+	if (!this->labels.hasUnusedIndexes())
+		return CMZN_OK;
+	FE_region_begin_change(this->fe_region);
+	std::vector<DsLabelIndex> oldToNewIndexes;
+	int result = this->labels.compactIndexes(oldToNewIndexes);
+	if ((CMZN_OK == result) && (!oldToNewIndexes.empty()))
+		result = this->remapIndexes(oldToNewIndexes, /*permute*/false);
+	FE_region_end_change(this->fe_region);
+	return result;
+}
+
+/**
+ * Reorder element indexes of a compact mesh, e.g. to store elements close in
+ * space or connectivity at nearby indexes, moving all per-element data to the
+ * new indexes. Element identifiers and iteration order are unchanged, but all
+ * element iterators are invalidated.
+ * @param oldToNewIndexes  Permutation of 0..size-1 giving the new index of
+ * each element index.
+ * @return  CMZN_OK on success, CMZN_ERROR_ARGUMENT if mesh is not compact or
+ * not a valid permutation, CMZN_ERROR_MEMORY if failed part way.
+ */
+int FE_mesh::permuteIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	FE_region_begin_change(this->fe_region);
+	int result = this->labels.permuteIndexes(oldToNewIndexes);
+	if (CMZN_OK == result)
+		result = this->remapIndexes(oldToNewIndexes, /*permute*/true);
+	FE_region_end_change(this->fe_region);
+	return result;
+}
+
+/**
+ * Called by FE_nodeset::remapIndexes to update node indexes held by this
+ * mesh, if its elements use nodes from the nodeset or it hosts embedded
+ * locations of nodes in it.
+ * @param nodesetIn  The compacted or permuted nodeset.
+ * @param oldToNewNodeIndexes  New index for each old node index.
+ * @param permute  True if node indexes were permuted, false if compacted.
+ * @return  True on success, false on failure.
+ */
+bool FE_mesh::remappedNodeIndexes(FE_nodeset *nodesetIn, const std::vector<DsLabelIndex>& oldToNewNodeIndexes, bool permute)
+{
+	bool success = true;
+	if (nodesetIn == this->nodeset)
+	{
+		for (int i = 0; i < this->elementFieldTemplateDataCount; ++i)
+		{
+			if (this->elementFieldTemplateData[i])
+				this->elementFieldTemplateData[i]->localToGlobalNodes.remapValues(oldToNewNodeIndexes);
+		}
+		success = block_array_remap_indexes(this->nodeScaleFactorsIndex, oldToNewNodeIndexes, permute);
+	}
+	const DsLabelIndex indexLimit = this->labels.getIndexSize();
+	for (auto embeddedIter = this->embeddedNodeFields.begin(); embeddedIter != this->embeddedNodeFields.end(); ++embeddedIter)
+	{
+		FE_mesh_embedded_node_field *embeddedNodeField = *embeddedIter;
+		if (embeddedNodeField->nodeset != nodesetIn)
+			continue;
+		DsLabelIndex *nodeIndexes;
+		for (DsLabelIndex elementIndex = 0; elementIndex < indexLimit; ++elementIndex)
+		{
+			if (embeddedNodeField->map.getValue(elementIndex, nodeIndexes) && (nodeIndexes))
+			{
+				// first 2 values are size, allocated size
+				const DsLabelIndex size = nodeIndexes[0];
+				for (DsLabelIndex n = 2; n < size + 2; ++n)
+					nodeIndexes[n] = oldToNewNodeIndexes[nodeIndexes[n]];
+			}
+		}
+	}
+	return success;
+}
+
+void FE_mesh::getElementNodeIncidences(std::vector<std::pair<DsLabelIndex, DsLabelIndex> >& elementNodes) const
+{
+	const size_t startSize = elementNodes.size();
+	const DsLabelIndex indexLimit = this->labels.getIndexSize();
+	for (int i = 0; i < this->elementFieldTemplateDataCount; ++i)
+	{
+		const FE_mesh_element_field_template_data *eftData = this->elementFieldTemplateData[i];
+		if ((!eftData) || (eftData->localNodeCount <= 0))
+			continue;
+		for (DsLabelIndex elementIndex = 0; elementIndex < indexLimit; ++elementIndex)
+		{
+			const DsLabelIndex *nodeIndexes = eftData->getElementNodeIndexes(elementIndex);
+			if (!nodeIndexes)
+				continue;
+			for (int n = 0; n < eftData->localNodeCount; ++n)
+			{
+				if (nodeIndexes[n] >= 0)
+					elementNodes.push_back(std::make_pair(elementIndex, nodeIndexes[n]));
+			}
+		}
+	}
+	std::sort(elementNodes.begin() + startSize, elementNodes.end());
+	elementNodes.erase(std::unique(elementNodes.begin() + startSize, elementNodes.end()), elementNodes.end());
+}
+
 FieldDerivative *FE_mesh::getHigherFieldDerivative(const FieldDerivative& fieldDerivative)
 {
 	if ((fieldDerivative.getMesh()) && (fieldDerivative.getMesh() != this))
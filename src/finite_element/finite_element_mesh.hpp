@@ -25,6 +25,7 @@
 #include "general/block_array.hpp"
 #include "general/list.h"
 #include <algorithm>
+#include <atomic>
 #include <list>
 #include <map>
 #include <set>
@@ -210,7 +211,8 @@ private:
 	// index into mesh labels, maps to unique identifier
 	DsLabelIndex index;
 	// the number of references held to this element; destroyed once reduces to 0
-	int access_count;
+	// atomic as evaluation from concurrent threads in a frozen region accesses it
+	std::atomic_int access_count;
 
 	cmzn_element(FE_mesh *meshIn, DsLabelIndex indexIn) :
 		mesh(meshIn),
@@ -795,6 +797,21 @@ public:
 		/** convenient function for getting a single face for an element */
 		DsLabelIndex getElementFace(DsLabelIndex elementIndex, int faceNumber);
 
+		/** Move face arrays to new element indexes after this mesh is compacted
+		 * or permuted.
+		 * @return  True on success, false if failed. */
+		bool remapElementIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute)
+		{
+			return block_array_remap_indexes(this->faces, oldToNewIndexes, permute);
+		}
+
+		/** Update face element indexes after the face mesh is compacted or
+		 * permuted. */
+		void remappedFaceIndexes(const std::vector<DsLabelIndex>& oldToNewFaceIndexes)
+		{
+			this->faces.remapValues(oldToNewFaceIndexes);
+		}
+
 	};
 
 private:
@@ -957,6 +974,11 @@ public:
 		return 0;
 	}
 
+	/** Get pairs of element index, node index for every node used by any
+	  * field on each element, sorted and without repeats.
+	  * @param elementNodes  Vector to append pairs to. */
+	void getElementNodeIncidences(std::vector<std::pair<DsLabelIndex, DsLabelIndex> >& elementNodes) const;
+
 	FE_element_field_template *findMergedElementfieldtemplate(FE_element_field_template *eftIn);
 
 	FE_element_field_template *mergeElementfieldtemplate(FE_element_field_template *eftIn);
@@ -1291,6 +1313,14 @@ public:
 
 	int destroyElementsInGroup(DsLabelsGroup& labelsGroup);
 
+	int remapIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute);
+
+	int compactIndexes();
+
+	int permuteIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes);
+
+	bool remappedNodeIndexes(FE_nodeset *nodesetIn, const std::vector<DsLabelIndex>& oldToNewNodeIndexes, bool permute);
+
 	/** @return  Non-accessed field derivative w.r.t. mesh chart of given order */
 	FieldDerivative *getFieldDerivative(int order) const
 	{
@@ -1556,6 +1586,11 @@ public:
 
 		virtual bool mergeElementValues(const ComponentBase *sourceBase) = 0;
 
+		/** Move per-element values to new element indexes after mesh is compacted
+		  * or permuted.
+		  * @return  True on success, false on failure. */
+		virtual bool remapElementIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute) = 0;
+
 	};
 
 	template <typename ValueType> class Component : public ComponentBase
@@ -1696,6 +1731,12 @@ public:
 			return true;
 		}
 
+		virtual bool remapElementIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute)
+		{
+			return block_array_remap_indexes(this->elementScalarDOFs, oldToNewIndexes, permute)
+				&& block_array_remap_indexes(this->elementVectorDOFs, oldToNewIndexes, permute);
+		}
+
 	};
 
 	/** Simple component type for types without element varying quantities e.g. indexed string */
@@ -1721,6 +1762,11 @@ public:
 			return true;
 		}
 
+		virtual bool remapElementIndexes(const std::vector<DsLabelIndex>&, bool)
+		{
+			return true;
+		}
+
 	};
 
 
@@ -1759,6 +1805,17 @@ public:
 			this->components[c]->clearElementData(elementIndex);
 	}
 
+	/** Move per-element values of all components to new element indexes after
+	  * mesh is compacted or permuted.
+	  * @return  True on success, false on failure. */
+	bool remapElementIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute)
+	{
+		for (int c = 0; c < this->componentCount; ++c)
+			if (!this->components[c]->remapElementIndexes(oldToNewIndexes, permute))
+				return false;
+		return true;
+	}
+
 	/** @param componentNumber  From 0 to componentCount - 1, not checked
 	  * @return  Non-accessed component base */
 	ComponentBase *getComponentBase(int componentNumber) const
@@ -291,3 +291,13 @@ void FeMeshFieldRangesCache::destroyedObjectGroup(const DsLabelsGroup& destroyed
 		this->destroyedObject(elementIndex);
 	}
 }
+
+void FeMeshFieldRangesCache::compactedIndexes(const std::vector<DsLabelIndex>&)
+{
+	this->clearAllRanges();
+}
+
+void FeMeshFieldRangesCache::permutedIndexes(const std::vector<DsLabelIndex>&)
+{
+	this->clearAllRanges();
+}
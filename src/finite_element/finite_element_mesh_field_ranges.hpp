@@ -275,6 +275,12 @@ public:
 
 	/** notification from parent FE_mesh that a group of elements has been destroyed: remove their ranges */
 	virtual void destroyedObjectGroup(const DsLabelsGroup& destroyedLabelsGroup);
+
+	/** notification from parent FE_mesh that element indexes have been compacted: clear ranges */
+	virtual void compactedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes);
+
+	/** notification from parent FE_mesh that element indexes have been permuted: clear ranges */
+	virtual void permutedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes);
 };
 
 #endif /* !defined (FINITE_ELEMENT_MESH_FIELD_RANGES_HPP) */
@@ -14,6 +14,7 @@
 #include <vector>
 #include "cmlibs/zinc/node.h"
 #include "finite_element/finite_element.h"
+#include "finite_element/finite_element_field_private.hpp"
 #include "finite_element/finite_element_mesh.hpp"
 #include "finite_element/finite_element_nodeset.hpp"
 #include "finite_element/finite_element_region.h"
@@ -109,7 +110,7 @@ cmzn_node::~cmzn_node()
 	if (0 != this->access_count)
 	{
 		display_message(ERROR_MESSAGE,
-			"cmzn_node::~cmzn_node.  Node has non-zero access count %d", this->access_count);
+			"cmzn_node::~cmzn_node.  Node has non-zero access count %d", this->access_count.load());
 	}
 	else if (DS_LABEL_IDENTIFIER_INVALID != this->index)
 	{
@@ -956,6 +957,102 @@ int FE_nodeset::destroyNodesInGroup(DsLabelsGroup& labelsGroup)
 	return (numberDestroyed < labelsGroup.getSize()) ? CMZN_ERROR_IN_USE : CMZN_OK;
 }
 
+/**
+ * Move all per-node data held by the nodeset, groups, and meshes using or
+ * embedding these nodes to new node indexes after labels have been compacted
+ * or permuted. Records an all-change to node identifiers and all fields
+ * changed so clients rebuild anything holding node indexes.
+ * Caller must begin/end change.
+ * @param oldToNewIndexes  New index for each old index, negative if removed.
+ * @param permute  True if labels were permuted, false if compacted.
+ * @return  CMZN_OK on success, CMZN_ERROR_MEMORY if failed part way.
+ */
+int FE_nodeset::remapIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute)
+{
+	bool success = block_array_remap_indexes(this->fe_nodes, oldToNewIndexes, permute);
+	const DsLabelIndex indexLimit = this->labels.getIndexSize();
+	cmzn_node *node;
+	for (DsLabelIndex nodeIndex = 0; nodeIndex < indexLimit; ++nodeIndex)
+	{
+		if (this->fe_nodes.getValue(nodeIndex, node) && (node))
+			node->setIndex(nodeIndex);
+	}
+	success = success && block_array_remap_indexes(this->elementUsageCount, oldToNewIndexes, permute);
+	if (this->fe_region)
+	{
+		for (int dimension = 1; dimension <= MAXIMUM_ELEMENT_XI_DIMENSIONS; ++dimension)
+		{
+			FE_mesh *mesh = FE_region_find_FE_mesh_by_dimension(this->fe_region, dimension);
+			if ((mesh) && (!mesh->remappedNodeIndexes(this, oldToNewIndexes, permute)))
+				success = false;
+		}
+		// field parameters map node indexes of nodes, not datapoints
+		if (this->getFieldDomainType() == CMZN_FIELD_DOMAIN_TYPE_NODES)
+		{
+			cmzn_set_FE_field *fields = reinterpret_cast<cmzn_set_FE_field*>(this->fe_region->fe_field_list);
+			for (cmzn_set_FE_field::iterator fieldIter = fields->begin(); fieldIter != fields->end(); ++fieldIter)
+				(*fieldIter)->remappedNodeIndexes(oldToNewIndexes, permute);
+		}
+	}
+	// groups must move their data to the new indexes
+	for (std::list<FE_domain_mapper*>::iterator mapperIter = this->mappers.begin();
+		mapperIter != this->mappers.end(); ++mapperIter)
+	{
+		if (permute)
+			(*mapperIter)->permutedIndexes(oldToNewIndexes);
+		else
+			(*mapperIter)->compactedIndexes(oldToNewIndexes);
+	}
+	this->changeLog->setAllChange(DS_LABEL_CHANGE_TYPE_IDENTIFIER);
+	if (this->fe_region)
+		this->fe_region->FE_field_all_change(CHANGE_LOG_RELATED_OBJECT_CHANGED(FE_field));
+	if (!success)
+	{
+		display_message(ERROR_MESSAGE, "FE_nodeset::remapIndexes.  Failed to move node data to new indexes");
+		return CMZN_ERROR_MEMORY;
+	}
+	return CMZN_OK;
+}
+
+/**
+ * Renumber node indexes densely in their current order to reclaim memory
+ * left by destroyed nodes, moving all per-node data to the new indexes.
+ * Node identifiers are unchanged, but all node iterators are invalidated.
+ * @return  CMZN_OK on success, CMZN_ERROR_MEMORY if failed part way.
+ */
+int FE_nodeset::compactIndexes()
+{
+	if (!this->labels.hasUnusedIndexes())
+		return CMZN_OK;
+	FE_region_begin_change(this->fe_region);
+	std::vector<DsLabelIndex> oldToNewIndexes;
+	int result = this->labels.compactIndexes(oldToNewIndexes);
+	if ((CMZN_OK == result) && (!oldToNewIndexes.empty()))
+		result = this->remapIndexes(oldToNewIndexes, /*permute*/false);
+	FE_region_end_change(this->fe_region);
+	return result;
+}
+
+/**
+ * Reorder node indexes of a compact nodeset, e.g. to store nodes close in
+ * space or connectivity at nearby indexes, moving all per-node data to the
+ * new indexes. Node identifiers and iteration order are unchanged, but all
+ * node iterators are invalidated.
+ * @param oldToNewIndexes  Permutation of 0..size-1 giving the new index of
+ * each node index.
+ * @return  CMZN_OK on success, CMZN_ERROR_ARGUMENT if nodeset is not compact
+ * or not a valid permutation, CMZN_ERROR_MEMORY if failed part way.
+ */
+int FE_nodeset::permuteIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	FE_region_begin_change(this->fe_region);
+	int result = this->labels.permuteIndexes(oldToNewIndexes);
+	if (CMZN_OK == result)
+		result = this->remapIndexes(oldToNewIndexes, /*permute*/true);
+	FE_region_end_change(this->fe_region);
+	return result;
+}
+
 int FE_nodeset::get_last_FE_node_identifier()
 {
 	cmzn_nodeiterator *iter = this->createNodeiterator();
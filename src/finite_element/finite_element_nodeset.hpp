@@ -22,6 +22,7 @@
 #include "general/enumerator.h"
 #include "general/list.h"
 #include "general/value.h"
+#include <atomic>
 #include <list>
 
 class FE_nodeset;
@@ -60,8 +61,9 @@ public:
 	FE_nodeset *nodeset;
 
 	/* the number of structures that point to this node field information.  The
-		node field information cannot be destroyed while this is greater than 0 */
-	int access_count;
+		node field information cannot be destroyed while this is greater than 0.
+		Atomic as evaluation from concurrent threads in a frozen region accesses it */
+	std::atomic_int access_count;
 
 	/** takes ownership of fe_node_field_listIn */
 	FE_node_field_info(FE_nodeset *nodesetIn, struct LIST(FE_node_field) *nodeFieldListIn,
@@ -154,8 +156,9 @@ public:
 	DsLabelIndex index;
 
 	/** the number of structures that point to this node.  The node cannot be
-	 * destroyed while this is greater than 0 */
-	int access_count;
+	 * destroyed while this is greater than 0. Atomic as evaluation from
+	 * concurrent threads in a frozen region accesses it */
+	std::atomic_int access_count;
 
 	/* the fields defined at the node */
 	struct FE_node_field_info *fields;
@@ -165,7 +168,7 @@ public:
 
 	/**
 	 * Set the index of the node in owning nodeset. Used only by FE_nodeset when
-	 * merging nodes from another region's nodeset.
+	 * merging nodes from another region's nodeset, or compacting indexes.
 	 * @param index  The new index, non-negative. Value is not checked due
 	 * to use by privileged caller.
 	 */
@@ -516,6 +519,12 @@ public:
 
 	int destroyNodesInGroup(DsLabelsGroup& labelsGroup);
 
+	int remapIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes, bool permute);
+
+	int compactIndexes();
+
+	int permuteIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes);
+
 	int get_last_FE_node_identifier();
 
 	bool FE_field_has_multiple_times(struct FE_field *fe_field) const;
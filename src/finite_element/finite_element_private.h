@@ -22,6 +22,7 @@ modules such as finite_element_region.c.
 #include "general/indexed_list_stl_private.hpp"
 #include "general/list.h"
 #include "general/object.h"
+#include <atomic>
 
 /*
 Global types
@@ -62,8 +63,9 @@ struct FE_node_field
 private:
 	FE_time_sequence *timeSequence;
 	/* the number of structures that point to this node field.  The node field
-		cannot be destroyed while this is greater than 0 */
-	int access_count;
+		cannot be destroyed while this is greater than 0. Atomic as evaluation
+		from concurrent threads in a frozen region accesses it */
+	std::atomic_int access_count;
 
 public:
 
@@ -99,8 +101,7 @@ public:
 		{
 			return CMZN_ERROR_ARGUMENT;
 		}
-		--(node_field->access_count);
-		if (node_field->access_count <= 0)
+		if (--(node_field->access_count) <= 0)
 		{
 			delete node_field;
 		}
@@ -1776,6 +1776,64 @@ int FE_element_shape_find_face_number_for_xi(struct FE_element_shape *shape,
 	return -1;
 }
 
+bool FE_element_shape_get_face_xi_for_xi(const FE_element_shape *shape,
+	int faceNumber, const FE_value *xi, FE_value tolerance, FE_value *faceXi)
+{
+	if (!((shape) && (2 <= shape->dimension) && (shape->dimension <= 3) &&
+		(0 <= faceNumber) && (faceNumber < shape->number_of_faces) &&
+		(xi) && (tolerance > 0.0) && (faceXi)))
+	{
+		display_message(ERROR_MESSAGE,
+			"FE_element_shape_get_face_xi_for_xi.  Invalid argument(s)");
+		return false;
+	}
+	const int dimension = shape->dimension;
+	// face_to_element rows are b + A faceXi; solve normal equations
+	// (A^T A) faceXi = A^T (xi - b) which are at most 2x2
+	const FE_value *face_to_element = shape->face_to_element + faceNumber*dimension*dimension;
+	FE_value AtA[2][2] = { { 0.0, 0.0 }, { 0.0, 0.0 } };
+	FE_value Atr[2] = { 0.0, 0.0 };
+	for (int i = 0; i < dimension; ++i)
+	{
+		const FE_value *row = face_to_element + i*dimension;
+		const FE_value r = xi[i] - row[0];
+		for (int j = 1; j < dimension; ++j)
+		{
+			Atr[j - 1] += row[j]*r;
+			for (int k = 1; k < dimension; ++k)
+			{
+				AtA[j - 1][k - 1] += row[j]*row[k];
+			}
+		}
+	}
+	if (2 == dimension)
+	{
+		if (AtA[0][0] == 0.0)
+			return false;
+		faceXi[0] = Atr[0] / AtA[0][0];
+	}
+	else
+	{
+		const FE_value det = AtA[0][0]*AtA[1][1] - AtA[0][1]*AtA[1][0];
+		if (det == 0.0)
+			return false;
+		faceXi[0] = (AtA[1][1]*Atr[0] - AtA[0][1]*Atr[1]) / det;
+		faceXi[1] = (AtA[0][0]*Atr[1] - AtA[1][0]*Atr[0]) / det;
+	}
+	for (int i = 0; i < dimension; ++i)
+	{
+		const FE_value *row = face_to_element + i*dimension;
+		FE_value faceToXi = row[0];
+		for (int j = 1; j < dimension; ++j)
+		{
+			faceToXi += row[j]*faceXi[j - 1];
+		}
+		if (fabs(faceToXi - xi[i]) > tolerance)
+			return false;
+	}
+	return true;
+}
+
 int get_FE_element_shape_xi_linkage_number(
 	const FE_element_shape *element_shape, int xi_number1, int xi_number2,
 	int *xi_linkage_number_address)
@@ -159,6 +159,19 @@ const FE_value *get_FE_element_shape_face_to_element(
 int FE_element_shape_find_face_number_for_xi(struct FE_element_shape *shape,
 	FE_value *xi, FE_value tolerance, int lastFaceNumber = -1);
 
+/**
+ * Inverts the face_to_element map to get face xi for an element xi location,
+ * if the location is on the face.
+ * @param shape  Element shape to query.
+ * @param faceNumber  Face number from 0 to number of faces - 1.
+ * @param xi  Element local coordinates in shape.
+ * @param tolerance  Maximum distance of xi from face in element xi space > 0.0.
+ * @param faceXi  On success, filled with dimension - 1 face xi values.
+ * @return  True if xi is on the face and faceXi set, otherwise false.
+ */
+bool FE_element_shape_get_face_xi_for_xi(const FE_element_shape *shape,
+	int faceNumber, const FE_value *xi, FE_value tolerance, FE_value *faceXi);
+
 int get_FE_element_shape_xi_linkage_number(
 	const FE_element_shape *element_shape, int xi_number1, int xi_number2,
 	int *xi_linkage_number_address);
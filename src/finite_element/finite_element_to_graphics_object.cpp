@@ -10,8 +10,10 @@ The functions for creating graphical objects from finite elements.
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 #include <limits.h>
+#include <algorithm>
 #include <cmath>
 #include <cstdlib>
+#include <vector>
 #include "cmlibs/zinc/differentialoperator.h"
 #include "cmlibs/zinc/fieldcache.h"
 #include "cmlibs/zinc/mesh.h"
@@ -25,6 +27,7 @@ The functions for creating graphical objects from finite elements.
 #include "finite_element/finite_element_adjacent_elements.h"
 #include "finite_element/finite_element_discretization.h"
 #include "finite_element/finite_element_mesh.hpp"
+#include "finite_element/finite_element_nodeset.hpp"
 #include "finite_element/finite_element_region.h"
 #include "finite_element/finite_element_to_graphics_object.h"
 #include "finite_element/finite_element_to_iso_lines.h"
@@ -35,6 +38,7 @@ The functions for creating graphical objects from finite elements.
 #include "general/mystring.h"
 #include "general/random.h"
 #include "general/statistics.h"
+#include "general/thread_pool.hpp"
 #include "graphics/graphics_object.h"
 #include "graphics/iso_field_calculation.h"
 #include "graphics/spectrum.h"
@@ -42,6 +46,7 @@ The functions for creating graphical objects from finite elements.
 #include "graphics/mcubes.h"
 #include "general/message.h"
 #include "graphics/graphics_object.hpp"
+#include "mesh/nodeset.hpp"
 
 /*
 Module types
@@ -340,6 +345,189 @@ static int field_cache_location_to_glyph_point(cmzn_fieldcache_id field_cache,
 	return (return_code);
 }
 
+/**
+ * Evaluates glyph points for the nodes concurrently on threads from the
+ * region's context thread pool, each node filling its own slot in the arrays
+ * of glyph_set_data, then compacts the points with all mandatory fields
+ * defined in node order, giving the same result as evaluating serially.
+ * The region is frozen for the duration of the threaded loop; if it cannot be
+ * frozen because it is mid-change, nodes are evaluated serially instead.
+ * @param nodes  The nodes to evaluate glyph points at.
+ * @param glyph_set_data  Iterator data with arrays sized for all nodes, set
+ * to the start of each array. On return number_of_points is set.
+ * @param threadCount  Maximum number of threads >= 0, 0 for all pool threads.
+ * @return  1 on success, 0 on failure.
+ */
+static int nodes_to_glyph_points_threaded(const std::vector<cmzn_node *>& nodes,
+	cmzn_fieldcache_id field_cache, Glyph_set_data& glyph_set_data, int threadCount)
+{
+	const int nodesCount = static_cast<int>(nodes.size());
+	glyph_set_data.number_of_points = 0;
+	if (nodesCount == 0)
+	{
+		return 1;
+	}
+	const int chunkSize = 64;
+	cmzn::ThreadPool& threadPool = field_cache->getRegion()->getThreadPool();
+	threadCount = threadPool.getLoopThreadCount(threadCount, (nodesCount + chunkSize - 1)/chunkSize);
+	// first thread uses field_cache; others get their own at the same time
+	FieldcacheThreadSet fieldcaches(field_cache, threadCount);
+	// each thread has its own iterator data and temporary storage
+	const int dataComponentsCount = glyph_set_data.n_data_components;
+	const int labelBoundsDimension = glyph_set_data.label_bounds_dimension;
+	const int labelBoundsSize = glyph_set_data.label_bounds_values*glyph_set_data.label_bounds_components;
+	std::vector<Glyph_set_data> threadData(threadCount, glyph_set_data);
+	std::vector<FE_value> threadDataValues(threadCount*dataComponentsCount);
+	std::vector<FE_value> threadLabelBoundsVectors(threadCount*labelBoundsDimension);
+	for (int t = 0; t < threadCount; ++t)
+	{
+		if (dataComponentsCount)
+		{
+			threadData[t].data_values = threadDataValues.data() + t*dataComponentsCount;
+		}
+		if (glyph_set_data.label_bounds_vector)
+		{
+			threadData[t].label_bounds_vector = threadLabelBoundsVectors.data() + t*labelBoundsDimension;
+		}
+	}
+	std::vector<char> pointDefined(nodesCount, 0);
+	std::vector<int> threadResults(threadCount, 1);
+	auto evaluateNode = [&](int n, int threadIndex)
+	{
+		Glyph_set_data& data = threadData[threadIndex];
+		data.number_of_points = 0;
+		data.point = glyph_set_data.point + n;
+		data.axis1 = glyph_set_data.axis1 + n;
+		data.axis2 = glyph_set_data.axis2 + n;
+		data.axis3 = glyph_set_data.axis3 + n;
+		data.scale = glyph_set_data.scale + n;
+		if (glyph_set_data.data)
+		{
+			data.data = glyph_set_data.data + n*dataComponentsCount;
+		}
+		if (glyph_set_data.label)
+		{
+			data.label = glyph_set_data.label + n;
+			*(data.label) = nullptr;
+		}
+		if (glyph_set_data.label_density)
+		{
+			data.label_density = glyph_set_data.label_density + n;
+		}
+		if (glyph_set_data.name)
+		{
+			data.name = glyph_set_data.name + n;
+		}
+		if (glyph_set_data.label_bounds)
+		{
+			data.label_bounds = glyph_set_data.label_bounds + n*labelBoundsSize;
+		}
+		cmzn_fieldcache *fieldcache = fieldcaches.getFieldcache(threadIndex);
+		cmzn_fieldcache_set_node(fieldcache, nodes[n]);
+		data.graphics_name = nodes[n]->getIndex();
+		if (!field_cache_location_to_glyph_point(fieldcache, &data))
+		{
+			threadResults[threadIndex] = 0;
+		}
+		pointDefined[n] = (0 < data.number_of_points) ? 1 : 0;
+	};
+	// creating value caches and working caches is not thread safe
+	cmzn_field *fields[] = { glyph_set_data.coordinate_field, glyph_set_data.data_field,
+		glyph_set_data.orientation_scale_field, glyph_set_data.variable_scale_field,
+		glyph_set_data.label_field, glyph_set_data.label_density_field,
+		glyph_set_data.label_bounds_field, glyph_set_data.subgroup_field,
+		glyph_set_data.group_field };
+	for (cmzn_field *field : fields)
+	{
+		fieldcaches.createValueCaches(field);
+	}
+	// region must not be modified while evaluating on other threads
+	cmzn_region *region = field_cache->getRegion();
+	if (CMZN_OK == region->beginFreeze())
+	{
+		threadPool.parallelFor(0, nodesCount, chunkSize, threadCount,
+			[&](int chunkStart, int chunkEnd, int threadIndex)
+			{
+				for (int n = chunkStart; n < chunkEnd; ++n)
+				{
+					evaluateNode(n, threadIndex);
+				}
+			});
+		region->endFreeze();
+	}
+	else
+	{
+		// region is mid-change: evaluate serially with the supplied cache
+		for (int n = 0; n < nodesCount; ++n)
+		{
+			evaluateNode(n, 0);
+		}
+	}
+	// compact defined points in node order
+	auto moveTriple = [](Triple *list, int source, int target)
+	{
+		if (list)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				list[target][j] = list[source][j];
+			}
+		}
+	};
+	int pointsCount = 0;
+	for (int n = 0; n < nodesCount; ++n)
+	{
+		if (!pointDefined[n])
+		{
+			if (glyph_set_data.label)
+			{
+				DEALLOCATE(glyph_set_data.label[n]);
+			}
+			continue;
+		}
+		if (pointsCount < n)
+		{
+			moveTriple(glyph_set_data.point, n, pointsCount);
+			moveTriple(glyph_set_data.axis1, n, pointsCount);
+			moveTriple(glyph_set_data.axis2, n, pointsCount);
+			moveTriple(glyph_set_data.axis3, n, pointsCount);
+			moveTriple(glyph_set_data.scale, n, pointsCount);
+			moveTriple(glyph_set_data.label_density, n, pointsCount);
+			if (glyph_set_data.data)
+			{
+				std::copy(glyph_set_data.data + n*dataComponentsCount,
+					glyph_set_data.data + (n + 1)*dataComponentsCount,
+					glyph_set_data.data + pointsCount*dataComponentsCount);
+			}
+			if (glyph_set_data.label)
+			{
+				glyph_set_data.label[pointsCount] = glyph_set_data.label[n];
+				glyph_set_data.label[n] = nullptr;
+			}
+			if (glyph_set_data.name)
+			{
+				glyph_set_data.name[pointsCount] = glyph_set_data.name[n];
+			}
+			if (glyph_set_data.label_bounds)
+			{
+				std::copy(glyph_set_data.label_bounds + n*labelBoundsSize,
+					glyph_set_data.label_bounds + (n + 1)*labelBoundsSize,
+					glyph_set_data.label_bounds + pointsCount*labelBoundsSize);
+			}
+		}
+		++pointsCount;
+	}
+	glyph_set_data.number_of_points = pointsCount;
+	for (int t = 0; t < threadCount; ++t)
+	{
+		if (!threadResults[t])
+		{
+			return 0;
+		}
+	}
+	return 1;
+}
+
 /*
 Global functions
 ----------------
@@ -615,6 +803,134 @@ these are simply returned, since no valid direction can be produced.
 	return (return_code);
 } /* make_glyph_orientation_scale_axes */
 
+int Nodeset_update_vertex_array(
+	int number_of_node_indexes, const DsLabelIndex *node_indexes,
+	cmzn_nodeset_id nodeset, cmzn_fieldcache_id field_cache,
+	struct GT_object *graphics_object,
+	cmzn_field* coordinate_field,
+	cmzn_field* data_field,
+	cmzn_field* orientation_scale_field,
+	cmzn_field* variable_scale_field)
+{
+	if (!((0 <= number_of_node_indexes) && ((0 == number_of_node_indexes) || node_indexes) &&
+		nodeset && field_cache && graphics_object && coordinate_field))
+	{
+		display_message(ERROR_MESSAGE, "Nodeset_update_vertex_array.  Invalid argument(s)");
+		return 0;
+	}
+	Graphics_vertex_array *array = GT_object_get_vertex_set(graphics_object);
+	if (!array)
+		return 0;
+	int *vertex_ids = nullptr;
+	unsigned int id_values_per_vertex = 0, vertex_count = 0;
+	if ((!array->get_integer_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_VERTEX_ID,
+			&vertex_ids, &id_values_per_vertex, &vertex_count)) || (1 != id_values_per_vertex) ||
+		(vertex_count != array->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION)))
+		return 0;
+	// labels are not updated
+	if ((0 < array->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_LABEL)) ||
+		(0 < array->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_LABEL_BOUND)) ||
+		(0 < array->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_LABEL_DENSITY)))
+		return 0;
+	// find vertices of changed nodes from their fast search ids; all changed
+	// nodes in nodeset must be drawn and no others
+	FE_nodeset *fe_nodeset = nodeset->getFeNodeset();
+	std::vector<unsigned int> vertex_indexes;
+	vertex_indexes.reserve(number_of_node_indexes);
+	for (int i = 0; i < number_of_node_indexes; ++i)
+	{
+		cmzn_node *node = fe_nodeset->getNode(node_indexes[i]);
+		const bool drawable = (node) && cmzn_nodeset_contains_node(nodeset, node);
+		const int location = array->find_first_fast_search_id_location(node_indexes[i]);
+		if (location < 0)
+		{
+			if (drawable)
+				return 0;
+			continue;
+		}
+		if ((!drawable) || (static_cast<unsigned int>(location) >= vertex_count) ||
+			(vertex_ids[location] != node_indexes[i]))
+			return 0;
+		vertex_indexes.push_back(static_cast<unsigned int>(location));
+	}
+	const int n_data_components = (data_field) ? cmzn_field_get_number_of_components(data_field) : 0;
+	if (n_data_components > 0)
+	{
+		GLfloat *data_buffer = nullptr;
+		unsigned int data_values_per_vertex = 0, data_vertex_count = 0;
+		if ((!array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+				&data_buffer, &data_values_per_vertex, &data_vertex_count)) ||
+			(static_cast<int>(data_values_per_vertex) != n_data_components) ||
+			(data_vertex_count != vertex_count))
+			return 0;
+	}
+	Triple point, axis1, axis2, axis3, scale;
+	std::vector<GLfloat> data(n_data_components);
+	std::vector<FE_value> data_values(n_data_components);
+	Glyph_set_data glyph_set_data;
+	glyph_set_data.label = nullptr;
+	glyph_set_data.label_bounds = nullptr;
+	for (int i = 0; i < 3; ++i)
+	{
+		glyph_set_data.base_size[i] = 0.0;
+		glyph_set_data.offset[i] = 0.0;
+		glyph_set_data.scale_factors[i] = 1.0;
+	}
+	glyph_set_data.label_bounds_vector = nullptr;
+	glyph_set_data.label_bounds_bit_pattern = nullptr;
+	glyph_set_data.label_bounds_components = 0;
+	glyph_set_data.label_bounds_dimension = 0;
+	glyph_set_data.label_bounds_values = 0;
+	glyph_set_data.n_data_components = n_data_components;
+	glyph_set_data.name = nullptr;
+	glyph_set_data.coordinate_field = coordinate_field;
+	glyph_set_data.data_field = data_field;
+	glyph_set_data.label_field = nullptr;
+	glyph_set_data.label_bounds_field = nullptr;
+	glyph_set_data.label_density_field = nullptr;
+	glyph_set_data.orientation_scale_field = orientation_scale_field;
+	glyph_set_data.variable_scale_field = variable_scale_field;
+	glyph_set_data.subgroup_field = nullptr;
+	glyph_set_data.group_field = nullptr;
+	glyph_set_data.label_density = nullptr;
+	glyph_set_data.select_mode = CMZN_GRAPHICS_SELECT_MODE_ON;
+	for (auto vertex_index : vertex_indexes)
+	{
+		cmzn_node *node = fe_nodeset->getNode(vertex_ids[vertex_index]);
+		cmzn_fieldcache_set_node(field_cache, node);
+		glyph_set_data.number_of_points = 0;
+		glyph_set_data.point = &point;
+		glyph_set_data.axis1 = &axis1;
+		glyph_set_data.axis2 = &axis2;
+		glyph_set_data.axis3 = &axis3;
+		glyph_set_data.scale = &scale;
+		glyph_set_data.data = data.data();
+		glyph_set_data.data_values = data_values.data();
+		glyph_set_data.graphics_name = vertex_ids[vertex_index];
+		if ((!field_cache_location_to_glyph_point(field_cache, &glyph_set_data)) ||
+			(1 != glyph_set_data.number_of_points))
+			return 0; // fields no longer defined: must rebuild
+		if (!(array->replace_float_vertex_buffer_at_position(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+				vertex_index, 3, 1, point) &&
+			array->replace_float_vertex_buffer_at_position(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS1,
+				vertex_index, 3, 1, axis1) &&
+			array->replace_float_vertex_buffer_at_position(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS2,
+				vertex_index, 3, 1, axis2) &&
+			array->replace_float_vertex_buffer_at_position(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS3,
+				vertex_index, 3, 1, axis3) &&
+			array->replace_float_vertex_buffer_at_position(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_SCALE,
+				vertex_index, 3, 1, scale) &&
+			((0 == n_data_components) ||
+				array->replace_float_vertex_buffer_at_position(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+					vertex_index, n_data_components, 1, data.data()))))
+		{
+			display_message(ERROR_MESSAGE, "Nodeset_update_vertex_array.  Failed to replace vertex values");
+			return 0;
+		}
+	}
+	return 1;
+}
+
 struct GT_glyphset_vertex_buffers *Nodeset_create_vertex_array(
 	cmzn_nodeset_id nodeset, cmzn_fieldcache_id field_cache,
 	struct GT_object *graphics_object,
@@ -630,7 +946,7 @@ struct GT_glyphset_vertex_buffers *Nodeset_create_vertex_array(
 	struct GT_object *glyph,
 	const FE_value *base_size, const FE_value *offset, const FE_value *scale_factors,
 	struct cmzn_font *font,	FE_value *label_offset, char *static_label_text[3],
-	enum cmzn_graphics_select_mode select_mode)
+	enum cmzn_graphics_select_mode select_mode, int threadCount)
 {
 	GT_glyphset_vertex_buffers *glyphset = 0;
 	char *glyph_name, **labels;
@@ -794,11 +1110,24 @@ struct GT_glyphset_vertex_buffers *Nodeset_create_vertex_array(
 
 					cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(nodeset);
 					cmzn_node_id node = 0;
-					while (return_code && (0 != (node = cmzn_nodeiterator_next_non_access(iterator))))
+					if (threadCount != 1)
 					{
-						cmzn_fieldcache_set_node(field_cache, node);
-						glyph_set_data.graphics_name = node->getIndex();
-						return_code = field_cache_location_to_glyph_point(field_cache, &glyph_set_data);
+						std::vector<cmzn_node *> nodes;
+						nodes.reserve(number_of_points);
+						while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
+						{
+							nodes.push_back(node);
+						}
+						return_code = nodes_to_glyph_points_threaded(nodes, field_cache, glyph_set_data, threadCount);
+					}
+					else
+					{
+						while (return_code && (0 != (node = cmzn_nodeiterator_next_non_access(iterator))))
+						{
+							cmzn_fieldcache_set_node(field_cache, node);
+							glyph_set_data.graphics_name = node->getIndex();
+							return_code = field_cache_location_to_glyph_point(field_cache, &glyph_set_data);
+						}
 					}
 					cmzn_nodeiterator_destroy(&iterator);
 					final_number_of_points = glyph_set_data.number_of_points;
@@ -850,6 +1179,15 @@ struct GT_glyphset_vertex_buffers *Nodeset_create_vertex_array(
 					{
 						DESTROY(GT_glyphset_vertex_buffers)(&glyphset);
 					}
+					else if (names)
+					{
+						// record vertex location of each node for updating in place
+						Graphics_vertex_array *array = GT_object_get_vertex_set(graphics_object);
+						for (unsigned int p = 0; p < final_number_of_points; ++p)
+						{
+							array->add_fast_search_id(names[p]);
+						}
+					}
 				}
 				if (label_bounds_field)
 				{
@@ -887,6 +1225,59 @@ struct GT_glyphset_vertex_buffers *Nodeset_create_vertex_array(
 	return glyphset;
 }
 
+/**
+ * Find the location of the element's primitive in the vertex array, and whether
+ * it is marked as needing an update. If the storage at that location no longer
+ * fits the element, e.g. because its index was reused by a newly added element
+ * of another shape or size, the location is abandoned so the element is
+ * appended as a new primitive; abandoned storage is reclaimed by the next full
+ * rebuild.
+ * @param number_of_vertices  Number of vertices the element needs.
+ * @param number_of_xi1  Number of vertices in xi1 if stored, or 0 if not.
+ * @param polygon_type  Polygon type if stored, or negative if not.
+ * @param replaceRequired  On return, non-zero if the found location needs update.
+ * @return  Location of existing primitive for element, or -1 if none.
+ */
+static int Graphics_vertex_array_find_element_location(Graphics_vertex_array *array,
+	DsLabelIndex elementIndex, unsigned int number_of_vertices,
+	unsigned int number_of_xi1, int polygon_type, int *replaceRequired)
+{
+	*replaceRequired = 0;
+	const int vertex_location = array->find_first_fast_search_id_location(elementIndex);
+	if (vertex_location >= 0)
+	{
+		array->get_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_UPDATE_REQUIRED,
+			vertex_location, 1, replaceRequired);
+		if (*replaceRequired)
+		{
+			unsigned int old_number_of_vertices = 0;
+			unsigned int old_number_of_xi1 = number_of_xi1;
+			int old_polygon_type = polygon_type;
+			array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+				vertex_location, 1, &old_number_of_vertices);
+			if (number_of_xi1 > 0)
+				array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_XI1,
+					vertex_location, 1, &old_number_of_xi1);
+			if (polygon_type >= 0)
+				array->get_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POLYGON,
+					vertex_location, 1, &old_polygon_type);
+			if ((old_number_of_vertices != number_of_vertices) ||
+				(old_number_of_xi1 != number_of_xi1) || (old_polygon_type != polygon_type))
+			{
+				// object id at location is already invalid so it is not drawn
+				int updated = 0;
+				array->replace_integer_vertex_buffer_at_position(
+					GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_UPDATE_REQUIRED,
+					vertex_location, 1, 1, &updated);
+				array->remove_fast_search_id_location(elementIndex, vertex_location);
+				*replaceRequired = 0;
+				return -1;
+			}
+		}
+	}
+	return vertex_location;
+}
+
 int FE_element_add_line_to_vertex_array(struct FE_element *element,
 	cmzn_fieldcache_id field_cache, struct Graphics_vertex_array *array,
 	cmzn_field* coordinate_field,
@@ -916,14 +1307,9 @@ int FE_element_add_line_to_vertex_array(struct FE_element *element,
 		const DsLabelIndex elementIndex = get_FE_element_index(element);
 
 		int replaceRequired = 0;
-		/* find if vertex already in the array */
-		int vertex_location = array->find_first_fast_search_id_location(elementIndex);
-		/* vertex found in array, check if update is required */
-		if (vertex_location >= 0)
-		{
-			array->get_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_UPDATE_REQUIRED,
-				vertex_location, 1, &replaceRequired);
-		}
+		/* find if vertex already in the array and if update is required */
+		int vertex_location = Graphics_vertex_array_find_element_location(array, elementIndex,
+			number_of_segments + 1, /*number_of_xi1*/0, /*polygon_type*/-1, &replaceRequired);
 		if (vertex_location < 0 || replaceRequired)
 		{
 			if (vertex_location < 0)
@@ -1129,15 +1515,9 @@ int FE_element_add_cylinder_to_vertex_array(struct FE_element *element,
 		}
 		const DsLabelIndex elementIndex = get_FE_element_index(element);
 		int replaceRequired = 0;
-		/* find if vertex already in the array */
-		int vertex_location = array->find_first_fast_search_id_location(elementIndex);
-
-		/* vertex found in array, check if update is required */
-		if (vertex_location >= 0)
-		{
-			array->get_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_UPDATE_REQUIRED,
-				vertex_location, 1, &replaceRequired);
-		}
+		/* find if vertex already in the array and if update is required */
+		int vertex_location = Graphics_vertex_array_find_element_location(array, elementIndex,
+			number_of_points, number_of_segments_around + 1, (int)g_TRIANGLE, &replaceRequired);
 		if ((vertex_location < 0 || replaceRequired) &&
 			(data||(!n_data_components)) &&
 			(ALLOCATE(normalpoints,Triple,number_of_points)) &&
@@ -1870,14 +2250,9 @@ int FE_element_add_surface_to_vertex_array(struct FE_element *element,
 		GLfloat *floatData = data_field ? new GLfloat[n_data_components] : 0;
 		FE_value *xi_points = new FE_value[2*number_of_points];
 		int replaceRequired = 0;
-		/* find if vertex already in the array */
-		int vertex_location = array->find_first_fast_search_id_location(elementIndex);
-		/* vertex found in array, check if update is required */
-		if (vertex_location >= 0)
-		{
-			array->get_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_UPDATE_REQUIRED,
-				vertex_location, 1, &replaceRequired);
-		}
+		/* find if vertex already in the array and if update is required */
+		int vertex_location = Graphics_vertex_array_find_element_location(array, elementIndex,
+			number_of_points, number_of_points_in_xi1, (int)polygon_type, &replaceRequired);
 		if ((vertex_location < 0 || replaceRequired) && (NULL != xi_points) &&
 			(floatData || (0 == n_data_components)) &&
 			(ALLOCATE(normalpoints,Triple,number_of_points)) &&
@@ -129,6 +129,33 @@ Note:
 to be set in the field_cache if needed.
 ==============================================================================*/
 
+/**
+ * Updates in place the vertices of the glyph set built by
+ * Nodeset_create_vertex_array in the graphics object for the listed nodes,
+ * re-evaluating their position, orientation, scale and data. Only usable
+ * if the glyph set was built with vertex IDs i.e. select mode not OFF, and
+ * without labels or label bounds. Fails if any of the listed nodes in the
+ * nodeset is not drawn, or is no longer drawable, in which case the glyph
+ * set must be rebuilt. Vertices are found from the fast search ids of the
+ * vertex array, so cost is proportional to the number of listed nodes.
+ *
+ * @param number_of_node_indexes  Number of node indexes >= 0.
+ * @param node_indexes  Array of indexes of changed nodes, sorted ascending.
+ * Need not all be in the nodeset.
+ * @param nodeset  The nodeset the glyph set was built from.
+ * @param field_cache  Field cache with time set.
+ * Remaining fields are as passed to Nodeset_create_vertex_array.
+ * @return  1 if all vertices for the nodes were updated, 0 if not.
+ */
+int Nodeset_update_vertex_array(
+	int number_of_node_indexes, const DsLabelIndex *node_indexes,
+	cmzn_nodeset_id nodeset, cmzn_fieldcache_id field_cache,
+	struct GT_object *graphics_object,
+	cmzn_field* coordinate_field,
+	cmzn_field* data_field,
+	cmzn_field* orientation_scale_field,
+	cmzn_field* variable_scale_field);
+
 struct GT_glyphset_vertex_buffers *Nodeset_create_vertex_array(
 	cmzn_nodeset_id nodeset, cmzn_fieldcache_id field_cache,
 	struct GT_object *graphics_object,
@@ -144,7 +171,7 @@ struct GT_glyphset_vertex_buffers *Nodeset_create_vertex_array(
 	struct GT_object *glyph,
 	const FE_value *base_size, const FE_value *offset, const FE_value *scale_factors,
 	struct cmzn_font *font, FE_value *label_offset, char *static_label_text[3],
-	enum cmzn_graphics_select_mode select_mode);
+	enum cmzn_graphics_select_mode select_mode, int threadCount);
 /*******************************************************************************
 Creates a GT_glyphset_vertex_buffer displaying a <glyph> of at least <base_size>, with the
 given glyph <offset> at each node in <fe_region>.
@@ -163,6 +190,9 @@ and graph grids.
 The <select_mode> controls whether node cmiss numbers are output as integer
 names with the glyph_set. If <select_mode> is DRAW_SELECTED or DRAW_UNSELECTED,
 only nodes in (or not in) the <selected_node_list> are rendered.
+The <threadCount> is the maximum number of threads >= 0 from the region's
+context thread pool to evaluate nodes on, where 0 uses all pool threads.
+Fields must be safe to evaluate concurrently if not 1.
 Notes:
 - the coordinate and orientation fields are assumed to be rectangular cartesian.
 - the coordinate system of the variable_scale_field is ignored/not used.
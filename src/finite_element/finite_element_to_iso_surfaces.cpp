@@ -10,6 +10,7 @@
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 #include <list>
 #include <map>
+#include <vector>
 #include "cmlibs/zinc/differentialoperator.h"
 #include "cmlibs/zinc/fieldcache.h"
 #include "cmlibs/zinc/mesh.h"
@@ -19,10 +20,13 @@
 #include "computed_field/field_cache.hpp"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_discretization.h"
+#include "finite_element/finite_element_mesh.hpp"
+#include "finite_element/finite_element_shape.hpp"
 #include "finite_element/finite_element_to_graphics_object.h"
 #include "finite_element/finite_element_to_iso_surfaces.h"
 #include "general/debug.h"
 #include "general/matrix_vector.h"
+#include "general/thread_pool.hpp"
 #include "graphics/graphics_object.hpp"
 #include "graphics/volume_texture.h"
 #include "general/message.h"
@@ -569,6 +573,133 @@ typedef std::map<int, Iso_mesh*> Iso_mesh_map;
 typedef std::map<int, Iso_mesh*>::iterator Iso_mesh_map_iterator;
 typedef std::map<int, Iso_mesh*>::const_iterator Iso_mesh_map_const_iterator;
 
+/**
+ * Identifies the lattice line an iso-vertex is on independently of which
+ * element it was computed in. The line is moved down to the lowest dimension
+ * face containing it, using the mesh face connectivity, so neighbouring
+ * elements sharing that face get the same key.
+ */
+class Iso_shared_vertex_key
+{
+public:
+	int iso_value_number;
+	int dimension;  // dimension of element or face containing the line
+	DsLabelIndex index;  // index of element or face in its mesh
+	int q[6];  // line end xi in element or face scaled to integers, in order
+
+	void set(FE_mesh *fe_mesh, DsLabelIndex element_index,
+		const FE_value *xi_a, const FE_value *xi_b, int iso_value_number_in);
+
+	bool operator<(const Iso_shared_vertex_key& other) const
+	{
+		if (iso_value_number != other.iso_value_number)
+			return iso_value_number < other.iso_value_number;
+		if (dimension != other.dimension)
+			return dimension < other.dimension;
+		if (index != other.index)
+			return index < other.index;
+		for (int i = 0; i < 6; ++i)
+		{
+			if (q[i] != other.q[i])
+				return q[i] < other.q[i];
+		}
+		return false;
+	}
+};
+
+void Iso_shared_vertex_key::set(FE_mesh *fe_mesh, DsLabelIndex element_index,
+	const FE_value *xi_a, const FE_value *xi_b, int iso_value_number_in)
+{
+	// lattice xi are small rationals; tolerance and scaling are well clear of
+	// rounding error and of the spacing of any practical discretization
+	const FE_value tolerance = 1.0E-6;
+	const FE_value scale = 1048576.0;
+	FE_value a[3], b[3], mid[3], face_a[2], face_b[2], face_mid[2];
+	int i;
+	for (i = 0; i < 3; ++i)
+	{
+		a[i] = xi_a[i];
+		b[i] = xi_b[i];
+	}
+	this->iso_value_number = iso_value_number_in;
+	this->dimension = 3;
+	this->index = element_index;
+	FE_mesh *entity_mesh = fe_mesh;
+	while (this->dimension > 1)
+	{
+		FE_mesh *face_mesh = entity_mesh->getFaceMesh();
+		FE_element_shape *shape = entity_mesh->getElementShape(this->index);
+		if ((!face_mesh) || (!shape))
+			break;
+		for (i = 0; i < this->dimension; ++i)
+		{
+			mid[i] = 0.5*(a[i] + b[i]);
+		}
+		const int number_of_faces = FE_element_shape_get_number_of_faces(shape);
+		bool on_face = false;
+		for (int face_number = 0; face_number < number_of_faces; ++face_number)
+		{
+			if (FE_element_shape_get_face_xi_for_xi(shape, face_number, mid, tolerance, face_mid))
+			{
+				const DsLabelIndex face_index = entity_mesh->getElementFace(this->index, face_number);
+				if ((face_index >= 0) &&
+					FE_element_shape_get_face_xi_for_xi(shape, face_number, a, tolerance, face_a) &&
+					FE_element_shape_get_face_xi_for_xi(shape, face_number, b, tolerance, face_b))
+				{
+					--(this->dimension);
+					for (i = 0; i < this->dimension; ++i)
+					{
+						a[i] = face_a[i];
+						b[i] = face_b[i];
+					}
+					this->index = face_index;
+					entity_mesh = face_mesh;
+					on_face = true;
+					break;
+				}
+			}
+		}
+		if (!on_face)
+			break;
+	}
+	int qa[3] = { 0, 0, 0 }, qb[3] = { 0, 0, 0 };
+	for (i = 0; i < this->dimension; ++i)
+	{
+		qa[i] = static_cast<int>(floor(a[i]*scale + 0.5));
+		qb[i] = static_cast<int>(floor(b[i]*scale + 0.5));
+	}
+	const bool swap = (qb[0] < qa[0]) || ((qb[0] == qa[0]) &&
+		((qb[1] < qa[1]) || ((qb[1] == qa[1]) && (qb[2] < qa[2]))));
+	for (i = 0; i < 3; ++i)
+	{
+		this->q[i] = swap ? qb[i] : qa[i];
+		this->q[i + 3] = swap ? qa[i] : qb[i];
+	}
+}
+
+class Iso_shared_vertex
+{
+public:
+	Iso_shared_vertex_key key;
+	FE_value coordinates[3];
+	FE_value texture_coordinates[3];
+	std::vector<FE_value> data;
+};
+
+/** Iso-surface vertices and triangles from one element for merging */
+class Iso_element_shared_surfaces
+{
+public:
+	std::vector<Iso_shared_vertex> vertices;
+	std::vector<int> triangles;  // 3 indexes into vertices per triangle
+
+	void clear()
+	{
+		vertices.clear();
+		triangles.clear();
+	}
+};
+
 class Isosurface_builder
 {
 private:
@@ -603,6 +734,14 @@ public:
 
 	int fill_graphics(struct Graphics_vertex_array *array);
 
+	/**
+	 * Get triangles and vertices with keys for sharing with other elements.
+	 * @param surfaces  Cleared and filled with triangles and vertices.
+	 * @param d_dxi  Array of 3 first derivative operators w.r.t. element xi.
+	 */
+	void get_shared_surfaces(Iso_element_shared_surfaces& surfaces,
+		cmzn_differentialoperator_id *d_dxi);
+
 	void add_vertex_array_entries(struct Graphics_vertex_array *array,
 		enum Graphics_vertex_array_attribute_type type, int number_of_components,
 		const FE_value *values1, const FE_value *values2, const FE_value *values3);
@@ -645,7 +784,12 @@ private:
 		return (vertex);
 	}
 
-	bool reverse_winding();
+	/**
+	 * @param d_dxi  Optional array of 3 first derivative operators w.r.t.
+	 * element xi. If not supplied these are obtained from the mesh, which is
+	 * not thread safe.
+	 */
+	bool reverse_winding(cmzn_differentialoperator_id *d_dxi = nullptr);
 
 	double get_scalar(const Point_index& p) const
 	{
@@ -1776,7 +1920,7 @@ int Isosurface_builder::sweep()
 	return (return_code);
 }
 
-bool Isosurface_builder::reverse_winding()
+bool Isosurface_builder::reverse_winding(cmzn_differentialoperator_id *d_dxi)
 {
 	FE_value result[3], winding_coordinate_derivative1[3],
 		winding_coordinate_derivative2[3], winding_coordinate_derivative3[3];
@@ -1792,9 +1936,13 @@ bool Isosurface_builder::reverse_winding()
 	if (FE_element_shape_get_xi_points_cell_centres(shape,
 			number_in_xi, number_of_xi_points_created, &xi_points))
 	{
-		cmzn_differentialoperator_id d_dxi1 = cmzn_mesh_get_chart_differentialoperator(mesh, /*order*/1, 1);
-		cmzn_differentialoperator_id d_dxi2 = cmzn_mesh_get_chart_differentialoperator(mesh, /*order*/1, 2);
-		cmzn_differentialoperator_id d_dxi3 = cmzn_mesh_get_chart_differentialoperator(mesh, /*order*/1, 3);
+		// supplied operators are not accessed as access counts aren't thread safe
+		cmzn_differentialoperator_id d_dxi1 = (d_dxi) ? d_dxi[0] :
+			cmzn_mesh_get_chart_differentialoperator(mesh, /*order*/1, 1);
+		cmzn_differentialoperator_id d_dxi2 = (d_dxi) ? d_dxi[1] :
+			cmzn_mesh_get_chart_differentialoperator(mesh, /*order*/1, 2);
+		cmzn_differentialoperator_id d_dxi3 = (d_dxi) ? d_dxi[2] :
+			cmzn_mesh_get_chart_differentialoperator(mesh, /*order*/1, 3);
 		if ((CMZN_OK == this->field_cache->setMeshLocation(element, xi_points[0])) &&
 			(CMZN_OK == cmzn_field_evaluate_derivative(coordinate_field, d_dxi1, field_cache, 3, winding_coordinate_derivative1)) &&
 			(CMZN_OK == cmzn_field_evaluate_derivative(coordinate_field, d_dxi2, field_cache, 3, winding_coordinate_derivative2)) &&
@@ -1809,9 +1957,12 @@ bool Isosurface_builder::reverse_winding()
 			}
 		}
 		DEALLOCATE(xi_points);
-		cmzn_differentialoperator_destroy(&d_dxi1);
-		cmzn_differentialoperator_destroy(&d_dxi2);
-		cmzn_differentialoperator_destroy(&d_dxi3);
+		if (!d_dxi)
+		{
+			cmzn_differentialoperator_destroy(&d_dxi1);
+			cmzn_differentialoperator_destroy(&d_dxi2);
+			cmzn_differentialoperator_destroy(&d_dxi3);
+		}
 	}
 	return (reverse_winding);
 }
@@ -2025,6 +2176,236 @@ int Isosurface_builder::fill_graphics(struct Graphics_vertex_array *array)
 	return (return_code);
 }
 
+void Isosurface_builder::get_shared_surfaces(Iso_element_shared_surfaces& surfaces,
+	cmzn_differentialoperator_id *d_dxi)
+{
+	surfaces.clear();
+	const bool reverse = reverse_winding(d_dxi);
+	FE_mesh *fe_mesh = element->getMesh();
+	const DsLabelIndex element_index = get_FE_element_index(element);
+	std::map<const Iso_vertex *, int> vertex_indexes;
+	FE_value xi_a[3], xi_b[3];
+	for (Iso_mesh_map_const_iterator mesh_iter = mesh_map.begin();
+		mesh_iter != mesh_map.end(); mesh_iter++)
+	{
+		const Iso_mesh& mesh = *(mesh_iter->second);
+		// only keep vertices used by triangles, in map order
+		vertex_indexes.clear();
+		for (Iso_triangle_list_const_iterator triangle_iter = mesh.triangle_list.begin();
+			triangle_iter != mesh.triangle_list.end(); triangle_iter++)
+		{
+			const Iso_triangle *triangle = *triangle_iter;
+			vertex_indexes[triangle->v1] = -1;
+			vertex_indexes[triangle->v2] = -1;
+			vertex_indexes[triangle->v3] = -1;
+		}
+		for (Iso_vertex_map_const_iterator vertex_iter = mesh.vertex_map.begin();
+			vertex_iter != mesh.vertex_map.end(); vertex_iter++)
+		{
+			const Iso_vertex *vertex = vertex_iter->second;
+			std::map<const Iso_vertex *, int>::iterator index_iter = vertex_indexes.find(vertex);
+			if (index_iter == vertex_indexes.end())
+				continue;
+			index_iter->second = static_cast<int>(surfaces.vertices.size());
+			surfaces.vertices.push_back(Iso_shared_vertex());
+			Iso_shared_vertex& shared_vertex = surfaces.vertices.back();
+			get_xi(vertex_iter->first.pa, xi_a);
+			get_xi(vertex_iter->first.pb, xi_b);
+			shared_vertex.key.set(fe_mesh, element_index, xi_a, xi_b, mesh_iter->first);
+			for (int i = 0; i < 3; ++i)
+			{
+				shared_vertex.coordinates[i] = vertex->coordinates[i];
+				shared_vertex.texture_coordinates[i] = vertex->texture_coordinates[i];
+			}
+			if (vertex->data)
+			{
+				shared_vertex.data.assign(vertex->data, vertex->data + number_of_data_components);
+			}
+		}
+		for (Iso_triangle_list_const_iterator triangle_iter = mesh.triangle_list.begin();
+			triangle_iter != mesh.triangle_list.end(); triangle_iter++)
+		{
+			const Iso_triangle *triangle = *triangle_iter;
+			surfaces.triangles.push_back(vertex_indexes[triangle->v1]);
+			surfaces.triangles.push_back(vertex_indexes[reverse ? triangle->v3 : triangle->v2]);
+			surfaces.triangles.push_back(vertex_indexes[reverse ? triangle->v2 : triangle->v3]);
+		}
+	}
+}
+
+/**
+ * Merges iso-surfaces from elements into a vertex array, sharing vertices
+ * with matching keys. Normals are accumulated from triangles as they are
+ * added and added to the array by finish().
+ */
+class Iso_shared_surfaces_merger
+{
+	Graphics_vertex_array *array;
+	const int number_of_data_components;
+	const bool texture_coordinates;
+	std::map<Iso_shared_vertex_key, unsigned int> vertex_index_map;
+	std::vector<FE_value> normals;
+	unsigned int vertex_start, vertex_count;
+	unsigned int strip_start, strip_index_start;
+	std::vector<unsigned int> global_indexes;
+
+public:
+	Iso_shared_surfaces_merger(Graphics_vertex_array *array_in,
+			int number_of_data_components_in, bool texture_coordinates_in) :
+		array(array_in),
+		number_of_data_components(number_of_data_components_in),
+		texture_coordinates(texture_coordinates_in),
+		vertex_count(0),
+		strip_start(0),
+		strip_index_start(0)
+	{
+		this->vertex_start = array->get_number_of_vertices(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
+		// continue strips after any already in array
+		const unsigned int last_entry = array->get_number_of_vertices(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_START);
+		if (last_entry > 0)
+		{
+			unsigned int last_number_of_strips = 0;
+			array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_START,
+				last_entry - 1, 1, &this->strip_start);
+			array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_STRIPS,
+				last_entry - 1, 1, &last_number_of_strips);
+			this->strip_start += last_number_of_strips;
+		}
+		const unsigned int last_strip = array->get_number_of_vertices(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_START);
+		if (last_strip > 0)
+		{
+			unsigned int last_points_per_strip = 0;
+			array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_START,
+				last_strip - 1, 1, &this->strip_index_start);
+			array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
+				last_strip - 1, 1, &last_points_per_strip);
+			this->strip_index_start += last_points_per_strip;
+		}
+	}
+
+	void add_element_surfaces(DsLabelIndex element_index,
+		const Iso_element_shared_surfaces& surfaces)
+	{
+		const unsigned int number_of_triangles =
+			static_cast<unsigned int>(surfaces.triangles.size() / 3);
+		if (0 == number_of_triangles)
+			return;
+		const unsigned int element_vertex_start = this->vertex_start + this->vertex_count;
+		GLfloat float_values[3];
+		GLfloat *float_data = (0 < this->number_of_data_components) ?
+			new GLfloat[this->number_of_data_components] : nullptr;
+		const size_t number_of_vertices = surfaces.vertices.size();
+		this->global_indexes.resize(number_of_vertices);
+		for (size_t v = 0; v < number_of_vertices; ++v)
+		{
+			const Iso_shared_vertex& vertex = surfaces.vertices[v];
+			std::map<Iso_shared_vertex_key, unsigned int>::iterator iter =
+				this->vertex_index_map.find(vertex.key);
+			if (iter != this->vertex_index_map.end())
+			{
+				this->global_indexes[v] = iter->second;
+				continue;
+			}
+			const unsigned int global_index = this->vertex_start + this->vertex_count;
+			this->vertex_index_map[vertex.key] = global_index;
+			this->global_indexes[v] = global_index;
+			++(this->vertex_count);
+			CAST_TO_OTHER(float_values, vertex.coordinates, GLfloat, 3);
+			this->array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+				3, 1, float_values);
+			if (this->texture_coordinates)
+			{
+				CAST_TO_OTHER(float_values, vertex.texture_coordinates, GLfloat, 3);
+				this->array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_TEXTURE_COORDINATE_ZERO,
+					3, 1, float_values);
+			}
+			if (float_data)
+			{
+				CAST_TO_OTHER(float_data, vertex.data.data(), GLfloat, this->number_of_data_components);
+				this->array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+					this->number_of_data_components, 1, float_data);
+			}
+			this->normals.push_back(0.0);
+			this->normals.push_back(0.0);
+			this->normals.push_back(0.0);
+		}
+		delete[] float_data;
+		const unsigned int points_per_strip = 3;
+		for (unsigned int t = 0; t < number_of_triangles; ++t)
+		{
+			const int *triangle = surfaces.triangles.data() + 3*t;
+			const FE_value *c1 = surfaces.vertices[triangle[0]].coordinates;
+			const FE_value *c2 = surfaces.vertices[triangle[1]].coordinates;
+			const FE_value *c3 = surfaces.vertices[triangle[2]].coordinates;
+			FE_value axis1[3], axis2[3], facet_normal[3];
+			for (int i = 0; i < 3; ++i)
+			{
+				axis1[i] = c2[i] - c1[i];
+				axis2[i] = c3[i] - c1[i];
+			}
+			// not normalised so vertex normal is area-weighted
+			cross_product_FE_value_vector3(axis1, axis2, facet_normal);
+			for (int p = 0; p < 3; ++p)
+			{
+				const unsigned int global_index = this->global_indexes[triangle[p]];
+				FE_value *normal = this->normals.data() + 3*(global_index - this->vertex_start);
+				normal[0] += facet_normal[0];
+				normal[1] += facet_normal[1];
+				normal[2] += facet_normal[2];
+				this->array->add_unsigned_integer_attribute(
+					GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_ARRAY, 1, 1, &global_index);
+			}
+			this->array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_START,
+				1, 1, &this->strip_index_start);
+			this->array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
+				1, 1, &points_per_strip);
+			this->strip_index_start += points_per_strip;
+		}
+		const int object_id = element_index;
+		this->array->add_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_OBJECT_ID,
+			1, 1, &object_id);
+		const int modificationRequired = 0;
+		this->array->add_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_UPDATE_REQUIRED,
+			1, 1, &modificationRequired);
+		// vertices first added by this element; triangles may also use earlier vertices
+		const unsigned int element_vertex_count = this->vertex_start + this->vertex_count - element_vertex_start;
+		this->array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+			1, 1, &element_vertex_count);
+		this->array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
+			1, 1, &element_vertex_start);
+		const int polygonType = (int)g_TRIANGLE;
+		this->array->add_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POLYGON,
+			1, 1, &polygonType);
+		const unsigned int number_of_xi2 = 3;
+		this->array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_XI1,
+			1, 1, &number_of_triangles);
+		this->array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_XI2,
+			1, 1, &number_of_xi2);
+		this->array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_START,
+			1, 1, &this->strip_start);
+		this->array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_STRIPS,
+			1, 1, &number_of_triangles);
+		this->strip_start += number_of_triangles;
+	}
+
+	/** Add normalised vertex normals to array. Call once after all elements added. */
+	void finish()
+	{
+		GLfloat float_normal[3];
+		for (unsigned int v = 0; v < this->vertex_count; ++v)
+		{
+			FE_value *normal = this->normals.data() + 3*v;
+			normalize3(normal);
+			CAST_TO_OTHER(float_normal, normal, GLfloat, 3);
+			this->array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+				3, 1, float_normal);
+		}
+	}
+};
+
 } // anonymous namespace
 
 /*
@@ -2164,3 +2545,126 @@ int create_iso_surfaces_from_FE_element(struct FE_element *element,
 	return (return_code);
 } /* create_iso_surfaces_from_FE_element */
 
+
+int create_shared_iso_surfaces_from_FE_elements(int number_of_elements,
+	const struct Iso_surface_element *elements,
+	cmzn_fieldcache_id field_cache, cmzn_mesh_id mesh,
+	struct Graphics_vertex_array *array,
+	struct Iso_surface_specification *specification, int threadCount)
+{
+	if (!((0 <= number_of_elements) && ((0 == number_of_elements) || (elements)) &&
+		(field_cache) && (mesh) && (3 == cmzn_mesh_get_dimension(mesh)) &&
+		(array) && (specification) && (0 <= threadCount)))
+	{
+		display_message(ERROR_MESSAGE,
+			"create_shared_iso_surfaces_from_FE_elements.  Invalid argument(s)");
+		return 0;
+	}
+	for (int e = 0; e < number_of_elements; ++e)
+	{
+		const Iso_surface_element& iso_element = elements[e];
+		if (!((iso_element.element) && (3 == get_FE_element_dimension(iso_element.element)) &&
+			(0 < iso_element.number_in_xi[0]) && (0 < iso_element.number_in_xi[1]) &&
+			(0 < iso_element.number_in_xi[2])))
+		{
+			display_message(ERROR_MESSAGE,
+				"create_shared_iso_surfaces_from_FE_elements.  Invalid element or discretization");
+			return 0;
+		}
+	}
+	if (0 == number_of_elements)
+	{
+		return 1;
+	}
+	// obtained here as getting these from the mesh is not thread safe
+	cmzn_differentialoperator_id d_dxi[3];
+	for (int i = 0; i < 3; ++i)
+	{
+		d_dxi[i] = cmzn_mesh_get_chart_differentialoperator(mesh, /*order*/1, i + 1);
+	}
+	auto sweepElement = [&](const Iso_surface_element& iso_element,
+		cmzn_fieldcache_id fieldcache, Iso_element_shared_surfaces& surfaces) -> int
+	{
+		Isosurface_builder iso_builder(iso_element.element, fieldcache, mesh,
+			iso_element.number_in_xi[0], iso_element.number_in_xi[1], iso_element.number_in_xi[2],
+			*specification);
+		const int result = iso_builder.sweep();
+		if (result)
+		{
+			iso_builder.get_shared_surfaces(surfaces, d_dxi);
+		}
+		else
+		{
+			surfaces.clear();
+		}
+		return result;
+	};
+	Iso_shared_surfaces_merger merger(array, specification->number_of_data_components,
+		(0 != specification->texture_coordinate_field));
+	const int chunkSize = 16;
+	cmzn::ThreadPool& threadPool = field_cache->getRegion()->getThreadPool();
+	threadCount = threadPool.getLoopThreadCount(threadCount, (number_of_elements + chunkSize - 1)/chunkSize);
+	int return_code = 1;
+	if (threadCount <= 1)
+	{
+		Iso_element_shared_surfaces surfaces;
+		for (int e = 0; e < number_of_elements; ++e)
+		{
+			if (sweepElement(elements[e], field_cache, surfaces))
+			{
+				merger.add_element_surfaces(get_FE_element_index(elements[e].element), surfaces);
+			}
+			else
+			{
+				return_code = 0;
+			}
+		}
+	}
+	else
+	{
+		// first thread uses field_cache; others get their own at the same time
+		FieldcacheThreadSet fieldcaches(field_cache, threadCount);
+		fieldcaches.createValueCaches(specification->coordinate_field);
+		fieldcaches.createValueCaches(specification->scalar_field);
+		fieldcaches.createValueCaches(specification->data_field);
+		fieldcaches.createValueCaches(specification->texture_coordinate_field);
+		const int batchSize = chunkSize*16*threadCount;
+		std::vector<Iso_element_shared_surfaces> batchSurfaces(
+			(number_of_elements < batchSize) ? number_of_elements : batchSize);
+		std::vector<int> sweepResults(batchSurfaces.size());
+		for (int batchStart = 0; batchStart < number_of_elements; batchStart += batchSize)
+		{
+			const int batchElementsCount = ((number_of_elements - batchStart) < batchSize) ?
+				number_of_elements - batchStart : batchSize;
+			threadPool.parallelFor(0, batchElementsCount, chunkSize, threadCount,
+				[&](int chunkStart, int chunkEnd, int threadIndex)
+				{
+					cmzn_fieldcache *fieldcache = fieldcaches.getFieldcache(threadIndex);
+					for (int i = chunkStart; i < chunkEnd; ++i)
+					{
+						sweepResults[i] = sweepElement(elements[batchStart + i], fieldcache, batchSurfaces[i]);
+					}
+				});
+			// merge in element order
+			for (int i = 0; i < batchElementsCount; ++i)
+			{
+				if (sweepResults[i])
+				{
+					merger.add_element_surfaces(get_FE_element_index(elements[batchStart + i].element),
+						batchSurfaces[i]);
+				}
+				else
+				{
+					return_code = 0;
+				}
+				batchSurfaces[i].clear();
+			}
+		}
+	}
+	merger.finish();
+	for (int i = 0; i < 3; ++i)
+	{
+		cmzn_differentialoperator_destroy(&d_dxi[i]);
+	}
+	return return_code;
+}
@@ -48,4 +48,41 @@ int create_iso_surfaces_from_FE_element(struct FE_element *element,
 	struct Graphics_vertex_array *array,
 	int *number_in_xi, struct Iso_surface_specification *specification);
 
+/**
+ * A 3-D element and its discretization for shared iso-surface extraction.
+ */
+struct Iso_surface_element
+{
+	struct FE_element *element;
+	int number_in_xi[3];
+};
+
+/**
+ * Converts 3-D elements into a single indexed triangle mesh per iso-value in
+ * which vertices on lines shared by elements, found from the mesh's face
+ * connectivity, are computed once and shared, so the surface has no cracks
+ * where element discretizations agree. Vertex normals are averaged over the
+ * triangles using them. Each element's triangles are added as a separate
+ * surface of 3-point strips indexing the shared vertices, with the element
+ * index as object ID; requires a surface primitive with continuous shading.
+ * Elements are swept concurrently with the given number of threads then
+ * merged in element order, so output is independent of the thread count.
+ * Faces should be defined on the mesh for vertices to be shared.
+ *
+ * @param number_of_elements  Size of elements array >= 0.
+ * @param elements  Array of 3-D elements and discretizations.
+ * @param field_cache  Field cache for the region, with time set.
+ * @param mesh  The 3-D mesh to get chart derivatives from.
+ * @param array  The vertex array to add to.
+ * @param specification  The iso-surface specification.
+ * @param threadCount  Maximum number of threads >= 0 from the region's
+ * context thread pool, where 0 uses all pool threads. Fields must be safe to evaluate concurrently if > 1.
+ * @return  1 on success, 0 on failure.
+ */
+int create_shared_iso_surfaces_from_FE_elements(int number_of_elements,
+	const struct Iso_surface_element *elements,
+	cmzn_fieldcache_id field_cache, cmzn_mesh_id mesh,
+	struct Graphics_vertex_array *array,
+	struct Iso_surface_specification *specification, int threadCount);
+
 #endif /* !defined (FINITE_ELEMENT_TO_ISO_SURFACES_H) */
@@ -24,6 +24,7 @@ Functions for calculating streamlines in finite elements.
 #include "general/geometry.h"
 #include "general/matrix_vector.h"
 #include "general/random.h"
+#include "general/thread_pool.hpp"
 #include "graphics/graphics_object.h"
 #include "graphics/graphics_object.hpp"
 #include "general/message.h"
@@ -31,6 +32,7 @@ Functions for calculating streamlines in finite elements.
 	however the stream point stuff currently messes around in the guts
 	of a pointset. */
 #include "graphics/graphics_object_private.hpp"
+#include <vector>
 
 /*
 Module types
@@ -182,8 +184,8 @@ size control and the improved euler method.  The function updates the <total_ste
 If <reverse_track> is true, the reverse of vector field is tracked.
 ==============================================================================*/
 {
-	int element_dimension,face_number,i,initial_face_number,j,
-		number_of_permutations, permutation, return_code,vector_dimension, face_numberB = 0;
+	int element_dimension,face_number,i,j,
+		permutation, return_code,vector_dimension, face_numberB = 0;
 	FE_value coordinate_length, coordinate_point_error, coordinate_point_vector, coordinate_tolerance,
 		deltaxi[MAXIMUM_ELEMENT_XI_DIMENSIONS],deltaxiA[MAXIMUM_ELEMENT_XI_DIMENSIONS],
 		deltaxiC[MAXIMUM_ELEMENT_XI_DIMENSIONS], deltaxiD[MAXIMUM_ELEMENT_XI_DIMENSIONS],
@@ -515,61 +517,44 @@ If <reverse_track> is true, the reverse of vector field is tracked.
 			*total_stepped += local_step_size;
 			if (face_number != -1)
 			{
-				initial_element = *element;
-				initial_face_number = face_number;
-				xiD[0]=xiF[0];
-				xiD[1]=xiF[1];
-				xiD[2]=xiF[2];
 				/* The last increment should have been the most accurate, if
-				it wants to change then change element if we can */
-				return_code = FE_element_change_to_adjacent_element(element,
-					xiF, (FE_value *)NULL, &face_number, xi_face, /*permutation*/0);
-				if (face_number == -1)
+				it wants to change then change element if we can.
+				Look up the adjacent element once, then try permutations of the
+				face xi until the coordinates match across the face */
+				FE_element_adjacent_face adjacent_face;
+				return_code = FE_element_get_adjacent_face(*element, face_number, &adjacent_face);
+				if (return_code && (!adjacent_face.element))
 				{
 					/* There is no adjacent element */
 					*keep_tracking = 0;
 				}
-				else
+				else if (return_code)
 				{
-					/* Check the new xi coordinates are correct for our
-					coordinate field and if not try rotating them */
-
-					return_code = (CMZN_OK == field_cache->setMeshLocation(*element, xiF)) &&
-						(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, point1));
-					coordinate_point_error = 0.0;
-					for (i = 0 ; i < vector_dimension ; i++)
-					{
-						coordinate_point_error += (point1[i] - point3[i]) * 
-							(point1[i] - point3[i]);
-					}
-					coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
-					// this permutation loop is inefficient; should extract common adjacent element code
-					number_of_permutations =
-						FE_element_get_number_of_change_to_adjacent_element_permutations(
-							*element, xiF, face_number);
-					/* We have already tried permutation 0 */
-					permutation = 1;
-					while ((permutation < number_of_permutations) &&
-						(coordinate_point_error > coordinate_tolerance))
+					initial_element = *element;
+					xiD[0]=xiF[0];
+					xiD[1]=xiF[1];
+					xiD[2]=xiF[2];
+					coordinate_point_error = coordinate_tolerance + 1.0;
+					for (permutation = 0; return_code && (permutation < adjacent_face.number_of_permutations) &&
+						(coordinate_point_error > coordinate_tolerance); ++permutation)
 					{
-						*element = initial_element;
-						face_number = initial_face_number;
-						xiF[0]=xiD[0];
-						xiF[1]=xiD[1];
-						xiF[2]=xiD[2];
-						return_code = FE_element_change_to_adjacent_element(element,
-							xiF, (FE_value *)NULL, &face_number, xi_face, permutation);
-						return_code = (CMZN_OK == field_cache->setMeshLocation(*element, xiF)) &&
+						/* Check the new xi coordinates are correct for our
+						coordinate field and if not try rotating them */
+						return_code = FE_element_adjacent_face_xi_to_xi(&adjacent_face, xi_face, permutation, xiF) &&
+							(CMZN_OK == field_cache->setMeshLocation(adjacent_face.element, xiF)) &&
 							(CMZN_OK == cmzn_field_evaluate_real(coordinate_field, field_cache, vector_dimension, point1));
-						coordinate_point_error = 0.0;
-						for (i = 0 ; i < vector_dimension ; i++)
+						if (return_code)
 						{
-							coordinate_point_error += (point1[i] - point3[i]) *
-								(point1[i] - point3[i]);
+							coordinate_point_error = 0.0;
+							for (i = 0 ; i < vector_dimension ; i++)
+							{
+								coordinate_point_error += (point1[i] - point3[i]) *
+									(point1[i] - point3[i]);
+							}
+							coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
 						}
-						coordinate_point_error = sqrt(coordinate_point_error) / coordinate_length;
-						permutation++;
 					}
+					*element = adjacent_face.element;
 					element_shape = get_FE_element_shape(*element);
 					if (!element_shape)
 					{
@@ -1349,89 +1334,467 @@ following way:
 	return (return_code);
 } /* track_streamline_from_FE_element */
 
-/*
-Global functions
-----------------
-*/
+namespace {
 
-int create_polyline_streamline_FE_element_vertex_array(
-	struct FE_element *element,FE_value *start_xi,
-	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
-	struct Computed_field *stream_vector_field,int reverse_track,
-	FE_value length, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
-	struct Computed_field *data_field,
+/**
+ * Points, vectors, normals and optional data along a streamline tracked from a
+ * seed location. Owns the arrays returned by track_streamline_from_FE_element.
+ * Tracking only modifies the field cache, so separate tracks can be made
+ * concurrently with separate field caches.
+ */
+class StreamlineTrack
+{
+public:
+	int number_of_points;
+	Triple *points, *vectors, *normals;
+	GLfloat *data;
+
+	StreamlineTrack() :
+		number_of_points(0),
+		points(nullptr),
+		vectors(nullptr),
+		normals(nullptr),
+		data(nullptr)
+	{
+	}
+
+	StreamlineTrack(const StreamlineTrack&) = delete;
+	StreamlineTrack& operator=(const StreamlineTrack&) = delete;
+
+	StreamlineTrack(StreamlineTrack&& source) noexcept :
+		number_of_points(source.number_of_points),
+		points(source.points),
+		vectors(source.vectors),
+		normals(source.normals),
+		data(source.data)
+	{
+		source.number_of_points = 0;
+		source.points = nullptr;
+		source.vectors = nullptr;
+		source.normals = nullptr;
+		source.data = nullptr;
+	}
+
+	~StreamlineTrack()
+	{
+		this->clear();
+	}
+
+	void clear()
+	{
+		DEALLOCATE(this->points);
+		DEALLOCATE(this->vectors);
+		DEALLOCATE(this->normals);
+		DEALLOCATE(this->data);
+		this->number_of_points = 0;
+	}
+
+	/** Track streamline from element and xi, replacing any previous track.
+	 * @return  Result of track_streamline_from_FE_element */
+	int track(struct FE_element *element, const FE_value *start_xi,
+		cmzn_fieldcache_id field_cache, const Streamline_settings& settings)
+	{
+		this->clear();
+		FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+		for (int i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
+		{
+			xi[i] = start_xi[i];
+		}
+		return track_streamline_from_FE_element(&element, xi,
+			field_cache, settings.coordinate_field, settings.stream_vector_field,
+			settings.reverse_track, settings.length,
+			settings.colour_data_type, settings.data_field, &this->number_of_points,
+			&this->points, &this->vectors, &this->normals, &this->data);
+	}
+};
+
+/**
+ * Append tracked streamline to array as a polyline.
+ * @return  1 if added, 0 if streamline is empty.
+ */
+int append_polyline_streamline_to_vertex_array(const StreamlineTrack& track,
 	struct Graphics_vertex_array *array)
 {
-	GLfloat *stream_data;
-	int element_dimension,number_of_stream_points,number_of_coordinate_components,
-		number_of_stream_vector_components, return_code = 1;
-	Triple *stream_points,*stream_normals,*stream_vectors;
+	const int number_of_stream_points = track.number_of_points;
+	if (number_of_stream_points <= 0)
+	{
+		return 0;
+	}
+	unsigned int total_number_of_vertices = number_of_stream_points;
+	unsigned int vertex_start = array->get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
+	array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+		3, number_of_stream_points, &(track.points[0][0]));
+	if (track.data)
+		array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+			1, number_of_stream_points, track.data);
+	array->add_unsigned_integer_attribute(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+		1, 1, &total_number_of_vertices);
+	array->add_unsigned_integer_attribute(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
+		1, 1, &vertex_start);
+	return 1;
+}
+
+/**
+ * Append tracked streamline to array as a ribbon or extrusion surface.
+ * @param line_shape  RIBBON, CIRCLE_EXTRUSION or SQUARE_EXTRUSION.
+ * @param line_base_size  width and thickness of line, use depends on shape.
+ * @return  1 if added, 0 if streamline is empty.
+ */
+int append_surface_streamribbon_to_vertex_array(const StreamlineTrack& track,
+	enum cmzn_graphicslineattributes_shape_type line_shape, int circleDivisions,
+	const FE_value *line_base_size, struct Graphics_vertex_array *array)
+{
+	const int number_of_stream_points = track.number_of_points;
+	if (number_of_stream_points <= 0)
+	{
+		return 0;
+	}
+	double cosw,magnitude,sinw;
+	GLfloat stream_datum = 0.0;
+	int d,i,surface_points_per_step;
+	Triple cross_thickness,cross_width,normal,point,stream_cross,
+		stream_normal,stream_point,
+		stream_unit_vector = {1.0, 0.0, 0.0},stream_vector;
+	const Triple *stream_points = track.points;
+	const Triple *stream_vectors = track.vectors;
+	const Triple *stream_normals = track.normals;
+	const GLfloat *stream_data = track.data;
+	const bool hasData = (0 != stream_data);
+	const FE_value width = line_base_size[0];
+	const FE_value thickness = line_base_size[1];
+
+	switch (line_shape)
+	{
+		case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_SQUARE_EXTRUSION:
+		{
+			surface_points_per_step = 8;
+		} break;
+		case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_CIRCLE_EXTRUSION:
+		{
+			surface_points_per_step = circleDivisions + 1;
+		} break;
+		case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_RIBBON:
+		default:
+		{
+			surface_points_per_step = 2;
+		} break;
+	}
 
-	if (stream_vector_field)
+	unsigned int vertex_start = array->get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
+	unsigned int number_of_vertices = surface_points_per_step * number_of_stream_points;
+	/* now fill in the points and data from the streamline */
+	GLfloat floatField[3];
+	for (i=0;i<number_of_stream_points;i++)
 	{
-		if (element&&FE_element_is_top_level(element, NULL)&&
-			(element_dimension = get_FE_element_dimension(element))&&
-			((3 == element_dimension) || (2 == element_dimension))
-			&&start_xi&&coordinate_field&&
-			(number_of_coordinate_components=cmzn_field_get_number_of_components(coordinate_field))&&
-			(number_of_stream_vector_components=cmzn_field_get_number_of_components(stream_vector_field))
-			&& (((3 == number_of_coordinate_components) &&
-			((3==number_of_stream_vector_components)||
-			(6==number_of_stream_vector_components)||
-			(9==number_of_stream_vector_components)))
-			|| ((2 == number_of_coordinate_components) &&
-			(2==number_of_stream_vector_components)))&&
-			(0.0<length) && array)
+		stream_point[0]=stream_points[i][0];
+		stream_point[1]=stream_points[i][1];
+		stream_point[2]=stream_points[i][2];
+		stream_vector[0]=stream_vectors[i][0];
+		stream_vector[1]=stream_vectors[i][1];
+		stream_vector[2]=stream_vectors[i][2];
+		stream_normal[0]=stream_normals[i][0];
+		stream_normal[1]=stream_normals[i][1];
+		stream_normal[2]=stream_normals[i][2];
+		if (stream_data)
 		{
-			/* track points and normals on streamline, and data if requested */
-			if (track_streamline_from_FE_element(&element,start_xi,
-				field_cache, coordinate_field,stream_vector_field,reverse_track,length,
-				colour_data_type,data_field,&number_of_stream_points,&stream_points,
-					&stream_vectors,&stream_normals,&stream_data))
+			stream_datum=stream_data[i];
+		}
+		if (0.0 < (magnitude = sqrt(stream_vector[0]*stream_vector[0]+
+			stream_vector[1]*stream_vector[1]+
+			stream_vector[2]*stream_vector[2])))
+		{
+			stream_unit_vector[0] = stream_vector[0] / GLfloat(magnitude);
+			stream_unit_vector[1] = stream_vector[1] / GLfloat(magnitude);
+			stream_unit_vector[2] = stream_vector[2] / GLfloat(magnitude);
+		}
+		/* get stream_cross = stream_normal (x) stream_unit_vector */
+		stream_cross[0]=stream_normal[1]*stream_unit_vector[2]-
+			stream_normal[2]*stream_unit_vector[1];
+		stream_cross[1]=stream_normal[2]*stream_unit_vector[0]-
+			stream_normal[0]*stream_unit_vector[2];
+		stream_cross[2]=stream_normal[0]*stream_unit_vector[1]-
+			stream_normal[1]*stream_unit_vector[0];
+		cross_width[0] = stream_cross[0] * 0.5f * width;
+		cross_width[1] = stream_cross[1] * 0.5f * width;
+		cross_width[2] = stream_cross[2] * 0.5f * width;
+		cross_thickness[0] = stream_normal[0] * 0.5f * GLfloat(thickness);
+		cross_thickness[1] = stream_normal[1] * 0.5f * GLfloat(thickness);
+		cross_thickness[2] = stream_normal[2] * 0.5f * GLfloat(thickness);
+		switch (line_shape)
+		{
+			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_RIBBON:
+			default:
 			{
-				if (0<number_of_stream_points)
+				point[0] = stream_point[0] + cross_width[0];
+				point[1] = stream_point[1] + cross_width[1];
+				point[2] = stream_point[2] + cross_width[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = stream_normal[0];
+				normal[1] = stream_normal[1];
+				normal[2] = stream_normal[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && (stream_data))
 				{
-					unsigned int total_number_of_vertices = number_of_stream_points;
-					unsigned int vertex_start = array->get_number_of_vertices(
-						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
-
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
+				}
+				point[0] = stream_point[0] - cross_width[0];
+				point[1] = stream_point[1] - cross_width[1];
+				point[2] = stream_point[2] - cross_width[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = stream_normal[0];
+				normal[1] = stream_normal[1];
+				normal[2] = stream_normal[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && stream_data)
+				{
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
+				}
+			} break;
+			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_CIRCLE_EXTRUSION:
+			{
+				for (d = 0 ; d < surface_points_per_step ; d++)
+				{
+					sinw = sin( 2 * PI * (double)d /
+						(double)(surface_points_per_step - 1));
+					cosw = cos( 2 * PI * (double)d /
+						(double)(surface_points_per_step - 1));
+					point[0] = stream_point[0] + GLfloat(sinw) * cross_width[0] + GLfloat(cosw) * cross_thickness[0];
+					point[1] = stream_point[1] + GLfloat(sinw) * cross_width[1] + GLfloat(cosw) * cross_thickness[1];
+					point[2] = stream_point[2] + GLfloat(sinw) * cross_width[2] + GLfloat(cosw) * cross_thickness[2];
+					CAST_TO_OTHER(floatField,point,GLfloat,3);
 					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-						3, number_of_stream_points, &(stream_points[0][0]));
-					if (stream_data)
+						3, 1, floatField);
+					normal[0] = -GLfloat(sinw) * stream_cross[0] * 0.5f * GLfloat(thickness) -
+						GLfloat(cosw) * stream_normal[0] * 0.5f * width;
+					normal[1] = -GLfloat(sinw) * stream_cross[1] * 0.5f * GLfloat(thickness) -
+						GLfloat(cosw) * stream_normal[1] * 0.5f * GLfloat(thickness);
+					normal[2] = -GLfloat(sinw) * stream_cross[2] * 0.5f * GLfloat(thickness) -
+						GLfloat(cosw) * stream_normal[2] * 0.5f * GLfloat(thickness);
+					magnitude = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
+					if (0.0<magnitude)
+					{
+						normal[0] /= GLfloat(magnitude);
+						normal[1] /= GLfloat(magnitude);
+						normal[2] /= GLfloat(magnitude);
+					}
+					CAST_TO_OTHER(floatField,normal,GLfloat,3);
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+						3, 1, floatField);
+					if (hasData && stream_data)
+					{
 						array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-							1, number_of_stream_points, stream_data);
-					array->add_unsigned_integer_attribute(
-						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
-						1, 1, &total_number_of_vertices);
-					array->add_unsigned_integer_attribute(
-						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
-						1, 1, &vertex_start);
-					DEALLOCATE(stream_points);
-					DEALLOCATE(stream_data);
-					DEALLOCATE(stream_vectors);
-					DEALLOCATE(stream_normals);
+							1, 1, &stream_datum);
+					}
 				}
-				else
+			} break;
+			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_SQUARE_EXTRUSION:
+			{
+				point[0] = stream_point[0] + cross_width[0] + cross_thickness[0];
+				point[1] = stream_point[1] + cross_width[1] + cross_thickness[1];
+				point[2] = stream_point[2] + cross_width[2] + cross_thickness[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = stream_normal[0];
+				normal[1] = stream_normal[1];
+				normal[2] = stream_normal[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && stream_data)
 				{
-					return_code = 0;
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
 				}
-			}
-			else
-			{
-				return_code = 0;
-			}
-		}
-		else
-		{
-			return_code = 0;
+				point[0] = stream_point[0] - cross_width[0] + cross_thickness[0];
+				point[1] = stream_point[1] - cross_width[1] + cross_thickness[1];
+				point[2] = stream_point[2] - cross_width[2] + cross_thickness[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = stream_normal[0];
+				normal[1] = stream_normal[1];
+				normal[2] = stream_normal[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && stream_data)
+				{
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
+				}
+
+				point[0] = stream_point[0] - cross_width[0] + cross_thickness[0];
+				point[1] = stream_point[1] - cross_width[1] + cross_thickness[1];
+				point[2] = stream_point[2] - cross_width[2] + cross_thickness[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = -stream_cross[0];
+				normal[1] = -stream_cross[1];
+				normal[2] = -stream_cross[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && stream_data)
+				{
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
+				}
+				point[0] = stream_point[0] - cross_width[0] - cross_thickness[0];
+				point[1] = stream_point[1] - cross_width[1] - cross_thickness[1];
+				point[2] = stream_point[2] - cross_width[2] - cross_thickness[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = -stream_cross[0];
+				normal[1] = -stream_cross[1];
+				normal[2] = -stream_cross[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && stream_data)
+				{
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
+				}
+
+				point[0] = stream_point[0] - cross_width[0] - cross_thickness[0];
+				point[1] = stream_point[1] - cross_width[1] - cross_thickness[1];
+				point[2] = stream_point[2] - cross_width[2] - cross_thickness[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = -stream_normal[0];
+				normal[1] = -stream_normal[1];
+				normal[2] = -stream_normal[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && stream_data)
+				{
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
+				}
+				point[0] = stream_point[0] + cross_width[0] - cross_thickness[0];
+				point[1] = stream_point[1] + cross_width[1] - cross_thickness[1];
+				point[2] = stream_point[2] + cross_width[2] - cross_thickness[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = -stream_normal[0];
+				normal[1] = -stream_normal[1];
+				normal[2] = -stream_normal[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && stream_data)
+				{
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
+				}
+
+				point[0] = stream_point[0] + cross_width[0] - cross_thickness[0];
+				point[1] = stream_point[1] + cross_width[1] - cross_thickness[1];
+				point[2] = stream_point[2] + cross_width[2] - cross_thickness[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = stream_cross[0];
+				normal[1] = stream_cross[1];
+				normal[2] = stream_cross[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && stream_data)
+				{
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
+				}
+				point[0] = stream_point[0] + cross_width[0] + cross_thickness[0];
+				point[1] = stream_point[1] + cross_width[1] + cross_thickness[1];
+				point[2] = stream_point[2] + cross_width[2] + cross_thickness[2];
+				CAST_TO_OTHER(floatField,point,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+					3, 1, floatField);
+				normal[0] = stream_cross[0];
+				normal[1] = stream_cross[1];
+				normal[2] = stream_cross[2];
+				CAST_TO_OTHER(floatField,normal,GLfloat,3);
+				array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+					3, 1, floatField);
+				if (hasData && stream_data)
+				{
+					array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						1, 1, &stream_datum);
+				}
+			} break;
 		}
 	}
-	else
+	int polygonType = (int)g_TRIANGLE;
+
+	unsigned int number_of_xi1 = surface_points_per_step,
+		number_of_xi2 = number_of_stream_points;
+	array->add_unsigned_integer_attribute(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+		1, 1, &number_of_vertices);
+	array->add_unsigned_integer_attribute(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
+		1, 1, &vertex_start);
+	array->add_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POLYGON,
+		1, 1, &polygonType);
+	array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_XI1,
+		1, 1, &number_of_xi1);
+	array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_XI2,
+		1, 1, &number_of_xi2);
+	array->fill_element_index(vertex_start, number_of_xi1, number_of_xi2,
+		ARRAY_SHAPE_TYPE_UNSPECIFIED);
+	return 1;
+}
+
+}
+
+/*
+Global functions
+----------------
+*/
+
+int create_polyline_streamline_FE_element_vertex_array(
+	struct FE_element *element,FE_value *start_xi,
+	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
+	struct Computed_field *stream_vector_field,int reverse_track,
+	FE_value length, enum cmzn_graphics_streamlines_colour_data_type colour_data_type,
+	struct Computed_field *data_field,
+	struct Graphics_vertex_array *array)
+{
+	if (!(element && start_xi && array))
 	{
-		return_code = 0;
+		return 0;
 	}
-
-	return (return_code);
+	Streamline_settings settings = { coordinate_field, stream_vector_field, reverse_track, length,
+		CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_LINE, /*circleDivisions*/0, /*line_base_size*/nullptr,
+		colour_data_type, data_field };
+	/* track points and normals on streamline, and data if requested */
+	StreamlineTrack track;
+	if (!track.track(element, start_xi, field_cache, settings))
+	{
+		return 0;
+	}
+	return append_polyline_streamline_to_vertex_array(track, array);
 }
 
 int create_surface_streamribbon_FE_element_vertex_array(
@@ -1444,376 +1807,113 @@ int create_surface_streamribbon_FE_element_vertex_array(
 	enum cmzn_graphics_streamlines_colour_data_type colour_data_type, struct Computed_field *data_field,
 	struct Graphics_vertex_array *array)
 {
-	double cosw,magnitude,sinw;
-	GLfloat *stream_data,stream_datum= 0.0;
-	int d,element_dimension,i,number_of_stream_points,number_of_coordinate_components,
-		number_of_stream_vector_components,surface_points_per_step, return_code = 1;
-	Triple cross_thickness,cross_width,normal,point,stream_cross,
-		stream_normal,*stream_normals,stream_point,*stream_points,
-		stream_unit_vector = {1.0, 0.0, 0.0},stream_vector,*stream_vectors;
-
 	USE_PARAMETER(line_scale_factors);
 	USE_PARAMETER(line_orientation_scale_field);
-	if (stream_vector_field)
+	if (!(element && start_xi && line_base_size && array))
 	{
-		if (element&&FE_element_is_top_level(element, NULL)&&
-			(0 < (element_dimension = get_FE_element_dimension(element))) &&
-			((3 == element_dimension) || (2 == element_dimension))
-			&&start_xi&&coordinate_field&&
-			(0 < (number_of_coordinate_components=cmzn_field_get_number_of_components(coordinate_field))) &&
-			(number_of_stream_vector_components=
-				cmzn_field_get_number_of_components(stream_vector_field))
-				&& (((3 == number_of_coordinate_components) &&
-					((3==number_of_stream_vector_components)||
-						(6==number_of_stream_vector_components)||
-						(9==number_of_stream_vector_components)))
-						|| ((2 == number_of_coordinate_components) &&
-							(2==number_of_stream_vector_components)))&&
-							(0.0<length) && array)
-		{
-			const bool hasData =
-				(colour_data_type != CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_FIELD) || (data_field);
-			const FE_value width = line_base_size[0];
-			const FE_value thickness = line_base_size[1];
+		display_message(ERROR_MESSAGE,
+			"create_surface_streamribbon_FE_element_vertex_array.  Invalid argument(s)");
+		return 0;
+	}
+	Streamline_settings settings = { coordinate_field, stream_vector_field, reverse_track, length,
+		line_shape, circleDivisions, line_base_size, colour_data_type, data_field };
+	/* track points and normals on streamline, and data if requested */
+	StreamlineTrack track;
+	if (!track.track(element, start_xi, field_cache, settings))
+	{
+		display_message(ERROR_MESSAGE,
+			"create_surface_streamribbon_FE_element_vertex_array.  "
+			"failed to track streamline");
+		return 0;
+	}
+	/* no error if streamline empty, but returns 0 */
+	return append_surface_streamribbon_to_vertex_array(track, line_shape, circleDivisions,
+		line_base_size, array);
+}
 
-			/* track points and normals on streamline, and data if requested */
-			if (track_streamline_from_FE_element(&element,start_xi,
-				field_cache, coordinate_field,stream_vector_field,reverse_track,length,
-				colour_data_type,data_field,&number_of_stream_points,&stream_points,
-				&stream_vectors,&stream_normals,&stream_data))
+int create_streamlines_FE_element_vertex_array(
+	int number_of_seeds, const struct Streamline_seed *seeds,
+	cmzn_fieldcache_id field_cache, const struct Streamline_settings& settings,
+	int threadCount, struct Graphics_vertex_array *array)
+{
+	if (!((0 <= number_of_seeds) && ((0 == number_of_seeds) || (seeds)) && (field_cache) &&
+		(settings.coordinate_field) && (settings.stream_vector_field) && (0 <= threadCount) &&
+		((CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_LINE == settings.line_shape) || (settings.line_base_size)) &&
+		(array)))
+	{
+		display_message(ERROR_MESSAGE,
+			"create_streamlines_FE_element_vertex_array.  Invalid argument(s)");
+		return 0;
+	}
+	auto appendTrack = [&](const StreamlineTrack& track)
+	{
+		if (CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_LINE == settings.line_shape)
+		{
+			append_polyline_streamline_to_vertex_array(track, array);
+		}
+		else
+		{
+			append_surface_streamribbon_to_vertex_array(track, settings.line_shape,
+				settings.circleDivisions, settings.line_base_size, array);
+		}
+	};
+	// tracking time varies greatly between seeds, so hand out small chunks
+	const int chunkSize = 4;
+	cmzn::ThreadPool& threadPool = field_cache->getRegion()->getThreadPool();
+	threadCount = threadPool.getLoopThreadCount(threadCount, (number_of_seeds + chunkSize - 1)/chunkSize);
+	int return_code = 1;
+	if (threadCount <= 1)
+	{
+		StreamlineTrack track;
+		for (int s = 0; s < number_of_seeds; ++s)
+		{
+			if (track.track(seeds[s].element, seeds[s].xi, field_cache, settings))
 			{
-				if (0<number_of_stream_points)
-				{
-					switch (line_shape)
-					{
-						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_SQUARE_EXTRUSION:
-						{
-							surface_points_per_step = 8;
-						} break;
-						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_CIRCLE_EXTRUSION:
-						{
-							surface_points_per_step = circleDivisions + 1;
-						} break;
-						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_RIBBON:
-						default:
-						{
-							surface_points_per_step = 2;
-						} break;
-					}
-
-					unsigned int vertex_start = array->get_number_of_vertices(
-						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
-					unsigned int number_of_vertices = surface_points_per_step * number_of_stream_points;
-					/* now fill in the points and data from the streamline */
-					GLfloat floatField[3];
-					for (i=0;i<number_of_stream_points;i++)
-					{
-						stream_point[0]=stream_points[i][0];
-						stream_point[1]=stream_points[i][1];
-						stream_point[2]=stream_points[i][2];
-						stream_vector[0]=stream_vectors[i][0];
-						stream_vector[1]=stream_vectors[i][1];
-						stream_vector[2]=stream_vectors[i][2];
-						stream_normal[0]=stream_normals[i][0];
-						stream_normal[1]=stream_normals[i][1];
-						stream_normal[2]=stream_normals[i][2];
-						if (stream_data)
-						{
-							stream_datum=stream_data[i];
-						}
-						if (0.0 < (magnitude = sqrt(stream_vector[0]*stream_vector[0]+
-							stream_vector[1]*stream_vector[1]+
-							stream_vector[2]*stream_vector[2])))
-						{
-							stream_unit_vector[0] = stream_vector[0] / GLfloat(magnitude);
-							stream_unit_vector[1] = stream_vector[1] / GLfloat(magnitude);
-							stream_unit_vector[2] = stream_vector[2] / GLfloat(magnitude);
-						}
-						/* get stream_cross = stream_normal (x) stream_unit_vector */
-						stream_cross[0]=stream_normal[1]*stream_unit_vector[2]-
-							stream_normal[2]*stream_unit_vector[1];
-						stream_cross[1]=stream_normal[2]*stream_unit_vector[0]-
-							stream_normal[0]*stream_unit_vector[2];
-						stream_cross[2]=stream_normal[0]*stream_unit_vector[1]-
-							stream_normal[1]*stream_unit_vector[0];
-						cross_width[0] = stream_cross[0] * 0.5f * width;
-						cross_width[1] = stream_cross[1] * 0.5f * width;
-						cross_width[2] = stream_cross[2] * 0.5f * width;
-						cross_thickness[0] = stream_normal[0] * 0.5f * GLfloat(thickness);
-						cross_thickness[1] = stream_normal[1] * 0.5f * GLfloat(thickness);
-						cross_thickness[2] = stream_normal[2] * 0.5f * GLfloat(thickness);
-						switch (line_shape)
-						{
-							case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_RIBBON:
-							default:
-							{
-								point[0] = stream_point[0] + cross_width[0];
-								point[1] = stream_point[1] + cross_width[1];
-								point[2] = stream_point[2] + cross_width[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = stream_normal[0];
-								normal[1] = stream_normal[1];
-								normal[2] = stream_normal[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && (stream_data))
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-								point[0] = stream_point[0] - cross_width[0];
-								point[1] = stream_point[1] - cross_width[1];
-								point[2] = stream_point[2] - cross_width[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = stream_normal[0];
-								normal[1] = stream_normal[1];
-								normal[2] = stream_normal[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && stream_data)
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-							} break;
-							case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_CIRCLE_EXTRUSION:
-							{
-								for (d = 0 ; d < surface_points_per_step ; d++)
-								{
-									sinw = sin( 2 * PI * (double)d /
-										(double)(surface_points_per_step - 1));
-									cosw = cos( 2 * PI * (double)d /
-										(double)(surface_points_per_step - 1));
-									point[0] = stream_point[0] + GLfloat(sinw) * cross_width[0] + GLfloat(cosw) * cross_thickness[0];
-									point[1] = stream_point[1] + GLfloat(sinw) * cross_width[1] + GLfloat(cosw) * cross_thickness[1];
-									point[2] = stream_point[2] + GLfloat(sinw) * cross_width[2] + GLfloat(cosw) * cross_thickness[2];
-									CAST_TO_OTHER(floatField,point,GLfloat,3);
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-										3, 1, floatField);
-									normal[0] = -GLfloat(sinw) * stream_cross[0] * 0.5f * GLfloat(thickness) -
-										GLfloat(cosw) * stream_normal[0] * 0.5f * width;
-									normal[1] = -GLfloat(sinw) * stream_cross[1] * 0.5f * GLfloat(thickness) -
-										GLfloat(cosw) * stream_normal[1] * 0.5f * GLfloat(thickness);
-									normal[2] = -GLfloat(sinw) * stream_cross[2] * 0.5f * GLfloat(thickness) -
-										GLfloat(cosw) * stream_normal[2] * 0.5f * GLfloat(thickness);
-									magnitude = sqrt(normal[0] * normal[0] + normal[1] * normal[1] + normal[2] * normal[2]);
-									if (0.0<magnitude)
-									{
-										normal[0] /= GLfloat(magnitude);
-										normal[1] /= GLfloat(magnitude);
-										normal[2] /= GLfloat(magnitude);
-									}
-									CAST_TO_OTHER(floatField,normal,GLfloat,3);
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-										3, 1, floatField);
-									if (hasData && stream_data)
-									{
-										array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-											1, 1, &stream_datum);
-									}
-								}
-							} break;
-							case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_SQUARE_EXTRUSION:
-							{
-								point[0] = stream_point[0] + cross_width[0] + cross_thickness[0];
-								point[1] = stream_point[1] + cross_width[1] + cross_thickness[1];
-								point[2] = stream_point[2] + cross_width[2] + cross_thickness[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = stream_normal[0];
-								normal[1] = stream_normal[1];
-								normal[2] = stream_normal[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && stream_data)
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-								point[0] = stream_point[0] - cross_width[0] + cross_thickness[0];
-								point[1] = stream_point[1] - cross_width[1] + cross_thickness[1];
-								point[2] = stream_point[2] - cross_width[2] + cross_thickness[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = stream_normal[0];
-								normal[1] = stream_normal[1];
-								normal[2] = stream_normal[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && stream_data)
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-
-								point[0] = stream_point[0] - cross_width[0] + cross_thickness[0];
-								point[1] = stream_point[1] - cross_width[1] + cross_thickness[1];
-								point[2] = stream_point[2] - cross_width[2] + cross_thickness[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = -stream_cross[0];
-								normal[1] = -stream_cross[1];
-								normal[2] = -stream_cross[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && stream_data)
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-								point[0] = stream_point[0] - cross_width[0] - cross_thickness[0];
-								point[1] = stream_point[1] - cross_width[1] - cross_thickness[1];
-								point[2] = stream_point[2] - cross_width[2] - cross_thickness[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = -stream_cross[0];
-								normal[1] = -stream_cross[1];
-								normal[2] = -stream_cross[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && stream_data)
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-
-								point[0] = stream_point[0] - cross_width[0] - cross_thickness[0];
-								point[1] = stream_point[1] - cross_width[1] - cross_thickness[1];
-								point[2] = stream_point[2] - cross_width[2] - cross_thickness[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = -stream_normal[0];
-								normal[1] = -stream_normal[1];
-								normal[2] = -stream_normal[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && stream_data)
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-								point[0] = stream_point[0] + cross_width[0] - cross_thickness[0];
-								point[1] = stream_point[1] + cross_width[1] - cross_thickness[1];
-								point[2] = stream_point[2] + cross_width[2] - cross_thickness[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = -stream_normal[0];
-								normal[1] = -stream_normal[1];
-								normal[2] = -stream_normal[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && stream_data)
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-
-								point[0] = stream_point[0] + cross_width[0] - cross_thickness[0];
-								point[1] = stream_point[1] + cross_width[1] - cross_thickness[1];
-								point[2] = stream_point[2] + cross_width[2] - cross_thickness[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = stream_cross[0];
-								normal[1] = stream_cross[1];
-								normal[2] = stream_cross[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && stream_data)
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-								point[0] = stream_point[0] + cross_width[0] + cross_thickness[0];
-								point[1] = stream_point[1] + cross_width[1] + cross_thickness[1];
-								point[2] = stream_point[2] + cross_width[2] + cross_thickness[2];
-								CAST_TO_OTHER(floatField,point,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
-									3, 1, floatField);
-								normal[0] = stream_cross[0];
-								normal[1] = stream_cross[1];
-								normal[2] = stream_cross[2];
-								CAST_TO_OTHER(floatField,normal,GLfloat,3);
-								array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
-									3, 1, floatField);
-								if (hasData && stream_data)
-								{
-									array->add_float_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
-										1, 1, &stream_datum);
-								}
-							} break;
-						}
-					}
-					int polygonType = (int)g_TRIANGLE;
-
-					unsigned int number_of_xi1 = surface_points_per_step,
-						number_of_xi2 = number_of_stream_points;
-					array->add_unsigned_integer_attribute(
-						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
-						1, 1, &number_of_vertices);
-					array->add_unsigned_integer_attribute(
-						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
-						1, 1, &vertex_start);
-					array->add_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POLYGON,
-						1, 1, &polygonType);
-					array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_XI1,
-						1, 1, &number_of_xi1);
-					array->add_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_XI2,
-						1, 1, &number_of_xi2);
-					array->fill_element_index(vertex_start, number_of_xi1, number_of_xi2,
-						ARRAY_SHAPE_TYPE_UNSPECIFIED);
-					/* no longer need original streamline */
-					DEALLOCATE(stream_points);
-					DEALLOCATE(stream_vectors);
-					DEALLOCATE(stream_normals);
-					DEALLOCATE(stream_data);
-				}
-				else
-				{
-					/* no error: streamline empty */
-					return_code = 0;
-				}
+				appendTrack(track);
 			}
 			else
 			{
-				display_message(ERROR_MESSAGE,
-					"create_surface_streamribbon_FE_element_vertex_array.  "
-					"failed to track streamline");
 				return_code = 0;
 			}
 		}
-		else
-		{
-			display_message(ERROR_MESSAGE,
-				"create_surface_streamribbon_FE_element_vertex_array.  Invalid argument(s)");
-			return_code = 0;
-		}
+		return return_code;
 	}
-	else
+	// first thread uses field_cache; others get their own at the same time
+	FieldcacheThreadSet fieldcaches(field_cache, threadCount);
+	fieldcaches.createValueCaches(settings.coordinate_field);
+	fieldcaches.createValueCaches(settings.stream_vector_field);
+	fieldcaches.createValueCaches(settings.data_field);
+	const int batchSize = chunkSize*64*threadCount;
+	std::vector<StreamlineTrack> tracks((number_of_seeds < batchSize) ? number_of_seeds : batchSize);
+	std::vector<int> trackResults(tracks.size());
+	for (int batchStart = 0; batchStart < number_of_seeds; batchStart += batchSize)
 	{
-		return_code = 0;
+		const int batchSeedsCount = ((number_of_seeds - batchStart) < batchSize) ? number_of_seeds - batchStart : batchSize;
+		threadPool.parallelFor(0, batchSeedsCount, chunkSize, threadCount,
+			[&](int chunkStart, int chunkEnd, int threadIndex)
+			{
+				cmzn_fieldcache *fieldcache = fieldcaches.getFieldcache(threadIndex);
+				for (int i = chunkStart; i < chunkEnd; ++i)
+				{
+					const Streamline_seed& seed = seeds[batchStart + i];
+					trackResults[i] = tracks[i].track(seed.element, seed.xi, fieldcache, settings);
+				}
+			});
+		// merge in seed order
+		for (int i = 0; i < batchSeedsCount; ++i)
+		{
+			if (trackResults[i])
+			{
+				appendTrack(tracks[i]);
+			}
+			else
+			{
+				return_code = 0;
+			}
+			tracks[i].clear();
+		}
 	}
-
-	return (return_code);
+	return return_code;
 }
 
 int add_flow_particle(struct Streampoint **list,FE_value *xi,
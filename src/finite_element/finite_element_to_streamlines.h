@@ -96,6 +96,54 @@ int create_surface_streamribbon_FE_element_vertex_array(
 	enum cmzn_graphics_streamlines_colour_data_type colour_data_type, struct Computed_field *data_field,
 	struct Graphics_vertex_array *array);
 
+/**
+ * Settings for tracking streamlines and converting them to graphics, common to
+ * all seed points.
+ * @see create_streamlines_FE_element_vertex_array
+ */
+struct Streamline_settings
+{
+	struct Computed_field *coordinate_field;
+	struct Computed_field *stream_vector_field;
+	int reverse_track;
+	FE_value length;
+	/* LINE gives polylines, otherwise surface ribbon or extrusion */
+	enum cmzn_graphicslineattributes_shape_type line_shape;
+	int circleDivisions;
+	FE_value *line_base_size;
+	enum cmzn_graphics_streamlines_colour_data_type colour_data_type;
+	struct Computed_field *data_field;
+};
+
+/**
+ * Element and xi location to start tracking a streamline from.
+ */
+struct Streamline_seed
+{
+	struct FE_element *element; // not accessed
+	FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+};
+
+/**
+ * Tracks streamlines from all seeds and appends them to the array as polylines
+ * or surfaces according to settings line_shape, in seed order.
+ * With more than one thread, streamlines are tracked concurrently by worker
+ * threads each with its own field cache, then appended to the array serially
+ * so the output is identical to serial tracking. Fields must not be modified
+ * while this is in progress, and seed elements must remain valid.
+ * Seeds at which the stream vector is zero give no streamline and are not an
+ * error.
+ * @param field_cache  cmzn_fieldcache for evaluating fields with. Time is
+ * expected to have been set in the field_cache if needed.
+ * @param threadCount  Maximum number of threads to track with from the
+ * region's context thread pool: 1 for serial, or 0 to use all pool threads.
+ * @return  1 on success, 0 if any streamline failed to track.
+ */
+int create_streamlines_FE_element_vertex_array(
+	int number_of_seeds, const struct Streamline_seed *seeds,
+	cmzn_fieldcache_id field_cache, const struct Streamline_settings& settings,
+	int threadCount, struct Graphics_vertex_array *array);
+
 int add_flow_particle(struct Streampoint **list,FE_value *xi,
 	struct FE_element *element,Triple **pointlist,int index,
 	cmzn_fieldcache_id field_cache, struct Computed_field *coordinate_field,
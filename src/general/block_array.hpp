@@ -14,6 +14,7 @@
 
 #include "general/debug.h"
 #include <cstring>
+#include <vector>
 
 // DsMapArray assumes following is > 128:
 #define CMZN_BLOCK_ARRAY_DEFAULT_BLOCK_SIZE_BYTES 1024
@@ -163,6 +164,16 @@ public:
 		return 0; // fall back to first
 	}
 
+	/** Free all blocks lying wholly at or after indexLimit. */
+	void destroyBlocksFrom(IndexType indexLimit)
+	{
+		for (IndexType blockIndex = (indexLimit + this->blockLength - 1)/this->blockLength;
+			blockIndex < this->blockCount; ++blockIndex)
+		{
+			this->destroyBlock(blockIndex);
+		}
+	}
+
 	/** Swaps all data with other block_array. Cannot fail. */
 	void swap(block_array& other)
 	{
@@ -344,7 +355,76 @@ public:
 		}
 		return true;
 	}
-	
+
+	/**
+	 * Move values to new indexes when compacting an index range with holes.
+	 * Values at removed indexes are discarded, and blocks wholly beyond the
+	 * last new index are freed. Works in place as new indexes never exceed
+	 * old indexes.
+	 * @param oldToNewIndexes  New index for each old index, increasing and
+	 * no greater than the old index, or negative if removed.
+	 * @return  Boolean true on success, false if failed to allocate a block.
+	 */
+	bool compactIndexes(const std::vector<IndexType>& oldToNewIndexes)
+	{
+		const IndexType oldIndexCount = static_cast<IndexType>(oldToNewIndexes.size());
+		const IndexType allocatedIndexLimit = this->blockCount*this->blockLength;
+		const IndexType indexLimit = (oldIndexCount < allocatedIndexLimit) ? oldIndexCount : allocatedIndexLimit;
+		IndexType newIndexCount = 0;
+		for (IndexType oldIndex = 0; oldIndex < oldIndexCount; ++oldIndex)
+		{
+			const IndexType newIndex = oldToNewIndexes[oldIndex];
+			if (newIndex >= 0)
+				newIndexCount = newIndex + 1;
+			if ((newIndex == oldIndex) || (oldIndex >= indexLimit))
+				continue;
+			EntryType *oldAddress = this->getAddress(oldIndex);
+			if (!oldAddress)
+				continue;
+			// position at newIndex has already been moved from or cleared
+			if ((newIndex >= 0) && (*oldAddress != this->allocInitValue))
+			{
+				EntryType *newAddress = this->getOrCreateAddress(newIndex);
+				if (!newAddress)
+					return false;
+				*newAddress = *oldAddress;
+			}
+			*oldAddress = this->allocInitValue;
+		}
+		this->destroyBlocksFrom(newIndexCount);
+		return true;
+	}
+
+	/**
+	 * Move values to new indexes in any order, building new blocks then
+	 * swapping them in. Values at removed indexes are discarded.
+	 * @param oldToNewIndexes  New index for each old index, unique if not
+	 * negative, or negative if removed.
+	 * @return  Boolean true on success, false if failed to allocate a block,
+	 * in which case values are unchanged.
+	 */
+	bool permuteIndexes(const std::vector<IndexType>& oldToNewIndexes)
+	{
+		block_array<IndexType, EntryType> newArray(this->blockLength, this->allocInitValue);
+		const IndexType oldIndexCount = static_cast<IndexType>(oldToNewIndexes.size());
+		for (IndexType oldIndex = 0; oldIndex < oldIndexCount; ++oldIndex)
+		{
+			const IndexType newIndex = oldToNewIndexes[oldIndex];
+			if (newIndex < 0)
+				continue;
+			const EntryType *oldAddress = this->getAddress(oldIndex);
+			if ((oldAddress) && (*oldAddress != this->allocInitValue))
+			{
+				EntryType *newAddress = newArray.getOrCreateAddress(newIndex);
+				if (!newAddress)
+					return false;
+				*newAddress = *oldAddress;
+			}
+		}
+		this->swap(newArray);
+		return true;
+	}
+
 };
 
 /** Variant of block_array for storing pointers to allocated array values.
@@ -375,6 +455,41 @@ public:
 		}
 		this->block_array<IndexType, EntryType>::clear();
 	}
+
+	/** Variant of block_array::compactIndexes also freeing arrays held at
+	 * removed indexes. */
+	bool compactIndexes(const std::vector<IndexType>& oldToNewIndexes)
+	{
+		this->destroyRemovedArrays(oldToNewIndexes);
+		return this->block_array<IndexType, EntryType>::compactIndexes(oldToNewIndexes);
+	}
+
+	/** Variant of block_array::permuteIndexes also freeing arrays held at
+	 * removed indexes. */
+	bool permuteIndexes(const std::vector<IndexType>& oldToNewIndexes)
+	{
+		this->destroyRemovedArrays(oldToNewIndexes);
+		return this->block_array<IndexType, EntryType>::permuteIndexes(oldToNewIndexes);
+	}
+
+private:
+
+	void destroyRemovedArrays(const std::vector<IndexType>& oldToNewIndexes)
+	{
+		const IndexType oldIndexCount = static_cast<IndexType>(oldToNewIndexes.size());
+		for (IndexType oldIndex = 0; oldIndex < oldIndexCount; ++oldIndex)
+		{
+			if (oldToNewIndexes[oldIndex] < 0)
+			{
+				EntryType *address = this->getAddress(oldIndex);
+				if ((address) && (*address))
+				{
+					delete[] *address;
+					*address = 0;
+				}
+			}
+		}
+	}
 };
 
 /** stores boolean values as individual bits, with no value equivalent to false */
@@ -398,6 +513,7 @@ public:
 		block_array<IndexType, unsigned int>::swap(other);
 	}
 
+	using block_array<IndexType, unsigned int>::destroyBlocksFrom;
 	using block_array<IndexType, unsigned int>::getBlockCount;
 	using block_array<IndexType, unsigned int>::getBlockLength;
 	using block_array<IndexType, unsigned int>::getValue;
@@ -530,6 +646,70 @@ public:
 		return true;
 	}
 
+	/**
+	 * Move true values to new indexes when compacting an index range with
+	 * holes, as for block_array::compactIndexes.
+	 * @param oldToNewIndexes  New index for each old index, increasing and
+	 * no greater than the old index, or negative if removed.
+	 * @return  Number of true values discarded at removed indexes.
+	 */
+	IndexType compactIndexes(const std::vector<IndexType>& oldToNewIndexes)
+	{
+		const IndexType oldIndexCount = static_cast<IndexType>(oldToNewIndexes.size());
+		IndexType newIndexCount = 0;
+		for (IndexType oldIndex = oldIndexCount - 1; 0 <= oldIndex; --oldIndex)
+		{
+			if (oldToNewIndexes[oldIndex] >= 0)
+			{
+				newIndexCount = oldToNewIndexes[oldIndex] + 1;
+				break;
+			}
+		}
+		IndexType discardCount = 0;
+		IndexType index = 0;
+		bool oldValue;
+		while (this->advanceIndexWhileFalse(index, oldIndexCount))
+		{
+			const IndexType newIndex = oldToNewIndexes[index];
+			if (newIndex != index)
+			{
+				this->setBool(index, false, oldValue);
+				if (newIndex >= 0)
+					this->setBool(newIndex, true, oldValue);
+				else
+					++discardCount;
+			}
+			++index;
+		}
+		this->destroyBlocksFrom((newIndexCount + 31) >> 5);
+		return discardCount;
+	}
+
+	/**
+	 * Move true values to new indexes in any order, as for
+	 * block_array::permuteIndexes.
+	 * @param oldToNewIndexes  New index for each old index, unique if not
+	 * negative, or negative if removed.
+	 * @return  True on success, false if failed to allocate, in which case
+	 * values are unchanged.
+	 */
+	bool permuteIndexes(const std::vector<IndexType>& oldToNewIndexes)
+	{
+		bool_array<IndexType> newArray(this->getBlockLength());
+		const IndexType oldIndexCount = static_cast<IndexType>(oldToNewIndexes.size());
+		IndexType index = 0;
+		bool oldValue;
+		while (this->advanceIndexWhileFalse(index, oldIndexCount))
+		{
+			const IndexType newIndex = oldToNewIndexes[index];
+			if ((newIndex >= 0) && (!newArray.setBool(newIndex, true, oldValue)))
+				return false;
+			++index;
+		}
+		this->swap(newArray);
+		return true;
+	}
+
 	/**
 	 * @return  true if all bits in bool array are either all on or all off over
 	 * all consecutive subarrays of the given size, otherwise false. Used to
@@ -552,4 +732,17 @@ public:
 
 };
 
+/**
+ * Move values of a block array or map array to new indexes after its labels
+ * are compacted or permuted, calling compactIndexes or permuteIndexes.
+ * @param permute  True if indexes have been permuted, false if compacted.
+ * @return  True on success, false if failed to allocate.
+ */
+template <class ArrayType, typename IndexType>
+inline bool block_array_remap_indexes(ArrayType& array,
+	const std::vector<IndexType>& oldToNewIndexes, bool permute)
+{
+	return (permute) ? array.permuteIndexes(oldToNewIndexes) : array.compactIndexes(oldToNewIndexes);
+}
+
 #endif /* !defined (BLOCK_ARRAY_HPP) */
@@ -0,0 +1,301 @@
+/**
+ * FILE : general/index_ordering.cpp
+ *
+ * Orderings of indexed points or graph vertices for locality of storage.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "general/index_ordering.hpp"
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+
+namespace cmzn
+{
+
+namespace {
+
+typedef uint64_t CurveKey;
+
+/**
+ * Convert integer coordinates to the transposed Hilbert index in place,
+ * after J. Skilling, "Programming the Hilbert curve", AIP Conf. Proc. 707,
+ * 381 (2004).
+ */
+void axesToHilbertTranspose(CurveKey *x, int bits, int dimension)
+{
+	const CurveKey m = static_cast<CurveKey>(1) << (bits - 1);
+	// inverse undo excess work
+	for (CurveKey q = m; q > 1; q >>= 1)
+	{
+		const CurveKey p = q - 1;
+		for (int i = 0; i < dimension; ++i)
+		{
+			if (x[i] & q)
+			{
+				x[0] ^= p;
+			}
+			else
+			{
+				const CurveKey t = (x[0] ^ x[i]) & p;
+				x[0] ^= t;
+				x[i] ^= t;
+			}
+		}
+	}
+	// gray encode
+	for (int i = 1; i < dimension; ++i)
+		x[i] ^= x[i - 1];
+	CurveKey t = 0;
+	for (CurveKey q = m; q > 1; q >>= 1)
+		if (x[dimension - 1] & q)
+			t ^= q - 1;
+	for (int i = 0; i < dimension; ++i)
+		x[i] ^= t;
+}
+
+/** Interleave bits of integer coordinates, most significant first. */
+CurveKey interleaveBits(const CurveKey *x, int bits, int dimension)
+{
+	CurveKey key = 0;
+	for (int b = bits - 1; b >= 0; --b)
+		for (int i = 0; i < dimension; ++i)
+			key = (key << 1) | ((x[i] >> b) & 1);
+	return key;
+}
+
+std::vector<int> getSpaceFillingCurveOrder(int dimension,
+	const std::vector<double>& coordinates, bool hilbert)
+{
+	std::vector<int> oldToNew;
+	if ((dimension < 1) || (dimension > 3) || (coordinates.size() % dimension))
+		return oldToNew;
+	const int pointCount = static_cast<int>(coordinates.size()/dimension);
+	double minimums[3], maximums[3];
+	for (int i = 0; i < dimension; ++i)
+	{
+		minimums[i] = HUGE_VAL;
+		maximums[i] = -HUGE_VAL;
+	}
+	std::vector<bool> finite(pointCount, true);
+	for (int p = 0; p < pointCount; ++p)
+	{
+		const double *x = coordinates.data() + p*dimension;
+		for (int i = 0; i < dimension; ++i)
+			if (!std::isfinite(x[i]))
+				finite[p] = false;
+		if (finite[p])
+		{
+			for (int i = 0; i < dimension; ++i)
+			{
+				if (x[i] < minimums[i])
+					minimums[i] = x[i];
+				if (x[i] > maximums[i])
+					maximums[i] = x[i];
+			}
+		}
+	}
+	// bits per coordinate so interleaved key fits in 63 bits
+	const int bits = (dimension == 3) ? 21 : 31;
+	const double maximumCell = static_cast<double>((static_cast<CurveKey>(1) << bits) - 1);
+	double scales[3];
+	for (int i = 0; i < dimension; ++i)
+	{
+		const double range = maximums[i] - minimums[i];
+		scales[i] = (range > 0.0) ? maximumCell/range : 0.0;
+	}
+	// sort key, original index; non-finite points have key beyond all curve keys
+	std::vector<std::pair<CurveKey, int> > keys(pointCount);
+	CurveKey cells[3];
+	for (int p = 0; p < pointCount; ++p)
+	{
+		CurveKey key = ~static_cast<CurveKey>(0);
+		if (finite[p])
+		{
+			const double *x = coordinates.data() + p*dimension;
+			for (int i = 0; i < dimension; ++i)
+			{
+				double cell = (x[i] - minimums[i])*scales[i];
+				if (cell > maximumCell)
+					cell = maximumCell;
+				cells[i] = static_cast<CurveKey>(cell);
+			}
+			if (hilbert)
+				axesToHilbertTranspose(cells, bits, dimension);
+			key = interleaveBits(cells, bits, dimension);
+		}
+		keys[p] = std::make_pair(key, p);
+	}
+	std::sort(keys.begin(), keys.end());
+	oldToNew.resize(pointCount);
+	for (int n = 0; n < pointCount; ++n)
+		oldToNew[keys[n].second] = n;
+	return oldToNew;
+}
+
+/**
+ * Breadth first search from start over unvisited vertices, recording levels.
+ * @return  Vertex of minimum degree in the last level.
+ */
+int getLastLevelMinimumDegreeVertex(int start, const std::vector<int>& offsets,
+	const std::vector<int>& indexes, const std::vector<bool>& visited,
+	std::vector<int>& levels, std::vector<int>& component, int& lastLevel)
+{
+	component.clear();
+	component.push_back(start);
+	levels[start] = 0;
+	for (size_t c = 0; c < component.size(); ++c)
+	{
+		const int vertex = component[c];
+		for (int a = offsets[vertex]; a < offsets[vertex + 1]; ++a)
+		{
+			const int neighbour = indexes[a];
+			if ((!visited[neighbour]) && (levels[neighbour] < 0))
+			{
+				levels[neighbour] = levels[vertex] + 1;
+				component.push_back(neighbour);
+			}
+		}
+	}
+	lastLevel = levels[component.back()];
+	int result = component.back();
+	for (auto iter = component.rbegin(); (iter != component.rend()) && (levels[*iter] == lastLevel); ++iter)
+	{
+		if ((offsets[*iter + 1] - offsets[*iter]) < (offsets[result + 1] - offsets[result]))
+			result = *iter;
+	}
+	for (const int vertex : component)
+		levels[vertex] = -1;
+	return result;
+}
+
+}
+
+std::vector<int> getHilbertOrder(int dimension, const std::vector<double>& coordinates)
+{
+	return getSpaceFillingCurveOrder(dimension, coordinates, /*hilbert*/true);
+}
+
+std::vector<int> getMortonOrder(int dimension, const std::vector<double>& coordinates)
+{
+	return getSpaceFillingCurveOrder(dimension, coordinates, /*hilbert*/false);
+}
+
+void getSharedConnectorAdjacency(int vertexCount,
+	const std::vector<std::pair<int, int> >& incidences,
+	std::vector<int>& adjacencyOffsets, std::vector<int>& adjacencyIndexes)
+{
+	// group vertices by connector
+	std::vector<std::pair<int, int> > connectorVertices;
+	connectorVertices.reserve(incidences.size());
+	for (const auto& incidence : incidences)
+	{
+		if ((0 <= incidence.first) && (incidence.first < vertexCount))
+			connectorVertices.push_back(std::make_pair(incidence.second, incidence.first));
+	}
+	std::sort(connectorVertices.begin(), connectorVertices.end());
+	std::vector<std::pair<int, int> > edges;
+	size_t groupBegin = 0;
+	while (groupBegin < connectorVertices.size())
+	{
+		size_t groupEnd = groupBegin + 1;
+		while ((groupEnd < connectorVertices.size()) && (connectorVertices[groupEnd].first == connectorVertices[groupBegin].first))
+			++groupEnd;
+		for (size_t i = groupBegin; i < groupEnd; ++i)
+			for (size_t j = groupBegin; j < groupEnd; ++j)
+				if (connectorVertices[i].second != connectorVertices[j].second)
+					edges.push_back(std::make_pair(connectorVertices[i].second, connectorVertices[j].second));
+		groupBegin = groupEnd;
+	}
+	std::sort(edges.begin(), edges.end());
+	edges.erase(std::unique(edges.begin(), edges.end()), edges.end());
+	adjacencyOffsets.assign(vertexCount + 1, 0);
+	adjacencyIndexes.resize(edges.size());
+	for (size_t e = 0; e < edges.size(); ++e)
+	{
+		++adjacencyOffsets[edges[e].first + 1];
+		adjacencyIndexes[e] = edges[e].second;
+	}
+	for (int v = 0; v < vertexCount; ++v)
+		adjacencyOffsets[v + 1] += adjacencyOffsets[v];
+}
+
+std::vector<int> getReverseCuthillMcKeeOrder(const std::vector<int>& adjacencyOffsets,
+	const std::vector<int>& adjacencyIndexes)
+{
+	std::vector<int> oldToNew;
+	if (adjacencyOffsets.empty())
+		return oldToNew;
+	const int vertexCount = static_cast<int>(adjacencyOffsets.size()) - 1;
+	if ((adjacencyOffsets[0] != 0) || (adjacencyOffsets[vertexCount] != static_cast<int>(adjacencyIndexes.size())))
+		return oldToNew;
+	for (const int index : adjacencyIndexes)
+		if ((index < 0) || (index >= vertexCount))
+			return oldToNew;
+	auto degree = [&adjacencyOffsets](int vertex)
+	{
+		return adjacencyOffsets[vertex + 1] - adjacencyOffsets[vertex];
+	};
+	// try start vertices in increasing degree so isolated vertices are first
+	std::vector<int> startCandidates(vertexCount);
+	for (int v = 0; v < vertexCount; ++v)
+		startCandidates[v] = v;
+	std::stable_sort(startCandidates.begin(), startCandidates.end(),
+		[&degree](int v1, int v2) { return degree(v1) < degree(v2); });
+	std::vector<bool> visited(vertexCount, false);
+	std::vector<int> levels(vertexCount, -1);
+	std::vector<int> component;
+	std::vector<int> order;
+	order.reserve(vertexCount);
+	std::vector<int> neighbours;
+	for (const int candidate : startCandidates)
+	{
+		if (visited[candidate])
+			continue;
+		// find pseudo-peripheral start vertex by repeated search from last level
+		int start = candidate;
+		int lastLevel;
+		int next = getLastLevelMinimumDegreeVertex(start, adjacencyOffsets, adjacencyIndexes, visited, levels, component, lastLevel);
+		for (int iteration = 0; iteration < 8; ++iteration)
+		{
+			int nextLastLevel;
+			const int nextNext = getLastLevelMinimumDegreeVertex(next, adjacencyOffsets, adjacencyIndexes, visited, levels, component, nextLastLevel);
+			if (nextLastLevel <= lastLevel)
+				break;
+			start = next;
+			lastLevel = nextLastLevel;
+			next = nextNext;
+		}
+		// Cuthill-McKee: breadth first adding neighbours in increasing degree
+		size_t head = order.size();
+		order.push_back(start);
+		visited[start] = true;
+		while (head < order.size())
+		{
+			const int vertex = order[head++];
+			neighbours.clear();
+			for (int a = adjacencyOffsets[vertex]; a < adjacencyOffsets[vertex + 1]; ++a)
+			{
+				const int neighbour = adjacencyIndexes[a];
+				if (!visited[neighbour])
+				{
+					visited[neighbour] = true;
+					neighbours.push_back(neighbour);
+				}
+			}
+			std::stable_sort(neighbours.begin(), neighbours.end(),
+				[&degree](int v1, int v2) { return degree(v1) < degree(v2); });
+			order.insert(order.end(), neighbours.begin(), neighbours.end());
+		}
+	}
+	oldToNew.resize(vertexCount);
+	for (int n = 0; n < vertexCount; ++n)
+		oldToNew[order[n]] = vertexCount - 1 - n;
+	return oldToNew;
+}
+
+}
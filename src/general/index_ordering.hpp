@@ -0,0 +1,67 @@
+/**
+ * FILE : general/index_ordering.hpp
+ *
+ * Orderings of indexed points or graph vertices for locality of storage.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (CMZN_GENERAL_INDEX_ORDERING_HPP)
+#define CMZN_GENERAL_INDEX_ORDERING_HPP
+
+#include <utility>
+#include <vector>
+
+namespace cmzn
+{
+
+/**
+ * Get the order of points along a Hilbert space-filling curve through the
+ * bounding box of the points, so consecutive points are close in space.
+ * Points with non-finite coordinates are ordered last in their original order.
+ * @param dimension  Number of coordinates per point, from 1 to 3.
+ * @param coordinates  Point coordinates, dimension values per point.
+ * @return  New index for each point index, or empty vector if invalid.
+ */
+std::vector<int> getHilbertOrder(int dimension, const std::vector<double>& coordinates);
+
+/**
+ * Get the order of points along a Morton (Z-order) space-filling curve
+ * through the bounding box of the points. Cheaper than Hilbert order but with
+ * jumps between quadrants. Other details as for getHilbertOrder.
+ */
+std::vector<int> getMortonOrder(int dimension, const std::vector<double>& coordinates);
+
+/**
+ * Build the symmetric adjacency of vertices sharing any connector, e.g.
+ * elements sharing nodes, in the compressed row form used by
+ * getReverseCuthillMcKeeOrder.
+ * @param vertexCount  Number of vertices.
+ * @param incidences  Pairs of vertex index, connector index.
+ * @param adjacencyOffsets  On return, offsets for each vertex plus end.
+ * @param adjacencyIndexes  On return, sorted neighbours of each vertex.
+ */
+void getSharedConnectorAdjacency(int vertexCount,
+	const std::vector<std::pair<int, int> >& incidences,
+	std::vector<int>& adjacencyOffsets, std::vector<int>& adjacencyIndexes);
+
+/**
+ * Get the reverse Cuthill-McKee order of vertices of an undirected graph,
+ * which reduces the bandwidth of its adjacency matrix so neighbours have
+ * nearby indexes. Each connected component is numbered from a
+ * pseudo-peripheral vertex of minimum degree.
+ * @param adjacencyOffsets  Compressed row offsets into adjacencyIndexes for
+ * each vertex plus a final offset, so vertex count is size - 1.
+ * @param adjacencyIndexes  Indexes of neighbouring vertices for each vertex.
+ * Must be symmetric.
+ * @return  New index for each vertex index, or empty vector if invalid.
+ */
+std::vector<int> getReverseCuthillMcKeeOrder(const std::vector<int>& adjacencyOffsets,
+	const std::vector<int>& adjacencyIndexes);
+
+}
+
+#endif /* !defined (CMZN_GENERAL_INDEX_ORDERING_HPP) */
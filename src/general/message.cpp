@@ -17,6 +17,7 @@ Declaration of functions for displaying messages.
 #include <stdio.h>
 #include <stdarg.h>
 #include <string.h>
+#include <mutex>
 #if defined (WIN32_USER_INTERFACE) || defined (_MSC_VER)
 //#define WINDOWS_LEAN_AND_MEAN
 #define NOMINMAX
@@ -35,7 +36,13 @@ static Display_message_function
 static void	*display_message_data = (void *)NULL;
 
 #define MESSAGE_STRING_SIZE 1000
-static char message_string[MESSAGE_STRING_SIZE];
+/* per-thread so messages can be formatted on worker threads */
+static thread_local char message_string[MESSAGE_STRING_SIZE];
+/* serialises output of messages from multiple threads; recursive as message
+	functions may display further messages */
+static std::recursive_mutex display_message_mutex;
+/* if set, messages on this thread are held in the buffer instead of output */
+static thread_local Message_buffer *thread_message_buffer = nullptr;
 
 static bool display_message_on_console = false;
 
@@ -71,6 +78,12 @@ int display_message_string(enum Message_type message_type,
 	if (!the_string)
 		return 0;
 
+	if (thread_message_buffer)
+	{
+		thread_message_buffer->add(message_type, the_string);
+		return 1;
+	}
+	std::lock_guard<std::recursive_mutex> lock(display_message_mutex);
 	if (display_any_message_function)
 	{
 		return_code=(*display_any_message_function)(the_string,	message_type,
@@ -193,7 +206,11 @@ form of arguments is used.
 		char error_string[100];
 		sprintf(error_string,"Overflow of message_string.  "
 			"Following is truncated to %d characters:",MESSAGE_STRING_SIZE-1);
-		if (display_any_message_function)
+		if (thread_message_buffer)
+		{
+			thread_message_buffer->add(ERROR_MESSAGE, error_string);
+		}
+		else if (display_any_message_function)
 		{
 			return_code=(*display_any_message_function)(error_string, ERROR_MESSAGE,
 				display_message_data);
@@ -212,6 +229,22 @@ form of arguments is used.
 	return (return_code);
 } /* display_message */
 
+void Message_buffer::display()
+{
+	for (auto& message : this->messages)
+	{
+		display_message_string(message.first, message.second.c_str());
+	}
+	this->messages.clear();
+}
+
+Message_buffer *set_thread_message_buffer(Message_buffer *buffer)
+{
+	Message_buffer *previousBuffer = thread_message_buffer;
+	thread_message_buffer = buffer;
+	return previousBuffer;
+}
+
 int write_message_to_file(enum Message_type message_type,const char *format, ... )
 /*******************************************************************************
 LAST MODIFIED : 15 September 2008
@@ -15,6 +15,11 @@ Global types and function prototypes for displaying messages.
 #define MESSAGE_H
 
 #include "cmlibs/zinc/zincsharedobject.h"
+#if defined (__cplusplus)
+#include <string>
+#include <utility>
+#include <vector>
+#endif /* defined (__cplusplus) */
 
 /*
 Global types
@@ -78,6 +83,36 @@ A function for displaying a message of the specified <message_type>.  The printf
 form of arguments is used.
 ==============================================================================*/
 
+#if defined (__cplusplus)
+/**
+ * Messages held back from display, e.g. those raised on thread pool worker
+ * threads, so they can be displayed later on the thread running the loop.
+ * Message callbacks, including logger notifier callbacks to clients, are then
+ * only called from that thread.
+ */
+class Message_buffer
+{
+	std::vector<std::pair<enum Message_type, std::string> > messages;
+
+public:
+	void add(enum Message_type message_type, const char *the_string)
+	{
+		this->messages.push_back(std::make_pair(message_type, std::string(the_string)));
+	}
+
+	/** Display buffered messages in the order added, then clear them. */
+	void display();
+};
+
+/***************************************************************************//**
+ * Set buffer for holding messages displayed on the current thread, or clear
+ * it to display them immediately.
+ * @param buffer  Buffer to add messages to, or nullptr for none.
+ * @return  Previous buffer for current thread, or nullptr if none.
+ */
+Message_buffer *set_thread_message_buffer(Message_buffer *buffer);
+#endif /* defined (__cplusplus) */
+
 int write_message_to_file(enum Message_type message_type,const char *format, ... );
 /*******************************************************************************
 LAST MODIFIED : 15 September 2008
@@ -0,0 +1,92 @@
+/**
+ * FILE : general/performance_counters.cpp
+ *
+ * Opt-in counters and timers on hot paths for performance analysis.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "general/performance_counters.hpp"
+#include <map>
+#include <memory>
+#include <mutex>
+#include <utility>
+
+namespace cmzn
+{
+
+namespace {
+
+typedef std::map<std::pair<std::string, std::string>, std::unique_ptr<PerformanceCounter> > PerformanceCounterMap;
+
+// function-local statics so counters can be used during static initialisation
+std::mutex& getPerformanceCounterMutex()
+{
+	static std::mutex performanceCounterMutex;
+	return performanceCounterMutex;
+}
+
+PerformanceCounterMap& getPerformanceCounterMap()
+{
+	static PerformanceCounterMap performanceCounterMap;
+	return performanceCounterMap;
+}
+
+}
+
+std::atomic<bool> PerformanceCounters::enabled(false);
+
+void PerformanceCounters::reset()
+{
+	std::lock_guard<std::mutex> lock(getPerformanceCounterMutex());
+	for (auto& iter : getPerformanceCounterMap())
+		iter.second->reset();
+}
+
+PerformanceCounter *PerformanceCounters::getCounter(const char *category, const char *name)
+{
+	if ((!category) || (!name))
+		return nullptr;
+	std::lock_guard<std::mutex> lock(getPerformanceCounterMutex());
+	std::unique_ptr<PerformanceCounter>& counter =
+		getPerformanceCounterMap()[std::make_pair(std::string(category), std::string(name))];
+	if (!counter)
+		counter.reset(new PerformanceCounter());
+	return counter.get();
+}
+
+PerformanceCounter *PerformanceCounters::getStaticNameCounter(const char *category, const char *staticName)
+{
+	thread_local std::map<std::pair<const char *, const char *>, PerformanceCounter *> threadCounters;
+	PerformanceCounter *&counter = threadCounters[std::make_pair(category, staticName)];
+	if (!counter)
+		counter = PerformanceCounters::getCounter(category, staticName);
+	return counter;
+}
+
+std::vector<PerformanceCounters::Entry> PerformanceCounters::getEntries()
+{
+	std::vector<Entry> entries;
+	std::lock_guard<std::mutex> lock(getPerformanceCounterMutex());
+	for (const auto& iter : getPerformanceCounterMap())
+	{
+		const PerformanceCounter& counter = *(iter.second);
+		const unsigned long long count = counter.getCount();
+		if (count > 0)
+		{
+			Entry entry;
+			entry.category = iter.first.first;
+			entry.name = iter.first.second;
+			entry.count = count;
+			entry.nanoseconds = counter.getNanoseconds();
+			entry.timed = counter.isTimed();
+			entries.push_back(entry);
+		}
+	}
+	return entries;
+}
+
+}
@@ -0,0 +1,169 @@
+/**
+ * FILE : general/performance_counters.hpp
+ *
+ * Opt-in counters and timers on hot paths for performance analysis.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (CMZN_GENERAL_PERFORMANCE_COUNTERS_HPP)
+#define CMZN_GENERAL_PERFORMANCE_COUNTERS_HPP
+
+#include <atomic>
+#include <chrono>
+#include <string>
+#include <vector>
+
+namespace cmzn
+{
+
+/**
+ * Count of calls and optional total time for one named operation. Updated
+ * with relaxed atomics so any thread may add to it.
+ */
+class PerformanceCounter
+{
+	std::atomic<unsigned long long> count;
+	std::atomic<unsigned long long> nanoseconds;
+	std::atomic<bool> timed;
+
+public:
+	PerformanceCounter() :
+		count(0),
+		nanoseconds(0),
+		timed(false)
+	{
+	}
+
+	void increment()
+	{
+		this->count.fetch_add(1, std::memory_order_relaxed);
+	}
+
+	void addTime(unsigned long long nanosecondsIn)
+	{
+		this->count.fetch_add(1, std::memory_order_relaxed);
+		this->nanoseconds.fetch_add(nanosecondsIn, std::memory_order_relaxed);
+		this->timed.store(true, std::memory_order_relaxed);
+	}
+
+	unsigned long long getCount() const
+	{
+		return this->count.load(std::memory_order_relaxed);
+	}
+
+	unsigned long long getNanoseconds() const
+	{
+		return this->nanoseconds.load(std::memory_order_relaxed);
+	}
+
+	bool isTimed() const
+	{
+		return this->timed.load(std::memory_order_relaxed);
+	}
+
+	void reset()
+	{
+		this->count.store(0, std::memory_order_relaxed);
+		this->nanoseconds.store(0, std::memory_order_relaxed);
+		this->timed.store(false, std::memory_order_relaxed);
+	}
+};
+
+/**
+ * Process-wide registry of performance counters by category and name,
+ * switched on and reported through the context API. Disabled by default;
+ * while disabled each instrumented site costs one relaxed atomic load.
+ * Counters are never freed once created so pointers to them remain valid;
+ * reset zeroes them.
+ */
+class PerformanceCounters
+{
+	static std::atomic<bool> enabled;
+
+public:
+	/** Snapshot of one counter for reporting */
+	struct Entry
+	{
+		std::string category;
+		std::string name;
+		unsigned long long count;
+		unsigned long long nanoseconds;
+		bool timed;
+	};
+
+	static bool isEnabled()
+	{
+		return enabled.load(std::memory_order_relaxed);
+	}
+
+	static void setEnabled(bool enabledIn)
+	{
+		enabled.store(enabledIn, std::memory_order_relaxed);
+	}
+
+	/** Zero all counters. */
+	static void reset();
+
+	/**
+	 * Get or create counter for category and name, copying the strings.
+	 * Takes a lock, so cache the result at sites with fixed names.
+	 */
+	static PerformanceCounter *getCounter(const char *category, const char *name);
+
+	/**
+	 * Variant of getCounter for names with static storage such as field type
+	 * strings, which caches counters per thread by name address to avoid
+	 * locking on repeated calls.
+	 */
+	static PerformanceCounter *getStaticNameCounter(const char *category, const char *staticName);
+
+	/** @return  Snapshot of all counters with non-zero count, sorted by
+	 * category then name. */
+	static std::vector<Entry> getEntries();
+};
+
+/**
+ * Scoped timer adding elapsed time to a counter on destruction or stop.
+ * Only reads the clock if counters are enabled at construction.
+ */
+class PerformanceTimer
+{
+	PerformanceCounter *counter;
+	std::chrono::steady_clock::time_point startTime;
+
+public:
+	explicit PerformanceTimer(PerformanceCounter *counterIn) :
+		counter(PerformanceCounters::isEnabled() ? counterIn : nullptr)
+	{
+		if (this->counter)
+			this->startTime = std::chrono::steady_clock::now();
+	}
+
+	~PerformanceTimer()
+	{
+		this->stop();
+	}
+
+	/** Add elapsed time to counter now instead of on destruction. */
+	void stop()
+	{
+		if (this->counter)
+		{
+			this->counter->addTime(static_cast<unsigned long long>(
+				std::chrono::duration_cast<std::chrono::nanoseconds>(
+					std::chrono::steady_clock::now() - this->startTime).count()));
+			this->counter = nullptr;
+		}
+	}
+
+	PerformanceTimer(const PerformanceTimer&) = delete;
+	PerformanceTimer& operator=(const PerformanceTimer&) = delete;
+};
+
+}
+
+#endif /* !defined (CMZN_GENERAL_PERFORMANCE_COUNTERS_HPP) */
@@ -12,12 +12,16 @@
 #if !defined (CMZN_GENERAL_REFCOUNTED_HPP)
 #define CMZN_GENERAL_REFCOUNTED_HPP
 
+#include <atomic>
+
 namespace cmzn
 {
 
 /**
  * Base class for intrusively reference counted objects.
  * Constructed on heap with refCount of 1.
+ * Reference count is atomic so objects may be accessed and deaccessed from
+ * concurrent threads evaluating a frozen region.
  */
 class RefCounted
 {
@@ -31,7 +35,7 @@ class RefCounted
 	template<class REFCOUNTED> friend void Reaccess(REFCOUNTED* &object, REFCOUNTED* newObject);
 
 protected:
-	mutable int access_count;
+	mutable std::atomic_int access_count;
 
 	RefCounted() :
 		access_count(1)
@@ -49,8 +53,7 @@ protected:
 
 	void deaccess() const
 	{
-		--this->access_count;
-		if (this->access_count <= 0)
+		if (--this->access_count <= 0)
 			delete this;
 	}
 };
@@ -0,0 +1,193 @@
+/**
+ * FILE : general/thread_pool.cpp
+ *
+ * Pool of worker threads for parallel loops over index ranges.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "general/thread_pool.hpp"
+
+namespace cmzn
+{
+
+namespace {
+
+// true on pool workers and on a thread while it runs a loop, so nested loops run serially
+thread_local bool inThreadPoolLoop = false;
+
+}
+
+ThreadPool::ThreadPool(int threadCountIn) :
+	threadCount((threadCountIn > 0) ? threadCountIn : getHardwareThreadCount()),
+	chunkRanges(threadCount),
+	messageBuffers(threadCount),
+	chunkFunction(nullptr),
+	loopThreadCount(0),
+	loopNumber(0),
+	busyWorkerCount(0),
+	stopping(false)
+{
+	for (int t = 1; t < this->threadCount; ++t)
+	{
+		this->workers.emplace_back(&ThreadPool::workerMain, this, t);
+	}
+}
+
+ThreadPool::~ThreadPool()
+{
+	{
+		std::lock_guard<std::mutex> lock(this->jobMutex);
+		this->stopping = true;
+	}
+	this->jobCondition.notify_all();
+	for (auto& worker : this->workers)
+	{
+		worker.join();
+	}
+}
+
+int ThreadPool::getHardwareThreadCount()
+{
+	const int hardwareThreadCount = static_cast<int>(std::thread::hardware_concurrency());
+	return (hardwareThreadCount > 0) ? hardwareThreadCount : 1;
+}
+
+ThreadPool& ThreadPool::getSerialThreadPool()
+{
+	static ThreadPool serialThreadPool(1);
+	return serialThreadPool;
+}
+
+int ThreadPool::getLoopThreadCount(int maximumThreadCount, size_t chunkCount) const
+{
+	int count = this->threadCount;
+	if ((maximumThreadCount > 0) && (maximumThreadCount < count))
+		count = maximumThreadCount;
+	if (chunkCount < static_cast<size_t>(count))
+		count = static_cast<int>(chunkCount);
+	return (count > 0) ? count : 1;
+}
+
+void ThreadPool::workerMain(int threadIndex)
+{
+	inThreadPoolLoop = true;
+	set_thread_message_buffer(&this->messageBuffers[threadIndex]);
+	unsigned long long lastLoopNumber = 0;
+	while (true)
+	{
+		{
+			std::unique_lock<std::mutex> lock(this->jobMutex);
+			this->jobCondition.wait(lock, [&]()
+				{
+					return (this->stopping) || (this->loopNumber != lastLoopNumber);
+				});
+			if (this->stopping)
+				return;
+			lastLoopNumber = this->loopNumber;
+			if (threadIndex >= this->loopThreadCount)
+				continue;
+		}
+		this->processChunks(threadIndex);
+		{
+			std::lock_guard<std::mutex> lock(this->jobMutex);
+			--(this->busyWorkerCount);
+		}
+		this->doneCondition.notify_one();
+	}
+}
+
+bool ThreadPool::takeChunk(int threadIndex, size_t& chunk)
+{
+	ChunkRange& range = this->chunkRanges[threadIndex];
+	std::lock_guard<std::mutex> lock(range.mutex);
+	if (range.begin < range.end)
+	{
+		chunk = (range.begin)++;
+		return true;
+	}
+	return false;
+}
+
+bool ThreadPool::stealChunk(int threadIndex, size_t& chunk)
+{
+	for (int v = 1; v < this->loopThreadCount; ++v)
+	{
+		ChunkRange& victimRange = this->chunkRanges[(threadIndex + v) % this->loopThreadCount];
+		size_t stealBegin, stealEnd;
+		{
+			std::lock_guard<std::mutex> lock(victimRange.mutex);
+			if (victimRange.begin >= victimRange.end)
+				continue;
+			// take the later half so the victim continues on its nearby chunks
+			stealEnd = victimRange.end;
+			stealBegin = victimRange.end - (victimRange.end - victimRange.begin + 1)/2;
+			victimRange.end = stealBegin;
+		}
+		chunk = stealBegin;
+		ChunkRange& range = this->chunkRanges[threadIndex];
+		std::lock_guard<std::mutex> lock(range.mutex);
+		range.begin = stealBegin + 1;
+		range.end = stealEnd;
+		return true;
+	}
+	return false;
+}
+
+void ThreadPool::processChunks(int threadIndex)
+{
+	size_t chunk;
+	while ((this->takeChunk(threadIndex, chunk)) || (this->stealChunk(threadIndex, chunk)))
+	{
+		(*this->chunkFunction)(chunk, threadIndex);
+	}
+}
+
+void ThreadPool::forChunks(size_t chunkCount, int maximumThreadCount,
+	const ChunkFunction& chunkFunctionIn)
+{
+	const int useThreadCount = this->getLoopThreadCount(maximumThreadCount, chunkCount);
+	std::unique_lock<std::mutex> loopLock(this->loopMutex, std::defer_lock);
+	if ((useThreadCount <= 1) || (inThreadPoolLoop) || (!loopLock.try_lock()))
+	{
+		for (size_t chunk = 0; chunk < chunkCount; ++chunk)
+		{
+			chunkFunctionIn(chunk, 0);
+		}
+		return;
+	}
+	for (int t = 0; t < useThreadCount; ++t)
+	{
+		ChunkRange& range = this->chunkRanges[t];
+		std::lock_guard<std::mutex> lock(range.mutex);
+		range.begin = (chunkCount*t)/useThreadCount;
+		range.end = (chunkCount*(t + 1))/useThreadCount;
+	}
+	{
+		std::lock_guard<std::mutex> lock(this->jobMutex);
+		this->chunkFunction = &chunkFunctionIn;
+		this->loopThreadCount = useThreadCount;
+		this->busyWorkerCount = useThreadCount - 1;
+		++(this->loopNumber);
+	}
+	this->jobCondition.notify_all();
+	inThreadPoolLoop = true;
+	this->processChunks(0);
+	inThreadPoolLoop = false;
+	std::unique_lock<std::mutex> lock(this->jobMutex);
+	this->doneCondition.wait(lock, [&]()
+		{
+			return (0 == this->busyWorkerCount);
+		});
+	this->chunkFunction = nullptr;
+	lock.unlock();
+	for (int t = 1; t < useThreadCount; ++t)
+	{
+		this->messageBuffers[t].display();
+	}
+}
+
+}
@@ -0,0 +1,174 @@
+/**
+ * FILE : general/thread_pool.hpp
+ *
+ * Pool of worker threads for parallel loops over index ranges.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (CMZN_GENERAL_THREAD_POOL_HPP)
+#define CMZN_GENERAL_THREAD_POOL_HPP
+
+#include "general/message.h"
+#include <condition_variable>
+#include <cstddef>
+#include <functional>
+#include <mutex>
+#include <thread>
+#include <vector>
+
+namespace cmzn
+{
+
+/**
+ * Pool of worker threads owned by a context for parallel loops over index
+ * ranges, e.g. DsLabelIndex ranges of nodes or elements. The calling thread
+ * takes part in each loop as thread index 0, so a pool with one thread has no
+ * workers and runs all loops serially on the caller.
+ * Ranges are split into chunks of a fixed grain size independent of the
+ * number of threads. Each thread starts on its own contiguous share of the
+ * chunks and when it runs out steals half of the chunks remaining for
+ * another thread. Reductions combine per-chunk results in chunk order so
+ * they are identical for any number of threads.
+ * Only one loop runs on the pool at a time: loops started from a loop body
+ * or while another thread has a loop running are run serially on the
+ * calling thread.
+ * Messages displayed by workers are buffered and displayed on the calling
+ * thread after the loop, so message callbacks are not called on workers.
+ */
+class ThreadPool
+{
+public:
+	/** Called with index of chunk and index of thread processing it */
+	typedef std::function<void(size_t chunk, int threadIndex)> ChunkFunction;
+
+private:
+	// chunks remaining for one thread in the current loop, locked to steal
+	struct alignas(64) ChunkRange
+	{
+		std::mutex mutex;
+		size_t begin;
+		size_t end;
+	};
+
+	int threadCount;  // including calling thread
+	std::vector<std::thread> workers;
+	std::vector<ChunkRange> chunkRanges;
+	std::vector<Message_buffer> messageBuffers;  // for each thread; unused for calling thread
+	std::mutex loopMutex;  // held by thread running a loop on the pool
+	std::mutex jobMutex;  // guards following members
+	std::condition_variable jobCondition;
+	std::condition_variable doneCondition;
+	const ChunkFunction *chunkFunction;
+	int loopThreadCount;
+	unsigned long long loopNumber;
+	int busyWorkerCount;
+	bool stopping;
+
+	void workerMain(int threadIndex);
+
+	bool takeChunk(int threadIndex, size_t& chunk);
+
+	bool stealChunk(int threadIndex, size_t& chunk);
+
+	void processChunks(int threadIndex);
+
+public:
+
+	/**
+	 * @param threadCountIn  Number of threads including the calling thread,
+	 * or 0 for the number of hardware threads.
+	 */
+	explicit ThreadPool(int threadCountIn);
+
+	~ThreadPool();
+
+	/** @return  Number of hardware threads, at least 1. */
+	static int getHardwareThreadCount();
+
+	/** @return  Shared pool with one thread for running loops serially where
+	 * no context pool is available. */
+	static ThreadPool& getSerialThreadPool();
+
+	/** @return  Number of threads including the calling thread. */
+	int getThreadCount() const
+	{
+		return this->threadCount;
+	}
+
+	/**
+	 * Get the number of threads a loop over a number of chunks will use, to
+	 * size per-thread storage such as field caches before the loop.
+	 * @param maximumThreadCount  Limit on threads, or 0 for all pool threads.
+	 * @return  Number of threads, at least 1.
+	 */
+	int getLoopThreadCount(int maximumThreadCount, size_t chunkCount) const;
+
+	/**
+	 * Call chunkFunction for every chunk index in [0, chunkCount) on up to
+	 * maximumThreadCount threads, returning when all have been processed.
+	 * @param maximumThreadCount  Limit on threads, or 0 for all pool threads.
+	 */
+	void forChunks(size_t chunkCount, int maximumThreadCount,
+		const ChunkFunction& chunkFunction);
+
+	/**
+	 * Call function(chunkBegin, chunkEnd, threadIndex) for consecutive chunks
+	 * of up to grainSize indexes covering [begin, end), in parallel. Thread
+	 * index is less than getLoopThreadCount(maximumThreadCount, chunkCount)
+	 * so it can select per-thread field caches.
+	 * @param maximumThreadCount  Limit on threads, or 0 for all pool threads.
+	 */
+	template <typename IndexType, class Function>
+	void parallelFor(IndexType begin, IndexType end, IndexType grainSize,
+		int maximumThreadCount, Function function)
+	{
+		if (end <= begin)
+			return;
+		if (grainSize < 1)
+			grainSize = 1;
+		const size_t chunkCount = static_cast<size_t>((end - begin - 1)/grainSize) + 1;
+		this->forChunks(chunkCount, maximumThreadCount,
+			[&](size_t chunk, int threadIndex)
+			{
+				const IndexType chunkBegin = begin + static_cast<IndexType>(chunk)*grainSize;
+				const IndexType chunkEnd = ((end - chunkBegin) > grainSize) ? chunkBegin + grainSize : end;
+				function(chunkBegin, chunkEnd, threadIndex);
+			});
+	}
+
+	/**
+	 * Evaluate value = function(chunkBegin, chunkEnd, threadIndex) for chunks
+	 * as for parallelFor, and combine them in chunk order starting from
+	 * identity with reduce(value1, value2). Result is independent of the
+	 * number of threads for a given grain size.
+	 */
+	template <typename IndexType, typename ValueType, class Function, class Reduce>
+	ValueType parallelReduce(IndexType begin, IndexType end, IndexType grainSize,
+		int maximumThreadCount, const ValueType& identity, Function function, Reduce reduce)
+	{
+		if (end <= begin)
+			return identity;
+		if (grainSize < 1)
+			grainSize = 1;
+		std::vector<ValueType> chunkValues(static_cast<size_t>((end - begin - 1)/grainSize) + 1, identity);
+		this->parallelFor(begin, end, grainSize, maximumThreadCount,
+			[&](IndexType chunkBegin, IndexType chunkEnd, int threadIndex)
+			{
+				chunkValues[static_cast<size_t>((chunkBegin - begin)/grainSize)] =
+					function(chunkBegin, chunkEnd, threadIndex);
+			});
+		ValueType value = identity;
+		for (const ValueType& chunkValue : chunkValues)
+			value = reduce(value, chunkValue);
+		return value;
+	}
+
+};
+
+}
+
+#endif /* !defined (CMZN_GENERAL_THREAD_POOL_HPP) */
@@ -9,13 +9,19 @@
 * This Source Code Form is subject to the terms of the Mozilla Public
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+#include <algorithm>
+#include <atomic>
+#include <condition_variable>
+#include <mutex>
 #include <string>
+#include <thread>
 
 #include "cmlibs/zinc/zincconfigure.h"
 
 #include <cstdlib>
 #include <cstdio>
 #include <cmath>
+#include <vector>
 
 #include "cmlibs/zinc/font.h"
 #include "cmlibs/zinc/glyph.h"
@@ -33,12 +39,15 @@
 #include "general/multi_range.h"
 #include "general/mystring.h"
 #include "general/object.h"
+#include "general/performance_counters.hpp"
 #include "computed_field/computed_field.h"
 #include "computed_field/computed_field_finite_element.h"
 #include "computed_field/computed_field_group.hpp"
 #include "computed_field/computed_field_private.hpp"
 #include "computed_field/computed_field_set.h"
+#include "computed_field/computed_field_time.h"
 #include "computed_field/computed_field_wrappers.h"
+#include "computed_field/field_cache.hpp"
 #include "computed_field/field_module.hpp"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_discretization.h"
@@ -60,6 +69,7 @@
 #include "graphics/render_gl.h"
 #include "graphics/scene_coordinate_system.hpp"
 #include "graphics/tessellation.hpp"
+#include "region/cmiss_region.hpp"
 #if defined(USE_OPENCASCADE)
 #	include "cad/computed_field_cad_geometry.h"
 #	include "cad/computed_field_cad_topology.h"
@@ -192,12 +202,15 @@ cmzn_graphics::cmzn_graphics(enum cmzn_graphics_type graphicsTypeIn) :
 	first_isovalue(0.0),
 	last_isovalue(0.0),
 	decimation_threshold(0.0),
+	contours_shared_vertices(false),
+	contours_number_of_threads(1),
 	glyph(nullptr),
 	glyph_repeat_mode(CMZN_GLYPH_REPEAT_MODE_NONE),
 	point_orientation_scale_field(nullptr),
 	signed_scale_field(nullptr),
 	label_field(nullptr),
 	label_density_field(nullptr),
+	points_number_of_threads(1),
 	sampling_mode(CMZN_ELEMENT_POINT_SAMPLING_MODE_CELL_CENTRES),
 	sample_density_field(nullptr),
 	tessellation(nullptr),
@@ -209,6 +222,7 @@ cmzn_graphics::cmzn_graphics(enum cmzn_graphics_type graphicsTypeIn) :
 	streamlines_track_direction(CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_FORWARD),
 	streamline_length(1.0),
 	streamlines_colour_data_type(CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_FIELD),
+	streamlines_number_of_threads(1),
 	seed_nodeset(nullptr),
 	seed_node_mesh_location_field(nullptr),
 	visibility_flag(true),
@@ -223,10 +237,17 @@ cmzn_graphics::cmzn_graphics(enum cmzn_graphics_type graphicsTypeIn) :
 	render_line_width(1.0),
 	render_point_size(1.0),
 	graphics_object(nullptr),
+	previous_graphics_object(nullptr),
 	graphics_changed(1),
 	incrementalBuildIndex(DS_LABEL_INDEX_INVALID),
 	selected_graphics_changed(0),
 	timeDependent(false),
+	lod_levels_count(1),
+	lod_threshold(256.0),
+	lod_requested_level(0),
+	lod_build_level(0),
+	lod_render_level(0),
+	backgroundBuild(nullptr),
 	access_count(1)
 {
 	for (int i = 0; i < 2; i++)
@@ -250,6 +271,7 @@ cmzn_graphics::cmzn_graphics(enum cmzn_graphics_type graphicsTypeIn) :
 
 cmzn_graphics::~cmzn_graphics()
 {
+	this->cancelBackgroundBuild();
 	if (this->scene)
 		cmzn_graphics_set_scene_private(this, nullptr);
 	if (this->name)
@@ -260,6 +282,8 @@ cmzn_graphics::~cmzn_graphics()
 	{
 		DEACCESS(GT_object)(&(this->graphics_object));
 	}
+	this->clearPreviousGraphicsObject();
+	this->clearLodLevels();
 	if (this->coordinate_field)
 	{
 		DEACCESS(Computed_field)(&(this->coordinate_field));
@@ -374,17 +398,39 @@ void cmzn_graphics::setChange(cmzn_graphics_change change)
 	case CMZN_GRAPHICS_CHANGE_REDRAW:
 		break;
 	case CMZN_GRAPHICS_CHANGE_RECOMPILE:
+		// coarser levels are not updated with trivial attribute changes
+		this->clearLodLevels();
+		this->cancelBackgroundBuild();
+		this->selected_graphics_changed = 1;
+		break;
 	case CMZN_GRAPHICS_CHANGE_SELECTION:
+		this->changedLodLevels();
 		this->selected_graphics_changed = 1;
 		break;
 	case CMZN_GRAPHICS_CHANGE_PARTIAL_REBUILD:
 		// partial removal of graphics should have been done by caller
 		this->graphics_changed = 1;
+		this->clearLodLevels();
+		this->cancelBackgroundBuild();
 		break;
 	case CMZN_GRAPHICS_CHANGE_FULL_REBUILD:
-		this->graphics_changed = 1;
 		if (this->graphics_object)
-			DEACCESS(GT_object)(&(this->graphics_object));
+		{
+			// keep a completely built graphics object to draw while rebuilding;
+			// a partially built one is stale so is discarded
+			if (this->graphics_changed)
+				DEACCESS(GT_object)(&(this->graphics_object));
+			else
+			{
+				this->clearPreviousGraphicsObject();
+				this->previous_graphics_object = this->graphics_object;
+				this->graphics_object = nullptr;
+			}
+		}
+		this->graphics_changed = 1;
+		this->glyph_update_node_indexes.clear();
+		this->clearLodLevels();
+		this->cancelBackgroundBuild();
 		break;
 	}
 	this->incrementalBuildIndex = DS_LABEL_INDEX_INVALID;
@@ -392,6 +438,81 @@ void cmzn_graphics::setChange(cmzn_graphics_change change)
 		this->scene->setChanged();
 }
 
+void cmzn_graphics::clearLodLevels()
+{
+	for (auto& lodLevel : this->lod_levels)
+	{
+		if (lodLevel.graphics_object)
+			DEACCESS(GT_object)(&(lodLevel.graphics_object));
+	}
+	this->lod_levels.clear();
+	this->lod_requested_level = 0;
+}
+
+void cmzn_graphics::clearPreviousGraphicsObject()
+{
+	if (this->previous_graphics_object)
+	{
+		DEACCESS(GT_object)(&(this->previous_graphics_object));
+		if (this->scene)
+			this->scene->invalidateBoundingBox();
+	}
+}
+
+void cmzn_graphics::changedLodLevels()
+{
+	for (auto& lodLevel : this->lod_levels)
+	{
+		if (lodLevel.graphics_object)
+			GT_object_changed(lodLevel.graphics_object);
+	}
+}
+
+size_t cmzn_graphics::getLodLevelsMemory() const
+{
+	const Graphics_vertex_array_attribute_type attributeTypes[] =
+	{
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NORMAL,
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_TEXTURE_COORDINATE_ZERO
+	};
+	size_t memory = 0;
+	for (auto& lodLevel : this->lod_levels)
+	{
+		Graphics_vertex_array *vertex_array = (lodLevel.graphics_object) ?
+			GT_object_get_vertex_set(lodLevel.graphics_object) : nullptr;
+		if (!vertex_array)
+			continue;
+		for (auto attributeType : attributeTypes)
+		{
+			GLfloat *buffer = nullptr;
+			unsigned int values_per_vertex = 0, vertex_count = 0;
+			if (vertex_array->get_float_vertex_buffer(attributeType, &buffer, &values_per_vertex, &vertex_count))
+				memory += static_cast<size_t>(values_per_vertex)*vertex_count*sizeof(GLfloat);
+		}
+	}
+	return memory;
+}
+
+/**
+ * Reduce element divisions for the level of detail being built, halving them
+ * for each level down to a minimum of 1.
+ */
+static void cmzn_graphics_apply_lod_build_level(cmzn_graphics *graphics,
+	int dimensions, int *number_in_xi)
+{
+	if (graphics->lod_build_level > 0)
+	{
+		for (int d = 0; d < dimensions; ++d)
+		{
+			number_in_xi[d] >>= graphics->lod_build_level;
+			if (number_in_xi[d] < 1)
+				number_in_xi[d] = 1;
+		}
+	}
+}
+
 void cmzn_graphics::updateTimeDependence()
 {
 	if ((this->glyph) && this->glyph->isTimeVarying())
@@ -530,6 +651,26 @@ bool cmzn_element_is_on_subgroup_boundary(cmzn_element *element, cmzn_field *sub
 	return parentsInGroup == 1;
 }
 
+/**
+ * @return  Settings for tracking and drawing streamlines for graphics.
+ */
+static Streamline_settings cmzn_graphics_get_streamline_settings(cmzn_graphics *graphics,
+	cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
+{
+	Streamline_settings settings = {
+		graphics_to_object_data->rc_coordinate_field,
+		graphics_to_object_data->wrapper_stream_vector_field,
+		static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
+		graphics->streamline_length,
+		graphics->line_shape,
+		cmzn_tessellation_get_circle_divisions(graphics->tessellation),
+		graphics->line_base_size,
+		graphics->streamlines_colour_data_type,
+		graphics->data_field
+	};
+	return settings;
+}
+
 /**
  * Converts a finite element into a graphics object with the supplied graphics.
  * @param element  The cmzn_element.
@@ -539,7 +680,6 @@ bool cmzn_element_is_on_subgroup_boundary(cmzn_element *element, cmzn_field *sub
 static int cmzn_element_to_graphics_object(cmzn_element *element,
 	cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
 {
-	FE_value initial_xi[3];
 	int i, number_in_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS],
 		number_of_xi_points, return_code = 1;
 	struct Element_point_ranges_identifier element_point_ranges_identifier;
@@ -648,6 +788,11 @@ static int cmzn_element_to_graphics_object(cmzn_element *element,
 			graphics->face, native_discretization_field, top_level_number_in_xi,
 			&top_level_element, number_in_xi))
 		{
+			if (graphics_to_object_data->adaptive_discretization)
+			{
+				graphics_to_object_data->adaptive_discretization->getElementNumberInXi(
+					elementIndex, number_in_xi);
+			}
 			switch (graphics->graphics_type)
 			{
 				case CMZN_GRAPHICS_TYPE_LINES:
@@ -700,11 +845,21 @@ static int cmzn_element_to_graphics_object(cmzn_element *element,
 						{
 							if (3 == element_dimension)
 							{
-								return_code = create_iso_surfaces_from_FE_element(element,
-									graphics_to_object_data->field_cache,
-									graphics_to_object_data->master_mesh,
-									GT_object_get_vertex_set(graphics->graphics_object),
-									number_in_xi, graphics_to_object_data->iso_surface_specification);
+								if (graphics_to_object_data->iso_surface_elements)
+								{
+									// built together after iterating over mesh
+									Iso_surface_element iso_surface_element = { element,
+										{ number_in_xi[0], number_in_xi[1], number_in_xi[2] } };
+									graphics_to_object_data->iso_surface_elements->push_back(iso_surface_element);
+								}
+								else
+								{
+									return_code = create_iso_surfaces_from_FE_element(element,
+										graphics_to_object_data->field_cache,
+										graphics_to_object_data->master_mesh,
+										GT_object_get_vertex_set(graphics->graphics_object),
+										number_in_xi, graphics_to_object_data->iso_surface_specification);
+								}
 							}
 						} break;
 						case g_POLYLINE_VERTEX_BUFFERS:
@@ -804,10 +959,9 @@ static int cmzn_element_to_graphics_object(cmzn_element *element,
 				} break;
 				case CMZN_GRAPHICS_TYPE_STREAMLINES:
 				{
-					/* use local copy of sample_location since tracking function updates it */
 					for (i = 0; i < 3; i++)
 					{
-						initial_xi[i] =  element_point_ranges_identifier.exact_xi[i] = graphics->sample_location[i];
+						element_point_ranges_identifier.exact_xi[i] = graphics->sample_location[i];
 					}
 					if (FE_element_get_xi_points(element,
 						graphics->sampling_mode, number_in_xi,
@@ -817,53 +971,29 @@ static int cmzn_element_to_graphics_object(cmzn_element *element,
 						graphics->sample_density_field,
 						&number_of_xi_points, &xi_points))
 					{
-						switch (graphics->line_shape)
+						if (CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_INVALID == graphics->line_shape)
 						{
-						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_LINE:
-							{
-								for (i = 0; i < number_of_xi_points; i++)
-								{
-									initial_xi[0] = xi_points[i][0];
-									initial_xi[1] = xi_points[i][1];
-									initial_xi[2] = xi_points[i][2];
-									return_code = create_polyline_streamline_FE_element_vertex_array(
-										element, initial_xi, graphics_to_object_data->field_cache,
-										graphics_to_object_data->rc_coordinate_field,
-										graphics_to_object_data->wrapper_stream_vector_field,
-										static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
-										graphics->streamline_length,
-										graphics->streamlines_colour_data_type, graphics->data_field,
-										GT_object_get_vertex_set(graphics->graphics_object));
-								}
-							} break;
-						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_RIBBON:
-						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_CIRCLE_EXTRUSION:
-						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_SQUARE_EXTRUSION:
-							{
-								for (i = 0; i < number_of_xi_points; i++)
-								{
-									initial_xi[0] = xi_points[i][0];
-									initial_xi[1] = xi_points[i][1];
-									initial_xi[2] = xi_points[i][2];
-									return_code = create_surface_streamribbon_FE_element_vertex_array(
-										element, initial_xi, graphics_to_object_data->field_cache,
-										graphics_to_object_data->rc_coordinate_field,
-										graphics_to_object_data->wrapper_stream_vector_field,
-										static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
-										graphics->streamline_length,
-										graphics->line_shape, cmzn_tessellation_get_circle_divisions(graphics->tessellation),
-										graphics->line_base_size, graphics->line_scale_factors,
-										graphics->line_orientation_scale_field,
-										graphics->streamlines_colour_data_type, graphics->data_field,
-										GT_object_get_vertex_set(graphics->graphics_object));
-								}
-							} break;
-						case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_INVALID:
+							display_message(ERROR_MESSAGE,
+								"cmzn_element_to_graphics_object.  Unknown streamline type");
+							return_code = 0;
+						}
+						else
+						{
+							std::vector<Streamline_seed> seeds(number_of_xi_points);
+							for (i = 0; i < number_of_xi_points; i++)
 							{
-								display_message(ERROR_MESSAGE,
-									"cmzn_element_to_graphics_object.  Unknown streamline type");
-								return_code = 0;
-							} break;
+								seeds[i].element = element;
+								seeds[i].xi[0] = xi_points[i][0];
+								seeds[i].xi[1] = xi_points[i][1];
+								seeds[i].xi[2] = xi_points[i][2];
+							}
+							const Streamline_settings settings = cmzn_graphics_get_streamline_settings(
+								graphics, graphics_to_object_data);
+							// as before, failure to track from element xi points is not an error
+							create_streamlines_FE_element_vertex_array(number_of_xi_points, seeds.data(),
+								graphics_to_object_data->field_cache, settings,
+								graphics->streamlines_number_of_threads,
+								GT_object_get_vertex_set(graphics->graphics_object));
 						}
 					}
 					else
@@ -899,84 +1029,59 @@ static int cmzn_element_to_graphics_object(cmzn_element *element,
 	return (return_code);
 } /* cmzn_element_to_graphics_object */
 
-/***************************************************************************//**
- * Creates a streamline seeded from the location given by the
- * seed_node_mesh_location_field at the node.
- * @param node  The node to seed streamline from.
+/**
+ * Creates streamlines seeded from the locations given by the
+ * seed_node_mesh_location_field at nodes in the graphics seed_nodeset.
+ * Nodes without a seed location are skipped.
  * @param graphics_to_object_data  All other data including graphics.
- * @return  1 if successfully added streamline
+ * @return  1 if successfully added streamlines
  */
-static int cmzn_node_to_streamline(struct FE_node *node,
+static int cmzn_graphics_seed_nodeset_to_streamlines(
 	struct cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
 {
-	int return_code = 1;
-
-	ENTER(node_to_streamline);
 	struct cmzn_graphics *graphics = 0;
-	if (node && graphics_to_object_data &&
+	if (!(graphics_to_object_data &&
 		(NULL != (graphics = graphics_to_object_data->graphics)) &&
-		graphics->graphics_object)
+		graphics->graphics_object && graphics->seed_nodeset &&
+		graphics->seed_node_mesh_location_field))
+	{
+		display_message(ERROR_MESSAGE,
+			"cmzn_graphics_seed_nodeset_to_streamlines.  Invalid argument(s)");
+		return 0;
+	}
+	if (CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_INVALID == graphics->line_shape)
+	{
+		display_message(ERROR_MESSAGE,
+			"cmzn_graphics_seed_nodeset_to_streamlines.  Unknown streamline type");
+		return 0;
+	}
+	// get all seed locations first so streamlines can be tracked in parallel
+	std::vector<Streamline_seed> seeds;
+	seeds.reserve(cmzn_nodeset_get_size(graphics->seed_nodeset));
+	Streamline_seed seed;
+	cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(graphics->seed_nodeset);
+	cmzn_node_id node = 0;
+	while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
 	{
 		cmzn_fieldcache_set_node(graphics_to_object_data->field_cache, node);
-		FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
 		cmzn_element_id element = cmzn_field_evaluate_mesh_location(
 			graphics->seed_node_mesh_location_field, graphics_to_object_data->field_cache,
-			MAXIMUM_ELEMENT_XI_DIMENSIONS, xi);
+			MAXIMUM_ELEMENT_XI_DIMENSIONS, seed.xi);
 		if (element)
 		{
-			switch (graphics->line_shape)
-			{
-			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_LINE:
-				{
-					return_code = create_polyline_streamline_FE_element_vertex_array(element,
-							xi, graphics_to_object_data->field_cache,
-							graphics_to_object_data->rc_coordinate_field,
-							graphics_to_object_data->wrapper_stream_vector_field,
-							static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
-							graphics->streamline_length,
-							graphics->streamlines_colour_data_type, graphics->data_field,
-							GT_object_get_vertex_set(graphics->graphics_object));
-				} break;
-			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_RIBBON:
-			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_CIRCLE_EXTRUSION:
-			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_SQUARE_EXTRUSION:
-				{
-					return_code = create_surface_streamribbon_FE_element_vertex_array(element,
-						xi, graphics_to_object_data->field_cache,
-						graphics_to_object_data->rc_coordinate_field,
-						graphics_to_object_data->wrapper_stream_vector_field,
-						static_cast<int>(graphics->streamlines_track_direction == CMZN_GRAPHICS_STREAMLINES_TRACK_DIRECTION_REVERSE),
-						graphics->streamline_length,
-						graphics->line_shape, cmzn_tessellation_get_circle_divisions(graphics->tessellation),
-						graphics->line_base_size, graphics->line_scale_factors,
-						graphics->line_orientation_scale_field,
-						graphics->streamlines_colour_data_type, graphics->data_field,
-						GT_object_get_vertex_set(graphics->graphics_object));
-				} break;
-			case CMZN_GRAPHICSLINEATTRIBUTES_SHAPE_TYPE_INVALID:
-				{
-					display_message(ERROR_MESSAGE,
-						"cmzn_node_to_streamline.  Unknown streamline type");
-					return_code=0;
-				} break;
-			}
+			// not accessed: element remains in mesh while building graphics
+			seed.element = element;
+			seeds.push_back(seed);
 			cmzn_element_destroy(&element);
 		}
-		else
-		{
-			return_code=1;
-		}
 	}
-	else
-	{
-		display_message(ERROR_MESSAGE,
-			"cmzn_node_to_streamline.  Invalid argument(s)");
-		return_code=0;
-	}
-	LEAVE;
-
-	return (return_code);
-} /* node_to_streamline */
+	cmzn_nodeiterator_destroy(&iterator);
+	const Streamline_settings settings = cmzn_graphics_get_streamline_settings(
+		graphics, graphics_to_object_data);
+	return create_streamlines_FE_element_vertex_array(static_cast<int>(seeds.size()), seeds.data(),
+		graphics_to_object_data->field_cache, settings, graphics->streamlines_number_of_threads,
+		GT_object_get_vertex_set(graphics->graphics_object));
+}
 
 int cmzn_graphics_add_to_list(struct cmzn_graphics *graphics,
 	int position,struct LIST(cmzn_graphics) *list_of_graphics)
@@ -1273,6 +1378,8 @@ int cmzn_graphics_set_visibility_flag(cmzn_graphics_id graphics,
 		if (graphics->visibility_flag != visibility_flag)
 		{
 			graphics->visibility_flag = visibility_flag;
+			if (!visibility_flag)
+				graphics->clearLodLevels();
 			graphics->setChange(CMZN_GRAPHICS_CHANGE_REDRAW);
 		}
 		return CMZN_OK;
@@ -1863,6 +1970,10 @@ char *cmzn_graphics_string(struct cmzn_graphics *graphics,
 					graphics->decimation_threshold);
 				append_string(&graphics_string,temp_string,&error);
 			}
+			if (graphics->contours_shared_vertices)
+			{
+				append_string(&graphics_string," shared_vertices",&error);
+			}
 		}
 
 		// line attributes
@@ -2713,9 +2824,179 @@ static char *cmzn_graphics_get_graphics_object_name(cmzn_graphics *graphics, con
 	return graphics_object_name;
 }
 
+/**
+ * Creates the graphics object for the graphics with its current material,
+ * render and select settings.
+ * @return  Accessed new graphics object, or NULL if failed.
+ */
+static GT_object *cmzn_graphics_create_graphics_object(cmzn_graphics *graphics,
+	const char *graphics_object_name)
+{
+	enum GT_object_type graphics_object_type = cmzn_graphics_get_graphics_object_type(graphics);
+	if (graphics_object_type == g_OBJECT_TYPE_INVALID)
+		return nullptr;
+	GT_object *graphics_object = CREATE(GT_object)(graphics_object_name,
+		graphics_object_type, graphics->material);
+	if (graphics_object)
+	{
+		set_GT_object_render_line_width(graphics_object, graphics->render_line_width);
+		set_GT_object_render_point_size(graphics_object, graphics->render_point_size);
+		GT_object_set_select_mode(graphics_object, graphics->select_mode);
+		if (graphics->secondary_material)
+		{
+			set_GT_object_secondary_material(graphics_object, graphics->secondary_material);
+		}
+		if (graphics->selected_material)
+		{
+			set_GT_object_selected_material(graphics_object, graphics->selected_material);
+		}
+	}
+	return graphics_object;
+}
+
+/**
+ * Gets the field wrappers and glyph graphics object the graphics is built
+ * with, from its scene. The glyph graphics object is accessed.
+ * @return  1 on success, 0 if a wrapper could not be found.
+ */
+static int cmzn_graphics_get_build_wrappers(cmzn_graphics *graphics,
+	cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
+{
+	int return_code = 1;
+	Computed_field *coordinate_field = graphics->coordinate_field;
+	graphics_to_object_data->rc_coordinate_field = (cmzn_field_id)0;
+	graphics_to_object_data->wrapper_orientation_scale_field = (cmzn_field_id)0;
+	graphics_to_object_data->wrapper_stream_vector_field = (cmzn_field_id)0;
+	graphics_to_object_data->glyph_gt_object = 0;
+	if (coordinate_field)
+	{
+		graphics_to_object_data->rc_coordinate_field = graphics->scene->getCoordinateFieldWrapper(coordinate_field);
+		if (!graphics_to_object_data->rc_coordinate_field)
+		{
+			display_message(ERROR_MESSAGE,
+				"cmzn_graphics_to_graphics_object.  Could not get rc_coordinate_field wrapper");
+			return_code = 0;
+		}
+	}
+	if (return_code && (graphics->point_orientation_scale_field))
+	{
+		graphics_to_object_data->wrapper_orientation_scale_field =
+			graphics->scene->getVectorFieldWrapper(graphics->point_orientation_scale_field, coordinate_field);
+		if (!graphics_to_object_data->wrapper_orientation_scale_field)
+		{
+			display_message(ERROR_MESSAGE,
+				"cmzn_graphics_to_graphics_object.  Could not get orientation_scale_field wrapper");
+			return_code = 0;
+		}
+	}
+	if (return_code && (graphics->stream_vector_field))
+	{
+		graphics_to_object_data->wrapper_stream_vector_field =
+			graphics->scene->getVectorFieldWrapper(graphics->stream_vector_field, coordinate_field);
+		if (!graphics_to_object_data->wrapper_stream_vector_field)
+		{
+			display_message(ERROR_MESSAGE,
+				"cmzn_graphics_to_graphics_object.  Could not get stream_vector_field wrapper");
+			return_code = 0;
+		}
+	}
+	if (return_code && graphics->glyph)
+	{
+		graphics_to_object_data->glyph_gt_object =
+			graphics->glyph->getGraphicsObject(graphics->tessellation, graphics->material, graphics->font);
+	}
+	return return_code;
+}
+
+/**
+ * Builds a new graphics object for a graphics on a background thread. It is
+ * built from a copy of the graphics, with field wrappers, iteration domain,
+ * element iterator, discretization, graphics object and a field cache with
+ * value caches for all its fields prepared on the calling thread, so the
+ * background thread only evaluates fields and adds primitives to its own
+ * graphics object. The region is frozen while building, and the build is
+ * stopped before the region is modified or the graphics is changed.
+ * Owned by the graphics, which swaps in the graphics object once built.
+ * Only graphics types building primitives from element fields are supported,
+ * as glyphs, fonts and streamline seeds are shared objects which are not
+ * safe to use concurrently.
+ */
+class GraphicsBackgroundBuild
+{
+	cmzn_graphics *graphics;  // copy of graphics being built
+	cmzn_region *region;  // not accessed; kept alive by field cache
+	std::string name_prefix;
+	cmzn_graphics_to_graphics_object_data graphics_to_object_data;
+	cmzn_elementiterator *iterator;  // for iteration mesh, created on calling thread
+	Message_buffer messageBuffer;  // messages from build, displayed when finished
+	std::thread thread;
+	std::mutex finishedMutex;
+	std::condition_variable finishedCondition;
+	std::atomic<bool> cancelled;
+	bool started;
+	bool finished;  // guarded by finishedMutex
+
+	GraphicsBackgroundBuild();
+
+	void build();
+
+	void stop();
+
+public:
+
+	~GraphicsBackgroundBuild();
+
+	/**
+	 * Prepare to build graphics in the background from the current graphics
+	 * settings. Must be called from cmzn_graphics_to_graphics_object.
+	 * @return  New background build to start, or nullptr if failed.
+	 */
+	static GraphicsBackgroundBuild *create(cmzn_graphics *sourceGraphics,
+		cmzn_graphics_to_graphics_object_data *source_graphics_to_object_data);
+
+	/** Start building in the background if the region can be frozen,
+	 * otherwise build now. */
+	void start();
+
+	bool isStarted() const
+	{
+		return this->started;
+	}
+
+	bool isCancelled() const
+	{
+		return this->cancelled;
+	}
+
+	cmzn_elementiterator *getElementiterator() const
+	{
+		return this->iterator;
+	}
+
+	/**
+	 * Wait for the started build to finish.
+	 * @param timeout  Maximum time to wait in seconds, or negative to wait
+	 * until finished.
+	 * @return  True if finished.
+	 */
+	bool waitForFinish(double timeout);
+
+	/**
+	 * Complete a finished build: end freeze of the region and display
+	 * messages from the build.
+	 * @return  Accessed graphics object if built without error and not
+	 * cancelled, otherwise nullptr.
+	 */
+	GT_object *finish();
+};
+
 static int cmzn_mesh_to_graphics(cmzn_mesh_id mesh, cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
 {
-	cmzn_elementiterator_id iterator = cmzn_mesh_create_elementiterator(mesh);
+	// background build prepares iterator over its iteration mesh as creating
+	// iterators is not thread safe
+	GraphicsBackgroundBuild *backgroundBuild = graphics_to_object_data->backgroundBuild;
+	cmzn_elementiterator_id iterator = (backgroundBuild) ? backgroundBuild->getElementiterator() :
+		cmzn_mesh_create_elementiterator(mesh);
 	if (!iterator)
 		return 0;
 	int return_code = 1;
@@ -2726,6 +3007,8 @@ static int cmzn_mesh_to_graphics(cmzn_mesh_id mesh, cmzn_graphics_to_graphics_ob
 		iterator->setIndex(graphics->incrementalBuildIndex);
 	while (0 != (element = cmzn_elementiterator_next_non_access(iterator)))
 	{
+		if ((backgroundBuild) && backgroundBuild->isCancelled())
+			break;
 		if (!cmzn_element_to_graphics_object(element, graphics_to_object_data))
 		{
 			return_code = 0;
@@ -2739,12 +3022,104 @@ static int cmzn_mesh_to_graphics(cmzn_mesh_id mesh, cmzn_graphics_to_graphics_ob
 			break;
 		}
 	}
-	cmzn_elementiterator_destroy(&iterator);
+	if (!backgroundBuild)
+		cmzn_elementiterator_destroy(&iterator);
 	if ((incrementalBuild) && !incrementalBuild->isMoreWorkToDo())
 		graphics->incrementalBuildIndex = DS_LABEL_INDEX_INVALID;
 	return return_code;
 }
 
+/**
+ * Computes adaptive element discretizations for the graphics while in scope,
+ * if its tessellation has a positive adaptive tolerance. Incremental build is
+ * suspended meanwhile as the discretization of each element depends on its
+ * neighbours.
+ */
+class GraphicsAdaptiveDiscretizationScope
+{
+	cmzn_graphics_to_graphics_object_data *graphics_to_object_data;
+	GraphicsIncrementalBuild *incrementalBuild;
+	FE_mesh_adaptive_discretization *adaptive_discretization;
+
+public:
+	GraphicsAdaptiveDiscretizationScope(cmzn_graphics_to_graphics_object_data *graphics_to_object_dataIn) :
+		graphics_to_object_data(graphics_to_object_dataIn),
+		incrementalBuild(graphics_to_object_dataIn->incrementalBuild),
+		adaptive_discretization(nullptr)
+	{
+		cmzn_graphics *graphics = this->graphics_to_object_data->graphics;
+		const double tolerance = cmzn_graphics_get_adaptive_tolerance(graphics);
+		cmzn_mesh *iteration_mesh = this->graphics_to_object_data->iteration_mesh;
+		if ((tolerance > 0.0) && (iteration_mesh))
+		{
+			cmzn_field *fields[2];
+			int fieldsCount = 0;
+			fields[fieldsCount++] = (graphics->tessellation_field) ? graphics->tessellation_field :
+				this->graphics_to_object_data->rc_coordinate_field;
+			if ((graphics->graphics_type == CMZN_GRAPHICS_TYPE_CONTOURS) && (graphics->isoscalar_field))
+				fields[fieldsCount++] = graphics->isoscalar_field;
+			int minimum_number_in_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+			int maximum_number_in_xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+			cmzn_tessellation_get_minimum_divisions(graphics->tessellation,
+				MAXIMUM_ELEMENT_XI_DIMENSIONS, minimum_number_in_xi);
+			cmzn_tessellation_get_refinement_factors(graphics->tessellation,
+				MAXIMUM_ELEMENT_XI_DIMENSIONS, maximum_number_in_xi);
+			for (int d = 0; d < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++d)
+				maximum_number_in_xi[d] *= minimum_number_in_xi[d];
+			cmzn_graphics_apply_lod_build_level(graphics, MAXIMUM_ELEMENT_XI_DIMENSIONS, minimum_number_in_xi);
+			cmzn_graphics_apply_lod_build_level(graphics, MAXIMUM_ELEMENT_XI_DIMENSIONS, maximum_number_in_xi);
+			this->adaptive_discretization = new FE_mesh_adaptive_discretization(iteration_mesh->getFeMesh());
+			if (this->adaptive_discretization->build(iteration_mesh, this->graphics_to_object_data->field_cache,
+				fieldsCount, fields, minimum_number_in_xi, maximum_number_in_xi, tolerance))
+			{
+				this->graphics_to_object_data->adaptive_discretization = this->adaptive_discretization;
+				this->graphics_to_object_data->incrementalBuild = nullptr;
+			}
+			else
+			{
+				display_message(WARNING_MESSAGE, "Graphics adaptive tessellation failed. Using minimum divisions.");
+			}
+		}
+	}
+
+	~GraphicsAdaptiveDiscretizationScope()
+	{
+		this->graphics_to_object_data->adaptive_discretization = nullptr;
+		this->graphics_to_object_data->incrementalBuild = this->incrementalBuild;
+		delete this->adaptive_discretization;
+	}
+};
+
+/**
+ * Creates iso-surfaces with vertices shared between elements over the
+ * iteration mesh. Elements are gathered with the usual per-element checks
+ * then swept together, so the build is not split into increments.
+ * @param graphics_to_object_data  All other data including graphics.
+ * @return  1 if successfully added iso-surfaces
+ */
+static int cmzn_graphics_mesh_to_shared_iso_surfaces(
+	cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
+{
+	cmzn_graphics *graphics = graphics_to_object_data->graphics;
+	std::vector<Iso_surface_element> iso_surface_elements;
+	GraphicsIncrementalBuild *incrementalBuild = graphics_to_object_data->incrementalBuild;
+	graphics_to_object_data->incrementalBuild = nullptr;
+	graphics_to_object_data->iso_surface_elements = &iso_surface_elements;
+	int return_code = cmzn_mesh_to_graphics(graphics_to_object_data->iteration_mesh, graphics_to_object_data);
+	graphics_to_object_data->iso_surface_elements = nullptr;
+	graphics_to_object_data->incrementalBuild = incrementalBuild;
+	if (return_code)
+	{
+		return_code = create_shared_iso_surfaces_from_FE_elements(
+			static_cast<int>(iso_surface_elements.size()), iso_surface_elements.data(),
+			graphics_to_object_data->field_cache, graphics_to_object_data->master_mesh,
+			GT_object_get_vertex_set(graphics->graphics_object),
+			graphics_to_object_data->iso_surface_specification,
+			graphics->contours_number_of_threads);
+	}
+	return return_code;
+}
+
 int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *graphics,
 	cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
 {
@@ -2765,54 +3140,14 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 			cmzn_fieldcache_clear_location(graphics_to_object_data->field_cache);
 			cmzn_fieldcache_set_time(graphics_to_object_data->field_cache, graphics_to_object_data->time);
 			Computed_field *coordinate_field = graphics->coordinate_field;
+			// background build prepares wrappers, iteration domain and discretization
+			GraphicsBackgroundBuild *backgroundBuild = graphics_to_object_data->backgroundBuild;
 			if (coordinate_field ||
 				(graphics->domain_type == CMZN_FIELD_DOMAIN_TYPE_POINT))
 			{
 				/* RC coordinate_field to pass to cmzn_element_to_graphics_object */
-				graphics_to_object_data->rc_coordinate_field = (cmzn_field_id)0;
-				graphics_to_object_data->wrapper_orientation_scale_field = (cmzn_field_id)0;
-				graphics_to_object_data->wrapper_stream_vector_field = (cmzn_field_id)0;
-				if (coordinate_field)
-				{
-					graphics_to_object_data->rc_coordinate_field = graphics->scene->getCoordinateFieldWrapper(coordinate_field);
-					if (!graphics_to_object_data->rc_coordinate_field)
-					{
-						display_message(ERROR_MESSAGE,
-							"cmzn_graphics_to_graphics_object.  Could not get rc_coordinate_field wrapper");
-						return_code = 0;
-					}
-				}
-				if (return_code && (graphics->point_orientation_scale_field))
-				{
-					graphics_to_object_data->wrapper_orientation_scale_field =
-						graphics->scene->getVectorFieldWrapper(graphics->point_orientation_scale_field, coordinate_field);
-					if (!graphics_to_object_data->wrapper_orientation_scale_field)
-					{
-						display_message(ERROR_MESSAGE,
-							"cmzn_graphics_to_graphics_object.  Could not get orientation_scale_field wrapper");
-						return_code = 0;
-					}
-				}
-				if (return_code && (graphics->stream_vector_field))
-				{
-					graphics_to_object_data->wrapper_stream_vector_field =
-						graphics->scene->getVectorFieldWrapper(graphics->stream_vector_field, coordinate_field);
-					if (!graphics_to_object_data->wrapper_stream_vector_field)
-					{
-						display_message(ERROR_MESSAGE,
-							"cmzn_graphics_to_graphics_object.  Could not get stream_vector_field wrapper");
-						return_code = 0;
-					}
-				}
-				if (return_code && graphics->glyph)
-				{
-					graphics_to_object_data->glyph_gt_object =
-						graphics->glyph->getGraphicsObject(graphics->tessellation, graphics->material, graphics->font);
-				}
-				else
-				{
-					graphics_to_object_data->glyph_gt_object = 0;
-				}
+				if (!backgroundBuild)
+					return_code = cmzn_graphics_get_build_wrappers(graphics, graphics_to_object_data);
 				if (return_code)
 				{
 					char *graphics_string;
@@ -2825,8 +3160,9 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 						DEALLOCATE(graphics_string);
 					}
 #endif /* defined (DEBUG_CODE) */
-					cmzn_graphics_get_top_level_number_in_xi(graphics,
-						MAXIMUM_ELEMENT_XI_DIMENSIONS, graphics_to_object_data->top_level_number_in_xi);
+					if (!backgroundBuild)
+						cmzn_graphics_get_top_level_number_in_xi(graphics,
+							MAXIMUM_ELEMENT_XI_DIMENSIONS, graphics_to_object_data->top_level_number_in_xi);
 					/* work out the name the graphics object is to have */
 					char *graphics_object_name = cmzn_graphics_get_graphics_object_name(graphics, graphics_to_object_data->name_prefix);
 					if (graphics_object_name)
@@ -2837,29 +3173,7 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 						}
 						else
 						{
-							enum GT_object_type graphics_object_type = cmzn_graphics_get_graphics_object_type(graphics);
-							if (graphics_object_type == g_OBJECT_TYPE_INVALID)
-								return_code = 1;
-							if (return_code)
-							{
-								graphics->graphics_object = CREATE(GT_object)(
-									graphics_object_name, graphics_object_type,
-									graphics->material);
-								set_GT_object_render_line_width(graphics->graphics_object, graphics->render_line_width);
-								set_GT_object_render_point_size(graphics->graphics_object, graphics->render_point_size);
-								GT_object_set_select_mode(graphics->graphics_object,
-									graphics->select_mode);
-								if (graphics->secondary_material)
-								{
-									set_GT_object_secondary_material(graphics->graphics_object,
-										graphics->secondary_material);
-								}
-								if (graphics->selected_material)
-								{
-									set_GT_object_selected_material(graphics->graphics_object,
-										graphics->selected_material);
-								}
-							}
+							graphics->graphics_object = cmzn_graphics_create_graphics_object(graphics, graphics_object_name);
 						}
 						DEALLOCATE(graphics_object_name);
 					}
@@ -2882,7 +3196,8 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 						graphics->selected_graphics_changed=1;
 						/* need graphics for cmzn_element_to_graphics_object routine */
 						graphics_to_object_data->graphics=graphics;
-						cmzn_graphics_get_iteration_domain(graphics, graphics_to_object_data);
+						if (!backgroundBuild)
+							cmzn_graphics_get_iteration_domain(graphics, graphics_to_object_data);
 						switch (graphics->graphics_type)
 						{
 						case CMZN_GRAPHICS_TYPE_POINTS:
@@ -2892,8 +3207,7 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 							case CMZN_FIELD_DOMAIN_TYPE_NODES:
 							case CMZN_FIELD_DOMAIN_TYPE_DATAPOINTS:
 							{
-								// currently graphics for all nodes/datapoints are always rebuilt entirely
-								GT_object_clear_primitives(graphics->graphics_object);
+								// graphics for nodes/datapoints are rebuilt entirely unless glyphs can be updated in place
 								cmzn_nodeset_id master_nodeset = cmzn_fieldmodule_find_nodeset_by_field_domain_type(
 									graphics_to_object_data->field_module, graphics->domain_type);
 								cmzn_nodeset_id iteration_nodeset = nullptr;
@@ -2915,6 +3229,30 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 								{
 									iteration_nodeset = cmzn_nodeset_access(master_nodeset);
 								}
+								bool updatedInPlace = false;
+								if ((iteration_nodeset) && (!graphics->glyph_update_node_indexes.empty()) &&
+									(GT_object_get_GT_glyphset_vertex_buffers(graphics->graphics_object)))
+								{
+									updatedInPlace = (0 != Nodeset_update_vertex_array(
+										static_cast<int>(graphics->glyph_update_node_indexes.size()),
+										graphics->glyph_update_node_indexes.data(),
+										iteration_nodeset, graphics_to_object_data->field_cache,
+										graphics->graphics_object,
+										graphics_to_object_data->rc_coordinate_field,
+										graphics->data_field,
+										graphics_to_object_data->wrapper_orientation_scale_field,
+										graphics->signed_scale_field));
+								}
+								graphics->glyph_update_node_indexes.clear();
+								if (updatedInPlace)
+								{
+									GT_object_reset_buffer_binding(graphics->graphics_object);
+									cmzn_nodeset_destroy(&iteration_nodeset);
+								}
+								else
+								{
+									GT_object_clear_primitives(graphics->graphics_object);
+								}
 								if (iteration_nodeset)
 								{
 									GT_glyphset_vertex_buffers *glyphset = Nodeset_create_vertex_array(
@@ -2933,7 +3271,7 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 										graphics->point_base_size, graphics->point_offset, graphics->point_scale_factors,
 										graphics->font,  graphics->label_offset,
 										graphics->label_text,
-										graphics->select_mode);
+										graphics->select_mode, graphics->points_number_of_threads);
 									if (!GT_OBJECT_ADD(GT_glyphset_vertex_buffers)(
 											graphics->graphics_object, glyphset))
 									{
@@ -3077,7 +3415,10 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 								else
 									GT_object_reset_buffer_binding(graphics->graphics_object);
 								if (return_code && (graphics_to_object_data->iteration_mesh))
+								{
+									GraphicsAdaptiveDiscretizationScope adaptiveDiscretizationScope(graphics_to_object_data);
 									return_code = cmzn_mesh_to_graphics(graphics_to_object_data->iteration_mesh, graphics_to_object_data);
+								}
 							}
 						} break;
 						case CMZN_GRAPHICS_TYPE_CONTOURS:
@@ -3090,8 +3431,10 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 								{
 									if (g_SURFACE_VERTEX_BUFFERS == GT_object_get_type(graphics->graphics_object))
 									{
+										// shared vertices are indexed with continuous shading
 										GT_surface_vertex_buffers *surfaces =
-											CREATE(GT_surface_vertex_buffers)(g_SH_DISCONTINUOUS_TEXMAP, graphics->render_polygon_mode);
+											CREATE(GT_surface_vertex_buffers)(graphics->contours_shared_vertices ?
+												g_SHADED_TEXMAP : g_SH_DISCONTINUOUS_TEXMAP, graphics->render_polygon_mode);
 										if (!GT_OBJECT_ADD(GT_surface_vertex_buffers)(graphics->graphics_object, surfaces))
 										{
 											DESTROY(GT_surface_vertex_buffers)(&surfaces);
@@ -3124,7 +3467,16 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 												graphics->isoscalar_field,
 												graphics->texture_coordinate_field);
 									}
-									return_code = cmzn_mesh_to_graphics(graphics_to_object_data->iteration_mesh, graphics_to_object_data);
+									GraphicsAdaptiveDiscretizationScope adaptiveDiscretizationScope(graphics_to_object_data);
+									if ((graphics->contours_shared_vertices) &&
+										(g_SURFACE_VERTEX_BUFFERS == GT_object_get_type(graphics->graphics_object)))
+									{
+										return_code = cmzn_graphics_mesh_to_shared_iso_surfaces(graphics_to_object_data);
+									}
+									else
+									{
+										return_code = cmzn_mesh_to_graphics(graphics_to_object_data->iteration_mesh, graphics_to_object_data);
+									}
 									if (g_SURFACE_VERTEX_BUFFERS == GT_object_get_type(graphics->graphics_object))
 									{
 										Iso_surface_specification_destroy(&graphics_to_object_data->iso_surface_specification);
@@ -3159,17 +3511,7 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 							else if (graphics->seed_nodeset &&
 								graphics->seed_node_mesh_location_field)
 							{
-								cmzn_nodeiterator_id iterator = cmzn_nodeset_create_nodeiterator(graphics->seed_nodeset);
-								cmzn_node_id node = 0;
-								while (0 != (node = cmzn_nodeiterator_next_non_access(iterator)))
-								{
-									if (!cmzn_node_to_streamline(node, graphics_to_object_data))
-									{
-										return_code = 0;
-										break;
-									}
-								}
-								cmzn_nodeiterator_destroy(&iterator);
+								return_code = cmzn_graphics_seed_nodeset_to_streamlines(graphics_to_object_data);
 							}
 							else
 							{
@@ -3184,14 +3526,18 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 							return_code = 0;
 						} break;
 						} /* end of switch */
-						cmzn_mesh_destroy(&graphics_to_object_data->iteration_mesh);
-						cmzn_mesh_destroy(&graphics_to_object_data->master_mesh);
+						if (!backgroundBuild)
+						{
+							cmzn_mesh_destroy(&graphics_to_object_data->iteration_mesh);
+							cmzn_mesh_destroy(&graphics_to_object_data->master_mesh);
+						}
 						if (return_code)
 						{
-							/* set the spectrum in the graphics object - if required */
-							if ((graphics->data_field) ||
+							/* set the spectrum in the graphics object - if required;
+							 * shared spectrum is set when background build is swapped in */
+							if ((!backgroundBuild) && ((graphics->data_field) ||
 								((CMZN_GRAPHICS_TYPE_STREAMLINES == graphics->graphics_type) &&
-									(CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_FIELD != graphics->streamlines_colour_data_type)))
+									(CMZN_GRAPHICS_STREAMLINES_COLOUR_DATA_TYPE_FIELD != graphics->streamlines_colour_data_type))))
 							{
 								set_GT_object_Spectrum(graphics->graphics_object, graphics->spectrum);
 							}
@@ -3199,6 +3545,8 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 								graphics->graphics_changed = 0;
 							/* mark display list as needing updating */
 							GT_object_changed(graphics->graphics_object);
+							if (graphics->scene)
+								graphics->scene->invalidateBoundingBox();
 						}
 						else
 						{
@@ -3231,15 +3579,329 @@ int cmzn_graphics_to_graphics_object_no_check_on_filter(struct cmzn_graphics *gr
 				}
 			}
 		}
-		if (graphics->selected_graphics_changed)
+		if (graphics->selected_graphics_changed)
+		{
+			if (graphics->graphics_object)
+				GT_object_changed(graphics->graphics_object);
+			graphics->selected_graphics_changed = 0;
+		}
+	}
+	else
+		return_code = 0;
+	return return_code;
+}
+
+GraphicsBackgroundBuild::GraphicsBackgroundBuild() :
+	graphics(nullptr),
+	region(nullptr),
+	iterator(nullptr),
+	cancelled(false),
+	started(false),
+	finished(false)
+{
+	cmzn_graphics_to_graphics_object_data& data = this->graphics_to_object_data;
+	data.field_cache = nullptr;
+	data.name_prefix = nullptr;
+	data.rc_coordinate_field = nullptr;
+	data.wrapper_orientation_scale_field = nullptr;
+	data.wrapper_stream_vector_field = nullptr;
+	data.glyph_gt_object = nullptr;
+	data.region = nullptr;
+	data.field_module = nullptr;
+	data.fe_region = nullptr;
+	data.master_mesh = nullptr;
+	data.iteration_mesh = nullptr;
+	data.time = 0.0;
+	data.incrementalBuild = nullptr;
+	data.selectionGroup = nullptr;
+	data.build_graphics = 0;
+	data.number_of_data_values = 0;
+	data.data_copy_buffer = nullptr;
+	data.iso_surface_specification = nullptr;
+	data.iso_surface_elements = nullptr;
+	data.adaptive_discretization = nullptr;
+	data.backgroundBuild = this;
+	data.scenefilter = nullptr;
+	data.graphics = nullptr;
+	for (int i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
+		data.top_level_number_in_xi[i] = 0;
+}
+
+GraphicsBackgroundBuild::~GraphicsBackgroundBuild()
+{
+	this->stop();
+	if (this->region)
+		this->region->endBackgroundFreeze(this);
+	cmzn_graphics_to_graphics_object_data& data = this->graphics_to_object_data;
+	cmzn_elementiterator_destroy(&this->iterator);
+	cmzn_mesh_destroy(&data.iteration_mesh);
+	cmzn_mesh_destroy(&data.master_mesh);
+	cmzn_field_destroy(&data.rc_coordinate_field);
+	cmzn_field_destroy(&data.wrapper_orientation_scale_field);
+	cmzn_field_destroy(&data.wrapper_stream_vector_field);
+	cmzn_field_group_destroy(&data.selectionGroup);
+	cmzn_fieldcache_destroy(&data.field_cache);
+	cmzn_fieldmodule_destroy(&data.field_module);
+	cmzn_graphics_destroy(&this->graphics);
+}
+
+GraphicsBackgroundBuild *GraphicsBackgroundBuild::create(cmzn_graphics *sourceGraphics,
+	cmzn_graphics_to_graphics_object_data *source_graphics_to_object_data)
+{
+	if (!((sourceGraphics) && (sourceGraphics->scene) && (source_graphics_to_object_data) &&
+		(source_graphics_to_object_data->name_prefix) && (source_graphics_to_object_data->region)))
+		return nullptr;
+	GraphicsBackgroundBuild *backgroundBuild = new GraphicsBackgroundBuild();
+	cmzn_graphics *graphics = cmzn_graphics::create(sourceGraphics->graphics_type);
+	backgroundBuild->graphics = graphics;
+	if (!((graphics) && (cmzn_graphics_copy_without_graphics_object(graphics, sourceGraphics))))
+	{
+		delete backgroundBuild;
+		return nullptr;
+	}
+	// copy has no scene to get highest dimension from
+	if (CMZN_FIELD_DOMAIN_TYPE_MESH_HIGHEST_DIMENSION == graphics->domain_type)
+	{
+		const int dimension = cmzn_graphics_get_domain_dimension(sourceGraphics);
+		graphics->domain_type = (1 == dimension) ? CMZN_FIELD_DOMAIN_TYPE_MESH1D :
+			(2 == dimension) ? CMZN_FIELD_DOMAIN_TYPE_MESH2D : CMZN_FIELD_DOMAIN_TYPE_MESH3D;
+	}
+	backgroundBuild->region = source_graphics_to_object_data->region;
+	backgroundBuild->name_prefix = source_graphics_to_object_data->name_prefix;
+	cmzn_graphics_to_graphics_object_data& data = backgroundBuild->graphics_to_object_data;
+	data.name_prefix = backgroundBuild->name_prefix.c_str();
+	data.region = backgroundBuild->region;
+	data.field_module = cmzn_region_get_fieldmodule(data.region);
+	data.field_cache = cmzn_fieldmodule_create_fieldcache(data.field_module);
+	data.fe_region = data.region->get_FE_region();
+	data.time = source_graphics_to_object_data->time;
+	cmzn_fieldcache_set_time(data.field_cache, data.time);
+	if (source_graphics_to_object_data->selectionGroup)
+	{
+		data.selectionGroup = cmzn_field_cast_group(
+			cmzn_field_group_base_cast(source_graphics_to_object_data->selectionGroup));
+	}
+	data.graphics = graphics;
+	// graphics->scene must be valid to get field wrappers
+	cmzn_scene *tmpScene = graphics->scene;
+	graphics->scene = sourceGraphics->scene;
+	int return_code = cmzn_graphics_get_build_wrappers(graphics, &data);
+	graphics->scene = tmpScene;
+	if (data.glyph_gt_object)
+		DEACCESS(GT_object)(&data.glyph_gt_object);  // not used by supported graphics types
+	if (data.rc_coordinate_field)
+		cmzn_field_access(data.rc_coordinate_field);
+	if (data.wrapper_orientation_scale_field)
+		cmzn_field_access(data.wrapper_orientation_scale_field);
+	if (data.wrapper_stream_vector_field)
+		cmzn_field_access(data.wrapper_stream_vector_field);
+	if (return_code)
+		return_code = cmzn_graphics_get_iteration_domain(graphics, &data);
+	if (return_code)
+	{
+		cmzn_graphics_get_top_level_number_in_xi(graphics,
+			MAXIMUM_ELEMENT_XI_DIMENSIONS, data.top_level_number_in_xi);
+		backgroundBuild->iterator = cmzn_mesh_create_elementiterator(data.iteration_mesh);
+		char *graphics_object_name = cmzn_graphics_get_graphics_object_name(graphics, data.name_prefix);
+		if (graphics_object_name)
+		{
+			graphics->graphics_object = cmzn_graphics_create_graphics_object(graphics, graphics_object_name);
+			DEALLOCATE(graphics_object_name);
+		}
+		if (!((backgroundBuild->iterator) && (graphics->graphics_object)))
+			return_code = 0;
+	}
+	if (!return_code)
+	{
+		delete backgroundBuild;
+		return nullptr;
+	}
+	// value caches must exist before evaluating on another thread
+	FieldcacheThreadSet fieldcaches(data.field_cache, 1);
+	fieldcaches.createValueCaches(data.rc_coordinate_field);
+	fieldcaches.createValueCaches(graphics->data_field);
+	fieldcaches.createValueCaches(graphics->texture_coordinate_field);
+	fieldcaches.createValueCaches(graphics->line_orientation_scale_field);
+	fieldcaches.createValueCaches(graphics->isoscalar_field);
+	fieldcaches.createValueCaches(graphics->subgroup_field);
+	fieldcaches.createValueCaches(graphics->tessellation_field);
+	fieldcaches.createValueCaches(cmzn_field_group_base_cast(data.selectionGroup));
+	return backgroundBuild;
+}
+
+void GraphicsBackgroundBuild::build()
+{
+	Message_buffer *previousMessageBuffer = set_thread_message_buffer(&this->messageBuffer);
+	cmzn_graphics_to_graphics_object_no_check_on_filter(this->graphics, &this->graphics_to_object_data);
+	set_thread_message_buffer(previousMessageBuffer);
+	std::lock_guard<std::mutex> lock(this->finishedMutex);
+	this->finished = true;
+	this->finishedCondition.notify_all();
+}
+
+void GraphicsBackgroundBuild::start()
+{
+	if (this->started)
+		return;
+	this->started = true;
+	if (CMZN_OK == this->region->beginBackgroundFreeze(this, [this]() { this->stop(); }))
+		this->thread = std::thread(&GraphicsBackgroundBuild::build, this);
+	else
+		this->build();  // region is caching changes: build now
+}
+
+void GraphicsBackgroundBuild::stop()
+{
+	this->cancelled = true;
+	if ((this->thread.joinable()) && (this->thread.get_id() != std::this_thread::get_id()))
+		this->thread.join();
+}
+
+bool GraphicsBackgroundBuild::waitForFinish(double timeout)
+{
+	std::unique_lock<std::mutex> lock(this->finishedMutex);
+	if (timeout < 0.0)
+		this->finishedCondition.wait(lock, [this]() { return this->finished; });
+	else
+		this->finishedCondition.wait_for(lock, std::chrono::duration<double>(timeout),
+			[this]() { return this->finished; });
+	return this->finished;
+}
+
+GT_object *GraphicsBackgroundBuild::finish()
+{
+	if (this->thread.joinable())
+		this->thread.join();
+	this->region->endBackgroundFreeze(this);
+	if (this->cancelled)
+		return nullptr;
+	this->messageBuffer.display();
+	if (0 != this->graphics->graphics_changed)
+		return nullptr;
+	return ACCESS(GT_object)(this->graphics->graphics_object);
+}
+
+void cmzn_graphics::cancelBackgroundBuild()
+{
+	delete this->backgroundBuild;
+	this->backgroundBuild = nullptr;
+}
+
+/**
+ * @return  True if graphics can be built on a background thread: lines,
+ * surfaces and contours over elements without adaptive tessellation.
+ */
+static bool cmzn_graphics_can_build_in_background(cmzn_graphics *graphics)
+{
+	return ((CMZN_GRAPHICS_TYPE_LINES == graphics->graphics_type) ||
+			(CMZN_GRAPHICS_TYPE_SURFACES == graphics->graphics_type) ||
+			(CMZN_GRAPHICS_TYPE_CONTOURS == graphics->graphics_type)) &&
+		(graphics->coordinate_field) && (graphics->scene) &&
+		(cmzn_graphics_get_adaptive_tolerance(graphics) <= 0.0);
+}
+
+/**
+ * Builds the graphics object for a changed graphics on a background thread if
+ * enabled for the incremental build and supported by the graphics, otherwise
+ * builds it now. A started background build is waited on until the time left
+ * for the incremental build, and its graphics object is swapped in once
+ * finished; until then more work is recorded so the scene viewer redraws,
+ * continuing to draw the previous graphics object.
+ */
+static int cmzn_graphics_update_graphics_object(struct cmzn_graphics *graphics,
+	cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
+{
+	GraphicsIncrementalBuild *incrementalBuild = graphics_to_object_data->incrementalBuild;
+	GraphicsBackgroundBuild *backgroundBuild = graphics->backgroundBuild;
+	if (backgroundBuild)
+	{
+		if (!backgroundBuild->isStarted())
+			backgroundBuild->start();
+		if (!backgroundBuild->waitForFinish((incrementalBuild) ? incrementalBuild->getTimeRemaining() : -1.0))
+		{
+			incrementalBuild->setMoreWorkToDo();
+			return 1;
+		}
+		const bool cancelled = backgroundBuild->isCancelled();
+		GT_object *graphics_object = backgroundBuild->finish();
+		graphics->cancelBackgroundBuild();
+		if (graphics_object)
 		{
 			if (graphics->graphics_object)
-				GT_object_changed(graphics->graphics_object);
+				DEACCESS(GT_object)(&graphics->graphics_object);
+			graphics->graphics_object = graphics_object;
+			if (graphics->data_field)
+				set_GT_object_Spectrum(graphics->graphics_object, graphics->spectrum);
+			graphics->graphics_changed = 0;
+			graphics->incrementalBuildIndex = DS_LABEL_INDEX_INVALID;
 			graphics->selected_graphics_changed = 0;
+			GT_object_changed(graphics->graphics_object);
+			graphics->clearPreviousGraphicsObject();
+			graphics->scene->invalidateBoundingBox();
+			return 1;
 		}
+		// if failed, rebuild now to report errors
+		if (!cancelled)
+			return cmzn_graphics_to_graphics_object_no_check_on_filter(graphics, graphics_to_object_data);
 	}
-	else
-		return_code = 0;
+	// only full rebuilds: partial rebuilds update the graphics object in place
+	if ((graphics->graphics_changed) && (!graphics->graphics_object) && (incrementalBuild) &&
+		incrementalBuild->isBuildInBackground() && cmzn_graphics_can_build_in_background(graphics))
+	{
+		graphics->backgroundBuild = GraphicsBackgroundBuild::create(graphics, graphics_to_object_data);
+		if (graphics->backgroundBuild)
+		{
+			incrementalBuild->setMoreWorkToDo();
+			return 1;
+		}
+	}
+	return cmzn_graphics_to_graphics_object_no_check_on_filter(graphics, graphics_to_object_data);
+}
+
+/**
+ * Continues building the coarser level of detail requested for the graphics
+ * once its main graphics object is complete. The level's graphics object is
+ * temporarily swapped in so the normal, possibly incremental, build applies
+ * with element divisions reduced for the level.
+ */
+static int cmzn_graphics_build_requested_lod_level(struct cmzn_graphics *graphics,
+	cmzn_graphics_to_graphics_object_data *graphics_to_object_data)
+{
+	const int level = graphics->lod_requested_level;
+	if ((level <= 0) || (graphics->graphics_changed) || (!graphics->graphics_object))
+		return 1;
+	if (level >= graphics->lod_levels_count)
+	{
+		graphics->lod_requested_level = 0;
+		return 1;
+	}
+	if (static_cast<int>(graphics->lod_levels.size()) < level)
+	{
+		cmzn_graphics_lod_level newLevel = { nullptr, 1, DS_LABEL_INDEX_INVALID, 0 };
+		graphics->lod_levels.resize(level, newLevel);
+	}
+	cmzn_graphics_lod_level& lodLevel = graphics->lod_levels[level - 1];
+	if (!lodLevel.graphics_changed)
+	{
+		graphics->lod_requested_level = 0;
+		return 1;
+	}
+	GT_object *graphics_object = graphics->graphics_object;
+	const DsLabelIndex incrementalBuildIndex = graphics->incrementalBuildIndex;
+	graphics->graphics_object = lodLevel.graphics_object;
+	graphics->graphics_changed = lodLevel.graphics_changed;
+	graphics->incrementalBuildIndex = lodLevel.incrementalBuildIndex;
+	graphics->lod_build_level = level;
+	int return_code = cmzn_graphics_to_graphics_object_no_check_on_filter(graphics, graphics_to_object_data);
+	graphics->lod_build_level = 0;
+	lodLevel.graphics_object = graphics->graphics_object;
+	lodLevel.graphics_changed = graphics->graphics_changed;
+	lodLevel.incrementalBuildIndex = graphics->incrementalBuildIndex;
+	graphics->graphics_object = graphics_object;
+	graphics->graphics_changed = 0;
+	graphics->incrementalBuildIndex = incrementalBuildIndex;
+	if (!lodLevel.graphics_changed)
+		graphics->lod_requested_level = 0;
 	return return_code;
 }
 
@@ -3258,8 +3920,19 @@ int cmzn_graphics_to_graphics_object(
 		/* build only if visible and changed */
 		if ((0 == filter) || (cmzn_scenefilter_evaluate_graphics(filter, graphics)))
 		{
-			return_code = cmzn_graphics_to_graphics_object_no_check_on_filter(graphics,
-				graphics_to_object_data);
+			// time only graphics being rebuilt, by graphics name
+			cmzn::PerformanceTimer buildTimer((cmzn::PerformanceCounters::isEnabled() && graphics->graphics_changed) ?
+				cmzn::PerformanceCounters::getCounter("graphics_build", graphics->name ? graphics->name : "(unnamed)") : nullptr);
+			return_code = cmzn_graphics_update_graphics_object(graphics, graphics_to_object_data);
+			if (return_code)
+				return_code = cmzn_graphics_build_requested_lod_level(graphics, graphics_to_object_data);
+		}
+		// previous graphics object is only drawn until an incremental or background rebuild is complete
+		GraphicsIncrementalBuild *incrementalBuild = graphics_to_object_data->incrementalBuild;
+		if ((graphics->previous_graphics_object) && ((!graphics->graphics_changed) ||
+			((!graphics->backgroundBuild) && ((!incrementalBuild) || (incrementalBuild->isShowPartialGraphics())))))
+		{
+			graphics->clearPreviousGraphicsObject();
 		}
 	}
 	else
@@ -3272,6 +3945,85 @@ int cmzn_graphics_to_graphics_object(
 	return (return_code);
 }
 
+int cmzn_graphics_start_background_build(
+	struct cmzn_graphics *graphics, void *dummy_void)
+{
+	USE_PARAMETER(dummy_void);
+	if ((graphics) && (graphics->backgroundBuild) && (!graphics->backgroundBuild->isStarted()))
+		graphics->backgroundBuild->start();
+	return 1;
+}
+
+int cmzn_graphics_build_graphics_objects_at_times(struct cmzn_graphics *graphics,
+	const char *name_prefix, int timesCount, const FE_value *times, int threadsCount,
+	std::vector<GT_object *>& graphicsObjectsOut)
+{
+	graphicsObjectsOut.clear();
+	if (!((graphics) && (name_prefix) && (0 < timesCount) && (times) && (0 <= threadsCount)))
+		return CMZN_ERROR_ARGUMENT;
+	if (!cmzn_graphics_can_build_in_background(graphics))
+		return CMZN_ERROR_NOT_IMPLEMENTED;
+	// time value fields evaluate the timekeeper time, not the field cache time
+	cmzn_field *fields[] = { graphics->coordinate_field, graphics->data_field,
+		graphics->texture_coordinate_field, graphics->line_orientation_scale_field,
+		graphics->isoscalar_field, graphics->subgroup_field, graphics->tessellation_field };
+	for (cmzn_field *field : fields)
+	{
+		if (Computed_field_depends_on_time_value(field))
+			return CMZN_ERROR_NOT_IMPLEMENTED;
+	}
+	cmzn_region *region = cmzn_scene_get_region_internal(graphics->scene);
+	if (0 == threadsCount)
+		threadsCount = region->getThreadPool().getThreadCount();
+	// only the members used to create background builds
+	cmzn_graphics_to_graphics_object_data graphics_to_object_data = {};
+	graphics_to_object_data.name_prefix = name_prefix;
+	graphics_to_object_data.region = region;
+	graphics_to_object_data.selectionGroup = graphics->scene->getLocalSelectionGroupForHighlighting();
+	int result = CMZN_OK;
+	std::vector<GraphicsBackgroundBuild *> backgroundBuilds;
+	for (int batchStart = 0; (batchStart < timesCount) && (CMZN_OK == result); batchStart += threadsCount)
+	{
+		// prepare all builds in batch before starting any
+		const int batchEnd = std::min(timesCount, batchStart + threadsCount);
+		for (int t = batchStart; t < batchEnd; ++t)
+		{
+			graphics_to_object_data.time = times[t];
+			GraphicsBackgroundBuild *backgroundBuild = GraphicsBackgroundBuild::create(graphics, &graphics_to_object_data);
+			if (!backgroundBuild)
+			{
+				result = CMZN_ERROR_GENERAL;
+				break;
+			}
+			backgroundBuilds.push_back(backgroundBuild);
+		}
+		for (GraphicsBackgroundBuild *backgroundBuild : backgroundBuilds)
+			backgroundBuild->start();
+		// finish in time order
+		for (GraphicsBackgroundBuild *backgroundBuild : backgroundBuilds)
+		{
+			GT_object *graphics_object = backgroundBuild->finish();
+			if (graphics_object)
+			{
+				if (graphics->data_field)
+					set_GT_object_Spectrum(graphics_object, graphics->spectrum);
+				graphicsObjectsOut.push_back(graphics_object);
+			}
+			else
+				result = CMZN_ERROR_GENERAL;
+			delete backgroundBuild;
+		}
+		backgroundBuilds.clear();
+	}
+	if (CMZN_OK != result)
+	{
+		for (GT_object *graphics_object : graphicsObjectsOut)
+			DEACCESS(GT_object)(&graphics_object);
+		graphicsObjectsOut.clear();
+	}
+	return result;
+}
+
 int cmzn_graphics_compile_visible_graphics(
 	struct cmzn_graphics *graphics, void *renderer_void)
 {
@@ -3281,12 +4033,24 @@ int cmzn_graphics_compile_visible_graphics(
 	if (graphics && (renderer = static_cast<Render_graphics *>(renderer_void)))
 	{
 		return_code = 1;
-		if (graphics->graphics_object)
+		if (cmzn_graphics_get_graphics_object(graphics))
 		{
 			cmzn_scenefilter_id filter = renderer->getScenefilter();
 			if ((0 == filter) || (cmzn_scenefilter_evaluate_graphics(filter, graphics)))
 			{
 				return_code = renderer->Graphics_compile(graphics);
+				// compile completely built coarser levels of detail
+				const int levelsCount = static_cast<int>(graphics->lod_levels.size());
+				for (int level = 1; (level <= levelsCount) && return_code; ++level)
+				{
+					const cmzn_graphics_lod_level& lodLevel = graphics->lod_levels[level - 1];
+					if ((lodLevel.graphics_object) && (!lodLevel.graphics_changed))
+					{
+						graphics->lod_render_level = level;
+						return_code = renderer->Graphics_compile(graphics);
+						graphics->lod_render_level = 0;
+					}
+				}
 			}
 		}
 	}
@@ -3312,7 +4076,8 @@ int cmzn_graphics_execute_visible_graphics(
 			(renderer_void)))
 	{
 		return_code = 1;
-		if (graphics->graphics_object)
+		GT_object *graphics_object = cmzn_graphics_get_graphics_object(graphics);
+		if (graphics_object)
 		{
 			cmzn_scenefilter_id filter = renderer->getScenefilter();
 			if ((0 == filter) || (cmzn_scenefilter_evaluate_graphics(filter, graphics)))
@@ -3328,7 +4093,28 @@ int cmzn_graphics_execute_visible_graphics(
 							glLoadName((GLuint)graphics->position);
 #endif /* defined (OPENGL_API) */
 						}
-						return_code = renderer->Graphics_execute(graphics);
+						// skip graphics in local coordinates entirely outside the view frustum
+						bool culled = false;
+						if ((renderer->view_frustum_culling) && (!renderer->picking) &&
+							(graphics->coordinate_system == CMZN_SCENECOORDINATESYSTEM_LOCAL))
+						{
+							Graphics_object_range_struct bounding_box;
+							culled = GT_object_add_bounding_box(graphics_object, &bounding_box) &&
+								renderer->isOutsideViewFrustum(bounding_box);
+						}
+						if (!culled)
+						{
+							GraphicsLevelOfDetail *levelOfDetail = renderer->getLevelOfDetail();
+							if ((levelOfDetail) && (graphics->lod_levels_count > 1) && (!renderer->picking))
+							{
+								double clip_matrix[16];
+								renderer->getClipMatrix(clip_matrix);
+								graphics->lod_render_level = levelOfDetail->selectLevel(graphics, clip_matrix,
+									renderer->viewport_width, renderer->viewport_height);
+							}
+							return_code = renderer->Graphics_execute(graphics);
+							graphics->lod_render_level = 0;
+						}
 						renderer->end_coordinate_system(graphics->coordinate_system);
 					}
 				}
@@ -3347,6 +4133,164 @@ int cmzn_graphics_execute_visible_graphics(
 	return (return_code);
 } /* cmzn_graphics_execute_visible_graphics */
 
+GraphicsLevelOfDetail::GraphicsLevelOfDetail() :
+	memoryBudget(0.0),
+	stamp(0),
+	moreWorkToDo(false)
+{
+}
+
+GraphicsLevelOfDetail::~GraphicsLevelOfDetail()
+{
+	for (auto graphics : this->graphicsList)
+		cmzn_graphics::deaccess(graphics);
+}
+
+void GraphicsLevelOfDetail::beginFrame(double memoryBudgetIn)
+{
+	// stamps are shared by all viewers as graphics may be drawn in several
+	static unsigned int lastStamp = 0;
+	this->stamp = ++lastStamp;
+	this->memoryBudget = memoryBudgetIn;
+	this->moreWorkToDo = false;
+}
+
+int GraphicsLevelOfDetail::selectLevel(cmzn_graphics *graphics,
+	const double *projectionMatrix16, double viewportWidth, double viewportHeight)
+{
+	if ((!graphics) || (graphics->lod_levels_count <= 1) || (graphics->graphics_changed) ||
+		(!graphics->graphics_object))
+		return 0;
+	Graphics_object_range_struct range;
+	GT_object_add_coordinates_range(graphics->graphics_object, &range);
+	if (range.first)
+		return 0;
+	// project corners of coordinate range to get its size on screen in pixels
+	double ndcMinimum[2] = { 0.0, 0.0 }, ndcMaximum[2] = { 0.0, 0.0 };
+	for (int c = 0; c < 8; ++c)
+	{
+		const double x[3] =
+		{
+			(c & 1) ? range.maximum[0] : range.minimum[0],
+			(c & 2) ? range.maximum[1] : range.minimum[1],
+			(c & 4) ? range.maximum[2] : range.minimum[2]
+		};
+		double clip[4];
+		for (int row = 0; row < 4; ++row)
+			clip[row] = projectionMatrix16[row] * x[0] + projectionMatrix16[4 + row] * x[1] +
+				projectionMatrix16[8 + row] * x[2] + projectionMatrix16[12 + row];
+		if (clip[3] <= 0.0)
+			return 0; // range crosses eye plane: treat as large
+		for (int i = 0; i < 2; ++i)
+		{
+			const double ndc = clip[i] / clip[3];
+			if ((c == 0) || (ndc < ndcMinimum[i]))
+				ndcMinimum[i] = ndc;
+			if ((c == 0) || (ndc > ndcMaximum[i]))
+				ndcMaximum[i] = ndc;
+		}
+	}
+	const double sizeX = 0.5*(ndcMaximum[0] - ndcMinimum[0])*viewportWidth;
+	const double sizeY = 0.5*(ndcMaximum[1] - ndcMinimum[1])*viewportHeight;
+	const double size = (sizeX > sizeY) ? sizeX : sizeY;
+	if (size >= graphics->lod_threshold)
+		return 0;
+	int wantLevel = graphics->lod_levels_count - 1;
+	if (size > 0.0)
+	{
+		const int level = static_cast<int>(floor(log2(graphics->lod_threshold / size))) + 1;
+		if (level < wantLevel)
+			wantLevel = level;
+	}
+	// remember graphics so levels built for it are counted until evicted
+	if (std::find(this->graphicsList.begin(), this->graphicsList.end(), graphics) == this->graphicsList.end())
+		this->graphicsList.push_back(graphics->access());
+	// draw finest built level not finer than wanted; request wanted level if not built
+	int drawLevel = 0;
+	const int levelsCount = static_cast<int>(graphics->lod_levels.size());
+	for (int level = (wantLevel < levelsCount) ? wantLevel : levelsCount; level > 0; --level)
+	{
+		const cmzn_graphics_lod_level& lodLevel = graphics->lod_levels[level - 1];
+		if ((lodLevel.graphics_object) && (!lodLevel.graphics_changed))
+		{
+			drawLevel = level;
+			break;
+		}
+	}
+	if (drawLevel != wantLevel)
+	{
+		graphics->lod_requested_level = wantLevel;
+		this->moreWorkToDo = true;
+	}
+	if (drawLevel > 0)
+	{
+		graphics->lod_levels[drawLevel - 1].lastUsedStamp = this->stamp;
+	}
+	return drawLevel;
+}
+
+void GraphicsLevelOfDetail::enforceMemoryBudget()
+{
+	size_t memory = 0;
+	for (auto iter = this->graphicsList.begin(); iter != this->graphicsList.end(); )
+	{
+		cmzn_graphics *graphics = *iter;
+		// levels of graphics removed from their scene can never be drawn again
+		if ((!graphics->scene) || (graphics->getAccessCount() == 1))
+			graphics->clearLodLevels();
+		bool hasLevels = false;
+		for (auto& lodLevel : graphics->lod_levels)
+		{
+			if (lodLevel.graphics_object)
+			{
+				hasLevels = true;
+				break;
+			}
+		}
+		if ((hasLevels) || (graphics->lod_requested_level > 0))
+		{
+			memory += graphics->getLodLevelsMemory();
+			++iter;
+		}
+		else
+		{
+			cmzn_graphics::deaccess(graphics);
+			iter = this->graphicsList.erase(iter);
+		}
+	}
+	while (memory > this->memoryBudget)
+	{
+		// evict least recently used level, coarsest first for equal use;
+		// never evict levels drawn in this frame as they would be rebuilt next frame
+		cmzn_graphics *evictGraphics = nullptr;
+		int evictLevel = 0;
+		unsigned int evictStamp = 0;
+		for (auto graphics : this->graphicsList)
+		{
+			const int levelsCount = static_cast<int>(graphics->lod_levels.size());
+			for (int level = levelsCount; level > 0; --level)
+			{
+				const cmzn_graphics_lod_level& lodLevel = graphics->lod_levels[level - 1];
+				if ((lodLevel.graphics_object) && (lodLevel.lastUsedStamp != this->stamp) &&
+					((!evictGraphics) || (lodLevel.lastUsedStamp < evictStamp)))
+				{
+					evictGraphics = graphics;
+					evictLevel = level;
+					evictStamp = lodLevel.lastUsedStamp;
+				}
+			}
+		}
+		if (!evictGraphics)
+			break;
+		const size_t graphicsMemory = evictGraphics->getLodLevelsMemory();
+		cmzn_graphics_lod_level& lodLevel = evictGraphics->lod_levels[evictLevel - 1];
+		DEACCESS(GT_object)(&(lodLevel.graphics_object));
+		lodLevel.graphics_changed = 1;
+		lodLevel.incrementalBuildIndex = DS_LABEL_INDEX_INVALID;
+		memory -= graphicsMemory - evictGraphics->getLodLevelsMemory();
+	}
+}
+
 namespace {
 
 /**
@@ -3459,6 +4403,85 @@ cmzn_field_change_flags cmzn_graphics_get_most_significant_field_change(
 	return change;
 }
 
+/**
+ * Adds nodes changed in the graphics' nodeset to the list of node glyphs to be
+ * updated in place, if only their field values have changed.
+ * @return  True if glyphs can be updated in place, false if full rebuild needed.
+ */
+bool cmzn_graphics_add_glyph_update_nodes(cmzn_graphics *graphics,
+	cmzn_fieldmoduleevent *event, FE_region_changes *feRegionChanges,
+	cmzn_field_change_flags fieldChange)
+{
+	if ((CMZN_GRAPHICS_TYPE_POINTS != graphics->graphics_type) ||
+		(fieldChange & (CMZN_FIELD_CHANGE_FLAG_DEFINITION | CMZN_FIELD_CHANGE_FLAG_FULL_RESULT)) ||
+		(CMZN_GRAPHICS_SELECT_MODE_OFF == graphics->select_mode) ||
+		(graphics->label_field) || (graphics->label_density_field))
+		return false;
+	// group membership changes are not in the node change log
+	if ((graphics->subgroup_field) &&
+		(cmzn_fieldmoduleevent_get_field_change_flags(event, graphics->subgroup_field) & CMZN_FIELD_CHANGE_FLAG_RESULT))
+		return false;
+	DsLabelsChangeLog *nodeChangeLog = feRegionChanges->getNodeChangeLog(graphics->domain_type);
+	if ((!nodeChangeLog) || nodeChangeLog->isAllChange() ||
+		(nodeChangeLog->getChangeSummary() & (DS_LABEL_CHANGE_TYPE_ADD | DS_LABEL_CHANGE_TYPE_REMOVE | DS_LABEL_CHANGE_TYPE_IDENTIFIER)))
+		return false;
+	// fields embedded in elements or other nodes may have changed elsewhere
+	DsLabelsChangeLog *otherNodeChangeLog = feRegionChanges->getNodeChangeLog(
+		(CMZN_FIELD_DOMAIN_TYPE_NODES == graphics->domain_type) ? CMZN_FIELD_DOMAIN_TYPE_DATAPOINTS : CMZN_FIELD_DOMAIN_TYPE_NODES);
+	if ((otherNodeChangeLog) && (otherNodeChangeLog->getChangeSummary()))
+		return false;
+	for (int dimension = 1; dimension <= MAXIMUM_ELEMENT_XI_DIMENSIONS; ++dimension)
+	{
+		DsLabelsChangeLog *elementChangeLog = feRegionChanges->getElementChangeLog(dimension);
+		if ((elementChangeLog) && (elementChangeLog->getChangeSummary()))
+			return false;
+	}
+	const DsLabelsGroup *changedNodes = nodeChangeLog->getLabelsGroup();
+	const size_t oldSize = graphics->glyph_update_node_indexes.size();
+	DsLabelIndex nodeIndex = DS_LABEL_INDEX_INVALID;
+	while (changedNodes->incrementIndex(nodeIndex))
+		graphics->glyph_update_node_indexes.push_back(nodeIndex);
+	std::inplace_merge(graphics->glyph_update_node_indexes.begin(),
+		graphics->glyph_update_node_indexes.begin() + oldSize, graphics->glyph_update_node_indexes.end());
+	graphics->glyph_update_node_indexes.erase(std::unique(graphics->glyph_update_node_indexes.begin(),
+		graphics->glyph_update_node_indexes.end()), graphics->glyph_update_node_indexes.end());
+	// too many changes for partial update
+	Graphics_vertex_array *vertexArray = GT_object_get_vertex_set(graphics->graphics_object);
+	if ((!vertexArray) || (graphics->glyph_update_node_indexes.size()*2 >
+		vertexArray->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION)))
+		return false;
+	return true;
+}
+
+/**
+ * Estimates whether partial rebuild of element graphics for the changed
+ * elements is cheaper than full rebuild, in units of evaluating fields at one
+ * vertex. Partial rebuild evaluates only changed and added elements but looks
+ * up every element in the vertex array and uploads all stored vertices
+ * including storage left by removed elements. Full rebuild evaluates every
+ * element and compacts that storage, so is also chosen once half of the stored
+ * vertices are no longer drawn.
+ * @param changeCount  Number of changed elements including added elements.
+ * @param elementCount  Number of elements in mesh after changes.
+ */
+bool cmzn_graphics_is_partial_rebuild_cheaper(cmzn_graphics *graphics,
+	int changeCount, int elementCount)
+{
+	// relative costs of looking up one element and uploading one vertex
+	const double lookupCost = 0.2;
+	const double uploadCost = 0.05;
+	unsigned int primitiveCount, vertexCount, invalidVertexCount;
+	if ((!GT_object_get_vertex_array_primitives_size(graphics->graphics_object,
+			&primitiveCount, &vertexCount, &invalidVertexCount)) ||
+		(0 == primitiveCount) || (invalidVertexCount*2 > vertexCount))
+		return false;
+	const double verticesPerElement = static_cast<double>(vertexCount) / static_cast<double>(primitiveCount);
+	const double partialCost = changeCount*verticesPerElement +
+		(elementCount + primitiveCount)*lookupCost + vertexCount*uploadCost;
+	const double fullCost = elementCount*verticesPerElement*(1.0 + uploadCost);
+	return (partialCost < fullCost);
+}
+
 } // namespace anonymous
 
 int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
@@ -3483,10 +4506,14 @@ int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
 	{
 		if (0 == domainDimension)
 		{
-			// node/data points: currently always rebuilt from scratch
+			// node/data points: glyphs of nodes with changed field values are updated
+			// in place if possible, otherwise rebuilt from scratch
 			if (fieldChange & CMZN_FIELD_CHANGE_FLAG_RESULT)
 			{
-				graphics->setChange(CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+				if (cmzn_graphics_add_glyph_update_nodes(graphics, change_data->event, feRegionChanges, fieldChange))
+					graphics->setChange(CMZN_GRAPHICS_CHANGE_PARTIAL_REBUILD);
+				else
+					graphics->setChange(CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
 				return 1;
 			}
 			// rebuild all if identifiers changed, for correct picking and editing graphics object
@@ -3506,12 +4533,6 @@ int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
 				return 1;
 			}
 			DsLabelsChangeLog *elementChangeLog = feRegionChanges->getElementChangeLog(domainDimension);
-			if (elementChangeLog->getChangeSummary() & DS_LABEL_CHANGE_TYPE_ADD)
-			{
-				// partial rebuild is buggy when new elements are added; workaround is to force full rebuild
-				graphics->setChange(CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
-				return 1;
-			}
 			bool partialUpdate = (0 != (fieldChange & CMZN_FIELD_CHANGE_FLAG_PARTIAL_RESULT));
 			if (!partialUpdate)
 			{
@@ -3519,22 +4540,26 @@ int cmzn_graphics_field_change(struct cmzn_graphics *graphics,
 				// not marked as changed, so need to manually trigger graphics using them to
 				// be updated. However, since renumbering is not common, it's not worth the
 				// complexity of checking such a field is being used, so always partial update.
-				// Also for the future this allows us to send an identifiers all-change
-				// message if reclaimed memory from DsLabels and maps (all indexes changed).
-				if (elementChangeLog->getChangeSummary() & DS_LABEL_CHANGE_TYPE_IDENTIFIER)
+				// This also handles the identifiers all-change message sent when mesh
+				// indexes are compacted to reclaim memory (all indexes changed).
+				// Added elements are appended to the graphics object's vertex arrays.
+				if (elementChangeLog->getChangeSummary() & (DS_LABEL_CHANGE_TYPE_ADD | DS_LABEL_CHANGE_TYPE_IDENTIFIER))
 					partialUpdate = true;
 			}
 			if (partialUpdate)
 			{
 				if (graphics->graphics_type == CMZN_GRAPHICS_TYPE_STREAMLINES ||
-					graphics->graphics_type == CMZN_GRAPHICS_TYPE_POINTS)
+					graphics->graphics_type == CMZN_GRAPHICS_TYPE_POINTS ||
+					((graphics->graphics_type == CMZN_GRAPHICS_TYPE_CONTOURS) && graphics->contours_shared_vertices) ||
+					(cmzn_graphics_get_adaptive_tolerance(graphics) > 0.0))
 				{
 					graphics->setChange(CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
 					return 1;
 				}
 				feRegionChanges->propagateToDimension(domainDimension);
-				if (elementChangeLog->isAllChange() || (elementChangeLog->getChangeCount()*2 >
-					FE_region_find_FE_mesh_by_dimension(graphics->scene->region->get_FE_region(), domainDimension)->getSize()))
+				if (elementChangeLog->isAllChange() || (!cmzn_graphics_is_partial_rebuild_cheaper(graphics,
+					elementChangeLog->getChangeCount(),
+					FE_region_find_FE_mesh_by_dimension(graphics->scene->region->get_FE_region(), domainDimension)->getSize())))
 				{
 					// too many changes for partial rebuild
 					graphics->setChange(CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
@@ -3561,14 +4586,15 @@ int cmzn_graphics_get_visible_graphics_object_range(
 
 	if (graphics && graphics_range && graphics_range->graphics_object_range)
 	{
-		if (graphics->graphics_object &&
+		GT_object *graphics_object = cmzn_graphics_get_graphics_object(graphics);
+		if (graphics_object &&
 			(graphics->coordinate_system == graphics_range->coordinate_system))
 		{
 			if ((0 == graphics_range->filter) ||
 				(cmzn_scenefilter_evaluate_graphics(graphics_range->filter, graphics)))
 			{
-				return_code=get_graphics_object_range(graphics->graphics_object,
-					(void *)graphics_range->graphics_object_range);
+				return_code = GT_object_add_coordinates_range(graphics_object,
+					graphics_range->graphics_object_range);
 			}
 		}
 	}
@@ -3584,6 +4610,21 @@ int cmzn_graphics_get_visible_graphics_object_range(
 	return (return_code);
 } /* cmzn_graphics_get_visible_graphics_object_range */
 
+int cmzn_graphics_add_bounding_box(struct cmzn_graphics *graphics,
+	void *bounding_box_void)
+{
+	cmzn_graphics_bounding_box *bounding_box =
+		static_cast<cmzn_graphics_bounding_box *>(bounding_box_void);
+	GT_object *graphics_object = (graphics) ? cmzn_graphics_get_graphics_object(graphics) : nullptr;
+	if ((graphics_object) && (bounding_box) && (bounding_box->bounded))
+	{
+		if ((graphics->coordinate_system != CMZN_SCENECOORDINATESYSTEM_LOCAL) ||
+			(!GT_object_add_bounding_box(graphics_object, &bounding_box->box)))
+			bounding_box->bounded = false;
+	}
+	return 1;
+}
+
 struct GT_object *cmzn_graphics_get_graphics_object(
 	struct cmzn_graphics *graphics)
 {
@@ -3592,7 +4633,14 @@ struct GT_object *cmzn_graphics_get_graphics_object(
 	ENTER(cmzn_graphics_get_graphics_object);
 	if (graphics)
 	{
-		graphics_object=graphics->graphics_object;
+		// draw the last completely built graphics object while rebuilding, if kept
+		graphics_object = (graphics->previous_graphics_object) ?
+			graphics->previous_graphics_object : graphics->graphics_object;
+		if ((graphics->lod_render_level > 0) &&
+			(graphics->lod_render_level <= static_cast<int>(graphics->lod_levels.size())))
+		{
+			graphics_object = graphics->lod_levels[graphics->lod_render_level - 1].graphics_object;
+		}
 	}
 	else
 	{
@@ -3730,6 +4778,8 @@ int cmzn_graphics_copy_without_graphics_object(
 					source->first_isovalue, source->last_isovalue);
 			}
 			cmzn_graphics_contours_set_decimation_threshold(contours, source->decimation_threshold);
+			cmzn_graphics_contours_set_shared_vertices_flag(contours, source->contours_shared_vertices);
+			cmzn_graphics_contours_set_number_of_threads(contours, source->contours_number_of_threads);
 			cmzn_graphics_contours_destroy(&contours);
 		}
 		else
@@ -3832,14 +4882,21 @@ int cmzn_graphics_copy_without_graphics_object(
 		REACCESS(Computed_field)(&(destination->data_field), source->data_field);
 		REACCESS(cmzn_spectrum)(&(destination->spectrum), source->spectrum);
 		destination->streamlines_colour_data_type = source->streamlines_colour_data_type;
+		destination->streamlines_number_of_threads = source->streamlines_number_of_threads;
+		destination->points_number_of_threads = source->points_number_of_threads;
 		REACCESS(cmzn_material)(&(destination->selected_material),
 			source->selected_material);
 		destination->autorange_spectrum_flag = source->autorange_spectrum_flag;
 		REACCESS(cmzn_font)(&(destination->font), source->font);
 
+		destination->lod_levels_count = source->lod_levels_count;
+		destination->lod_threshold = source->lod_threshold;
+
 		/* ensure destination graphics object is cleared */
 		REACCESS(GT_object)(&(destination->graphics_object),
 			(struct GT_object *)NULL);
+		destination->clearLodLevels();
+		destination->glyph_update_node_indexes.clear();
 		destination->graphics_changed = 1;
 		destination->selected_graphics_changed = 1;
 
@@ -3970,6 +5027,7 @@ int cmzn_graphics_same_non_trivial(cmzn_graphics *graphics,
 			return_code=(graphics->number_of_isovalues==
 				second_graphics->number_of_isovalues)&&
 				(graphics->decimation_threshold==second_graphics->decimation_threshold)&&
+				(graphics->contours_shared_vertices==second_graphics->contours_shared_vertices)&&
 				(graphics->isoscalar_field==second_graphics->isoscalar_field);
 			if (return_code)
 			{
@@ -4333,7 +5391,7 @@ int cmzn_graphics_extract_graphics_object_from_list(
 		(struct LIST(cmzn_graphics) *)list_of_graphics_void))
 	{
 		return_code = 1;
-		if (!(graphics->graphics_object))
+		if (!((graphics->graphics_object) || (graphics->previous_graphics_object)))
 		{
 			if (NULL != (matching_graphics = FIRST_OBJECT_IN_LIST_THAT(cmzn_graphics)(
 				cmzn_graphics_same_non_trivial_with_graphics_object,
@@ -4342,6 +5400,7 @@ int cmzn_graphics_extract_graphics_object_from_list(
 				/* make sure graphics_changed and selected_graphics_changed flags
 					 are brought across */
 				graphics->graphics_object = matching_graphics->graphics_object;
+				graphics->previous_graphics_object = matching_graphics->previous_graphics_object;
 				/* make sure graphics and graphics object have same material and
 					 spectrum */
 				cmzn_graphics_update_graphics_object_trivial(graphics);
@@ -4350,6 +5409,7 @@ int cmzn_graphics_extract_graphics_object_from_list(
 					matching_graphics->selected_graphics_changed;
 				/* reset graphics_object and flags in matching_graphics */
 				matching_graphics->graphics_object = (struct GT_object *)NULL;
+				matching_graphics->previous_graphics_object = (struct GT_object *)NULL;
 				//matching_graphics->setChange(CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
 			}
 		}
@@ -4470,6 +5530,72 @@ int cmzn_graphics_set_tessellation_field(cmzn_graphics_id graphics,
 	return CMZN_ERROR_ARGUMENT;
 }
 
+int cmzn_graphics_get_lod_levels_count(cmzn_graphics_id graphics)
+{
+	if (graphics)
+		return graphics->lod_levels_count;
+	return 0;
+}
+
+int cmzn_graphics_set_lod_levels_count(cmzn_graphics_id graphics,
+	int levelsCount)
+{
+	if ((graphics) && (1 <= levelsCount) && (levelsCount <= 8) &&
+		((1 == levelsCount) || ((graphics->graphics_type != CMZN_GRAPHICS_TYPE_POINTS) &&
+			(graphics->graphics_type != CMZN_GRAPHICS_TYPE_STREAMLINES))))
+	{
+		if (levelsCount != graphics->lod_levels_count)
+		{
+			graphics->lod_levels_count = levelsCount;
+			if (static_cast<int>(graphics->lod_levels.size()) >= levelsCount)
+			{
+				for (int level = static_cast<int>(graphics->lod_levels.size()); level >= levelsCount; --level)
+				{
+					if (graphics->lod_levels[level - 1].graphics_object)
+						DEACCESS(GT_object)(&(graphics->lod_levels[level - 1].graphics_object));
+				}
+				graphics->lod_levels.resize(levelsCount - 1);
+			}
+			graphics->setChange(CMZN_GRAPHICS_CHANGE_REDRAW);
+		}
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+double cmzn_graphics_get_lod_threshold(cmzn_graphics_id graphics)
+{
+	if (graphics)
+		return graphics->lod_threshold;
+	return 0.0;
+}
+
+int cmzn_graphics_set_lod_threshold(cmzn_graphics_id graphics,
+	double threshold)
+{
+	if ((graphics) && (threshold > 0.0))
+	{
+		if (threshold != graphics->lod_threshold)
+		{
+			graphics->lod_threshold = threshold;
+			graphics->setChange(CMZN_GRAPHICS_CHANGE_REDRAW);
+		}
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+double cmzn_graphics_get_adaptive_tolerance(struct cmzn_graphics *graphics)
+{
+	if ((graphics) && (graphics->tessellation) &&
+		((graphics->graphics_type == CMZN_GRAPHICS_TYPE_SURFACES) ||
+			(graphics->graphics_type == CMZN_GRAPHICS_TYPE_CONTOURS)))
+	{
+		return cmzn_tessellation_get_adaptive_tolerance(graphics->tessellation);
+	}
+	return 0.0;
+}
+
 int cmzn_graphics_get_top_level_number_in_xi(struct cmzn_graphics *graphics,
 	int max_dimensions, int *top_level_number_in_xi)
 {
@@ -4507,6 +5633,7 @@ int cmzn_graphics_get_top_level_number_in_xi(struct cmzn_graphics *graphics,
 					delete [] refinement_factors;
 				}
 			}
+			cmzn_graphics_apply_lod_build_level(graphics, max_dimensions, top_level_number_in_xi);
 		}
 	}
 	else
@@ -5565,6 +6692,53 @@ int cmzn_graphics_contours_set_range_isovalues(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+bool cmzn_graphics_contours_get_shared_vertices_flag(
+	cmzn_graphics_contours_id contours)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics_id>(contours);
+	if (graphics)
+		return graphics->contours_shared_vertices;
+	return false;
+}
+
+int cmzn_graphics_contours_set_shared_vertices_flag(
+	cmzn_graphics_contours_id contours, bool shared_vertices_flag)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics_id>(contours);
+	if (graphics)
+	{
+		if (shared_vertices_flag != graphics->contours_shared_vertices)
+		{
+			graphics->contours_shared_vertices = shared_vertices_flag;
+			graphics->setChange(CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
+		}
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_graphics_contours_get_number_of_threads(
+	cmzn_graphics_contours_id contours)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics_id>(contours);
+	if (graphics)
+		return graphics->contours_number_of_threads;
+	return -1;
+}
+
+int cmzn_graphics_contours_set_number_of_threads(
+	cmzn_graphics_contours_id contours, int number_of_threads)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics_id>(contours);
+	if (graphics && (number_of_threads >= 0))
+	{
+		// output is identical for any number of threads so no rebuild needed
+		graphics->contours_number_of_threads = number_of_threads;
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 cmzn_graphics_lines_id cmzn_graphics_cast_lines(cmzn_graphics_id graphics)
 {
 	if (graphics && (graphics->graphics_type == CMZN_GRAPHICS_TYPE_LINES))
@@ -5595,6 +6769,28 @@ int cmzn_graphics_points_destroy(cmzn_graphics_points_id *points_address)
 	return cmzn_graphics_destroy(reinterpret_cast<cmzn_graphics_id *>(points_address));
 }
 
+int cmzn_graphics_points_get_number_of_threads(
+	cmzn_graphics_points_id points)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics_id>(points);
+	if (graphics)
+		return graphics->points_number_of_threads;
+	return -1;
+}
+
+int cmzn_graphics_points_set_number_of_threads(
+	cmzn_graphics_points_id points, int number_of_threads)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics_id>(points);
+	if (graphics && (number_of_threads >= 0))
+	{
+		// output is identical for any number of threads so no rebuild needed
+		graphics->points_number_of_threads = number_of_threads;
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 cmzn_graphics_streamlines_id cmzn_graphics_cast_streamlines(cmzn_graphics_id graphics)
 {
 	if (graphics && (graphics->graphics_type == CMZN_GRAPHICS_TYPE_STREAMLINES))
@@ -5728,6 +6924,28 @@ int cmzn_graphics_streamlines_set_track_length(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+int cmzn_graphics_streamlines_get_number_of_threads(
+	cmzn_graphics_streamlines_id streamlines)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(streamlines);
+	if (graphics)
+		return graphics->streamlines_number_of_threads;
+	return -1;
+}
+
+int cmzn_graphics_streamlines_set_number_of_threads(
+	cmzn_graphics_streamlines_id streamlines, int number_of_threads)
+{
+	cmzn_graphics *graphics = reinterpret_cast<cmzn_graphics *>(streamlines);
+	if (graphics && (number_of_threads >= 0))
+	{
+		// output is identical for any number of threads so no rebuild needed
+		graphics->streamlines_number_of_threads = number_of_threads;
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 cmzn_graphics_surfaces_id cmzn_graphics_cast_surfaces(cmzn_graphics_id graphics)
 {
 	if (graphics && (graphics->graphics_type == CMZN_GRAPHICS_TYPE_SURFACES))
@@ -6538,14 +7756,16 @@ void cmzn_graphics_flag_glyph_has_changed(struct cmzn_graphics *graphics)
 }
 
 int cmzn_graphics_flag_for_full_rebuild(
-	struct cmzn_graphics *graphics,void *dummy_void)
+	struct cmzn_graphics *graphics,void *renderer_void)
 {
 	int return_code;
 
 	if (graphics)
 	{
 		return_code = 1;
-		if (graphics->timeDependent)
+		Render_graphics_compile_members *renderer =
+			static_cast<Render_graphics_compile_members *>(renderer_void);
+		if ((graphics->timeDependent) && !((renderer) && renderer->hasGraphicsObjectAtTime(graphics)))
 		{
 			graphics->setChange(CMZN_GRAPHICS_CHANGE_FULL_REBUILD);
 		}
@@ -6663,6 +7883,9 @@ struct GT_object *cmzn_graphics_copy_graphics_object(struct cmzn_graphics *graph
 				graphics_to_object_data.incrementalBuild = 0;
 				graphics_to_object_data.selectionGroup = graphics->scene->getLocalSelectionGroupForHighlighting();
 				graphics_to_object_data.iso_surface_specification = 0;
+				graphics_to_object_data.iso_surface_elements = 0;
+				graphics_to_object_data.adaptive_discretization = 0;
+				graphics_to_object_data.backgroundBuild = 0;
 				for (int i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
 				{
 					graphics_to_object_data.top_level_number_in_xi[i] = 0;
@@ -10,7 +10,9 @@
 #if !defined (CMZN_GRAPHICS_H)
 #define CMZN_GRAPHICS_H
 
+#include <chrono>
 #include <ctime>
+#include <vector>
 #include "cmlibs/zinc/fieldgroup.h"
 #include "cmlibs/zinc/graphics.h"
 #include "cmlibs/zinc/types/scenefilterid.h"
@@ -18,6 +20,7 @@
 #include "computed_field/computed_field.h"
 #include "finite_element/finite_element.h"
 #include "finite_element/finite_element_to_graphics_object.h"
+#include "finite_element/finite_element_to_iso_surfaces.h"
 #include "graphics/auxiliary_graphics_types.h"
 #include "graphics/element_point_ranges.h"
 #include "graphics/font.h"
@@ -27,6 +30,8 @@
 #include "graphics/material.hpp"
 #include "graphics/spectrum.h"
 
+class FE_mesh_adaptive_discretization;
+class GraphicsBackgroundBuild;
 struct cmzn_graphicspointattributes;
 struct cmzn_graphicslineattributes;
 
@@ -40,6 +45,22 @@ enum cmzn_graphics_change
 	CMZN_GRAPHICS_CHANGE_FULL_REBUILD = 5,    /**< graphics object needs full rebuild */
 };
 
+/**
+ * A coarser level of detail for graphics, with element divisions halved from
+ * the next finer level. Built on demand by the same incremental build as the
+ * main graphics_object.
+ */
+struct cmzn_graphics_lod_level
+{
+	struct GT_object *graphics_object;
+	/* flag indicating the graphics_object is not completely built */
+	int graphics_changed;
+	/* incremental build index for the graphics_object */
+	DsLabelIndex incrementalBuildIndex;
+	/* stamp of last frame this level was drawn in, for evicting least recently used */
+	unsigned int lastUsedStamp;
+};
+
 struct cmzn_graphics
 {
 	struct cmzn_scene *scene;  // scene which owns this graphics
@@ -77,6 +98,10 @@ struct cmzn_graphics
 		first_isovalue to last_isovalue including these values for n>1 */
 	double *isovalues, first_isovalue, last_isovalue,
 		decimation_threshold;
+	/* iso-surfaces: share vertices between elements in an indexed mesh */
+	bool contours_shared_vertices;
+	/* number of threads to sweep elements with for shared vertices, 0 = hardware threads */
+	int contours_number_of_threads;
 
 	/* point attributes */
 	cmzn_glyph *glyph;
@@ -90,6 +115,8 @@ struct cmzn_graphics
 	struct Computed_field *signed_scale_field;
 	struct Computed_field *label_field;
 	struct Computed_field *label_density_field;
+	/* number of threads to build points on nodes with, 0 = hardware threads */
+	int points_number_of_threads;
 
 	// for element sampling: element points, streamlines
 	cmzn_element_point_sampling_mode sampling_mode;
@@ -110,6 +137,8 @@ struct cmzn_graphics
 	enum cmzn_graphics_streamlines_track_direction streamlines_track_direction;
 	FE_value streamline_length;
 	enum cmzn_graphics_streamlines_colour_data_type streamlines_colour_data_type;
+	/* number of threads to track streamlines with, 0 = hardware threads */
+	int streamlines_number_of_threads;
 	/* streamline seed nodeset and field giving mesh location */
 	cmzn_nodeset_id seed_nodeset;
 	struct Computed_field *seed_node_mesh_location_field;
@@ -134,14 +163,33 @@ struct cmzn_graphics
 	/* rendering information */
 	/* the graphics_object generated for this settings */
 	struct GT_object *graphics_object;
+	/* last completely built graphics_object drawn instead while graphics_object
+	 * is rebuilt over several incremental builds, or NULL if none */
+	struct GT_object *previous_graphics_object;
 	/* flag indicating the graphics_object needs rebuilding */
 	int graphics_changed;
 	/* for incremental build: last completed element index to start after (or before first if INVALID) */
 	DsLabelIndex incrementalBuildIndex;
+	/* for partial rebuild of node/data point glyphs: sorted indexes of changed nodes to update in place */
+	std::vector<DsLabelIndex> glyph_update_node_indexes;
 	/* flag indicating that selected graphics have changed */
 	int selected_graphics_changed;
 	/* flag indicating that this settings needs to be regenerated when time changes */
 	bool timeDependent;
+	/* number of levels of detail >= 1; each coarser level halves element divisions */
+	int lod_levels_count;
+	/* projected size in pixels below which coarser levels of detail are drawn */
+	double lod_threshold;
+	/* coarser levels 1..lod_levels_count-1 built on demand; empty until needed */
+	std::vector<cmzn_graphics_lod_level> lod_levels;
+	/* coarser level requested by a renderer to build next, or 0 if none */
+	int lod_requested_level;
+	/* level being built, or 0 for the main graphics_object */
+	int lod_build_level;
+	/* level being compiled or rendered, or 0 for the main graphics_object */
+	int lod_render_level;
+	/* build of a new graphics_object on a background thread, or NULL if none */
+	GraphicsBackgroundBuild *backgroundBuild;
 
 private:
 	int access_count;  // number of references held externally
@@ -243,6 +291,21 @@ public:
 
 	int setBoundaryMode(cmzn_graphics_boundary_mode boundaryModeIn);
 
+	/** Discard all coarser levels of detail built for the graphics. */
+	void clearLodLevels();
+
+	/** Mark coarser levels of detail as needing recompilation, e.g. for selection. */
+	void changedLodLevels();
+
+	/** Discard any previous graphics object kept for drawing while rebuilding. */
+	void clearPreviousGraphicsObject();
+
+	/** Stop and discard any background build of the graphics object. */
+	void cancelBackgroundBuild();
+
+	/** @return  Estimated memory in bytes used by coarser levels of detail. */
+	size_t getLodLevelsMemory() const;
+
 };
 
 struct cmzn_graphics_module;
@@ -276,6 +339,18 @@ struct cmzn_graphics_range
 	enum cmzn_scenecoordinatesystem coordinate_system;
 };
 
+/** Bounding box of graphics accumulated for culling; box only valid if bounded */
+struct cmzn_graphics_bounding_box
+{
+	struct Graphics_object_range_struct box;
+	bool bounded;
+
+	cmzn_graphics_bounding_box() :
+		bounded(true)
+	{
+	}
+};
+
 /**
  * Tracks the time spent building graphics in this increment so it can be stopped
  * when enough time elapses to just keep the client UI responsive. This is used
@@ -288,18 +363,30 @@ private:
 	double buildTimeout; // timeout in seconds for incremental build
 	clock_t startClock; // process clock ticks when this object created
 	clock_t clockLimit; // limit on work to do in incremental build, in clock units
+	std::chrono::steady_clock::time_point startTime; // for waiting on background builds
 	bool moreWorkToDo; // set once increment done, but more work to do i.e. another increment needed
+	bool showPartialGraphics; // if false, draw previously built graphics until rebuild is complete
+	bool buildInBackground; // if true, build graphics on background threads where possible
 
 public:
 
 	/**
 	 * @param buildTimeoutIn  Target duration of incremental build update, in seconds >= 0.0.
+	 * @param showPartialGraphicsIn  True to draw graphics partially built in
+	 * each increment, false to keep drawing the last completely built graphics
+	 * until the rebuild is complete.
+	 * @param buildInBackgroundIn  True to build graphics which support it on
+	 * background threads, waiting up to the build timeout for them to finish.
 	 */
-	GraphicsIncrementalBuild(double buildTimeoutIn = 1.0) :
+	GraphicsIncrementalBuild(double buildTimeoutIn = 1.0, bool showPartialGraphicsIn = true,
+			bool buildInBackgroundIn = false) :
 		buildTimeout(buildTimeoutIn),
 		startClock(clock()),
 		clockLimit(static_cast<clock_t>(buildTimeoutIn*CLOCKS_PER_SEC)),
-		moreWorkToDo(false)
+		startTime(std::chrono::steady_clock::now()),
+		moreWorkToDo(false),
+		showPartialGraphics(showPartialGraphicsIn),
+		buildInBackground(buildInBackgroundIn)
 	{
 		if (buildTimeoutIn < 0.0)
 		{
@@ -336,6 +423,94 @@ public:
 	{
 		this->moreWorkToDo = true;
 	}
+
+	/**
+	 * Query whether partially built graphics are drawn, otherwise the last
+	 * completely built graphics are drawn until rebuilt.
+	 */
+	bool isShowPartialGraphics() const
+	{
+		return this->showPartialGraphics;
+	}
+
+	/**
+	 * Query whether graphics are built on background threads where possible.
+	 */
+	bool isBuildInBackground() const
+	{
+		return this->buildInBackground;
+	}
+
+	/**
+	 * @return  Wall clock time in seconds left until the build timeout, or 0.0
+	 * if expired. Used to limit waiting for background builds.
+	 */
+	double getTimeRemaining() const
+	{
+		const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - this->startTime;
+		const double remaining = this->buildTimeout - elapsed.count();
+		return (remaining > 0.0) ? remaining : 0.0;
+	}
+};
+
+/**
+ * Selects the level of detail for each graphics drawn in a frame from the
+ * projected screen size of its coordinate range, drawing the finest built
+ * level no finer than wanted and requesting the wanted level be built in a
+ * later frame. Kept by a scene viewer over all its frames, remembering every
+ * graphics that wanted coarser levels, so at the end of each frame coarser
+ * levels of all of them are evicted least recently used first until they fit
+ * the memory budget, including those of graphics since drawn at full detail,
+ * culled or no longer drawn.
+ */
+class GraphicsLevelOfDetail
+{
+private:
+	double memoryBudget; // limit on memory used by coarser levels, in bytes
+	unsigned int stamp; // stamp of current frame, increases with each frame
+	std::vector<cmzn_graphics *> graphicsList; // accessed graphics which may hold coarser levels
+	bool moreWorkToDo; // set if any level requested to be built
+
+public:
+
+	GraphicsLevelOfDetail();
+
+	~GraphicsLevelOfDetail();
+
+	/**
+	 * Start selecting levels for a new frame.
+	 * @param memoryBudgetIn  Memory limit for coarser levels of detail, in bytes >= 0.
+	 */
+	void beginFrame(double memoryBudgetIn);
+
+	/**
+	 * Choose the level of detail to draw graphics at, requesting a build of
+	 * the wanted level if not yet built.
+	 * @param graphics  The graphics whose main graphics object is built.
+	 * @param projectionMatrix16  Matrix from graphics coordinates to clip
+	 * coordinates, ordered down columns first, OpenGL style.
+	 * @param viewportWidth  Viewport width in pixels.
+	 * @param viewportHeight  Viewport height in pixels.
+	 * @return  Built level to draw, 0 for the main graphics object.
+	 */
+	int selectLevel(cmzn_graphics *graphics, const double *projectionMatrix16,
+		double viewportWidth, double viewportHeight);
+
+	/**
+	 * Query whether levels of detail were requested so another frame is needed.
+	 */
+	bool isMoreWorkToDo() const
+	{
+		return this->moreWorkToDo;
+	}
+
+	/**
+	 * Discard least recently used coarser levels of all graphics holding them
+	 * until within the memory budget. Levels drawn in this frame are kept even
+	 * if over budget. Graphics no longer in a scene lose all their coarser
+	 * levels, and graphics without coarser levels are forgotten.
+	 */
+	void enforceMemoryBudget();
 };
 
 struct cmzn_graphics_to_graphics_object_data
@@ -366,6 +541,13 @@ struct cmzn_graphics_to_graphics_object_data
 	FE_value *data_copy_buffer;
 
 	struct Iso_surface_specification *iso_surface_specification;
+	/* if set, 3-D elements are added here to build shared iso-surfaces from */
+	std::vector<Iso_surface_element> *iso_surface_elements;
+	/* if set, supplies element discretizations in place of top_level_number_in_xi */
+	FE_mesh_adaptive_discretization *adaptive_discretization;
+	/* if set, building on a background thread with field wrappers, iteration
+	 * domain and discretization prepared by it */
+	GraphicsBackgroundBuild *backgroundBuild;
 	struct cmzn_scenefilter *scenefilter;
 	/* additional values for passing to element_to_graphics_object */
 	struct cmzn_graphics *graphics;
@@ -471,6 +653,41 @@ int cmzn_graphics_selects_cad_primitives(struct cmzn_graphics *graphics);
 int cmzn_graphics_to_graphics_object(
 	struct cmzn_graphics *graphics,void *graphics_to_object_data_void);
 
+/**
+ * Starts the background build of the graphics object prepared while building
+ * graphics, if any. Called once the region is no longer caching changes, as
+ * the region is frozen for the duration of the build. If the region cannot be
+ * frozen the graphics object is built immediately instead.
+ * @param graphics  The graphics to start building.
+ * @param dummy_void  Unused.
+ * @return  1 always.
+ */
+int cmzn_graphics_start_background_build(
+	struct cmzn_graphics *graphics, void *dummy_void);
+
+/**
+ * Builds new graphics objects for the graphics at each of the times, each
+ * from its own copy of the graphics with its own field cache at that time.
+ * Builds run concurrently on separate threads while the region is frozen, in
+ * batches of up to the number of threads. The graphics object of the graphics
+ * itself is unchanged. Only supported for lines, surfaces and contours on
+ * elements without adaptive tessellation or fields depending on time value
+ * fields, which evaluate the timekeeper time.
+ * @param graphics  The graphics to build. Must be in a scene.
+ * @param name_prefix  Prefix for graphics object names.
+ * @param timesCount  Number of times to build at > 0.
+ * @param times  Array of timesCount times to build at.
+ * @param threadsCount  Maximum number of concurrent builds, or 0 for the
+ * number of threads in the context thread pool.
+ * @param graphicsObjectsOut  On success filled with accessed graphics objects
+ * in the order of times, otherwise cleared.
+ * @return  CMZN_OK on success, CMZN_ERROR_NOT_IMPLEMENTED if graphics cannot
+ * be built concurrently, otherwise any other error.
+ */
+int cmzn_graphics_build_graphics_objects_at_times(struct cmzn_graphics *graphics,
+	const char *name_prefix, int timesCount, const FE_value *times, int threadsCount,
+	std::vector<GT_object *>& graphicsObjectsOut);
+
 /***************************************************************************//**
  * If the settings visibility flag is set and it has a graphics_object, the
  * graphics_object is compiled.
@@ -495,9 +712,34 @@ int cmzn_graphics_execute_visible_graphics(
 int cmzn_graphics_get_visible_graphics_object_range(
 	struct cmzn_graphics *graphics,void *graphics_range_void);
 
+/**
+ * Adds the bounding box of the graphics' object to the bounding box of its
+ * scene in local coordinates. Graphics in other coordinate systems, or which
+ * cannot be bounded, make the scene box unbounded.
+ * Graphics are included whether visible or not, and without building them.
+ * @param bounding_box_void  Void pointer to struct cmzn_graphics_bounding_box.
+ * @return  1 always.
+ */
+int cmzn_graphics_add_bounding_box(struct cmzn_graphics *graphics,
+	void *bounding_box_void);
+
+/**
+ * Get the graphics object to compile and draw for the graphics: the level of
+ * detail being rendered if set, otherwise any previous graphics object kept
+ * while rebuilding, otherwise the current graphics object.
+ * @return  Non-accessed graphics object or NULL if none.
+ */
 struct GT_object *cmzn_graphics_get_graphics_object(
 	struct cmzn_graphics *graphics);
 
+/**
+ * Get adaptive tolerance of the graphics' tessellation if it applies to the
+ * graphics type, currently only surfaces and contours.
+ *
+ * @return  Adaptive tolerance > 0.0, or 0.0 if not adaptive.
+ */
+double cmzn_graphics_get_adaptive_tolerance(struct cmzn_graphics *graphics);
+
 /**
  * Fills the top_level_number_in_xi array with the discretization computed for
  * the graphics taking into account the tessellation and non-linearity of the
@@ -728,8 +970,13 @@ int cmzn_graphics_set_renderer_highlight_functor(struct cmzn_graphics *graphics,
 int cmzn_graphics_remove_renderer_highlight_functor(struct cmzn_graphics *graphics,
 	void *renderer_void);
 
+/**
+ * Flags time dependent graphics for full rebuild, except those whose graphics
+ * object at the renderer's time is supplied by the renderer.
+ * @param renderer_void  Render_graphics_compile_members, or NULL.
+ */
 int cmzn_graphics_flag_for_full_rebuild(
-	struct cmzn_graphics *graphics,void *dummy_void);
+	struct cmzn_graphics *graphics,void *renderer_void);
 
 enum GT_object_type cmzn_graphics_get_graphics_object_type(struct cmzn_graphics *graphics);
 
@@ -88,6 +88,23 @@ int has_current_context()
 	return 0;
 }
 
+void *get_current_context()
+{
+#if defined (WIN32)
+	return (void *)wglGetCurrentContext();
+#elif defined (UNIX)
+#  if defined (DARWIN)
+	return (void *)CGLGetCurrentContext();
+#  elif defined (GLEW_OSMESA)
+	return (void *)OSMesaGetCurrentContext();
+#  else
+	return (void *)glXGetCurrentContext();
+#  endif
+#else
+	return NULL;
+#endif
+}
+
 int initialize_graphics_library()
 /*******************************************************************************
 LAST MODIFIED : 23 February 2004
@@ -1082,6 +1099,46 @@ appropriately.
 			}
 		}
 #endif /* GL_VERSION_3_0 */
+#if defined GL_VERSION_3_3
+		else if (!strcmp(extension_name, "GL_VERSION_3_3"))
+		{
+			if (GLEXTENSION_UNSURE != GLEXTENSIONFLAG(GL_VERSION_3_3))
+			{
+				return_code = GLEXTENSIONFLAG(GL_VERSION_3_3);
+			}
+			else
+			{
+				return_code = Graphics_library_query_environment_extension(extension_name);
+				if (GLEXTENSION_UNSURE == return_code)
+				{
+					return_code = query_gl_version(3, 3);
+					if (GLEXTENSION_AVAILABLE == return_code)
+					{
+						if (!((GRAPHICS_LIBRARY_ASSIGN_HANDLE(glBindAttribLocation, PFNGLBINDATTRIBLOCATIONPROC)
+									Graphics_library_get_function_ptr("glBindAttribLocation")) &&
+								(GRAPHICS_LIBRARY_ASSIGN_HANDLE(glDisableVertexAttribArray, PFNGLDISABLEVERTEXATTRIBARRAYPROC)
+									Graphics_library_get_function_ptr("glDisableVertexAttribArray")) &&
+								(GRAPHICS_LIBRARY_ASSIGN_HANDLE(glDrawArraysInstanced, PFNGLDRAWARRAYSINSTANCEDPROC)
+									Graphics_library_get_function_ptr("glDrawArraysInstanced")) &&
+								(GRAPHICS_LIBRARY_ASSIGN_HANDLE(glDrawElementsInstanced, PFNGLDRAWELEMENTSINSTANCEDPROC)
+									Graphics_library_get_function_ptr("glDrawElementsInstanced")) &&
+								(GRAPHICS_LIBRARY_ASSIGN_HANDLE(glEnableVertexAttribArray, PFNGLENABLEVERTEXATTRIBARRAYPROC)
+									Graphics_library_get_function_ptr("glEnableVertexAttribArray")) &&
+								(GRAPHICS_LIBRARY_ASSIGN_HANDLE(glUniform3fv, PFNGLUNIFORM3FVPROC)
+									Graphics_library_get_function_ptr("glUniform3fv")) &&
+								(GRAPHICS_LIBRARY_ASSIGN_HANDLE(glVertexAttribDivisor, PFNGLVERTEXATTRIBDIVISORPROC)
+									Graphics_library_get_function_ptr("glVertexAttribDivisor")) &&
+								(GRAPHICS_LIBRARY_ASSIGN_HANDLE(glVertexAttribPointer, PFNGLVERTEXATTRIBPOINTERPROC)
+									Graphics_library_get_function_ptr("glVertexAttribPointer"))))
+						{
+							return_code = GLEXTENSION_UNAVAILABLE;
+						}
+					}
+				}
+				GLEXTENSIONFLAG(GL_VERSION_3_3) = return_code;
+			}
+		}
+#endif /* GL_VERSION_3_3 */
 #if defined GL_ARB_depth_texture
 		else if (!strcmp(extension_name, "GL_ARB_depth_texture"))
 		{
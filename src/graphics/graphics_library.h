@@ -85,6 +85,11 @@ Global functions
 
 int has_current_context();
 
+/**
+ * @return  Handle identifying the current OpenGL context, or NULL if none.
+ */
+void *get_current_context();
+
 int open_graphics_library(void);
 /*******************************************************************************
 LAST MODIFIED : 23 March 1993
@@ -332,6 +337,9 @@ yet we just don't know.
 #if defined (GL_VERSION_3_0)
   GRAPHICS_LIBRARY_INITIALISE_GLEXTENSIONFLAG(GL_VERSION_3_0);
 #endif /* defined (GL_VERSION_3_0) */
+#if defined (GL_VERSION_3_3)
+  GRAPHICS_LIBRARY_INITIALISE_GLEXTENSIONFLAG(GL_VERSION_3_3);
+#endif /* defined (GL_VERSION_3_3) */
 #if defined (GL_ARB_depth_texture)
   GRAPHICS_LIBRARY_INITIALISE_GLEXTENSIONFLAG(GL_ARB_depth_texture);
 #endif /* defined (GL_ARB_depth_texture) */
@@ -491,6 +499,25 @@ GRAPHICS_LIBRARY_INITIALISE_GLEXTENSIONFLAG(GL_display_lists);
 #      define glGenerateMipmap (GLHANDLE(glGenerateMipmap))
 #    endif /* defined (GL_VERSION_3_0) */
 
+#    if defined (GL_VERSION_3_3)
+	   GRAPHICS_LIBRARY_EXTERN PFNGLBINDATTRIBLOCATIONPROC GLHANDLE(glBindAttribLocation);
+#      define glBindAttribLocation (GLHANDLE(glBindAttribLocation))
+	   GRAPHICS_LIBRARY_EXTERN PFNGLDISABLEVERTEXATTRIBARRAYPROC GLHANDLE(glDisableVertexAttribArray);
+#      define glDisableVertexAttribArray (GLHANDLE(glDisableVertexAttribArray))
+	   GRAPHICS_LIBRARY_EXTERN PFNGLDRAWARRAYSINSTANCEDPROC GLHANDLE(glDrawArraysInstanced);
+#      define glDrawArraysInstanced (GLHANDLE(glDrawArraysInstanced))
+	   GRAPHICS_LIBRARY_EXTERN PFNGLDRAWELEMENTSINSTANCEDPROC GLHANDLE(glDrawElementsInstanced);
+#      define glDrawElementsInstanced (GLHANDLE(glDrawElementsInstanced))
+	   GRAPHICS_LIBRARY_EXTERN PFNGLENABLEVERTEXATTRIBARRAYPROC GLHANDLE(glEnableVertexAttribArray);
+#      define glEnableVertexAttribArray (GLHANDLE(glEnableVertexAttribArray))
+	   GRAPHICS_LIBRARY_EXTERN PFNGLUNIFORM3FVPROC GLHANDLE(glUniform3fv);
+#      define glUniform3fv (GLHANDLE(glUniform3fv))
+	   GRAPHICS_LIBRARY_EXTERN PFNGLVERTEXATTRIBDIVISORPROC GLHANDLE(glVertexAttribDivisor);
+#      define glVertexAttribDivisor (GLHANDLE(glVertexAttribDivisor))
+	   GRAPHICS_LIBRARY_EXTERN PFNGLVERTEXATTRIBPOINTERPROC GLHANDLE(glVertexAttribPointer);
+#      define glVertexAttribPointer (GLHANDLE(glVertexAttribPointer))
+#    endif /* defined (GL_VERSION_3_3) */
+
 #    if defined (GL_ARB_vertex_program) || defined (GL_ARB_fragment_program)
 	   GRAPHICS_LIBRARY_EXTERN PFNGLGENPROGRAMSARBPROC GLHANDLE(glGenProgramsARB);
 #      define glGenProgramsARB (GLHANDLE(glGenProgramsARB))
@@ -1116,12 +1116,21 @@ struct GT_object *CREATE(GT_object)(const char *name,enum GT_object_type object_
 				object->display_list = 0;
 				object->position_vertex_buffer_object = 0;
 				object->position_values_per_vertex = 0;
+				object->position_vertex_buffer_count = 0;
 				object->colour_vertex_buffer_object = 0;
 				object->colour_values_per_vertex = 0;
+				object->spectrum_data_vertex_buffer_object = 0;
+				object->spectrum_data_values_per_vertex = 0;
 				object->normal_vertex_buffer_object = 0;
+				object->normal_vertex_buffer_count = 0;
 				object->texture_coordinate0_vertex_buffer_object = 0;
+				object->texture_coordinate0_values_per_vertex = 0;
+				object->texture_coordinate0_vertex_buffer_count = 0;
 				object->tangent_vertex_buffer_object = 0;
+				object->tangent_values_per_vertex = 0;
+				object->tangent_vertex_buffer_count = 0;
 				object->index_vertex_buffer_object = 0;
+				object->glyph_axes_vertex_buffer_object = 0;
 				object->vertex_array_object = 0;
 				object->multipass_width = 0;
 				object->multipass_height = 0;
@@ -1130,6 +1139,10 @@ struct GT_object *CREATE(GT_object)(const char *name,enum GT_object_type object_
 				object->multipass_frame_buffer_texture = 0;
 #endif /* defined (OPENGL_API) */
 				object->compile_status = GRAPHICS_NOT_COMPILED;
+				object->ranges_valid = false;
+				object->bounding_box_bounded = false;
+				object->coordinates_range = Graphics_object_range_struct();
+				object->bounding_box = Graphics_object_range_struct();
 				object->object_type=object_type;
 				if (default_material)
 				{
@@ -1245,6 +1258,10 @@ static int DESTROY(GT_object)(struct GT_object **object_ptr)
 			{
 				glDeleteBuffers(1, &object->colour_vertex_buffer_object);
 			}
+			if (object->spectrum_data_vertex_buffer_object)
+			{
+				glDeleteBuffers(1, &object->spectrum_data_vertex_buffer_object);
+			}
 			if (object->normal_vertex_buffer_object)
 			{
 				glDeleteBuffers(1, &object->normal_vertex_buffer_object);
@@ -1261,6 +1278,10 @@ static int DESTROY(GT_object)(struct GT_object **object_ptr)
 			{
 				glDeleteBuffers(1, &object->index_vertex_buffer_object);
 			}
+			if (object->glyph_axes_vertex_buffer_object)
+			{
+				glDeleteBuffers(1, &object->glyph_axes_vertex_buffer_object);
+			}
 			if (object->multipass_vertex_buffer_object)
 			{
 				glDeleteBuffers(1, &object->multipass_vertex_buffer_object);
@@ -1313,6 +1334,7 @@ void GT_object_changed(struct GT_object *graphics_object)
 	while (graphics_object)
 	{
 		graphics_object->compile_status = GRAPHICS_NOT_COMPILED;
+		graphics_object->ranges_valid = false;
 		graphics_object = graphics_object->nextobject;
 	}
 }
@@ -1761,6 +1783,187 @@ will produce the range of all the graphics objects.
 	return (return_code);
 } /* get_graphics_object_range */
 
+namespace {
+
+/**
+ * Adds conservative bounding box of a single graphics object, not including
+ * its linked next objects, to bounding_box.
+ * @return  True if bounded, false if not.
+ */
+bool GT_object_add_single_bounding_box(struct GT_object *graphics_object,
+	struct Graphics_object_range_struct *bounding_box)
+{
+	Graphics_vertex_array *vertex_array = graphics_object->vertex_array;
+	if (!vertex_array)
+		return false;
+	std::string *label_buffer = 0;
+	unsigned int label_per_vertex = 0, label_count = 0;
+	vertex_array->get_string_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_LABEL,
+		&label_buffer, &label_per_vertex, &label_count);
+	if (label_buffer)
+		return false; // labels are drawn at a fixed size on screen
+	switch (graphics_object->object_type)
+	{
+	case g_SURFACE_VERTEX_BUFFERS:
+	case g_POLYLINE_VERTEX_BUFFERS:
+		return (0 != get_graphics_object_range(graphics_object, bounding_box));
+		break;
+	case g_POINT_SET_VERTEX_BUFFERS:
+	{
+		GLfloat *position_buffer = 0;
+		unsigned int position_values_per_vertex = 0, position_vertex_count = 0;
+		vertex_array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+			&position_buffer, &position_values_per_vertex, &position_vertex_count);
+		for (int j = 0; j < graphics_object->number_of_times; ++j)
+		{
+			const GLfloat marker_size = static_cast<GLfloat>(
+				graphics_object->primitive_lists[j].gt_pointset_vertex_buffers->marker_size);
+			const GLfloat *position = position_buffer;
+			for (unsigned int i = 0; i < position_vertex_count; ++i)
+			{
+				Triple minimum = { 0.0, 0.0, 0.0 }, maximum = { 0.0, 0.0, 0.0 };
+				for (unsigned int k = 0; (k < position_values_per_vertex) && (k < 3); ++k)
+				{
+					minimum[k] = position[k] - marker_size;
+					maximum[k] = position[k] + marker_size;
+				}
+				bounding_box->addPoint(minimum);
+				bounding_box->addPoint(maximum);
+				position += position_values_per_vertex;
+			}
+		}
+	} break;
+	case g_GLYPH_SET_VERTEX_BUFFERS:
+	{
+		GLfloat *label_bound_buffer = 0;
+		unsigned int label_bounds_per_vertex = 0, label_bounds_count = 0;
+		vertex_array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_LABEL_BOUND,
+			&label_bound_buffer, &label_bounds_per_vertex, &label_bounds_count);
+		if (label_bound_buffer)
+			return false;
+		unsigned int position_values_per_vertex = 0, position_vertex_count = 0,
+			axis1_values_per_vertex = 0, axis1_vertex_count = 0,
+			axis2_values_per_vertex = 0, axis2_vertex_count = 0,
+			axis3_values_per_vertex = 0, axis3_vertex_count = 0,
+			scale_values_per_vertex = 0, scale_vertex_count = 0;
+		GLfloat *position_buffer = 0, *axis1_buffer = 0,
+			*axis2_buffer = 0, *axis3_buffer = 0, *scale_buffer = 0;
+		vertex_array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION,
+			&position_buffer, &position_values_per_vertex, &position_vertex_count);
+		vertex_array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS1,
+			&axis1_buffer, &axis1_values_per_vertex, &axis1_vertex_count);
+		vertex_array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS2,
+			&axis2_buffer, &axis2_values_per_vertex, &axis2_vertex_count);
+		vertex_array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS3,
+			&axis3_buffer, &axis3_values_per_vertex, &axis3_vertex_count);
+		vertex_array->get_float_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_SCALE,
+			&scale_buffer, &scale_values_per_vertex, &scale_vertex_count);
+		if ((0 < position_vertex_count) && !(axis1_buffer && axis2_buffer && axis3_buffer && scale_buffer))
+			return false;
+		for (int j = 0; j < graphics_object->number_of_times; ++j)
+		{
+			struct GT_glyphset_vertex_buffers *glyphset =
+				graphics_object->primitive_lists[j].gt_glyphset_vertex_buffers;
+			if (glyphset->static_label_text[0] || glyphset->static_label_text[1] ||
+				glyphset->static_label_text[2])
+				return false;
+			if (!glyphset->glyph)
+				continue;
+			// box of glyph in its own coordinates, mapped by the axes of each glyph
+			Graphics_object_range_struct glyph_box;
+			if (!GT_object_add_bounding_box(glyphset->glyph, &glyph_box))
+				return false;
+			if (glyph_box.first)
+				continue;
+			const int number_of_glyphs =
+				cmzn_glyph_repeat_mode_get_number_of_glyphs(glyphset->glyph_repeat_mode);
+			GLfloat *position = position_buffer, *axis1 = axis1_buffer, *axis2 = axis2_buffer,
+				*axis3 = axis3_buffer, *scale = scale_buffer;
+			Triple point, final_axes[3], minimum, maximum;
+			for (unsigned int i = 0; i < position_vertex_count; ++i)
+			{
+				for (int glyph_number = 0; glyph_number < number_of_glyphs; ++glyph_number)
+				{
+					resolve_glyph_axes(glyphset->glyph_repeat_mode, glyph_number,
+						glyphset->base_size, glyphset->scale_factors, glyphset->offset,
+						position, axis1, axis2, axis3, scale,
+						point, final_axes[0], final_axes[1], final_axes[2]);
+					for (int k = 0; k < 3; ++k)
+					{
+						minimum[k] = maximum[k] = point[k];
+						for (int a = 0; a < 3; ++a)
+						{
+							const GLfloat value1 = final_axes[a][k]*glyph_box.minimum[a];
+							const GLfloat value2 = final_axes[a][k]*glyph_box.maximum[a];
+							minimum[k] += (value1 < value2) ? value1 : value2;
+							maximum[k] += (value1 < value2) ? value2 : value1;
+						}
+					}
+					bounding_box->addPoint(minimum);
+					bounding_box->addPoint(maximum);
+				}
+				position += position_values_per_vertex;
+				axis1 += axis1_values_per_vertex;
+				axis2 += axis2_values_per_vertex;
+				axis3 += axis3_values_per_vertex;
+				scale += scale_values_per_vertex;
+			}
+		}
+	} break;
+	default:
+		return false;
+		break;
+	}
+	return true;
+}
+
+/** Recalculate cached coordinates range and bounding box if changed. */
+void GT_object_update_ranges(struct GT_object *graphics_object)
+{
+	if (!graphics_object->ranges_valid)
+	{
+		graphics_object->coordinates_range = Graphics_object_range_struct();
+		get_graphics_object_range(graphics_object, &graphics_object->coordinates_range);
+		graphics_object->bounding_box = Graphics_object_range_struct();
+		graphics_object->bounding_box_bounded = (!graphics_object->glyph_labels_function) &&
+			GT_object_add_single_bounding_box(graphics_object, &graphics_object->bounding_box);
+		graphics_object->ranges_valid = true;
+	}
+}
+
+}
+
+int GT_object_add_coordinates_range(struct GT_object *graphics_object,
+	struct Graphics_object_range_struct *graphics_object_range)
+{
+	if (!((graphics_object) && (graphics_object_range)))
+	{
+		display_message(ERROR_MESSAGE, "GT_object_add_coordinates_range.  Invalid argument(s)");
+		return 0;
+	}
+	GT_object_update_ranges(graphics_object);
+	graphics_object_range->addRange(graphics_object->coordinates_range);
+	return 1;
+}
+
+bool GT_object_add_bounding_box(struct GT_object *graphics_object,
+	struct Graphics_object_range_struct *bounding_box)
+{
+	if (!((graphics_object) && (bounding_box)))
+	{
+		display_message(ERROR_MESSAGE, "GT_object_add_bounding_box.  Invalid argument(s)");
+		return false;
+	}
+	for (GT_object *object = graphics_object; object; object = object->nextobject)
+	{
+		GT_object_update_ranges(object);
+		if (!object->bounding_box_bounded)
+			return false;
+		bounding_box->addRange(object->bounding_box);
+	}
+	return true;
+}
+
 int get_graphics_object_data_range(struct GT_object *graphics_object,
 	Graphics_object_data_range *range)
 {
@@ -2079,7 +2282,10 @@ int GT_OBJECT_ADD(GT_pointset_vertex_buffers)(
 void GT_object_reset_buffer_binding(struct GT_object *graphics_object)
 {
 	if (graphics_object)
+	{
 		graphics_object->buffer_binding = 1;
+		graphics_object->ranges_valid = false;
+	}
 }
 
 #define DECLARE_GT_OBJECT_GET_FUNCTION(primitive_type, \
@@ -2166,6 +2372,33 @@ int GT_object_invalidate_selected_primitives(struct GT_object *graphics_object,
 	return 0;
 }
 
+int GT_object_get_vertex_array_primitives_size(struct GT_object *graphics_object,
+	unsigned int *primitiveCount, unsigned int *vertexCount,
+	unsigned int *invalidVertexCount)
+{
+	if (!((graphics_object) && (graphics_object->vertex_array) && (primitiveCount) &&
+		(vertexCount) && (invalidVertexCount)))
+		return 0;
+	Graphics_vertex_array *array = graphics_object->vertex_array;
+	int *object_names = 0;
+	unsigned int values_per_vertex = 0;
+	*primitiveCount = 0;
+	*vertexCount = array->get_number_of_vertices(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_POSITION);
+	*invalidVertexCount = 0;
+	if (!(array->get_integer_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_OBJECT_ID,
+		&object_names, &values_per_vertex, primitiveCount) && (object_names)))
+		return 0;
+	unsigned int *index_counts = 0, index_counts_count = 0;
+	array->get_unsigned_integer_vertex_buffer(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+		&index_counts, &values_per_vertex, &index_counts_count);
+	for (unsigned int i = 0; i < *primitiveCount; ++i)
+	{
+		if ((object_names[i] < 0) && (index_counts) && (i < index_counts_count))
+			*invalidVertexCount += index_counts[i];
+	}
+	return 1;
+}
+
 int GT_object_clear_primitives(struct GT_object *graphics_object)
 {
 	if (graphics_object)
@@ -180,6 +180,37 @@ struct Graphics_object_range_struct
 		for (int i = 0; i < 3; ++i)
 			this->maximum[i] = this->minimum[i] = 0.0;
 	}
+
+	/** Expand range to include point */
+	void addPoint(const GLfloat *point)
+	{
+		if (this->first)
+		{
+			for (int i = 0; i < 3; ++i)
+				this->maximum[i] = this->minimum[i] = point[i];
+			this->first = 0;
+		}
+		else
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				if (point[i] < this->minimum[i])
+					this->minimum[i] = point[i];
+				else if (point[i] > this->maximum[i])
+					this->maximum[i] = point[i];
+			}
+		}
+	}
+
+	/** Expand range to include source range, if valid */
+	void addRange(const Graphics_object_range_struct& source)
+	{
+		if (!source.first)
+		{
+			this->addPoint(source.minimum);
+			this->addPoint(source.maximum);
+		}
+	}
 };
 
 /**
@@ -393,6 +424,26 @@ struct GT_object *CREATE(GT_object)(const char *name,enum GT_object_type object_
  */
 void GT_object_changed(struct GT_object *graphics_object);
 
+/**
+ * Adds the range of coordinates in the graphics object, as from
+ * get_graphics_object_range, to graphics_object_range. The range is cached
+ * and only recalculated after the graphics object has changed.
+ * @return  1 on success, 0 on failure.
+ */
+int GT_object_add_coordinates_range(struct GT_object *graphics_object,
+	struct Graphics_object_range_struct *graphics_object_range);
+
+/**
+ * Adds a conservative bounding box of everything drawn for the graphics object
+ * and its linked next objects to bounding_box. Unlike the coordinates range
+ * this includes the extents of glyphs and marker sizes. The box is cached and
+ * only recalculated after the graphics object has changed.
+ * @return  True if the box is bounded, false if it cannot be bounded in model
+ * coordinates e.g. for labels drawn at a fixed size on screen, or on failure.
+ */
+bool GT_object_add_bounding_box(struct GT_object *graphics_object,
+	struct Graphics_object_range_struct *bounding_box);
+
 int GT_object_Graphical_material_change(struct GT_object *graphics_object,
 	struct LIST(cmzn_material) *changed_material_list);
 /*******************************************************************************
@@ -567,6 +618,21 @@ typedef int (GT_object_primitive_object_name_conditional_function) \
 int GT_object_invalidate_selected_primitives(struct GT_object *graphics_object,
 	DsLabelsChangeLog *changeLog);
 
+/**
+ * Get sizes of the element primitives stored in the vertex array of the
+ * graphics object, for estimating the cost of partial versus full rebuild.
+ * Primitives with an invalid object name are those of removed or changed
+ * objects awaiting rebuild, and storage abandoned for appended primitives.
+ * @param primitiveCount  On return, number of primitives with object names.
+ * @param vertexCount  On return, number of position vertices stored.
+ * @param invalidVertexCount  On return, number of vertices in primitives with
+ * invalid object names.
+ * @return  1 on success, 0 if no vertex array or no object names stored.
+ */
+int GT_object_get_vertex_array_primitives_size(struct GT_object *graphics_object,
+	unsigned int *primitiveCount, unsigned int *vertexCount,
+	unsigned int *invalidVertexCount);
+
 /**
  * Clears all primitives and vertext arrays from graphics object.
  */
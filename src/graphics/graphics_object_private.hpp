@@ -156,15 +156,31 @@ Graphical object data structure.
 
 	GLuint position_vertex_buffer_object;
 	GLuint position_values_per_vertex;
+	/* number of vertices allocated in position_vertex_buffer_object, which
+	 * partial redraws must not exceed */
+	GLuint position_vertex_buffer_count;
 	GLuint colour_vertex_buffer_object;
 	GLuint colour_values_per_vertex;
+	/* per-vertex data used as texture coordinates to look up spectrum colours
+	 * from a texture, used instead of colour_vertex_buffer_object */
+	GLuint spectrum_data_vertex_buffer_object;
+	GLuint spectrum_data_values_per_vertex;
 	GLuint normal_vertex_buffer_object;
+	/* number of vertices allocated in normal_vertex_buffer_object */
+	GLuint normal_vertex_buffer_count;
 	GLuint texture_coordinate0_vertex_buffer_object;
 	GLuint texture_coordinate0_values_per_vertex;
+	/* number of vertices allocated in texture_coordinate0_vertex_buffer_object */
+	GLuint texture_coordinate0_vertex_buffer_count;
 	/* tangent buffer will be passed in as coordinates of texture unit 1*/
 	GLuint tangent_vertex_buffer_object;
 	GLuint tangent_values_per_vertex;
+	/* number of vertices allocated in tangent_vertex_buffer_object */
+	GLuint tangent_vertex_buffer_count;
 	GLuint index_vertex_buffer_object;
+	/* glyph set axis1, axis2, axis3 and scale arrays for instanced rendering,
+	 * stored consecutively with position_vertex_buffer_count values each */
+	GLuint glyph_axes_vertex_buffer_object;
 	/* For multipass rendering we use some more vertex_buffers
 	 * a framebuffer and a texture. */
 	unsigned int multipass_width;
@@ -175,6 +191,11 @@ Graphical object data structure.
 #endif /* defined (OPENGL_API) */
 	/* enumeration indicates whether the graphics display list is up to date */
 	enum Graphics_compile_status compile_status;
+	/* cached coordinates range and bounding box, recalculated when ranges_valid
+	 * is cleared by any change to the graphics object */
+	bool ranges_valid;
+	bool bounding_box_bounded;
+	struct Graphics_object_range_struct coordinates_range, bounding_box;
 
 	/* Custom per compile code for graphics_objects used as glyphs. */
 	Graphics_object_glyph_labels_function glyph_labels_function;
@@ -140,9 +140,12 @@ public:
 	/* fast search map for locating id for quick modification,
 	 * this is implemented as multimap for graphics type that have varying number of primitives */
 	Fast_search_id_map id_map;
+	/* number of locations added with fast search ids, including removed ones */
+	int fast_search_location_count;
 
 	Graphics_vertex_array_internal(Graphics_vertex_array_type type)
-		: type(type)
+		: type(type),
+		fast_search_location_count(0)
 	{
 		buffer_list = CREATE(LIST(Graphics_vertex_buffer))();
 	}
@@ -171,6 +174,8 @@ public:
 	int get_all_fast_search_id_locations(int target_id,
 		int *number_of_locations, int **locations);
 
+	int remove_fast_search_id_location(int target_id, int location);
+
 	/** Gets the buffer appropriate for storing this vertex data or
 	* creates one in this array if it doesn't already exist.
 	* If it does exist but the value_per_vertex does not match then
@@ -233,8 +238,8 @@ Graphics_vertex_array::Graphics_vertex_array(Graphics_vertex_array_type type)
 
 int Graphics_vertex_array_internal::add_fast_search_id(int object_id)
 {
-	const int current_location = static_cast<int>(id_map.size());
-	id_map.insert(std::make_pair(object_id, current_location));
+	id_map.insert(std::make_pair(object_id, fast_search_location_count));
+	++fast_search_location_count;
 	return 1;
 }
 
@@ -268,6 +273,20 @@ int Graphics_vertex_array_internal::get_all_fast_search_id_locations(int target_
 	return 1;
 }
 
+int Graphics_vertex_array_internal::remove_fast_search_id_location(int target_id, int location)
+{
+	Fast_search_id_map::iterator pos;
+	for (pos = id_map.lower_bound(target_id); pos != id_map.upper_bound(target_id); ++pos)
+	{
+		if (pos->second == location)
+		{
+			id_map.erase(pos);
+			return 1;
+		}
+	}
+	return 0;
+}
+
 Graphics_vertex_string_buffer *Graphics_vertex_array_internal::get_or_create_string_buffer(
 	Graphics_vertex_array_attribute_type vertex_type,
 	unsigned int values_per_vertex)
@@ -920,9 +939,17 @@ int Graphics_vertex_array::get_all_fast_search_id_locations(int target_id,
 	return internal->get_all_fast_search_id_locations(target_id, number_of_locations, locations);
 }
 
+int Graphics_vertex_array::remove_fast_search_id_location(int target_id, int location)
+{
+	return internal->remove_fast_search_id_location(target_id, location);
+}
+
 int Graphics_vertex_array::clear_buffers()
 {
 	internal->clear_string_buffer();
+	// locations of fast search ids are no longer valid
+	internal->id_map.clear();
+	internal->fast_search_location_count = 0;
 	return FOR_EACH_OBJECT_IN_LIST(Graphics_vertex_buffer)(
 		Graphics_vertex_buffer_clear, NULL, internal->buffer_list);
 }
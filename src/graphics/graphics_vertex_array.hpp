@@ -295,9 +295,9 @@ public:
 	int free_unused_buffer_memory( Graphics_vertex_array_attribute_type vertex_type );
 
 	/*****************************************************************************//**
-	 * Resets the sizes of all the buffers in the set.  Does not actually
-	 * release memory in the buffers as it is assumed likely that the same buffers
-	 * will be recreated.
+	 * Resets the sizes of all the buffers in the set and clears fast search
+	 * ids.  Does not actually release memory in the buffers as it is assumed
+	 * likely that the same buffers will be recreated.
 	 *
 	 * @return return_code.
 	*/
@@ -329,6 +329,11 @@ public:
 	 * with varying number of vertices per id e.g contour */
 	int get_all_fast_search_id_locations(int target_id, int *number_of_locations, int **locations);
 
+	/* stop finding the location for the id, e.g. when the storage at the
+	 * location no longer fits a new object reusing the id. The location itself
+	 * is left in the array. */
+	int remove_fast_search_id_location(int target_id, int location);
+
 	void fill_element_index(unsigned vertex_start, unsigned int number_of_xi1, unsigned int number_of_xi2,
 		enum Graphics_vertex_array_shape_type shape_type);
 
@@ -15,6 +15,7 @@ struct cmzn_scenefilter;
 #define Scene cmzn_scene // GRC temp
 struct cmzn_graphics;
 class GraphicsIncrementalBuild;
+class GraphicsLevelOfDetail;
 struct cmzn_scene;
 struct Texture;
 struct cmzn_material;
@@ -210,7 +211,8 @@ public:
 	Render_graphics_compile_members() :
 		time(0.0),
 		region_path(NULL),
-		incrementalBuild(0)
+		incrementalBuild(0),
+		levelOfDetail(0)
 	{
 		for (int i = 0; i < 16; i++)
 		{
@@ -228,6 +230,10 @@ public:
 	 * somewhat responsive; invokes further redraw/build steps until complete.
 	 * If 0, full scene/graphics rebuild is performed. */
 	GraphicsIncrementalBuild *incrementalBuild;
+	/** object set if graphics levels of detail are to be selected from their
+	 * projected size, requesting coarser levels to be built in later frames.
+	 * If 0, graphics are always rendered at full detail. */
+	GraphicsLevelOfDetail *levelOfDetail;
 	
 	virtual int Scene_compile(cmzn_scene *scene, cmzn_scenefilter *scenefilter);
 
@@ -240,6 +246,16 @@ public:
 	virtual int cmzn_scene_compile_members(
 		cmzn_scene *scene);
 
+	/**
+	 * Query whether the renderer has its own graphics object for the graphics
+	 * at the current time, in which case the graphics need not be rebuilt
+	 * when compiling at that time.
+	 */
+	virtual bool hasGraphicsObjectAtTime(cmzn_graphics * /*graphics*/)
+	{
+		return false;
+	}
+
 	/***************************************************************************//**
 	 * @see Render_graphics::Texture_compile
 	 */
@@ -276,6 +292,16 @@ public:
 	{
 		this->incrementalBuild = incrementalBuildIn;
 	}
+
+	GraphicsLevelOfDetail *getLevelOfDetail()
+	{
+		return this->levelOfDetail;
+	}
+
+	void setLevelOfDetail(GraphicsLevelOfDetail *levelOfDetailIn)
+	{
+		this->levelOfDetail = levelOfDetailIn;
+	}
 };
 
 /***************************************************************************//**
@@ -12,7 +12,10 @@ GL rendering calls - API specific.
 #include <stdio.h>
 #include <math.h>
 #include <list>
+#include <map>
+#include <vector>
 #include "cmlibs/zinc/zincconfigure.h"
+#include "cmlibs/zinc/scenefilter.h"
 
 #include "general/mystring.h"
 #include "general/debug.h"
@@ -32,6 +35,7 @@ GL rendering calls - API specific.
 #include "graphics/render_gl.h"
 #include "graphics/scene.hpp"
 #include "graphics/scene_coordinate_system.hpp"
+#include "graphics/shader_program.hpp"
 #include "graphics/spectrum.hpp"
 #include "graphics/texture.hpp"
 #include "graphics/threejs_export.hpp"
@@ -145,6 +149,56 @@ void Render_graphics_opengl::reset_lights()
 	this->next_light_no = 0;
 }
 
+void Render_graphics_opengl::getClipMatrix(double *clipMatrix16)
+{
+	GLdouble modelview_matrix[16], projection_matrix[16];
+	glGetDoublev(GL_MODELVIEW_MATRIX, modelview_matrix);
+	glGetDoublev(GL_PROJECTION_MATRIX, projection_matrix);
+	for (int col = 0; col < 4; ++col)
+	{
+		for (int row = 0; row < 4; ++row)
+		{
+			double sum = 0.0;
+			for (int k = 0; k < 4; ++k)
+				sum += projection_matrix[k*4 + row]*modelview_matrix[col*4 + k];
+			clipMatrix16[col*4 + row] = sum;
+		}
+	}
+}
+
+bool Render_graphics_opengl::isOutsideViewFrustum(const Graphics_object_range_struct& box)
+{
+	if (box.first)
+		return false;
+	double clip_matrix[16];
+	this->getClipMatrix(clip_matrix);
+	// bits set for each of the 6 clip planes -w <= x, y, z <= w the corners are outside
+	int outside_all = 0x3f;
+	for (int c = 0; (c < 8) && outside_all; ++c)
+	{
+		const double x[3] =
+		{
+			(c & 1) ? box.maximum[0] : box.minimum[0],
+			(c & 2) ? box.maximum[1] : box.minimum[1],
+			(c & 4) ? box.maximum[2] : box.minimum[2]
+		};
+		double clip[4];
+		for (int row = 0; row < 4; ++row)
+			clip[row] = clip_matrix[row]*x[0] + clip_matrix[4 + row]*x[1] +
+				clip_matrix[8 + row]*x[2] + clip_matrix[12 + row];
+		int outside = 0;
+		for (int i = 0; i < 3; ++i)
+		{
+			if (clip[i] < -clip[3])
+				outside |= (1 << (2*i));
+			if (clip[i] > clip[3])
+				outside |= (2 << (2*i));
+		}
+		outside_all &= outside;
+	}
+	return (0 != outside_all);
+}
+
 /**
  * An implementation of a render class that uses immediate mode glBegin/glEnd.
  */
@@ -583,6 +637,9 @@ public:
 	int morphVertices, morphColours, morphNormals, numberOfResources;
 	char **filenames;
 	int isInline;
+	int numberOfThreads;
+	// accessed graphics objects built concurrently for all time steps, by graphics
+	std::map<cmzn_graphics *, std::vector<GT_object *> > timeStepGraphicsObjects;
 
 	/** @param outputStringsRef  Reference to vector of strings to fill with the output strings */
 	Render_graphics_opengl_threejs(const char *file_prefix_in,
@@ -590,7 +647,7 @@ public:
 			enum cmzn_streaminformation_scene_io_data_type mode_in, int *number_of_entries_in,
 			std::vector<std::string>& outputStringsRef,
 			int morphVerticesIn, int morphColoursIn, int morphNormalsIn,
-			int numberOfFilesIn, char **filenamesIn, int isInlineIn) :
+			int numberOfFilesIn, char **filenamesIn, int isInlineIn, int numberOfThreadsIn) :
 		Render_graphics_opengl_vertex_buffer_object(),
 		file_prefix(duplicate_string(file_prefix_in)),
 		begin_time(begin_time_in),
@@ -605,17 +662,72 @@ public:
 		morphNormals(morphNormalsIn),
 		numberOfResources(numberOfFilesIn),
 		filenames(filenamesIn),
-		isInline(isInlineIn)
+		isInline(isInlineIn),
+		numberOfThreads(numberOfThreadsIn)
 	{
 		exports_list.clear();
 	}
 
 	~Render_graphics_opengl_threejs()
 	{
+		this->clearTimeStepGraphicsObjects();
 		if (file_prefix)
 			DEALLOCATE(file_prefix);
 	}
 
+	/**
+	 * Build graphics objects for all time steps concurrently for the visible
+	 * time dependent graphics in scene which support it. Other graphics are
+	 * rebuilt at each time step as before.
+	 * @param times  The time of each time step.
+	 */
+	void buildTimeStepGraphicsObjects(cmzn_scene *scene, const std::vector<FE_value>& times)
+	{
+		cmzn_scenefilter *filter = this->getScenefilter();
+		cmzn_graphics *graphics = cmzn_scene_get_first_graphics(scene);
+		while (graphics)
+		{
+			if ((graphics->timeDependent) &&
+				((0 == filter) || (cmzn_scenefilter_evaluate_graphics(filter, graphics))))
+			{
+				std::vector<GT_object *> graphicsObjects;
+				if (CMZN_OK == cmzn_graphics_build_graphics_objects_at_times(graphics, this->region_path,
+					static_cast<int>(times.size()), times.data(), this->numberOfThreads, graphicsObjects))
+				{
+					this->timeStepGraphicsObjects[graphics] = graphicsObjects;
+				}
+			}
+			cmzn_graphics *nextGraphics = cmzn_scene_get_next_graphics(scene, graphics);
+			cmzn_graphics_destroy(&graphics);
+			graphics = nextGraphics;
+		}
+	}
+
+	void clearTimeStepGraphicsObjects()
+	{
+		for (auto& graphicsObjectsPair : this->timeStepGraphicsObjects)
+		{
+			for (GT_object *graphics_object : graphicsObjectsPair.second)
+				DEACCESS(GT_object)(&graphics_object);
+		}
+		this->timeStepGraphicsObjects.clear();
+	}
+
+	virtual bool hasGraphicsObjectAtTime(cmzn_graphics *graphics)
+	{
+		return this->timeStepGraphicsObjects.find(graphics) != this->timeStepGraphicsObjects.end();
+	}
+
+	/** @return  Non-accessed graphics object to export for graphics at the
+	 * current time frame. */
+	GT_object *getGraphicsObject(cmzn_graphics *graphics)
+	{
+		auto iter = this->timeStepGraphicsObjects.find(graphics);
+		if (iter != this->timeStepGraphicsObjects.end())
+			return iter->second[current_time_frame];
+		return cmzn_graphics_get_graphics_object(graphics);
+	}
+
 	int get_number_of_entries()
 	{
 		int size = 0;
@@ -779,6 +891,13 @@ public:
 				double increment = 0;
 				if (number_of_time_steps > 1)
 					increment = (end_time - begin_time) / (double)(number_of_time_steps - 1);
+				if ((this->numberOfThreads != 1) && (number_of_time_steps > 1))
+				{
+					std::vector<FE_value> times(number_of_time_steps);
+					for (int i = 0; i < number_of_time_steps; i++)
+						times[i] = begin_time + i * increment;
+					this->buildTimeStepGraphicsObjects(scene, times);
+				}
 				for (int i = 0; i < number_of_time_steps && return_code; i++)
 				{
 					this->time = begin_time + i * increment;
@@ -786,6 +905,7 @@ public:
 					return_code = cmzn_scene_execute(scene);
 					current_time_frame++;
 				}
+				this->clearTimeStepGraphicsObjects();
 			}
 			current_time_frame = 0;
 			//Restore the scene back to its original time
@@ -818,8 +938,7 @@ public:
 	int Graphics_export(cmzn_graphics *graphics)
 	{
 		int return_code = 0;
-		GT_object *graphics_object = cmzn_graphics_get_graphics_object(
-			graphics);
+		GT_object *graphics_object = this->getGraphicsObject(graphics);
 		Threejs_export_class *threejs_export = 0;
 		if (number_of_time_steps == 0 || current_time_frame == 0)
 		{
@@ -859,6 +978,10 @@ public:
 			threejs_export = new Threejs_export_class(new_file_prefix, number_of_time_steps, mode,
 				morphsVerticesAllowed, morphsColoursAllowed, morphNormalsAllowed, &textureSizes[0], group_name,
 				this->region_path, graphics);
+			if ((this->numberOfThreads != 1) && (number_of_time_steps > 1))
+			{
+				threejs_export->setMorphThreads(&(region->getThreadPool()), this->numberOfThreads);
+			}
 			threejs_export->beginExport();
 			threejs_export->exportMaterial(material);
 			cmzn_material_destroy(&material);
@@ -898,8 +1021,7 @@ public:
 	int Graphics_execute(cmzn_graphics *graphics)
 	{
 		int return_code = 1;
-		GT_object *graphics_object = cmzn_graphics_get_graphics_object(
-			graphics);
+		GT_object *graphics_object = this->getGraphicsObject(graphics);
 		if (graphics_object &&
 			(GT_object_get_type(graphics_object) == g_SURFACE_VERTEX_BUFFERS))
 		{
@@ -953,11 +1075,12 @@ Render_graphics_opengl *Render_graphics_opengl_create_threejs_renderer(
 	double end_time, enum cmzn_streaminformation_scene_io_data_type mode,
 	int *number_of_entries, std::vector<std::string>& outputStringsRef,
 	int morphVertices, int morphColours, int morphNormals,
-	int numberOfFiles, char **file_names, int isInline)
+	int numberOfFiles, char **file_names, int isInline, int numberOfThreads)
 {
 	return new Render_graphics_opengl_threejs(file_prefix, number_of_time_steps,
 		begin_time, end_time, mode, number_of_entries, outputStringsRef,
-		morphVertices, morphColours, morphNormals, numberOfFiles, file_names, isInline);
+		morphVertices, morphColours, morphNormals, numberOfFiles, file_names, isInline,
+		numberOfThreads);
 }
 
 /**
@@ -1175,45 +1298,22 @@ int Graphics_object_create_colour_buffer_from_data(GT_object *object,
 		{
 			if (ALLOCATE(*colour_buffer, GLfloat, 4 * data_vertex_count))
 			{
-				GLfloat *data_vertex;
-				GLfloat *colour_vertex;
-				unsigned int i;
-				ZnReal colData[4];
+				GLfloat base_rgba[4] = { 0.0, 0.0, 0.0, 1.0 };
 				if (!cmzn_spectrum_is_material_overwrite(spectrum))
 				{
 					Colour diffuse_colour;
 					Graphical_material_get_diffuse(material, &diffuse_colour);
-					MATERIAL_PRECISION prec;
-					Graphical_material_get_alpha(material, &prec);
-					GLfloat alpha = prec;
-					for (i = 0 ; i < data_vertex_count ; i++)
-					{
-						colData[0] = diffuse_colour.red;
-						colData[1] = diffuse_colour.green;
-						colData[2] = diffuse_colour.blue;
-						colData[3] = alpha;
-					}
+					MATERIAL_PRECISION alpha;
+					Graphical_material_get_alpha(material, &alpha);
+					base_rgba[0] = (GLfloat)diffuse_colour.red;
+					base_rgba[1] = (GLfloat)diffuse_colour.green;
+					base_rgba[2] = (GLfloat)diffuse_colour.blue;
+					base_rgba[3] = (GLfloat)alpha;
 				}
-				colour_vertex = *colour_buffer;
-				data_vertex = data_buffer;
-				FE_value *feData = new FE_value[data_values_per_vertex];
-				for (i = 0 ; i < data_vertex_count ; i++)
-				{
-					CAST_TO_FE_VALUE(feData,data_vertex,(int)data_values_per_vertex);
-					Spectrum_value_to_rgba(spectrum, data_values_per_vertex,
-							feData, colData);
-					for (unsigned int j = 0 ; j < 4 ; j++)
-					{
-						colour_vertex[j] = (GLfloat)colData[j];
-					}
-					colour_vertex += 4;
-					data_vertex += data_values_per_vertex;
-				}
-				Spectrum_end_value_to_rgba(spectrum);
-
+				Spectrum_values_to_rgba(spectrum, (int)data_values_per_vertex,
+					data_vertex_count, data_buffer, base_rgba, *colour_buffer);
 				*colour_vertex_count = data_vertex_count;
 				*colour_values_per_vertex = 4;
-				delete[] feData;
 			}
 			else
 			{
@@ -1229,6 +1329,58 @@ int Graphics_object_create_colour_buffer_from_data(GT_object *object,
 	return (return_code);
 }
 
+/**
+ * Returns true if the spectrum colours of <object> can be looked up from its
+ * per-vertex data in the spectrum's data lookup texture when drawing with
+ * vertex buffer objects, so spectrum changes only update the texture instead
+ * of converting and uploading per-vertex colours. Limited to lines and
+ * surfaces with at most 3 data components and no texture coordinates or
+ * secondary material, whose materials have no texture, shader program or
+ * emission, as the texture modulates the fixed-function lit colour.
+ */
+static bool Graphics_object_use_spectrum_data_lookup(GT_object *object)
+{
+	if (!(((g_POLYLINE_VERTEX_BUFFERS == object->object_type) ||
+		(g_SURFACE_VERTEX_BUFFERS == object->object_type)) &&
+		(!object->secondary_material)))
+	{
+		return false;
+	}
+	cmzn_material *materials[2] = { get_GT_object_default_material(object),
+		get_GT_object_selected_material(object) };
+	for (int i = 0; i < 2; ++i)
+	{
+		if (materials[i])
+		{
+			Colour emission;
+			if (Graphical_material_get_texture(materials[i]) || materials[i]->program ||
+				(!Graphical_material_get_emission(materials[i], &emission)) ||
+				(0.0 != emission.red) || (0.0 != emission.green) || (0.0 != emission.blue))
+			{
+				return false;
+			}
+		}
+	}
+	GLfloat *buffer = 0;
+	unsigned int data_values_per_vertex, data_vertex_count;
+	unsigned int texture_coordinate0_values_per_vertex, texture_coordinate0_vertex_count;
+	if ((!object->vertex_array->get_float_vertex_buffer(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+			&buffer, &data_values_per_vertex, &data_vertex_count)) ||
+		(3 < data_values_per_vertex) ||
+		object->vertex_array->get_float_vertex_buffer(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_TEXTURE_COORDINATE_ZERO,
+			&buffer, &texture_coordinate0_values_per_vertex, &texture_coordinate0_vertex_count))
+	{
+		return false;
+	}
+	int component_index;
+	ZnReal minimum, maximum;
+	return Spectrum_get_data_lookup_range(get_GT_object_spectrum(object),
+		&component_index, &minimum, &maximum) &&
+		(component_index < static_cast<int>(data_values_per_vertex));
+}
+
 static int Graphics_object_enable_opengl_client_vertex_arrays(GT_object *object,
 	Render_graphics_opengl *renderer,
 	GLfloat **vertex_buffer, GLfloat **colour_buffer, GLfloat **normal_buffer,
@@ -1690,6 +1842,72 @@ static int Graphics_object_generate_vertex_positions_from_secondary_material(GT_
 /***************************************************************************//**
 																			 * Compile Graphics_vertex_array data into vertex buffer objects.
 																			 */
+#if defined (GL_VERSION_3_3)
+/**
+ * Uploads glyph set axis1, axis2, axis3 and scale arrays consecutively into
+ * the glyph axes buffer for instanced rendering, updating only the partial
+ * redraw ranges unless reallocating. Deletes the buffer if any array does not
+ * match the number of glyphs or instancing is not available.
+ */
+static void Graphics_object_compile_opengl_glyph_axes_vertex_buffer_object(
+	GT_object *object, unsigned int glyph_count, bool reallocate,
+	unsigned int *partialRedrawIndices, unsigned int *redraw_count_buffer,
+	unsigned int redrawCount)
+{
+	static const Graphics_vertex_array_attribute_type axes_types[4] = {
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS1,
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS2,
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_AXIS3,
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_SCALE };
+	GLfloat *axes_buffers[4];
+	bool valid = (0 < glyph_count) && Graphics_library_check_extension(GL_VERSION_3_3);
+	for (int a = 0; valid && (a < 4); ++a)
+	{
+		unsigned int values_per_vertex = 0, vertex_count = 0;
+		valid = object->vertex_array->get_float_vertex_buffer(axes_types[a],
+			&axes_buffers[a], &values_per_vertex, &vertex_count) &&
+			(3 == values_per_vertex) && (glyph_count == vertex_count);
+	}
+	if (!valid)
+	{
+		if (object->glyph_axes_vertex_buffer_object)
+		{
+			glDeleteBuffers(1, &object->glyph_axes_vertex_buffer_object);
+			object->glyph_axes_vertex_buffer_object = 0;
+		}
+		return;
+	}
+	const GLsizeiptr block_size = sizeof(GLfloat)*3*glyph_count;
+	if (!object->glyph_axes_vertex_buffer_object)
+	{
+		glGenBuffers(1, &object->glyph_axes_vertex_buffer_object);
+		reallocate = true;
+	}
+	glBindBuffer(GL_ARRAY_BUFFER, object->glyph_axes_vertex_buffer_object);
+	if (reallocate)
+	{
+		glBufferData(GL_ARRAY_BUFFER, 4*block_size, NULL, GL_STATIC_DRAW);
+		for (int a = 0; a < 4; ++a)
+		{
+			glBufferSubData(GL_ARRAY_BUFFER, a*block_size, block_size, axes_buffers[a]);
+		}
+	}
+	else
+	{
+		for (unsigned int i = 0; i < redrawCount; i++)
+		{
+			const GLintptr bytesStart = sizeof(GLfloat)*3*partialRedrawIndices[i];
+			const GLsizeiptr size = sizeof(GLfloat)*3*redraw_count_buffer[i];
+			for (int a = 0; a < 4; ++a)
+			{
+				glBufferSubData(GL_ARRAY_BUFFER, a*block_size + bytesStart, size,
+					axes_buffers[a] + 3*partialRedrawIndices[i]);
+			}
+		}
+	}
+}
+#endif /* defined (GL_VERSION_3_3) */
+
 static int Graphics_object_compile_opengl_vertex_buffer_object(GT_object *object,
 	Render_graphics_opengl *renderer)
 {
@@ -1755,10 +1973,27 @@ static int Graphics_object_compile_opengl_vertex_buffer_object(GT_object *object
 					else if (object->buffer_binding)
 					{
 						glBindBuffer(GL_ARRAY_BUFFER, object->position_vertex_buffer_object);
-						if (!partialRedrawIndices)
+						/* vertices appended by partial rebuild need the whole buffer
+						 * reallocated, as do buffers with no ranges to redraw */
+						const bool reallocate = (!partialRedrawIndices) || (0 == redrawCount) ||
+							(position_vertex_count != object->position_vertex_buffer_count) ||
+							(position_values_per_vertex != object->position_values_per_vertex);
+#if defined (GL_VERSION_3_3)
+						if (GT_object_get_type(object) == g_GLYPH_SET_VERTEX_BUFFERS)
+						{
+							Graphics_object_compile_opengl_glyph_axes_vertex_buffer_object(
+								object, position_vertex_count, reallocate,
+								partialRedrawIndices, redraw_count_buffer, redrawCount);
+							glBindBuffer(GL_ARRAY_BUFFER, object->position_vertex_buffer_object);
+						}
+#endif /* defined (GL_VERSION_3_3) */
+						if (reallocate)
+						{
 							glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)*
 									position_values_per_vertex*position_vertex_count,
 									position_vertex_buffer, GL_STATIC_DRAW);
+							object->position_vertex_buffer_count = position_vertex_count;
+						}
 						else
 						{
 							GLintptr bytesStart = 0;
@@ -1780,41 +2015,86 @@ static int Graphics_object_compile_opengl_vertex_buffer_object(GT_object *object
 					{
 						glDeleteBuffers(1, &object->position_vertex_buffer_object);
 						object->position_vertex_buffer_object = 0;
+						object->position_vertex_buffer_count = 0;
+					}
+					if (object->glyph_axes_vertex_buffer_object)
+					{
+						glDeleteBuffers(1, &object->glyph_axes_vertex_buffer_object);
+						object->glyph_axes_vertex_buffer_object = 0;
 					}
 				}
-				unsigned int colour_values_per_vertex, colour_vertex_count;
-				GLfloat *colour_buffer = (GLfloat *)NULL;
-				if (Graphics_object_create_colour_buffer_from_data(object,
-					&colour_buffer,
-					&colour_values_per_vertex, &colour_vertex_count))
+				GLfloat *spectrum_data_buffer = NULL;
+				unsigned int spectrum_data_values_per_vertex, spectrum_data_vertex_count;
+				if (Graphics_object_use_spectrum_data_lookup(object) &&
+					Spectrum_compile_data_lookup(get_GT_object_spectrum(object), renderer) &&
+					object->vertex_array->get_float_vertex_buffer(
+						GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_DATA,
+						&spectrum_data_buffer, &spectrum_data_values_per_vertex,
+						&spectrum_data_vertex_count) &&
+					(spectrum_data_vertex_count == position_vertex_count))
 				{
-					if ((object->buffer_binding || (object->compile_status == GRAPHICS_NOT_COMPILED)) &&
-							(colour_vertex_count == position_vertex_count))
+					/* colours are looked up from data in the spectrum texture, so
+					 * data is only uploaded with geometry; spectrum changes only
+					 * update the texture */
+					if (object->colour_vertex_buffer_object)
 					{
-						if (!object->colour_vertex_buffer_object)
-						{
-							glGenBuffers(1, &object->colour_vertex_buffer_object);
-						}
-						glBindBuffer(GL_ARRAY_BUFFER, object->colour_vertex_buffer_object);
-						glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)* /*need to be 4 */4 *colour_vertex_count,
-							colour_buffer, GL_STATIC_DRAW);
-						object->colour_values_per_vertex = colour_values_per_vertex;
-						if (colour_buffer)
+						glDeleteBuffers(1, &object->colour_vertex_buffer_object);
+						object->colour_vertex_buffer_object = 0;
+					}
+					if ((!object->spectrum_data_vertex_buffer_object) || object->buffer_binding)
+					{
+						if (!object->spectrum_data_vertex_buffer_object)
 						{
-							DEALLOCATE(colour_buffer);
+							glGenBuffers(1, &object->spectrum_data_vertex_buffer_object);
 						}
+						glBindBuffer(GL_ARRAY_BUFFER, object->spectrum_data_vertex_buffer_object);
+						glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)*
+							spectrum_data_values_per_vertex*spectrum_data_vertex_count,
+							spectrum_data_buffer, GL_STATIC_DRAW);
+						object->spectrum_data_values_per_vertex = spectrum_data_values_per_vertex;
 					}
 				}
 				else
 				{
-					if (colour_buffer)
+					if (object->spectrum_data_vertex_buffer_object)
 					{
-						DEALLOCATE(colour_buffer);
+						glDeleteBuffers(1, &object->spectrum_data_vertex_buffer_object);
+						object->spectrum_data_vertex_buffer_object = 0;
 					}
-					if (object->colour_vertex_buffer_object)
+					unsigned int colour_values_per_vertex, colour_vertex_count;
+					GLfloat *colour_buffer = (GLfloat *)NULL;
+					if (Graphics_object_create_colour_buffer_from_data(object,
+						&colour_buffer,
+						&colour_values_per_vertex, &colour_vertex_count))
 					{
-						glDeleteBuffers(1, &object->colour_vertex_buffer_object);
-						object->colour_vertex_buffer_object = 0;
+						if ((object->buffer_binding || (object->compile_status == GRAPHICS_NOT_COMPILED)) &&
+								(colour_vertex_count == position_vertex_count))
+						{
+							if (!object->colour_vertex_buffer_object)
+							{
+								glGenBuffers(1, &object->colour_vertex_buffer_object);
+							}
+							glBindBuffer(GL_ARRAY_BUFFER, object->colour_vertex_buffer_object);
+							glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)* /*need to be 4 */4 *colour_vertex_count,
+								colour_buffer, GL_STATIC_DRAW);
+							object->colour_values_per_vertex = colour_values_per_vertex;
+							if (colour_buffer)
+							{
+								DEALLOCATE(colour_buffer);
+							}
+						}
+					}
+					else
+					{
+						if (colour_buffer)
+						{
+							DEALLOCATE(colour_buffer);
+						}
+						if (object->colour_vertex_buffer_object)
+						{
+							glDeleteBuffers(1, &object->colour_vertex_buffer_object);
+							object->colour_vertex_buffer_object = 0;
+						}
 					}
 				}
 
@@ -1832,9 +2112,13 @@ static int Graphics_object_compile_opengl_vertex_buffer_object(GT_object *object
 					if (object->buffer_binding)
 					{
 						glBindBuffer(GL_ARRAY_BUFFER, object->normal_vertex_buffer_object);
-						if (!partialRedrawIndices)
+						if ((!partialRedrawIndices) || (0 == redrawCount) ||
+							(normal_vertex_count != object->normal_vertex_buffer_count))
+						{
 							glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)*normal_values_per_vertex*normal_vertex_count,
 								normal_buffer, GL_STATIC_DRAW);
+							object->normal_vertex_buffer_count = normal_vertex_count;
+						}
 						else
 						{
 							GLintptr bytesStart = 0;
@@ -1854,6 +2138,7 @@ static int Graphics_object_compile_opengl_vertex_buffer_object(GT_object *object
 					{
 						glDeleteBuffers(1, &object->normal_vertex_buffer_object);
 						object->normal_vertex_buffer_object = 0;
+						object->normal_vertex_buffer_count = 0;
 					}
 				}
 
@@ -1873,9 +2158,14 @@ static int Graphics_object_compile_opengl_vertex_buffer_object(GT_object *object
 					if (object->buffer_binding)
 					{
 						glBindBuffer(GL_ARRAY_BUFFER, object->texture_coordinate0_vertex_buffer_object);
-						if (!partialRedrawIndices)
+						if ((!partialRedrawIndices) || (0 == redrawCount) ||
+							(texture_coordinate0_vertex_count != object->texture_coordinate0_vertex_buffer_count) ||
+							(texture_coordinate0_values_per_vertex != object->texture_coordinate0_values_per_vertex))
+						{
 							glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)*texture_coordinate0_values_per_vertex*texture_coordinate0_vertex_count,
 								texture_coordinate0_buffer, GL_STATIC_DRAW);
+							object->texture_coordinate0_vertex_buffer_count = texture_coordinate0_vertex_count;
+						}
 						else
 						{
 							GLintptr bytesStart = 0;
@@ -1897,6 +2187,7 @@ static int Graphics_object_compile_opengl_vertex_buffer_object(GT_object *object
 					{
 						glDeleteBuffers(1, &object->texture_coordinate0_vertex_buffer_object);
 						object->texture_coordinate0_vertex_buffer_object = 0;
+						object->texture_coordinate0_vertex_buffer_count = 0;
 					}
 				}
 
@@ -1914,9 +2205,14 @@ static int Graphics_object_compile_opengl_vertex_buffer_object(GT_object *object
 						glGenBuffers(1, &object->tangent_vertex_buffer_object);
 					}
 					glBindBuffer(GL_ARRAY_BUFFER, object->tangent_vertex_buffer_object);
-					if (!partialRedrawIndices)
+					if ((!partialRedrawIndices) || (0 == redrawCount) ||
+						(tangent_vertex_count != object->tangent_vertex_buffer_count) ||
+						(tangent_values_per_vertex != object->tangent_values_per_vertex))
+					{
 						glBufferData(GL_ARRAY_BUFFER, sizeof(GLfloat)*tangent_values_per_vertex*tangent_vertex_count,
 								tangent_buffer, GL_STATIC_DRAW);
+						object->tangent_vertex_buffer_count = tangent_vertex_count;
+					}
 					else
 					{
 						GLintptr bytesStart = 0;
@@ -1936,6 +2232,7 @@ static int Graphics_object_compile_opengl_vertex_buffer_object(GT_object *object
 					{
 						glDeleteBuffers(1, &object->tangent_vertex_buffer_object);
 						object->tangent_vertex_buffer_object = 0;
+						object->tangent_vertex_buffer_count = 0;
 					}
 				}
 
@@ -2063,6 +2360,33 @@ static int Graphics_object_enable_opengl_vertex_buffer_object(GT_object *object,
 					glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
 					glEnable(GL_COLOR_MATERIAL);
 				}
+				if (object->spectrum_data_vertex_buffer_object)
+				{
+					/* Texture from spectrum modulates quarter-white lit material
+					 * colour scaled by 4, so lighting saturates after texturing,
+					 * with specular added after texturing, giving the same colour
+					 * as per-vertex colours for materials without emission */
+					glPushAttrib(GL_CURRENT_BIT | GL_ENABLE_BIT | GL_LIGHTING_BIT | GL_TEXTURE_BIT);
+					glColorMaterial(GL_FRONT_AND_BACK, GL_AMBIENT_AND_DIFFUSE);
+					glEnable(GL_COLOR_MATERIAL);
+					glColor4f(0.25f, 0.25f, 0.25f, 1.0f);
+#if defined (GL_VERSION_1_2)
+					glLightModeli(GL_LIGHT_MODEL_COLOR_CONTROL, GL_SEPARATE_SPECULAR_COLOR);
+#endif /* defined (GL_VERSION_1_2) */
+					glActiveTexture(GL_TEXTURE0);
+					glMatrixMode(GL_TEXTURE);
+					glPushMatrix();
+					glMatrixMode(GL_MODELVIEW);
+					Spectrum_execute_data_lookup(get_GT_object_spectrum(object), renderer);
+					glClientActiveTexture(GL_TEXTURE0);
+					glBindBuffer(GL_ARRAY_BUFFER,
+						object->spectrum_data_vertex_buffer_object);
+					glEnableClientState(GL_TEXTURE_COORD_ARRAY);
+					glTexCoordPointer(
+						object->spectrum_data_values_per_vertex,
+						GL_FLOAT, /*Packed vertices*/0,
+						/*No offset in vertex array*/(void *)0);
+				}
 				if (object->normal_vertex_buffer_object)
 				{
 					glBindBuffer(GL_ARRAY_BUFFER,
@@ -2142,6 +2466,16 @@ static int Graphics_object_disable_opengl_vertex_buffer_object(GT_object *object
 					glDisableClientState(GL_COLOR_ARRAY);
 					glDisable(GL_COLOR_MATERIAL);
 				}
+				if (object->spectrum_data_vertex_buffer_object)
+				{
+					glClientActiveTexture(GL_TEXTURE0);
+					glDisableClientState(GL_TEXTURE_COORD_ARRAY);
+					glActiveTexture(GL_TEXTURE0);
+					glMatrixMode(GL_TEXTURE);
+					glPopMatrix();
+					glMatrixMode(GL_MODELVIEW);
+					glPopAttrib();
+				}
 				if (object->normal_vertex_buffer_object)
 				{
 					glDisableClientState(GL_NORMAL_ARRAY);
@@ -2297,6 +2631,230 @@ static int draw_vertexBufferPointset(gtObject *object,
 	return 0;
 }
 
+#if defined (GL_VERSION_3_3)
+/**
+ * Draws every glyph in the glyph set with one instanced draw per strip of the
+ * glyph surface and range of points, passing the glyph set position, axes,
+ * scale and any spectrum colour buffers as instance arrays to the instanced
+ * glyph shader program. Only handles single surface glyphs without repeats
+ * or static labels, and materials without their own shader program, drawn
+ * with lighting on.
+ * @return  True if drawn, false if glyphs must be drawn individually.
+ */
+static bool draw_vertexBufferGlyphsetInstanced(gtObject *object,
+	Render_graphics_opengl *renderer)
+{
+	GT_glyphset_vertex_buffers *glyph_set = object->primitive_lists->gt_glyphset_vertex_buffers;
+	GT_object *glyph = glyph_set->glyph;
+	if ((!object->position_vertex_buffer_object) || (!object->glyph_axes_vertex_buffer_object) ||
+		(3 != object->position_values_per_vertex) ||
+		(CMZN_GLYPH_REPEAT_MODE_NONE != glyph_set->glyph_repeat_mode) ||
+		(0 != glyph_set->static_label_text[0]) || (!glyph) ||
+		(g_SURFACE_VERTEX_BUFFERS != GT_object_get_type(glyph)) ||
+		GT_object_get_next_object(glyph) || Graphics_object_get_glyph_labels_function(glyph) ||
+		(!glyph->position_vertex_buffer_object) || (!glyph->primitive_lists))
+	{
+		return false;
+	}
+	GT_surface_vertex_buffers *vb_surface = glyph->primitive_lists->gt_surface_vertex_buffers;
+	if (!vb_surface)
+	{
+		return false;
+	}
+	GLenum mode;
+	switch (vb_surface->surface_type)
+	{
+	case g_SHADED:
+	case g_SHADED_TEXMAP:
+	{
+		if (!glyph->index_vertex_buffer_object)
+		{
+			return false;
+		}
+		mode = GL_TRIANGLE_STRIP;
+	} break;
+	case g_SH_DISCONTINUOUS:
+	case g_SH_DISCONTINUOUS_STRIP:
+	case g_SH_DISCONTINUOUS_TEXMAP:
+	case g_SH_DISCONTINUOUS_STRIP_TEXMAP:
+	{
+		mode = GL_TRIANGLES;
+	} break;
+	default:
+	{
+		return false;
+	} break;
+	}
+	GLint current_program = 0;
+	glGetIntegerv(GL_CURRENT_PROGRAM, &current_program);
+	if (current_program)
+	{
+		/* material has its own shader program */
+		return false;
+	}
+	if (!glIsEnabled(GL_LIGHTING))
+	{
+		return false;
+	}
+	GLint light_indexes[8];
+	GLint light_count = 0;
+	for (GLint i = 0; i < 8; ++i)
+	{
+		if (glIsEnabled(GL_LIGHT0 + i))
+		{
+			light_indexes[light_count] = i;
+			++light_count;
+		}
+	}
+	GLint two_sided = 0, local_viewer = 0;
+	glGetIntegerv(GL_LIGHT_MODEL_TWO_SIDE, &two_sided);
+	glGetIntegerv(GL_LIGHT_MODEL_LOCAL_VIEWER, &local_viewer);
+	const GLuint program = cmzn_shaderprogram_get_instanced_glyph_glslprogram();
+	if (!program)
+	{
+		return false;
+	}
+	const bool use_colour = (0 != object->colour_vertex_buffer_object);
+	glUseProgram(program);
+	glUniform3fv(glGetUniformLocation(program, "baseSize"), 1, glyph_set->base_size);
+	glUniform3fv(glGetUniformLocation(program, "scaleFactors"), 1, glyph_set->scale_factors);
+	glUniform3fv(glGetUniformLocation(program, "offset"), 1, glyph_set->offset);
+	glUniform1i(glGetUniformLocation(program, "useGlyphColour"), use_colour ? 1 : 0);
+	glUniform1i(glGetUniformLocation(program, "lightCount"), light_count);
+	if (light_count > 0)
+	{
+		glUniform1iv(glGetUniformLocation(program, "lightIndexes"), light_count, light_indexes);
+	}
+	glUniform1i(glGetUniformLocation(program, "twoSided"), two_sided ? 1 : 0);
+	glUniform1i(glGetUniformLocation(program, "localViewer"), local_viewer ? 1 : 0);
+	if (two_sided)
+	{
+		glEnable(GL_VERTEX_PROGRAM_TWO_SIDE);
+	}
+	const bool wireframe_flag = (vb_surface->render_polygon_mode == CMZN_GRAPHICS_RENDER_POLYGON_MODE_WIREFRAME);
+	if (wireframe_flag)
+	{
+		glPushAttrib(GL_POLYGON_BIT);
+		glPolygonMode(GL_FRONT_AND_BACK, GL_LINE);
+	}
+	Graphics_object_enable_opengl_vertex_buffer_object(glyph, renderer);
+	const GLuint axes_attributes[4] = {
+		SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_AXIS1,
+		SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_AXIS2,
+		SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_AXIS3,
+		SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_SCALE };
+	glEnableVertexAttribArray(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_POSITION);
+	glVertexAttribDivisor(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_POSITION, 1);
+	for (int a = 0; a < 4; ++a)
+	{
+		glEnableVertexAttribArray(axes_attributes[a]);
+		glVertexAttribDivisor(axes_attributes[a], 1);
+	}
+	if (use_colour)
+	{
+		glEnableVertexAttribArray(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_COLOUR);
+		glVertexAttribDivisor(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_COLOUR, 1);
+	}
+	const GLsizeiptr axes_block_size = sizeof(GLfloat)*3*object->position_vertex_buffer_count;
+	Graphics_vertex_array *glyph_array = glyph->vertex_array;
+	const unsigned int surface_count = glyph_array->get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START);
+	const unsigned int range_count = object->vertex_array->get_number_of_vertices(
+		GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START);
+	for (unsigned int range_index = 0; range_index < range_count; ++range_index)
+	{
+		unsigned int index_start = 0, index_count = 0;
+		object->vertex_array->get_unsigned_integer_attribute(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
+			range_index, 1, &index_start);
+		object->vertex_array->get_unsigned_integer_attribute(
+			GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+			range_index, 1, &index_count);
+		if ((0 == index_count) || (index_start + index_count > object->position_vertex_buffer_count))
+		{
+			continue;
+		}
+		/* point instance arrays at start of range */
+		const GLsizeiptr triple_offset = sizeof(GLfloat)*3*index_start;
+		glBindBuffer(GL_ARRAY_BUFFER, object->position_vertex_buffer_object);
+		glVertexAttribPointer(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_POSITION,
+			3, GL_FLOAT, GL_FALSE, /*Packed vertices*/0, BUFFER_OFFSET(triple_offset));
+		glBindBuffer(GL_ARRAY_BUFFER, object->glyph_axes_vertex_buffer_object);
+		for (int a = 0; a < 4; ++a)
+		{
+			glVertexAttribPointer(axes_attributes[a], 3, GL_FLOAT, GL_FALSE,
+				/*Packed vertices*/0, BUFFER_OFFSET(a*axes_block_size + triple_offset));
+		}
+		if (use_colour)
+		{
+			glBindBuffer(GL_ARRAY_BUFFER, object->colour_vertex_buffer_object);
+			glVertexAttribPointer(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_COLOUR,
+				4, GL_FLOAT, GL_FALSE, /*Packed vertices*/0, BUFFER_OFFSET(sizeof(GLfloat)*4*index_start));
+		}
+		for (unsigned int surface_index = 0; surface_index < surface_count; ++surface_index)
+		{
+			if (GL_TRIANGLE_STRIP == mode)
+			{
+				unsigned int number_of_strips = 0;
+				unsigned int strip_start = 0;
+				glyph_array->get_unsigned_integer_attribute(
+					GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_STRIPS,
+					surface_index, 1, &number_of_strips);
+				glyph_array->get_unsigned_integer_attribute(
+					GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_START,
+					surface_index, 1, &strip_start);
+				for (unsigned int i = 0; i < number_of_strips; ++i)
+				{
+					unsigned int points_per_strip = 0;
+					unsigned int index_start_for_strip = 0;
+					glyph_array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_START,
+						strip_start + i, 1, &index_start_for_strip);
+					glyph_array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
+						strip_start + i, 1, &points_per_strip);
+					glDrawElementsInstanced(GL_TRIANGLE_STRIP, points_per_strip, GL_UNSIGNED_INT,
+						BUFFER_OFFSET(sizeof(GLuint)*index_start_for_strip), index_count);
+				}
+			}
+			else
+			{
+				unsigned int surface_start = 0, surface_vertex_count = 0;
+				glyph_array->get_unsigned_integer_attribute(
+					GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_START,
+					surface_index, 1, &surface_start);
+				glyph_array->get_unsigned_integer_attribute(
+					GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_ELEMENT_INDEX_COUNT,
+					surface_index, 1, &surface_vertex_count);
+				glDrawArraysInstanced(GL_TRIANGLES, surface_start, surface_vertex_count, index_count);
+			}
+		}
+	}
+	/* divisors are vertex array state so must be reset for other drawing */
+	glVertexAttribDivisor(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_POSITION, 0);
+	glDisableVertexAttribArray(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_POSITION);
+	for (int a = 0; a < 4; ++a)
+	{
+		glVertexAttribDivisor(axes_attributes[a], 0);
+		glDisableVertexAttribArray(axes_attributes[a]);
+	}
+	if (use_colour)
+	{
+		glVertexAttribDivisor(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_COLOUR, 0);
+		glDisableVertexAttribArray(SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_COLOUR);
+	}
+	Graphics_object_disable_opengl_vertex_buffer_object(glyph, renderer);
+	if (wireframe_flag)
+	{
+		glPopAttrib();
+	}
+	if (two_sided)
+	{
+		glDisable(GL_VERTEX_PROGRAM_TWO_SIDE);
+	}
+	glUseProgram(0);
+	return true;
+}
+#endif /* defined (GL_VERSION_3_3) */
+
 static int draw_vertexBufferGlyphset(gtObject *object,
 	cmzn_material *material, cmzn_material *secondary_material,
 	struct cmzn_spectrum *spectrum,
@@ -2397,6 +2955,16 @@ static int draw_vertexBufferGlyphset(gtObject *object,
 					&label_density_buffer, &label_density_values_per_vertex, &label_density_count);
 				bool picking_names = (names_buffer) && (renderer->picking);
 				draw_all = ((!names_buffer) || ((!draw_selected)&&(!highlight_functor)));
+#if defined (GL_VERSION_3_3)
+				/* draw all glyphs at once if nothing needs per-glyph state */
+				if (draw_all && (!renderer->picking) && (!renderer->use_display_list) &&
+					(GRAPHICS_OBJECT_RENDERING_TYPE_VERTEX_BUFFER_OBJECT == rendering_type) &&
+					(!label_buffer) && (!label_bound_buffer) &&
+					draw_vertexBufferGlyphsetInstanced(object, renderer))
+				{
+					return 1;
+				}
+#endif /* defined (GL_VERSION_3_3) */
 				if (data_buffer)
 				{
 					render_data=spectrum_start_renderGL(spectrum,material,data_values_per_vertex);
@@ -3088,7 +3656,8 @@ int drawGLSurfaces(gtObject *object, Render_graphics_opengl *renderer,
 										array->get_unsigned_integer_attribute(
 											GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_START,
 											surface_index, 1, &strip_start);
-										for (unsigned int i = 0; i < number_of_strips; i++)
+										unsigned int i = 0;
+										while (i < number_of_strips)
 										{
 											unsigned int points_per_strip = 0;
 											unsigned int index_start_for_strip = 0;
@@ -3096,9 +3665,28 @@ int drawGLSurfaces(gtObject *object, Render_graphics_opengl *renderer,
 												strip_start+i, 1, &index_start_for_strip);
 											array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
 												strip_start+i, 1, &points_per_strip);
+											++i;
+											GLenum strip_mode = mode;
+											if (3 == points_per_strip)
+											{
+												// consecutive single triangle strips e.g. from indexed
+												// iso-surfaces are drawn together as triangles
+												unsigned int next_points_per_strip, next_index_start;
+												while ((i < number_of_strips) &&
+													array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_NUMBER_OF_POINTS_FOR_STRIP,
+														strip_start+i, 1, &next_points_per_strip) && (3 == next_points_per_strip) &&
+													array->get_unsigned_integer_attribute(GRAPHICS_VERTEX_ARRAY_ATTRIBUTE_TYPE_STRIP_INDEX_START,
+														strip_start+i, 1, &next_index_start) &&
+													(next_index_start == index_start_for_strip + points_per_strip))
+												{
+													points_per_strip += 3;
+													++i;
+												}
+												strip_mode = GL_TRIANGLES;
+											}
 											if (object->index_vertex_buffer_object)
 											{
-												glDrawElements(mode, points_per_strip, GL_UNSIGNED_INT, BUFFER_OFFSET(sizeof(GLuint) * index_start_for_strip));
+												glDrawElements(strip_mode, points_per_strip, GL_UNSIGNED_INT, BUFFER_OFFSET(sizeof(GLuint) * index_start_for_strip));
 											}
 										}
 									} break;
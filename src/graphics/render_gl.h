@@ -37,6 +37,10 @@ public:
 
 	int use_display_list;
 
+	/** Set to skip scenes and graphics in local coordinates whose bounding box
+	 * is entirely outside the view frustum. Not applied when picking. */
+	bool view_frustum_culling;
+
 	// use second pointer to save highlight_functor while it is disabled
 	GraphicsHighlightFunctor *highlight_functor, *saved_highlight_functor;
 
@@ -65,6 +69,7 @@ public:
 		current_layer(0),
 		number_of_layers(1),
 		use_display_list(0),
+		view_frustum_culling(false),
 		highlight_functor(NULL),
 		saved_highlight_functor(NULL),
 		point_unit_size_pixels(1.0),
@@ -168,6 +173,21 @@ public:
 	 */
 	void reset_lights();
 
+	/**
+	 * Get matrix from current model coordinates to clip coordinates, the
+	 * product of the current OpenGL projection and modelview matrices.
+	 * @param clipMatrix16  Array to receive 16 values ordered down columns
+	 * first, OpenGL style.
+	 */
+	void getClipMatrix(double *clipMatrix16);
+
+	/**
+	 * Query whether a box in current model coordinates is entirely outside
+	 * the view frustum, i.e. all its corners are outside the same clip plane.
+	 * @param box  The box to test. An empty box is never outside.
+	 */
+	bool isOutsideViewFrustum(const Graphics_object_range_struct& box);
+
 }; /* class Render_graphics_opengl */
 
 /***************************************************************************//**
@@ -209,13 +229,16 @@ Render_graphics_opengl *Render_graphics_opengl_create_vertex_buffer_object_displ
 Render_graphics_opengl *Render_graphics_opengl_create_webgl_renderer(const char *filename);
 
 /** @param outputStringsRef  Reference to vector of strings to fill with the output strings.
- * Client must ensure this exists through the lifetime of the returned object. */
+ * Client must ensure this exists through the lifetime of the returned object.
+ * @param numberOfThreads  Maximum threads for building graphics and
+ * formatting morph targets of time steps in parallel, 0 for all context
+ * threads, or 1 to export each time step in turn. */
 Render_graphics_opengl *Render_graphics_opengl_create_threejs_renderer(
 	const char *file_prefix, int number_of_time_steps, double begin_time,
 	double end_time, enum cmzn_streaminformation_scene_io_data_type mode,
 	int *number_of_entries, std::vector<std::string>& outputStringsRef,
 	int morphVertices, int morphColours, int morphNormals,
-	int numberOfFiles, char **file_names, int isInline);
+	int numberOfFiles, char **file_names, int isInline, int numberOfThreads = 1);
 
 /** Routine that uses the objects material and spectrum to convert
 * an array of data to corresponding colour data.
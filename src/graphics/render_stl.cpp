@@ -12,9 +12,15 @@ Renders gtObjects to STL stereolithography file.
 * License, v. 2.0. If a copy of the MPL was not distributed with this
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
+#include <algorithm>
+#include <cstdint>
+#include <cstring>
+#include <limits>
 #include <sstream>
 #include <stack>
 #include <stdio.h>
+#include <unordered_map>
+#include <vector>
 #include "cmlibs/zinc/region.h"
 #include "general/debug.h"
 #include "general/matrix_vector.h"
@@ -104,48 +110,22 @@ public:
 	}
 };
 
+/**
+ * Base context for writing surface triangles, maintaining the transformation
+ * stack for glyphs. Derived classes output each non-degenerate triangle.
+ */
 class Stl_context
 {
 private:
-    std::ostringstream stl_content;
-    std::string solid_name;
-	/* Future: add binary option */
 	std::stack<Transformation_matrix> transformation_stack;
 
 public:
-    Stl_context(const char *solid_name_in) :
-        stl_content(),
-        solid_name(solid_name_in == nullptr ? "default" : solid_name_in)
-	{
-	}
-
-	~Stl_context()
+	Stl_context()
 	{
 	}
 
-    void begin()
-    {
-        stl_content << "solid " << this->solid_name << std::endl;
-    }
-
-    std::string get_export_string() const
-    {
-        return stl_content.str();
-    }
-
-    void end()
-    {
-        stl_content << "endsolid " << this->solid_name << std::endl;
-    }
-
-    /**
-     * Confirms STL content is not malformed.
-	 * 
-     * @return @c true if content is not malformed, @c false if not.
-	 */
-	bool is_valid() const
+	virtual ~Stl_context()
 	{
-        return !solid_name.empty();
 	}
 
 /**
@@ -192,7 +172,7 @@ public:
 	}
 
 	/***************************************************************************//**
-     * Writes a single STL triangle to string.
+	 * Transforms a single triangle and outputs it if it has a valid normal.
 	 * 
 	 * @param v1 coordinates of first vertex
 	 * @param v2 coordinates of second vertex
@@ -216,18 +196,378 @@ public:
 		cross_product3(tangent1, tangent2, normal);
 		if (0.0 < normalize3(normal))
 		{
-            this->stl_content << "facet normal " << (ZnReal)normal[0] << " " << (ZnReal)normal[1] << " " << (ZnReal)normal[2] << std::endl;
-            this->stl_content << " outer loop" << std::endl;
-            this->stl_content << "  vertex " << (ZnReal)tv1[0] << " " << (ZnReal)tv1[1] << " " << (ZnReal)tv1[2] << std::endl;
-            this->stl_content << "  vertex " << (ZnReal)tv2[0] << " " << (ZnReal)tv2[1] << " " << (ZnReal)tv2[2] << std::endl;
-            this->stl_content << "  vertex " << (ZnReal)tv3[0] << " " << (ZnReal)tv3[1] << " " << (ZnReal)tv3[2] << std::endl;
-            this->stl_content << " endloop" << std::endl;
-            this->stl_content << "endfacet" << std::endl;
+			this->output_triangle(tv1, tv2, tv3, normal);
 		}
 	} /* write_triangle_stl */
 
+protected:
+	/** Output transformed triangle vertices with unit normal. */
+	virtual void output_triangle(const ZnReal *tv1, const ZnReal *tv2,
+		const ZnReal *tv3, const ZnReal *normal) = 0;
+
 }; /* class Stl_context */
 
+/** Writes triangles to a string in ASCII STL format. */
+class Stl_ascii_context : public Stl_context
+{
+private:
+    std::ostringstream stl_content;
+    std::string solid_name;
+
+public:
+    Stl_ascii_context(const char *solid_name_in) :
+        stl_content(),
+        solid_name(solid_name_in == nullptr ? "default" : solid_name_in)
+	{
+	}
+
+    void begin()
+    {
+        stl_content << "solid " << this->solid_name << std::endl;
+    }
+
+    std::string get_export_string() const
+    {
+        return stl_content.str();
+    }
+
+    void end()
+    {
+        stl_content << "endsolid " << this->solid_name << std::endl;
+    }
+
+    /**
+     * Confirms STL content is not malformed.
+	 * 
+     * @return @c true if content is not malformed, @c false if not.
+	 */
+	bool is_valid() const
+	{
+        return !solid_name.empty();
+	}
+
+protected:
+	virtual void output_triangle(const ZnReal *tv1, const ZnReal *tv2,
+		const ZnReal *tv3, const ZnReal *normal)
+	{
+        this->stl_content << "facet normal " << (ZnReal)normal[0] << " " << (ZnReal)normal[1] << " " << (ZnReal)normal[2] << std::endl;
+        this->stl_content << " outer loop" << std::endl;
+        this->stl_content << "  vertex " << (ZnReal)tv1[0] << " " << (ZnReal)tv1[1] << " " << (ZnReal)tv1[2] << std::endl;
+        this->stl_content << "  vertex " << (ZnReal)tv2[0] << " " << (ZnReal)tv2[1] << " " << (ZnReal)tv2[2] << std::endl;
+        this->stl_content << "  vertex " << (ZnReal)tv3[0] << " " << (ZnReal)tv3[1] << " " << (ZnReal)tv3[2] << std::endl;
+        this->stl_content << " endloop" << std::endl;
+        this->stl_content << "endfacet" << std::endl;
+	}
+
+}; /* class Stl_ascii_context */
+
+/**
+ * Writes binary output in little endian byte order either to a file through
+ * a fixed size chunk, or to a memory buffer allocated once at its final size.
+ */
+class Binary_output
+{
+private:
+	FILE *file;
+	char *buffer;
+	size_t buffer_size, position;
+	bool failed;
+	std::vector<char> chunk;
+
+	void flush_chunk()
+	{
+		if (this->file && (this->position > 0))
+		{
+			if (fwrite(this->chunk.data(), 1, this->position, this->file) != this->position)
+			{
+				this->failed = true;
+			}
+			this->position = 0;
+		}
+	}
+
+public:
+	Binary_output() :
+		file(nullptr),
+		buffer(nullptr),
+		buffer_size(0),
+		position(0),
+		failed(false)
+	{
+	}
+
+	~Binary_output()
+	{
+		if (this->file)
+		{
+			fclose(this->file);
+		}
+		if (this->buffer)
+		{
+			DEALLOCATE(this->buffer);
+		}
+	}
+
+	bool open_file(const char *file_name)
+	{
+		this->file = fopen(file_name, "wb");
+		if (!this->file)
+		{
+			display_message(ERROR_MESSAGE, "Binary_output::open_file.  Could not open file %s", file_name);
+			return false;
+		}
+		this->chunk.resize(1 << 20);
+		this->buffer_size = this->chunk.size();
+		return true;
+	}
+
+	bool allocate_memory(size_t size)
+	{
+		if ((size > static_cast<size_t>(std::numeric_limits<unsigned int>::max())) ||
+			(!ALLOCATE(this->buffer, char, (size > 0) ? size : 1)))
+		{
+			display_message(ERROR_MESSAGE, "Binary_output::allocate_memory.  Could not allocate output buffer");
+			return false;
+		}
+		this->buffer_size = size;
+		return true;
+	}
+
+	void write(const void *data, size_t length)
+	{
+		const char *source = static_cast<const char *>(data);
+		char *target = (this->file) ? this->chunk.data() : this->buffer;
+		while (length > 0)
+		{
+			if (this->position == this->buffer_size)
+			{
+				if (!this->file)
+				{
+					this->failed = true;
+					return;
+				}
+				this->flush_chunk();
+			}
+			const size_t copy_length = std::min(length, this->buffer_size - this->position);
+			memcpy(target + this->position, source, copy_length);
+			this->position += copy_length;
+			source += copy_length;
+			length -= copy_length;
+		}
+	}
+
+	void write_uint8(unsigned char value)
+	{
+		this->write(&value, 1);
+	}
+
+	void write_uint16(uint16_t value)
+	{
+		const unsigned char bytes[2] = {
+			static_cast<unsigned char>(value & 0xff), static_cast<unsigned char>(value >> 8) };
+		this->write(bytes, 2);
+	}
+
+	void write_uint32(uint32_t value)
+	{
+		const unsigned char bytes[4] = {
+			static_cast<unsigned char>(value & 0xff), static_cast<unsigned char>((value >> 8) & 0xff),
+			static_cast<unsigned char>((value >> 16) & 0xff), static_cast<unsigned char>(value >> 24) };
+		this->write(bytes, 4);
+	}
+
+	void write_float(float value)
+	{
+		uint32_t bits;
+		memcpy(&bits, &value, 4);
+		this->write_uint32(bits);
+	}
+
+	/**
+	 * Finish output, flushing and closing the file if any.
+	 * @return  True if all output was written.
+	 */
+	bool finish()
+	{
+		if (this->file)
+		{
+			this->flush_chunk();
+			if (0 != fclose(this->file))
+			{
+				this->failed = true;
+			}
+			this->file = nullptr;
+		}
+		else if (this->position != this->buffer_size)
+		{
+			this->failed = true;
+		}
+		return !this->failed;
+	}
+
+	/** Take ownership of memory buffer; caller must DEALLOCATE. */
+	char *release_memory_buffer(unsigned int& size)
+	{
+		char *released_buffer = this->buffer;
+		size = static_cast<unsigned int>(this->buffer_size);
+		this->buffer = nullptr;
+		this->buffer_size = 0;
+		return released_buffer;
+	}
+};
+
+/** Writes triangles in binary STL format: normal, 3 vertices, attribute count. */
+class Stl_binary_context : public Stl_context
+{
+private:
+	Binary_output& output;
+
+public:
+	Stl_binary_context(Binary_output& output_in) :
+		output(output_in)
+	{
+	}
+
+protected:
+	virtual void output_triangle(const ZnReal *tv1, const ZnReal *tv2,
+		const ZnReal *tv3, const ZnReal *normal)
+	{
+		const ZnReal *values[4] = { normal, tv1, tv2, tv3 };
+		for (int i = 0; i < 4; ++i)
+		{
+			for (int j = 0; j < 3; ++j)
+			{
+				this->output.write_float(static_cast<float>(values[i][j]));
+			}
+		}
+		this->output.write_uint16(0);
+	}
+};
+
+/** Vertex position in single precision as written, for welding. */
+struct Ply_vertex
+{
+	float x[3];
+
+	Ply_vertex(const ZnReal *v)
+	{
+		for (int i = 0; i < 3; ++i)
+		{
+			// add zero so -0.0 and 0.0 weld
+			this->x[i] = static_cast<float>(v[i]) + 0.0f;
+		}
+	}
+
+	bool operator==(const Ply_vertex& other) const
+	{
+		return (this->x[0] == other.x[0]) && (this->x[1] == other.x[1]) && (this->x[2] == other.x[2]);
+	}
+};
+
+struct Ply_vertex_hash
+{
+	size_t operator()(const Ply_vertex& vertex) const
+	{
+		size_t hash = 0;
+		for (int i = 0; i < 3; ++i)
+		{
+			uint32_t bits;
+			memcpy(&bits, &vertex.x[i], 4);
+			hash = hash*1000003 ^ static_cast<size_t>(bits);
+		}
+		return hash;
+	}
+};
+
+typedef std::unordered_map<Ply_vertex, uint32_t, Ply_vertex_hash> Ply_vertex_index_map;
+
+/**
+ * If output is supplied, writes all 3 vertices of each triangle in order for
+ * PLY. Otherwise counts triangles and, if welding, finds unique vertices in
+ * order of first use.
+ */
+class Ply_vertex_context : public Stl_context
+{
+private:
+	Binary_output *output;
+	Ply_vertex_index_map *vertex_index_map;
+	std::vector<Ply_vertex> *unique_vertices;
+	size_t triangle_count;
+
+	void add_vertex(const ZnReal *v)
+	{
+		const Ply_vertex vertex(v);
+		if (this->output)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				this->output->write_float(vertex.x[i]);
+			}
+		}
+		else if (this->vertex_index_map)
+		{
+			const uint32_t index = static_cast<uint32_t>(this->unique_vertices->size());
+			if (this->vertex_index_map->insert(std::make_pair(vertex, index)).second)
+			{
+				this->unique_vertices->push_back(vertex);
+			}
+		}
+	}
+
+public:
+	Ply_vertex_context(Binary_output *output_in, Ply_vertex_index_map *vertex_index_map_in,
+		std::vector<Ply_vertex> *unique_vertices_in) :
+		output(output_in),
+		vertex_index_map(vertex_index_map_in),
+		unique_vertices(unique_vertices_in),
+		triangle_count(0)
+	{
+	}
+
+	size_t get_triangle_count() const
+	{
+		return this->triangle_count;
+	}
+
+protected:
+	virtual void output_triangle(const ZnReal *tv1, const ZnReal *tv2,
+		const ZnReal *tv3, const ZnReal *)
+	{
+		this->add_vertex(tv1);
+		this->add_vertex(tv2);
+		this->add_vertex(tv3);
+		++this->triangle_count;
+	}
+};
+
+/** Second pass for welded PLY output writing faces with unique vertex indices. */
+class Ply_welded_face_context : public Stl_context
+{
+private:
+	Binary_output& output;
+	const Ply_vertex_index_map& vertex_index_map;
+
+public:
+	Ply_welded_face_context(Binary_output& output_in, const Ply_vertex_index_map& vertex_index_map_in) :
+		output(output_in),
+		vertex_index_map(vertex_index_map_in)
+	{
+	}
+
+protected:
+	virtual void output_triangle(const ZnReal *tv1, const ZnReal *tv2,
+		const ZnReal *tv3, const ZnReal *)
+	{
+		this->output.write_uint8(3);
+		const ZnReal *values[3] = { tv1, tv2, tv3 };
+		for (int i = 0; i < 3; ++i)
+		{
+			Ply_vertex_index_map::const_iterator iter = this->vertex_index_map.find(Ply_vertex(values[i]));
+			this->output.write_uint32((iter != this->vertex_index_map.end()) ? iter->second : 0);
+		}
+	}
+};
+
 /*
 Module functions
 ----------------
@@ -624,7 +964,7 @@ std::string export_to_stl(cmzn_scene_id scene, cmzn_scenefilter_id filter)
 	{
 		build_Scene(scene, filter);
 		char *solid_name = cmzn_region_get_name(cmzn_scene_get_region_internal(scene));
-        Stl_context stl_context(solid_name);
+        Stl_ascii_context stl_context(solid_name);
         DEALLOCATE(solid_name);
         if (stl_context.is_valid())
 		{
@@ -649,3 +989,121 @@ std::string export_to_stl(cmzn_scene_id scene, cmzn_scenefilter_id filter)
 
     return content;
 } /* export_to_stl */
+
+int export_to_binary_triangles(cmzn_scene_id scene, cmzn_scenefilter_id filter,
+	Binary_triangles_format format, bool weld_vertices, const char *file_name,
+	char **memory_buffer_out, unsigned int *memory_buffer_size_out)
+{
+	if ((!scene) || ((!file_name) && ((!memory_buffer_out) || (!memory_buffer_size_out))))
+	{
+		display_message(ERROR_MESSAGE, "export_to_binary_triangles.  Invalid argument(s)");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	build_Scene(scene, filter);
+	const bool ply = (format == BINARY_TRIANGLES_FORMAT_PLY);
+	const bool weld = ply && weld_vertices;
+	// first pass counts triangles and finds unique vertices if welding
+	Ply_vertex_index_map vertex_index_map;
+	std::vector<Ply_vertex> unique_vertices;
+	Ply_vertex_context count_context(/*output*/nullptr,
+		weld ? &vertex_index_map : nullptr, weld ? &unique_vertices : nullptr);
+	int return_code = write_scene_stl(count_context, scene, filter);
+	if (return_code != CMZN_OK)
+	{
+		return return_code;
+	}
+	const size_t triangle_count = count_context.get_triangle_count();
+	if (triangle_count > static_cast<size_t>(std::numeric_limits<uint32_t>::max()))
+	{
+		display_message(ERROR_MESSAGE, "export_to_binary_triangles.  Too many triangles");
+		return CMZN_ERROR_GENERAL;
+	}
+	const size_t vertex_count = weld ? unique_vertices.size() : 3*triangle_count;
+	// PLY faces index vertices with 32-bit unsigned integers
+	if (ply && (vertex_count > static_cast<size_t>(std::numeric_limits<uint32_t>::max())))
+	{
+		display_message(ERROR_MESSAGE, "export_to_binary_triangles.  Too many vertices");
+		return CMZN_ERROR_GENERAL;
+	}
+	std::string ply_header;
+	size_t output_size;
+	if (ply)
+	{
+		std::ostringstream header;
+		header << "ply\n"
+			<< "format binary_little_endian 1.0\n"
+			<< "comment Zinc scene export\n"
+			<< "element vertex " << vertex_count << "\n"
+			<< "property float x\n"
+			<< "property float y\n"
+			<< "property float z\n"
+			<< "element face " << triangle_count << "\n"
+			<< "property list uchar uint vertex_indices\n"
+			<< "end_header\n";
+		ply_header = header.str();
+		output_size = ply_header.size() + 12*vertex_count + 13*triangle_count;
+	}
+	else
+	{
+		output_size = 80 + 4 + 50*triangle_count;
+	}
+	Binary_output output;
+	if (!((file_name) ? output.open_file(file_name) : output.allocate_memory(output_size)))
+	{
+		return CMZN_ERROR_GENERAL;
+	}
+	if (ply)
+	{
+		output.write(ply_header.data(), ply_header.size());
+		if (weld)
+		{
+			for (std::vector<Ply_vertex>::const_iterator iter = unique_vertices.begin();
+				iter != unique_vertices.end(); ++iter)
+			{
+				for (int i = 0; i < 3; ++i)
+				{
+					output.write_float(iter->x[i]);
+				}
+			}
+			Ply_welded_face_context face_context(output, vertex_index_map);
+			return_code = write_scene_stl(face_context, scene, filter);
+		}
+		else
+		{
+			Ply_vertex_context vertex_context(&output, nullptr, nullptr);
+			return_code = write_scene_stl(vertex_context, scene, filter);
+			// faces use vertices in order so need no second pass over graphics
+			for (size_t i = 0; i < triangle_count; ++i)
+			{
+				output.write_uint8(3);
+				for (uint32_t j = 0; j < 3; ++j)
+				{
+					output.write_uint32(static_cast<uint32_t>(3*i) + j);
+				}
+			}
+		}
+	}
+	else
+	{
+		char header[80];
+		memset(header, 0, sizeof(header));
+		char *region_name = cmzn_region_get_name(cmzn_scene_get_region_internal(scene));
+		snprintf(header, sizeof(header), "Zinc binary STL export of region %s",
+			(region_name) ? region_name : "default");
+		DEALLOCATE(region_name);
+		output.write(header, sizeof(header));
+		output.write_uint32(static_cast<uint32_t>(triangle_count));
+		Stl_binary_context stl_context(output);
+		return_code = write_scene_stl(stl_context, scene, filter);
+	}
+	if (!output.finish())
+	{
+		display_message(ERROR_MESSAGE, "export_to_binary_triangles.  Failed to write output");
+		return CMZN_ERROR_GENERAL;
+	}
+	if ((return_code == CMZN_OK) && (!file_name))
+	{
+		*memory_buffer_out = output.release_memory_buffer(*memory_buffer_size_out);
+	}
+	return return_code;
+}
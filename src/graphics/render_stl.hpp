@@ -5,7 +5,7 @@
  * file, You can obtain one at http://mozilla.org/MPL/2.0/.
  */
 /*
- * Renders gtObjects to STL stereolithography file.
+ * Renders gtObjects to STL stereolithography or PLY file.
  */
 
 #pragma once
@@ -23,3 +23,35 @@ struct cmzn_scenefilter;
  * @return @c std::string in STL format on success, an empty string on failure
  */
 std::string export_to_stl(cmzn_scene *scene, cmzn_scenefilter *filter);
+
+/** Binary formats for export_to_binary_triangles */
+enum Binary_triangles_format
+{
+	BINARY_TRIANGLES_FORMAT_STL,
+	BINARY_TRIANGLES_FORMAT_PLY
+};
+
+/**
+ * Streams the visible surface triangles, including surface glyphs, to a file
+ * or memory buffer in binary STL or little endian binary PLY format. Triangles
+ * are written directly from the graphics vertex arrays in two passes over the
+ * graphics, the first counting triangles so the output size is known and
+ * memory output is allocated once at its final size.
+ *
+ * @param scene  The scene to output.
+ * @param filter  The filter on scene. Can be NULL.
+ * @param format  The binary format to write.
+ * @param weld_vertices  PLY only: if true, vertices at identical positions are
+ * merged and shared by faces; otherwise each face has its own 3 vertices.
+ * Ignored for STL which has no shared vertices.
+ * @param file_name  Name of file to write to, or NULL to write to memory.
+ * @param memory_buffer_out  If file_name is NULL, on success receives
+ * allocated buffer which caller must DEALLOCATE.
+ * @param memory_buffer_size_out  If file_name is NULL, on success receives
+ * size of memory buffer.
+ * @return  CMZN_OK on success, CMZN_ERROR_ARGUMENT if invalid arguments,
+ * otherwise CMZN_ERROR_GENERAL.
+ */
+int export_to_binary_triangles(cmzn_scene *scene, cmzn_scenefilter *filter,
+	Binary_triangles_format format, bool weld_vertices, const char *file_name,
+	char **memory_buffer_out, unsigned int *memory_buffer_size_out);
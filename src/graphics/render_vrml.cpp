@@ -463,6 +463,18 @@ Writes VRML to represent the value 'data' in accordance with the spectrum.
 	ENTER(spectrum_render_vrml_value);
 	if (spectrum&&material)
 	{
+		if (!cmzn_spectrum_is_material_overwrite(spectrum))
+		{
+			/* non-overwrite spectrums modify the material colour for each value */
+			struct Colour diffuse;
+			MATERIAL_PRECISION alpha;
+			Graphical_material_get_diffuse(material, &diffuse);
+			Graphical_material_get_alpha(material, &alpha);
+			rgba[0] = diffuse.red;
+			rgba[1] = diffuse.green;
+			rgba[2] = diffuse.blue;
+			rgba[3] = alpha;
+		}
 		FE_value *feData = new FE_value[number_of_data_components];
 		CAST_TO_FE_VALUE(feData,data,number_of_data_components);
 		Spectrum_value_to_rgba(spectrum,number_of_data_components,feData,rgba);
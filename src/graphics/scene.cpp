@@ -178,7 +178,9 @@ cmzn_scene::cmzn_scene(cmzn_region *regionIn, cmzn_graphics_module *graphicsmodu
 	selectionChanged(false),
 	selectionnotifier_list(0),
 	editorCopy(false),
-	access_count(1)
+	access_count(1),
+	boundingBoxBounded(false),
+	boundingBoxValid(false)
 {
 }
 
@@ -1121,6 +1123,9 @@ static int cmzn_scene_build_graphics_objects(
 			graphics_to_object_data.incrementalBuild = renderer->getIncrementalBuild();
 			graphics_to_object_data.selectionGroup = scene->getLocalSelectionGroupForHighlighting();
 			graphics_to_object_data.iso_surface_specification = 0;
+			graphics_to_object_data.iso_surface_elements = 0;
+			graphics_to_object_data.adaptive_discretization = 0;
+			graphics_to_object_data.backgroundBuild = 0;
 			for (int i = 0; i < MAXIMUM_ELEMENT_XI_DIMENSIONS; ++i)
 			{
 				graphics_to_object_data.top_level_number_in_xi[i] = 0;
@@ -1131,6 +1136,9 @@ static int cmzn_scene_build_graphics_objects(
 			cmzn_fieldcache_destroy(&graphics_to_object_data.field_cache);
 			cmzn_fieldmodule_end_change(graphics_to_object_data.field_module);
 			cmzn_fieldmodule_destroy(&graphics_to_object_data.field_module);
+			// region can only be frozen for background builds once not caching changes
+			FOR_EACH_OBJECT_IN_LIST(cmzn_graphics)(cmzn_graphics_start_background_build,
+				nullptr, scene->list_of_graphics);
 		}
 	}
 	else
@@ -1596,9 +1604,15 @@ int execute_cmzn_scene(struct cmzn_scene *scene,
 			else
 				glMultTransposeMatrixd(transmat);
 		}
-		renderer->time = (scene->time_notifier) ? cmzn_timenotifier_get_time(scene->time_notifier) : 0.0;
-		return_code = renderer->cmzn_scene_execute_graphics(scene);
-		return_code = renderer->cmzn_scene_execute_child_scene(scene);
+		/* skip scene and its child scenes if entirely outside the view frustum */
+		Graphics_object_range_struct boundingBox;
+		if (!((renderer->view_frustum_culling) && (!renderer->picking) &&
+			scene->getBoundingBox(boundingBox) && renderer->isOutsideViewFrustum(boundingBox)))
+		{
+			renderer->time = (scene->time_notifier) ? cmzn_timenotifier_get_time(scene->time_notifier) : 0.0;
+			return_code = renderer->cmzn_scene_execute_graphics(scene);
+			return_code = renderer->cmzn_scene_execute_child_scene(scene);
+		}
 		if (scene->transformationActive)
 		{
 			/* Restore starting modelview matrix */
@@ -2905,6 +2919,74 @@ int cmzn_scene::getCoordinatesRange(cmzn_scenefilter *filter, double *minimumVal
 	return CMZN_OK;
 }
 
+bool cmzn_scene::getBoundingBox(Graphics_object_range_struct& boxOut)
+{
+	if (!this->boundingBoxValid)
+	{
+		cmzn_graphics_bounding_box graphicsBoundingBox;
+		FOR_EACH_OBJECT_IN_LIST(cmzn_graphics)(cmzn_graphics_add_bounding_box,
+			(void *)&graphicsBoundingBox, this->list_of_graphics);
+		Graphics_object_range_struct& box = graphicsBoundingBox.box;
+		bool bounded = graphicsBoundingBox.bounded;
+		cmzn_region *childRegion = (this->region) ? this->region->getFirstChild() : nullptr;
+		for (; childRegion; childRegion = childRegion->getNextSibling())
+		{
+			cmzn_scene *childScene = childRegion->getScene();
+			if (!childScene)
+				continue;
+			Graphics_object_range_struct childBox;
+			// always evaluate so child box is cached
+			if (!childScene->getBoundingBox(childBox))
+				bounded = false;
+			if ((!bounded) || (childBox.first))
+				continue;
+			if (!childScene->transformationActive)
+			{
+				box.addRange(childBox);
+				continue;
+			}
+			// transformation from field may vary without notification
+			double matrix[16];
+			if ((childScene->transformationField) ||
+				(CMZN_OK != childScene->getTransformationMatrixRowMajor(matrix)))
+			{
+				bounded = false;
+				continue;
+			}
+			for (int c = 0; c < 8; ++c)
+			{
+				const double x[3] =
+				{
+					(c & 1) ? childBox.maximum[0] : childBox.minimum[0],
+					(c & 2) ? childBox.maximum[1] : childBox.minimum[1],
+					(c & 4) ? childBox.maximum[2] : childBox.minimum[2]
+				};
+				double transformed[4];
+				for (int row = 0; row < 4; ++row)
+					transformed[row] = matrix[row*4]*x[0] + matrix[row*4 + 1]*x[1] +
+						matrix[row*4 + 2]*x[2] + matrix[row*4 + 3];
+				if (transformed[3] <= 0.0)
+				{
+					bounded = false;
+					break;
+				}
+				const GLfloat point[3] =
+				{
+					static_cast<GLfloat>(transformed[0]/transformed[3]),
+					static_cast<GLfloat>(transformed[1]/transformed[3]),
+					static_cast<GLfloat>(transformed[2]/transformed[3])
+				};
+				box.addPoint(point);
+			}
+		}
+		this->boundingBox = box;
+		this->boundingBoxBounded = bounded;
+		this->boundingBoxValid = true;
+	}
+	boxOut = this->boundingBox;
+	return this->boundingBoxBounded;
+}
+
 int cmzn_scene::getCoordinatesRangeCentreSize(cmzn_scenefilter *filter, double *centre3,
 	double *size3)
 {
@@ -3154,14 +3236,14 @@ int Scene_render_threejs(cmzn_scene_id scene,
 	cmzn_streaminformation_scene_io_data_type export_mode,
 	int *number_of_entries, std::vector<std::string>& outputStringsRef,
 	int morphVertices, int morphColours, int morphNormals,
-	int numberOfFiles, char **file_names, int isInline)
+	int numberOfFiles, char **file_names, int isInline, int numberOfThreads)
 {
 	if (scene)
 	{
 		Render_graphics_opengl *renderer = Render_graphics_opengl_create_threejs_renderer(
 			file_prefix, number_of_time_steps, begin_time, end_time, export_mode, number_of_entries,
 			outputStringsRef, morphVertices, morphColours, morphNormals, numberOfFiles, file_names,
-			isInline);
+			isInline, numberOfThreads);
 		renderer->Scene_compile(scene, scenefilter);
 		renderer->Scene_tree_execute(scene);
 		delete renderer;
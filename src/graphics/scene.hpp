@@ -76,6 +76,10 @@ struct cmzn_scene
 private:
 	SceneCoordinateFieldWrapperMap coordinateFieldWrappers;
 	SceneVectorFieldWrapperMap vectorFieldWrappers;
+	// cached bounding box in local coordinates, see getBoundingBox()
+	Graphics_object_range_struct boundingBox;
+	bool boundingBoxBounded;
+	bool boundingBoxValid;
 
 private:
 	cmzn_scene(cmzn_region *regionIn, cmzn_graphics_module *graphicsmoduleIn);
@@ -235,6 +239,22 @@ public:
 	int getCoordinatesRangeCentreSize(cmzn_scenefilter *filter, double *centre3,
 		double *size3);
 
+	/** Get conservative bounding box of all built graphics in this scene and
+	 * its child scenes, in the local coordinates of this scene. The box is
+	 * cached until the scene, its graphics or child scenes change.
+	 * @param boxOut  Receives the box, which is empty if there is nothing to draw.
+	 * @return  True if bounded, false if any graphics cannot be bounded e.g.
+	 * are not in local coordinates, or have labels with a fixed size on screen. */
+	bool getBoundingBox(Graphics_object_range_struct& boxOut);
+
+	/** Mark the cached bounding box of this scene and its ancestors as needing
+	  * recalculation. Call when graphics objects are rebuilt. */
+	void invalidateBoundingBox()
+	{
+		for (cmzn_scene *scene = this; scene; scene = scene->getParent())
+			scene->boundingBoxValid = false;
+	}
+
 	void timeChange(cmzn_timenotifierevent_id timenotifierevent);
 
 	/** Notify registered clients of change in the scene */
@@ -256,6 +276,7 @@ public:
 	  * For internal use only; called by changed graphics to owning scene. */
 	void setChanged()
 	{
+		this->invalidateBoundingBox();
 		this->changed = 1;
 		if (0 == this->cache)
 			this->notifyClients();
@@ -547,14 +568,18 @@ char *cmzn_streaminformation_scene_io_data_type_enum_to_string(
 	enum cmzn_streaminformation_scene_io_data_type mode);
 
 /** @param outputStringsRef  Reference to vector of strings to fill with the output strings.
- * Client must ensure this exists through the lifetime of the returned object. */
+ * Client must ensure this exists through the lifetime of the returned object.
+ * @param numberOfThreads  Maximum threads for building graphics and
+ * formatting morph targets of time steps in parallel, 0 for all context
+ * threads, or 1 to export each time step in turn. Only graphics supporting
+ * it are built concurrently; others are built for each time step in turn. */
 int Scene_render_threejs(cmzn_scene_id scene,
 	cmzn_scenefilter_id scenefilter, const char *filename,
 	int number_of_time_steps, double begin_time, double end_time,
 	cmzn_streaminformation_scene_io_data_type export_mode,
 	int *number_of_entries, std::vector<std::string>& outputStringsRef,
 	int morphColours, int morphNormals, int morphVertices,
-	int numberOfFiles, char **file_names, int isInline);
+	int numberOfFiles, char **file_names, int isInline, int numberOfThreads = 1);
 
 int Scene_render_webgl(cmzn_scene_id scene,
 	cmzn_scenefilter_id scenefilter, const char *name_prefix);
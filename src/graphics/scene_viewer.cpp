@@ -111,6 +111,39 @@ void cmzn_sceneviewer::setRenderTimeout(double timeout)
 	}
 }
 
+int cmzn_sceneviewer::setLodMemoryBudget(double budget)
+{
+	if (!(budget >= 0.0))
+		return CMZN_ERROR_ARGUMENT;
+	if (budget != this->lod_memory_budget)
+	{
+		this->lod_memory_budget = budget;
+		// as for render timeout, notify clients of the setting change
+		this->setChangedTransformOnly();
+	}
+	return CMZN_OK;
+}
+
+void cmzn_sceneviewer::setShowPartialGraphics(bool value)
+{
+	if (value != this->show_partial_graphics)
+	{
+		this->show_partial_graphics = value;
+		// as for render timeout, notify clients of the setting change
+		this->setChangedTransformOnly();
+	}
+}
+
+void cmzn_sceneviewer::setBuildInBackground(bool value)
+{
+	if (value != this->build_in_background)
+	{
+		this->build_in_background = value;
+		// as for render timeout, notify clients of the setting change
+		this->setChangedTransformOnly();
+	}
+}
+
 int cmzn_sceneviewer::setBackgroundColourAlpha(double alpha)
 {
 	this->background_colour.alpha = alpha;
@@ -2119,6 +2152,7 @@ Scene_viewer_render_scene_in_viewport to access this function.
 //			}
 
 			rendering_data.renderer->set_world_view_matrix(scene_viewer->modelview_matrix);
+			rendering_data.renderer->view_frustum_culling = true;
 			rendering_data.renderer->viewport_width = (double)rendering_data.viewport_width;
 			rendering_data.renderer->viewport_height = (double)rendering_data.viewport_height;
 			double NDC_left, NDC_top, NDC_width, NDC_height;
@@ -2130,9 +2164,13 @@ Scene_viewer_render_scene_in_viewport to access this function.
 			GraphicsIncrementalBuild *incrementalBuild = nullptr;
 			if (scene_viewer->render_timeout >= 0.0)
 			{
-				incrementalBuild = new GraphicsIncrementalBuild(scene_viewer->render_timeout);
+				incrementalBuild = new GraphicsIncrementalBuild(scene_viewer->render_timeout,
+					scene_viewer->show_partial_graphics, scene_viewer->build_in_background);
 			}
 			rendering_data.renderer->setIncrementalBuild(incrementalBuild);
+			GraphicsLevelOfDetail& levelOfDetail = *(scene_viewer->levelOfDetail);
+			levelOfDetail.beginFrame(scene_viewer->lod_memory_budget*1048576.0);
+			rendering_data.renderer->setLevelOfDetail(&levelOfDetail);
 			rendering_data.renderer->Scene_compile(scene_viewer->scene, scene_viewer->filter);
 
 			rendering_data.render_callstack = CREATE(LIST(Scene_viewer_render_object))();
@@ -2379,6 +2417,12 @@ Scene_viewer_render_scene_in_viewport to access this function.
 				}
 				delete incrementalBuild;
 			}
+			levelOfDetail.enforceMemoryBudget();
+			if (levelOfDetail.isMoreWorkToDo())
+			{
+				// request another redraw to build levels of detail wanted for the view
+				scene_viewer->scene->setChanged();
+			}
 		}
 		scene_viewer->frame_count++;
 	}
@@ -3121,6 +3165,10 @@ struct Scene_viewer *CREATE(Scene_viewer)(struct Graphics_buffer *graphics_buffe
 #endif /* defined (WIN32_SYSTEM) */
 				scene_viewer->frame_count = 0;
 				scene_viewer->render_timeout = 1.0;
+				scene_viewer->lod_memory_budget = 256.0;
+				scene_viewer->levelOfDetail = new GraphicsLevelOfDetail();
+				scene_viewer->show_partial_graphics = true;
+				scene_viewer->build_in_background = false;
 
 				scene_viewer->scene = 0;
 				Scene_viewer_awaken(scene_viewer);
@@ -3175,6 +3223,8 @@ Closes the scene_viewer and disposes of the scene_viewer data structure.
 		/* send the destroy callbacks */
 
 		/* dispose of our data structure */
+		delete scene_viewer->levelOfDetail;
+		scene_viewer->levelOfDetail = nullptr;
 		DESTROY(LIST(cmzn_light))(&(scene_viewer->list_of_lights));
 		if (scene_viewer->order_independent_transparency_data)
 		{
@@ -4682,6 +4732,68 @@ int cmzn_sceneviewer_set_render_timeout(cmzn_sceneviewer_id sceneviewer, double
 	return CMZN_ERROR_ARGUMENT;
 }
 
+double cmzn_sceneviewer_get_lod_memory_budget(cmzn_sceneviewer_id sceneviewer)
+{
+	if (sceneviewer)
+	{
+		return sceneviewer->getLodMemoryBudget();
+	}
+	display_message(ERROR_MESSAGE, "cmzn_sceneviewer_get_lod_memory_budget.  Invalid argument(s)");
+	return 0.0;
+}
+
+int cmzn_sceneviewer_set_lod_memory_budget(cmzn_sceneviewer_id sceneviewer, double budget)
+{
+	if (sceneviewer)
+	{
+		return sceneviewer->setLodMemoryBudget(budget);
+	}
+	display_message(ERROR_MESSAGE, "cmzn_sceneviewer_set_lod_memory_budget.  Invalid argument(s)");
+	return CMZN_ERROR_ARGUMENT;
+}
+
+bool cmzn_sceneviewer_get_show_partial_graphics_flag(cmzn_sceneviewer_id sceneviewer)
+{
+	if (sceneviewer)
+	{
+		return sceneviewer->isShowPartialGraphics();
+	}
+	display_message(ERROR_MESSAGE, "cmzn_sceneviewer_get_show_partial_graphics_flag.  Invalid argument(s)");
+	return false;
+}
+
+int cmzn_sceneviewer_set_show_partial_graphics_flag(cmzn_sceneviewer_id sceneviewer, bool value)
+{
+	if (sceneviewer)
+	{
+		sceneviewer->setShowPartialGraphics(value);
+		return CMZN_OK;
+	}
+	display_message(ERROR_MESSAGE, "cmzn_sceneviewer_set_show_partial_graphics_flag.  Invalid argument(s)");
+	return CMZN_ERROR_ARGUMENT;
+}
+
+bool cmzn_sceneviewer_get_build_in_background_flag(cmzn_sceneviewer_id sceneviewer)
+{
+	if (sceneviewer)
+	{
+		return sceneviewer->isBuildInBackground();
+	}
+	display_message(ERROR_MESSAGE, "cmzn_sceneviewer_get_build_in_background_flag.  Invalid argument(s)");
+	return false;
+}
+
+int cmzn_sceneviewer_set_build_in_background_flag(cmzn_sceneviewer_id sceneviewer, bool value)
+{
+	if (sceneviewer)
+	{
+		sceneviewer->setBuildInBackground(value);
+		return CMZN_OK;
+	}
+	display_message(ERROR_MESSAGE, "cmzn_sceneviewer_set_build_in_background_flag.  Invalid argument(s)");
+	return CMZN_ERROR_ARGUMENT;
+}
+
 enum cmzn_sceneviewer_interact_mode cmzn_sceneviewer_get_interact_mode(
 	cmzn_sceneviewer_id sceneviewer)
 {
@@ -35,6 +35,7 @@ translating and zooming with mouse button press and motion events.
 #include <list>
 
 struct Graphics_buffer;
+class GraphicsLevelOfDetail;
 #define Graphics_buffer_input cmzn_sceneviewerinput
 #define Graphics_buffer_input_event_type cmzn_sceneviewerinput_event_type
 
@@ -440,6 +441,14 @@ struct cmzn_sceneviewer
 
 	// Target duration of incremental graphics update
 	double render_timeout;
+	// Memory limit for cached coarser graphics levels of detail, in megabytes
+	double lod_memory_budget;
+	// selects levels of detail and evicts them over all frames; owned
+	GraphicsLevelOfDetail *levelOfDetail;
+	// if false, draw previously built graphics until incremental rebuild is complete
+	bool show_partial_graphics;
+	// if true, build graphics on background threads where possible
+	bool build_in_background;
 
 	cmzn_sceneviewer *access()
 	{
@@ -486,6 +495,29 @@ struct cmzn_sceneviewer
 	/** @param timeout  Render timeout in seconds or negative to disable incremental build */
 	void setRenderTimeout(double timeout);
 
+	double getLodMemoryBudget() const
+	{
+		return this->lod_memory_budget;
+	}
+
+	/** @param budget  Memory budget in megabytes >= 0.0
+	 * @return  CMZN_OK on success, CMZN_ERROR_ARGUMENT if invalid budget */
+	int setLodMemoryBudget(double budget);
+
+	bool isShowPartialGraphics() const
+	{
+		return this->show_partial_graphics;
+	}
+
+	void setShowPartialGraphics(bool value);
+
+	bool isBuildInBackground() const
+	{
+		return this->build_in_background;
+	}
+
+	void setBuildInBackground(bool value);
+
 	/**
 	 * @param  localToWorldTransformationMatrix  Optional.
 	 * @return CMZN_OK on success, any other error on failure
@@ -14,6 +14,7 @@
 #include "general/debug.h"
 #include "general/indexed_list_private.h"
 #include "general/indexed_list_stl_private.hpp"
+#include <map>
 
 const char *defaultVertex = "varying vec3 lightPos, eyeVertex, eyeNormal;\n"
 							"varying vec4 diffuse;\n"
@@ -2905,6 +2906,179 @@ int cmzn_shaderprogram_execute_uniforms(cmzn_shaderprogram_id shader_program,
 	return 0;
 }
 
+namespace {
+
+/* Resolves glyph axes from per-instance attributes as for
+ * CMZN_GLYPH_REPEAT_MODE_NONE in resolve_glyph_axes, transforms the glyph
+ * vertex and normal by them, and lights them as the fixed function pipeline
+ * does from the lightCount enabled lights listed in lightIndexes, with the
+ * per-instance colour replacing material ambient and diffuse if enabled.
+ * Back faces are lit with the back material only if twoSided. */
+const char *instancedGlyphVertex = "#version 120\n"
+	"attribute vec3 glyphPosition, glyphAxis1, glyphAxis2, glyphAxis3, glyphScale;\n"
+	"attribute vec4 glyphColour;\n"
+	"uniform vec3 baseSize, scaleFactors, offset;\n"
+	"uniform int useGlyphColour;\n"
+	"uniform int lightCount;\n"
+	"uniform int lightIndexes[8];\n"
+	"uniform int twoSided, localViewer;\n"
+	"\n"
+	"vec4 lightingColour(vec3 eyeNormal, vec3 eyeVertex, gl_MaterialParameters material)\n"
+	"{\n"
+	"  vec4 ambient = (0 != useGlyphColour) ? glyphColour : material.ambient;\n"
+	"  vec4 diffuse = (0 != useGlyphColour) ? glyphColour : material.diffuse;\n"
+	"  vec4 colour = material.emission + ambient*gl_LightModel.ambient;\n"
+	"  vec3 eyeVec = (0 != localViewer) ? -normalize(eyeVertex) : vec3(0.0, 0.0, 1.0);\n"
+	"  for (int i = 0; i < 8; ++i)\n"
+	"  {\n"
+	"    if (i >= lightCount)\n"
+	"      break;\n"
+	"    int l = lightIndexes[i];\n"
+	"    vec3 lightVec;\n"
+	"    float attenuation = 1.0;\n"
+	"    if (0.0 == gl_LightSource[l].position.w)\n"
+	"      lightVec = normalize(gl_LightSource[l].position.xyz);\n"
+	"    else\n"
+	"    {\n"
+	"      lightVec = gl_LightSource[l].position.xyz - eyeVertex;\n"
+	"      float d = length(lightVec);\n"
+	"      lightVec /= d;\n"
+	"      attenuation = 1.0/(gl_LightSource[l].constantAttenuation +\n"
+	"        d*(gl_LightSource[l].linearAttenuation + d*gl_LightSource[l].quadraticAttenuation));\n"
+	"      if (gl_LightSource[l].spotCutoff <= 90.0)\n"
+	"      {\n"
+	"        float spotCos = dot(-lightVec, normalize(gl_LightSource[l].spotDirection));\n"
+	"        attenuation *= (spotCos < gl_LightSource[l].spotCosCutoff) ? 0.0 :\n"
+	"          pow(spotCos, gl_LightSource[l].spotExponent);\n"
+	"      }\n"
+	"    }\n"
+	"    float NdotL = max(dot(eyeNormal, lightVec), 0.0);\n"
+	"    vec4 lightColour = ambient*gl_LightSource[l].ambient + NdotL*diffuse*gl_LightSource[l].diffuse;\n"
+	"    if (NdotL > 0.0)\n"
+	"    {\n"
+	"      float NdotHV = max(dot(eyeNormal, normalize(lightVec + eyeVec)), 0.0);\n"
+	"      lightColour += pow(NdotHV, material.shininess)*material.specular*gl_LightSource[l].specular;\n"
+	"    }\n"
+	"    colour += attenuation*lightColour;\n"
+	"  }\n"
+	"  colour.a = diffuse.a;\n"
+	"  return clamp(colour, 0.0, 1.0);\n"
+	"}\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"  vec3 scaleSign = vec3(1.0) - 2.0*vec3(lessThan(glyphScale, vec3(0.0)));\n"
+	"  vec3 axisScale = scaleSign*baseSize + glyphScale*scaleFactors;\n"
+	"  vec3 axis1 = glyphAxis1*axisScale.x;\n"
+	"  vec3 axis2 = glyphAxis2*axisScale.y;\n"
+	"  vec3 axis3 = glyphAxis3*axisScale.z;\n"
+	"  vec3 point = glyphPosition + offset.x*axis1 + offset.y*axis2 + offset.z*axis3;\n"
+	"  if (dot(axis3, cross(axis1, axis2)) < 0.0)\n"
+	"    axis3 = -axis3;\n"
+	"  vec4 vertex = vec4(point + mat3(axis1, axis2, axis3)*gl_Vertex.xyz, 1.0);\n"
+	"  // cofactor matrix is a positive multiple of the inverse transpose\n"
+	"  vec3 normal = mat3(cross(axis2, axis3), cross(axis3, axis1), cross(axis1, axis2))*gl_Normal;\n"
+	"  vec3 eyeVertex = vec3(gl_ModelViewMatrix*vertex);\n"
+	"  vec3 eyeNormal = normalize(gl_NormalMatrix*normal);\n"
+	"  gl_FrontColor = lightingColour(eyeNormal, eyeVertex, gl_FrontMaterial);\n"
+	"  gl_BackColor = (0 != twoSided) ? lightingColour(-eyeNormal, eyeVertex, gl_BackMaterial) : gl_FrontColor;\n"
+	"  gl_TexCoord[0] = gl_MultiTexCoord0;\n"
+	"  gl_Position = gl_ModelViewProjectionMatrix*vertex;\n"
+	"}\n";
+
+const char *instancedGlyphFragment = "#version 120\n"
+	"\n"
+	"void main()\n"
+	"{\n"
+	"  gl_FragColor = gl_Color;\n"
+	"}\n";
+
+#if defined (GL_VERSION_3_3)
+GLuint compileInstancedGlyphShader(GLenum shaderType, const char *source)
+{
+	GLuint shader = glCreateShader(shaderType);
+	glShaderSource(shader, 1, &source, NULL);
+	glCompileShader(shader);
+	GLint compiled = 0;
+	glGetShaderiv(shader, GL_COMPILE_STATUS, &compiled);
+	if (!compiled)
+	{
+		int infologLength = 0;
+		int charsWritten  = 0;
+		glGetShaderiv(shader, GL_INFO_LOG_LENGTH, &infologLength);
+		if (infologLength > 0)
+		{
+			char *infoLog = (char *)malloc(infologLength);
+			glGetShaderInfoLog(shader, infologLength, &charsWritten, infoLog);
+			display_message(INFORMATION_MESSAGE, "Instanced glyph %s program info:\n%s\n",
+				(GL_VERTEX_SHADER == shaderType) ? "vertex" : "fragment", infoLog);
+			free(infoLog);
+		}
+		glDeleteShader(shader);
+		shader = 0;
+	}
+	return shader;
+}
+#endif /* defined (GL_VERSION_3_3) */
+
+}
+
+unsigned int cmzn_shaderprogram_get_instanced_glyph_glslprogram()
+{
+#if defined (GL_VERSION_3_3)
+	/* programs are not shared between graphics contexts, so are built and
+	 * any failure remembered for each context */
+	static std::map<void *, GLuint> contextPrograms;
+	void *context = get_current_context();
+	std::map<void *, GLuint>::iterator iter = contextPrograms.find(context);
+	if (iter != contextPrograms.end())
+	{
+		/* zero if building failed in this context; rebuilt if deleted */
+		if ((0 == iter->second) || glIsProgram(iter->second))
+			return iter->second;
+		contextPrograms.erase(iter);
+	}
+	GLuint program = 0;
+	if (!Graphics_library_check_extension(GL_VERSION_3_3))
+	{
+		contextPrograms[context] = 0;
+		return 0;
+	}
+	GLuint vertexShader = compileInstancedGlyphShader(GL_VERTEX_SHADER, instancedGlyphVertex);
+	GLuint fragmentShader = compileInstancedGlyphShader(GL_FRAGMENT_SHADER, instancedGlyphFragment);
+	if (vertexShader && fragmentShader)
+	{
+		program = glCreateProgram();
+		glAttachShader(program, vertexShader);
+		glAttachShader(program, fragmentShader);
+		glBindAttribLocation(program, SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_POSITION, "glyphPosition");
+		glBindAttribLocation(program, SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_AXIS1, "glyphAxis1");
+		glBindAttribLocation(program, SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_AXIS2, "glyphAxis2");
+		glBindAttribLocation(program, SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_AXIS3, "glyphAxis3");
+		glBindAttribLocation(program, SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_SCALE, "glyphScale");
+		glBindAttribLocation(program, SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_COLOUR, "glyphColour");
+		glLinkProgram(program);
+		GLint linked = 0;
+		glGetProgramiv(program, GL_LINK_STATUS, &linked);
+		if (!linked)
+		{
+			display_message(WARNING_MESSAGE, "cmzn_shaderprogram_get_instanced_glyph_glslprogram.  "
+				"Failed to link program; glyphs will not be drawn instanced.");
+			glDeleteProgram(program);
+			program = 0;
+		}
+	}
+	if (vertexShader)
+		glDeleteShader(vertexShader);
+	if (fragmentShader)
+		glDeleteShader(fragmentShader);
+	contextPrograms[context] = program;
+	return program;
+#else
+	return 0;
+#endif /* defined (GL_VERSION_3_3) */
+}
+
 #endif /* defined (OPENGL_API) */
 
 int cmzn_shaderprogram_manager_set_owner_private(struct MANAGER(cmzn_shaderprogram) *manager,
@@ -178,6 +178,34 @@ int cmzn_shaderprogram_execute_textures(cmzn_shaderprogram_id shader_program,
 
 int cmzn_shaderprogram_execute_uniforms(cmzn_shaderprogram_id program,
 	cmzn_shaderuniforms_id uniforms);
+
+/**
+ * Generic vertex attribute indexes of per-instance values in the instanced
+ * glyph program. Chosen to avoid indexes some drivers alias to the vertex,
+ * normal, colour and first texture coordinate attributes.
+ */
+enum cmzn_shaderprogram_instanced_glyph_attribute
+{
+	SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_POSITION = 10,
+	SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_AXIS1 = 11,
+	SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_AXIS2 = 12,
+	SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_AXIS3 = 13,
+	SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_SCALE = 14,
+	SHADER_PROGRAM_INSTANCED_GLYPH_ATTRIBUTE_COLOUR = 15
+};
+
+/**
+ * Get the GLSL program for drawing a glyph at many points with instanced
+ * arrays, building it on first use in the current graphics context.
+ * Per-instance position, axes, scale and colour are read from the attribute
+ * indexes above, and resolved with uniforms baseSize, scaleFactors and offset
+ * as for CMZN_GLYPH_REPEAT_MODE_NONE.
+ * Uniform useGlyphColour non-zero replaces the material colour by glyphColour.
+ * Lighting is from the first lightCount of the 8 light numbers in uniform
+ * lightIndexes, with uniforms twoSided and localViewer set from the light model.
+ * @return  OpenGL program, or 0 if instancing is not available.
+ */
+unsigned int cmzn_shaderprogram_get_instanced_glyph_glslprogram();
 #endif
 
 unsigned int cmzn_shaderprogram_get_glslprogram(cmzn_shaderprogram_id program);
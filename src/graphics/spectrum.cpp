@@ -19,9 +19,12 @@ Spectrum functions and support code.
 #include <list>
 #include <vector>
 #include <math.h>
+#include "cmlibs/zinc/fieldcache.h"
+#include "cmlibs/zinc/fieldmodule.h"
 #include "cmlibs/zinc/scene.h"
 #include "cmlibs/zinc/spectrum.h"
 #include "cmlibs/zinc/status.h"
+#include "computed_field/computed_field.h"
 #include "description_io/spectrum_json_io.hpp"
 #include "general/cmiss_set.hpp"
 #include "general/debug.h"
@@ -336,6 +339,7 @@ struct cmzn_spectrum *cmzn_spectrum_create_private()
 		spectrum->manager_change_status = MANAGER_CHANGE_NONE(cmzn_spectrum);
 		spectrum->access_count=1;
 		spectrum->colour_lookup_texture = (struct Texture *)NULL;
+		spectrum->data_lookup_texture = (struct Texture *)NULL;
 		spectrum->is_managed_flag = false;
 		spectrum->list_of_components=CREATE(LIST(cmzn_spectrumcomponent))();
 		spectrum->name=NULL;
@@ -378,6 +382,10 @@ Frees the memory for the fields of <**spectrum>, frees the memory for
 			{
 				DEACCESS(Texture)(&((*spectrum_ptr)->colour_lookup_texture));
 			}
+			if ((*spectrum_ptr)->data_lookup_texture)
+			{
+				DEACCESS(Texture)(&((*spectrum_ptr)->data_lookup_texture));
+			}
 			DESTROY(LIST(cmzn_spectrumcomponent))(&((*spectrum_ptr)->list_of_components));
 			DEALLOCATE(*spectrum_ptr);
 		}
@@ -1460,6 +1468,7 @@ Initialises the graphics state for rendering values on the current material.
 			if (ALLOCATE(render_data,struct Spectrum_render_data,1))
 			{
 				render_data->number_of_data_components = number_of_data_components;
+				render_data->field_cache = 0;
 
 				if (spectrum->overwrite_colour)
 				{
@@ -1903,6 +1912,7 @@ Uses the <spectrum> to modify the <material> to represent the <number_of_data_co
 		render_data.rgba = rgba;
 		render_data.data = data;
 		render_data.number_of_data_components = number_of_data_components;
+		render_data.field_cache = 0;
 
 		return_code = FOR_EACH_OBJECT_IN_LIST(cmzn_spectrumcomponent)(
 			cmzn_spectrumcomponent_activate,(void *)&render_data,
@@ -1958,6 +1968,7 @@ Uses the <spectrum> to calculate RGBA components to represent the
 		CAST_TO_OTHER(fData,data,GLfloat,number_of_data_components);
 		render_data.data = fData;
 		render_data.number_of_data_components = number_of_data_components;
+		render_data.field_cache = 0;
 		return_code = FOR_EACH_OBJECT_IN_LIST(cmzn_spectrumcomponent)(
 			cmzn_spectrumcomponent_activate,(void *)&render_data,
 			spectrum->list_of_components);
@@ -2007,6 +2018,89 @@ Resets the caches and graphics state after rendering values.
 	return (return_code);
 } /* Spectrum_end_value_to_rgba */
 
+namespace {
+
+int cmzn_spectrumcomponent_add_active_to_vector(
+	struct cmzn_spectrumcomponent *component, void *components_void)
+{
+	if (component->active)
+	{
+		static_cast<std::vector<cmzn_spectrumcomponent *> *>(components_void)->push_back(component);
+	}
+	return 1;
+}
+
+}
+
+int Spectrum_values_to_rgba(struct cmzn_spectrum *spectrum,
+	int number_of_data_components, unsigned int number_of_values,
+	const GLfloat *data, const GLfloat *base_rgba, GLfloat *rgba)
+{
+	if ((!spectrum) || (number_of_data_components < 1) ||
+		((number_of_values > 0) && ((!data) || (!rgba))) ||
+		((!spectrum->overwrite_colour) && (!base_rgba)))
+	{
+		display_message(ERROR_MESSAGE, "Spectrum_values_to_rgba.  Invalid argument(s)");
+		return 0;
+	}
+	std::vector<cmzn_spectrumcomponent *> components;
+	FOR_EACH_OBJECT_IN_LIST(cmzn_spectrumcomponent)(
+		cmzn_spectrumcomponent_add_active_to_vector, (void *)&components,
+		spectrum->list_of_components);
+	const size_t number_of_components = components.size();
+	// field lookup components keep one cache for all values
+	std::vector<cmzn_fieldcache_id> field_caches(number_of_components, static_cast<cmzn_fieldcache_id>(0));
+	for (size_t c = 0; c < number_of_components; ++c)
+	{
+		if (components[c]->is_field_lookup && components[c]->output_field)
+		{
+			cmzn_fieldmodule_id field_module = cmzn_field_get_fieldmodule(components[c]->output_field);
+			field_caches[c] = cmzn_fieldmodule_create_fieldcache(field_module);
+			cmzn_fieldmodule_destroy(&field_module);
+		}
+	}
+	const GLfloat overwrite_rgba[4] = { 0.0, 0.0, 0.0, 1.0 };
+	const GLfloat *initial_rgba = (spectrum->overwrite_colour) ? overwrite_rgba : base_rgba;
+	struct Spectrum_render_data render_data;
+	render_data.number_of_data_components = number_of_data_components;
+	int return_code = 1;
+	const GLfloat *value_data = data;
+	GLfloat *value_rgba = rgba;
+	for (unsigned int i = 0; i < number_of_values; ++i)
+	{
+		for (int j = 0; j < 4; ++j)
+		{
+			value_rgba[j] = initial_rgba[j];
+		}
+		render_data.rgba = value_rgba;
+		// activate only reads data
+		render_data.data = const_cast<GLfloat *>(value_data);
+		for (size_t c = 0; c < number_of_components; ++c)
+		{
+			render_data.field_cache = field_caches[c];
+			if (!cmzn_spectrumcomponent_activate(components[c], (void *)&render_data))
+			{
+				return_code = 0;
+			}
+		}
+		value_data += number_of_data_components;
+		value_rgba += 4;
+	}
+	for (size_t c = 0; c < number_of_components; ++c)
+	{
+		if (field_caches[c])
+		{
+			cmzn_fieldcache_destroy(&field_caches[c]);
+		}
+	}
+	/* render data is currently not used in disable */
+	for (size_t c = 0; c < number_of_components; ++c)
+	{
+		cmzn_spectrumcomponent_disable(components[c], (void *)&render_data);
+	}
+	return return_code;
+}
+
 struct LIST(cmzn_spectrumcomponent) *get_cmzn_spectrumcomponent_list(
 	struct cmzn_spectrum *spectrum )
 /*******************************************************************************
@@ -2126,6 +2220,7 @@ Rebuilds the display_list for <spectrum> if it is not current.
 			render_data.rgba = rgba;
 			render_data.data = data;
 			render_data.number_of_data_components = number_of_data_components;
+			render_data.field_cache = 0;
 
 			FOR_EACH_OBJECT_IN_LIST(cmzn_spectrumcomponent)(
 				cmzn_spectrumcomponent_enable,(void *)&render_data,
@@ -2320,6 +2415,146 @@ If a NULL <spectrum> is supplied, spectrums are disabled.
 	return (return_code);
 } /* Spectrum_execute_colour_lookup */
 
+namespace {
+
+/* number of texels in the data lookup texture */
+const int SPECTRUM_DATA_LOOKUP_SIZE = 1024;
+
+}
+
+bool Spectrum_get_data_lookup_range(struct cmzn_spectrum *spectrum,
+	int *component_index, ZnReal *minimum, ZnReal *maximum)
+{
+	if (!((spectrum) && (spectrum->overwrite_colour) && (component_index) &&
+		(minimum) && (maximum)))
+	{
+		return false;
+	}
+	std::vector<cmzn_spectrumcomponent *> components;
+	FOR_EACH_OBJECT_IN_LIST(cmzn_spectrumcomponent)(
+		cmzn_spectrumcomponent_add_active_to_vector, (void *)&components,
+		spectrum->list_of_components);
+	if (components.size() != 1)
+	{
+		return false;
+	}
+	cmzn_spectrumcomponent *component = components[0];
+	if ((component->is_field_lookup) ||
+		((component->component_scale != CMZN_SPECTRUMCOMPONENT_SCALE_TYPE_LINEAR) &&
+			(component->component_scale != CMZN_SPECTRUMCOMPONENT_SCALE_TYPE_LOG)) ||
+		(component->colour_mapping_type == CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_BANDED) ||
+		(component->colour_mapping_type == CMZN_SPECTRUMCOMPONENT_COLOUR_MAPPING_TYPE_STEP) ||
+		(!component->extend_above) || (!component->extend_below) ||
+		(component->component_number < 0) ||
+		(!(component->minimum < component->maximum)))
+	{
+		return false;
+	}
+	*component_index = component->component_number;
+	*minimum = component->minimum;
+	*maximum = component->maximum;
+	return true;
+}
+
+int Spectrum_compile_data_lookup(struct cmzn_spectrum *spectrum,
+	Render_graphics_opengl *renderer)
+{
+	int component_index;
+	ZnReal minimum, maximum;
+	if (!((renderer) && Spectrum_get_data_lookup_range(spectrum,
+		&component_index, &minimum, &maximum)))
+	{
+		display_message(ERROR_MESSAGE,
+			"Spectrum_compile_data_lookup.  Invalid argument(s)");
+		return 0;
+	}
+	/* texel i holds the colour at minimum + i*(maximum - minimum)/(size - 1) */
+	const int number_of_values = SPECTRUM_DATA_LOOKUP_SIZE;
+	const int number_of_data_components = component_index + 1;
+	std::vector<GLfloat> data(number_of_values*number_of_data_components, 0.0f);
+	for (int i = 0; i < number_of_values; ++i)
+	{
+		data[i*number_of_data_components + component_index] = static_cast<GLfloat>(
+			minimum + (maximum - minimum)*static_cast<ZnReal>(i)/static_cast<ZnReal>(number_of_values - 1));
+	}
+	std::vector<GLfloat> rgba(4*number_of_values);
+	if (!Spectrum_values_to_rgba(spectrum, number_of_data_components,
+		number_of_values, data.data(), /*base_rgba*/0, rgba.data()))
+	{
+		return 0;
+	}
+	std::vector<unsigned char> colour_table(4*number_of_values);
+	for (int i = 0; i < 4*number_of_values; ++i)
+	{
+		const GLfloat value = (rgba[i] < 0.0f) ? 0.0f : ((rgba[i] > 1.0f) ? 1.0f : rgba[i]);
+		colour_table[i] = static_cast<unsigned char>(value*255.0f + 0.5f);
+	}
+	const void *image = 0;
+	unsigned int image_size = 0;
+	if ((spectrum->data_lookup_texture) &&
+		(CMZN_OK == Texture_get_image_block(spectrum->data_lookup_texture, &image, &image_size)) &&
+		(image_size == colour_table.size()) &&
+		(0 == memcmp(image, colour_table.data(), image_size)))
+	{
+		/* unchanged: keep texture object in use by compiled graphics */
+		return renderer->Texture_compile(spectrum->data_lookup_texture);
+	}
+	if (!spectrum->data_lookup_texture)
+	{
+		struct Texture *texture = CREATE(Texture)("spectrum_data_texture");
+		/* linear interpolation between texel centres; values outside the
+		 * range clamp to the end colours as components are extended */
+		Texture_set_filter_mode(texture, TEXTURE_LINEAR_FILTER);
+		Texture_set_wrap_mode(texture, TEXTURE_CLAMP_WRAP);
+		Texture_set_combine_mode(texture, TEXTURE_MODULATE_SCALE_4);
+		Texture_allocate_image(texture, number_of_values, 1, 1, TEXTURE_RGBA,
+			/*number_of_bytes_per_component*/1, "spectrum_data_texture");
+		spectrum->data_lookup_texture = ACCESS(Texture)(texture);
+	}
+	if (!Texture_set_image_block(spectrum->data_lookup_texture,
+		/*left*/0, /*bottom*/0, number_of_values, 1, /*depth_plane*/0,
+		4*number_of_values, colour_table.data()))
+	{
+		return 0;
+	}
+	return renderer->Texture_compile(spectrum->data_lookup_texture);
+}
+
+int Spectrum_execute_data_lookup(struct cmzn_spectrum *spectrum,
+	Render_graphics_opengl *renderer)
+{
+	int component_index;
+	ZnReal minimum, maximum;
+	if (!((renderer) && (spectrum) && (spectrum->data_lookup_texture) &&
+		Spectrum_get_data_lookup_range(spectrum, &component_index, &minimum, &maximum) &&
+		(component_index < 3)))
+	{
+		display_message(ERROR_MESSAGE,
+			"Spectrum_execute_data_lookup.  Invalid argument(s)");
+		return 0;
+	}
+	/* 3D and 2D textures take precedence over 1D */
+	glDisable(GL_TEXTURE_2D);
+	glDisable(GL_TEXTURE_3D);
+	if (!renderer->Texture_execute(spectrum->data_lookup_texture))
+	{
+		return 0;
+	}
+	/* map data component to s so minimum and maximum are at the centres of
+	 * the first and last texels; t and r are zeroed and q is 1 for up to 3
+	 * data components. Matrix is column major. */
+	const ZnReal size = static_cast<ZnReal>(SPECTRUM_DATA_LOOKUP_SIZE);
+	const ZnReal scale = (size - 1.0)/(size*(maximum - minimum));
+	GLfloat data_to_texture[16] = { 0.0f };
+	data_to_texture[4*component_index] = static_cast<GLfloat>(scale);
+	data_to_texture[12] = static_cast<GLfloat>(0.5/size - scale*minimum);
+	data_to_texture[15] = 1.0f;
+	glMatrixMode(GL_TEXTURE);
+	glMultMatrixf(data_to_texture);
+	glMatrixMode(GL_MODELVIEW);
+	return 1;
+}
+
 int Spectrum_get_colour_lookup_sizes(struct cmzn_spectrum *spectrum,
 	int *lookup_dimension, int **lookup_sizes)
 /*******************************************************************************
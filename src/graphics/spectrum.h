@@ -75,6 +75,9 @@ Spectrum type is private.
 	struct LIST(cmzn_spectrumcomponent) *list_of_components;
 
 	struct Texture *colour_lookup_texture;
+	/* 1D texture giving colour over the range of a single component, for
+	 * looking up colours from per-vertex data when drawing */
+	struct Texture *data_lookup_texture;
 	int cache, changed;
 	bool is_managed_flag;
 	/* the number of structures that point to this spectrum.  The spectrum
@@ -300,6 +303,26 @@ DESCRIPTION :
 Resets the caches and graphics state after rendering values.
 ==============================================================================*/
 
+/**
+ * Converts an array of values to RGBA colours with the spectrum in one pass,
+ * equivalent to calling Spectrum_value_to_rgba for each value followed by
+ * Spectrum_end_value_to_rgba. Active components are gathered once and field
+ * lookup components reuse one field cache for all values.
+ *
+ * @param spectrum  The spectrum to convert values with.
+ * @param number_of_data_components  Number of data components per value.
+ * @param number_of_values  Number of values to convert.
+ * @param data  Array of number_of_values*number_of_data_components values.
+ * @param base_rgba  Colour each value starts from if the spectrum does not
+ * overwrite material colour, usually the material diffuse and alpha. May be
+ * NULL for overwriting spectrums.
+ * @param rgba  Array of number_of_values*4 to receive colours.
+ * @return  1 on success, 0 on failure.
+ */
+int Spectrum_values_to_rgba(struct cmzn_spectrum *spectrum,
+	int number_of_data_components, unsigned int number_of_values,
+	const GLfloat *data, const GLfloat *base_rgba, GLfloat *rgba);
+
 struct LIST(cmzn_spectrumcomponent) *get_cmzn_spectrumcomponent_list(
 	struct cmzn_spectrum *spectrum );
 /*******************************************************************************
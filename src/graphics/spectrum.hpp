@@ -17,6 +17,44 @@ int Spectrum_compile_colour_lookup(struct cmzn_spectrum *spectrum,
 int Spectrum_execute_colour_lookup(struct cmzn_spectrum *spectrum,
 	Render_graphics_opengl *renderer);
 
+/**
+ * Determines whether colours of <spectrum> can be looked up from per-vertex
+ * data in its 1D data lookup texture. Requires the spectrum to overwrite the
+ * material colour and have a single active linear or log component over a
+ * non-empty range, extended above and below, which is not a field lookup,
+ * banded or step component.
+ * @param component_index  On success, set to the index of the data
+ * component the spectrum uses, starting at 0.
+ * @param minimum  On success, set to the data value at the start of the
+ * texture.
+ * @param maximum  On success, set to the data value at the end of the
+ * texture.
+ * @return  true if the data lookup texture can be used, otherwise false.
+ */
+bool Spectrum_get_data_lookup_range(struct cmzn_spectrum *spectrum,
+	int *component_index, ZnReal *minimum, ZnReal *maximum);
+
+/**
+ * Builds and compiles the 1D texture giving the colour of <spectrum> over the
+ * range of its single component, using the same conversion as per-vertex
+ * colours. Texels are only replaced if the colours have changed, so graphics
+ * compiled with the texture remain valid. Only call if
+ * Spectrum_get_data_lookup_range returns true.
+ * @return  1 on success, 0 on failure.
+ */
+int Spectrum_compile_data_lookup(struct cmzn_spectrum *spectrum,
+	Render_graphics_opengl *renderer);
+
+/**
+ * Binds the compiled data lookup texture of <spectrum> on the current texture
+ * unit, modulating the lit material colour, and multiplies the texture matrix
+ * to map the data component in texture coordinates across the texture. Caller
+ * must save and restore the texture state and matrix.
+ * @return  1 on success, 0 on failure.
+ */
+int Spectrum_execute_data_lookup(struct cmzn_spectrum *spectrum,
+	Render_graphics_opengl *renderer);
+
 #if defined (OPENGL_API)
 struct Spectrum_render_data *spectrum_start_renderGL(
 	struct cmzn_spectrum *spectrum,struct cmzn_material *material,
@@ -1382,11 +1382,13 @@ passed in render data.
 		{
 			if (component->active)
 			{
-				cmzn_fieldmodule_id field_module;
-				cmzn_fieldcache_id field_cache;
-				// GRC probably inefficient to create and destroy cache here; keep it through render pass?
-				field_module = cmzn_field_get_fieldmodule(component->output_field);
-				field_cache = cmzn_fieldmodule_create_fieldcache(field_module);
+				cmzn_fieldmodule_id field_module = 0;
+				cmzn_fieldcache_id field_cache = render_data->field_cache;
+				if (!field_cache)
+				{
+					field_module = cmzn_field_get_fieldmodule(component->output_field);
+					field_cache = cmzn_fieldmodule_create_fieldcache(field_module);
+				}
 				number_of_components = cmzn_field_get_number_of_components
 					(component->output_field);
 				ALLOCATE(values, FE_value, number_of_components);
@@ -1408,8 +1410,11 @@ passed in render data.
 					DEALLOCATE(feData);
 				}
 				cmzn_field_evaluate_real(component->output_field, field_cache, number_of_components, values);
-				cmzn_fieldcache_destroy(&field_cache);
-				cmzn_fieldmodule_destroy(&field_module);
+				if (field_module)
+				{
+					cmzn_fieldcache_destroy(&field_cache);
+					cmzn_fieldmodule_destroy(&field_module);
+				}
 				for (i = 0 ; i < number_of_components ; i++)
 				{
 					/* ensure 0 - 1 */
@@ -37,6 +37,9 @@ rendering.
 	GLfloat material_rgba[4];
 	GLfloat *data;
 	int number_of_data_components;
+	/* optional cache for evaluating field lookup components over many values.
+	 * If NULL a temporary cache is created for each value */
+	struct cmzn_fieldcache *field_cache;
 }; /* struct Spectrum_render_data */
 
 struct cmzn_spectrumcomponent
@@ -270,6 +270,7 @@ struct cmzn_tessellation
 	int *minimum_divisions;
 	int refinement_factors_size;
 	int *refinement_factors;
+	double adaptiveTolerance;
 	cmzn_tessellation_change_detail changeDetail;
 	bool is_managed_flag;
 	int access_count;
@@ -285,6 +286,7 @@ protected:
 		minimum_divisions(NULL),
 		refinement_factors_size(1),
 		refinement_factors(NULL),
+		adaptiveTolerance(0.0),
 		is_managed_flag(false),
 		access_count(1)
 	{
@@ -323,6 +325,7 @@ public:
 		this->set_minimum_divisions(source.minimum_divisions_size, source.minimum_divisions);
 		this->set_refinement_factors(source.refinement_factors_size, source.refinement_factors);
 		this->setCircleDivisions(source.circleDivisions);
+		this->setAdaptiveTolerance(source.adaptiveTolerance);
 		return *this;
 	}
 
@@ -351,6 +354,25 @@ public:
 		return (inCircleDivisions == this->circleDivisions) ? CMZN_OK : CMZN_ERROR_ARGUMENT;
 	}
 
+	double getAdaptiveTolerance() const
+	{
+		return this->adaptiveTolerance;
+	}
+
+	int setAdaptiveTolerance(double adaptiveToleranceIn)
+	{
+		if (!(adaptiveToleranceIn >= 0.0))
+			return CMZN_ERROR_ARGUMENT;
+		if (adaptiveToleranceIn != this->adaptiveTolerance)
+		{
+			this->adaptiveTolerance = adaptiveToleranceIn;
+			this->changeDetail.setElementDivisionsChanged();
+			MANAGED_OBJECT_CHANGE(cmzn_tessellation)(this,
+				MANAGER_CHANGE_OBJECT_NOT_IDENTIFIER(cmzn_tessellation));
+		}
+		return CMZN_OK;
+	}
+
 	/** get minimum divisions for a particular dimension >= 0 */
 	inline int get_minimum_divisions_value(int dimension)
 	{
@@ -463,7 +485,12 @@ public:
 		{
 			display_message(INFORMATION_MESSAGE, "1");
 		}
-		display_message(INFORMATION_MESSAGE, "\" circle_divisions %d;\n", circleDivisions);
+		display_message(INFORMATION_MESSAGE, "\" circle_divisions %d", circleDivisions);
+		if (adaptiveTolerance > 0.0)
+		{
+			display_message(INFORMATION_MESSAGE, " adaptive_tolerance %g", adaptiveTolerance);
+		}
+		display_message(INFORMATION_MESSAGE, ";\n");
 	}
 
 	inline cmzn_tessellation *access()
@@ -1115,6 +1142,22 @@ int cmzn_tessellation_set_circle_divisions(
 	return CMZN_ERROR_ARGUMENT;
 }
 
+double cmzn_tessellation_get_adaptive_tolerance(
+	cmzn_tessellation_id tessellation)
+{
+	if (tessellation)
+		return tessellation->getAdaptiveTolerance();
+	return 0.0;
+}
+
+int cmzn_tessellation_set_adaptive_tolerance(
+	cmzn_tessellation_id tessellation, double adaptiveTolerance)
+{
+	if (tessellation)
+		return tessellation->setAdaptiveTolerance(adaptiveTolerance);
+	return CMZN_ERROR_ARGUMENT;
+}
+
 int cmzn_tessellation_get_minimum_divisions(cmzn_tessellation_id tessellation,
 	int valuesCount, int *valuesOut)
 {
@@ -1226,7 +1269,8 @@ cmzn_tessellation_id cmzn_tessellationmodule_find_or_create_fixed_tessellation(
 			// don't want to use default_points tessellation
 			if (tempTessellation == default_points_tessellation)
 				continue;
-			bool match = (tempTessellation->circleDivisions == useCircleDivisions);
+			bool match = (tempTessellation->circleDivisions == useCircleDivisions) &&
+				(tempTessellation->adaptiveTolerance == 0.0);
 			if (match)
 			{
 				int count = useElementDivisionsCount;
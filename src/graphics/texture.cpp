@@ -51,6 +51,7 @@ long lround(double d)
 #include "general/message.h"
 #include "general/enumerator_private.hpp"
 #include "graphics/texture.hpp"
+#include "graphics/texture_brick_cache.hpp"
 #include "graphics/render_gl.h"
 
 /*
@@ -177,6 +178,11 @@ The properties of a graphical texture.
 	/* Store the properties */
 	struct LIST(Texture_property) *property_list;
 
+	/* optional out-of-core storage replacing image, and the mip level of it
+		 currently presented as the texture */
+	TextureBrickCache *brick_cache;
+	int brick_level;
+
 	int access_count;
 }; /* struct Texture */
 /*
@@ -184,6 +190,49 @@ Module functions
 ----------------
 */
 
+/**
+ * Release out-of-core brick storage so texture image is used again.
+ * Caller must reallocate image to the required size.
+ */
+static void Texture_clear_brick_cache(struct Texture *texture)
+{
+	if (texture->brick_cache)
+	{
+		TextureBrickCache::deaccess(texture->brick_cache);
+		texture->brick_level = 0;
+		/* force reallocation of placeholder image */
+		texture->original_width_texels = 0;
+		texture->original_height_texels = 0;
+		texture->original_depth_texels = 0;
+	}
+}
+
+/**
+ * Get pointer to bytes of texel at byte offset in the row-padded texture image
+ * layout. Texels of out-of-core textures are copied into texel_buffer, which
+ * must hold at least bytes_per_pixel bytes.
+ */
+static inline unsigned char *Texture_get_texel_pointer(struct Texture *texture,
+	long int offset, long int row_width_bytes, int bytes_per_pixel,
+	unsigned char *texel_buffer)
+{
+	if (!texture->brick_cache)
+	{
+		return texture->image + offset;
+	}
+	const long int slice_bytes = row_width_bytes*texture->height_texels;
+	const long int z = offset/slice_bytes;
+	offset -= z*slice_bytes;
+	const long int y = offset/row_width_bytes;
+	const long int x = (offset - y*row_width_bytes)/bytes_per_pixel;
+	if (!texture->brick_cache->getTexels(texture->brick_level,
+		static_cast<int>(x), static_cast<int>(y), static_cast<int>(z), 1, texel_buffer))
+	{
+		memset(texel_buffer, 0, bytes_per_pixel);
+	}
+	return texel_buffer;
+}
+
 #if defined (OPENGL_API)
 static GLenum Texture_get_target_enum(Texture *texture)
 {
@@ -2516,7 +2565,13 @@ Directly outputs the commands setting up the <texture>.
 
 	ENTER(direct_render_Texture);
 	return_code = 1;
-	if (texture)
+	if (texture && texture->brick_cache)
+	{
+		display_message(WARNING_MESSAGE, "Texture %s uses out-of-core chunked storage "
+			"and is not rendered", texture->name);
+		return_code = 0;
+	}
+	else if (texture)
 	{
 		rendered_image = (unsigned char *)NULL;
 		texture_target = Texture_get_target_enum(texture);
@@ -3130,6 +3185,8 @@ of all textures.
 			texture->texture_tiling = (struct Texture_tiling *)NULL;
 			texture->display_list_current= TEXTURE_COMPILE_STATE_NOT_COMPILED;
 			texture->property_list = (struct LIST(Texture_property) *)NULL;
+			texture->brick_cache = (TextureBrickCache *)NULL;
+			texture->brick_level = 0;
 			texture->access_count=0;
 		}
 		else
@@ -3201,6 +3258,10 @@ Frees the memory for the texture and sets <*texture_address> to NULL.
 					DEALLOCATE(texture->file_number_pattern);
 				}
                 DEALLOCATE(texture->image);
+				if (texture->brick_cache)
+				{
+					TextureBrickCache::deaccess(texture->brick_cache);
+				}
 				if (texture->property_list)
 				{
 					DESTROY(LIST(Texture_property))(&texture->property_list);
@@ -3311,9 +3372,11 @@ int Texture_copy_image(const struct Texture *source, struct Texture *destination
 	if (source && destination)
 	{
 		const int number_of_components = Texture_storage_type_get_number_of_components(source->storage);
-		const int image_size = source->depth_texels * source->height_texels * 4 *
+		/* out-of-core storage is shared, with only the placeholder image copied */
+		const int image_size = (source->brick_cache) ? 4 :
+			(source->depth_texels * source->height_texels * 4 *
 			((source->width_texels * number_of_components *
-				source->number_of_bytes_per_component + 3)/4);
+				source->number_of_bytes_per_component + 3)/4));
 		unsigned char *destination_image;
 		if ((0 < image_size) && REALLOCATE(destination_image,
 			destination->image, unsigned char, image_size))
@@ -3341,6 +3404,18 @@ int Texture_copy_image(const struct Texture *source, struct Texture *destination
 			destination->width_texels = source->width_texels;
 			destination->height_texels = source->height_texels;
 			destination->depth_texels = source->depth_texels;
+			if (source->brick_cache != destination->brick_cache)
+			{
+				if (destination->brick_cache)
+				{
+					TextureBrickCache::deaccess(destination->brick_cache);
+				}
+				if (source->brick_cache)
+				{
+					destination->brick_cache = source->brick_cache->access();
+				}
+			}
+			destination->brick_level = source->brick_level;
 			destination->display_list_current = TEXTURE_COMPILE_STATE_NOT_COMPILED;
 		}
 	}
@@ -3856,6 +3931,7 @@ int Texture_allocate_image(struct Texture *texture,
 		}
 		bytes_per_pixel = number_of_components * number_of_bytes_per_component;
 		padded_width_bytes = 4*((width*bytes_per_pixel + 3)/4);
+		Texture_clear_brick_cache(texture);
 
 		// avoid allocation if already correct size
 		if ((texture->original_width_texels != width) ||
@@ -3955,7 +4031,12 @@ Up to the calling function to DESTROY the returned Cmgui_image.
 
 	ENTER(Texture_get_image);
 	cmgui_image = (struct Cmgui_image *)NULL;
-	if (texture && (0 < (number_of_components =
+	if (texture && texture->brick_cache)
+	{
+		display_message(ERROR_MESSAGE,
+			"Texture_get_image.  Cannot get image of texture with out-of-core chunked storage");
+	}
+	else if (texture && (0 < (number_of_components =
 		Texture_storage_type_get_number_of_components(texture->storage))) &&
 		(0 < (bytes_per_pixel =
 			number_of_components*texture->number_of_bytes_per_component)))
@@ -4145,6 +4226,7 @@ positive. Cropping is not available in the depth direction.
 				texture->width_texels = texture_width;
 				texture->height_texels = texture_height;
 				texture->depth_texels = texture_depth;
+				Texture_clear_brick_cache(texture);
 				DEALLOCATE(texture->image);
 				texture->image = texture_image;
 				if (texture->image_file_name)
@@ -4270,7 +4352,8 @@ int Texture_get_image_block(struct Texture *texture,
 	int bytes_per_pixel = 0, number_of_components = 0;
 	if (buffer_out)
 	{
-		if (texture && (texture->width_texels > 0) &&  (texture->height_texels > 0) &&
+		if (texture && (!texture->brick_cache) &&
+			(texture->width_texels > 0) &&  (texture->height_texels > 0) &&
 			(texture->depth_texels > 0) &&
 			(0 < (number_of_components =
 				Texture_storage_type_get_number_of_components(texture->storage))) &&
@@ -4348,7 +4431,7 @@ Adds <cmgui_image> into <texture> making a 3D image from 2D images.
 	unsigned char *destination;
 
 	ENTER(Texture_set_image);
-	if (texture && cmgui_image &&
+	if (texture && (!texture->brick_cache) && cmgui_image &&
 		(0 < (image_width = Cmgui_image_get_width(cmgui_image))) &&
 		(0 < (image_height = Cmgui_image_get_height(cmgui_image))) &&
 		(0 < (number_of_components =
@@ -4497,15 +4580,22 @@ Returns the byte values in the texture at x,y,z.
 	{
 		number_of_bytes = Texture_storage_type_get_number_of_components(texture->storage)
 			* texture->number_of_bytes_per_component;
-		row_width_bytes=
-			((int)(texture->width_texels*number_of_bytes+3)/4)*4;
-		pixel_ptr=(unsigned char *)(texture->image);
-		pixel_ptr += ((z*texture->height_texels + y)*row_width_bytes+x*number_of_bytes);
-		for (i=0;i<number_of_bytes;i++)
+		if (texture->brick_cache)
 		{
-			values[i]=pixel_ptr[i];
+			return_code = texture->brick_cache->getTexels(texture->brick_level, x, y, z, 1, values) ? 1 : 0;
+		}
+		else
+		{
+			row_width_bytes=
+				((int)(texture->width_texels*number_of_bytes+3)/4)*4;
+			pixel_ptr=(unsigned char *)(texture->image);
+			pixel_ptr += ((z*texture->height_texels + y)*row_width_bytes+x*number_of_bytes);
+			for (i=0;i<number_of_bytes;i++)
+			{
+				values[i]=pixel_ptr[i];
+			}
+			return_code=1;
 		}
-		return_code=1;
 	}
 	else
 	{
@@ -4518,6 +4608,76 @@ Returns the byte values in the texture at x,y,z.
 	return (return_code);
 } /* Texture_get_raw_pixel_values */
 
+int Texture_get_original_texel_values(struct Texture *texture, ZnReal *values)
+{
+	if (!((texture) && (texture->image) && (values)))
+	{
+		display_message(ERROR_MESSAGE,
+			"Texture_get_original_texel_values.  Invalid argument(s)");
+		return 0;
+	}
+	const int number_of_components =
+		Texture_storage_type_get_number_of_components(texture->storage);
+	const int number_of_bytes_per_component = texture->number_of_bytes_per_component;
+	const int bytes_per_pixel = number_of_components*number_of_bytes_per_component;
+	const long int row_width_bytes =
+		((long int)(texture->width_texels*bytes_per_pixel + 3)/4)*4;
+	const ZnReal scale = 1.0/((2 == number_of_bytes_per_component) ? 65535.0 : 255.0);
+	/* out-of-core textures are copied a row at a time from their bricks */
+	unsigned char *row_buffer = (unsigned char *)NULL;
+	if ((texture->brick_cache) &&
+		(!ALLOCATE(row_buffer, unsigned char, texture->original_width_texels*bytes_per_pixel)))
+	{
+		return 0;
+	}
+	ZnReal *value = values;
+	for (int k = 0; k < texture->original_depth_texels; ++k)
+	{
+		for (int j = 0; j < texture->original_height_texels; ++j)
+		{
+			const unsigned char *pixel_ptr = texture->image +
+				(k*(long int)texture->height_texels + j)*row_width_bytes;
+			if (row_buffer)
+			{
+				if (!texture->brick_cache->getTexels(texture->brick_level, 0, j, k,
+					texture->original_width_texels, row_buffer))
+				{
+					DEALLOCATE(row_buffer);
+					return 0;
+				}
+				pixel_ptr = row_buffer;
+			}
+			const int row_values = texture->original_width_texels*number_of_components;
+			if (2 == number_of_bytes_per_component)
+			{
+				for (int i = 0; i < row_values; ++i)
+				{
+#if (1234==BYTE_ORDER)
+					const unsigned short short_value =
+						(((unsigned short)(*(pixel_ptr + 1))) << 8) + (*pixel_ptr);
+#else /* (1234==BYTE_ORDER) */
+					const unsigned short short_value =
+						(((unsigned short)(*pixel_ptr)) << 8) + (*(pixel_ptr + 1));
+#endif /* (1234==BYTE_ORDER) */
+					value[i] = (ZnReal)short_value*scale;
+					pixel_ptr += 2;
+				}
+			}
+			else
+			{
+				for (int i = 0; i < row_values; ++i)
+					value[i] = (ZnReal)pixel_ptr[i]*scale;
+			}
+			value += row_values;
+		}
+	}
+	if (row_buffer)
+	{
+		DEALLOCATE(row_buffer);
+	}
+	return 1;
+}
+
 int Texture_get_pixel_values(struct Texture *texture,
 	ZnReal x, ZnReal y, ZnReal z, ZnReal *values)
 /*******************************************************************************
@@ -4539,6 +4699,7 @@ is constant from the half texel location to the edge.
 	long int high_offset[3] = {}, low_offset[3] = {}, offset, offset_i, offset_j, offset_k,
 		v_i, x_i, y_i, z_i;
 	unsigned char *pixel_ptr = nullptr;
+	unsigned char texel_buffer[8];
 	unsigned short short_value;
 
 	ENTER(Texture_get_pixel_values);
@@ -4846,7 +5007,8 @@ is constant from the half texel location to the edge.
 									weight_i = weight_j*local_xi[0];
 									offset_i = offset_j + high_offset[0];
 								}
-								pixel_ptr = texture->image + offset_i;
+								pixel_ptr = Texture_get_texel_pointer(texture, offset_i,
+									row_width_bytes, bytes_per_pixel, texel_buffer);
 								weight = weight_i / component_max;
 								for (n = 0; n < number_of_components; n++)
 								{
@@ -4895,7 +5057,8 @@ is constant from the half texel location to the edge.
 					}
 					offset = (z_i*(long int)texture->height_texels + y_i)*(long int)row_width_bytes +
 						x_i*(long int)bytes_per_pixel;
-					pixel_ptr = texture->image + offset;
+					pixel_ptr = Texture_get_texel_pointer(texture, offset,
+						row_width_bytes, bytes_per_pixel, texel_buffer);
 					for (n = 0; n < number_of_components; n++)
 					{
 						if (2 == number_of_bytes_per_component)
@@ -5323,6 +5486,95 @@ read. May differ from the dimensions of the texture which is in powers of 2.
 	return (return_code);
 } /* Texture_get_original_size */
 
+int Texture_set_brick_cache(struct Texture *texture, TextureBrickCache *brick_cache,
+	enum Texture_storage_type storage, const char *source_name)
+{
+	int sizes[3];
+	unsigned char *texture_image;
+	if (!((texture) && (brick_cache) &&
+		(Texture_storage_type_get_number_of_components(storage) ==
+			brick_cache->getNumberOfComponents())))
+	{
+		display_message(ERROR_MESSAGE, "Texture_set_brick_cache.  Invalid argument(s)");
+		return 0;
+	}
+	/* image is only a placeholder: texels are fetched from bricks on demand */
+	if (!REALLOCATE(texture_image, texture->image, unsigned char, 4))
+	{
+		display_message(ERROR_MESSAGE, "Texture_set_brick_cache.  Could not reallocate image");
+		return 0;
+	}
+	texture->image = texture_image;
+	memset(texture_image, 0, 4);
+	brick_cache->access();
+	if (texture->brick_cache)
+	{
+		TextureBrickCache::deaccess(texture->brick_cache);
+	}
+	texture->brick_cache = brick_cache;
+	texture->brick_level = 0;
+	brick_cache->getLevelSizes(0, sizes);
+	texture->dimension = (1 < sizes[2]) ? 3 : ((1 < sizes[1]) ? 2 : 1);
+	texture->storage = storage;
+	texture->number_of_bytes_per_component = brick_cache->getNumberOfBytesPerComponent();
+	texture->original_width_texels = texture->width_texels = sizes[0];
+	texture->original_height_texels = texture->height_texels = sizes[1];
+	texture->original_depth_texels = texture->depth_texels = sizes[2];
+	if (texture->image_file_name)
+	{
+		DEALLOCATE(texture->image_file_name);
+	}
+	texture->image_file_name = source_name ? duplicate_string(source_name) : 0;
+	if (texture->file_number_pattern)
+	{
+		DEALLOCATE(texture->file_number_pattern);
+	}
+	texture->start_file_number = 0;
+	texture->stop_file_number = 0;
+	texture->file_number_increment = 0;
+	texture->crop_left_margin = 0;
+	texture->crop_bottom_margin = 0;
+	texture->crop_width = 0;
+	texture->crop_height = 0;
+	texture->display_list_current = TEXTURE_COMPILE_STATE_NOT_COMPILED;
+	return 1;
+}
+
+TextureBrickCache *Texture_get_brick_cache(struct Texture *texture)
+{
+	if (texture)
+	{
+		return texture->brick_cache;
+	}
+	return (TextureBrickCache *)NULL;
+}
+
+int Texture_get_brick_level(struct Texture *texture)
+{
+	if (texture)
+	{
+		return texture->brick_level;
+	}
+	return 0;
+}
+
+int Texture_set_brick_level(struct Texture *texture, int level)
+{
+	int sizes[3];
+	if (!((texture) && (texture->brick_cache) && (0 <= level) &&
+		(level < texture->brick_cache->getLevelCount())))
+	{
+		return 0;
+	}
+	texture->brick_level = level;
+	/* the texture presents the mip level as if it were the whole image */
+	texture->brick_cache->getLevelSizes(level, sizes);
+	texture->original_width_texels = texture->width_texels = sizes[0];
+	texture->original_height_texels = texture->height_texels = sizes[1];
+	texture->original_depth_texels = texture->depth_texels = sizes[2];
+	return 1;
+}
+
 int Texture_get_physical_size(struct Texture *texture,ZnReal *width,
 	ZnReal *height, ZnReal *depth)
 /*******************************************************************************
@@ -489,6 +489,16 @@ DESCRIPTION :
 Returns the byte values in the texture at x,y,z.
 ==============================================================================*/
 
+/**
+ * Gets normalised values in [0,1] of all texels in the original image size of
+ * the texture, without filtering. Values are ordered by component, then x, y
+ * and z, with x varying fastest.
+ * @param values  Array large enough for original width*height*depth texels
+ * times number of components to receive the values.
+ * @return  1 on success, 0 on failure.
+ */
+int Texture_get_original_texel_values(struct Texture *texture, ZnReal *values);
+
 int Texture_get_pixel_values(struct Texture *texture,
 	double x, double y, double z, double *values);
 /*******************************************************************************
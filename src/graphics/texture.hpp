@@ -10,8 +10,10 @@
 #define TEXTURE_HPP
 
 class Render_graphics_opengl;
+class TextureBrickCache;
 
 #include <general/callback_class.hpp>
+#include "graphics/texture.h"
 
 /***************************************************************************//**
  * Compile the texture_object for this texture.
@@ -38,4 +40,32 @@ int Texture_compile_opengl_display_list(struct Texture *texture,
 int Texture_execute_opengl_display_list(struct Texture *texture,
 	Render_graphics_opengl *renderer);
 
+/***************************************************************************//**
+ * Use out-of-core brick storage for the texture image, with its texels fetched
+ * on demand when sampled. The texture takes a new access to brick_cache and
+ * presents its level 0 until Texture_set_brick_level is called. Textures with
+ * brick storage are not rendered and cannot be written.
+ * @param source_name  Name of file or other source recorded for the image.
+ * @return  1 on success, 0 on failure.
+ */
+int Texture_set_brick_cache(struct Texture *texture, TextureBrickCache *brick_cache,
+	enum Texture_storage_type storage, const char *source_name);
+
+/***************************************************************************//**
+ * @return  Non-accessed brick storage of texture, or NULL if none.
+ */
+TextureBrickCache *Texture_get_brick_cache(struct Texture *texture);
+
+/***************************************************************************//**
+ * @return  Mip level of brick storage presented by the texture, 0 if none.
+ */
+int Texture_get_brick_level(struct Texture *texture);
+
+/***************************************************************************//**
+ * Present mip level of brick storage as the texture image, changing its size
+ * in texels. Level 0 is full resolution.
+ * @return  1 on success, 0 if no brick storage or invalid level.
+ */
+int Texture_set_brick_level(struct Texture *texture, int level);
+
 #endif /* !defined (TEXTURE_HPP) */
@@ -0,0 +1,366 @@
+/**
+ * FILE : texture_brick_cache.cpp
+ *
+ * Out-of-core storage of large images in bricks loaded on demand.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "cmlibs/zinc/stream.h"
+#include "graphics/texture_brick_cache.hpp"
+#include "general/message.h"
+#include <cstring>
+
+TextureBrickCache::TextureBrickCache(const int *sizesIn, int numberOfComponentsIn,
+	int numberOfBytesPerComponentIn, int brickSizeIn, size_t memoryBudgetIn) :
+	numberOfComponents(numberOfComponentsIn),
+	numberOfBytesPerComponent(numberOfBytesPerComponentIn),
+	bytesPerPixel(numberOfComponentsIn*numberOfBytesPerComponentIn),
+	brickSize(brickSizeIn),
+	levelCount(1),
+	memoryBudget(memoryBudgetIn),
+	memoryUsed(0),
+	memory(0),
+	memoryLength(0),
+	memoryResource(0),
+	lastKey(0),
+	lastBrickValid(false),
+	loadCount(0),
+	hitCount(0),
+	access_count(1)
+{
+	int maximumSize = 1;
+	for (int d = 0; d < 3; ++d)
+	{
+		this->sizes[d] = sizesIn[d];
+		if (sizesIn[d] > maximumSize)
+			maximumSize = sizesIn[d];
+	}
+	while (maximumSize > 1)
+	{
+		maximumSize = (maximumSize + 1)/2;
+		++(this->levelCount);
+	}
+}
+
+TextureBrickCache::~TextureBrickCache()
+{
+	if (this->memoryResource)
+		cmzn_streamresource_destroy(&this->memoryResource);
+}
+
+namespace {
+
+bool TextureBrickCache_valid_arguments(const int *sizesIn, int numberOfComponentsIn,
+	int numberOfBytesPerComponentIn, int brickSizeIn)
+{
+	if (!((sizesIn) && (0 < numberOfComponentsIn) && (numberOfComponentsIn <= 4) &&
+		((1 == numberOfBytesPerComponentIn) || (2 == numberOfBytesPerComponentIn)) &&
+		(4 <= brickSizeIn) && (brickSizeIn <= 1024)))
+		return false;
+	for (int d = 0; d < 3; ++d)
+		if (sizesIn[d] < 1)
+			return false;
+	return true;
+}
+
+}
+
+TextureBrickCache *TextureBrickCache::createFromFile(const char *fileNameIn,
+	const int *sizesIn, int numberOfComponentsIn, int numberOfBytesPerComponentIn,
+	int brickSizeIn, size_t memoryBudgetIn)
+{
+	if (!((fileNameIn) && TextureBrickCache_valid_arguments(sizesIn,
+		numberOfComponentsIn, numberOfBytesPerComponentIn, brickSizeIn)))
+	{
+		display_message(ERROR_MESSAGE, "TextureBrickCache::createFromFile.  Invalid argument(s)");
+		return 0;
+	}
+	TextureBrickCache *cache = new TextureBrickCache(sizesIn, numberOfComponentsIn,
+		numberOfBytesPerComponentIn, brickSizeIn, memoryBudgetIn);
+	cache->fileName = fileNameIn;
+	cache->file.open(fileNameIn, std::ios::in | std::ios::binary);
+	if (cache->file.is_open())
+	{
+		cache->file.seekg(0, std::ios::end);
+		const std::streamoff fileLength = cache->file.tellg();
+		const std::streamoff requiredLength = static_cast<std::streamoff>(sizesIn[0])*
+			sizesIn[1]*sizesIn[2]*cache->bytesPerPixel;
+		if (fileLength >= requiredLength)
+			return cache;
+		display_message(ERROR_MESSAGE, "TextureBrickCache::createFromFile.  "
+			"File %s is too small for image size", fileNameIn);
+	}
+	else
+	{
+		display_message(ERROR_MESSAGE, "TextureBrickCache::createFromFile.  "
+			"Could not open file %s", fileNameIn);
+	}
+	delete cache;
+	return 0;
+}
+
+TextureBrickCache *TextureBrickCache::createFromMemory(const void *memoryIn,
+	size_t memoryLengthIn, cmzn_streamresource_id resource,
+	const int *sizesIn, int numberOfComponentsIn, int numberOfBytesPerComponentIn,
+	int brickSizeIn, size_t memoryBudgetIn)
+{
+	if (!((memoryIn) && TextureBrickCache_valid_arguments(sizesIn,
+		numberOfComponentsIn, numberOfBytesPerComponentIn, brickSizeIn)))
+	{
+		display_message(ERROR_MESSAGE, "TextureBrickCache::createFromMemory.  Invalid argument(s)");
+		return 0;
+	}
+	const size_t requiredLength = static_cast<size_t>(sizesIn[0])*sizesIn[1]*sizesIn[2]*
+		numberOfComponentsIn*numberOfBytesPerComponentIn;
+	if (memoryLengthIn < requiredLength)
+	{
+		display_message(ERROR_MESSAGE, "TextureBrickCache::createFromMemory.  "
+			"Memory block is too small for image size");
+		return 0;
+	}
+	TextureBrickCache *cache = new TextureBrickCache(sizesIn, numberOfComponentsIn,
+		numberOfBytesPerComponentIn, brickSizeIn, memoryBudgetIn);
+	cache->memory = static_cast<const unsigned char *>(memoryIn);
+	cache->memoryLength = memoryLengthIn;
+	if (resource)
+		cache->memoryResource = cmzn_streamresource_access(resource);
+	return cache;
+}
+
+int TextureBrickCache::deaccess(TextureBrickCache* &cache)
+{
+	if (!cache)
+		return 0;
+	--(cache->access_count);
+	if (cache->access_count <= 0)
+		delete cache;
+	cache = 0;
+	return 1;
+}
+
+void TextureBrickCache::getLevelSizes(int level, int *levelSizes) const
+{
+	for (int d = 0; d < 3; ++d)
+	{
+		int size = this->sizes[d];
+		for (int l = 0; l < level; ++l)
+			size = (size + 1)/2;
+		levelSizes[d] = size;
+	}
+}
+
+void TextureBrickCache::setMemoryBudget(size_t memoryBudgetIn)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	this->memoryBudget = memoryBudgetIn;
+	this->evictToBudget(0);
+}
+
+size_t TextureBrickCache::getMemoryUsed()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->memoryUsed;
+}
+
+unsigned long long TextureBrickCache::getLoadCount()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->loadCount;
+}
+
+unsigned long long TextureBrickCache::getHitCount()
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->hitCount;
+}
+
+void TextureBrickCache::evictToBudget(size_t requiredBytes)
+{
+	while ((!this->bricks.empty()) && (this->memoryUsed + requiredBytes > this->memoryBudget))
+	{
+		Brick& brick = this->bricks.back();
+		this->memoryUsed -= brick.texels.size();
+		this->brickMap.erase(brick.key);
+		this->bricks.pop_back();
+		this->lastBrickValid = false;
+	}
+}
+
+bool TextureBrickCache::readSourceTexels(int x, int y, int z, int count, unsigned char *texels)
+{
+	const size_t offset = ((static_cast<size_t>(z)*this->sizes[1] + y)*this->sizes[0] + x)*
+		this->bytesPerPixel;
+	const size_t length = static_cast<size_t>(count)*this->bytesPerPixel;
+	if (this->memory)
+	{
+		memcpy(texels, this->memory + offset, length);
+		return true;
+	}
+	this->file.clear();
+	this->file.seekg(static_cast<std::streamoff>(offset), std::ios::beg);
+	this->file.read(reinterpret_cast<char *>(texels), static_cast<std::streamsize>(length));
+	return this->file.good();
+}
+
+bool TextureBrickCache::loadBrick(int level, int bx, int by, int bz,
+	std::vector<unsigned char>& texels)
+{
+	const int b = this->brickSize;
+	int levelSizes[3];
+	this->getLevelSizes(level, levelSizes);
+	const int x0 = bx*b;
+	const int y0 = by*b;
+	const int z0 = bz*b;
+	const int nx = (x0 + b <= levelSizes[0]) ? b : (levelSizes[0] - x0);
+	const int ny = (y0 + b <= levelSizes[1]) ? b : (levelSizes[1] - y0);
+	const int nz = (z0 + b <= levelSizes[2]) ? b : (levelSizes[2] - z0);
+	const size_t rowBytes = static_cast<size_t>(b)*this->bytesPerPixel;
+	// bricks are stored full size so texel offsets within them are uniform
+	texels.assign(rowBytes*b*((levelSizes[2] > 1) ? b : 1), 0);
+	if (0 == level)
+	{
+		for (int k = 0; k < nz; ++k)
+			for (int j = 0; j < ny; ++j)
+				if (!this->readSourceTexels(x0, y0 + j, z0 + k, nx,
+						texels.data() + (static_cast<size_t>(k)*b + j)*rowBytes))
+					return false;
+		return true;
+	}
+	// average 2x2x2 texels of finer level, clamped at its far edges
+	int fineSizes[3];
+	this->getLevelSizes(level - 1, fineSizes);
+	std::vector<unsigned char> fineTexels(2*this->bytesPerPixel);
+	std::vector<double> sums(this->numberOfComponents);
+	for (int k = 0; k < nz; ++k)
+	{
+		const int fz0 = 2*(z0 + k);
+		const int fzCount = (fz0 + 1 < fineSizes[2]) ? 2 : 1;
+		for (int j = 0; j < ny; ++j)
+		{
+			const int fy0 = 2*(y0 + j);
+			const int fyCount = (fy0 + 1 < fineSizes[1]) ? 2 : 1;
+			unsigned char *texel = texels.data() + (static_cast<size_t>(k)*b + j)*rowBytes;
+			for (int i = 0; i < nx; ++i)
+			{
+				const int fx0 = 2*(x0 + i);
+				const int fxCount = (fx0 + 1 < fineSizes[0]) ? 2 : 1;
+				for (int c = 0; c < this->numberOfComponents; ++c)
+					sums[c] = 0.0;
+				for (int fk = 0; fk < fzCount; ++fk)
+					for (int fj = 0; fj < fyCount; ++fj)
+					{
+						if (!this->getTexelsUnlocked(level - 1, fx0, fy0 + fj, fz0 + fk,
+								fxCount, fineTexels.data()))
+							return false;
+						const unsigned char *fineTexel = fineTexels.data();
+						for (int n = 0; n < fxCount*this->numberOfComponents; ++n)
+						{
+							if (2 == this->numberOfBytesPerComponent)
+							{
+								unsigned short shortValue;
+								memcpy(&shortValue, fineTexel, 2);
+								sums[n % this->numberOfComponents] += shortValue;
+							}
+							else
+							{
+								sums[n % this->numberOfComponents] += *fineTexel;
+							}
+							fineTexel += this->numberOfBytesPerComponent;
+						}
+					}
+				const double scale = 1.0/static_cast<double>(fxCount*fyCount*fzCount);
+				for (int c = 0; c < this->numberOfComponents; ++c)
+				{
+					const double value = sums[c]*scale + 0.5;
+					if (2 == this->numberOfBytesPerComponent)
+					{
+						const unsigned short shortValue = static_cast<unsigned short>(value);
+						memcpy(texel, &shortValue, 2);
+					}
+					else
+					{
+						*texel = static_cast<unsigned char>(value);
+					}
+					texel += this->numberOfBytesPerComponent;
+				}
+			}
+		}
+	}
+	return true;
+}
+
+const TextureBrickCache::Brick *TextureBrickCache::getBrick(int level, int bx, int by, int bz)
+{
+	const unsigned long long key = this->getKey(level, bx, by, bz);
+	if ((this->lastBrickValid) && (this->lastKey == key))
+	{
+		++(this->hitCount);
+		return &(*this->lastBrick);
+	}
+	std::unordered_map<unsigned long long, BrickList::iterator>::iterator iter =
+		this->brickMap.find(key);
+	if (iter != this->brickMap.end())
+	{
+		++(this->hitCount);
+		this->bricks.splice(this->bricks.begin(), this->bricks, iter->second);
+	}
+	else
+	{
+		// build before inserting: coarser levels recursively use finer bricks
+		Brick brick;
+		brick.key = key;
+		if (!this->loadBrick(level, bx, by, bz, brick.texels))
+		{
+			display_message(ERROR_MESSAGE, "TextureBrickCache::getBrick.  "
+				"Failed to read image data from %s",
+				(this->memory) ? "memory" : this->fileName.c_str());
+			return 0;
+		}
+		++(this->loadCount);
+		this->evictToBudget(brick.texels.size());
+		this->memoryUsed += brick.texels.size();
+		this->bricks.push_front(Brick());
+		this->bricks.front().key = key;
+		this->bricks.front().texels.swap(brick.texels);
+		this->brickMap[key] = this->bricks.begin();
+	}
+	this->lastBrick = this->bricks.begin();
+	this->lastKey = key;
+	this->lastBrickValid = true;
+	return &(*this->lastBrick);
+}
+
+bool TextureBrickCache::getTexelsUnlocked(int level, int x, int y, int z, int count,
+	unsigned char *texels)
+{
+	const int b = this->brickSize;
+	const int by = y/b;
+	const int bz = z/b;
+	const size_t rowOffset = (static_cast<size_t>(z % b)*b + (y % b))*b;
+	while (count > 0)
+	{
+		const int bx = x/b;
+		const int i = x % b;
+		const int runCount = (i + count <= b) ? count : (b - i);
+		const Brick *brick = this->getBrick(level, bx, by, bz);
+		if (!brick)
+			return false;
+		const size_t runBytes = static_cast<size_t>(runCount)*this->bytesPerPixel;
+		memcpy(texels, brick->texels.data() + (rowOffset + i)*this->bytesPerPixel, runBytes);
+		texels += runBytes;
+		x += runCount;
+		count -= runCount;
+	}
+	return true;
+}
+
+bool TextureBrickCache::getTexels(int level, int x, int y, int z, int count,
+	unsigned char *texels)
+{
+	std::lock_guard<std::mutex> lock(this->mutex);
+	return this->getTexelsUnlocked(level, x, y, z, count, texels);
+}
@@ -0,0 +1,176 @@
+/**
+ * FILE : texture_brick_cache.hpp
+ *
+ * Out-of-core storage of large images in bricks loaded on demand.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (TEXTURE_BRICK_CACHE_HPP)
+#define TEXTURE_BRICK_CACHE_HPP
+
+#include "cmlibs/zinc/types/streamid.h"
+#include <cstddef>
+#include <fstream>
+#include <list>
+#include <mutex>
+#include <string>
+#include <unordered_map>
+#include <vector>
+
+/**
+ * Stores a large image as fixed-size cubic bricks of texels loaded on demand
+ * from raw pixel data in a file or memory, keeping recently used bricks in a
+ * least-recently-used cache limited by a memory budget.
+ * Raw data has texels packed with components fastest, then x, y, z with no
+ * row padding, and multi-byte components in native byte order.
+ * Coarser mip levels are built on demand by averaging 2x2x2 texels of the
+ * next finer level, and are cached in the same way.
+ * Texel access is thread safe; values are always copied out under a lock.
+ */
+class TextureBrickCache
+{
+public:
+	static const int DEFAULT_BRICK_SIZE = 64;
+	static const size_t DEFAULT_MEMORY_BUDGET = 256*1024*1024;
+
+private:
+	struct Brick
+	{
+		unsigned long long key;
+		std::vector<unsigned char> texels;
+	};
+	typedef std::list<Brick> BrickList;
+
+	int sizes[3];
+	int numberOfComponents;
+	int numberOfBytesPerComponent;
+	int bytesPerPixel;
+	int brickSize;
+	int levelCount;
+	size_t memoryBudget;
+	size_t memoryUsed;
+	// source of level 0 texels
+	std::string fileName;
+	std::ifstream file;
+	const unsigned char *memory;
+	size_t memoryLength;
+	cmzn_streamresource_id memoryResource;
+	BrickList bricks;  // most recently used at front
+	std::unordered_map<unsigned long long, BrickList::iterator> brickMap;
+	BrickList::iterator lastBrick;  // fast path for repeated access to same brick
+	unsigned long long lastKey;
+	bool lastBrickValid;
+	unsigned long long loadCount;
+	unsigned long long hitCount;
+	std::mutex mutex;
+	int access_count;
+
+	TextureBrickCache(const int *sizesIn, int numberOfComponentsIn,
+		int numberOfBytesPerComponentIn, int brickSizeIn, size_t memoryBudgetIn);
+
+	~TextureBrickCache();
+
+	unsigned long long getKey(int level, int bx, int by, int bz) const
+	{
+		return (static_cast<unsigned long long>(level) << 57) |
+			(static_cast<unsigned long long>(bz) << 38) |
+			(static_cast<unsigned long long>(by) << 19) |
+			static_cast<unsigned long long>(bx);
+	}
+
+	const Brick *getBrick(int level, int bx, int by, int bz);
+
+	bool loadBrick(int level, int bx, int by, int bz, std::vector<unsigned char>& texels);
+
+	bool readSourceTexels(int x, int y, int z, int count, unsigned char *texels);
+
+	void evictToBudget(size_t requiredBytes);
+
+	bool getTexelsUnlocked(int level, int x, int y, int z, int count, unsigned char *texels);
+
+public:
+
+	/**
+	 * Create brick cache reading level 0 texels from a raw file.
+	 * @param sizesIn  Width, height and depth of image in texels.
+	 * @return  Accessed cache, or NULL if invalid arguments or file unreadable.
+	 */
+	static TextureBrickCache *createFromFile(const char *fileNameIn,
+		const int *sizesIn, int numberOfComponentsIn, int numberOfBytesPerComponentIn,
+		int brickSizeIn = DEFAULT_BRICK_SIZE, size_t memoryBudgetIn = DEFAULT_MEMORY_BUDGET);
+
+	/**
+	 * Create brick cache reading level 0 texels from memory, e.g. a memory-mapped
+	 * raw file. Memory is not copied; if resource is supplied it is accessed until
+	 * the cache is destroyed, otherwise caller must keep memory valid.
+	 * @return  Accessed cache, or NULL if invalid arguments or memory too small.
+	 */
+	static TextureBrickCache *createFromMemory(const void *memoryIn,
+		size_t memoryLengthIn, cmzn_streamresource_id resource,
+		const int *sizesIn, int numberOfComponentsIn, int numberOfBytesPerComponentIn,
+		int brickSizeIn = DEFAULT_BRICK_SIZE, size_t memoryBudgetIn = DEFAULT_MEMORY_BUDGET);
+
+	TextureBrickCache *access()
+	{
+		++(this->access_count);
+		return this;
+	}
+
+	static int deaccess(TextureBrickCache* &cache);
+
+	/** @return  Number of mip levels, 1 + halvings until all sizes are 1. */
+	int getLevelCount() const
+	{
+		return this->levelCount;
+	}
+
+	/** Get width, height and depth of mip level in texels. */
+	void getLevelSizes(int level, int *levelSizes) const;
+
+	int getBrickSize() const
+	{
+		return this->brickSize;
+	}
+
+	int getNumberOfComponents() const
+	{
+		return this->numberOfComponents;
+	}
+
+	int getNumberOfBytesPerComponent() const
+	{
+		return this->numberOfBytesPerComponent;
+	}
+
+	size_t getMemoryBudget() const
+	{
+		return this->memoryBudget;
+	}
+
+	/** Set memory budget, evicting least recently used bricks to meet it.
+	 * A brick being read is always loaded even if it exceeds the budget. */
+	void setMemoryBudget(size_t memoryBudgetIn);
+
+	/** @return  Memory currently held in cached bricks, in bytes. */
+	size_t getMemoryUsed();
+
+	/** @return  Number of bricks loaded or built since creation. */
+	unsigned long long getLoadCount();
+
+	/** @return  Number of texel requests served from cached bricks. */
+	unsigned long long getHitCount();
+
+	/**
+	 * Copy raw texel bytes for count texels along x from x, y, z on level.
+	 * All texels must be within the level sizes.
+	 * @return  True on success, false if source could not be read.
+	 */
+	bool getTexels(int level, int x, int y, int z, int count, unsigned char *texels);
+
+};
+
+#endif /* !defined (TEXTURE_BRICK_CACHE_HPP) */
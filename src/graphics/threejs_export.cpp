@@ -10,6 +10,7 @@
 * file, You can obtain one at http://mozilla.org/MPL/2.0/. */
 
 #include "general/debug.h"
+#include "general/thread_pool.hpp"
 #include "cmlibs/zinc/material.h"
 #include "graphics/threejs_export.hpp"
 #include "graphics/glyph.hpp"
@@ -81,6 +82,7 @@ int Threejs_export::beginExport()
 
 int Threejs_export::endExport()
 {
+	this->writeMorphBuffers();
 	if (this->isValid())
 	{
 		outputString += verticesMorphString;
@@ -151,43 +153,65 @@ void Threejs_export::writeMorphIntegerBuffer(const char *output_variable_name,
 	if (vertex_buffer && (values_per_vertex > 0)  && (vertex_count > 0) &&
 		(vertex_count > 0) && output)
 	{
-		if (time_step == 0)
+		if (this->morphThreadPool)
 		{
-			(*output) += "\t\"morphColors\": [";
+			MorphBuffer morphBuffer;
+			morphBuffer.output = output;
+			morphBuffer.output_variable_name = output_variable_name;
+			morphBuffer.integerValues.assign(vertex_buffer, vertex_buffer + values_per_vertex*vertex_count);
+			morphBuffer.values_per_vertex = values_per_vertex;
+			morphBuffer.vertex_count = vertex_count;
+			morphBuffer.time_step = time_step;
+			this->morphBuffers.push_back(morphBuffer);
 		}
-		unsigned int number_of_valid_output =  values_per_vertex;
-		if (number_of_valid_output > 3)
-			number_of_valid_output = 3;
-		int *currentVertex = vertex_buffer;
-		char temp[300];
-		sprintf(temp, "\t{ \"name\": \"%s_color_%03d\", \"%s\": [", filename, time_step, output_variable_name);
-		(*output) += temp;
-		for (unsigned int i = 0; i < vertex_count; i++)
+		else
 		{
-			if (((i % 10) == 0))
-			{
-				sprintf(temp,"\n\t\t");
-				(*output) += temp;
-			}
-			for (unsigned int k = 0; k < number_of_valid_output; k++)
-			{
-				sprintf(temp, "%d", currentVertex[k]);
-				(*output) += temp;
-				if (0 == ((k == number_of_valid_output - 1) && (i == vertex_count - 1)))
-				{
-					(*output) += ",";
-				}
-			}
-			currentVertex+=values_per_vertex;
+			formatMorphIntegerBuffer(*output, output_variable_name, vertex_buffer,
+				values_per_vertex, vertex_count, time_step);
 		}
-		if (number_of_time_steps - 1 > time_step)
+	}
+}
+
+void Threejs_export::formatMorphIntegerBuffer(std::string& output, const char *output_variable_name,
+	const int *vertex_buffer, unsigned int values_per_vertex,
+	unsigned int vertex_count, int time_step) const
+{
+	if (time_step == 0)
+	{
+		output += "\t\"morphColors\": [";
+	}
+	unsigned int number_of_valid_output =  values_per_vertex;
+	if (number_of_valid_output > 3)
+		number_of_valid_output = 3;
+	const int *currentVertex = vertex_buffer;
+	char temp[300];
+	sprintf(temp, "\t{ \"name\": \"%s_color_%03d\", \"%s\": [", filename, time_step, output_variable_name);
+	output += temp;
+	for (unsigned int i = 0; i < vertex_count; i++)
+	{
+		if (((i % 10) == 0))
 		{
-			(*output) += "] },\n";
+			sprintf(temp,"\n\t\t");
+			output += temp;
 		}
-		else
+		for (unsigned int k = 0; k < number_of_valid_output; k++)
 		{
-			(*output) += "] }\n\t],\n\n";
+			sprintf(temp, "%d", currentVertex[k]);
+			output += temp;
+			if (0 == ((k == number_of_valid_output - 1) && (i == vertex_count - 1)))
+			{
+				output += ",";
+			}
 		}
+		currentVertex+=values_per_vertex;
+	}
+	if (number_of_time_steps - 1 > time_step)
+	{
+		output += "] },\n";
+	}
+	else
+	{
+		output += "] }\n\t],\n\n";
 	}
 }
 
@@ -235,54 +259,111 @@ void Threejs_export::writeMorphVertexBuffer(const char *output_variable_name,
 	if (vertex_buffer && (values_per_vertex > 0) &&
 		(vertex_count > 0) && output)
 	{
-		if (time_step == 0)
+		if (this->morphThreadPool)
 		{
-			if (!strcmp("vertices", output_variable_name))
-			{
-				(*output) += "\t\"morphTargets\": [";
-			}
+			MorphBuffer morphBuffer;
+			morphBuffer.output = output;
+			morphBuffer.output_variable_name = output_variable_name;
+			morphBuffer.floatValues.assign(vertex_buffer, vertex_buffer + values_per_vertex*vertex_count);
+			morphBuffer.values_per_vertex = values_per_vertex;
+			morphBuffer.vertex_count = vertex_count;
+			morphBuffer.time_step = time_step;
+			this->morphBuffers.push_back(morphBuffer);
+		}
+		else
+		{
+			formatMorphVertexBuffer(*output, output_variable_name, vertex_buffer,
+				values_per_vertex, vertex_count, time_step);
+		}
+	}
+}
+
+void Threejs_export::formatMorphVertexBuffer(std::string& output, const char *output_variable_name,
+	const GLfloat *vertex_buffer, unsigned int values_per_vertex,
+	unsigned int vertex_count, int time_step) const
+{
+	if (time_step == 0)
+	{
+		if (!strcmp("vertices", output_variable_name))
+		{
+			output += "\t\"morphTargets\": [";
+		}
+		else
+		{
+			output += "\t\"morphNormals\": [";
+		}
+	}
+	unsigned int number_of_valid_output =  3;
+	const GLfloat *currentVertex = vertex_buffer;
+
+	char temp[300];
+	sprintf(temp, "\t{ \"name\": \"%s_%03d\", \"%s\": [", filename, time_step, output_variable_name);
+	output += temp;
+	for (unsigned int i = 0; i < vertex_count; i++)
+	{
+		if (((i % 10) == 0))
+		{
+			sprintf(temp,"\n\t\t");
+			output += temp;
+		}
+		for (unsigned int k = 0; k < number_of_valid_output; k++)
+		{
+			if ((number_of_valid_output > values_per_vertex) &&
+				(k >= values_per_vertex))
+				sprintf(temp, "0.0");
 			else
+				sprintf(temp, "%f", currentVertex[k]);
+			output += temp;
+			if (0 == ((k == number_of_valid_output - 1) && (i == vertex_count - 1)))
 			{
-				(*output) += "\t\"morphNormals\": [";
+				output += ",";
 			}
 		}
-		unsigned int number_of_valid_output =  3;
-		GLfloat *currentVertex = vertex_buffer;
+		currentVertex+=values_per_vertex;
+	}
+	if (number_of_time_steps - 1 > time_step)
+	{
+		output += "] },\n";
+	}
+	else
+	{
+		output += "] }\n\t],\n\n";
+	}
+}
 
-		char temp[300];
-		sprintf(temp, "\t{ \"name\": \"%s_%03d\", \"%s\": [", filename, time_step, output_variable_name);
-		(*output) += temp;
-		for (unsigned int i = 0; i < vertex_count; i++)
+/* Format morph buffers deferred over all time steps in parallel and append
+ * them to their outputs in the order they were exported */
+void Threejs_export::writeMorphBuffers()
+{
+	const size_t bufferCount = this->morphBuffers.size();
+	if ((!this->morphThreadPool) || (bufferCount == 0))
+		return;
+	std::vector<std::string> formattedBuffers(bufferCount);
+	this->morphThreadPool->parallelFor(static_cast<size_t>(0), bufferCount, static_cast<size_t>(1),
+		this->morphThreadCount, [&](size_t bufferBegin, size_t bufferEnd, int /*threadIndex*/)
 		{
-			if (((i % 10) == 0))
-			{
-				sprintf(temp,"\n\t\t");
-				(*output) += temp;
-			}
-			for (unsigned int k = 0; k < number_of_valid_output; k++)
+			for (size_t b = bufferBegin; b < bufferEnd; ++b)
 			{
-				if ((number_of_valid_output > values_per_vertex) &&
-					(k >= values_per_vertex))
-					sprintf(temp, "0.0");
+				const MorphBuffer& morphBuffer = this->morphBuffers[b];
+				if (morphBuffer.integerValues.empty())
+				{
+					this->formatMorphVertexBuffer(formattedBuffers[b], morphBuffer.output_variable_name,
+						morphBuffer.floatValues.data(), morphBuffer.values_per_vertex,
+						morphBuffer.vertex_count, morphBuffer.time_step);
+				}
 				else
-					sprintf(temp, "%f", currentVertex[k]);
-				(*output) += temp;
-				if (0 == ((k == number_of_valid_output - 1) && (i == vertex_count - 1)))
 				{
-					(*output) += ",";
+					this->formatMorphIntegerBuffer(formattedBuffers[b], morphBuffer.output_variable_name,
+						morphBuffer.integerValues.data(), morphBuffer.values_per_vertex,
+						morphBuffer.vertex_count, morphBuffer.time_step);
 				}
 			}
-			currentVertex+=values_per_vertex;
-		}
-		if (number_of_time_steps - 1 > time_step)
-		{
-			(*output) += "] },\n";
-		}
-		else
-		{
-			(*output) += "] }\n\t],\n\n";
-		}
+		});
+	for (size_t b = 0; b < bufferCount; ++b)
+	{
+		*(this->morphBuffers[b].output) += formattedBuffers[b];
 	}
+	this->morphBuffers.clear();
 }
 
 /*
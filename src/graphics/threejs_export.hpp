@@ -13,12 +13,18 @@
 #include "graphics/graphics_library.h"
 #include "graphics/render_gl.h"
 #include <string>
+#include <vector>
 #include "jsoncpp/json.h"
 #include "cmlibs/zinc/types/graphicsid.h"
 
 
 struct GT_object;
 
+namespace cmzn
+{
+class ThreadPool;
+}
+
 /* generic threejs_export class with many basic methods to export
  * standard surfaces
  */
@@ -41,6 +47,30 @@ protected:
 	std::string outputString;
 	bool isEmpty;
 
+	/* copy of a morph target buffer at one time step, formatted when export ends */
+	struct MorphBuffer
+	{
+		std::string *output;
+		const char *output_variable_name;
+		std::vector<GLfloat> floatValues;
+		std::vector<int> integerValues;
+		unsigned int values_per_vertex, vertex_count;
+		int time_step;
+	};
+	std::vector<MorphBuffer> morphBuffers;
+	cmzn::ThreadPool *morphThreadPool; // not owned; if set morph buffers are deferred
+	int morphThreadCount;
+
+	void formatMorphVertexBuffer(std::string& output, const char *output_variable_name,
+		const GLfloat *vertex_buffer, unsigned int values_per_vertex,
+		unsigned int vertex_count, int time_step) const;
+
+	void formatMorphIntegerBuffer(std::string& output, const char *output_variable_name,
+		const int *vertex_buffer, unsigned int values_per_vertex,
+		unsigned int vertex_count, int time_step) const;
+
+	void writeMorphBuffers();
+
 	void writeVertexBuffer(const char *output_variable_name,
 		GLfloat *vertex_buffer, unsigned int values_per_vertex,
 		unsigned int vertex_count);
@@ -87,7 +117,9 @@ public:
 		number_of_time_steps(number_of_time_steps_in),
 		groupName(groupNameIn ? duplicate_string(groupNameIn) : nullptr),
 		regionPath(regionPathIn ? duplicate_string(regionPathIn) : nullptr),
-		graphics(graphicsIn)
+		graphics(graphicsIn),
+		morphThreadPool(nullptr),
+		morphThreadCount(1)
 	{
 		if (textureSizesIn)
 		{
@@ -120,6 +152,21 @@ public:
 
 	int endExport();
 
+	/**
+	 * Defer formatting of morph targets until export ends, then format the
+	 * time steps in parallel. Graphics objects for each time step are built
+	 * beforehand by the renderer, concurrently where supported.
+	 * Output is identical to formatting each time step as it is exported.
+	 * @param threadPool  Pool to format time steps on, or NULL to format
+	 * each time step as it is exported.
+	 * @param threadCount  Maximum number of threads, or 0 for all pool threads.
+	 */
+	void setMorphThreads(cmzn::ThreadPool *threadPool, int threadCount)
+	{
+		this->morphThreadPool = threadPool;
+		this->morphThreadCount = threadCount;
+	}
+
 	bool isValid() const
 	{
 		return !isEmpty;
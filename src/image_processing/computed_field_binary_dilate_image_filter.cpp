@@ -4,7 +4,7 @@ FILE : computed_field_binary_dilate_image_filter.cpp
 LAST MODIFIED : 16 July 2007
 
 DESCRIPTION :
-Wraps itk::BinaryDilateImageFilter
+Binary dilate image filter computed natively on image buffers.
 ==============================================================================*/
 /* Zinc Library
 *
@@ -20,10 +20,6 @@ Wraps itk::BinaryDilateImageFilter
 #include "general/mystring.h"
 #include "general/message.h"
 #include "image_processing/computed_field_binary_dilate_image_filter.h"
-#include "itkImage.h"
-#include "itkVector.h"
-#include "itkBinaryBallStructuringElement.h"
-#include "itkBinaryDilateImageFilter.h"
 
 using namespace CMZN;
 
@@ -48,6 +44,9 @@ public:
 private:
 	virtual void create_functor();
 
+	virtual int native_filter(const NativeImageGrid& grid, const ZnReal *input,
+		ZnReal *output);
+
 	Computed_field_core *copy()
 	{
 		return new Computed_field_binary_dilate_image_filter(field->source_fields[0],
@@ -100,71 +99,6 @@ Compare the type specific data.
 	return (return_code);
 } /* Computed_field_binary_dilate_image_filter::compare */
 
-template < class ImageType >
-class Computed_field_binary_dilate_image_filter_Functor :
-	public computed_field_image_filter_FunctorTmpl< ImageType >
-/*******************************************************************************
-LAST MODIFIED : 12 September 2006
-
-DESCRIPTION :
-This class actually does the work of processing images with the filter.
-It is instantiated for each of the chosen ImageTypes.
-==============================================================================*/
-{
-	Computed_field_binary_dilate_image_filter *binary_dilate_image_filter;
-
-public:
-
-	Computed_field_binary_dilate_image_filter_Functor(
-		Computed_field_binary_dilate_image_filter *binary_dilate_image_filter) :
-		computed_field_image_filter_FunctorTmpl< ImageType >(binary_dilate_image_filter),
-		binary_dilate_image_filter(binary_dilate_image_filter)
-	{
-	}
-
-	int set_filter(cmzn_fieldcache& cache)
-/*******************************************************************************
-LAST MODIFIED : 12 September 2006
-
-DESCRIPTION :
-Create a filter of the correct type, set the filter specific parameters
-and generate the outputImage.
-==============================================================================*/
-	{
-		int return_code;
-
-
-		typedef typename ImageType::PixelType  InputPixelType;
-
-		// can not hardcode dimension, it must be consistent with the
-		// dimension of the ImageType
-
-		// create a structuring element for the ImageType
-		typedef itk::BinaryBallStructuringElement< InputPixelType, ImageType::ImageDimension > StructuringElementType;
-
-		StructuringElementType structuringElement;
-		structuringElement.SetRadius( binary_dilate_image_filter->radius );
-		structuringElement.CreateStructuringElement();
-
-		// create a dilate image filter
-		typedef itk::BinaryDilateImageFilter< ImageType , ImageType, StructuringElementType > FilterType;
-
-		typename FilterType::Pointer filter = FilterType::New();		
-		filter->SetKernel(structuringElement);
-		filter->SetDilateValue( binary_dilate_image_filter->dilate_value );
-		filter->SetDilateValue( 1 );
-		
-		// update filter output
-		
-		return_code = binary_dilate_image_filter->update_output_image
-			(cache, filter, this->outputImage,
-			static_cast<ImageType*>(NULL), static_cast<FilterType*>(NULL));
-
-		return (return_code);
-	} /* set_filter */
-
-}; /* template < class ImageType > class Computed_field_binary_dilate_image_filter_Functor */
-
 Computed_field_binary_dilate_image_filter::Computed_field_binary_dilate_image_filter(
 	Computed_field *source_field, int radius, double dilate_value) :
 	computed_field_image_filter(source_field),
@@ -180,15 +114,15 @@ Create the computed_field representation of the BinaryDilateFilter.
 
 void Computed_field_binary_dilate_image_filter::create_functor()
 {
-#if defined DONOTUSE_TEMPLATETEMPLATES
-	create_filters_singlecomponent_multidimensions(
-		Computed_field_binary_dilate_image_filter_Functor, this);
-#else
-	create_filters_singlecomponent_multidimensions
-		< Computed_field_binary_dilate_image_filter_Functor,
-		Computed_field_binary_dilate_image_filter >
-		(this);
-#endif
+	functor = new computed_field_image_filter_NativeFunctor(this);
+}
+
+int Computed_field_binary_dilate_image_filter::native_filter(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output)
+{
+	native_image_filter_binary_dilate(grid, input, output, radius, dilate_value,
+		this->getThreadPool(), number_of_threads);
+	return 1;
 }
 
 int Computed_field_binary_dilate_image_filter::list()
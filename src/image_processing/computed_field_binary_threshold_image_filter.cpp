@@ -4,7 +4,7 @@ FILE : computed_field_binary_threshold_image_filter.cpp
 LAST MODIFIED : 16 May 2008
 
 DESCRIPTION :
-Wraps itk::BinaryThresholdImageFilter
+Binary threshold image filter computed natively on image buffers.
 ==============================================================================*/
 /* Zinc Library
 *
@@ -20,9 +20,6 @@ Wraps itk::BinaryThresholdImageFilter
 #include "general/mystring.h"
 #include "general/message.h"
 #include "image_processing/computed_field_binary_threshold_image_filter.h"
-#include "itkImage.h"
-#include "itkVector.h"
-#include "itkBinaryThresholdImageFilter.h"
 
 using namespace CMZN;
 
@@ -77,6 +74,9 @@ public:
 private:
 	virtual void create_functor();
 
+	virtual int native_filter(const NativeImageGrid& grid, const ZnReal *input,
+		ZnReal *output);
+
 	Computed_field_core *copy()
 	{
 		return new Computed_field_binary_threshold_image_filter(field->source_fields[0],
@@ -137,65 +137,6 @@ int Computed_field_binary_threshold_image_filter::compare(Computed_field_core *o
 	return (return_code);
 } /* Computed_field_binary_threshold_image_filter::compare */
 
-template < class ImageType >
-class Computed_field_binary_threshold_image_filter_Functor :
-	public computed_field_image_filter_FunctorTmpl< ImageType >
-/*******************************************************************************
-LAST MODIFIED : 12 September 2006
-
-DESCRIPTION :
-This class actually does the work of processing images with the filter.
-It is instantiated for each of the chosen ImageTypes.
-==============================================================================*/
-{
-	Computed_field_binary_threshold_image_filter *binary_threshold_image_filter;
-
-public:
-
-	Computed_field_binary_threshold_image_filter_Functor(
-		Computed_field_binary_threshold_image_filter *binary_threshold_image_filter) :
-		computed_field_image_filter_FunctorTmpl< ImageType >(binary_threshold_image_filter),
-		binary_threshold_image_filter(binary_threshold_image_filter)
-	{
-	}
-
-/*****************************************************************************//**
- * Create a filter of the correct type, set the filter specific parameters
- * and generate the output
- * 
- * @param location Field location
- * @return Return code indicating succes (1) or failure (0)
-*/
-	int set_filter(cmzn_fieldcache& cache)
-	{
-		int return_code;
-		
-		typedef itk::BinaryThresholdImageFilter< ImageType , ImageType > FilterType;
-		
-		typename FilterType::Pointer filter = FilterType::New();
-		
-		filter->SetLowerThreshold( binary_threshold_image_filter->lower_threshold );
-		filter->SetUpperThreshold( binary_threshold_image_filter->upper_threshold );
-		
-		return_code = binary_threshold_image_filter->update_output_image
-			(cache, filter, this->outputImage,
-			static_cast<ImageType*>(NULL), static_cast<FilterType*>(NULL));
-		
-		return (return_code);
-	} /* set_filter */
-
-}; /* template < class ImageType > class Computed_field_binary_threshold_image_filter_Functor */
-
-
-/*****************************************************************************//**
- * Constructor for a binary threshold image filter field
- * Creates the computed field representation of the binary threshold image filter
- * 
- * @param field Generic computed field
- * @param lower_threshold Lower threshold value (below which values will be set to 0)
- * @param upper_threshold Upper threshold value (above which values will be set to 0)
- * @return Return code indicating succes (1) or failure (0)
-*/
 Computed_field_binary_threshold_image_filter::Computed_field_binary_threshold_image_filter(
 	Computed_field *source_field, double lower_threshold, double upper_threshold) :
 	computed_field_image_filter(source_field),
@@ -205,15 +146,15 @@ Computed_field_binary_threshold_image_filter::Computed_field_binary_threshold_im
 
 void Computed_field_binary_threshold_image_filter::create_functor()
 {
-#if defined DONOTUSE_TEMPLATETEMPLATES
-	create_filters_singlecomponent_multidimensions(
-		Computed_field_binary_threshold_image_filter_Functor, this);
-#else
-	create_filters_singlecomponent_multidimensions
-		< Computed_field_binary_threshold_image_filter_Functor,
-		Computed_field_binary_threshold_image_filter >
-		(this);
-#endif
+	functor = new computed_field_image_filter_NativeFunctor(this);
+}
+
+int Computed_field_binary_threshold_image_filter::native_filter(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output)
+{
+	native_image_filter_binary_threshold(grid, input, output, lower_threshold,
+		upper_threshold, this->getThreadPool(), number_of_threads);
+	return 1;
 }
 
 /*****************************************************************************//**
@@ -4,7 +4,7 @@ FILE : computed_field_discrete_gaussian_image_filter.c
 LAST MODIFIED : 16 May 2008
 
 DESCRIPTION :
-Wraps itk::DiscreteGaussianImageFilter
+Discrete gaussian image filter computed natively on image buffers.
 ==============================================================================*/
 /* Zinc Library
 *
@@ -20,9 +20,6 @@ Wraps itk::DiscreteGaussianImageFilter
 #include "general/mystring.h"
 #include "general/message.h"
 #include "image_processing/computed_field_discrete_gaussian_image_filter.h"
-#include "itkImage.h"
-#include "itkVector.h"
-#include "itkDiscreteGaussianImageFilter.h"
 
 using namespace CMZN;
 
@@ -77,6 +74,9 @@ public:
 private:
 	virtual void create_functor();
 
+	virtual int native_filter(const NativeImageGrid& grid, const ZnReal *input,
+		ZnReal *output);
+
 	Computed_field_core *copy()
 	{
 		return new Computed_field_discrete_gaussian_image_filter(field->source_fields[0],
@@ -207,55 +207,6 @@ Returns allocated command string for reproducing field. Includes type.
 	return (command_string);
 } /* Computed_field_discrete_gaussian_image_filter::get_command_string */
 
-template < class ImageType >
-class Computed_field_discrete_gaussian_image_filter_Functor :
-	public computed_field_image_filter_FunctorTmpl< ImageType >
-/*******************************************************************************
-LAST MODIFIED : 12 September 2006
-
-DESCRIPTION :
-This class actually does the work of processing images with the filter.
-It is instantiated for each of the chosen ImageTypes.
-==============================================================================*/
-{
-	Computed_field_discrete_gaussian_image_filter *discrete_gaussian_image_filter;
-
-public:
-
-	Computed_field_discrete_gaussian_image_filter_Functor(
-		Computed_field_discrete_gaussian_image_filter *discrete_gaussian_image_filter) :
-		computed_field_image_filter_FunctorTmpl< ImageType >(discrete_gaussian_image_filter),
-		discrete_gaussian_image_filter(discrete_gaussian_image_filter)
-	{
-	}
-
-	int set_filter(cmzn_fieldcache& cache)
-/*******************************************************************************
-LAST MODIFIED : 12 September 2006
-
-DESCRIPTION :
-Create a filter of the correct type, set the filter specific parameters
-and generate the outputImage.
-==============================================================================*/
-	{
-		int return_code;
-
-		typedef itk::DiscreteGaussianImageFilter< ImageType , ImageType > FilterType;
-		
-		typename FilterType::Pointer filter = FilterType::New();
-
-		filter->SetVariance( discrete_gaussian_image_filter->variance );
-		filter->SetMaximumKernelWidth( discrete_gaussian_image_filter->maxKernelWidth);
-		
-		return_code = discrete_gaussian_image_filter->update_output_image
-			(cache, filter, this->outputImage,
-			static_cast<ImageType*>(NULL), static_cast<FilterType*>(NULL));
-		
-		return (return_code);
-	} /* set_filter */
-
-}; /* template < class ImageType > class Computed_field_discrete_gaussian_image_filter_Functor */
-
 Computed_field_discrete_gaussian_image_filter::Computed_field_discrete_gaussian_image_filter(
 	Computed_field *source_field, double variance, int maxKernelWidth) :
 	computed_field_image_filter(source_field), 
@@ -271,14 +222,15 @@ Create the computed_field representation of the DiscreteGaussianImageFilter.
 
 void Computed_field_discrete_gaussian_image_filter::create_functor()
 {
-#if defined DONOTUSE_TEMPLATETEMPLATES
-	create_filters_singlecomponent_multidimensions(
-		Computed_field_discrete_gaussian_image_filter_Functor, this);
-#else
-	create_filters_singlecomponent_multidimensions
-		< Computed_field_discrete_gaussian_image_filter_Functor, Computed_field_discrete_gaussian_image_filter >
-		(this);
-#endif
+	functor = new computed_field_image_filter_NativeFunctor(this);
+}
+
+int Computed_field_discrete_gaussian_image_filter::native_filter(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output)
+{
+	native_image_filter_discrete_gaussian(grid, input, output, variance, maxKernelWidth,
+		this->getThreadPool(), number_of_threads);
+	return 1;
 }
 
 } //namespace
@@ -4,7 +4,7 @@ FILE : computed_field_gradient_magnitude_recursive_gaussian_image_filter.cpp
 LAST MODIFIED : 18 Nov 2006
 
 DESCRIPTION :
-Wraps itk::GradientMagnitudeRecursiveGaussianImageFilter
+Gradient magnitude of gaussian smoothed image computed natively on image buffers.
 ==============================================================================*/
 /* Zinc Library
 *
@@ -20,9 +20,6 @@ Wraps itk::GradientMagnitudeRecursiveGaussianImageFilter
 #include "general/mystring.h"
 #include "general/message.h"
 #include "image_processing/computed_field_gradient_magnitude_recursive_gaussian_image_filter.h"
-#include "itkImage.h"
-#include "itkVector.h"
-#include "itkGradientMagnitudeRecursiveGaussianImageFilter.h"
 
 using namespace CMZN;
 
@@ -46,6 +43,9 @@ public:
 private:
 	virtual void create_functor();
 
+	virtual int native_filter(const NativeImageGrid& grid, const ZnReal *input,
+		ZnReal *output);
+
 	Computed_field_core *copy()
 	{
 		return new Computed_field_gradient_magnitude_recursive_gaussian_image_filter(field->source_fields[0], sigma);
@@ -161,59 +161,6 @@ Returns allocated command string for reproducing field. Includes type.
 	return (command_string);
 } /* Computed_field_gradient_magnitude_recursive_gaussian_image_filter::get_command_string */
 
-template < class ImageType >
-class Computed_field_gradient_magnitude_recursive_gaussian_image_filter_Functor :
-	public computed_field_image_filter_FunctorTmpl< ImageType >
-/*******************************************************************************
-LAST MODIFIED : 12 September 2006
-
-DESCRIPTION :
-This class actually does the work of processing images with the filter.
-It is instantiated for each of the chosen ImageTypes.
-==============================================================================*/
-{
-	Computed_field_gradient_magnitude_recursive_gaussian_image_filter *gradient_magnitude_recursive_gaussian_image_filter;
-
-public:
-
-	Computed_field_gradient_magnitude_recursive_gaussian_image_filter_Functor(
-		Computed_field_gradient_magnitude_recursive_gaussian_image_filter *gradient_magnitude_recursive_gaussian_image_filter) :
-		computed_field_image_filter_FunctorTmpl< ImageType >(gradient_magnitude_recursive_gaussian_image_filter),
-		gradient_magnitude_recursive_gaussian_image_filter(gradient_magnitude_recursive_gaussian_image_filter)
-	{
-	}
-
-	int set_filter(cmzn_fieldcache& cache)
-/*******************************************************************************
-LAST MODIFIED : 12 September 2006
-
-DESCRIPTION :
-Create a filter of the correct type, set the filter specific parameters
-and generate the outputImage.
-==============================================================================*/
-	{
-		int return_code;
-
-		typedef itk::GradientMagnitudeRecursiveGaussianImageFilter< ImageType , ImageType > FilterType;
-		
-		typename FilterType::Pointer filter = FilterType::New();
-
-		/* Code to output sigma value for debugging purposes
-			double sigmaOut = gradient_magnitude_recursive_gaussian_image_filter->sigma;
-			("sigma is %g\n",sigmaOut);
-		*/
-
-		filter->SetSigma( gradient_magnitude_recursive_gaussian_image_filter->sigma );
-		
-		return_code = gradient_magnitude_recursive_gaussian_image_filter->update_output_image
-			(cache, filter, this->outputImage,
-			static_cast<ImageType*>(NULL), static_cast<FilterType*>(NULL));
-		
-		return (return_code);
-	} /* set_filter */
-
-}; /* template < class ImageType > class Computed_field_gradient_magnitude_recursive_gaussian_image_filter_Functor */
-
 Computed_field_gradient_magnitude_recursive_gaussian_image_filter::Computed_field_gradient_magnitude_recursive_gaussian_image_filter(
 	Computed_field *source_field, double sigma) : 
 	computed_field_image_filter(source_field), 
@@ -229,14 +176,15 @@ Create the computed_field representation of the GradientMagnitudeRecursiveGaussi
 
 void Computed_field_gradient_magnitude_recursive_gaussian_image_filter::create_functor()
 {
-#if defined DONOTUSE_TEMPLATETEMPLATES
-	create_filters_singlecomponent_twoormoredimensions(
-		Computed_field_gradient_magnitude_recursive_gaussian_image_filter_Functor, this);
-#else
-	create_filters_singlecomponent_twoormoredimensions
-		< Computed_field_gradient_magnitude_recursive_gaussian_image_filter_Functor, Computed_field_gradient_magnitude_recursive_gaussian_image_filter >
-		(this);
-#endif
+	functor = new computed_field_image_filter_NativeFunctor(this);
+}
+
+int Computed_field_gradient_magnitude_recursive_gaussian_image_filter::native_filter(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output)
+{
+	native_image_filter_gradient_magnitude_gaussian(grid, input, output, sigma,
+		this->getThreadPool(), number_of_threads);
+	return 1;
 }
 
 } //namespace
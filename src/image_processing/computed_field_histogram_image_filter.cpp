@@ -75,6 +75,12 @@ public:
 		const typename HistogramFilterType::HistogramType *outputHistogram,
 		ImageType *dummytemplarg, HistogramFilterType *dummytemplarg2);
 
+	/* histogram output is not an image on the source grid */
+	virtual bool supports_interpolation() const
+	{
+		return false;
+	}
+
 	double getMaginalScale()
 	{
 		return marginalScale;
@@ -616,6 +622,9 @@ protected:
 
 	typename HistogramFilterType::Pointer filter;
 
+	// so only one thread builds histogram when evaluated concurrently
+	std::mutex histogramMutex;
+
 public:
 
 	Computed_field_histogram_image_filter_Functor(
@@ -634,19 +643,15 @@ Updates the outputImage if required and then evaluates the outputImage at the
 location.
 ==============================================================================*/
 	{
-		int return_code;
-		if (!histogram)
+		int return_code = 1;
 		{
-			return_code = set_filter(cache);
-			if (return_code )
+			std::lock_guard<std::mutex> lock(this->histogramMutex);
+			if (!histogram)
 			{
-				return_code = histogram_image_filter->evaluate_histogram
-					(cache, valueCache, histogram,
-					 static_cast<ImageType*>(NULL),
-					 static_cast<HistogramFilterType*>(NULL));
+				return_code = set_filter(cache);
 			}
 		}
-		else
+		if (return_code)
 		{
 			return_code = histogram_image_filter->evaluate_histogram
 				(cache, valueCache, histogram,
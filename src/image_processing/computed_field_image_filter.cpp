@@ -14,11 +14,84 @@ Class used for wrapping itk filters
 #include "cmlibs/zinc/fieldimageprocessing.h"
 #include "computed_field/computed_field.h"
 #include "computed_field/computed_field_private.hpp"
+#include "computed_field/field_cache.hpp"
+#include "computed_field/field_module.hpp"
 #include "image_processing/computed_field_image_filter.h"
 #include "general/debug.h"
 #include "general/mystring.h"
 #include "general/message.h"
 
+namespace {
+
+const int MAXIMUM_SAMPLE_POINTS = 4;
+
+/**
+ * Get pixel indexes, weights and their derivatives w.r.t. xi for
+ * interpolating one dimension of an image with size pixels.
+ * Pixel centres are at xi = (i + 0.5)/size; beyond the outer pixel centres
+ * values are constant with zero derivative.
+ * @return  Number of sample points.
+ */
+int get_sample_weights(enum cmzn_field_imagefilter_interpolation_mode mode,
+	int size, FE_value xi, int *indexes, FE_value *weights, FE_value *dweights)
+{
+	if (mode == CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_NEAREST)
+	{
+		indexes[0] = (xi < 0.0) ? 0 : ((xi >= 1.0) ? (size - 1) :
+			static_cast<int>(xi*static_cast<FE_value>(size)));
+		weights[0] = 1.0;
+		dweights[0] = 0.0;
+		return 1;
+	}
+	FE_value u = xi*static_cast<FE_value>(size) - 0.5;
+	FE_value du_dxi = static_cast<FE_value>(size);
+	if (u <= 0.0)
+	{
+		u = 0.0;
+		du_dxi = 0.0;
+	}
+	else if (u >= static_cast<FE_value>(size - 1))
+	{
+		u = static_cast<FE_value>(size - 1);
+		du_dxi = 0.0;
+	}
+	int i = static_cast<int>(u);
+	if (i > size - 2)
+		i = size - 2;
+	if (i < 0)
+		i = 0;
+	const FE_value t = u - static_cast<FE_value>(i);
+	const int last = size - 1;
+	if (mode == CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_CUBIC)
+	{
+		// Catmull-Rom spline through neighbouring pixel centres, clamped at edges
+		const FE_value t2 = t*t;
+		const FE_value t3 = t2*t;
+		indexes[0] = (i > 0) ? (i - 1) : 0;
+		indexes[1] = i;
+		indexes[2] = (i + 1 < last) ? (i + 1) : last;
+		indexes[3] = (i + 2 < last) ? (i + 2) : last;
+		weights[0] = 0.5*(-t3 + 2.0*t2 - t);
+		weights[1] = 0.5*(3.0*t3 - 5.0*t2 + 2.0);
+		weights[2] = 0.5*(-3.0*t3 + 4.0*t2 + t);
+		weights[3] = 0.5*(t3 - t2);
+		dweights[0] = 0.5*du_dxi*(-3.0*t2 + 4.0*t - 1.0);
+		dweights[1] = 0.5*du_dxi*(9.0*t2 - 10.0*t);
+		dweights[2] = 0.5*du_dxi*(-9.0*t2 + 8.0*t + 1.0);
+		dweights[3] = 0.5*du_dxi*(3.0*t2 - 2.0*t);
+		return 4;
+	}
+	indexes[0] = i;
+	indexes[1] = (i < last) ? (i + 1) : last;
+	weights[0] = 1.0 - t;
+	weights[1] = t;
+	dweights[0] = -du_dxi;
+	dweights[1] = du_dxi;
+	return 2;
+}
+
+}
+
 namespace CMZN {
 int computed_field_image_filter::evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache)
 {
@@ -26,4 +99,304 @@ int computed_field_image_filter::evaluate(cmzn_fieldcache& cache, FieldValueCach
 	return functor->update_and_evaluate_filter(cache, valueCache);
 }
 
+int computed_field_image_filter::evaluateDerivative(cmzn_fieldcache& cache,
+	RealFieldValueCache& inValueCache, const FieldDerivative& fieldDerivative)
+{
+	// analytic first derivatives w.r.t. the image mesh from the interpolant
+	const Field_location_element_xi *element_xi_location;
+	if ((this->interpolation_mode != CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_NEAREST)
+		&& this->supports_interpolation()
+		&& fieldDerivative.isMeshOnly() && (fieldDerivative.getMeshOrder() == 1)
+		&& (fieldDerivative.getMeshDimension() == this->dimension)
+		&& (element_xi_location = cache.get_location_element_xi())
+		&& (element_xi_location->get_element_dimension() == this->dimension))
+	{
+		const ZnReal *pixel_values = this->functor->get_output_values(cache);
+		if (pixel_values)
+		{
+			DerivativeValueCache *derivativeCache = inValueCache.getDerivativeValueCache(fieldDerivative);
+			this->sample_output_values(pixel_values, element_xi_location->get_xi(),
+				inValueCache.values, derivativeCache->values);
+			return 1;
+		}
+	}
+	return this->evaluateDerivativeFiniteDifference(cache, inValueCache, fieldDerivative);
+}
+
+int computed_field_image_filter::set_interpolation_mode(
+	enum cmzn_field_imagefilter_interpolation_mode interpolation_mode_in)
+{
+	if ((interpolation_mode_in != CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_NEAREST)
+		&& (interpolation_mode_in != CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_LINEAR)
+		&& (interpolation_mode_in != CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_CUBIC))
+	{
+		return CMZN_ERROR_ARGUMENT;
+	}
+	if ((interpolation_mode_in != CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_NEAREST)
+		&& (!this->supports_interpolation()))
+	{
+		return CMZN_ERROR_ARGUMENT;
+	}
+	if (interpolation_mode_in != this->interpolation_mode)
+	{
+		this->interpolation_mode = interpolation_mode_in;
+		// output image is unchanged; only sampling of it differs
+		this->field->setChanged();
+	}
+	return CMZN_OK;
+}
+
+void computed_field_image_filter::sample_output_values(const ZnReal *pixel_values,
+	const FE_value *xi, FE_value *values, FE_value *derivatives) const
+{
+	const int componentCount = this->field->number_of_components;
+	int indexes[3][MAXIMUM_SAMPLE_POINTS];
+	FE_value weights[3][MAXIMUM_SAMPLE_POINTS], dweights[3][MAXIMUM_SAMPLE_POINTS];
+	int pointCounts[3] = { 1, 1, 1 };
+	int strides[3] = { 0, 0, 0 };
+	int stride = componentCount;
+	for (int d = 0; d < 3; ++d)
+	{
+		if (d < this->dimension)
+		{
+			pointCounts[d] = get_sample_weights(this->interpolation_mode, this->sizes[d],
+				xi[d], indexes[d], weights[d], dweights[d]);
+			strides[d] = stride;
+			stride *= this->sizes[d];
+		}
+		else
+		{
+			indexes[d][0] = 0;
+			weights[d][0] = 1.0;
+			dweights[d][0] = 0.0;
+		}
+	}
+	for (int c = 0; c < componentCount; ++c)
+		values[c] = 0.0;
+	if (derivatives)
+	{
+		for (int j = componentCount*this->dimension - 1; 0 <= j; --j)
+			derivatives[j] = 0.0;
+	}
+	for (int k = 0; k < pointCounts[2]; ++k)
+	{
+		const int offset_k = indexes[2][k]*strides[2];
+		for (int j = 0; j < pointCounts[1]; ++j)
+		{
+			const int offset_jk = offset_k + indexes[1][j]*strides[1];
+			const FE_value weight_jk = weights[1][j]*weights[2][k];
+			for (int i = 0; i < pointCounts[0]; ++i)
+			{
+				const ZnReal *pixel = pixel_values + offset_jk + indexes[0][i]*strides[0];
+				const FE_value weight = weights[0][i]*weight_jk;
+				for (int c = 0; c < componentCount; ++c)
+					values[c] += weight*pixel[c];
+				if (derivatives)
+				{
+					const FE_value dweight[3] =
+					{
+						dweights[0][i]*weight_jk,
+						weights[0][i]*dweights[1][j]*weights[2][k],
+						weights[0][i]*weights[1][j]*dweights[2][k]
+					};
+					FE_value *derivative = derivatives;
+					for (int c = 0; c < componentCount; ++c)
+					{
+						for (int d = 0; d < this->dimension; ++d)
+							derivative[d] += dweight[d]*pixel[c];
+						derivative += this->dimension;
+					}
+				}
+			}
+		}
+	}
+}
+
+int computed_field_image_filter::create_input_values(cmzn_fieldcache& cache,
+	ZnReal *values)
+{
+	const Field_location_element_xi *element_xi_location = cache.get_location_element_xi();
+	const Field_location_field_values *coordinate_location =
+		(element_xi_location) ? NULL : cache.get_location_field_values();
+	if (!((element_xi_location) || (coordinate_location)))
+	{
+		return 0;
+	}
+	cmzn_field *sourceField = this->getSourceField(0);
+	const int componentCount = sourceField->number_of_components;
+	size_t pixelCount = 1;
+	for (int d = 0; d < this->dimension; ++d)
+	{
+		pixelCount *= this->sizes[d];
+	}
+	// connect output of another filter on the same grid
+	computed_field_image_filter *input_filter =
+		dynamic_cast<computed_field_image_filter *>(sourceField->core);
+	if ((input_filter) && (input_filter->has_same_grid(*this)) && (input_filter->functor))
+	{
+		const ZnReal *pixel_values = input_filter->functor->get_output_values(cache);
+		if (pixel_values)
+		{
+			memcpy(values, pixel_values, pixelCount*componentCount*sizeof(ZnReal));
+			return 1;
+		}
+	}
+	if (Computed_field_image_get_grid_values(sourceField,
+		(element_xi_location) ? NULL : coordinate_location->get_field(),
+		this->dimension, this->sizes, values))
+	{
+		return 1;
+	}
+	// evaluate at pixel centres with a private field cache to avoid stomping current location
+	cmzn_fieldmodule *fieldmodule = cmzn_field_get_fieldmodule(this->field);
+	cmzn_fieldcache *fieldcache = cmzn_fieldmodule_create_fieldcache(fieldmodule);
+	fieldcache->setTime(cache.getTime());
+	int return_code = 1;
+	FE_value pixel_xi[3] = { 0.0, 0.0, 0.0 };
+	int index[3] = { 0, 0, 0 };
+	ZnReal *pixel = values;
+	for (size_t p = 0; p < pixelCount; ++p)
+	{
+		for (int d = 0; d < this->dimension; ++d)
+		{
+			pixel_xi[d] = (static_cast<FE_value>(index[d]) + 0.5)/static_cast<FE_value>(this->sizes[d]);
+		}
+		if (element_xi_location)
+		{
+			fieldcache->setMeshLocation(element_xi_location->get_element(), pixel_xi);
+		}
+		else
+		{
+			fieldcache->setFieldReal(coordinate_location->get_field(), this->dimension, pixel_xi);
+		}
+		const RealFieldValueCache *valueCache = RealFieldValueCache::cast(sourceField->evaluate(*fieldcache));
+		if (!valueCache)
+		{
+			return_code = 0;
+			break;
+		}
+		for (int c = 0; c < componentCount; ++c)
+		{
+			pixel[c] = valueCache->values[c];
+		}
+		pixel += componentCount;
+		for (int d = 0; d < this->dimension; ++d)
+		{
+			if (++index[d] < this->sizes[d])
+			{
+				break;
+			}
+			index[d] = 0;
+		}
+	}
+	cmzn_fieldcache_destroy(&fieldcache);
+	cmzn_fieldmodule_destroy(&fieldmodule);
+	return return_code;
+}
+
+int computed_field_image_filter::evaluate_output_values(cmzn_fieldcache& cache,
+	RealFieldValueCache& valueCache, const ZnReal *pixel_values)
+{
+	const Field_location_element_xi *element_xi_location;
+	const Field_location_field_values *coordinate_location;
+	const FE_value *xi = NULL;
+	if ((element_xi_location = cache.get_location_element_xi()))
+	{
+		xi = element_xi_location->get_xi();
+	}
+	else if ((coordinate_location = cache.get_location_field_values()))
+	{
+		xi = coordinate_location->get_values();
+	}
+	if ((xi) && (pixel_values))
+	{
+		this->sample_output_values(pixel_values, xi, valueCache.values, NULL);
+		return 1;
+	}
+	return 0;
+}
+
+int computed_field_image_filter::evaluate_xi_points(cmzn_fieldcache& cache,
+	int point_count, const FE_value *xi_values, FE_value *values)
+{
+	if ((!this->supports_interpolation()) || (!this->functor))
+	{
+		return CMZN_ERROR_ARGUMENT;
+	}
+	const ZnReal *pixel_values = this->functor->get_output_values(cache);
+	if (!pixel_values)
+	{
+		return CMZN_ERROR_GENERAL;
+	}
+	const int componentCount = this->field->number_of_components;
+	for (int p = 0; p < point_count; ++p)
+	{
+		this->sample_output_values(pixel_values, xi_values + p*this->dimension,
+			values + p*componentCount, NULL);
+	}
+	return CMZN_OK;
+}
+
 } // namespace CMZN
+
+enum cmzn_field_imagefilter_interpolation_mode
+	cmzn_field_imagefilter_get_interpolation_mode(cmzn_field_id field)
+{
+	CMZN::computed_field_image_filter *filter_core = (field) ?
+		dynamic_cast<CMZN::computed_field_image_filter *>(field->core) : NULL;
+	if (filter_core)
+	{
+		return filter_core->get_interpolation_mode();
+	}
+	return CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_INVALID;
+}
+
+int cmzn_field_imagefilter_set_interpolation_mode(cmzn_field_id field,
+	enum cmzn_field_imagefilter_interpolation_mode interpolation_mode)
+{
+	CMZN::computed_field_image_filter *filter_core = (field) ?
+		dynamic_cast<CMZN::computed_field_image_filter *>(field->core) : NULL;
+	if (filter_core)
+	{
+		return filter_core->set_interpolation_mode(interpolation_mode);
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_field_imagefilter_get_number_of_threads(cmzn_field_id field)
+{
+	CMZN::computed_field_image_filter *filter_core = (field) ?
+		dynamic_cast<CMZN::computed_field_image_filter *>(field->core) : NULL;
+	if (filter_core)
+	{
+		return filter_core->get_number_of_threads();
+	}
+	return -1;
+}
+
+int cmzn_field_imagefilter_set_number_of_threads(cmzn_field_id field,
+	int number_of_threads)
+{
+	CMZN::computed_field_image_filter *filter_core = (field) ?
+		dynamic_cast<CMZN::computed_field_image_filter *>(field->core) : NULL;
+	if (filter_core)
+	{
+		return filter_core->set_number_of_threads(number_of_threads);
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_field_imagefilter_evaluate_real_xi_points(cmzn_field_id field,
+	cmzn_fieldcache_id cache, int number_of_points, const double *xi_values,
+	int values_count, double *values)
+{
+	CMZN::computed_field_image_filter *filter_core = (field) ?
+		dynamic_cast<CMZN::computed_field_image_filter *>(field->core) : NULL;
+	if ((filter_core) && (cache) && (cache->getRegion() == field->getRegion()) &&
+		(0 < number_of_points) && (xi_values) && (values) &&
+		(values_count >= number_of_points*field->number_of_components))
+	{
+		return filter_core->evaluate_xi_points(*cache, number_of_points, xi_values, values);
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
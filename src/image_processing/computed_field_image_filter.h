@@ -12,16 +12,23 @@
 #if !defined (computed_field_image_filter_H)
 #define computed_field_image_filter_H
 
+#include "cmlibs/zinc/fieldimageprocessing.h"
 #include "computed_field/computed_field.h"
 #include "computed_field/computed_field_private.hpp"
+#include "computed_field/computed_field_image.h"
 #include "computed_field/computed_field_set.h"
 #include "general/debug.h"
 #include "general/mystring.h"
 #include "general/message.h"
+#include "image_processing/native_image_filters.hpp"
 #include "itkImage.h"
 #include "itkVector.h"
 #include "itkImageRegionIteratorWithIndex.h"
 #include "itkImportImageFilter.h"
+#include <atomic>
+#include <cstring>
+#include <mutex>
+#include <vector>
 
 #if defined (SGI)
 /* The IRIX compiler 7.3.1.3m does not seem to support templates of templates so
@@ -31,6 +38,17 @@
 
 namespace CMZN {
 
+/** Number of ZnReal components in an ITK image pixel type. */
+template <class PixelType> struct ImagePixelComponents
+{
+	static const int count = 1;
+};
+
+template <unsigned int N> struct ImagePixelComponents< itk::Vector<ZnReal, N> >
+{
+	static const int count = static_cast<int>(N);
+};
+
 class computed_field_image_filter_Functor
 {
 public:
@@ -43,6 +61,13 @@ public:
 	}
 
 	virtual int clear_cache() = 0;
+
+	/** Update filter output if required and get its pixel values with
+	 * components fastest then x, y, z, or NULL if not an image output. */
+	virtual const ZnReal *get_output_values(cmzn_fieldcache& /*cache*/)
+	{
+		return NULL;
+	}
 };
 
 class computed_field_image_filter : public Computed_field_core
@@ -56,7 +81,13 @@ public:
 
 	computed_field_image_filter_Functor* functor;
 
-	computed_field_image_filter(Computed_field *source_field) : Computed_field_core()
+	enum cmzn_field_imagefilter_interpolation_mode interpolation_mode;
+
+	int number_of_threads;
+
+	computed_field_image_filter(Computed_field *source_field) : Computed_field_core(),
+		interpolation_mode(CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_NEAREST),
+		number_of_threads(1)
 	{
 		if (Computed_field_get_native_resolution(source_field,
 				&dimension, &sizes, &texture_coordinate_field))
@@ -115,11 +146,91 @@ public:
 
 	virtual int evaluate(cmzn_fieldcache& cache, FieldValueCache& inValueCache);
 
-	virtual int evaluateDerivative(cmzn_fieldcache& cache, RealFieldValueCache& inValueCache, const FieldDerivative& fieldDerivative)
+	virtual int evaluateDerivative(cmzn_fieldcache& cache, RealFieldValueCache& inValueCache, const FieldDerivative& fieldDerivative);
+
+	/** @return  True if output is an image which can be interpolated. */
+	virtual bool supports_interpolation() const
+	{
+		return true;
+	}
+
+	enum cmzn_field_imagefilter_interpolation_mode get_interpolation_mode() const
+	{
+		return this->interpolation_mode;
+	}
+
+	int set_interpolation_mode(enum cmzn_field_imagefilter_interpolation_mode interpolation_mode_in);
+
+	int get_number_of_threads() const
+	{
+		return this->number_of_threads;
+	}
+
+	/** Set maximum number of threads for native filters, 0 for all threads
+	 * in the context's pool. Does not change the filter output. */
+	int set_number_of_threads(int number_of_threads_in)
+	{
+		if (number_of_threads_in < 0)
+			return CMZN_ERROR_ARGUMENT;
+		this->number_of_threads = number_of_threads_in;
+		return CMZN_OK;
+	}
+
+	/** @return  Thread pool for native filters: the owning context's pool. */
+	cmzn::ThreadPool& getThreadPool() const
+	{
+		return this->field->getRegion()->getThreadPool();
+	}
+
+	/**
+	 * Override to filter image natively with computed_field_image_filter_NativeFunctor.
+	 * @param input  Input pixel values with components fastest then x, y, z.
+	 * @param output  Array to receive output pixel values in same layout.
+	 * @return  1 on success, 0 on failure.
+	 */
+	virtual int native_filter(const NativeImageGrid& /*grid*/,
+		const ZnReal * /*input*/, ZnReal * /*output*/)
 	{
-		return this->evaluateDerivativeFiniteDifference(cache, inValueCache, fieldDerivative);
+		return 0;
 	}
 
+	/** Get input image pixel values for the grid, components fastest then
+	 * x, y, z, from another filter on the same grid, directly from image
+	 * field texture memory or by evaluating the source field at each pixel.
+	 * @return  1 on success, 0 on failure. */
+	int create_input_values(cmzn_fieldcache& cache, ZnReal *values);
+
+	/** Evaluate output pixel values at the cache location. */
+	int evaluate_output_values(cmzn_fieldcache& cache, RealFieldValueCache& valueCache,
+		const ZnReal *pixel_values);
+
+	/** Output image is cleared when source fields change so it is rebuilt on
+	 * next evaluation. */
+	virtual int check_dependency()
+	{
+		const int change = Computed_field_core::check_dependency();
+		if (change & MANAGER_CHANGE_RESULT(Computed_field))
+			this->clear_cache();
+		return change;
+	}
+
+	/**
+	 * Sample output pixel values at xi with the current interpolation mode.
+	 * @param pixel_values  Output image values, components fastest then x, y, z.
+	 * @param xi  Image xi location, 0 to 1 across all pixels.
+	 * @param values  Array to receive number of components values.
+	 * @param derivatives  Optional array to receive number of components x
+	 * dimension derivatives w.r.t. xi, xi varying fastest, or NULL if not needed.
+	 */
+	void sample_output_values(const ZnReal *pixel_values, const FE_value *xi,
+		FE_value *values, FE_value *derivatives) const;
+
+	/** Sample output at many image xi locations with the current
+	 * interpolation mode, updating the filter using cache if needed.
+	 * @return  CMZN_OK on success, otherwise an error code. */
+	int evaluate_xi_points(cmzn_fieldcache& cache, int point_count,
+		const FE_value *xi_values, FE_value *values);
+
 protected:
 
 	int clear_cache()
@@ -151,6 +262,18 @@ protected:
 #endif /* !defined (DONOTUSE_TEMPLATETEMPLATES) */
 
 public:
+	/** @return  True if other filter has the same image grid as this one. */
+	bool has_same_grid(const computed_field_image_filter& other) const
+	{
+		if ((dimension != other.dimension) || (!sizes) || (!other.sizes) ||
+			(texture_coordinate_field != other.texture_coordinate_field))
+			return false;
+		for (int i = 0; i < dimension; ++i)
+			if (sizes[i] != other.sizes[i])
+				return false;
+		return true;
+	}
+
 	template <class ImageType >
 	int create_input_image(cmzn_fieldcache& cache,
 		typename ImageType::Pointer &inputImage,
@@ -851,7 +974,15 @@ Evaluate the templated version of this filter
 		}
 		if (dimension > 0)
 		{
-			assign_field_values( valueCache, outputImage->GetPixel( index ) );
+			if (this->interpolation_mode == CMZN_FIELD_IMAGEFILTER_INTERPOLATION_MODE_NEAREST)
+			{
+				assign_field_values( valueCache, outputImage->GetPixel( index ) );
+			}
+			else
+			{
+				this->sample_output_values(reinterpret_cast<const ZnReal *>(
+					outputImage->GetBufferPointer()), xi, valueCache.values, NULL);
+			}
 		}
 		return 1;
 	}
@@ -864,13 +995,30 @@ class computed_field_image_filter_FunctorTmpl :
 {
 protected:
 	typename ImageType::Pointer outputImage;
+	// set once outputImage is built; with mutex so only one thread builds it
+	std::atomic<bool> outputValid;
+	std::mutex outputMutex;
 
 	computed_field_image_filter* image_filter;
 
+	/** Build output image if not already built. Thread safe. */
+	int update_output(cmzn_fieldcache& cache)
+	{
+		std::lock_guard<std::mutex> lock(this->outputMutex);
+		if (!this->outputValid)
+		{
+			if (!set_filter(cache))
+				return 0;
+			this->outputValid = (outputImage) ? true : false;
+		}
+		return 1;
+	}
+
 public:
 
 	computed_field_image_filter_FunctorTmpl(
 		computed_field_image_filter* image_filter) :
+		outputValid(false),
 		image_filter(image_filter)
 	{
 		outputImage = NULL;
@@ -885,27 +1033,18 @@ Updates the outputImage if required and then evaluates the outputImage at the
 location.
 ==============================================================================*/
 	{
-		int return_code;
-		if (!outputImage)
-		{
-			if ( (return_code = set_filter(cache) ) )
-			{
-				return_code = image_filter->evaluate_output_image
-					(cache, valueCache, outputImage,
-					 static_cast<ImageType*>(NULL));
-			}
-		}
-		else
+		if ((!this->outputValid) && (!this->update_output(cache)))
 		{
-			return_code = image_filter->evaluate_output_image
-				(cache, valueCache, outputImage,
-				 static_cast<ImageType*>(NULL));
+			return 0;
 		}
-		return(return_code);
+		return image_filter->evaluate_output_image
+			(cache, valueCache, outputImage,
+			 static_cast<ImageType*>(NULL));
 	}
 
 	int clear_cache()
 	{
+		this->outputValid = false;
 		outputImage = NULL;
 		return (1);
 	}
@@ -915,6 +1054,91 @@ location.
 		return (outputImage);
 	}
 
+	const ZnReal *get_output_values(cmzn_fieldcache& cache)
+	{
+		if ((!this->outputValid) && (!this->update_output(cache)))
+		{
+			return NULL;
+		}
+		if (!outputImage)
+		{
+			return NULL;
+		}
+		// pixel components are packed contiguously as in the bulk input copy
+		return reinterpret_cast<const ZnReal *>(outputImage->GetBufferPointer());
+	}
+
+};
+
+/**
+ * Functor for filters implemented natively on flat pixel buffers, for any
+ * number of components in 1 to 3 dimensions, without ITK.
+ */
+class computed_field_image_filter_NativeFunctor :
+	public computed_field_image_filter_Functor
+{
+	computed_field_image_filter* image_filter;
+	std::vector<ZnReal> outputValues;
+	// set once outputValues are built; with mutex so only one thread builds them
+	std::atomic<bool> outputValid;
+	std::mutex outputMutex;
+
+	/** Build output values if not already built. Thread safe. */
+	bool update_output(cmzn_fieldcache& cache)
+	{
+		std::lock_guard<std::mutex> lock(this->outputMutex);
+		return (this->outputValid) || (this->set_filter(cache));
+	}
+
+public:
+
+	computed_field_image_filter_NativeFunctor(
+		computed_field_image_filter* image_filter) :
+		image_filter(image_filter),
+		outputValid(false)
+	{
+	}
+
+	int set_filter(cmzn_fieldcache& cache)
+	{
+		if ((image_filter->dimension < 1) || (image_filter->dimension > 3))
+		{
+			return 0;
+		}
+		const NativeImageGrid grid(image_filter->dimension, image_filter->sizes,
+			image_filter->getField()->number_of_components);
+		std::vector<ZnReal> inputValues(grid.getValueCount());
+		this->outputValues.resize(grid.getValueCount());
+		this->outputValid = (image_filter->create_input_values(cache, inputValues.data()) &&
+			image_filter->native_filter(grid, inputValues.data(), this->outputValues.data()));
+		return (this->outputValid) ? 1 : 0;
+	}
+
+	int update_and_evaluate_filter(cmzn_fieldcache& cache, RealFieldValueCache& valueCache)
+	{
+		if ((!this->outputValid) && (!this->update_output(cache)))
+		{
+			return 0;
+		}
+		return image_filter->evaluate_output_values(cache, valueCache, this->outputValues.data());
+	}
+
+	int clear_cache()
+	{
+		// keep memory for re-use as image size is fixed
+		this->outputValid = false;
+		return 1;
+	}
+
+	const ZnReal *get_output_values(cmzn_fieldcache& cache)
+	{
+		if ((!this->outputValid) && (!this->update_output(cache)))
+		{
+			return NULL;
+		}
+		return this->outputValues.data();
+	}
+
 };
 
 template < >
@@ -975,10 +1199,11 @@ for subsequent operations.
 		{
 			return_code = 1;
 			cmzn_field_id sourceField = getSourceField(0);
-			// If the input contains an ImageFilter of the correct type then use that as
-			// the input field
+			// If the input contains an ImageFilter of the correct type on the same
+			// grid then connect its output image directly as the input image
 			if ((input_field_image_filter = dynamic_cast<computed_field_image_filter *>
 					(field->source_fields[0]->core))
+					&& (input_field_image_filter->has_same_grid(*this))
 					&& (input_field_image_functor = dynamic_cast<computed_field_image_filter_FunctorTmpl<ImageType>*>
 					(input_field_image_filter->functor)))
 			{
@@ -989,6 +1214,34 @@ for subsequent operations.
 
 				inputImage = input_field_image_functor->get_output_image();
 			}
+			else if ((input_field_image_filter) &&
+				(input_field_image_filter->has_same_grid(*this)) &&
+				(static_cast<size_t>(sourceField->number_of_components)*sizeof(ZnReal) ==
+					sizeof(typename ImageType::PixelType)))
+			{
+				// copy output of native filter on same grid into new image
+				const ZnReal *pixel_values = input_field_image_filter->functor->get_output_values(cache);
+				if (!pixel_values)
+				{
+					return 0;
+				}
+				inputImage = ImageType::New();
+				typename ImageType::IndexType start;
+				typename ImageType::SizeType size;
+				size_t value_count = sourceField->number_of_components;
+				for (i = 0 ; i < dimension ; i++)
+				{
+					start[i] = 0;
+					size[i] = sizes[i];
+					value_count *= sizes[i];
+				}
+				typename ImageType::RegionType region;
+				region.SetSize( size );
+				region.SetIndex( start );
+				inputImage->SetRegions(region);
+				inputImage->Allocate();
+				memcpy(inputImage->GetBufferPointer(), pixel_values, value_count*sizeof(ZnReal));
+			}
 			else
 			{
 				inputImage = ImageType::New();
@@ -1011,82 +1264,97 @@ for subsequent operations.
 			
 				inputImage->SetRegions(region);
 				inputImage->Allocate();
-			
-				FE_value pixel_xi[3];
-				
-				for (i = 0 ; i < 3 ; i++)
-				{
-					pixel_xi[i] = 0.0;
-				}
 
-				// work with a private field cache to avoid stomping current location
-				cmzn_fieldmodule_id field_module = cmzn_field_get_fieldmodule(field);
-				cmzn_fieldcache_id field_cache = cmzn_fieldmodule_create_fieldcache(field_module);
-				field_cache->setTime(cache.getTime());
-				if(element_xi_location)
+				// image fields sampled exactly at texel centres are copied in bulk
+				// from texture memory, with pixel components packed as in ITK images
+				typedef typename ImageType::PixelType PixelType;
+				static_assert(sizeof(PixelType) == ImagePixelComponents<PixelType>::count*sizeof(ZnReal),
+					"Image pixel must be packed ZnReal components for bulk copy");
+				if (!((sourceField->number_of_components == ImagePixelComponents<PixelType>::count) &&
+					Computed_field_image_get_grid_values(sourceField,
+						(element_xi_location) ? (cmzn_field *)NULL : coordinate_location->get_field(),
+						dimension, sizes, reinterpret_cast<ZnReal *>(inputImage->GetBufferPointer()))))
 				{
-					cmzn_element* element = element_xi_location->get_element();
+					FE_value pixel_xi[3];
+				
+					for (i = 0 ; i < 3 ; i++)
+					{
+						pixel_xi[i] = 0.0;
+					}
 
-					itk::ImageRegionIteratorWithIndex< ImageType >
-						generateInput( inputImage, region );
-					for ( generateInput.GoToBegin(); !generateInput.IsAtEnd();
-						++generateInput)
+					// work with a private field cache to avoid stomping current location
+					cmzn_fieldmodule_id field_module = cmzn_field_get_fieldmodule(field);
+					cmzn_fieldcache_id field_cache = cmzn_fieldmodule_create_fieldcache(field_module);
+					field_cache->setTime(cache.getTime());
+					if(element_xi_location)
 					{
-						typename ImageType::IndexType idx = generateInput.GetIndex();
-				
-						/* Find element xi for idx, assuming xi field for now. */
-						for (i = 0 ; i < dimension ; i++)
-						{
-							pixel_xi[i] = ((ZnReal)idx[i] + 0.5) / (ZnReal)sizes[i];
-						}
+						cmzn_element* element = element_xi_location->get_element();
 
-						field_cache->setMeshLocation(element, pixel_xi);
-						const RealFieldValueCache *valueCache = RealFieldValueCache::cast(sourceField->evaluate(*field_cache));
-						if (valueCache)
-						{
-							generateInput.Set( valueCache->values[0] );
-						}
-						else
+						itk::ImageRegionIteratorWithIndex< ImageType >
+							generateInput( inputImage, region );
+						for ( generateInput.GoToBegin(); !generateInput.IsAtEnd();
+							++generateInput)
 						{
-							return_code = 0;
-							break;
+							typename ImageType::IndexType idx = generateInput.GetIndex();
+				
+							/* Find element xi for idx, assuming xi field for now. */
+							for (i = 0 ; i < dimension ; i++)
+							{
+								pixel_xi[i] = ((ZnReal)idx[i] + 0.5) / (ZnReal)sizes[i];
+							}
+
+							field_cache->setMeshLocation(element, pixel_xi);
+							const RealFieldValueCache *valueCache = RealFieldValueCache::cast(sourceField->evaluate(*field_cache));
+							if (valueCache)
+							{
+								typename ImageType::PixelType pixel;
+								setPixelValues(pixel, valueCache->values);
+								generateInput.Set( pixel );
+							}
+							else
+							{
+								return_code = 0;
+								break;
+							}
 						}
 					}
-				}
-				else if (coordinate_location)
-				{
-					cmzn_field* reference_field = coordinate_location->get_field();
-					//FE_value time = coordinate_location->get_time();
-					itk::ImageRegionIteratorWithIndex< ImageType >
-						generateInput( inputImage, region );
-					//Field_location_field_values pixel_location(reference_field, 
-					//	dimension, pixel_xi, time);
-
-					for ( generateInput.GoToBegin(); !generateInput.IsAtEnd(); ++generateInput)
+					else if (coordinate_location)
 					{
-						typename ImageType::IndexType idx = generateInput.GetIndex();
-				
-						/* Find element xi for idx, assuming xi field for now. */
-						for (i = 0 ; i < dimension ; i++)
-						{
-							pixel_xi[i] = ((ZnReal)idx[i] + 0.5) / (ZnReal)sizes[i];
-						}
-
-						field_cache->setFieldReal(reference_field, dimension, pixel_xi);
-						const RealFieldValueCache *valueCache = RealFieldValueCache::cast(sourceField->evaluate(*field_cache));
-						if (valueCache)
-						{
-							generateInput.Set( valueCache->values[0] );
-						}
-						else
+						cmzn_field* reference_field = coordinate_location->get_field();
+						//FE_value time = coordinate_location->get_time();
+						itk::ImageRegionIteratorWithIndex< ImageType >
+							generateInput( inputImage, region );
+						//Field_location_field_values pixel_location(reference_field, 
+						//	dimension, pixel_xi, time);
+
+						for ( generateInput.GoToBegin(); !generateInput.IsAtEnd(); ++generateInput)
 						{
-							return_code = 0;
-							break;
+							typename ImageType::IndexType idx = generateInput.GetIndex();
+				
+							/* Find element xi for idx, assuming xi field for now. */
+							for (i = 0 ; i < dimension ; i++)
+							{
+								pixel_xi[i] = ((ZnReal)idx[i] + 0.5) / (ZnReal)sizes[i];
+							}
+
+							field_cache->setFieldReal(reference_field, dimension, pixel_xi);
+							const RealFieldValueCache *valueCache = RealFieldValueCache::cast(sourceField->evaluate(*field_cache));
+							if (valueCache)
+							{
+								typename ImageType::PixelType pixel;
+								setPixelValues(pixel, valueCache->values);
+								generateInput.Set( pixel );
+							}
+							else
+							{
+								return_code = 0;
+								break;
+							}
 						}
 					}
+					cmzn_fieldcache_destroy(&field_cache);
+					cmzn_fieldmodule_destroy(&field_module);
 				}
-				cmzn_fieldcache_destroy(&field_cache);
-				cmzn_fieldmodule_destroy(&field_module);
 #if defined (NEW_CODE)
 				typedef itk::ImportImageFilter<
 				   typename ImageType::PixelType, ImageType::ImageDimension >
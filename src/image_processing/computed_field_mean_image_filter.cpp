@@ -4,7 +4,7 @@ FILE : computed_field_mean_image_filter.c
 LAST MODIFIED : 9 September 2006
 
 DESCRIPTION :
-Wraps itk::MeanImageFilter
+Mean image filter computed natively on image buffers.
 ==============================================================================*/
 /* Zinc Library
 *
@@ -20,9 +20,6 @@ Wraps itk::MeanImageFilter
 #include "general/mystring.h"
 #include "general/message.h"
 #include "image_processing/computed_field_mean_image_filter.h"
-#include "itkImage.h"
-#include "itkVector.h"
-#include "itkMeanImageFilter.h"
 
 using namespace CMZN;
 
@@ -50,6 +47,9 @@ public:
 private:
 	virtual void create_functor();
 
+	virtual int native_filter(const NativeImageGrid& grid, const ZnReal *input,
+		ZnReal *output);
+
 	Computed_field_core *copy()
 	{
 		return new Computed_field_mean_image_filter(field->source_fields[0], dimension,radius_sizes);
@@ -180,62 +180,6 @@ Returns allocated command string for reproducing field. Includes type.
 	return (command_string);
 } /* Computed_field_mean_image_filter::get_command_string */
 
-template < class ImageType >
-class Computed_field_mean_image_filter_Functor :
-	public computed_field_image_filter_FunctorTmpl< ImageType >
-/*******************************************************************************
-LAST MODIFIED : 12 September 2006
-
-DESCRIPTION :
-This class actually does the work of processing images with the filter.
-It is instantiated for each of the chosen ImageTypes.
-==============================================================================*/
-{
-	Computed_field_mean_image_filter *mean_image_filter;
-
-public:
-
-	Computed_field_mean_image_filter_Functor(
-		Computed_field_mean_image_filter *mean_image_filter) :
-		computed_field_image_filter_FunctorTmpl< ImageType >(mean_image_filter),
-		mean_image_filter(mean_image_filter)
-	{
-	}
-
-	int set_filter(cmzn_fieldcache& cache)
-/*******************************************************************************
-LAST MODIFIED : 12 September 2006
-
-DESCRIPTION :
-Create a filter of the correct type, set the filter specific parameters
-and generate the outputImage.
-==============================================================================*/
-	{
-		int i, return_code;
-
-		typedef itk::MeanImageFilter< ImageType , ImageType > FilterType;
-		
-		typename FilterType::Pointer filter = FilterType::New();
-		typename FilterType::InputSizeType radius;
-		
-		for (i = 0 ; i < mean_image_filter->dimension ; i++)
-		{
-			radius[i] = mean_image_filter->radius_sizes[i];
-		}
-		if (mean_image_filter->dimension > 0)
-		{
-			filter->SetRadius( radius );
-		}
-		
-		return_code = mean_image_filter->update_output_image
-			(cache, filter, this->outputImage,
-			static_cast<ImageType*>(NULL), static_cast<FilterType*>(NULL));
-		
-		return (return_code);
-	} /* set_filter */
-
-}; /* template < class ImageType > class Computed_field_mean_image_filter_Functor */
-
 Computed_field_mean_image_filter::Computed_field_mean_image_filter(
 	Computed_field *source_field, int radius_sizes_count, const int *radius_sizes_in) :
 	computed_field_image_filter(source_field),
@@ -251,7 +195,7 @@ Create the computed_field representation of the MeanImageFilter.
 	radius_sizes = new int[dimension];
 	for (i = 0 ; i < dimension ; i++)
 	{
-		if (i > radius_sizes_count)
+		if (i >= radius_sizes_count)
 			radius_sizes[i] = radius_sizes_in[radius_sizes_count - 1];
 		else
 			radius_sizes[i] = radius_sizes_in[i];
@@ -260,14 +204,15 @@ Create the computed_field representation of the MeanImageFilter.
 
 void Computed_field_mean_image_filter::create_functor()
 {
-#if defined DONOTUSE_TEMPLATETEMPLATES
-	create_filters_singlecomponent_multidimensions(
-		Computed_field_mean_image_filter_Functor, this);
-#else
-	create_filters_singlecomponent_multidimensions
-		< Computed_field_mean_image_filter_Functor, Computed_field_mean_image_filter >
-		(this);
-#endif
+	functor = new computed_field_image_filter_NativeFunctor(this);
+}
+
+int Computed_field_mean_image_filter::native_filter(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output)
+{
+	native_image_filter_mean(grid, input, output, radius_sizes,
+		this->getThreadPool(), number_of_threads);
+	return 1;
 }
 
 } //namespace
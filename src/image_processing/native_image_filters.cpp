@@ -0,0 +1,455 @@
+/**
+ * FILE : native_image_filters.cpp
+ *
+ * Multithreaded image filters operating directly on pixel value buffers.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#include "image_processing/native_image_filters.hpp"
+#include "general/thread_pool.hpp"
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace {
+
+/**
+ * Call function(begin, end) over chunks of item indexes on up to threadCount
+ * threads of the pool, with chunks balanced between threads by stealing.
+ * @param threadCount  Maximum number of threads, 0 for all pool threads.
+ */
+template <class Function>
+void parallel_for_chunks(cmzn::ThreadPool& threadPool, size_t itemCount, int threadCount,
+	Function function)
+{
+	// several chunks per thread so threads finishing early take more work
+	const size_t chunkSize = std::max(static_cast<size_t>(1),
+		itemCount/(8*threadPool.getLoopThreadCount(threadCount, itemCount)));
+	threadPool.parallelFor(static_cast<size_t>(0), itemCount, chunkSize, threadCount,
+		[&](size_t chunkBegin, size_t chunkEnd, int /*threadIndex*/)
+		{
+			function(chunkBegin, chunkEnd);
+		});
+}
+
+/**
+ * Iterates over lines of values along one axis of an image, one line per
+ * component, giving the offset of the first value and the step between values.
+ */
+class ImageAxisLines
+{
+	const CMZN::NativeImageGrid& grid;
+	int axis;
+	int otherSize;  // size of first other axis
+	size_t otherStrides[2];
+	size_t step;
+
+public:
+	ImageAxisLines(const CMZN::NativeImageGrid& gridIn, int axisIn) :
+		grid(gridIn),
+		axis(axisIn)
+	{
+		size_t strides[3];
+		strides[0] = gridIn.componentCount;
+		strides[1] = strides[0]*gridIn.sizes[0];
+		strides[2] = strides[1]*gridIn.sizes[1];
+		this->step = strides[axisIn];
+		const int other0 = (axisIn == 0) ? 1 : 0;
+		const int other1 = (axisIn == 2) ? 1 : 2;
+		this->otherSize = gridIn.sizes[other0];
+		this->otherStrides[0] = strides[other0];
+		this->otherStrides[1] = strides[other1];
+	}
+
+	size_t getLineCount() const
+	{
+		return (this->grid.getPixelCount()/this->grid.sizes[this->axis])*this->grid.componentCount;
+	}
+
+	int getLineSize() const
+	{
+		return this->grid.sizes[this->axis];
+	}
+
+	size_t getStep() const
+	{
+		return this->step;
+	}
+
+	size_t getLineStart(size_t line) const
+	{
+		const size_t component = line % this->grid.componentCount;
+		const size_t pixelLine = line / this->grid.componentCount;
+		return component +
+			(pixelLine % this->otherSize)*this->otherStrides[0] +
+			(pixelLine / this->otherSize)*this->otherStrides[1];
+	}
+};
+
+/**
+ * Copy line of values into buffer with radius values of padding at each end,
+ * clamped to the edge values.
+ */
+inline void gather_padded_line(const ZnReal *values, size_t step, int size,
+	int radius, ZnReal *padded)
+{
+	const ZnReal first = values[0];
+	const ZnReal last = values[(size - 1)*step];
+	for (int i = 0; i < radius; ++i)
+	{
+		padded[i] = first;
+		padded[radius + size + i] = last;
+	}
+	ZnReal *target = padded + radius;
+	for (int i = 0; i < size; ++i)
+	{
+		target[i] = values[i*step];
+	}
+}
+
+/**
+ * Convolve values along axis in place with kernel of 2*radius + 1 weights,
+ * where weight k applies to the value at offset k - radius.
+ */
+void convolve_axis(const CMZN::NativeImageGrid& grid, ZnReal *values, int axis,
+	const std::vector<double>& weights, cmzn::ThreadPool& threadPool,
+	int threadCount)
+{
+	const int radius = static_cast<int>(weights.size()/2);
+	const ImageAxisLines lines(grid, axis);
+	const int size = lines.getLineSize();
+	const size_t step = lines.getStep();
+	parallel_for_chunks(threadPool, lines.getLineCount(), threadCount,
+		[&](size_t lineBegin, size_t lineEnd)
+	{
+		std::vector<ZnReal> padded(size + 2*radius);
+		const double *weight = weights.data();
+		const int weightCount = static_cast<int>(weights.size());
+		for (size_t line = lineBegin; line < lineEnd; ++line)
+		{
+			ZnReal *lineValues = values + lines.getLineStart(line);
+			gather_padded_line(lineValues, step, size, radius, padded.data());
+			for (int i = 0; i < size; ++i)
+			{
+				// contiguous inner loop for vectorisation
+				const ZnReal *source = padded.data() + i;
+				double sum = 0.0;
+				for (int k = 0; k < weightCount; ++k)
+				{
+					sum += weight[k]*source[k];
+				}
+				lineValues[i*step] = static_cast<ZnReal>(sum);
+			}
+		}
+	});
+}
+
+/** Mean of values in window of 2*radius + 1 along axis, in place. */
+void box_mean_axis(const CMZN::NativeImageGrid& grid, ZnReal *values, int axis,
+	int radius, cmzn::ThreadPool& threadPool, int threadCount)
+{
+	if (radius <= 0)
+	{
+		return;
+	}
+	const ImageAxisLines lines(grid, axis);
+	const int size = lines.getLineSize();
+	const size_t step = lines.getStep();
+	const double scale = 1.0/static_cast<double>(2*radius + 1);
+	parallel_for_chunks(threadPool, lines.getLineCount(), threadCount,
+		[&](size_t lineBegin, size_t lineEnd)
+	{
+		std::vector<ZnReal> padded(size + 2*radius);
+		for (size_t line = lineBegin; line < lineEnd; ++line)
+		{
+			ZnReal *lineValues = values + lines.getLineStart(line);
+			gather_padded_line(lineValues, step, size, radius, padded.data());
+			double sum = 0.0;
+			for (int k = 0; k < 2*radius; ++k)
+			{
+				sum += padded[k];
+			}
+			for (int i = 0; i < size; ++i)
+			{
+				sum += padded[i + 2*radius];
+				lineValues[i*step] = static_cast<ZnReal>(sum*scale);
+				sum -= padded[i];
+			}
+		}
+	});
+}
+
+/** @return  exp(-x)*I_n(x) for modified Bessel function of first kind I_n. */
+double scaled_modified_bessel_i(int n, double x)
+{
+	const double logHalfX = std::log(0.5*x);
+	const int maximumTerms = 1000 + static_cast<int>(x);
+	double sum = 0.0;
+	for (int k = 0; k < maximumTerms; ++k)
+	{
+		// evaluated in logs to avoid overflow for large x
+		const double term = std::exp(static_cast<double>(2*k + n)*logHalfX -
+			std::lgamma(k + 1.0) - std::lgamma(k + n + 1.0) - x);
+		sum += term;
+		if ((k > 0.5*x) && (term < 1.0E-16*sum))
+		{
+			break;
+		}
+	}
+	return sum;
+}
+
+/** @return  Normalised discrete gaussian kernel for variance in pixels squared. */
+std::vector<double> get_discrete_gaussian_kernel(double variance,
+	int maximumKernelWidth)
+{
+	std::vector<double> halfKernel;
+	if (variance > 0.0)
+	{
+		const double maximumError = 0.01;
+		const int maximumRadius = std::max(0, (maximumKernelWidth - 1)/2);
+		double sum = 0.0;
+		for (int n = 0; n <= maximumRadius; ++n)
+		{
+			const double coefficient = scaled_modified_bessel_i(n, variance);
+			halfKernel.push_back(coefficient);
+			sum += (n == 0) ? coefficient : 2.0*coefficient;
+			if (sum >= 1.0 - maximumError)
+			{
+				break;
+			}
+		}
+	}
+	else
+	{
+		halfKernel.push_back(1.0);
+	}
+	const int radius = static_cast<int>(halfKernel.size()) - 1;
+	std::vector<double> kernel(2*radius + 1);
+	double sum = 0.0;
+	for (int k = 0; k <= 2*radius; ++k)
+	{
+		kernel[k] = halfKernel[std::abs(k - radius)];
+		sum += kernel[k];
+	}
+	for (int k = 0; k <= 2*radius; ++k)
+	{
+		kernel[k] /= sum;
+	}
+	return kernel;
+}
+
+/** Get list of pixel offsets dx, dy, dz within ball of radius in dimension. */
+std::vector<int> get_ball_offsets(int dimension, int radius)
+{
+	std::vector<int> offsets;
+	const int radiusY = (dimension > 1) ? radius : 0;
+	const int radiusZ = (dimension > 2) ? radius : 0;
+	// as ITK binary ball structuring element: within radius + 0.5 of centre
+	const double limit = (radius + 0.5)*(radius + 0.5);
+	for (int dz = -radiusZ; dz <= radiusZ; ++dz)
+	{
+		for (int dy = -radiusY; dy <= radiusY; ++dy)
+		{
+			for (int dx = -radius; dx <= radius; ++dx)
+			{
+				if (static_cast<double>(dx*dx + dy*dy + dz*dz) <= limit)
+				{
+					offsets.push_back(dx);
+					offsets.push_back(dy);
+					offsets.push_back(dz);
+				}
+			}
+		}
+	}
+	return offsets;
+}
+
+/**
+ * Binary morphology with ball: if dilate, pixels not foreground become
+ * foreground if any pixel in ball is foreground; otherwise foreground pixels
+ * become 0 if any pixel in ball within the image is not foreground.
+ */
+void binary_morphology(const CMZN::NativeImageGrid& grid, const ZnReal *input,
+	ZnReal *output, int radius, double foregroundValue, bool dilate, cmzn::ThreadPool& threadPool,
+	int threadCount)
+{
+	const std::vector<int> offsets = get_ball_offsets(grid.dimension, std::max(0, radius));
+	const size_t offsetCount = offsets.size()/3;
+	const int componentCount = grid.componentCount;
+	const int sizeX = grid.sizes[0];
+	const int sizeY = grid.sizes[1];
+	const int sizeZ = grid.sizes[2];
+	const ZnReal foreground = static_cast<ZnReal>(foregroundValue);
+	parallel_for_chunks(threadPool, static_cast<size_t>(sizeY)*sizeZ, threadCount,
+		[&](size_t rowBegin, size_t rowEnd)
+	{
+		for (size_t row = rowBegin; row < rowEnd; ++row)
+		{
+			const int y = static_cast<int>(row % sizeY);
+			const int z = static_cast<int>(row / sizeY);
+			for (int x = 0; x < sizeX; ++x)
+			{
+				const size_t pixelOffset = ((static_cast<size_t>(z)*sizeY + y)*sizeX + x)*componentCount;
+				for (int c = 0; c < componentCount; ++c)
+				{
+					const ZnReal value = input[pixelOffset + c];
+					ZnReal result = value;
+					if (dilate != (value == foreground))
+					{
+						for (size_t o = 0; o < offsetCount; ++o)
+						{
+							const int qx = x + offsets[3*o];
+							const int qy = y + offsets[3*o + 1];
+							const int qz = z + offsets[3*o + 2];
+							if ((qx < 0) || (qx >= sizeX) || (qy < 0) || (qy >= sizeY) ||
+								(qz < 0) || (qz >= sizeZ))
+							{
+								continue;
+							}
+							const bool isForeground = (input[((static_cast<size_t>(qz)*sizeY + qy)*sizeX + qx)*componentCount + c] == foreground);
+							if (dilate == isForeground)
+							{
+								result = (dilate) ? foreground : 0.0;
+								break;
+							}
+						}
+					}
+					output[pixelOffset + c] = result;
+				}
+			}
+		}
+	});
+}
+
+}
+
+namespace CMZN {
+
+NativeImageGrid::NativeImageGrid(int dimensionIn, const int *sizesIn, int componentCountIn) :
+	dimension(dimensionIn),
+	componentCount(componentCountIn)
+{
+	for (int d = 0; d < 3; ++d)
+	{
+		this->sizes[d] = (d < dimensionIn) ? sizesIn[d] : 1;
+	}
+}
+
+void native_image_filter_mean(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, const int *radii, cmzn::ThreadPool& threadPool,
+	int threadCount)
+{
+	std::copy(input, input + grid.getValueCount(), output);
+	for (int d = 0; d < grid.dimension; ++d)
+	{
+		box_mean_axis(grid, output, d, radii[d], threadPool, threadCount);
+	}
+}
+
+void native_image_filter_discrete_gaussian(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, double variance, int maximumKernelWidth,
+	cmzn::ThreadPool& threadPool, int threadCount)
+{
+	const std::vector<double> kernel = get_discrete_gaussian_kernel(variance, maximumKernelWidth);
+	std::copy(input, input + grid.getValueCount(), output);
+	if (kernel.size() > 1)
+	{
+		for (int d = 0; d < grid.dimension; ++d)
+		{
+			convolve_axis(grid, output, d, kernel, threadPool, threadCount);
+		}
+	}
+}
+
+void native_image_filter_binary_threshold(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, double lowerThreshold,
+	double upperThreshold, cmzn::ThreadPool& threadPool, int threadCount)
+{
+	parallel_for_chunks(threadPool, grid.getValueCount(), threadCount,
+		[&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			output[i] = ((lowerThreshold <= input[i]) && (input[i] <= upperThreshold)) ? 1.0 : 0.0;
+		}
+	});
+}
+
+void native_image_filter_gradient_magnitude_gaussian(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, double sigma, cmzn::ThreadPool& threadPool,
+	int threadCount)
+{
+	if (sigma <= 0.0)
+	{
+		sigma = 1.0;
+	}
+	const int radius = std::max(1, static_cast<int>(std::ceil(4.0*sigma)));
+	std::vector<double> smoothKernel(2*radius + 1);
+	std::vector<double> derivativeKernel(2*radius + 1);
+	double smoothSum = 0.0;
+	double derivativeSum = 0.0;
+	for (int k = 0; k <= 2*radius; ++k)
+	{
+		const double offset = static_cast<double>(k - radius);
+		const double value = std::exp(-0.5*offset*offset/(sigma*sigma));
+		smoothKernel[k] = value;
+		derivativeKernel[k] = offset*value;
+		smoothSum += value;
+		derivativeSum += offset*offset*value;
+	}
+	// scale so smoothing preserves constants and derivative of a ramp is its slope
+	for (int k = 0; k <= 2*radius; ++k)
+	{
+		smoothKernel[k] /= smoothSum;
+		derivativeKernel[k] /= derivativeSum;
+	}
+	const size_t valueCount = grid.getValueCount();
+	std::vector<ZnReal> derivative(valueCount);
+	std::fill(output, output + valueCount, 0.0);
+	for (int d = 0; d < grid.dimension; ++d)
+	{
+		std::copy(input, input + valueCount, derivative.begin());
+		for (int a = 0; a < grid.dimension; ++a)
+		{
+			convolve_axis(grid, derivative.data(), a,
+				(a == d) ? derivativeKernel : smoothKernel, threadPool, threadCount);
+		}
+		parallel_for_chunks(threadPool, valueCount, threadCount,
+			[&](size_t begin, size_t end)
+		{
+			for (size_t i = begin; i < end; ++i)
+			{
+				output[i] += derivative[i]*derivative[i];
+			}
+		});
+	}
+	parallel_for_chunks(threadPool, valueCount, threadCount,
+		[&](size_t begin, size_t end)
+	{
+		for (size_t i = begin; i < end; ++i)
+		{
+			output[i] = std::sqrt(output[i]);
+		}
+	});
+}
+
+void native_image_filter_binary_dilate(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, int radius, double foregroundValue,
+	cmzn::ThreadPool& threadPool, int threadCount)
+{
+	binary_morphology(grid, input, output, radius, foregroundValue, /*dilate*/true, threadPool, threadCount);
+}
+
+void native_image_filter_binary_erode(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, int radius, double foregroundValue,
+	cmzn::ThreadPool& threadPool, int threadCount)
+{
+	binary_morphology(grid, input, output, radius, foregroundValue, /*dilate*/false, threadPool, threadCount);
+}
+
+} // namespace CMZN
@@ -0,0 +1,101 @@
+/**
+ * FILE : native_image_filters.hpp
+ *
+ * Multithreaded image filters operating directly on pixel value buffers.
+ */
+/* Zinc Library
+*
+* This Source Code Form is subject to the terms of the Mozilla Public
+* License, v. 2.0. If a copy of the MPL was not distributed with this
+* file, You can obtain one at http://mozilla.org/MPL/2.0/. */
+
+#if !defined (NATIVE_IMAGE_FILTERS_HPP)
+#define NATIVE_IMAGE_FILTERS_HPP
+
+#include "cmlibs/zinc/zincconfigure.h"
+#include <cstddef>
+
+namespace cmzn {
+class ThreadPool;
+}
+
+namespace CMZN {
+
+/**
+ * Describes a grid of pixel values stored with components fastest, then x,
+ * y, z with no padding. All filters process components independently, and
+ * sample beyond the image edges by clamping to the nearest edge pixel
+ * (zero flux Neumann boundary) unless stated otherwise.
+ */
+struct NativeImageGrid
+{
+	int dimension;  // 1 to 3
+	int sizes[3];  // sizes beyond dimension are 1
+	int componentCount;
+
+	NativeImageGrid(int dimensionIn, const int *sizesIn, int componentCountIn);
+
+	size_t getPixelCount() const
+	{
+		return static_cast<size_t>(this->sizes[0])*this->sizes[1]*this->sizes[2];
+	}
+
+	size_t getValueCount() const
+	{
+		return this->getPixelCount()*this->componentCount;
+	}
+};
+
+/**
+ * Average of pixels in box of +/- radii[d] pixels in each dimension.
+ * Separable, with running sums so cost is independent of radius.
+ * @param threadPool  Pool to run filter on, normally the context's.
+ * @param threadCount  Maximum number of threads, 0 for all pool threads.
+ */
+void native_image_filter_mean(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, const int *radii,
+	cmzn::ThreadPool& threadPool, int threadCount);
+
+/**
+ * Convolve with discrete gaussian kernel of variance in pixels squared,
+ * with coefficients from modified Bessel functions as for the ITK discrete
+ * gaussian filter, truncated at 1% error or maximum kernel width.
+ */
+void native_image_filter_discrete_gaussian(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, double variance, int maximumKernelWidth,
+	cmzn::ThreadPool& threadPool, int threadCount);
+
+/** Set values in [lowerThreshold, upperThreshold] to 1, otherwise 0. */
+void native_image_filter_binary_threshold(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, double lowerThreshold,
+	double upperThreshold, cmzn::ThreadPool& threadPool, int threadCount);
+
+/**
+ * Magnitude of image gradient in pixel units, from derivative of gaussian
+ * with standard deviation sigma pixels along each dimension and gaussian
+ * smoothing in the others.
+ */
+void native_image_filter_gradient_magnitude_gaussian(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, double sigma,
+	cmzn::ThreadPool& threadPool, int threadCount);
+
+/**
+ * Set pixels within a ball of radius pixels of any pixel with
+ * foregroundValue to foregroundValue; other pixels are unchanged.
+ */
+void native_image_filter_binary_dilate(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, int radius, double foregroundValue,
+	cmzn::ThreadPool& threadPool, int threadCount);
+
+/**
+ * Set pixels with foregroundValue to 0 if any pixel within a ball of radius
+ * pixels does not have foregroundValue; other pixels are unchanged. Pixels
+ * beyond the image edges are treated as foreground.
+ */
+void native_image_filter_binary_erode(const NativeImageGrid& grid,
+	const ZnReal *input, ZnReal *output, int radius, double foregroundValue,
+	cmzn::ThreadPool& threadPool, int threadCount);
+
+} // namespace CMZN
+
+#endif /* !defined (NATIVE_IMAGE_FILTERS_HPP) */
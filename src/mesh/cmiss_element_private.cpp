@@ -21,6 +21,7 @@
 #include "general/mystring.h"
 #include "mesh/cmiss_element_private.hpp"
 #include "mesh/mesh.hpp"
+#include "region/cmiss_region.hpp"
 
 
 /*
@@ -395,7 +396,16 @@ int cmzn_element_merge(cmzn_element_id element,
 	cmzn_elementtemplate_id element_template)
 {
 	if (element && element_template)
+	{
+		FE_mesh *feMesh = element->getMesh();
+		if (feMesh)
+		{
+			const int result = feMesh->getRegion()->checkModify("cmzn_element_merge");
+			if (result != CMZN_OK)
+				return result;
+		}
 		return element_template->mergeIntoElement(element);
+	}
 	return CMZN_ERROR_ARGUMENT;
 }
 
@@ -31,6 +31,7 @@
 #include "mesh/nodeset.hpp"
 #include "node/node_operations.h"
 #include "node/nodetemplate.hpp"
+#include "region/cmiss_region.hpp"
 #include <vector>
 
 /*
@@ -86,6 +87,13 @@ int cmzn_node_merge(cmzn_node_id node, cmzn_nodetemplate_id node_template)
 {
 	if ((node) && (node_template))
 	{
+		FE_nodeset *feNodeset = node->getNodeset();
+		if (feNodeset)
+		{
+			const int result = feNodeset->getRegion()->checkModify("cmzn_node_merge");
+			if (result != CMZN_OK)
+				return result;
+		}
 		return node_template->mergeIntoNode(node);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -14,9 +14,12 @@
 #include "computed_field/field_cache.hpp"
 #include "computed_field/field_module.hpp"
 #include "element/elementtemplate.hpp"
+#include "finite_element/finite_element_discretization.h"
 #include "finite_element/finite_element_region_private.h"
+#include "general/index_ordering.hpp"
 #include "mesh/mesh.hpp"
 #include "region/cmiss_region.hpp"
+#include <cmath>
 
 
 void cmzn_mesh::deaccess(cmzn_mesh*& mesh)
@@ -81,6 +84,86 @@ int cmzn_mesh::destroyElementsConditional(cmzn_field* conditional_field)
 	return return_code;
 }
 
+int cmzn_mesh::reorder(cmzn_field* coordinateField, cmzn_field_domain_ordering ordering)
+{
+	cmzn_region* region = this->getRegion();
+	if (!region)
+	{
+		return CMZN_ERROR_ARGUMENT;
+	}
+	const bool spaceFillingCurve = (ordering == CMZN_FIELD_DOMAIN_ORDERING_HILBERT)
+		|| (ordering == CMZN_FIELD_DOMAIN_ORDERING_MORTON);
+	int componentCount = 0;
+	if (spaceFillingCurve)
+	{
+		if ((!coordinateField) || (Computed_field_get_region(coordinateField) != region)
+			|| (!Computed_field_has_numerical_components(coordinateField, nullptr)))
+		{
+			display_message(ERROR_MESSAGE, "Mesh reorder.  Invalid coordinate field");
+			return CMZN_ERROR_ARGUMENT;
+		}
+		componentCount = cmzn_field_get_number_of_components(coordinateField);
+		if (componentCount > 3)
+		{
+			display_message(ERROR_MESSAGE, "Mesh reorder.  Coordinate field must have 1 to 3 components");
+			return CMZN_ERROR_ARGUMENT;
+		}
+	}
+	else if (ordering != CMZN_FIELD_DOMAIN_ORDERING_REVERSE_CUTHILL_MCKEE)
+	{
+		display_message(ERROR_MESSAGE, "Mesh reorder.  Invalid ordering");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	int result = this->feMesh->compactIndexes();
+	if (result != CMZN_OK)
+	{
+		return result;
+	}
+	const DsLabelIndex elementCount = this->feMesh->getSize();
+	if (elementCount < 2)
+	{
+		return CMZN_OK;
+	}
+	std::vector<DsLabelIndex> oldToNewIndexes;
+	if (spaceFillingCurve)
+	{
+		// centres of elements where field is not defined are left non-finite
+		std::vector<double> coordinates(static_cast<size_t>(elementCount)*componentCount, HUGE_VAL);
+		FE_value xi[MAXIMUM_ELEMENT_XI_DIMENSIONS];
+		cmzn_fieldcache* fieldcache = cmzn_fieldcache::create(region);
+		for (DsLabelIndex elementIndex = 0; elementIndex < elementCount; ++elementIndex)
+		{
+			cmzn_element* element = this->feMesh->getElement(elementIndex);
+			double *elementCoordinates = coordinates.data() + elementIndex*componentCount;
+			if ((element) && (CMZN_OK == FE_element_shape_get_xi_centroid(element->getElementShape(), xi))
+				&& (CMZN_OK == fieldcache->setMeshLocation(element, xi))
+				&& (CMZN_OK != cmzn_field_evaluate_real(coordinateField, fieldcache, componentCount, elementCoordinates)))
+			{
+				for (int c = 0; c < componentCount; ++c)
+					elementCoordinates[c] = HUGE_VAL;
+			}
+		}
+		cmzn_fieldcache::deaccess(fieldcache);
+		oldToNewIndexes = (ordering == CMZN_FIELD_DOMAIN_ORDERING_HILBERT) ?
+			cmzn::getHilbertOrder(componentCount, coordinates) :
+			cmzn::getMortonOrder(componentCount, coordinates);
+	}
+	else
+	{
+		std::vector<std::pair<DsLabelIndex, DsLabelIndex> > elementNodes;
+		this->feMesh->getElementNodeIncidences(elementNodes);
+		std::vector<int> adjacencyOffsets, adjacencyIndexes;
+		cmzn::getSharedConnectorAdjacency(elementCount, elementNodes, adjacencyOffsets, adjacencyIndexes);
+		oldToNewIndexes = cmzn::getReverseCuthillMcKeeOrder(adjacencyOffsets, adjacencyIndexes);
+	}
+	if (static_cast<DsLabelIndex>(oldToNewIndexes.size()) != elementCount)
+	{
+		display_message(ERROR_MESSAGE, "Mesh reorder.  Failed to get ordering");
+		return CMZN_ERROR_GENERAL;
+	}
+	return this->feMesh->permuteIndexes(oldToNewIndexes);
+}
+
 char* cmzn_mesh::getName() const
 {
 	return duplicate_string(this->feMesh->getName());
@@ -164,6 +247,31 @@ int cmzn_mesh_destroy(cmzn_mesh_id* mesh_address)
 	return CMZN_ERROR_ARGUMENT;
 }
 
+int cmzn_mesh_compact(cmzn_mesh_id mesh)
+{
+	if (mesh)
+	{
+		const int result = mesh->getRegion()->checkModify("cmzn_mesh_compact");
+		if (result != CMZN_OK)
+			return result;
+		return mesh->getFeMesh()->compactIndexes();
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_mesh_reorder(cmzn_mesh_id mesh, cmzn_field_id coordinate_field,
+	enum cmzn_field_domain_ordering ordering)
+{
+	if (mesh)
+	{
+		const int result = mesh->getRegion()->checkModify("cmzn_mesh_reorder");
+		if (result != CMZN_OK)
+			return result;
+		return mesh->reorder(coordinate_field, ordering);
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 bool cmzn_mesh_contains_element(cmzn_mesh_id mesh, cmzn_element_id element)
 {
 	if (mesh)
@@ -188,6 +296,8 @@ cmzn_element_id cmzn_mesh_create_element(cmzn_mesh_id mesh,
 {
 	if (mesh)
 	{
+		if (mesh->getRegion()->checkModify("cmzn_mesh_create_element") != CMZN_OK)
+			return nullptr;
 		return mesh->createElement(identifier, element_template);
 	}
 	return nullptr;
@@ -220,6 +330,9 @@ int cmzn_mesh_destroy_all_elements(cmzn_mesh_id mesh)
 {
 	if (mesh)
 	{
+		const int result = mesh->getRegion()->checkModify("cmzn_mesh_destroy_all_elements");
+		if (result != CMZN_OK)
+			return result;
 		return mesh->destroyAllElements();
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -229,6 +342,9 @@ int cmzn_mesh_destroy_element(cmzn_mesh_id mesh, cmzn_element_id element)
 {
 	if (mesh && element)
 	{
+		const int result = mesh->getRegion()->checkModify("cmzn_mesh_destroy_element");
+		if (result != CMZN_OK)
+			return result;
 		return mesh->destroyElement(element);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -239,6 +355,9 @@ int cmzn_mesh_destroy_elements_conditional(cmzn_mesh_id mesh,
 {
 	if (mesh)
 	{
+		const int result = mesh->getRegion()->checkModify("cmzn_mesh_destroy_elements_conditional");
+		if (result != CMZN_OK)
+			return result;
 		return mesh->destroyElementsConditional(conditional_field);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -96,6 +96,10 @@ public:
 
 	int destroyElementsConditional(cmzn_field* conditional_field);
 
+	/** Compact then reorder master mesh element storage for locality.
+	 * @param coordinateField  Required for space-filling curve orderings. */
+	int reorder(cmzn_field* coordinateField, cmzn_field_domain_ordering ordering);
+
 	/** @return  Non-accessed element, or nullptr if not found */
 	virtual cmzn_element* findElementByIdentifier(int identifier) const
 	{
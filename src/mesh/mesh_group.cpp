@@ -14,6 +14,7 @@
 #include "mesh/mesh_group.hpp"
 #include "mesh/nodeset_group.hpp"
 #include "finite_element/finite_element_region.h"
+#include "region/cmiss_region.hpp"
 
 
 cmzn_mesh_group::cmzn_mesh_group(FE_mesh* feMeshIn, cmzn_field_group* groupIn) :
@@ -1129,6 +1130,19 @@ void cmzn_mesh_group::destroyedObjectGroup(const DsLabelsGroup& destroyedLabelsG
 	}
 }
 
+void cmzn_mesh_group::compactedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	this->labelsGroup->compactIndexes(oldToNewIndexes);
+}
+
+void cmzn_mesh_group::permutedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	if (!this->labelsGroup->permuteIndexes(oldToNewIndexes))
+	{
+		display_message(ERROR_MESSAGE, "MeshGroup permutedIndexes.  Failed to reorder group");
+	}
+}
+
 /*
 Global functions
 ----------------
@@ -1160,6 +1174,9 @@ int cmzn_mesh_group_add_adjacent_elements(
 {
 	if (mesh_group)
 	{
+		const int result = mesh_group->getRegion()->checkModify("cmzn_mesh_group_add_adjacent_elements");
+		if (result != CMZN_OK)
+			return result;
 		return mesh_group->addAdjacentElements(shared_dimension);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -1169,6 +1186,9 @@ int cmzn_mesh_group_add_element(cmzn_mesh_group_id mesh_group, cmzn_element_id e
 {
 	if (mesh_group)
 	{
+		const int result = mesh_group->getRegion()->checkModify("cmzn_mesh_group_add_element");
+		if (result != CMZN_OK)
+			return result;
 		return mesh_group->addElement(element);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -1179,6 +1199,9 @@ int cmzn_mesh_group_add_elements_conditional(cmzn_mesh_group_id mesh_group,
 {
 	if (mesh_group)
 	{
+		const int result = mesh_group->getRegion()->checkModify("cmzn_mesh_group_add_elements_conditional");
+		if (result != CMZN_OK)
+			return result;
 		return mesh_group->addElementsConditional(conditional_field);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -1203,6 +1226,9 @@ int cmzn_mesh_group_remove_all_elements(cmzn_mesh_group_id mesh_group)
 {
 	if (mesh_group)
 	{
+		const int result = mesh_group->getRegion()->checkModify("cmzn_mesh_group_remove_all_elements");
+		if (result != CMZN_OK)
+			return result;
 		return mesh_group->removeAllElements();
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -1212,6 +1238,9 @@ int cmzn_mesh_group_remove_element(cmzn_mesh_group_id mesh_group, cmzn_element_i
 {
 	if (mesh_group)
 	{
+		const int result = mesh_group->getRegion()->checkModify("cmzn_mesh_group_remove_element");
+		if (result != CMZN_OK)
+			return result;
 		return mesh_group->removeElement(element);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -1222,6 +1251,9 @@ int cmzn_mesh_group_remove_elements_conditional(cmzn_mesh_group_id mesh_group,
 {
 	if (mesh_group)
 	{
+		const int result = mesh_group->getRegion()->checkModify("cmzn_mesh_group_remove_elements_conditional");
+		if (result != CMZN_OK)
+			return result;
 		return mesh_group->removeElementsConditional(conditional_field);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -1231,6 +1263,9 @@ int cmzn_mesh_group_add_element_faces(cmzn_mesh_group_id mesh_group, cmzn_elemen
 {
 	if (mesh_group)
 	{
+		const int result = mesh_group->getRegion()->checkModify("cmzn_mesh_group_add_element_faces");
+		if (result != CMZN_OK)
+			return result;
 		return mesh_group->addElementFaces(element);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -1240,6 +1275,9 @@ int cmzn_mesh_group_remove_element_faces(cmzn_mesh_group_id mesh_group, cmzn_ele
 {
 	if (mesh_group)
 	{
+		const int result = mesh_group->getRegion()->checkModify("cmzn_mesh_group_remove_element_faces");
+		if (result != CMZN_OK)
+			return result;
 		return mesh_group->removeElementFaces(element);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -186,6 +186,10 @@ public:
 
 	void destroyedObjectGroup(const DsLabelsGroup& destroyedLabelsGroup);
 
+	void compactedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes);
+
+	void permutedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes);
+
 };
 
 /**
@@ -13,9 +13,11 @@
 #include "computed_field/field_cache.hpp"
 #include "computed_field/field_module.hpp"
 #include "finite_element/finite_element_region_private.h"
+#include "general/index_ordering.hpp"
 #include "mesh/nodeset.hpp"
 #include "node/nodetemplate.hpp"
 #include "region/cmiss_region.hpp"
+#include <cmath>
 
 
 void cmzn_nodeset::deaccess(cmzn_nodeset*& nodeset)
@@ -85,6 +87,96 @@ int cmzn_nodeset::destroyNodesConditional(cmzn_field* conditional_field)
 	return return_code;
 }
 
+int cmzn_nodeset::reorder(cmzn_field* coordinateField, cmzn_field_domain_ordering ordering)
+{
+	cmzn_region* region = this->getRegion();
+	if (!region)
+	{
+		return CMZN_ERROR_ARGUMENT;
+	}
+	const bool spaceFillingCurve = (ordering == CMZN_FIELD_DOMAIN_ORDERING_HILBERT)
+		|| (ordering == CMZN_FIELD_DOMAIN_ORDERING_MORTON);
+	int componentCount = 0;
+	if (spaceFillingCurve)
+	{
+		if ((!coordinateField) || (Computed_field_get_region(coordinateField) != region)
+			|| (!Computed_field_has_numerical_components(coordinateField, nullptr)))
+		{
+			display_message(ERROR_MESSAGE, "Nodeset reorder.  Invalid coordinate field");
+			return CMZN_ERROR_ARGUMENT;
+		}
+		componentCount = cmzn_field_get_number_of_components(coordinateField);
+		if (componentCount > 3)
+		{
+			display_message(ERROR_MESSAGE, "Nodeset reorder.  Coordinate field must have 1 to 3 components");
+			return CMZN_ERROR_ARGUMENT;
+		}
+	}
+	else if (ordering != CMZN_FIELD_DOMAIN_ORDERING_REVERSE_CUTHILL_MCKEE)
+	{
+		display_message(ERROR_MESSAGE, "Nodeset reorder.  Invalid ordering");
+		return CMZN_ERROR_ARGUMENT;
+	}
+	int result = this->feNodeset->compactIndexes();
+	if (result != CMZN_OK)
+	{
+		return result;
+	}
+	const DsLabelIndex nodeCount = this->feNodeset->getSize();
+	if (nodeCount < 2)
+	{
+		return CMZN_OK;
+	}
+	std::vector<DsLabelIndex> oldToNewIndexes;
+	if (spaceFillingCurve)
+	{
+		// nodes where field is not defined are left non-finite
+		std::vector<double> coordinates(static_cast<size_t>(nodeCount)*componentCount, HUGE_VAL);
+		cmzn_fieldcache* fieldcache = cmzn_fieldcache::create(region);
+		for (DsLabelIndex nodeIndex = 0; nodeIndex < nodeCount; ++nodeIndex)
+		{
+			cmzn_node* node = this->feNodeset->getNode(nodeIndex);
+			double *nodeCoordinates = coordinates.data() + nodeIndex*componentCount;
+			if ((node) && (CMZN_OK == fieldcache->setNode(node))
+				&& (CMZN_OK != cmzn_field_evaluate_real(coordinateField, fieldcache, componentCount, nodeCoordinates)))
+			{
+				for (int c = 0; c < componentCount; ++c)
+					nodeCoordinates[c] = HUGE_VAL;
+			}
+		}
+		cmzn_fieldcache::deaccess(fieldcache);
+		oldToNewIndexes = (ordering == CMZN_FIELD_DOMAIN_ORDERING_HILBERT) ?
+			cmzn::getHilbertOrder(componentCount, coordinates) :
+			cmzn::getMortonOrder(componentCount, coordinates);
+	}
+	else
+	{
+		// connect nodes used by the same element of any mesh using them
+		std::vector<std::pair<int, int> > nodeElements;
+		int connectorOffset = 0;
+		for (int dimension = 1; dimension <= MAXIMUM_ELEMENT_XI_DIMENSIONS; ++dimension)
+		{
+			FE_mesh* feMesh = FE_region_find_FE_mesh_by_dimension(this->feNodeset->get_FE_region(), dimension);
+			if ((!feMesh) || (feMesh->getNodeset() != this->feNodeset))
+				continue;
+			std::vector<std::pair<DsLabelIndex, DsLabelIndex> > elementNodes;
+			feMesh->getElementNodeIncidences(elementNodes);
+			for (const auto& elementNode : elementNodes)
+				nodeElements.push_back(std::make_pair(elementNode.second, connectorOffset + elementNode.first));
+			connectorOffset += feMesh->getLabels().getIndexSize();
+		}
+		std::vector<int> adjacencyOffsets, adjacencyIndexes;
+		cmzn::getSharedConnectorAdjacency(nodeCount, nodeElements, adjacencyOffsets, adjacencyIndexes);
+		oldToNewIndexes = cmzn::getReverseCuthillMcKeeOrder(adjacencyOffsets, adjacencyIndexes);
+	}
+	if (static_cast<DsLabelIndex>(oldToNewIndexes.size()) != nodeCount)
+	{
+		display_message(ERROR_MESSAGE, "Nodeset reorder.  Failed to get ordering");
+		return CMZN_ERROR_GENERAL;
+	}
+	return this->feNodeset->permuteIndexes(oldToNewIndexes);
+}
+
 char* cmzn_nodeset::getName() const
 {
 	return duplicate_string(this->feNodeset->getName());
@@ -169,6 +261,31 @@ int cmzn_nodeset_destroy(cmzn_nodeset_id* nodeset_address)
 	return CMZN_ERROR_ARGUMENT;
 }
 
+int cmzn_nodeset_compact(cmzn_nodeset_id nodeset)
+{
+	if (nodeset)
+	{
+		const int result = nodeset->getRegion()->checkModify("cmzn_nodeset_compact");
+		if (result != CMZN_OK)
+			return result;
+		return nodeset->getFeNodeset()->compactIndexes();
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_nodeset_reorder(cmzn_nodeset_id nodeset, cmzn_field_id coordinate_field,
+	enum cmzn_field_domain_ordering ordering)
+{
+	if (nodeset)
+	{
+		const int result = nodeset->getRegion()->checkModify("cmzn_nodeset_reorder");
+		if (result != CMZN_OK)
+			return result;
+		return nodeset->reorder(coordinate_field, ordering);
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 bool cmzn_nodeset_contains_node(cmzn_nodeset_id nodeset, cmzn_node_id node)
 {
 	if (nodeset && node)
@@ -193,6 +310,8 @@ cmzn_node_id cmzn_nodeset_create_node(cmzn_nodeset_id nodeset,
 {
 	if (nodeset && node_template)
 	{
+		if (nodeset->getRegion()->checkModify("cmzn_nodeset_create_node") != CMZN_OK)
+			return nullptr;
 		return nodeset->createNode(identifier, node_template);
 	}
 	return nullptr;
@@ -244,6 +363,9 @@ int cmzn_nodeset_destroy_all_nodes(cmzn_nodeset_id nodeset)
 {
 	if (nodeset)
 	{
+		const int result = nodeset->getRegion()->checkModify("cmzn_nodeset_destroy_all_nodes");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset->destroyAllNodes();
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -253,6 +375,9 @@ int cmzn_nodeset_destroy_node(cmzn_nodeset_id nodeset, cmzn_node_id node)
 {
 	if (nodeset && node)
 	{
+		const int result = nodeset->getRegion()->checkModify("cmzn_nodeset_destroy_node");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset->destroyNode(node);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -263,6 +388,9 @@ int cmzn_nodeset_destroy_nodes_conditional(cmzn_nodeset_id nodeset,
 {
 	if (nodeset && conditional_field)
 	{
+		const int result = nodeset->getRegion()->checkModify("cmzn_nodeset_destroy_nodes_conditional");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset->destroyNodesConditional(conditional_field);
 	}
 	return CMZN_ERROR_ARGUMENT;
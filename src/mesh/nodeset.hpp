@@ -99,6 +99,10 @@ public:
 
 	int destroyNodesConditional(cmzn_field* conditional_field);
 
+	/** Compact then reorder master nodeset node storage for locality.
+	 * @param coordinateField  Required for space-filling curve orderings. */
+	int reorder(cmzn_field* coordinateField, cmzn_field_domain_ordering ordering);
+
 	/** @return  Non-accessed node, or nullptr if not found */
 	virtual cmzn_node* findNodeByIdentifier(int identifier) const
 	{
@@ -12,6 +12,7 @@
 #include "general/mystring.h"
 #include "mesh/nodeset_group.hpp"
 #include "finite_element/finite_element_region.h"
+#include "region/cmiss_region.hpp"
 
 
 cmzn_nodeset_group::cmzn_nodeset_group(FE_nodeset* feNodesetIn, cmzn_field_group* groupIn) :
@@ -361,6 +362,19 @@ void cmzn_nodeset_group::destroyedObjectGroup(const DsLabelsGroup& destroyedLabe
 	}
 }
 
+void cmzn_nodeset_group::compactedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	this->labelsGroup->compactIndexes(oldToNewIndexes);
+}
+
+void cmzn_nodeset_group::permutedIndexes(const std::vector<DsLabelIndex>& oldToNewIndexes)
+{
+	if (!this->labelsGroup->permuteIndexes(oldToNewIndexes))
+	{
+		display_message(ERROR_MESSAGE, "NodesetGroup permutedIndexes.  Failed to reorder group");
+	}
+}
+
 /*
 Global functions
 ----------------
@@ -391,6 +405,9 @@ int cmzn_nodeset_group_add_node(cmzn_nodeset_group_id nodeset_group, cmzn_node_i
 {
 	if (nodeset_group)
 	{
+		const int result = nodeset_group->getRegion()->checkModify("cmzn_nodeset_group_add_node");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset_group->addNode(node);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -401,6 +418,9 @@ int cmzn_nodeset_group_add_nodes_conditional(
 {
 	if (nodeset_group)
 	{
+		const int result = nodeset_group->getRegion()->checkModify("cmzn_nodeset_group_add_nodes_conditional");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset_group->addNodesConditional(conditional_field);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -425,6 +445,9 @@ int cmzn_nodeset_group_remove_all_nodes(cmzn_nodeset_group_id nodeset_group)
 {
 	if (nodeset_group)
 	{
+		const int result = nodeset_group->getRegion()->checkModify("cmzn_nodeset_group_remove_all_nodes");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset_group->removeAllNodes();
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -434,6 +457,9 @@ int cmzn_nodeset_group_remove_node(cmzn_nodeset_group_id nodeset_group, cmzn_nod
 {
 	if (nodeset_group)
 	{
+		const int result = nodeset_group->getRegion()->checkModify("cmzn_nodeset_group_remove_node");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset_group->removeNode(node);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -444,6 +470,9 @@ int cmzn_nodeset_group_remove_nodes_conditional(cmzn_nodeset_group_id nodeset_gr
 {
 	if (nodeset_group)
 	{
+		const int result = nodeset_group->getRegion()->checkModify("cmzn_nodeset_group_remove_nodes_conditional");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset_group->removeNodesConditional(conditional_field);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -454,6 +483,9 @@ int cmzn_nodeset_group_add_element_nodes(
 {
 	if (nodeset_group)
 	{
+		const int result = nodeset_group->getRegion()->checkModify("cmzn_nodeset_group_add_element_nodes");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset_group->addElementNodes(element);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -464,6 +496,9 @@ int cmzn_nodeset_group_remove_element_nodes(
 {
 	if (nodeset_group)
 	{
+		const int result = nodeset_group->getRegion()->checkModify("cmzn_nodeset_group_remove_element_nodes");
+		if (result != CMZN_OK)
+			return result;
 		return nodeset_group->removeElementNodes(element);
 	}
 	return CMZN_ERROR_ARGUMENT;
@@ -30,6 +30,7 @@
 #include "general/debug.h"
 #include "general/message.h"
 #include "general/mystring.h"
+#include "general/performance_counters.hpp"
 #include "graphics/scene.hpp"
 #include "mesh/mesh.hpp"
 #include "mesh/mesh_group.hpp"
@@ -102,6 +103,79 @@ void cmzn_regionnotifier::deaccess(cmzn_regionnotifier* &notifier)
 	}
 }
 
+cmzn_regiontransaction::cmzn_regiontransaction(cmzn_region *regionIn) :
+	region(regionIn->access()),
+	committed(false),
+	timings{},
+	timerLevel(0),
+	fieldmoduleEventCount(0),
+	regionEventCount(0),
+	access_count(1)
+{
+	this->region->beginHierarchicalChange();
+}
+
+cmzn_regiontransaction::~cmzn_regiontransaction()
+{
+	cmzn_region::deaccess(this->region);
+}
+
+void cmzn_regiontransaction::deaccess(cmzn_regiontransaction* &transaction)
+{
+	if (transaction)
+	{
+		--(transaction->access_count);
+		if (transaction->access_count <= 0)
+		{
+			if (!transaction->committed)
+			{
+				// not committed: end its change so the region tree is not left caching
+				display_message(WARNING_MESSAGE, "Regiontransaction destroy.  "
+					"Ending change for transaction which was not committed");
+				transaction->region->endHierarchicalChange();
+			}
+			delete transaction;
+		}
+		transaction = nullptr;
+	}
+}
+
+int cmzn_regiontransaction::commit()
+{
+	if (this->committed)
+	{
+		display_message(ERROR_MESSAGE, "Regiontransaction commit.  Already committed");
+		return CMZN_ERROR_ALREADY_EXISTS;
+	}
+	this->committed = true;
+	// notifications are only sent by the outermost change on the region and
+	// its ancestors, whose changes or hierarchical changes defer them
+	bool outermost = (1 == this->region->change_level) &&
+		(1 == this->region->getSumHierarchicalChangeLevel());
+	for (const cmzn_region *ancestor = this->region->parent; (outermost) && (ancestor); ancestor = ancestor->parent)
+	{
+		if (0 < ancestor->change_level)
+			outermost = false;
+	}
+	if (!outermost)
+	{
+		this->region->endHierarchicalChange();
+		return CMZN_OK;
+	}
+	cmzn_regiontransaction *previousTransaction = this->region->committingTransaction;
+	this->region->committingTransaction = this;
+	const std::chrono::steady_clock::time_point startTime = std::chrono::steady_clock::now();
+	this->region->endHierarchicalChange();
+	const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - startTime;
+	this->region->committingTransaction = previousTransaction;
+	this->timings[CMZN_REGIONTRANSACTION_TIMING_TOTAL] = elapsed.count();
+	const double fieldChangesTime = elapsed.count()
+		- this->timings[CMZN_REGIONTRANSACTION_TIMING_FIELDMODULE_CALLBACKS]
+		- this->timings[CMZN_REGIONTRANSACTION_TIMING_REGION_CALLBACKS];
+	this->timings[CMZN_REGIONTRANSACTION_TIMING_FIELD_CHANGES] = (fieldChangesTime > 0.0) ? fieldChangesTime : 0.0;
+	return CMZN_OK;
+}
+
 int cmzn_regionnotifier::setCallback(cmzn_regionnotifier_callback_function function_in,
 	void *user_data_in)
 {
@@ -144,6 +218,8 @@ cmzn_region::cmzn_region(cmzn_context* contextIn) :
 	change_level(0),
 	hierarchical_change_level(0),
 	regionChanged(false),
+	committingTransaction(nullptr),
+	freeze_level(0),
 	access_count(1)
 {
 	Computed_field_manager_set_region(this->field_manager, this);
@@ -285,6 +361,9 @@ void cmzn_region::Computed_field_change(
 	// otherwise cmzn_fieldmoduleevent will access and destroy region again
 	if (message && region && (region->access_count > 0))
 	{
+		static cmzn::PerformanceCounter *fieldChangeCounter =
+			cmzn::PerformanceCounters::getCounter("change_notification", "fields");
+		cmzn::PerformanceTimer fieldChangeTimer(fieldChangeCounter);
 		int change_summary = MANAGER_MESSAGE_GET_CHANGE_SUMMARY(Computed_field)(message);
 		// clear active field caches for changed fields
 		if ((change_summary & MANAGER_CHANGE_RESULT(Computed_field)) &&
@@ -309,13 +388,21 @@ void cmzn_region::Computed_field_change(
 			FE_region_changes *changes = FE_region_changes::create(region->fe_region);
 			event->setFeRegionChanges(changes);
 			FE_region_changes::deaccess(changes);
-			for (cmzn_fieldmodulenotifier_list::iterator iter = region->fieldmodulenotifierList.begin();
-				iter != region->fieldmodulenotifierList.end(); ++iter)
+			cmzn_regiontransaction *transaction = region->getCommittingTransaction();
 			{
-				(*iter)->notify(event);
+				cmzn_regiontransaction::Timer timer(transaction, CMZN_REGIONTRANSACTION_TIMING_FIELDMODULE_CALLBACKS);
+				for (cmzn_fieldmodulenotifier_list::iterator iter = region->fieldmodulenotifierList.begin();
+					iter != region->fieldmodulenotifierList.end(); ++iter)
+				{
+					(*iter)->notify(event);
+					if (transaction)
+						transaction->addFieldmoduleEvent();
+				}
 			}
 			cmzn_fieldmoduleevent::deaccess(event);
 		}
+		// parent region times its own notification
+		fieldChangeTimer.stop();
 		if (change_summary & (MANAGER_CHANGE_RESULT(Computed_field) |
 			MANAGER_CHANGE_ADD(Computed_field)))
 		{
@@ -336,6 +423,9 @@ void cmzn_region::Computed_field_change(
  */
 void cmzn_region::notifyRegionChanged()
 {
+	static cmzn::PerformanceCounter *regionChangeCounter =
+		cmzn::PerformanceCounters::getCounter("change_notification", "region");
+	cmzn::PerformanceTimer regionChangeTimer(regionChangeCounter);
 	this->regionChanged = false;
 	if (this->parent)
 	{
@@ -348,13 +438,20 @@ void cmzn_region::notifyRegionChanged()
 	if (0 < this->regionnotifierList.size())
 	{
 		cmzn_regionevent *event = cmzn_regionevent::create(this);
-		for (cmzn_regionnotifier_list::iterator iter = this->regionnotifierList.begin();
-			iter != this->regionnotifierList.end(); ++iter)
+		cmzn_regiontransaction *transaction = this->getCommittingTransaction();
 		{
-			(*iter)->notify(event);
+			cmzn_regiontransaction::Timer timer(transaction, CMZN_REGIONTRANSACTION_TIMING_REGION_CALLBACKS);
+			for (cmzn_regionnotifier_list::iterator iter = this->regionnotifierList.begin();
+				iter != this->regionnotifierList.end(); ++iter)
+			{
+				(*iter)->notify(event);
+				if (transaction)
+					transaction->addRegionEvent();
+			}
 		}
 		cmzn_regionevent::deaccess(event);
 	}
+	regionChangeTimer.stop();
 	if (this->parent)
 	{
 		this->parent->endRegionChangedChild();
@@ -464,6 +561,84 @@ int cmzn_region::getSumHierarchicalChangeLevel() const
 	return sum_hierarchical_change_level;
 }
 
+int cmzn_region::beginFreeze()
+{
+	if (0 < this->change_level)
+	{
+		display_message(ERROR_MESSAGE,
+			"Region beginFreeze.  Cannot freeze region while it is caching changes");
+		return CMZN_ERROR_IN_USE;
+	}
+	++(this->freeze_level);
+	return CMZN_OK;
+}
+
+int cmzn_region::endFreeze()
+{
+	if (0 < this->freeze_level)
+	{
+		--(this->freeze_level);
+		return CMZN_OK;
+	}
+	display_message(ERROR_MESSAGE,
+		"Region endFreeze.  Freeze level is already zero");
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_region::beginBackgroundFreeze(void *owner, std::function<void()> stop)
+{
+	if ((!owner) || (!stop) || (this->backgroundFreezes.find(owner) != this->backgroundFreezes.end()))
+		return CMZN_ERROR_ARGUMENT;
+	// caller falls back to evaluating now, so no error message
+	if (0 < this->change_level)
+		return CMZN_ERROR_IN_USE;
+	const int result = this->beginFreeze();
+	if (CMZN_OK == result)
+		this->backgroundFreezes[owner] = stop;
+	return result;
+}
+
+int cmzn_region::endBackgroundFreeze(void *owner)
+{
+	auto iter = this->backgroundFreezes.find(owner);
+	if (iter == this->backgroundFreezes.end())
+		return CMZN_ERROR_NOT_FOUND;
+	this->backgroundFreezes.erase(iter);
+	return this->endFreeze();
+}
+
+void cmzn_region::stopBackgroundFreezes()
+{
+	while (!this->backgroundFreezes.empty())
+	{
+		auto iter = this->backgroundFreezes.begin();
+		std::function<void()> stop = iter->second;
+		this->backgroundFreezes.erase(iter);
+		stop();
+		this->endFreeze();
+	}
+}
+
+cmzn::ThreadPool& cmzn_region::getThreadPool() const
+{
+	if (this->context)
+		return this->context->getThreadPool();
+	return cmzn::ThreadPool::getSerialThreadPool();
+}
+
+int cmzn_region::checkModify(const char *functionName)
+{
+	for (cmzn_region *region = this; (region); region = region->parent)
+		region->stopBackgroundFreezes();
+	if (this->isFrozen())
+	{
+		display_message(ERROR_MESSAGE,
+			"%s.  Cannot modify region while it is frozen for concurrent evaluation", functionName);
+		return CMZN_ERROR_IN_USE;
+	}
+	return CMZN_OK;
+}
+
 cmzn_region *cmzn_region::findChildByName(const char *name) const
 {
 	for (cmzn_region *child = this->first_child; (child); child = child->next_sibling)
@@ -1500,6 +1675,83 @@ void *cmzn_regionnotifier_get_callback_user_data(
 	return 0;
 }
 
+cmzn_regiontransaction_id cmzn_region_create_regiontransaction(
+	cmzn_region_id region)
+{
+	return cmzn_regiontransaction::create(region);
+}
+
+cmzn_regiontransaction_id cmzn_regiontransaction_access(
+	cmzn_regiontransaction_id transaction)
+{
+	if (transaction)
+	{
+		return transaction->access();
+	}
+	return nullptr;
+}
+
+int cmzn_regiontransaction_destroy(
+	cmzn_regiontransaction_id *transaction_address)
+{
+	if (transaction_address)
+	{
+		cmzn_regiontransaction::deaccess(*transaction_address);
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_regiontransaction_commit(cmzn_regiontransaction_id transaction)
+{
+	if (transaction)
+	{
+		return transaction->commit();
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
+bool cmzn_regiontransaction_is_committed(
+	cmzn_regiontransaction_id transaction)
+{
+	if (transaction)
+	{
+		return transaction->isCommitted();
+	}
+	return false;
+}
+
+int cmzn_regiontransaction_get_number_of_fieldmoduleevents(
+	cmzn_regiontransaction_id transaction)
+{
+	if (transaction)
+	{
+		return transaction->getFieldmoduleEventCount();
+	}
+	return 0;
+}
+
+int cmzn_regiontransaction_get_number_of_regionevents(
+	cmzn_regiontransaction_id transaction)
+{
+	if (transaction)
+	{
+		return transaction->getRegionEventCount();
+	}
+	return 0;
+}
+
+double cmzn_regiontransaction_get_timing(
+	cmzn_regiontransaction_id transaction,
+	enum cmzn_regiontransaction_timing timing)
+{
+	if (transaction)
+	{
+		return transaction->getTiming(timing);
+	}
+	return 0.0;
+}
+
 cmzn_region_id cmzn_region_create_region(cmzn_region_id base_region)
 {
 	if ((base_region) && (base_region->getContext()))
@@ -1510,7 +1762,7 @@ cmzn_region_id cmzn_region_create_region(cmzn_region_id base_region)
 cmzn_region_id cmzn_region_create_child(cmzn_region_id region,
 	const char *name)
 {
-	if (!region)
+	if ((!region) || (region->checkModify("cmzn_region_create_child") != CMZN_OK))
 		return nullptr;
 	cmzn_region *childRegion = region->createChild(name);
 	if (childRegion)
@@ -1521,7 +1773,7 @@ cmzn_region_id cmzn_region_create_child(cmzn_region_id region,
 cmzn_region_id cmzn_region_create_subregion(cmzn_region_id region,
 	const char *path)
 {
-	if (!region)
+	if ((!region) || (region->checkModify("cmzn_region_create_subregion") != CMZN_OK))
 		return nullptr;
 	cmzn_region *subregion = region->createSubregion(path);
 	if (subregion)
@@ -1625,6 +1877,29 @@ int cmzn_region_end_hierarchical_change(cmzn_region_id region)
 	return 0;
 }
 
+int cmzn_region_begin_freeze(cmzn_region_id region)
+{
+	if (region)
+		return region->beginFreeze();
+	display_message(ERROR_MESSAGE, "cmzn_region_begin_freeze.  Invalid argument(s)");
+	return CMZN_ERROR_ARGUMENT;
+}
+
+int cmzn_region_end_freeze(cmzn_region_id region)
+{
+	if (region)
+		return region->endFreeze();
+	display_message(ERROR_MESSAGE, "cmzn_region_end_freeze.  Invalid argument(s)");
+	return CMZN_ERROR_ARGUMENT;
+}
+
+bool cmzn_region_is_frozen(cmzn_region_id region)
+{
+	if (region)
+		return region->isFrozen();
+	return false;
+}
+
 cmzn_context_id cmzn_region_get_context(cmzn_region_id region)
 {
 	if (region)
@@ -1650,7 +1925,12 @@ char *cmzn_region_get_name(cmzn_region_id region)
 int cmzn_region_set_name(cmzn_region_id region, const char *name)
 {
 	if (region)
+	{
+		const int result = region->checkModify("cmzn_region_set_name");
+		if (result != CMZN_OK)
+			return result;
 		return region->setName(name);
+	}
 	return CMZN_ERROR_ARGUMENT;
 }
 
@@ -1739,7 +2019,12 @@ void cmzn_region_reaccess_next_sibling(cmzn_region_id *region_address)
 int cmzn_region_append_child(cmzn_region_id region, cmzn_region_id new_child)
 {
 	if (region)
+	{
+		const int result = region->checkModify("cmzn_region_append_child");
+		if (result != CMZN_OK)
+			return result;
 		return region->appendChild(new_child);
+	}
 	return CMZN_ERROR_ARGUMENT;
 }
 
@@ -1747,7 +2032,12 @@ int cmzn_region_insert_child_before(cmzn_region_id region,
 	cmzn_region_id new_child, cmzn_region_id ref_child)
 {
 	if (region)
+	{
+		const int result = region->checkModify("cmzn_region_insert_child_before");
+		if (result != CMZN_OK)
+			return result;
 		return region->insertChildBefore(new_child, ref_child);
+	}
 	return CMZN_ERROR_ARGUMENT;
 }
 
@@ -1755,7 +2045,12 @@ int cmzn_region_remove_child(cmzn_region_id region,
 	cmzn_region_id old_child)
 {
 	if (region)
+	{
+		const int result = region->checkModify("cmzn_region_remove_child");
+		if (result != CMZN_OK)
+			return result;
 		return region->removeChild(old_child);
+	}
 	return CMZN_ERROR_ARGUMENT;
 }
 
@@ -18,7 +18,13 @@
 #include "cmlibs/zinc/types/regionid.h"
 #include "computed_field/computed_field.h"
 #include "computed_field/field_derivative.hpp"
+#include "general/thread_pool.hpp"
+#include <atomic>
+#include <chrono>
+#include <functional>
 #include <list>
+#include <map>
+#include <mutex>
 
 
 /*
@@ -133,6 +139,7 @@ struct cmzn_scene;
 struct cmzn_region
 {
 	friend struct cmzn_context;
+	friend struct cmzn_regiontransaction;
 
 private:
 	char *name;
@@ -156,6 +163,8 @@ private:
 	// all field caches currently in use for this region, for clearing
 	// when fields changed, and adding value caches for new fields.
 	std::list<cmzn_fieldcache_id> field_caches;
+	// guards field_caches as caches may be created by concurrent threads while frozen
+	std::mutex fieldcachesMutex;
 	std::vector<FieldDerivative *> fieldDerivatives;
 
 	// Scene gives visualisation of region content
@@ -180,8 +189,19 @@ private:
 	// list of notifiers which receive field module callbacks
 	cmzn_fieldmodulenotifier_list fieldmodulenotifierList;
 
-	/* number of objects using this region */
-	int access_count;
+	// transaction being committed on this region tree, if any; not accessed
+	cmzn_regiontransaction *committingTransaction;
+
+	// number of begin freeze calls on this region without matching end freeze
+	int freeze_level;
+
+	// functions stopping evaluations continuing in the background while they
+	// hold a freeze on this region, by owner
+	std::map<void *, std::function<void()> > backgroundFreezes;
+
+	/* number of objects using this region; atomic as field caches access it
+	 * from concurrent threads while frozen */
+	std::atomic_int access_count;
 
 	cmzn_region(cmzn_context* contextIn);
 
@@ -254,8 +274,7 @@ public:
 	{
 		if (!region)
 			return CMZN_ERROR_ARGUMENT;
-		--(region->access_count);
-		if (region->access_count <= 0)
+		if (--(region->access_count) <= 0)
 		{
 			delete region;
 		}
@@ -320,6 +339,63 @@ public:
 		this->deltaTreeChange(-1);
 	}
 
+	/** Begin freeze for concurrent evaluation of this region tree.
+	 * @return  CMZN_OK on success, CMZN_ERROR_IN_USE if caching changes. */
+	int beginFreeze();
+
+	/** End freeze for concurrent evaluation of this region tree.
+	 * @return  CMZN_OK on success, CMZN_ERROR_ARGUMENT if not frozen here. */
+	int endFreeze();
+
+	/** Begin freeze for evaluation of this region tree which continues in the
+	 * background after returning. Before the region tree is next modified the
+	 * stop function is called on the modifying thread, and the freeze is ended
+	 * once it returns.
+	 * @param owner  Unique key identifying the background evaluation.
+	 * @param stop  Function which returns once the evaluation has stopped.
+	 * @return  CMZN_OK on success, CMZN_ERROR_IN_USE if caching changes. */
+	int beginBackgroundFreeze(void *owner, std::function<void()> stop);
+
+	/** End freeze begun with beginBackgroundFreeze, if not already ended by
+	 * stopping the background evaluation.
+	 * @return  CMZN_OK on success, CMZN_ERROR_NOT_FOUND if not frozen for owner. */
+	int endBackgroundFreeze(void *owner);
+
+	/** Stop all background evaluations holding a freeze on this region and
+	 * end their freezes. */
+	void stopBackgroundFreezes();
+
+	/** @return  True if this region or any ancestor is frozen for concurrent
+	 * evaluation, in which case it must not be modified. */
+	bool isFrozen() const
+	{
+		for (const cmzn_region *region = this; (region); region = region->parent)
+		{
+			if (region->freeze_level > 0)
+				return true;
+		}
+		return false;
+	}
+
+	/** Call before modifying region tree to report error if it is frozen.
+	 * Background evaluations holding a freeze on this region or its ancestors
+	 * are stopped first.
+	 * @param functionName  Name of calling function for error message.
+	 * @return  CMZN_OK if not frozen, otherwise CMZN_ERROR_IN_USE. */
+	int checkModify(const char *functionName);
+
+	/** @return  Non-accessed transaction being committed on this region or
+	 * its nearest ancestor doing so, or nullptr if none. */
+	cmzn_regiontransaction *getCommittingTransaction() const
+	{
+		for (const cmzn_region *region = this; (region); region = region->parent)
+		{
+			if (region->committingTransaction)
+				return region->committingTransaction;
+		}
+		return nullptr;
+	}
+
 	/**
 	 * Returns pointer to context this region was created for. Can be NULL if
 	 * context is destroyed already during clean-up.
@@ -330,6 +406,10 @@ public:
 		return this->context;
 	}
 
+	/** @return  Thread pool of owning context for parallel operations, or
+	 * serial thread pool if context has been destroyed. */
+	cmzn::ThreadPool& getThreadPool() const;
+
 	struct MANAGER(Computed_field) *getFieldManager() const
 	{
 		return this->field_manager;
@@ -412,7 +492,10 @@ public:
 	void addFieldcache(cmzn_fieldcache *fieldcache)
 	{
 		if (fieldcache)
+		{
+			std::lock_guard<std::mutex> lock(this->fieldcachesMutex);
 			this->field_caches.push_back(fieldcache);
+		}
 	}
 
 	/** Called only by Fieldcache destructor.
@@ -421,7 +504,10 @@ public:
 	void removeFieldcache(cmzn_fieldcache *fieldcache)
 	{
 		if (fieldcache)
+		{
+			std::lock_guard<std::mutex> lock(this->fieldcachesMutex);
 			this->field_caches.remove(fieldcache);
+		}
 	}
 
 	/**
@@ -551,6 +637,115 @@ public:
 
 };
 
+/**
+ * Caches changes to a region tree from creation until commit by holding a
+ * hierarchical change on it, and records time spent in notifying clients.
+ */
+struct cmzn_regiontransaction
+{
+	/** Adds time from construction to destruction to a timing of the
+	 * transaction, if any, unless nested in another timer. */
+	class Timer
+	{
+		cmzn_regiontransaction *transaction;
+		enum cmzn_regiontransaction_timing timing;
+		std::chrono::steady_clock::time_point startTime;
+
+	public:
+		Timer(cmzn_regiontransaction *transactionIn, enum cmzn_regiontransaction_timing timingIn) :
+			transaction(((transactionIn) && (0 == transactionIn->timerLevel)) ? transactionIn : nullptr),
+			timing(timingIn)
+		{
+			if (this->transaction)
+			{
+				++(this->transaction->timerLevel);
+				this->startTime = std::chrono::steady_clock::now();
+			}
+		}
+
+		~Timer()
+		{
+			if (this->transaction)
+			{
+				const std::chrono::duration<double> elapsed = std::chrono::steady_clock::now() - this->startTime;
+				this->transaction->timings[this->timing] += elapsed.count();
+				--(this->transaction->timerLevel);
+			}
+		}
+	};
+
+private:
+	cmzn_region *region;  // accessed
+	bool committed;
+	double timings[CMZN_REGIONTRANSACTION_TIMING_REGION_CALLBACKS + 1];  // in seconds
+	int timerLevel;
+	int fieldmoduleEventCount;
+	int regionEventCount;
+	int access_count;
+
+	cmzn_regiontransaction(cmzn_region *regionIn);
+
+	~cmzn_regiontransaction();
+
+public:
+
+	/** private: external code must use cmzn_region_create_regiontransaction */
+	static cmzn_regiontransaction *create(cmzn_region *region)
+	{
+		if (region)
+		{
+			return new cmzn_regiontransaction(region);
+		}
+		return nullptr;
+	}
+
+	cmzn_regiontransaction *access()
+	{
+		++(this->access_count);
+		return this;
+	}
+
+	/** Ends change with a warning if not committed when last access is removed */
+	static void deaccess(cmzn_regiontransaction* &transaction);
+
+	/** End hierarchical change on region tree, notifying clients if outermost
+	 * @return  Result OK on success, ERROR_ALREADY_EXISTS if already committed. */
+	int commit();
+
+	bool isCommitted() const
+	{
+		return this->committed;
+	}
+
+	void addFieldmoduleEvent()
+	{
+		++(this->fieldmoduleEventCount);
+	}
+
+	int getFieldmoduleEventCount() const
+	{
+		return this->fieldmoduleEventCount;
+	}
+
+	void addRegionEvent()
+	{
+		++(this->regionEventCount);
+	}
+
+	int getRegionEventCount() const
+	{
+		return this->regionEventCount;
+	}
+
+	/** @return  Time in seconds for timing, or 0.0 if invalid */
+	double getTiming(enum cmzn_regiontransaction_timing timing) const
+	{
+		if ((CMZN_REGIONTRANSACTION_TIMING_TOTAL <= timing) && (timing <= CMZN_REGIONTRANSACTION_TIMING_REGION_CALLBACKS))
+			return this->timings[timing];
+		return 0.0;
+	}
+};
+
 /*
 Global functions
 ----------------
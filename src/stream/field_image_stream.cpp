@@ -17,18 +17,154 @@
 #include "general/mystring.h"
 #include "general/image_utilities.h"
 #include "graphics/texture.h"
+#include "graphics/texture.hpp"
+#include "graphics/texture_brick_cache.hpp"
 #include "general/message.h"
 #include "general/enumerator_conversion.hpp"
 #include "stream/field_image_stream.hpp"
 #include "image_io/analyze.h"
 #include "image_io/analyze_object_map.hpp"
 
+namespace {
+
+/** Copy texture attributes from old texture of image field to its new texture. */
+void cmzn_field_image_copy_texture_attributes(cmzn_field_image_id image_field,
+	Texture *texture)
+{
+	Texture *old_texture = cmzn_field_image_get_texture(image_field);
+	if (old_texture)
+	{
+		Texture_set_combine_mode(texture, Texture_get_combine_mode(old_texture));
+		Texture_set_filter_mode(texture, Texture_get_filter_mode(old_texture));
+		Texture_set_compression_mode(texture, Texture_get_compression_mode(old_texture));
+		Texture_set_wrap_mode(texture, Texture_get_wrap_mode(old_texture));
+		double sizes[3];
+		cmzn_texture_get_texture_coordinate_sizes(old_texture, 3, sizes);
+		cmzn_texture_set_texture_coordinate_sizes(texture, 3, sizes);
+	}
+}
+
+/**
+ * Read raw pixel data from a single file or memory resource into out-of-core
+ * chunked storage, so only chunks which are sampled are loaded.
+ */
+int cmzn_field_image_read_chunked(cmzn_field_image_id image_field,
+	cmzn_streaminformation_image_id streaminformation_image)
+{
+	const cmzn_stream_properties_list streams_list = streaminformation_image->getResourcesList();
+	if (streams_list.size() != 1)
+	{
+		display_message(ERROR_MESSAGE, "cmzn_field_image_read.  "
+			"Chunked reading requires exactly one file or memory resource");
+		return 0;
+	}
+	cmzn_streaminformation_id streaminformation = cmzn_streaminformation_image_base_cast(
+		streaminformation_image);
+	const enum cmzn_streaminformation_data_compression_type data_compression_type =
+		cmzn_streaminformation_get_data_compression_type(streaminformation);
+	if ((data_compression_type != CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_DEFAULT) &&
+		(data_compression_type != CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE))
+	{
+		display_message(ERROR_MESSAGE, "cmzn_field_image_read.  "
+			"Chunked reading requires uncompressed raw pixel data");
+		return 0;
+	}
+	const int numberOfComponents = streaminformation_image->getNumberOfComponents();
+	enum Texture_storage_type storage = TEXTURE_STORAGE_TYPE_INVALID;
+	switch (numberOfComponents)
+	{
+	case 1:
+		storage = TEXTURE_LUMINANCE;
+		break;
+	case 2:
+		storage = TEXTURE_LUMINANCE_ALPHA;
+		break;
+	case 3:
+		storage = TEXTURE_RGB;
+		break;
+	case 4:
+		storage = TEXTURE_RGBA;
+		break;
+	default:
+		break;
+	}
+	int sizes[3];
+	streaminformation_image->getRawSizes(sizes);
+	const int chunkSize = streaminformation_image->getChunkSizePixels();
+	const size_t memoryBudget = static_cast<size_t>(
+		streaminformation_image->getChunkMemoryBudgetMegabytes())*1024*1024;
+	char *field_name = cmzn_field_get_name(cmzn_field_image_base_cast(image_field));
+	char *source_name = 0;
+	TextureBrickCache *brick_cache = 0;
+	cmzn_streamresource_id stream = (*(streams_list.begin()))->getResource();
+	cmzn_streamresource_file_id file_resource = cmzn_streamresource_cast_file(stream);
+	cmzn_streamresource_memory_id memory_resource = 0;
+	if (file_resource)
+	{
+		source_name = file_resource->getFileName();
+		if (source_name)
+		{
+			brick_cache = TextureBrickCache::createFromFile(source_name, sizes,
+				numberOfComponents, streaminformation_image->getNumberOfBytesPerComponent(),
+				chunkSize, memoryBudget);
+		}
+		cmzn_streamresource_file_destroy(&file_resource);
+	}
+	else if (NULL != (memory_resource = cmzn_streamresource_cast_memory(stream)))
+	{
+		source_name = duplicate_string(field_name);
+		const void *memory_block = NULL;
+		unsigned int buffer_size = 0;
+		memory_resource->getBuffer(&memory_block, &buffer_size);
+		// resource is kept accessed by cache as memory is not copied
+		brick_cache = TextureBrickCache::createFromMemory(memory_block, buffer_size,
+			stream, sizes, numberOfComponents,
+			streaminformation_image->getNumberOfBytesPerComponent(), chunkSize, memoryBudget);
+		cmzn_streamresource_memory_destroy(&memory_resource);
+	}
+	int return_code = 0;
+	if (brick_cache)
+	{
+		Texture *texture = CREATE(Texture)(field_name);
+		if ((texture) && Texture_set_brick_cache(texture, brick_cache, storage, source_name))
+		{
+			cmzn_field_image_copy_texture_attributes(image_field, texture);
+			return_code = cmzn_field_image_set_texture(image_field, texture);
+		}
+		else
+		{
+			display_message(ERROR_MESSAGE,
+				"cmzn_field_image_read.  Could not create chunked image for field");
+		}
+		if (texture)
+			DESTROY(Texture)(&texture);
+		TextureBrickCache::deaccess(brick_cache);
+	}
+	else
+	{
+		display_message(ERROR_MESSAGE,
+			"cmzn_field_image_read.  Could not read chunked image");
+	}
+	if (source_name)
+		DEALLOCATE(source_name);
+	if (field_name)
+		DEALLOCATE(field_name);
+	return return_code;
+}
+
+}
+
 int cmzn_field_image_read(cmzn_field_image_id image_field,
 	cmzn_streaminformation_image_id streaminformation_image)
 {
 	int return_code = 1;
 	struct Cmgui_image_information *image_information = NULL;
 
+	if (image_field && streaminformation_image &&
+		(0 < streaminformation_image->getChunkSizePixels()))
+	{
+		return cmzn_field_image_read_chunked(image_field, streaminformation_image);
+	}
 	if (image_field && streaminformation_image &&
 		(NULL != (image_information = streaminformation_image->getImageInformation())))
 	{
@@ -161,18 +297,7 @@ int cmzn_field_image_read(cmzn_field_image_id image_field,
 					}
 					if (return_code)
 					{
-						// copy attributes from old texture
-						Texture *old_texture = cmzn_field_image_get_texture(image_field);
-						if (old_texture)
-						{
-							Texture_set_combine_mode(texture, Texture_get_combine_mode(old_texture));
-							Texture_set_filter_mode(texture, Texture_get_filter_mode(old_texture));
-							Texture_set_compression_mode(texture, Texture_get_compression_mode(old_texture));
-							Texture_set_wrap_mode(texture, Texture_get_wrap_mode(old_texture));
-							double sizes[3];
-							cmzn_texture_get_texture_coordinate_sizes(old_texture, 3, sizes);
-							cmzn_texture_set_texture_coordinate_sizes(texture, 3, sizes);
-						}
+						cmzn_field_image_copy_texture_attributes(image_field, texture);
 						return_code = cmzn_field_image_set_texture(image_field, texture);
 						DESTROY(Texture)(&texture);
 					}
@@ -425,10 +550,12 @@ int cmzn_streaminformation_image_set_attribute_integer(
 		{
 			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_RAW_WIDTH_PIXELS:
 			{
+				streaminformation->setRawSize(0, value);
 				return (Cmgui_image_information_set_width(image_information, value));
 			} break;
 			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_RAW_HEIGHT_PIXELS:
 			{
+				streaminformation->setRawSize(1, value);
 				return (Cmgui_image_information_set_height(image_information, value));
 			} break;
 			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_BITS_PER_COMPONENT:
@@ -438,9 +565,37 @@ int cmzn_streaminformation_image_set_attribute_integer(
 					number_of_bytes = 1;
 				else if (value ==16)
 					number_of_bytes = 2;
+				streaminformation->setNumberOfBytesPerComponent(number_of_bytes);
 				return (Cmgui_image_information_set_number_of_bytes_per_component(
 					image_information, number_of_bytes));
 			} break;
+			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_RAW_DEPTH_PIXELS:
+			{
+				if (0 < value)
+				{
+					streaminformation->setRawSize(2, value);
+					return CMZN_OK;
+				}
+				return CMZN_ERROR_ARGUMENT;
+			} break;
+			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_CHUNK_SIZE_PIXELS:
+			{
+				if ((0 == value) || ((4 <= value) && (value <= 1024)))
+				{
+					streaminformation->setChunkSizePixels(value);
+					return CMZN_OK;
+				}
+				return CMZN_ERROR_ARGUMENT;
+			} break;
+			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_CHUNK_MEMORY_BUDGET_MEGABYTES:
+			{
+				if (0 < value)
+				{
+					streaminformation->setChunkMemoryBudgetMegabytes(value);
+					return CMZN_OK;
+				}
+				return CMZN_ERROR_ARGUMENT;
+			} break;
 			default:
 			{
 				display_message(ERROR_MESSAGE,
@@ -497,6 +652,15 @@ public:
 			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_COMPRESSION_QUALITY:
 				enum_string = "COMPRESSION_QUALITY";
 				break;
+			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_RAW_DEPTH_PIXELS:
+				enum_string = "RAW_DEPTH_PIXELS";
+				break;
+			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_CHUNK_SIZE_PIXELS:
+				enum_string = "CHUNK_SIZE_PIXELS";
+				break;
+			case CMZN_STREAMINFORMATION_IMAGE_ATTRIBUTE_CHUNK_MEMORY_BUDGET_MEGABYTES:
+				enum_string = "CHUNK_MEMORY_BUDGET_MEGABYTES";
+				break;
 			default:
 				break;
 		}
@@ -677,6 +841,7 @@ int cmzn_streaminformation_image_set_pixel_format(
 		}
 		if (number_of_components)
 		{
+			streaminformation->setNumberOfComponents(number_of_components);
 			return_code = Cmgui_image_information_set_number_of_components(
 				image_information, number_of_components);
 		}
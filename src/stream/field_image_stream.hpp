@@ -23,7 +23,14 @@ struct cmzn_streaminformation_image : cmzn_streaminformation
 public:
 
 	cmzn_streaminformation_image(cmzn_field_image_id image_field_in) :
-		image_field(image_field_in)
+		image_field(image_field_in),
+		rawWidth(0),
+		rawHeight(0),
+		rawDepth(1),
+		numberOfComponents(1),
+		numberOfBytesPerComponent(1),
+		chunkSizePixels(0),
+		chunkMemoryBudgetMegabytes(256)
 	{
 		cmzn_field_access(cmzn_field_image_base_cast(image_field_in));
 		image_information = CREATE(Cmgui_image_information)();
@@ -40,9 +47,75 @@ public:
 		return image_information;
 	}
 
+	/* raw image properties are also recorded here for chunked reading */
+	void setRawSize(int dimension, int size)
+	{
+		if (dimension == 0)
+			this->rawWidth = size;
+		else if (dimension == 1)
+			this->rawHeight = size;
+		else
+			this->rawDepth = size;
+	}
+
+	/** Get raw width, height and depth in pixels. */
+	void getRawSizes(int *sizes) const
+	{
+		sizes[0] = this->rawWidth;
+		sizes[1] = this->rawHeight;
+		sizes[2] = this->rawDepth;
+	}
+
+	int getNumberOfComponents() const
+	{
+		return this->numberOfComponents;
+	}
+
+	void setNumberOfComponents(int numberOfComponentsIn)
+	{
+		this->numberOfComponents = numberOfComponentsIn;
+	}
+
+	int getNumberOfBytesPerComponent() const
+	{
+		return this->numberOfBytesPerComponent;
+	}
+
+	void setNumberOfBytesPerComponent(int numberOfBytesPerComponentIn)
+	{
+		this->numberOfBytesPerComponent = numberOfBytesPerComponentIn;
+	}
+
+	/** @return  Brick size in pixels for chunked out-of-core reading, or 0 to
+	 * read whole image into memory. */
+	int getChunkSizePixels() const
+	{
+		return this->chunkSizePixels;
+	}
+
+	void setChunkSizePixels(int chunkSizePixelsIn)
+	{
+		this->chunkSizePixels = chunkSizePixelsIn;
+	}
+
+	int getChunkMemoryBudgetMegabytes() const
+	{
+		return this->chunkMemoryBudgetMegabytes;
+	}
+
+	void setChunkMemoryBudgetMegabytes(int chunkMemoryBudgetMegabytesIn)
+	{
+		this->chunkMemoryBudgetMegabytes = chunkMemoryBudgetMegabytesIn;
+	}
+
 private:
 	cmzn_field_image_id image_field;
 	struct Cmgui_image_information *image_information;
+	int rawWidth, rawHeight, rawDepth;
+	int numberOfComponents;
+	int numberOfBytesPerComponent;
+	int chunkSizePixels;
+	int chunkMemoryBudgetMegabytes;
 };
 
 
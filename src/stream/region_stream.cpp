@@ -19,6 +19,7 @@
 #include "finite_element/import_finite_element.h"
 #include "general/debug.h"
 #include "general/mystring.h"
+#include "general/performance_counters.hpp"
 #include "region/cmiss_region.hpp"
 #include "stream/region_stream.hpp"
 
@@ -127,6 +128,9 @@ int cmzn_region_read(cmzn_region_id region,
 	if (region && streaminformation_region &&
 		(cmzn_streaminformation_region_get_region_private(streaminformation_region) == region))
 	{
+		return_code = region->checkModify("cmzn_region_read");
+		if (return_code != CMZN_OK)
+			return return_code;
 		enum cmzn_streaminformation_data_compression_type data_compression_type =
 			CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE;
 		const cmzn_stream_properties_list streams_list = streaminformation_region->getResourcesList();
@@ -146,6 +150,9 @@ int cmzn_region_read(cmzn_region_id region,
 					streaminformation_region, CMZN_STREAMINFORMATION_REGION_ATTRIBUTE_TIME);
 				time_index = &time_index_value;
 			}
+			static cmzn::PerformanceCounter *parseCounter =
+				cmzn::PerformanceCounters::getCounter("region_read", "parse");
+			cmzn::PerformanceTimer parseTimer(parseCounter);
 			for (iter = streams_list.begin(); (iter != streams_list.end()) && (return_code == CMZN_OK); ++iter)
 			{
 				data_compression_type = CMZN_STREAMINFORMATION_DATA_COMPRESSION_TYPE_NONE;
@@ -216,8 +223,12 @@ int cmzn_region_read(cmzn_region_id region,
 			// end change before merge otherwise there will be callbacks for changes
 			// to half-temporary, half-global objects, leading to errors
 			temp_region->endHierarchicalChange();
+			parseTimer.stop();
 			if (return_code == CMZN_OK)
 			{
+				static cmzn::PerformanceCounter *mergeCounter =
+					cmzn::PerformanceCounters::getCounter("region_read", "merge");
+				cmzn::PerformanceTimer mergeTimer(mergeCounter);
 				if (!region->canMerge(*temp_region))
 				{
 					return_code = CMZN_ERROR_INCOMPATIBLE_DATA;
@@ -273,6 +284,9 @@ int cmzn_region_write(cmzn_region_id region,
 			return_code = CMZN_ERROR_ARGUMENT;
 		else
 		{
+			static cmzn::PerformanceCounter *writeCounter =
+				cmzn::PerformanceCounters::getCounter("region_write", "write");
+			cmzn::PerformanceTimer writeTimer(writeCounter);
 			cmzn_stream_properties_list_const_iterator iter;
 			cmzn_resource_properties *stream_properties = NULL;
 			cmzn_streamresource_id stream = NULL;
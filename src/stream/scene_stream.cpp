@@ -76,7 +76,8 @@ int cmzn_scene_write(cmzn_scene_id scene,
 					streaminformation_scene->getOutputTimeDependentColours(),
 					streaminformation_scene->getOutputTimeDependentNormals(),
 					size,	resource_names,
-					streaminformation_scene->getOutputIsInline());
+					streaminformation_scene->getOutputIsInline(),
+					streaminformation_scene->getNumberOfThreads());
 				cmzn_scenefilter_destroy(&scenefilter);
 				for (int i = 0; i < size; i++)
 				{
@@ -103,6 +104,45 @@ int cmzn_scene_write(cmzn_scene_id scene,
                 outputStrings = export_to_wavefront(scene, scenefilter, 1);
                 number_of_entries = outputStrings.size();
             }
+			else if ((streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_STL) ||
+				(streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_PLY))
+			{
+				// binary output is streamed straight to the first resource, not via outputStrings
+				const Binary_triangles_format format =
+					(streaminformation_scene->getIOFormat() == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_PLY) ?
+					BINARY_TRIANGLES_FORMAT_PLY : BINARY_TRIANGLES_FORMAT_STL;
+				const bool weld_vertices = (0 != streaminformation_scene->getOutputWeldVertices());
+				cmzn_scenefilter_id scenefilter = streaminformation_scene->getScenefilter();
+				cmzn_streamresource_id stream = (*(streams_list.begin()))->getResource();
+				cmzn_streamresource_file_id file_resource = cmzn_streamresource_cast_file(stream);
+				cmzn_streamresource_memory_id memory_resource = NULL;
+				if (file_resource)
+				{
+					char *file_name = file_resource->getFileName();
+					return_code = export_to_binary_triangles(scene, scenefilter, format, weld_vertices,
+						file_name, /*memory_buffer_out*/NULL, /*memory_buffer_size_out*/NULL);
+					DEALLOCATE(file_name);
+					cmzn_streamresource_file_destroy(&file_resource);
+				}
+				else if (NULL != (memory_resource = cmzn_streamresource_cast_memory(stream)))
+				{
+					char *buffer_out = NULL;
+					unsigned int buffer_size = 0;
+					return_code = export_to_binary_triangles(scene, scenefilter, format, weld_vertices,
+						/*file_name*/NULL, &buffer_out, &buffer_size);
+					if (return_code == CMZN_OK)
+					{
+						memory_resource->setBuffer(buffer_out, buffer_size);
+					}
+					cmzn_streamresource_memory_destroy(&memory_resource);
+				}
+				else
+				{
+					display_message(ERROR_MESSAGE, "cmzn_scene_export. Stream error");
+					return_code = CMZN_ERROR_ARGUMENT;
+				}
+				cmzn_scenefilter_destroy(&scenefilter);
+			}
 
 			cmzn_scene_destroy(&scene);
 
@@ -367,6 +407,26 @@ int cmzn_streaminformation_scene_set_number_of_time_steps(cmzn_streaminformation
 	return CMZN_ERROR_ARGUMENT;
 }
 
+int cmzn_streaminformation_scene_get_number_of_threads(
+	cmzn_streaminformation_scene_id streaminformation)
+{
+	if (streaminformation)
+	{
+		return streaminformation->getNumberOfThreads();
+	}
+	return -1;
+}
+
+int cmzn_streaminformation_scene_set_number_of_threads(
+	cmzn_streaminformation_scene_id streaminformation, int numberOfThreads)
+{
+	if (streaminformation)
+	{
+		return streaminformation->setNumberOfThreads(numberOfThreads);
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
+
 enum cmzn_streaminformation_scene_io_format
 	cmzn_streaminformation_scene_get_io_format(
 	cmzn_streaminformation_scene_id streaminformation)
@@ -426,6 +486,12 @@ public:
 			case CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_THREEJS:
 				enum_string = "THREEJS";
 				break;
+			case CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_STL:
+				enum_string = "BINARY_STL";
+				break;
+			case CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_PLY:
+				enum_string = "BINARY_PLY";
+				break;
 			default:
 				break;
 		}
@@ -568,3 +634,25 @@ int cmzn_streaminformation_scene_set_output_is_inline(
 	}
 	return CMZN_ERROR_ARGUMENT;
 }
+
+int cmzn_streaminformation_scene_get_output_weld_vertices(
+	cmzn_streaminformation_scene_id streaminformation)
+{
+	if (streaminformation)
+	{
+		return streaminformation->getOutputWeldVertices();
+	}
+	return 0;
+}
+
+int cmzn_streaminformation_scene_set_output_weld_vertices(
+	cmzn_streaminformation_scene_id streaminformation,
+	int outputWeldVertices)
+{
+	if (streaminformation)
+	{
+		streaminformation->setOutputWeldVertices(outputWeldVertices);
+		return CMZN_OK;
+	}
+	return CMZN_ERROR_ARGUMENT;
+}
@@ -23,12 +23,12 @@ struct cmzn_streaminformation_scene : cmzn_streaminformation
 public:
 
 	cmzn_streaminformation_scene(cmzn_scene_id scene_in) : scene(scene_in),
-		scenefilter(0), numberOfTimeSteps(0), initialTime(0.0), finishTime(0.0),
+		scenefilter(0), numberOfTimeSteps(0), numberOfThreads(1), initialTime(0.0), finishTime(0.0),
 		format(CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_INVALID),
 		data_type(CMZN_STREAMINFORMATION_SCENE_IO_DATA_TYPE_COLOUR),
 		overwriteSceneGraphics(0),  outputTimeDependentVertices(1),
 		outputTimeDependentColours(0), outputTimeDependentNormals(0),
-		outputIsInline(0)
+		outputIsInline(0), outputWeldVertices(0)
 	{
 		cmzn_scene_access(scene_in);
 	}
@@ -88,7 +88,9 @@ public:
 			return numberOfResources;
 		}
         else if (format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_DESCRIPTION ||
-                 format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_ASCII_STL)
+                 format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_ASCII_STL ||
+                 format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_STL ||
+                 format == CMZN_STREAMINFORMATION_SCENE_IO_FORMAT_BINARY_PLY)
         {
 			return 1;
         }
@@ -118,6 +120,19 @@ public:
 		return CMZN_OK;
 	}
 
+	int getNumberOfThreads() const
+	{
+		return numberOfThreads;
+	}
+
+	int setNumberOfThreads(int numberOfThreadsIn)
+	{
+		if (numberOfThreadsIn < 0)
+			return CMZN_ERROR_ARGUMENT;
+		numberOfThreads = numberOfThreadsIn;
+		return CMZN_OK;
+	}
+
 	cmzn_scenefilter_id getScenefilter()
 	{
 		if (scenefilter)
@@ -210,16 +225,28 @@ public:
 		return CMZN_OK;
 	}
 
+	int getOutputWeldVertices()
+	{
+		return outputWeldVertices;
+	}
+
+	int setOutputWeldVertices(int outputWeldVerticesIn)
+	{
+		outputWeldVertices = outputWeldVerticesIn;
+		return CMZN_OK;
+	}
+
 private:
 	cmzn_scene_id scene;
 	cmzn_scenefilter_id scenefilter;
 	int numberOfTimeSteps;
+	int numberOfThreads;
 	double initialTime, finishTime;
 	enum cmzn_streaminformation_scene_io_format format;
 	enum cmzn_streaminformation_scene_io_data_type data_type;
 	int overwriteSceneGraphics;
 	int outputTimeDependentVertices, outputTimeDependentColours, outputTimeDependentNormals,
-		outputIsInline;
+		outputIsInline, outputWeldVertices;
 };
 
 
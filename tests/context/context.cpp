@@ -7,10 +7,21 @@
  */
 
 #include <gtest/gtest.h>
+#include <cstring>
+#include <string>
 
 #include <cmlibs/zinc/core.h>
+#include <cmlibs/zinc/context.hpp>
 #include <cmlibs/zinc/element.hpp>
+#include <cmlibs/zinc/fieldarithmeticoperators.hpp>
+#include <cmlibs/zinc/fieldassignment.hpp>
+#include <cmlibs/zinc/fieldcache.hpp>
+#include <cmlibs/zinc/fieldconstant.hpp>
+#include <cmlibs/zinc/fieldfiniteelement.hpp>
 #include <cmlibs/zinc/fieldmodule.hpp>
+#include <cmlibs/zinc/node.hpp>
+#include <cmlibs/zinc/nodeset.hpp>
+#include <cmlibs/zinc/nodetemplate.hpp>
 #include <cmlibs/zinc/region.hpp>
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
@@ -107,3 +118,150 @@ TEST(cmzn_context, region_lifetime)
     cmzn_context_destroy(&context);
     cmzn_region_destroy(&region);
 }
+
+TEST(cmzn_context, number_of_threads)
+{
+	ZincTestSetup zinc;
+
+	EXPECT_EQ(-1, cmzn_context_get_number_of_threads(nullptr));
+	EXPECT_EQ(CMZN_RESULT_ERROR_ARGUMENT, cmzn_context_set_number_of_threads(nullptr, 2));
+	EXPECT_EQ(0, cmzn_context_get_number_of_threads(zinc.context));
+	EXPECT_EQ(CMZN_RESULT_ERROR_ARGUMENT, cmzn_context_set_number_of_threads(zinc.context, -1));
+	EXPECT_EQ(CMZN_RESULT_OK, cmzn_context_set_number_of_threads(zinc.context, 3));
+	EXPECT_EQ(3, cmzn_context_get_number_of_threads(zinc.context));
+}
+
+// test feature thread counts are served from the context thread pool, giving
+// the same results for any context number of threads
+TEST(ZincContext, numberOfThreads)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(0, zinc.context.getNumberOfThreads());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, zinc.context.setNumberOfThreads(-1));
+	EXPECT_EQ(0, zinc.context.getNumberOfThreads());
+
+	Fieldmodule fm = zinc.context.getDefaultRegion().getFieldmodule();
+	FieldFiniteElement coordinates = fm.createFieldFiniteElement(3);
+	EXPECT_TRUE(coordinates.isValid());
+	EXPECT_EQ(RESULT_OK, coordinates.setName("coordinates"));
+	FieldFiniteElement result = fm.createFieldFiniteElement(3);
+	EXPECT_TRUE(result.isValid());
+	EXPECT_EQ(RESULT_OK, result.setName("result"));
+	Nodeset nodes = fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(RESULT_OK, nodetemplate.defineField(coordinates));
+	EXPECT_EQ(RESULT_OK, nodetemplate.defineField(result));
+	Fieldcache cache = fm.createFieldcache();
+	const int nodesCount = 5000;
+	EXPECT_EQ(RESULT_OK, fm.beginChange());
+	for (int n = 1; n <= nodesCount; ++n)
+	{
+		Node node = nodes.createNode(n, nodetemplate);
+		EXPECT_TRUE(node.isValid());
+		EXPECT_EQ(RESULT_OK, cache.setNode(node));
+		const double x[3] = { 0.001*n, 0.5 - 0.0002*n, 1.0 + 0.0001*n*n };
+		EXPECT_EQ(RESULT_OK, coordinates.assignReal(cache, 3, x));
+	}
+	EXPECT_EQ(RESULT_OK, fm.endChange());
+	const double scaleValues[3] = { 2.0, -3.0, 0.5 };
+	Field scale = fm.createFieldConstant(3, scaleValues);
+	Field source = coordinates*scale + coordinates*coordinates;
+	EXPECT_TRUE(source.isValid());
+	Fieldassignment fieldassignment = result.createFieldassignment(source);
+	EXPECT_TRUE(fieldassignment.isValid());
+	EXPECT_EQ(RESULT_OK, fieldassignment.setNumberOfThreads(0));
+
+	const int contextThreadCounts[3] = { 1, 4, 0 };
+	for (int i = 0; i < 3; ++i)
+	{
+		EXPECT_EQ(RESULT_OK, zinc.context.setNumberOfThreads(contextThreadCounts[i]));
+		EXPECT_EQ(contextThreadCounts[i], zinc.context.getNumberOfThreads());
+		EXPECT_EQ(RESULT_OK, fieldassignment.assign());
+		double x[3], value[3];
+		for (int n = 1; n <= nodesCount; n += 7)
+		{
+			EXPECT_EQ(RESULT_OK, cache.setNode(nodes.findNodeByIdentifier(n)));
+			EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(cache, 3, x));
+			EXPECT_EQ(RESULT_OK, result.evaluateReal(cache, 3, value));
+			for (int c = 0; c < 3; ++c)
+			{
+				EXPECT_DOUBLE_EQ(x[c]*scaleValues[c] + x[c]*x[c], value[c]);
+			}
+		}
+		// clear result so next assignment is checked
+		const double zero[3] = { 0.0, 0.0, 0.0 };
+		Fieldassignment clearAssignment = result.createFieldassignment(fm.createFieldConstant(3, zero));
+		EXPECT_EQ(RESULT_OK, clearAssignment.assign());
+	}
+}
+
+TEST(cmzn_context, performance_counters)
+{
+	ZincTestSetup zinc;
+
+	EXPECT_FALSE(cmzn_context_is_performance_counters_enabled(nullptr));
+	EXPECT_EQ(CMZN_RESULT_ERROR_ARGUMENT, cmzn_context_set_performance_counters_enabled(nullptr, true));
+	EXPECT_EQ(CMZN_RESULT_ERROR_ARGUMENT, cmzn_context_reset_performance_counters(nullptr));
+	EXPECT_EQ(nullptr, cmzn_context_get_performance_report(nullptr));
+	EXPECT_FALSE(cmzn_context_is_performance_counters_enabled(zinc.context));
+	EXPECT_EQ(CMZN_RESULT_OK, cmzn_context_set_performance_counters_enabled(zinc.context, true));
+	EXPECT_TRUE(cmzn_context_is_performance_counters_enabled(zinc.context));
+	EXPECT_EQ(CMZN_RESULT_OK, cmzn_context_set_performance_counters_enabled(zinc.context, false));
+	EXPECT_FALSE(cmzn_context_is_performance_counters_enabled(zinc.context));
+	char *report = cmzn_context_get_performance_report(zinc.context);
+	EXPECT_NE(nullptr, report);
+	EXPECT_NE(nullptr, strstr(report, "\"enabled\" : false"));
+	cmzn_deallocate(report);
+}
+
+TEST(ZincContext, performanceCounters)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.context.resetPerformanceCounters());
+	EXPECT_EQ(RESULT_OK, zinc.context.setPerformanceCountersEnabled(true));
+	EXPECT_TRUE(zinc.context.isPerformanceCountersEnabled());
+
+	Fieldmodule fm = zinc.context.getDefaultRegion().getFieldmodule();
+	EXPECT_EQ(RESULT_OK, fm.beginChange());
+	FieldFiniteElement coordinates = fm.createFieldFiniteElement(3);
+	EXPECT_EQ(RESULT_OK, coordinates.setName("coordinates"));
+	Nodeset nodes = fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(RESULT_OK, nodetemplate.defineField(coordinates));
+	Fieldcache cache = fm.createFieldcache();
+	Node node = nodes.createNode(1, nodetemplate);
+	EXPECT_EQ(RESULT_OK, cache.setNode(node));
+	const double x[3] = { 1.0, 2.0, 3.0 };
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(cache, 3, x));
+	EXPECT_EQ(RESULT_OK, fm.endChange());
+	Field sum = coordinates + coordinates;
+	EXPECT_TRUE(sum.isValid());
+	double value[3];
+	// second evaluation at same location is served from field cache
+	EXPECT_EQ(RESULT_OK, sum.evaluateReal(cache, 3, value));
+	EXPECT_EQ(RESULT_OK, sum.evaluateReal(cache, 3, value));
+	EXPECT_DOUBLE_EQ(2.0, value[0]);
+
+	char *report = zinc.context.getPerformanceReport();
+	EXPECT_NE(nullptr, report);
+	const std::string reportString(report);
+	cmzn_deallocate(report);
+	EXPECT_NE(std::string::npos, reportString.find("\"enabled\" : true"));
+	EXPECT_NE(std::string::npos, reportString.find("\"fieldcache\""));
+	EXPECT_NE(std::string::npos, reportString.find("\"hits\""));
+	EXPECT_NE(std::string::npos, reportString.find("\"misses\""));
+	EXPECT_NE(std::string::npos, reportString.find("\"field_evaluations\""));
+	EXPECT_NE(std::string::npos, reportString.find("\"add\""));
+	EXPECT_NE(std::string::npos, reportString.find("\"finite_element\""));
+	EXPECT_NE(std::string::npos, reportString.find("\"change_notification\""));
+
+	EXPECT_EQ(RESULT_OK, zinc.context.setPerformanceCountersEnabled(false));
+	EXPECT_EQ(RESULT_OK, zinc.context.resetPerformanceCounters());
+	EXPECT_EQ(RESULT_OK, sum.evaluateReal(cache, 3, value));
+	report = zinc.context.getPerformanceReport();
+	EXPECT_NE(nullptr, report);
+	EXPECT_EQ(std::string::npos, std::string(report).find("\"fieldcache\""));
+	cmzn_deallocate(report);
+}
@@ -889,6 +889,96 @@ TEST(ZincFieldGradient, gradientOfGradient2)
 	}
 }
 
+// Test higher mesh derivatives of gradient, curl and divergence which are
+// evaluated analytically, comparing third gradient against finite differences
+// and derivatives of curl and divergence against the gradient of gradient
+TEST(ZincFieldGradient, analyticHigherDerivatives)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(resourcePath("fieldmodule/cube_tricubic_deformed.exfile").c_str()));
+
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	Field deformed = zinc.fm.findFieldByName("deformed");
+	Field xiField = zinc.fm.findFieldByName("xi");
+	EXPECT_TRUE(xiField.isValid());
+	Field gradient1 = zinc.fm.createFieldGradient(deformed, coordinates);
+	Field gradient2 = zinc.fm.createFieldGradient(gradient1, coordinates);
+	Field gradient3 = zinc.fm.createFieldGradient(gradient2, coordinates);
+	EXPECT_EQ(81, gradient3.getNumberOfComponents());
+	Field dxi_dx = zinc.fm.createFieldGradient(xiField, coordinates);
+	EXPECT_TRUE(dxi_dx.isValid());
+	Field curl = zinc.fm.createFieldCurl(deformed, coordinates);
+	Field curlGradient = zinc.fm.createFieldGradient(curl, coordinates);
+	EXPECT_TRUE(curlGradient.isValid());
+	Field divergence = zinc.fm.createFieldDivergence(deformed, coordinates);
+	Field divergenceGradient = zinc.fm.createFieldGradient(divergence, coordinates);
+	EXPECT_TRUE(divergenceGradient.isValid());
+
+	Mesh mesh = zinc.fm.findMeshByDimension(3);
+	Element element = mesh.findElementByIdentifier(1);
+	EXPECT_TRUE(element.isValid());
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const double xi[2][3] =
+	{
+		{ 0.5, 0.5, 0.5 },
+		{ 0.1, 0.2, 0.3 }
+	};
+	const double delta = 1.0E-5;
+	double dxi_dxValues[9], gradient2Values[27], gradient3Values[81];
+	double gradient2Minus[27], gradient2Plus[27], dgradient2_dxi[3][27];
+	double curlGradientValues[9], divergenceGradientValues[3];
+	for (int p = 0; p < 2; ++p)
+	{
+		double xiOffset[3];
+		for (int k = 0; k < 3; ++k)
+		{
+			for (int d = 0; d < 3; ++d)
+				xiOffset[d] = xi[p][d];
+			xiOffset[k] -= delta;
+			EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element, 3, xiOffset));
+			EXPECT_EQ(RESULT_OK, gradient2.evaluateReal(fieldcache, 27, gradient2Minus));
+			xiOffset[k] += 2.0*delta;
+			EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element, 3, xiOffset));
+			EXPECT_EQ(RESULT_OK, gradient2.evaluateReal(fieldcache, 27, gradient2Plus));
+			for (int c = 0; c < 27; ++c)
+				dgradient2_dxi[k][c] = (gradient2Plus[c] - gradient2Minus[c]) / (2.0*delta);
+		}
+		EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element, 3, xi[p]));
+		EXPECT_EQ(RESULT_OK, dxi_dx.evaluateReal(fieldcache, 9, dxi_dxValues));
+		EXPECT_EQ(RESULT_OK, gradient2.evaluateReal(fieldcache, 27, gradient2Values));
+		EXPECT_EQ(RESULT_OK, gradient3.evaluateReal(fieldcache, 81, gradient3Values));
+		for (int c = 0; c < 27; ++c)
+			for (int j = 0; j < 3; ++j)
+			{
+				double expectedValue = 0.0;
+				for (int k = 0; k < 3; ++k)
+					expectedValue += dgradient2_dxi[k][c]*dxi_dxValues[k*3 + j];
+				EXPECT_NEAR(expectedValue, gradient3Values[c*3 + j], 1.0E-5);
+			}
+		// gradient of gradient is symmetric in the derivatives
+		for (int i = 0; i < 3; ++i)
+			for (int j = 0; j < 3; ++j)
+				for (int k = 0; k < 3; ++k)
+					EXPECT_NEAR(gradient2Values[(i*3 + j)*3 + k], gradient2Values[(i*3 + k)*3 + j], 1.0E-10);
+		EXPECT_EQ(RESULT_OK, curlGradient.evaluateReal(fieldcache, 9, curlGradientValues));
+		EXPECT_EQ(RESULT_OK, divergenceGradient.evaluateReal(fieldcache, 3, divergenceGradientValues));
+		for (int j = 0; j < 3; ++j)
+		{
+			for (int i = 0; i < 3; ++i)
+			{
+				// curl[i] = dV[i + 2]/dx[i + 1] - dV[i + 1]/dx[i + 2], indexes cycling
+				const int i1 = (i + 1) % 3;
+				const int i2 = (i + 2) % 3;
+				EXPECT_NEAR(gradient2Values[(i2*3 + i1)*3 + j] - gradient2Values[(i1*3 + i2)*3 + j],
+					curlGradientValues[i*3 + j], 1.0E-10);
+			}
+			EXPECT_NEAR(gradient2Values[j] + gradient2Values[12 + j] + gradient2Values[24 + j],
+				divergenceGradientValues[j], 1.0E-10);
+		}
+	}
+}
+
 // Issue 3317: Gradient field calculations for grid based scalar fields are not
 // being scaled by the number of grid points in each xi direction. The resulting
 // gradients are smaller than their correct values.
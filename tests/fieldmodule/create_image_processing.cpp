@@ -21,6 +21,7 @@
 #include <cmlibs/zinc/streamimage.h>
 
 #include <cmlibs/zinc/field.hpp>
+#include <cmlibs/zinc/fieldcache.hpp>
 #include <cmlibs/zinc/fieldimage.hpp>
 #include <cmlibs/zinc/fieldimageprocessing.hpp>
 #include <cmlibs/zinc/fieldmodule.hpp>
@@ -209,3 +210,189 @@ TEST(ZincFieldImagefilterThreshold, api)
 	EXPECT_EQ(CMZN_OK, result = th.setUpperThreshold(0.8));
 	ASSERT_DOUBLE_EQ(0.8, value = th.getUpperThreshold());
 }
+
+// Test chained image filters on the same grid give the same values as the
+// source image when connected directly or copied from image texels
+TEST(ZincFieldImagefilterThreshold, chain)
+{
+	ZincTestSetupCpp zinc;
+
+	FieldImage im = zinc.fm.createFieldImage();
+	EXPECT_TRUE(im.isValid());
+	EXPECT_EQ(RESULT_OK, im.readFile(resourcePath("testimage_gray.jpg").c_str()));
+	int sizes[2];
+	EXPECT_EQ(2, im.getSizeInPixels(2, sizes));
+
+	// thresholds keeping all values are identity filters
+	FieldImagefilterThreshold th1 = zinc.fm.createFieldImagefilterThreshold(im);
+	EXPECT_TRUE(th1.isValid());
+	EXPECT_EQ(RESULT_OK, th1.setCondition(FieldImagefilterThreshold::CONDITION_OUTSIDE));
+	EXPECT_EQ(RESULT_OK, th1.setLowerThreshold(-1.0));
+	EXPECT_EQ(RESULT_OK, th1.setUpperThreshold(2.0));
+	FieldImagefilterThreshold th2 = zinc.fm.createFieldImagefilterThreshold(th1);
+	EXPECT_TRUE(th2.isValid());
+	EXPECT_EQ(RESULT_OK, th2.setCondition(FieldImagefilterThreshold::CONDITION_OUTSIDE));
+	EXPECT_EQ(RESULT_OK, th2.setLowerThreshold(-1.0));
+	EXPECT_EQ(RESULT_OK, th2.setUpperThreshold(2.0));
+
+	Field xi = im.getDomainField();
+	EXPECT_TRUE(xi.isValid());
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const int pixels[4][2] = { { 0, 0 }, { sizes[0] - 1, 0 }, { sizes[0]/3, sizes[1]/2 }, { sizes[0] - 1, sizes[1] - 1 } };
+	for (int p = 0; p < 4; ++p)
+	{
+		const double location[2] = {
+			(pixels[p][0] + 0.5)/sizes[0],
+			(pixels[p][1] + 0.5)/sizes[1] };
+		EXPECT_EQ(RESULT_OK, fieldcache.setFieldReal(xi, 2, location));
+		double imageValue, value1, value2;
+		EXPECT_EQ(RESULT_OK, im.evaluateReal(fieldcache, 1, &imageValue));
+		EXPECT_EQ(RESULT_OK, th1.evaluateReal(fieldcache, 1, &value1));
+		EXPECT_EQ(RESULT_OK, th2.evaluateReal(fieldcache, 1, &value2));
+		EXPECT_DOUBLE_EQ(imageValue, value1);
+		EXPECT_DOUBLE_EQ(imageValue, value2);
+	}
+}
+
+TEST(ZincFieldImagefilter, interpolationMode)
+{
+	ZincTestSetupCpp zinc;
+
+	FieldImage im = zinc.fm.createFieldImage();
+	EXPECT_TRUE(im.isValid());
+	EXPECT_EQ(RESULT_OK, im.readFile(resourcePath("testimage_gray.jpg").c_str()));
+	int sizes[2];
+	EXPECT_EQ(2, im.getSizeInPixels(2, sizes));
+
+	FieldImagefilterThreshold th = zinc.fm.createFieldImagefilterThreshold(im);
+	EXPECT_TRUE(th.isValid());
+	EXPECT_EQ(RESULT_OK, th.setCondition(FieldImagefilterThreshold::CONDITION_OUTSIDE));
+	EXPECT_EQ(RESULT_OK, th.setLowerThreshold(-1.0));
+	EXPECT_EQ(RESULT_OK, th.setUpperThreshold(2.0));
+
+	FieldImagefilter filter(th);
+	EXPECT_EQ(FieldImagefilter::INTERPOLATION_MODE_NEAREST, filter.getInterpolationMode());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, filter.setInterpolationMode(FieldImagefilter::INTERPOLATION_MODE_INVALID));
+	EXPECT_EQ(RESULT_OK, filter.setInterpolationMode(FieldImagefilter::INTERPOLATION_MODE_LINEAR));
+	EXPECT_EQ(FieldImagefilter::INTERPOLATION_MODE_LINEAR, filter.getInterpolationMode());
+
+	// not an image filter
+	FieldImagefilter notFilter(im);
+	EXPECT_EQ(FieldImagefilter::INTERPOLATION_MODE_INVALID, notFilter.getInterpolationMode());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, notFilter.setInterpolationMode(FieldImagefilter::INTERPOLATION_MODE_LINEAR));
+
+	Field xi = im.getDomainField();
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const int i = sizes[0]/3;
+	const int j = sizes[1]/2;
+	double pixelValues[2];
+	for (int p = 0; p < 2; ++p)
+	{
+		const double location[2] = { (i + p + 0.5)/sizes[0], (j + 0.5)/sizes[1] };
+		EXPECT_EQ(RESULT_OK, fieldcache.setFieldReal(xi, 2, location));
+		EXPECT_EQ(RESULT_OK, im.evaluateReal(fieldcache, 1, &pixelValues[p]));
+	}
+	// linear interpolation between pixel centres
+	const double xiPoints[6] = {
+		(i + 0.5)/sizes[0], (j + 0.5)/sizes[1],
+		(i + 0.75)/sizes[0], (j + 0.5)/sizes[1],
+		(i + 1.0)/sizes[0], (j + 0.5)/sizes[1] };
+	const double expectedValues[3] = {
+		pixelValues[0],
+		0.75*pixelValues[0] + 0.25*pixelValues[1],
+		0.5*(pixelValues[0] + pixelValues[1]) };
+	double value;
+	for (int p = 0; p < 3; ++p)
+	{
+		EXPECT_EQ(RESULT_OK, fieldcache.setFieldReal(xi, 2, xiPoints + 2*p));
+		EXPECT_EQ(RESULT_OK, th.evaluateReal(fieldcache, 1, &value));
+		EXPECT_NEAR(expectedValues[p], value, 1.0E-12);
+	}
+
+	// batch sampling gives the same values
+	double values[3];
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, filter.evaluateRealXiPoints(fieldcache, 3, xiPoints, 2, values));
+	EXPECT_EQ(RESULT_OK, filter.evaluateRealXiPoints(fieldcache, 3, xiPoints, 3, values));
+	for (int p = 0; p < 3; ++p)
+		EXPECT_NEAR(expectedValues[p], values[p], 1.0E-12);
+
+	// cubic interpolation passes through pixel centres
+	EXPECT_EQ(RESULT_OK, filter.setInterpolationMode(FieldImagefilter::INTERPOLATION_MODE_CUBIC));
+	EXPECT_EQ(RESULT_OK, filter.evaluateRealXiPoints(fieldcache, 1, xiPoints, 1, values));
+	EXPECT_NEAR(pixelValues[0], values[0], 1.0E-12);
+	EXPECT_EQ(RESULT_OK, filter.setInterpolationMode(FieldImagefilter::INTERPOLATION_MODE_NEAREST));
+	EXPECT_EQ(RESULT_OK, filter.evaluateRealXiPoints(fieldcache, 3, xiPoints, 3, values));
+	EXPECT_DOUBLE_EQ(pixelValues[0], values[0]);
+	EXPECT_DOUBLE_EQ(pixelValues[0], values[1]);
+	EXPECT_DOUBLE_EQ(pixelValues[1], values[2]);
+}
+
+TEST(ZincFieldImagefilter, numberOfThreads)
+{
+	ZincTestSetupCpp zinc;
+
+	FieldImage im = zinc.fm.createFieldImage();
+	EXPECT_TRUE(im.isValid());
+	EXPECT_EQ(RESULT_OK, im.setPixelFormat(FieldImage::PIXEL_FORMAT_LUMINANCE));
+	EXPECT_EQ(RESULT_OK, im.setNumberOfBitsPerComponent(8));
+	const int sizes[2] = { 5, 4 };
+	EXPECT_EQ(RESULT_OK, im.setSizeInPixels(2, sizes));
+	unsigned char buffer[20];
+	for (int i = 0; i < 20; ++i)
+		buffer[i] = static_cast<unsigned char>((i*37) % 251);
+	EXPECT_EQ(RESULT_OK, im.setBuffer(buffer, sizeof(buffer)));
+
+	const int radii[2] = { 1, 1 };
+	FieldImagefilterMean mean = zinc.fm.createFieldImagefilterMean(im, 2, radii);
+	EXPECT_TRUE(mean.isValid());
+	FieldImagefilter filter(mean);
+	EXPECT_EQ(1, filter.getNumberOfThreads());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, filter.setNumberOfThreads(-1));
+	EXPECT_EQ(1, filter.getNumberOfThreads());
+
+	// not an image filter
+	FieldImagefilter notFilter(im);
+	EXPECT_EQ(-1, notFilter.getNumberOfThreads());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, notFilter.setNumberOfThreads(2));
+
+	Field xi = im.getDomainField();
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	double values1[20], values4[20];
+	for (int j = 0; j < sizes[1]; ++j)
+		for (int i = 0; i < sizes[0]; ++i)
+		{
+			const double location[2] = { (i + 0.5)/sizes[0], (j + 0.5)/sizes[1] };
+			EXPECT_EQ(RESULT_OK, fieldcache.setFieldReal(xi, 2, location));
+			EXPECT_EQ(RESULT_OK, mean.evaluateReal(fieldcache, 1, &values1[j*sizes[0] + i]));
+		}
+	// interior pixel averages 3x3 neighbourhood
+	double sum = 0.0;
+	for (int j = 0; j < 3; ++j)
+		for (int i = 1; i < 4; ++i)
+			sum += buffer[j*sizes[0] + i]/255.0;
+	EXPECT_NEAR(sum/9.0, values1[sizes[0] + 2], 1.0E-12);
+
+	// same result with more threads, including all hardware threads
+	for (int threads = 0; threads <= 4; threads += 4)
+	{
+		EXPECT_EQ(RESULT_OK, filter.setNumberOfThreads(threads));
+		EXPECT_EQ(threads, filter.getNumberOfThreads());
+		for (int j = 0; j < sizes[1]; ++j)
+			for (int i = 0; i < sizes[0]; ++i)
+			{
+				const double location[2] = { (i + 0.5)/sizes[0], (j + 0.5)/sizes[1] };
+				EXPECT_EQ(RESULT_OK, fieldcache.setFieldReal(xi, 2, location));
+				EXPECT_EQ(RESULT_OK, mean.evaluateReal(fieldcache, 1, &values4[j*sizes[0] + i]));
+				EXPECT_DOUBLE_EQ(values1[j*sizes[0] + i], values4[j*sizes[0] + i]);
+			}
+	}
+
+	// output is rebuilt when the source image changes
+	memset(buffer, 255, sizeof(buffer));
+	EXPECT_EQ(RESULT_OK, im.setBuffer(buffer, sizeof(buffer)));
+	const double location[2] = { 0.5, 0.5 };
+	double value;
+	EXPECT_EQ(RESULT_OK, fieldcache.setFieldReal(xi, 2, location));
+	EXPECT_EQ(RESULT_OK, mean.evaluateReal(fieldcache, 1, &value));
+	EXPECT_NEAR(1.0, value, 1.0E-12);
+}
@@ -26,6 +26,7 @@
 #include <cmlibs/zinc/mesh.hpp>
 #include <cmlibs/zinc/node.hpp>
 #include <cmlibs/zinc/nodeset.hpp>
+#include <cmlibs/zinc/nodetemplate.hpp>
 #include <cmlibs/zinc/streamregion.hpp>
 #include <cmlibs/zinc/status.hpp>
 
@@ -401,6 +402,104 @@ TEST(ZincFieldassignment, transformDerivatives)
 	}
 }
 
+// test multithreaded assignment gives identical results to serial assignment,
+// including derivatives transformed by gradient of source field
+TEST(ZincFieldassignment, transformDerivativesThreaded)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.context.setNumberOfThreads(4));
+	// enough nodes for several chunks of work so they are split between threads
+	const int nodesCount = 2000;
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	EXPECT_TRUE(nodes.isValid());
+	const Node::ValueLabel valueLabels[4] = { Node::VALUE_LABEL_VALUE, Node::VALUE_LABEL_D_DS1, Node::VALUE_LABEL_D_DS2, Node::VALUE_LABEL_D_DS3 };
+	FieldFiniteElement targetFields[2];
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_TRUE(nodetemplate.isValid());
+	EXPECT_EQ(RESULT_OK, zinc.fm.beginChange());
+	for (int f = 0; f < 2; ++f)
+	{
+		targetFields[f] = zinc.fm.createFieldFiniteElement(3);
+		EXPECT_TRUE(targetFields[f].isValid());
+		EXPECT_EQ(RESULT_OK, targetFields[f].setName(f ? "coordinates" : "serialCoordinates"));
+		EXPECT_EQ(RESULT_OK, targetFields[f].setTypeCoordinate(true));
+		EXPECT_EQ(RESULT_OK, nodetemplate.defineField(targetFields[f]));
+		for (int d = 1; d < 4; ++d)
+		{
+			EXPECT_EQ(RESULT_OK, nodetemplate.setValueNumberOfVersions(targetFields[f], -1, valueLabels[d], 1));
+		}
+	}
+	Fieldcache cache = zinc.fm.createFieldcache();
+	EXPECT_TRUE(cache.isValid());
+	for (int n = 0; n < nodesCount; ++n)
+	{
+		Node node = nodes.createNode(n + 1, nodetemplate);
+		EXPECT_TRUE(node.isValid());
+		EXPECT_EQ(RESULT_OK, cache.setNode(node));
+		const double parameters[4][3] = {
+			{ 0.1*(n % 10), 0.1*((n/10) % 10), 0.1*(n/100) },
+			{ 0.1, 0.01*(n % 3), 0.0 },
+			{ 0.0, 0.1, 0.01*(n % 5) },
+			{ 0.01*(n % 7), 0.0, 0.1 } };
+		for (int f = 0; f < 2; ++f)
+		{
+			for (int d = 0; d < 4; ++d)
+			{
+				EXPECT_EQ(RESULT_OK, targetFields[f].setNodeParameters(cache, -1, valueLabels[d], /*version*/1, 3, parameters[d]));
+			}
+		}
+	}
+	EXPECT_EQ(RESULT_OK, zinc.fm.endChange());
+	FieldFiniteElement& serialCoordinates = targetFields[0];
+	FieldFiniteElement& coordinates = targetFields[1];
+
+	const double offsetValues[3] = { 1.0, 0.0, 0.0 };
+	Field offset = zinc.fm.createFieldConstant(3, offsetValues);
+	EXPECT_TRUE(offset.isValid());
+	const double scaleValues[3] = { 2.0, 0.78539816339744830961566084581988, 0.5 };
+	Field scale = zinc.fm.createFieldConstant(3, scaleValues);
+	EXPECT_TRUE(scale.isValid());
+	Fieldassignment fieldassignments[2];
+	for (int f = 0; f < 2; ++f)
+	{
+		Field sphericalCoordinates = zinc.fm.createFieldIdentity((targetFields[f] + offset)*scale);
+		EXPECT_TRUE(sphericalCoordinates.isValid());
+		EXPECT_EQ(RESULT_OK, sphericalCoordinates.setCoordinateSystemType(Field::COORDINATE_SYSTEM_TYPE_SPHERICAL_POLAR));
+		Field newCoordinates = zinc.fm.createFieldCoordinateTransformation(sphericalCoordinates);
+		EXPECT_TRUE(newCoordinates.isValid());
+		EXPECT_EQ(RESULT_OK, newCoordinates.setCoordinateSystemType(Field::COORDINATE_SYSTEM_TYPE_RECTANGULAR_CARTESIAN));
+		fieldassignments[f] = targetFields[f].createFieldassignment(newCoordinates);
+		EXPECT_TRUE(fieldassignments[f].isValid());
+		EXPECT_EQ(1, fieldassignments[f].getNumberOfThreads());
+	}
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, fieldassignments[1].setNumberOfThreads(-1));
+	EXPECT_EQ(RESULT_OK, fieldassignments[1].setNumberOfThreads(0));
+	EXPECT_EQ(0, fieldassignments[1].getNumberOfThreads());
+	EXPECT_EQ(RESULT_OK, fieldassignments[1].setNumberOfThreads(4));
+	EXPECT_EQ(4, fieldassignments[1].getNumberOfThreads());
+
+	EXPECT_EQ(RESULT_OK, fieldassignments[0].assign());
+	EXPECT_EQ(RESULT_OK, fieldassignments[1].assign());
+
+	double serialValues[3], values[3];
+	for (int n = 0; n < nodesCount; ++n)
+	{
+		Node node = nodes.findNodeByIdentifier(n + 1);
+		EXPECT_TRUE(node.isValid());
+		EXPECT_EQ(RESULT_OK, cache.setNode(node));
+		for (int d = 0; d < 4; ++d)
+		{
+			EXPECT_EQ(RESULT_OK, serialCoordinates.getNodeParameters(cache, -1, valueLabels[d], /*version*/1, 3, serialValues));
+			EXPECT_EQ(RESULT_OK, coordinates.getNodeParameters(cache, -1, valueLabels[d], /*version*/1, 3, values));
+			for (int c = 0; c < 3; ++c)
+			{
+				EXPECT_EQ(serialValues[c], values[c]);
+			}
+		}
+	}
+}
+
 namespace {
 
 void checkAssignNodeValueVersions(Fieldmodule& fm, const double *offset, const double *scale, bool squared = false)
@@ -36,6 +36,12 @@ TEST(ZincField, DomainTypeEnum)
 	testEnumBitShift(8, enumNames, Field::DomainTypeEnumToString, Field::DomainTypeEnumFromString);
 }
 
+TEST(ZincField, DomainOrderingEnum)
+{
+	const char *enumNames[4] = { nullptr, "HILBERT", "MORTON", "REVERSE_CUTHILL_MCKEE" };
+	testEnum(4, enumNames, Field::DomainOrderingEnumToString, Field::DomainOrderingEnumFromString);
+}
+
 TEST(ZincField, automaticRenaming)
 {
 	ZincTestSetupCpp zinc;
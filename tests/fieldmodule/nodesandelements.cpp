@@ -24,11 +24,17 @@
 #include <cmlibs/zinc/changemanager.hpp>
 #include <cmlibs/zinc/context.hpp>
 #include <cmlibs/zinc/element.hpp>
+#include <cmlibs/zinc/elementbasis.hpp>
+#include <cmlibs/zinc/elementfieldtemplate.hpp>
+#include <cmlibs/zinc/elementtemplate.hpp>
 #include <cmlibs/zinc/field.hpp>
+#include <cmlibs/zinc/fieldcache.hpp>
 #include <cmlibs/zinc/fieldconstant.hpp>
+#include <cmlibs/zinc/fieldfiniteelement.hpp>
 #include <cmlibs/zinc/fieldgroup.hpp>
 #include <cmlibs/zinc/fieldlogicaloperators.hpp>
 #include <cmlibs/zinc/fieldmodule.hpp>
+#include <cmlibs/zinc/fieldparameters.hpp>
 #include <cmlibs/zinc/node.hpp>
 #include <cmlibs/zinc/status.hpp>
 #include <cmlibs/zinc/stream.hpp>
@@ -38,6 +44,8 @@
 
 #include "test_resources.h"
 
+#include <vector>
+
 
 TEST(nodes_elements_identifier, set_identifier)
 {
@@ -678,6 +686,326 @@ TEST(ZincNodeset, destroyNodesGroupChangeManager)
 	}
 }
 
+// Check field parameters of bilinear 2-D coordinates index the values at the
+// nodes of each element in mesh, without regenerating parameter maps
+static void checkElementCoordinatesParameters(Fieldparameters& fieldparameters,
+	int parameterCount, Mesh& mesh, const Elementfieldtemplate& eft, const Field& coordinates)
+{
+	std::vector<double> parameters(parameterCount);
+	EXPECT_EQ(RESULT_OK, fieldparameters.getParameters(parameterCount, parameters.data()));
+	Fieldcache fieldcache = coordinates.getFieldmodule().createFieldcache();
+	Elementiterator elementiterator = mesh.createElementiterator();
+	Element element;
+	while ((element = elementiterator.next()).isValid())
+	{
+		int parameterIndexes[8];
+		EXPECT_EQ(8, fieldparameters.getNumberOfElementParameters(element));
+		EXPECT_EQ(RESULT_OK, fieldparameters.getElementParameterIndexesZero(element, 8, parameterIndexes));
+		for (int n = 0; n < 4; ++n)
+		{
+			EXPECT_EQ(RESULT_OK, fieldcache.setNode(element.getNode(eft, n + 1)));
+			double x[2];
+			EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(fieldcache, 2, x));
+			EXPECT_DOUBLE_EQ(x[0], parameters[parameterIndexes[n]]);
+			EXPECT_DOUBLE_EQ(x[1], parameters[parameterIndexes[4 + n]]);
+		}
+	}
+}
+
+// Test compacting element and node indexes after destroying most of a mesh
+// preserves identifiers, field values, group membership and face connectivity
+TEST(ZincMesh, compact)
+{
+	ZincTestSetupCpp zinc;
+
+	const int elementCount = 16;
+	FieldFiniteElement coordinates = zinc.fm.createFieldFiniteElement(/*numberOfComponents*/2);
+	EXPECT_TRUE(coordinates.isValid());
+	EXPECT_EQ(RESULT_OK, coordinates.setName("coordinates"));
+	EXPECT_EQ(RESULT_OK, coordinates.setTypeCoordinate(true));
+	FieldFiniteElement pressure = zinc.fm.createFieldFiniteElement(/*numberOfComponents*/1);
+	EXPECT_TRUE(pressure.isValid());
+	EXPECT_EQ(RESULT_OK, pressure.setName("pressure"));
+
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(RESULT_OK, nodetemplate.defineField(coordinates));
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	// 2 rows of nodes with identifier 2*i + j + 1 at x = i, y = j
+	for (int i = 0; i <= elementCount; ++i)
+	{
+		for (int j = 0; j < 2; ++j)
+		{
+			Node node = nodes.createNode(2*i + j + 1, nodetemplate);
+			EXPECT_TRUE(node.isValid());
+			EXPECT_EQ(RESULT_OK, fieldcache.setNode(node));
+			const double x[2] = { static_cast<double>(i), static_cast<double>(j) };
+			EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 2, x));
+		}
+	}
+
+	Mesh mesh2d = zinc.fm.findMeshByDimension(2);
+	Elementbasis bilinearBasis = zinc.fm.createElementbasis(2, Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE);
+	Elementfieldtemplate eftBilinear = mesh2d.createElementfieldtemplate(bilinearBasis);
+	EXPECT_TRUE(eftBilinear.isValid());
+	Elementbasis constantBasis = zinc.fm.createElementbasis(2, Elementbasis::FUNCTION_TYPE_CONSTANT);
+	Elementfieldtemplate eftElementConstant = mesh2d.createElementfieldtemplate(constantBasis);
+	EXPECT_EQ(RESULT_OK, eftElementConstant.setParameterMappingMode(Elementfieldtemplate::PARAMETER_MAPPING_MODE_ELEMENT));
+	EXPECT_TRUE(eftElementConstant.validate());
+	Elementtemplate elementtemplate = mesh2d.createElementtemplate();
+	EXPECT_EQ(RESULT_OK, elementtemplate.setElementShapeType(Element::SHAPE_TYPE_SQUARE));
+	EXPECT_EQ(RESULT_OK, elementtemplate.defineField(coordinates, -1, eftBilinear));
+	EXPECT_EQ(RESULT_OK, elementtemplate.defineField(pressure, -1, eftElementConstant));
+	const double xi[2] = { 0.5, 0.5 };
+	for (int e = 0; e < elementCount; ++e)
+	{
+		Element element = mesh2d.createElement(e + 1, elementtemplate);
+		EXPECT_TRUE(element.isValid());
+		const int nodeIdentifiers[4] = { 2*e + 1, 2*e + 3, 2*e + 2, 2*e + 4 };
+		EXPECT_EQ(RESULT_OK, element.setNodesByIdentifier(eftBilinear, 4, nodeIdentifiers));
+		EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element, 2, xi));
+		const double p = 10.0*(e + 1);
+		EXPECT_EQ(RESULT_OK, pressure.assignReal(fieldcache, 1, &p));
+	}
+	EXPECT_EQ(RESULT_OK, zinc.fm.defineAllFaces());
+	Mesh mesh1d = zinc.fm.findMeshByDimension(1);
+	EXPECT_EQ(3*elementCount + 1, mesh1d.getSize());
+
+	FieldGroup group = zinc.fm.createFieldGroup();
+	EXPECT_EQ(RESULT_OK, group.setSubelementHandlingMode(FieldGroup::SUBELEMENT_HANDLING_MODE_FULL));
+	MeshGroup meshGroup2d = group.createMeshGroup(mesh2d);
+	const double one = 1.0;
+	EXPECT_EQ(RESULT_OK, meshGroup2d.addElementsConditional(zinc.fm.createFieldConstant(1, &one)));
+	EXPECT_EQ(elementCount, meshGroup2d.getSize());
+
+	// destroy first 12 elements and their unused faces and nodes
+	Field cmiss_number = zinc.fm.findFieldByName("cmiss_number");
+	const double limitIdentifierValue = 12.5;
+	FieldLessThan lowIdentifiers = zinc.fm.createFieldLessThan(cmiss_number,
+		zinc.fm.createFieldConstant(1, &limitIdentifierValue));
+	EXPECT_EQ(RESULT_OK, mesh2d.destroyElementsConditional(lowIdentifiers));
+	EXPECT_EQ(4, mesh2d.getSize());
+	EXPECT_EQ(13, mesh1d.getSize());
+	EXPECT_EQ(RESULT_ERROR_IN_USE, nodes.destroyAllNodes());
+	EXPECT_EQ(10, nodes.getSize());
+	Element element16 = mesh2d.findElementByIdentifier(16);
+	EXPECT_TRUE(element16.isValid());
+	Node node34 = nodes.findNodeByIdentifier(34);
+	EXPECT_TRUE(node34.isValid());
+
+	// field parameters with maps made before compacting
+	Fieldparameters fieldparameters = coordinates.getFieldparameters();
+	EXPECT_TRUE(fieldparameters.isValid());
+	const int parameterCount = fieldparameters.getNumberOfParameters();
+	EXPECT_EQ(20, parameterCount);
+
+	EXPECT_EQ(RESULT_OK, nodes.compact());
+	EXPECT_EQ(RESULT_OK, mesh1d.compact());
+	EXPECT_EQ(RESULT_OK, meshGroup2d.compact());  // compacts master mesh
+	// compacting again does nothing
+	EXPECT_EQ(RESULT_OK, mesh2d.compact());
+
+	EXPECT_EQ(4, mesh2d.getSize());
+	EXPECT_EQ(13, mesh1d.getSize());
+	EXPECT_EQ(10, nodes.getSize());
+	EXPECT_EQ(4, meshGroup2d.getSize());
+	// existing handles remain valid
+	EXPECT_EQ(16, element16.getIdentifier());
+	EXPECT_EQ(element16, mesh2d.findElementByIdentifier(16));
+	EXPECT_EQ(34, node34.getIdentifier());
+	EXPECT_EQ(node34, nodes.findNodeByIdentifier(34));
+
+	Elementiterator elementiterator = meshGroup2d.createElementiterator();
+	fieldcache = zinc.fm.createFieldcache();
+	for (int e = 12; e < elementCount; ++e)
+	{
+		Element element = elementiterator.next();
+		EXPECT_EQ(e + 1, element.getIdentifier());
+		EXPECT_EQ(4, element.getNumberOfFaces());
+		EXPECT_TRUE(mesh1d.containsElement(element.getFaceElement(1)));
+		EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element, 2, xi));
+		double x[2], p;
+		EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(fieldcache, 2, x));
+		EXPECT_DOUBLE_EQ(e + 0.5, x[0]);
+		EXPECT_DOUBLE_EQ(0.5, x[1]);
+		EXPECT_EQ(RESULT_OK, pressure.evaluateReal(fieldcache, 1, &p));
+		EXPECT_DOUBLE_EQ(10.0*(e + 1), p);
+	}
+	EXPECT_FALSE(elementiterator.next().isValid());
+	checkElementCoordinatesParameters(fieldparameters, parameterCount, mesh2d, eftBilinear, coordinates);
+
+	// face and node groups are rebuilt from compacted connectivity
+	MeshGroup meshGroup1d = group.getMeshGroup(mesh1d);
+	NodesetGroup nodesetGroup = group.getNodesetGroup(nodes);
+	EXPECT_EQ(RESULT_OK, meshGroup2d.removeAllElements());
+	EXPECT_EQ(0, meshGroup1d.getSize());
+	EXPECT_EQ(0, nodesetGroup.getSize());
+	EXPECT_EQ(RESULT_OK, meshGroup2d.addElement(element16));
+	EXPECT_EQ(4, meshGroup1d.getSize());
+	EXPECT_EQ(4, nodesetGroup.getSize());
+	EXPECT_TRUE(nodesetGroup.containsNode(node34));
+
+	// can add new elements and nodes after compacting
+	Node node35 = nodes.createNode(35, nodetemplate);
+	EXPECT_TRUE(node35.isValid());
+	Element element17 = mesh2d.createElement(17, elementtemplate);
+	EXPECT_TRUE(element17.isValid());
+	EXPECT_EQ(5, mesh2d.getSize());
+	EXPECT_EQ(element17, mesh2d.findElementByIdentifier(17));
+}
+
+TEST(ZincMesh, reorder)
+{
+	ZincTestSetupCpp zinc;
+
+	// 4x4 bilinear squares with element and node identifiers in reverse order of position
+	const int gridSize = 4;
+	const int elementCount = gridSize*gridSize;
+	const int nodeCount = (gridSize + 1)*(gridSize + 1);
+	FieldFiniteElement coordinates = zinc.fm.createFieldFiniteElement(/*numberOfComponents*/2);
+	EXPECT_TRUE(coordinates.isValid());
+	EXPECT_EQ(RESULT_OK, coordinates.setName("coordinates"));
+	EXPECT_EQ(RESULT_OK, coordinates.setTypeCoordinate(true));
+	FieldFiniteElement pressure = zinc.fm.createFieldFiniteElement(/*numberOfComponents*/1);
+	EXPECT_TRUE(pressure.isValid());
+	EXPECT_EQ(RESULT_OK, pressure.setName("pressure"));
+
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(RESULT_OK, nodetemplate.defineField(coordinates));
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	for (int j = 0; j <= gridSize; ++j)
+	{
+		for (int i = 0; i <= gridSize; ++i)
+		{
+			Node node = nodes.createNode(nodeCount - (j*(gridSize + 1) + i), nodetemplate);
+			EXPECT_TRUE(node.isValid());
+			EXPECT_EQ(RESULT_OK, fieldcache.setNode(node));
+			const double x[2] = { static_cast<double>(i), static_cast<double>(j) };
+			EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 2, x));
+		}
+	}
+
+	Mesh mesh2d = zinc.fm.findMeshByDimension(2);
+	Elementbasis bilinearBasis = zinc.fm.createElementbasis(2, Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE);
+	Elementfieldtemplate eftBilinear = mesh2d.createElementfieldtemplate(bilinearBasis);
+	EXPECT_TRUE(eftBilinear.isValid());
+	Elementbasis constantBasis = zinc.fm.createElementbasis(2, Elementbasis::FUNCTION_TYPE_CONSTANT);
+	Elementfieldtemplate eftElementConstant = mesh2d.createElementfieldtemplate(constantBasis);
+	EXPECT_EQ(RESULT_OK, eftElementConstant.setParameterMappingMode(Elementfieldtemplate::PARAMETER_MAPPING_MODE_ELEMENT));
+	EXPECT_TRUE(eftElementConstant.validate());
+	Elementtemplate elementtemplate = mesh2d.createElementtemplate();
+	EXPECT_EQ(RESULT_OK, elementtemplate.setElementShapeType(Element::SHAPE_TYPE_SQUARE));
+	EXPECT_EQ(RESULT_OK, elementtemplate.defineField(coordinates, -1, eftBilinear));
+	EXPECT_EQ(RESULT_OK, elementtemplate.defineField(pressure, -1, eftElementConstant));
+	const double xi[2] = { 0.5, 0.5 };
+	for (int j = 0; j < gridSize; ++j)
+	{
+		for (int i = 0; i < gridSize; ++i)
+		{
+			const int identifier = elementCount - (j*gridSize + i);
+			Element element = mesh2d.createElement(identifier, elementtemplate);
+			EXPECT_TRUE(element.isValid());
+			const int n = j*(gridSize + 1) + i;
+			const int nodeIdentifiers[4] = { nodeCount - n, nodeCount - n - 1,
+				nodeCount - n - gridSize - 1, nodeCount - n - gridSize - 2 };
+			EXPECT_EQ(RESULT_OK, element.setNodesByIdentifier(eftBilinear, 4, nodeIdentifiers));
+			EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element, 2, xi));
+			const double p = 10.0*identifier;
+			EXPECT_EQ(RESULT_OK, pressure.assignReal(fieldcache, 1, &p));
+		}
+	}
+	EXPECT_EQ(RESULT_OK, zinc.fm.defineAllFaces());
+	Mesh mesh1d = zinc.fm.findMeshByDimension(1);
+	EXPECT_EQ(2*gridSize*(gridSize + 1), mesh1d.getSize());
+
+	// group of odd numbered elements
+	FieldGroup group = zinc.fm.createFieldGroup();
+	MeshGroup meshGroup2d = group.createMeshGroup(mesh2d);
+	for (int identifier = 1; identifier <= elementCount; identifier += 2)
+		EXPECT_EQ(RESULT_OK, meshGroup2d.addElement(mesh2d.findElementByIdentifier(identifier)));
+	NodesetGroup nodesetGroup = group.createNodesetGroup(nodes);
+	EXPECT_EQ(RESULT_OK, nodesetGroup.addNode(nodes.findNodeByIdentifier(1)));
+
+	Element element1 = mesh2d.findElementByIdentifier(1);
+	Node node1 = nodes.findNodeByIdentifier(1);
+
+	// field parameters with maps made before reordering
+	Fieldparameters fieldparameters = coordinates.getFieldparameters();
+	EXPECT_TRUE(fieldparameters.isValid());
+	const int parameterCount = fieldparameters.getNumberOfParameters();
+	EXPECT_EQ(2*nodeCount, parameterCount);
+
+	// invalid arguments
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, mesh2d.reorder(Field(), Field::DOMAIN_ORDERING_HILBERT));
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, mesh2d.reorder(coordinates, Field::DOMAIN_ORDERING_INVALID));
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, nodes.reorder(Field(), Field::DOMAIN_ORDERING_MORTON));
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, Mesh().reorder(coordinates, Field::DOMAIN_ORDERING_HILBERT));
+
+	EXPECT_EQ(RESULT_OK, mesh2d.reorder(coordinates, Field::DOMAIN_ORDERING_HILBERT));
+	EXPECT_EQ(RESULT_OK, nodes.reorder(coordinates, Field::DOMAIN_ORDERING_HILBERT));
+	EXPECT_EQ(RESULT_OK, mesh1d.reorder(Field(), Field::DOMAIN_ORDERING_REVERSE_CUTHILL_MCKEE));
+	EXPECT_EQ(RESULT_OK, meshGroup2d.reorder(coordinates, Field::DOMAIN_ORDERING_MORTON));  // reorders master mesh
+	EXPECT_EQ(RESULT_OK, nodes.reorder(Field(), Field::DOMAIN_ORDERING_REVERSE_CUTHILL_MCKEE));
+	EXPECT_EQ(RESULT_OK, mesh2d.reorder(Field(), Field::DOMAIN_ORDERING_REVERSE_CUTHILL_MCKEE));
+
+	EXPECT_EQ(elementCount, mesh2d.getSize());
+	EXPECT_EQ(2*gridSize*(gridSize + 1), mesh1d.getSize());
+	EXPECT_EQ(nodeCount, nodes.getSize());
+	EXPECT_EQ(elementCount/2, meshGroup2d.getSize());
+	EXPECT_EQ(1, nodesetGroup.getSize());
+	EXPECT_TRUE(nodesetGroup.containsNode(node1));
+	// existing handles remain valid
+	EXPECT_EQ(element1, mesh2d.findElementByIdentifier(1));
+	EXPECT_EQ(node1, nodes.findNodeByIdentifier(1));
+
+	// iteration is still in identifier order with unchanged values and faces
+	Elementiterator elementiterator = mesh2d.createElementiterator();
+	fieldcache = zinc.fm.createFieldcache();
+	for (int identifier = 1; identifier <= elementCount; ++identifier)
+	{
+		Element element = elementiterator.next();
+		EXPECT_EQ(identifier, element.getIdentifier());
+		EXPECT_EQ(identifier % 2 == 1, meshGroup2d.containsElement(element));
+		EXPECT_EQ(4, element.getNumberOfFaces());
+		EXPECT_TRUE(mesh1d.containsElement(element.getFaceElement(1)));
+		const int position = elementCount - identifier;
+		const int n = (position / gridSize)*(gridSize + 1) + (position % gridSize);
+		EXPECT_EQ(nodeCount - n, element.getNode(eftBilinear, 1).getIdentifier());
+		EXPECT_EQ(nodeCount - n - gridSize - 2, element.getNode(eftBilinear, 4).getIdentifier());
+		EXPECT_EQ(RESULT_OK, fieldcache.setMeshLocation(element, 2, xi));
+		double x[2], p;
+		EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(fieldcache, 2, x));
+		EXPECT_DOUBLE_EQ((position % gridSize) + 0.5, x[0]);
+		EXPECT_DOUBLE_EQ((position / gridSize) + 0.5, x[1]);
+		EXPECT_EQ(RESULT_OK, pressure.evaluateReal(fieldcache, 1, &p));
+		EXPECT_DOUBLE_EQ(10.0*identifier, p);
+	}
+	EXPECT_FALSE(elementiterator.next().isValid());
+	Nodeiterator nodeiterator = nodes.createNodeiterator();
+	for (int identifier = 1; identifier <= nodeCount; ++identifier)
+	{
+		Node node = nodeiterator.next();
+		EXPECT_EQ(identifier, node.getIdentifier());
+		EXPECT_EQ(RESULT_OK, fieldcache.setNode(node));
+		double x[2];
+		EXPECT_EQ(RESULT_OK, coordinates.evaluateReal(fieldcache, 2, x));
+		const int position = nodeCount - identifier;
+		EXPECT_DOUBLE_EQ(position % (gridSize + 1), x[0]);
+		EXPECT_DOUBLE_EQ(position / (gridSize + 1), x[1]);
+	}
+	EXPECT_FALSE(nodeiterator.next().isValid());
+	checkElementCoordinatesParameters(fieldparameters, parameterCount, mesh2d, eftBilinear, coordinates);
+
+	// can add new elements and nodes after reordering
+	Node newNode = nodes.createNode(nodeCount + 1, nodetemplate);
+	EXPECT_TRUE(newNode.isValid());
+	Element newElement = mesh2d.createElement(elementCount + 1, elementtemplate);
+	EXPECT_TRUE(newElement.isValid());
+	EXPECT_EQ(newElement, mesh2d.findElementByIdentifier(elementCount + 1));
+	EXPECT_EQ(elementCount + 1, mesh2d.getSize());
+}
+
 TEST(ZincElement, FaceTypeEnum)
 {
 	const char *enumNames[10] = { nullptr, "ALL", "ANY_FACE", "NO_FACE", "XI1_0", "XI1_1", "XI2_0", "XI2_1", "XI3_0", "XI3_1" };
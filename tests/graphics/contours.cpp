@@ -26,6 +26,7 @@
 #include <cmlibs/zinc/fieldtrigonometry.hpp>
 #include <cmlibs/zinc/fieldvectoroperators.hpp>
 #include <cmlibs/zinc/result.hpp>
+#include <cmlibs/zinc/scenefilter.hpp>
 #include <cmlibs/zinc/timekeeper.hpp>
 
 #include "zinctestsetup.hpp"
@@ -184,6 +185,34 @@ TEST(cmzn_graphics_contours, range_isovalues_null)
 	EXPECT_EQ(CMZN_OK, cmzn_graphics_contours_destroy(&is));
 }
 
+TEST(cmzn_graphics_contours, shared_vertices)
+{
+	ZincTestSetup zinc;
+
+	cmzn_graphics_id gr = cmzn_scene_create_graphics_contours(zinc.scene);
+	cmzn_graphics_contours_id is = cmzn_graphics_cast_contours(gr);
+	cmzn_graphics_destroy(&gr);
+	EXPECT_NE(static_cast<cmzn_graphics_contours *>(0), is);
+
+	EXPECT_FALSE(cmzn_graphics_contours_get_shared_vertices_flag(is));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_contours_set_shared_vertices_flag(is, true));
+	EXPECT_TRUE(cmzn_graphics_contours_get_shared_vertices_flag(is));
+	EXPECT_FALSE(cmzn_graphics_contours_get_shared_vertices_flag(0));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_contours_set_shared_vertices_flag(0, true));
+
+	EXPECT_EQ(1, cmzn_graphics_contours_get_number_of_threads(is));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_contours_set_number_of_threads(is, 4));
+	EXPECT_EQ(4, cmzn_graphics_contours_get_number_of_threads(is));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_contours_set_number_of_threads(is, 0));
+	EXPECT_EQ(0, cmzn_graphics_contours_get_number_of_threads(is));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_contours_set_number_of_threads(is, -1));
+	EXPECT_EQ(0, cmzn_graphics_contours_get_number_of_threads(is));
+	EXPECT_EQ(-1, cmzn_graphics_contours_get_number_of_threads(0));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_contours_set_number_of_threads(0, 1));
+
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_contours_destroy(&is));
+}
+
 TEST(cmzn_graphics_contours, description_io)
 {
 	ZincTestSetupCpp zinc;
@@ -206,6 +235,7 @@ TEST(cmzn_graphics_contours, description_io)
 
 	EXPECT_EQ(CMZN_OK, gr2.setListIsovalues(3, dvalues));
 	EXPECT_EQ(CMZN_OK, gr2.setIsoscalarField(orientationScaleField));
+	EXPECT_EQ(CMZN_OK, gr2.setSharedVerticesFlag(true));
 
 	char *return_string = zinc.scene.writeDescription();
 	EXPECT_TRUE(return_string != 0);
@@ -223,12 +253,14 @@ TEST(cmzn_graphics_contours, description_io)
 	EXPECT_EQ(1,  gr.getRangeNumberOfIsovalues());
 	EXPECT_EQ(0.3, gr.getRangeFirstIsovalue());
 	EXPECT_EQ(0.3, gr.getRangeLastIsovalue());
+	EXPECT_FALSE(gr.getSharedVerticesFlag());
 
 	EXPECT_EQ(orientationScaleField.getId(), gr2.getIsoscalarField().getId());
 	EXPECT_EQ(3, gr2.getListIsovalues(3, dvalues));
 	EXPECT_EQ(0.1, dvalues[0]);
 	EXPECT_EQ(0.2, dvalues[1]);
 	EXPECT_EQ(0.3, dvalues[2]);
+	EXPECT_TRUE(gr2.getSharedVerticesFlag());
 
 	cmzn_deallocate(return_string);
 }
@@ -365,3 +397,73 @@ TEST(ZincGraphicsContours, analytic_isosurfaces)
 	//	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(Scenefilter(), minimums, maximums));
 	//}
 }
+
+// test shared vertex iso-surfaces have the same extent as per-element ones,
+// fewer vertices, and are independent of the number of threads
+TEST(ZincGraphicsContours, sharedVertices)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(resourcePath("fieldmodule/allshapes.ex3").c_str()));
+	EXPECT_EQ(RESULT_OK, zinc.fm.defineAllFaces());
+
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	FieldComponent z = zinc.fm.createFieldComponent(coordinates, 3);
+	EXPECT_TRUE(z.isValid());
+
+	Tessellation tessellation = zinc.context.getTessellationmodule().getDefaultTessellation();
+	const int number4 = 4;
+	EXPECT_EQ(RESULT_OK, tessellation.setMinimumDivisions(1, &number4));
+
+	const char *names[3] = { "unshared", "serial", "threaded" };
+	GraphicsContours contours[3];
+	const double isovalue = 0.35;
+	zinc.scene.beginChange();
+	for (int i = 0; i < 3; ++i)
+	{
+		contours[i] = zinc.scene.createGraphicsContours();
+		EXPECT_TRUE(contours[i].isValid());
+		EXPECT_EQ(RESULT_OK, contours[i].setName(names[i]));
+		EXPECT_EQ(RESULT_OK, contours[i].setCoordinateField(coordinates));
+		EXPECT_EQ(RESULT_OK, contours[i].setIsoscalarField(z));
+		EXPECT_EQ(RESULT_OK, contours[i].setListIsovalues(1, &isovalue));
+		if (i > 0)
+		{
+			EXPECT_EQ(RESULT_OK, contours[i].setSharedVerticesFlag(true));
+		}
+	}
+	EXPECT_EQ(RESULT_OK, contours[2].setNumberOfThreads(4));
+	zinc.scene.endChange();
+
+	Scenefiltermodule scenefiltermodule = zinc.context.getScenefiltermodule();
+	double minimums[3][3], maximums[3][3];
+	for (int i = 0; i < 3; ++i)
+	{
+		Scenefilter filter = scenefiltermodule.createScenefilterGraphicsName(names[i]);
+		EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(filter, minimums[i], maximums[i]));
+	}
+	const double GTOL = 1.0E-6;  // as graphics may be in single precision
+	for (int c = 0; c < 3; ++c)
+	{
+		EXPECT_NEAR(minimums[0][c], minimums[1][c], GTOL);
+		EXPECT_NEAR(maximums[0][c], maximums[1][c], GTOL);
+		EXPECT_EQ(minimums[1][c], minimums[2][c]);
+		EXPECT_EQ(maximums[1][c], maximums[2][c]);
+	}
+	EXPECT_NEAR(isovalue, minimums[1][2], GTOL);
+	EXPECT_NEAR(isovalue, maximums[1][2], GTOL);
+
+	int vertexCounts[3];
+	for (int i = 0; i < 3; ++i)
+	{
+		for (int j = 0; j < 3; ++j)
+		{
+			EXPECT_EQ(RESULT_OK, contours[j].setVisibilityFlag(i == j));
+		}
+		vertexCounts[i] = countWavefrontVertices(zinc.scene);
+	}
+	EXPECT_GT(vertexCounts[1], 0);
+	EXPECT_LT(vertexCounts[1], vertexCounts[0]);
+	EXPECT_EQ(vertexCounts[1], vertexCounts[2]);
+}
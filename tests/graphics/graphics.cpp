@@ -19,11 +19,18 @@
 #include <cmlibs/zinc/graphics.h>
 #include <cmlibs/zinc/spectrum.h>
 
+#include "cmlibs/zinc/element.hpp"
+#include "cmlibs/zinc/elementbasis.hpp"
+#include "cmlibs/zinc/fieldcache.hpp"
 #include "cmlibs/zinc/fieldconstant.hpp"
 #include "cmlibs/zinc/fieldgroup.hpp"
 #include "cmlibs/zinc/fieldfiniteelement.hpp"
 #include "cmlibs/zinc/font.hpp"
 #include "cmlibs/zinc/graphics.hpp"
+#include "cmlibs/zinc/node.hpp"
+#include "cmlibs/zinc/nodeset.hpp"
+#include "cmlibs/zinc/nodetemplate.hpp"
+#include "cmlibs/zinc/scenefilter.hpp"
 #include "cmlibs/zinc/result.hpp"
 
 #include "utilities/testenum.hpp"
@@ -706,6 +713,259 @@ TEST(cmzn_graphics_api, tessellation_field_cpp)
 	EXPECT_FALSE(tempTessellationField.isValid());
 }
 
+TEST(cmzn_graphics_api, lod)
+{
+	ZincTestSetup zinc;
+
+	cmzn_graphics_id gr = cmzn_scene_create_graphics_surfaces(zinc.scene);
+	EXPECT_NE(static_cast<cmzn_graphics *>(0), gr);
+
+	EXPECT_EQ(1, cmzn_graphics_get_lod_levels_count(gr));
+	EXPECT_EQ(0, cmzn_graphics_get_lod_levels_count(static_cast<cmzn_graphics_id>(0)));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_set_lod_levels_count(static_cast<cmzn_graphics_id>(0), 3));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_set_lod_levels_count(gr, 0));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_set_lod_levels_count(gr, 9));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_set_lod_levels_count(gr, 3));
+	EXPECT_EQ(3, cmzn_graphics_get_lod_levels_count(gr));
+
+	EXPECT_DOUBLE_EQ(256.0, cmzn_graphics_get_lod_threshold(gr));
+	EXPECT_DOUBLE_EQ(0.0, cmzn_graphics_get_lod_threshold(static_cast<cmzn_graphics_id>(0)));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_set_lod_threshold(static_cast<cmzn_graphics_id>(0), 100.0));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_set_lod_threshold(gr, 0.0));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_set_lod_threshold(gr, 100.0));
+	EXPECT_DOUBLE_EQ(100.0, cmzn_graphics_get_lod_threshold(gr));
+
+	cmzn_graphics_destroy(&gr);
+}
+
+TEST(ZincGraphics, lod)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(resourcePath("fieldmodule/two_cubes.exformat").c_str()));
+	EXPECT_EQ(RESULT_OK, zinc.fm.defineAllFaces());
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	GraphicsSurfaces gr = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(gr.isValid());
+	EXPECT_EQ(RESULT_OK, gr.setCoordinateField(coordinates));
+	EXPECT_EQ(1, gr.getLodLevelsCount());
+	EXPECT_DOUBLE_EQ(256.0, gr.getLodThreshold());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, gr.setLodLevelsCount(0));
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, gr.setLodThreshold(-1.0));
+	EXPECT_EQ(RESULT_OK, gr.setLodLevelsCount(4));
+	EXPECT_EQ(RESULT_OK, gr.setLodThreshold(128.0));
+
+	// rendering without a scene viewer always uses full detail
+	const int vertexCount = countWavefrontVertices(zinc.scene);
+	EXPECT_GT(vertexCount, 0);
+	EXPECT_EQ(RESULT_OK, gr.setLodLevelsCount(1));
+	EXPECT_EQ(vertexCount, countWavefrontVertices(zinc.scene));
+	EXPECT_EQ(RESULT_OK, gr.setLodLevelsCount(4));
+
+	char *description = zinc.scene.writeDescription();
+	EXPECT_NE(static_cast<char *>(0), description);
+	zinc.scene.removeAllGraphics();
+	EXPECT_EQ(RESULT_OK, zinc.scene.readDescription(description, true));
+	cmzn_deallocate(description);
+	gr = zinc.scene.getFirstGraphics().castSurfaces();
+	EXPECT_TRUE(gr.isValid());
+	EXPECT_EQ(4, gr.getLodLevelsCount());
+	EXPECT_DOUBLE_EQ(128.0, gr.getLodThreshold());
+
+	// points and streamlines do not depend on element divisions
+	Graphics otherGraphics[2] = { zinc.scene.createGraphicsPoints(), zinc.scene.createGraphicsStreamlines() };
+	for (int i = 0; i < 2; ++i)
+	{
+		EXPECT_TRUE(otherGraphics[i].isValid());
+		EXPECT_EQ(1, otherGraphics[i].getLodLevelsCount());
+		EXPECT_EQ(RESULT_ERROR_ARGUMENT, otherGraphics[i].setLodLevelsCount(2));
+		EXPECT_EQ(RESULT_OK, otherGraphics[i].setLodLevelsCount(1));
+		EXPECT_EQ(1, otherGraphics[i].getLodLevelsCount());
+	}
+}
+
+// Test node glyphs are updated in place when only a few node values change,
+// and fully rebuilt when nodes are added or removed
+TEST(ZincGraphics, pointsPartialUpdate)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(resourcePath("fieldmodule/two_cubes.exformat").c_str()));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	GraphicsPoints gr = zinc.scene.createGraphicsPoints();
+	EXPECT_TRUE(gr.isValid());
+	EXPECT_EQ(RESULT_OK, gr.setFieldDomainType(Field::DOMAIN_TYPE_NODES));
+	EXPECT_EQ(RESULT_OK, gr.setCoordinateField(coordinates));
+
+	const Scenefilter noScenefilter;
+	double minimums[3], maximums[3];
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noScenefilter, minimums, maximums));
+	EXPECT_DOUBLE_EQ(20.0, maximums[0]);
+	EXPECT_DOUBLE_EQ(10.0, maximums[1]);
+
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Node node3 = nodes.findNodeByIdentifier(3);
+	EXPECT_TRUE(node3.isValid());
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node3));
+	const double newX[3] = { 30.0, 0.0, 0.0 };
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 3, newX));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noScenefilter, minimums, maximums));
+	EXPECT_DOUBLE_EQ(30.0, maximums[0]);
+	EXPECT_DOUBLE_EQ(10.0, maximums[1]);
+
+	const double oldX[3] = { 20.0, 0.0, 0.0 };
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 3, oldX));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noScenefilter, minimums, maximums));
+	EXPECT_DOUBLE_EQ(20.0, maximums[0]);
+
+	// removing nodes falls back to a full rebuild
+	for (int i = 3; i <= 12; i += 3)
+		EXPECT_EQ(RESULT_OK, nodes.destroyNode(nodes.findNodeByIdentifier(i)));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noScenefilter, minimums, maximums));
+	EXPECT_DOUBLE_EQ(10.0, maximums[0]);
+	EXPECT_DOUBLE_EQ(10.0, maximums[1]);
+
+	// changes are still correct with vertex identifiers not stored
+	EXPECT_EQ(RESULT_OK, gr.setSelectMode(Graphics::SELECT_MODE_OFF));
+	Node node2 = nodes.findNodeByIdentifier(2);
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node2));
+	const double newY[3] = { 10.0, 25.0, 0.0 };
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 3, newY));
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(noScenefilter, minimums, maximums));
+	EXPECT_DOUBLE_EQ(10.0, maximums[0]);
+	EXPECT_DOUBLE_EQ(25.0, maximums[1]);
+}
+
+// test points on nodes built on multiple threads match those built serially,
+// including omitting nodes not in the subgroup
+TEST(ZincGraphics, pointsNumberOfThreads)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.context.setNumberOfThreads(4));
+	EXPECT_EQ(RESULT_OK, zinc.fm.beginChange());
+	FieldFiniteElement coordinates = zinc.fm.createFieldFiniteElement(3);
+	EXPECT_TRUE(coordinates.isValid());
+	EXPECT_EQ(RESULT_OK, coordinates.setName("coordinates"));
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_EQ(RESULT_OK, nodetemplate.defineField(coordinates));
+	FieldGroup group = zinc.fm.createFieldGroup();
+	NodesetGroup nodesetGroup = group.createNodesetGroup(nodes);
+	EXPECT_TRUE(nodesetGroup.isValid());
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const int nodesCount = 500;
+	for (int i = 1; i <= nodesCount; ++i)
+	{
+		Node node = nodes.createNode(i, nodetemplate);
+		EXPECT_TRUE(node.isValid());
+		EXPECT_EQ(RESULT_OK, fieldcache.setNode(node));
+		const double x[3] = { static_cast<double>(i), 0.01*i, -0.02*i };
+		EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 3, x));
+		// omit every 7th node and all beyond 400
+		if ((i % 7) && (i <= 400))
+		{
+			EXPECT_EQ(RESULT_OK, nodesetGroup.addNode(node));
+		}
+	}
+	EXPECT_EQ(RESULT_OK, zinc.fm.endChange());
+
+	const char *names[2] = { "serial", "threaded" };
+	GraphicsPoints points[2];
+	zinc.scene.beginChange();
+	for (int i = 0; i < 2; ++i)
+	{
+		points[i] = zinc.scene.createGraphicsPoints();
+		EXPECT_TRUE(points[i].isValid());
+		EXPECT_EQ(RESULT_OK, points[i].setName(names[i]));
+		EXPECT_EQ(RESULT_OK, points[i].setFieldDomainType(Field::DOMAIN_TYPE_NODES));
+		EXPECT_EQ(RESULT_OK, points[i].setCoordinateField(coordinates));
+		EXPECT_EQ(RESULT_OK, points[i].setDataField(coordinates));
+		EXPECT_EQ(RESULT_OK, points[i].setSubgroupField(group));
+	}
+	EXPECT_EQ(1, points[0].getNumberOfThreads());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, points[1].setNumberOfThreads(-1));
+	EXPECT_EQ(RESULT_OK, points[1].setNumberOfThreads(0));
+	EXPECT_EQ(0, points[1].getNumberOfThreads());
+	zinc.scene.endChange();
+
+	Scenefiltermodule scenefiltermodule = zinc.context.getScenefiltermodule();
+	double minimums[2][3], maximums[2][3];
+	for (int i = 0; i < 2; ++i)
+	{
+		Scenefilter filter = scenefiltermodule.createScenefilterGraphicsName(names[i]);
+		EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(filter, minimums[i], maximums[i]));
+	}
+	EXPECT_DOUBLE_EQ(1.0, minimums[0][0]);
+	EXPECT_DOUBLE_EQ(400.0, maximums[0][0]);
+	for (int c = 0; c < 3; ++c)
+	{
+		EXPECT_EQ(minimums[0][c], minimums[1][c]);
+		EXPECT_EQ(maximums[0][c], maximums[1][c]);
+	}
+	int vertexCounts[2];
+	for (int i = 0; i < 2; ++i)
+	{
+		for (int j = 0; j < 2; ++j)
+		{
+			EXPECT_EQ(RESULT_OK, points[j].setVisibilityFlag(i == j));
+		}
+		vertexCounts[i] = countWavefrontVertices(zinc.scene);
+	}
+	EXPECT_EQ(vertexCounts[0], vertexCounts[1]);
+}
+
+// Test surfaces are correct after partial rebuild appending new elements
+TEST(ZincGraphics, surfacesPartialRebuildAddElements)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(resourcePath("fieldmodule/two_cubes.exformat").c_str()));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	GraphicsSurfaces gr = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(gr.isValid());
+	EXPECT_EQ(RESULT_OK, gr.setCoordinateField(coordinates));
+	const int oldVertexCount = countWavefrontVertices(zinc.scene);
+	EXPECT_GT(oldVertexCount, 0);
+
+	// add bilinear faces across both cubes, one at a time as in interactive editing
+	Mesh mesh2d = zinc.fm.findMeshByDimension(2);
+	const int oldElementCount = mesh2d.getSize();
+	Elementbasis elementbasis = zinc.fm.createElementbasis(2, Elementbasis::FUNCTION_TYPE_LINEAR_LAGRANGE);
+	Elementfieldtemplate eft = mesh2d.createElementfieldtemplate(elementbasis);
+	Elementtemplate elementtemplate = mesh2d.createElementtemplate();
+	EXPECT_EQ(RESULT_OK, elementtemplate.setElementShapeType(Element::SHAPE_TYPE_SQUARE));
+	EXPECT_EQ(RESULT_OK, elementtemplate.defineField(coordinates, -1, eft));
+	const int nodeIdentifiers[2][4] = { { 1, 3, 10, 12 }, { 4, 6, 7, 9 } };
+	int vertexCount = oldVertexCount;
+	for (int e = 0; e < 2; ++e)
+	{
+		zinc.fm.beginChange();
+		Element element = mesh2d.createElement(-1, elementtemplate);
+		EXPECT_TRUE(element.isValid());
+		EXPECT_EQ(RESULT_OK, element.setNodesByIdentifier(eft, 4, nodeIdentifiers[e]));
+		zinc.fm.endChange();
+		const int newVertexCount = countWavefrontVertices(zinc.scene);
+		EXPECT_GT(newVertexCount, vertexCount);
+		vertexCount = newVertexCount;
+	}
+	EXPECT_EQ(oldElementCount + 2, mesh2d.getSize());
+
+	// compare with graphics built from scratch
+	EXPECT_EQ(RESULT_OK, zinc.scene.removeAllGraphics());
+	gr = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(gr.isValid());
+	EXPECT_EQ(RESULT_OK, gr.setCoordinateField(coordinates));
+	EXPECT_EQ(vertexCount, countWavefrontVertices(zinc.scene));
+}
+
 TEST(cmzn_graphics_api, texture_coordinate_field)
 {
 	ZincTestSetup zinc;
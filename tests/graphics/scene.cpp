@@ -33,6 +33,8 @@
 #include <cmlibs/zinc/fieldvectoroperators.hpp>
 #include <cmlibs/zinc/graphics.hpp>
 #include <cmlibs/zinc/material.hpp>
+#include <cmlibs/zinc/node.hpp>
+#include <cmlibs/zinc/nodeset.hpp>
 #include <cmlibs/zinc/scene.hpp>
 #include <cmlibs/zinc/types/scenecoordinatesystem.hpp>
 #include <cmlibs/zinc/scenefilter.hpp>
@@ -258,6 +260,51 @@ TEST(ZincScene, getSpectrumDataRange)
     ASSERT_DOUBLE_EQ(0.5, maximumValues[0]);
 }
 
+// test cached ranges of graphics are recalculated when graphics are rebuilt
+TEST(ZincScene, getCoordinatesRangeAfterChange)
+{
+    ZincTestSetupCpp zinc;
+    int result;
+
+    EXPECT_EQ(RESULT_OK, result = zinc.root_region.readFile(resourcePath("fieldmodule/cube.exformat").c_str()));
+    FieldFiniteElement coordinates = zinc.fm.findFieldByName("coordinates").castFiniteElement();
+    EXPECT_TRUE(coordinates.isValid());
+    GraphicsLines lines = zinc.scene.createGraphicsLines();
+    EXPECT_TRUE(lines.isValid());
+    EXPECT_EQ(RESULT_OK, result = lines.setCoordinateField(coordinates));
+
+    Scenefilter noFilter;
+    double minimums[3], maximums[3];
+    // second query uses cached range
+    for (int q = 0; q < 2; ++q)
+    {
+        EXPECT_EQ(RESULT_OK, result = zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+        for (int i = 0; i < 3; ++i)
+        {
+            EXPECT_DOUBLE_EQ(0.0, minimums[i]);
+            EXPECT_DOUBLE_EQ(1.0, maximums[i]);
+        }
+    }
+
+    Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+    Node node = nodes.findNodeByIdentifier(8);
+    EXPECT_TRUE(node.isValid());
+    Fieldcache fieldcache = zinc.fm.createFieldcache();
+    EXPECT_EQ(RESULT_OK, result = fieldcache.setNode(node));
+    const double x[3] = { 2.0, 1.5, 3.0 };
+    EXPECT_EQ(RESULT_OK, result = coordinates.assignReal(fieldcache, 3, x));
+    EXPECT_EQ(RESULT_OK, result = zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+    for (int i = 0; i < 3; ++i)
+    {
+        EXPECT_DOUBLE_EQ(0.0, minimums[i]);
+        EXPECT_DOUBLE_EQ(x[i], maximums[i]);
+    }
+
+    // range of graphics in other coordinate systems is not included
+    EXPECT_EQ(RESULT_OK, result = lines.setScenecoordinatesystem(SCENECOORDINATESYSTEM_WORLD));
+    EXPECT_EQ(RESULT_ERROR_NOT_FOUND, result = zinc.scene.getCoordinatesRange(noFilter, minimums, maximums));
+}
+
 TEST(cmzn_scene, visibility_flag)
 {
     ZincTestSetup zinc;
@@ -1058,6 +1105,98 @@ TEST(cmzn_scene, threejs_export_cpp)
     EXPECT_NE(static_cast<char *>(0), temp_char);
 }
 
+TEST(cmzn_scene, threejs_export_time_steps_threads)
+{
+    ZincTestSetupCpp zinc;
+
+    EXPECT_EQ(CMZN_OK, zinc.root_region.readFile(resourcePath("fieldmodule/cube.exformat").c_str()));
+    Timekeeper timekeeper = zinc.context.getTimekeepermodule().getDefaultTimekeeper();
+    Field timeValue = zinc.fm.createFieldTimeValue(timekeeper);
+    EXPECT_TRUE(timeValue.isValid());
+    const double one = 1.0;
+    Field scale = zinc.fm.createFieldConstant(1, &one) + timeValue;
+    Field coordinates = zinc.fm.findFieldByName("coordinates")*scale;
+    EXPECT_TRUE(coordinates.isValid());
+    GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+    EXPECT_TRUE(surfaces.isValid());
+    EXPECT_EQ(CMZN_OK, surfaces.setCoordinateField(coordinates));
+    EXPECT_EQ(CMZN_OK, zinc.context.setNumberOfThreads(4));
+
+    std::string serialOutput[2];
+    const int numbersOfThreads[3] = { 1, 0, 3 };
+    for (int t = 0; t < 3; ++t)
+    {
+        StreaminformationScene si = zinc.scene.createStreaminformationScene();
+        EXPECT_TRUE(si.isValid());
+        EXPECT_EQ(CMZN_OK, si.setIOFormat(si.IO_FORMAT_THREEJS));
+        EXPECT_EQ(1, si.getNumberOfThreads());
+        EXPECT_EQ(CMZN_ERROR_ARGUMENT, si.setNumberOfThreads(-1));
+        EXPECT_EQ(CMZN_OK, si.setNumberOfThreads(numbersOfThreads[t]));
+        EXPECT_EQ(numbersOfThreads[t], si.getNumberOfThreads());
+        EXPECT_EQ(CMZN_OK, si.setNumberOfTimeSteps(5));
+        EXPECT_EQ(CMZN_OK, si.setInitialTime(0.0));
+        EXPECT_EQ(CMZN_OK, si.setFinishTime(1.0));
+        EXPECT_EQ(2, si.getNumberOfResourcesRequired());
+        StreamresourceMemory memory_sr[2] = { si.createStreamresourceMemory(), si.createStreamresourceMemory() };
+        EXPECT_EQ(CMZN_OK, zinc.scene.write(si));
+        for (int r = 0; r < 2; ++r)
+        {
+            const char *memory_buffer = nullptr;
+            unsigned int size = 0;
+            EXPECT_EQ(CMZN_OK, memory_sr[r].getBuffer((const void**)&memory_buffer, &size));
+            const std::string output(memory_buffer, size);
+            if (t == 0)
+                serialOutput[r] = output;
+            else
+                EXPECT_EQ(serialOutput[r], output);
+        }
+    }
+    EXPECT_NE(std::string::npos, serialOutput[1].find("\"morphTargets\""));
+    EXPECT_NE(std::string::npos, serialOutput[1].find("\"morphNormals\""));
+}
+
+// lines with time varying node coordinates are built for all time steps concurrently
+TEST(cmzn_scene, threejs_export_time_steps_threads_lines)
+{
+    ZincTestSetupCpp zinc;
+
+    EXPECT_EQ(CMZN_OK, zinc.root_region.readFile(resourcePath("fieldio/node_time_sequence.exf").c_str()));
+    Field coordinates = zinc.fm.findFieldByName("coordinates");
+    EXPECT_TRUE(coordinates.isValid());
+    GraphicsLines lines = zinc.scene.createGraphicsLines();
+    EXPECT_TRUE(lines.isValid());
+    EXPECT_EQ(CMZN_OK, lines.setCoordinateField(coordinates));
+    EXPECT_EQ(CMZN_OK, zinc.context.setNumberOfThreads(4));
+
+    std::string serialOutput[2];
+    const int numbersOfThreads[3] = { 1, 0, 4 };
+    for (int t = 0; t < 3; ++t)
+    {
+        StreaminformationScene si = zinc.scene.createStreaminformationScene();
+        EXPECT_TRUE(si.isValid());
+        EXPECT_EQ(CMZN_OK, si.setIOFormat(si.IO_FORMAT_THREEJS));
+        EXPECT_EQ(CMZN_OK, si.setNumberOfThreads(numbersOfThreads[t]));
+        EXPECT_EQ(CMZN_OK, si.setNumberOfTimeSteps(6));
+        EXPECT_EQ(CMZN_OK, si.setInitialTime(0.0));
+        EXPECT_EQ(CMZN_OK, si.setFinishTime(5.0));
+        EXPECT_EQ(2, si.getNumberOfResourcesRequired());
+        StreamresourceMemory memory_sr[2] = { si.createStreamresourceMemory(), si.createStreamresourceMemory() };
+        EXPECT_EQ(CMZN_OK, zinc.scene.write(si));
+        for (int r = 0; r < 2; ++r)
+        {
+            const char *memory_buffer = nullptr;
+            unsigned int size = 0;
+            EXPECT_EQ(CMZN_OK, memory_sr[r].getBuffer((const void**)&memory_buffer, &size));
+            const std::string output(memory_buffer, size);
+            if (t == 0)
+                serialOutput[r] = output;
+            else
+                EXPECT_EQ(serialOutput[r], output);
+        }
+    }
+    EXPECT_NE(std::string::npos, serialOutput[1].find("\"morphTargets\""));
+}
+
 TEST(cmzn_scene, threejs_export_inline)
 {
     ZincTestSetup zinc;
@@ -1682,6 +1821,72 @@ TEST(cmzn_scene, stl_export_text)
     EXPECT_NE(static_cast<char *>(0), temp_char);
 }
 
+TEST(cmzn_scene, binary_stl_ply_export)
+{
+    ZincTestSetupCpp zinc;
+
+    EXPECT_EQ(CMZN_OK, zinc.root_region.readFile(resourcePath("fieldmodule/cube.exformat").c_str()));
+    GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+    EXPECT_TRUE(surfaces.isValid());
+    EXPECT_EQ(CMZN_OK, surfaces.setCoordinateField(zinc.fm.findFieldByName("coordinates")));
+
+    // get number of triangles from ASCII STL
+    StreaminformationScene si = zinc.scene.createStreaminformationScene();
+    EXPECT_EQ(CMZN_OK, si.setIOFormat(si.IO_FORMAT_ASCII_STL));
+    StreamresourceMemory asciiResource = si.createStreamresourceMemory();
+    EXPECT_EQ(CMZN_OK, zinc.scene.write(si));
+    const char *buffer = nullptr;
+    unsigned int size = 0;
+    EXPECT_EQ(CMZN_OK, asciiResource.getBuffer((const void**)&buffer, &size));
+    const std::string asciiStl(buffer, size);
+    unsigned int triangleCount = 0;
+    for (size_t pos = asciiStl.find("facet normal"); pos != std::string::npos;
+        pos = asciiStl.find("facet normal", pos + 1))
+        ++triangleCount;
+    EXPECT_EQ(12U, triangleCount);
+
+    si = zinc.scene.createStreaminformationScene();
+    EXPECT_EQ(CMZN_OK, si.setIOFormat(si.IO_FORMAT_BINARY_STL));
+    EXPECT_EQ(1, si.getNumberOfResourcesRequired());
+    StreamresourceMemory stlResource = si.createStreamresourceMemory();
+    EXPECT_EQ(CMZN_OK, zinc.scene.write(si));
+    EXPECT_EQ(CMZN_OK, stlResource.getBuffer((const void**)&buffer, &size));
+    EXPECT_EQ(84 + 50*triangleCount, size);
+    const unsigned char *countBytes = reinterpret_cast<const unsigned char *>(buffer) + 80;
+    EXPECT_EQ(triangleCount, static_cast<unsigned int>(countBytes[0] | (countBytes[1] << 8) |
+        (countBytes[2] << 16) | (countBytes[3] << 24)));
+
+    const char *vertexElement = "element vertex ";
+    const char *faceElement = "element face ";
+    const char *endHeader = "end_header\n";
+    for (int weld = 0; weld < 2; ++weld)
+    {
+        si = zinc.scene.createStreaminformationScene();
+        EXPECT_EQ(CMZN_OK, si.setIOFormat(si.IO_FORMAT_BINARY_PLY));
+        EXPECT_EQ(0, si.getOutputWeldVertices());
+        EXPECT_EQ(CMZN_OK, si.setOutputWeldVertices(weld));
+        EXPECT_EQ(weld, si.getOutputWeldVertices());
+        EXPECT_EQ(1, si.getNumberOfResourcesRequired());
+        StreamresourceMemory plyResource = si.createStreamresourceMemory();
+        EXPECT_EQ(CMZN_OK, zinc.scene.write(si));
+        EXPECT_EQ(CMZN_OK, plyResource.getBuffer((const void**)&buffer, &size));
+        const std::string ply(buffer, size);
+        EXPECT_EQ(0U, ply.find("ply\nformat binary_little_endian 1.0\n"));
+        const size_t vertexPos = ply.find(vertexElement);
+        const size_t facePos = ply.find(faceElement);
+        const size_t endPos = ply.find(endHeader);
+        EXPECT_NE(std::string::npos, vertexPos);
+        EXPECT_NE(std::string::npos, facePos);
+        EXPECT_NE(std::string::npos, endPos);
+        const unsigned int vertexCount = static_cast<unsigned int>(atoi(ply.c_str() + vertexPos + strlen(vertexElement)));
+        const unsigned int faceCount = static_cast<unsigned int>(atoi(ply.c_str() + facePos + strlen(faceElement)));
+        EXPECT_EQ(triangleCount, faceCount);
+        // welding merges the cube face vertices to its 8 corners
+        EXPECT_EQ(weld ? 8U : 3*triangleCount, vertexCount);
+        EXPECT_EQ(endPos + strlen(endHeader) + 12*vertexCount + 13*faceCount, size);
+    }
+}
+
 TEST(cmzn_scene, stl_export_empty_points_crash)
 {
     ZincTestSetupCpp zinc;
@@ -15,6 +15,14 @@
 #include <cmlibs/zinc/context.hpp>
 #include <cmlibs/zinc/light.hpp>
 #include <cmlibs/zinc/sceneviewer.hpp>
+#if defined (ZINC_USE_OSMESA)
+#include <cmlibs/zinc/field.hpp>
+#include <cmlibs/zinc/fieldmodule.hpp>
+#include <cmlibs/zinc/glyph.hpp>
+#include <cmlibs/zinc/graphics.hpp>
+#include <GL/osmesa.h>
+#include <vector>
+#endif /* defined (ZINC_USE_OSMESA) */
 
 #include "utilities/testenum.hpp"
 #include "zinctestsetup.hpp"
@@ -587,6 +595,19 @@ TEST(ZincSceneviewer, get_set)
 	// negative timeout disables incremental build
 	EXPECT_EQ(OK, sv.setRenderTimeout(-1.0));
 	ASSERT_DOUBLE_EQ(-1.0, value = sv.getRenderTimeout());
+
+	ASSERT_DOUBLE_EQ(256.0, value = sv.getLodMemoryBudget());
+	EXPECT_EQ(ERROR_ARGUMENT, sv.setLodMemoryBudget(-1.0));
+	EXPECT_EQ(OK, sv.setLodMemoryBudget(64.0));
+	ASSERT_DOUBLE_EQ(64.0, value = sv.getLodMemoryBudget());
+
+	EXPECT_TRUE(sv.getShowPartialGraphicsFlag());
+	EXPECT_EQ(OK, sv.setShowPartialGraphicsFlag(false));
+	EXPECT_FALSE(sv.getShowPartialGraphicsFlag());
+
+	EXPECT_FALSE(sv.getBuildInBackgroundFlag());
+	EXPECT_EQ(OK, sv.setBuildInBackgroundFlag(true));
+	EXPECT_TRUE(sv.getBuildInBackgroundFlag());
 }
 
 class mySceneviewercallback : public Sceneviewercallback
@@ -725,3 +746,84 @@ TEST(ZincSceneviewer, TransparencyModeEnum)
 	const char *enumNames[4] = { nullptr, "FAST", "SLOW", "ORDER_INDEPENDENT" };
 	testEnum(4, enumNames, Sceneviewer::TransparencyModeEnumToString, Sceneviewer::TransparencyModeEnumFromString);
 }
+
+#if defined (ZINC_USE_OSMESA)
+
+namespace {
+
+/** Render scene viewer into current OSMesa buffer, return sum of RGB values. */
+unsigned long renderBrightness(Sceneviewer& sv, const std::vector<GLubyte>& buffer)
+{
+	EXPECT_EQ(RESULT_OK, sv.renderScene());
+	glFinish();
+	unsigned long brightness = 0;
+	for (size_t i = 0; i < buffer.size(); i += 4)
+		brightness += buffer[i] + buffer[i + 1] + buffer[i + 2];
+	return brightness;
+}
+
+}
+
+// Test glyphs, drawn instanced where supported, are lit by all scene viewer
+// lights and not only the first, for one and two-sided lighting
+TEST(ZincSceneviewer, renderGlyphsMultipleLights)
+{
+	ZincTestSetupCpp zinc;
+
+	const int size = 64;
+	OSMesaContext osmesaContext = OSMesaCreateContextExt(OSMESA_RGBA, 24, 0, 0, NULL);
+	ASSERT_NE(static_cast<OSMesaContext>(NULL), osmesaContext);
+	std::vector<GLubyte> buffer(size*size*4);
+	ASSERT_TRUE(OSMesaMakeCurrent(osmesaContext, buffer.data(), GL_UNSIGNED_BYTE, size, size));
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(resourcePath("fieldmodule/cube.exformat").c_str()));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	GraphicsPoints points = zinc.scene.createGraphicsPoints();
+	EXPECT_TRUE(points.isValid());
+	EXPECT_EQ(RESULT_OK, points.setFieldDomainType(Field::DOMAIN_TYPE_NODES));
+	EXPECT_EQ(RESULT_OK, points.setCoordinateField(coordinates));
+	Graphicspointattributes pointAttributes = points.getGraphicspointattributes();
+	EXPECT_EQ(RESULT_OK, pointAttributes.setGlyphShapeType(Glyph::SHAPE_TYPE_SPHERE));
+	const double baseSize = 0.4;
+	EXPECT_EQ(RESULT_OK, pointAttributes.setBaseSize(1, &baseSize));
+
+	Sceneviewer sv = zinc.context.getSceneviewermodule().createSceneviewer(
+		Sceneviewer::BUFFERING_MODE_SINGLE, Sceneviewer::STEREO_MODE_DEFAULT);
+	EXPECT_TRUE(sv.isValid());
+	EXPECT_EQ(RESULT_OK, sv.setScene(zinc.scene));
+	EXPECT_EQ(RESULT_OK, sv.setViewportSize(size, size));
+	EXPECT_EQ(RESULT_OK, sv.viewAll());
+
+	// replace default lights with a black first light
+	Lightmodule lightmodule = zinc.context.getLightmodule();
+	EXPECT_EQ(RESULT_OK, sv.removeLight(lightmodule.getDefaultLight()));
+	EXPECT_EQ(RESULT_OK, sv.removeLight(lightmodule.getDefaultAmbientLight()));
+	const double black[3] = { 0.0, 0.0, 0.0 };
+	const double white[3] = { 1.0, 1.0, 1.0 };
+	const double direction[3] = { 0.0, 0.0, -1.0 };
+	Light darkLight = lightmodule.createLight();
+	EXPECT_EQ(RESULT_OK, darkLight.setName("a_dark"));
+	EXPECT_EQ(RESULT_OK, darkLight.setType(Light::TYPE_DIRECTIONAL));
+	EXPECT_EQ(RESULT_OK, darkLight.setColourRGB(black));
+	EXPECT_EQ(RESULT_OK, darkLight.setDirection(direction));
+	EXPECT_EQ(RESULT_OK, sv.addLight(darkLight));
+	const unsigned long darkBrightness = renderBrightness(sv, buffer);
+
+	Light brightLight = lightmodule.createLight();
+	EXPECT_EQ(RESULT_OK, brightLight.setName("b_bright"));
+	EXPECT_EQ(RESULT_OK, brightLight.setType(Light::TYPE_DIRECTIONAL));
+	EXPECT_EQ(RESULT_OK, brightLight.setColourRGB(white));
+	EXPECT_EQ(RESULT_OK, brightLight.setDirection(direction));
+	EXPECT_EQ(RESULT_OK, sv.addLight(brightLight));
+	for (int twoSided = 0; twoSided < 2; ++twoSided)
+	{
+		EXPECT_EQ(RESULT_OK, sv.setLightingTwoSided(0 != twoSided));
+		const unsigned long brightness = renderBrightness(sv, buffer);
+		EXPECT_GT(brightness, darkBrightness + 255*size);
+	}
+
+	OSMesaDestroyContext(osmesaContext);
+}
+
+#endif /* defined (ZINC_USE_OSMESA) */
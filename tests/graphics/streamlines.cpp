@@ -20,8 +20,20 @@
 
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
+#include "cmlibs/zinc/element.hpp"
 #include "cmlibs/zinc/fieldconstant.hpp"
 #include "cmlibs/zinc/graphics.hpp"
+#include "cmlibs/zinc/region.hpp"
+#include "cmlibs/zinc/result.hpp"
+#include "cmlibs/zinc/scene.hpp"
+#include "cmlibs/zinc/scenefilter.hpp"
+#include "cmlibs/zinc/stream.hpp"
+#include "cmlibs/zinc/streamscene.hpp"
+#include "cmlibs/zinc/tessellation.hpp"
+
+#include "test_resources.h"
+
+#include <string>
 
 TEST(cmzn_graphics_streamlines, create_cast)
 {
@@ -210,3 +222,107 @@ TEST(cmzn_graphics_streamlines, track_length_cpp)
 	EXPECT_EQ(CMZN_OK, st.setTrackLength(trackLength));
 	EXPECT_DOUBLE_EQ(trackLength, st.getTrackLength());
 }
+
+TEST(cmzn_graphics_streamlines, number_of_threads)
+{
+	ZincTestSetup zinc;
+
+	cmzn_graphics_id gr = cmzn_scene_create_graphics_streamlines(zinc.scene);
+	cmzn_graphics_streamlines_id st = cmzn_graphics_cast_streamlines(gr);
+	cmzn_graphics_destroy(&gr);
+	EXPECT_NE(static_cast<cmzn_graphics_streamlines *>(0), st);
+
+	EXPECT_EQ(1, cmzn_graphics_streamlines_get_number_of_threads(st));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_streamlines_set_number_of_threads(st, 4));
+	EXPECT_EQ(4, cmzn_graphics_streamlines_get_number_of_threads(st));
+	EXPECT_EQ(CMZN_OK, cmzn_graphics_streamlines_set_number_of_threads(st, 0));
+	EXPECT_EQ(0, cmzn_graphics_streamlines_get_number_of_threads(st));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_graphics_streamlines_set_number_of_threads(st, -1));
+	EXPECT_EQ(0, cmzn_graphics_streamlines_get_number_of_threads(st));
+	EXPECT_EQ(-1, cmzn_graphics_streamlines_get_number_of_threads(static_cast<cmzn_graphics_streamlines_id>(0)));
+
+	cmzn_graphics_streamlines_destroy(&st);
+}
+
+// test streamlines tracked on multiple threads match those tracked serially
+TEST(ZincGraphicsStreamlines, numberOfThreads)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(resourcePath("fieldmodule/two_cubes_hermite_nocross.ex2").c_str()));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	const double vectorValues[3] = { 1.0, 0.2, -0.1 };
+	Field streamVector = zinc.fm.createFieldConstant(3, vectorValues);
+	EXPECT_TRUE(streamVector.isValid());
+
+	Tessellation tessellation = zinc.context.getTessellationmodule().createTessellation();
+	const int three = 3;
+	EXPECT_EQ(RESULT_OK, tessellation.setMinimumDivisions(1, &three));
+
+	GraphicsStreamlines streamlines[2];
+	const char *names[2] = { "serial", "threaded" };
+	zinc.scene.beginChange();
+	for (int i = 0; i < 2; ++i)
+	{
+		streamlines[i] = zinc.scene.createGraphicsStreamlines();
+		EXPECT_TRUE(streamlines[i].isValid());
+		EXPECT_EQ(RESULT_OK, streamlines[i].setName(names[i]));
+		EXPECT_EQ(RESULT_OK, streamlines[i].setCoordinateField(coordinates));
+		EXPECT_EQ(RESULT_OK, streamlines[i].setStreamVectorField(streamVector));
+		EXPECT_EQ(RESULT_OK, streamlines[i].setTessellation(tessellation));
+		EXPECT_EQ(RESULT_OK, streamlines[i].setTrackLength(1.5));
+		EXPECT_EQ(RESULT_OK, streamlines[i].setColourDataType(GraphicsStreamlines::COLOUR_DATA_TYPE_TRAVEL_TIME));
+		Graphicssamplingattributes sampling = streamlines[i].getGraphicssamplingattributes();
+		EXPECT_EQ(RESULT_OK, sampling.setElementPointSamplingMode(Element::POINT_SAMPLING_MODE_CELL_CORNERS));
+	}
+	EXPECT_EQ(RESULT_OK, zinc.context.setNumberOfThreads(4));
+	EXPECT_EQ(RESULT_OK, streamlines[1].setNumberOfThreads(4));
+	EXPECT_EQ(4, streamlines[1].getNumberOfThreads());
+	zinc.scene.endChange();
+
+	Scenefiltermodule scenefiltermodule = zinc.context.getScenefiltermodule();
+	double minimums[2][3], maximums[2][3];
+	std::string geometry[2];
+	for (int i = 0; i < 2; ++i)
+	{
+		Scenefilter filter = scenefiltermodule.createScenefilterGraphicsName(names[i]);
+		EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(filter, minimums[i], maximums[i]));
+		// export vertex lists to check order and merging of tracks
+		StreaminformationScene si = zinc.scene.createStreaminformationScene();
+		EXPECT_EQ(RESULT_OK, si.setIOFormat(si.IO_FORMAT_THREEJS));
+		EXPECT_EQ(RESULT_OK, si.setScenefilter(filter));
+		EXPECT_EQ(2, si.getNumberOfResourcesRequired());
+		StreamresourceMemory metadataResource = si.createStreamresourceMemory();
+		StreamresourceMemory geometryResource = si.createStreamresourceMemory();
+		EXPECT_EQ(RESULT_OK, zinc.scene.write(si));
+		const char *buffer = nullptr;
+		unsigned int size = 0;
+		EXPECT_EQ(RESULT_OK, geometryResource.getBuffer((const void**)&buffer, &size));
+		geometry[i].assign(buffer, size);
+	}
+	for (int c = 0; c < 3; ++c)
+	{
+		EXPECT_LT(minimums[0][c], maximums[0][c]);
+		EXPECT_EQ(minimums[0][c], minimums[1][c]);
+		EXPECT_EQ(maximums[0][c], maximums[1][c]);
+	}
+	const char *arrayNames[3] = { "\"vertices\"", "\"faces\"", "\"colors\"" };
+	for (int a = 0; a < 3; ++a)
+	{
+		std::string arrays[2];
+		for (int i = 0; i < 2; ++i)
+		{
+			const size_t start = geometry[i].find(arrayNames[a]);
+			if (start != std::string::npos)
+			{
+				arrays[i] = geometry[i].substr(start, geometry[i].find(']', start) - start);
+			}
+		}
+		if (a == 0)
+		{
+			EXPECT_FALSE(arrays[0].empty());
+		}
+		EXPECT_EQ(arrays[0], arrays[1]);
+	}
+}
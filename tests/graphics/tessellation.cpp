@@ -12,6 +12,13 @@
 #include <cmlibs/zinc/core.h>
 #include <cmlibs/zinc/tessellation.h>
 
+#include "cmlibs/zinc/changemanager.hpp"
+#include "cmlibs/zinc/fieldarithmeticoperators.hpp"
+#include "cmlibs/zinc/fieldcomposite.hpp"
+#include "cmlibs/zinc/fieldconstant.hpp"
+#include "cmlibs/zinc/fieldtrigonometry.hpp"
+#include "cmlibs/zinc/graphics.hpp"
+#include "cmlibs/zinc/scenefilter.hpp"
 #include "cmlibs/zinc/tessellation.hpp"
 
 #include "zinctestsetup.hpp"
@@ -204,6 +211,14 @@ TEST(cmzn_tessellation_api, valid_args)
 	for (int i = 0; i < 3; ++i)
 		EXPECT_EQ(inValues[i], outValues[i]);
 
+	EXPECT_EQ(0.0, cmzn_tessellation_get_adaptive_tolerance(tessellation));
+	EXPECT_EQ(CMZN_OK, cmzn_tessellation_set_adaptive_tolerance(tessellation, 0.01));
+	EXPECT_EQ(0.01, cmzn_tessellation_get_adaptive_tolerance(tessellation));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_tessellation_set_adaptive_tolerance(tessellation, -0.1));
+	EXPECT_EQ(0.01, cmzn_tessellation_get_adaptive_tolerance(tessellation));
+	EXPECT_EQ(CMZN_ERROR_ARGUMENT, cmzn_tessellation_set_adaptive_tolerance(0, 0.01));
+	EXPECT_EQ(0.0, cmzn_tessellation_get_adaptive_tolerance(0));
+
 	cmzn_tessellation_destroy(&tessellation);
 
 	cmzn_tessellationmodule_destroy(&tm);
@@ -257,6 +272,11 @@ TEST(cmzn_tessellation_api, valid_args_cpp)
 	for (int i = 0; i < 3; ++i)
 		EXPECT_EQ(inValues[i], outValues[i]);
 
+	EXPECT_EQ(0.0, tessellation.getAdaptiveTolerance());
+	EXPECT_EQ(CMZN_OK, tessellation.setAdaptiveTolerance(0.01));
+	EXPECT_EQ(0.01, tessellation.getAdaptiveTolerance());
+	EXPECT_EQ(CMZN_OK, tessellation.setAdaptiveTolerance(0.0));
+	EXPECT_EQ(0.0, tessellation.getAdaptiveTolerance());
 }
 
 
@@ -308,11 +328,77 @@ TEST(cmzn_tessellation_api, description_io_cpp)
 	EXPECT_EQ(5, intValues[1]);
 	EXPECT_EQ(7, intValues[2]);
 
+	EXPECT_EQ(0.0, tessellation.getAdaptiveTolerance());
+	EXPECT_EQ(CMZN_OK, tessellation.setAdaptiveTolerance(0.02));
+
 	char *return_string = tm.writeDescription();
 	EXPECT_TRUE(return_string != 0);
+	EXPECT_EQ(CMZN_OK, tessellation.setAdaptiveTolerance(0.0));
+	EXPECT_EQ(CMZN_OK, tm.readDescription(return_string));
+	EXPECT_EQ(0.02, tessellation.getAdaptiveTolerance());
 	cmzn_deallocate(return_string);
 }
 
+// test adaptive tessellation only refines surfaces where the geometry is curved
+TEST(ZincTessellation, adaptiveSurfaces)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(resourcePath("fieldmodule/two_cubes.exformat").c_str()));
+	EXPECT_EQ(RESULT_OK, zinc.fm.defineAllFaces());
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	// warp z by a sine wave in x
+	Field warped;
+	{
+		ChangeManager<Fieldmodule> changeFields(zinc.fm);
+		FieldComponent x = zinc.fm.createFieldComponent(coordinates, 1);
+		const int xyComponents[2] = { 1, 2 };
+		FieldComponent xy = zinc.fm.createFieldComponent(coordinates, 2, xyComponents);
+		FieldComponent z = zinc.fm.createFieldComponent(coordinates, 3);
+		const double frequencyValue = 0.3;
+		FieldConstant frequency = zinc.fm.createFieldConstant(1, &frequencyValue);
+		const double amplitudeValue = 2.0;
+		FieldConstant amplitude = zinc.fm.createFieldConstant(1, &amplitudeValue);
+		Field wave = amplitude*zinc.fm.createFieldSin(x*frequency);
+		const Field sourceFields[2] = { xy, z + wave };
+		warped = zinc.fm.createFieldConcatenate(2, sourceFields);
+		EXPECT_TRUE(warped.isValid());
+	}
+
+	Tessellation tessellation = zinc.context.getTessellationmodule().getDefaultTessellation();
+	const int number1 = 1;
+	const int number8 = 8;
+	EXPECT_EQ(RESULT_OK, tessellation.setMinimumDivisions(1, &number1));
+	EXPECT_EQ(RESULT_OK, tessellation.setRefinementFactors(1, &number8));
+
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_EQ(RESULT_OK, surfaces.setCoordinateField(warped));
+	// 11 faces each with 9x9 vertices
+	EXPECT_EQ(891, countWavefrontVertices(zinc.scene));
+	double uniformMinimums[3], uniformMaximums[3];
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(Scenefilter(), uniformMinimums, uniformMaximums));
+
+	EXPECT_EQ(RESULT_OK, tessellation.setAdaptiveTolerance(0.001));
+	const int adaptiveCount = countWavefrontVertices(zinc.scene);
+	// flat faces normal to x are not refined, others only in x
+	EXPECT_LT(adaptiveCount, 891);
+	EXPECT_GT(adaptiveCount, 44);
+	double adaptiveMinimums[3], adaptiveMaximums[3];
+	EXPECT_EQ(RESULT_OK, zinc.scene.getCoordinatesRange(Scenefilter(), adaptiveMinimums, adaptiveMaximums));
+	for (int c = 0; c < 2; ++c)
+	{
+		EXPECT_DOUBLE_EQ(uniformMinimums[c], adaptiveMinimums[c]);
+		EXPECT_DOUBLE_EQ(uniformMaximums[c], adaptiveMaximums[c]);
+	}
+
+	// coarser tolerance gives fewer vertices
+	EXPECT_EQ(RESULT_OK, tessellation.setAdaptiveTolerance(0.05));
+	EXPECT_LT(countWavefrontVertices(zinc.scene), adaptiveCount);
+}
+
 
 TEST(ZincTessellationiterator, iteration)
 {
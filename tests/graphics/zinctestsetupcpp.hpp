@@ -18,6 +18,7 @@
 #include <cmlibs/zinc/fieldmodule.hpp>
 #include <cmlibs/zinc/glyph.hpp>
 #include <cmlibs/zinc/scene.hpp>
+#include <cmlibs/zinc/streamscene.hpp>
 
 using namespace CMLibs::Zinc;
 
@@ -49,4 +50,22 @@ public:
 	}
 };
 
+/** Export scene in wavefront format and return number of vertices written. */
+inline int countWavefrontVertices(Scene& scene)
+{
+	StreaminformationScene si = scene.createStreaminformationScene();
+	EXPECT_EQ(RESULT_OK, si.setIOFormat(si.IO_FORMAT_WAVEFRONT));
+	StreamresourceMemory memory_sr1 = si.createStreamresourceMemory();
+	StreamresourceMemory memory_sr2 = si.createStreamresourceMemory();
+	EXPECT_EQ(RESULT_OK, scene.write(si));
+	const char *memory_buffer = nullptr;
+	unsigned int size = 0;
+	EXPECT_EQ(RESULT_OK, memory_sr2.getBuffer((const void**)&memory_buffer, &size));
+	int count = 0;
+	for (unsigned int i = 0; (i + 1) < size; ++i)
+		if (((i == 0) || (memory_buffer[i - 1] == '\n')) && (memory_buffer[i] == 'v') && (memory_buffer[i + 1] == ' '))
+			++count;
+	return count;
+}
+
 #endif // __ZINCTESTSETUPCPP_HPP__
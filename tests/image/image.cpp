@@ -182,6 +182,95 @@ TEST(ZincFieldImage, issue_3707_keep_attributes_after_read_image)
 	ASSERT_DOUBLE_EQ(2.2, depth = im.getTextureCoordinateDepth());
 }
 
+// Test reading raw 3-D image into out-of-core chunks loaded when sampled,
+// and evaluating it at coarser chunk levels
+TEST(ZincFieldImage, readChunked)
+{
+	// memory buffer is not copied so must outlive the image field
+	const int size = 8;
+	unsigned char buffer[size*size*size];
+	for (int z = 0; z < size; ++z)
+		for (int y = 0; y < size; ++y)
+			for (int x = 0; x < size; ++x)
+				buffer[(z*size + y)*size + x] = static_cast<unsigned char>(2*x + 4*y + 8*z);
+
+	ZincTestSetupCpp zinc;
+
+	FieldImage im = zinc.fm.createFieldImage();
+	EXPECT_TRUE(im.isValid());
+	EXPECT_EQ(0, im.getNumberOfChunkLevels());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, im.setChunkLevel(1));
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, im.setChunkMemoryBudget(1));
+
+	StreaminformationImage si = im.createStreaminformationImage();
+	EXPECT_TRUE(si.isValid());
+	EXPECT_EQ(RESULT_OK, si.setAttributeInteger(StreaminformationImage::ATTRIBUTE_RAW_WIDTH_PIXELS, size));
+	EXPECT_EQ(RESULT_OK, si.setAttributeInteger(StreaminformationImage::ATTRIBUTE_RAW_HEIGHT_PIXELS, size));
+	EXPECT_EQ(RESULT_OK, si.setAttributeInteger(StreaminformationImage::ATTRIBUTE_RAW_DEPTH_PIXELS, size));
+	EXPECT_EQ(RESULT_OK, si.setAttributeInteger(StreaminformationImage::ATTRIBUTE_BITS_PER_COMPONENT, 8));
+	EXPECT_EQ(RESULT_OK, si.setPixelFormat(StreaminformationImage::PIXEL_FORMAT_LUMINANCE));
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, si.setAttributeInteger(StreaminformationImage::ATTRIBUTE_CHUNK_SIZE_PIXELS, 2));
+	EXPECT_EQ(RESULT_OK, si.setAttributeInteger(StreaminformationImage::ATTRIBUTE_CHUNK_SIZE_PIXELS, 4));
+	EXPECT_EQ(RESULT_OK, si.setAttributeInteger(StreaminformationImage::ATTRIBUTE_CHUNK_MEMORY_BUDGET_MEGABYTES, 1));
+	Streamresource sr = si.createStreamresourceMemoryBuffer(buffer, sizeof(buffer));
+	EXPECT_TRUE(sr.isValid());
+	EXPECT_EQ(RESULT_OK, im.read(si));
+
+	EXPECT_EQ(1, im.getNumberOfComponents());
+	EXPECT_EQ(size, im.getWidthInPixels());
+	EXPECT_EQ(size, im.getHeightInPixels());
+	EXPECT_EQ(size, im.getDepthInPixels());
+	EXPECT_EQ(4, im.getNumberOfChunkLevels());
+	EXPECT_EQ(0, im.getChunkLevel());
+	EXPECT_EQ(1, im.getChunkMemoryBudget());
+	EXPECT_EQ(RESULT_OK, im.setChunkMemoryBudget(2));
+	EXPECT_EQ(2, im.getChunkMemoryBudget());
+
+	Field domainField = im.getDomainField();
+	EXPECT_TRUE(domainField.isValid());
+	Fieldcache cache = zinc.fm.createFieldcache();
+	double coordinates[3], value;
+	// sample pixel centres with default nearest filter mode
+	for (int z = 0; z < size; z += 3)
+		for (int y = 0; y < size; y += 3)
+			for (int x = 0; x < size; ++x)
+			{
+				coordinates[0] = (x + 0.5)/size;
+				coordinates[1] = (y + 0.5)/size;
+				coordinates[2] = (z + 0.5)/size;
+				EXPECT_EQ(RESULT_OK, cache.setFieldReal(domainField, 3, coordinates));
+				EXPECT_EQ(RESULT_OK, im.evaluateReal(cache, 1, &value));
+				EXPECT_NEAR((2*x + 4*y + 8*z)/255.0, value, 1.0E-12);
+			}
+
+	// level 1 averages 2x2x2 pixels of level 0 and spans the same coordinates
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, im.setChunkLevel(4));
+	EXPECT_EQ(RESULT_OK, im.setChunkLevel(1));
+	EXPECT_EQ(1, im.getChunkLevel());
+	const int levelSize = size/2;
+	EXPECT_EQ(levelSize, im.getWidthInPixels());
+	EXPECT_EQ(levelSize, im.getHeightInPixels());
+	EXPECT_EQ(levelSize, im.getDepthInPixels());
+	for (int z = 0; z < levelSize; ++z)
+		for (int y = 0; y < levelSize; ++y)
+			for (int x = 0; x < levelSize; ++x)
+			{
+				coordinates[0] = (x + 0.5)/levelSize;
+				coordinates[1] = (y + 0.5)/levelSize;
+				coordinates[2] = (z + 0.5)/levelSize;
+				EXPECT_EQ(RESULT_OK, cache.setFieldReal(domainField, 3, coordinates));
+				EXPECT_EQ(RESULT_OK, im.evaluateReal(cache, 1, &value));
+				EXPECT_NEAR((4*x + 8*y + 16*z + 7)/255.0, value, 1.0E-12);
+			}
+
+	// coarsest level is the average of the whole image
+	EXPECT_EQ(RESULT_OK, im.setChunkLevel(3));
+	EXPECT_EQ(1, im.getWidthInPixels());
+	EXPECT_EQ(RESULT_OK, cache.setFieldReal(domainField, 3, coordinates));
+	EXPECT_EQ(RESULT_OK, im.evaluateReal(cache, 1, &value));
+	EXPECT_NEAR(49.0/255.0, value, 1.0E-12);
+}
+
 TEST(cmzn_fieldmodule_create_image, analyze_bigendian)
 {
 	ZincTestSetup zinc;
@@ -9,10 +9,21 @@
 #include <gtest/gtest.h>
 
 #include "cmlibs/zinc/core.h"
+#include "cmlibs/zinc/element.hpp"
+#include "cmlibs/zinc/fieldarithmeticoperators.hpp"
+#include "cmlibs/zinc/fieldcache.hpp"
 #include "cmlibs/zinc/fieldconstant.hpp"
+#include "cmlibs/zinc/fieldvectoroperators.hpp"
+#include "cmlibs/zinc/mesh.hpp"
+#include "cmlibs/zinc/node.hpp"
+#include "cmlibs/zinc/nodeset.hpp"
+#include "cmlibs/zinc/nodetemplate.hpp"
 
+#include "test_resources.h"
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
+#include <thread>
+#include <vector>
 
 TEST(cmzn_region, build_tree)
 {
@@ -335,13 +346,16 @@ class FieldmodulecallbackRecordChange : public Fieldmodulecallback
 {
 public:
 	Fieldmoduleevent lastEvent;
+	int eventCount;
 
-	FieldmodulecallbackRecordChange()
+	FieldmodulecallbackRecordChange() :
+		eventCount(0)
 	{ }
 
 	virtual void operator()(const Fieldmoduleevent& event)
 	{
 		this->lastEvent = event;
+		++(this->eventCount);
 	}
 };
 
@@ -394,3 +408,216 @@ TEST(ZincRegion, HierarchicalChangeManager)
 	}
 	EXPECT_EQ(Field::CHANGE_FLAG_ADD, change = recordChange.lastEvent.getSummaryFieldChangeFlags());
 }
+
+TEST(ZincRegiontransaction, commit)
+{
+	ZincTestSetupCpp zinc;
+
+	Region region = zinc.fm.getRegion();
+	Region child = region.createChild("child");
+	EXPECT_TRUE(child.isValid());
+	Fieldmodule childFm = child.getFieldmodule();
+	Fieldmodulenotifier notifier = childFm.createFieldmodulenotifier();
+	EXPECT_TRUE(notifier.isValid());
+	FieldmodulecallbackRecordChange recordChange;
+	EXPECT_EQ(RESULT_OK, notifier.setCallback(recordChange));
+	Regionnotifier regionnotifier = region.createRegionnotifier();
+	EXPECT_TRUE(regionnotifier.isValid());
+	RegioncallbackRecordChange regionChange;
+	EXPECT_EQ(RESULT_OK, regionnotifier.setCallback(regionChange));
+
+	Regiontransaction transaction = region.createRegiontransaction();
+	EXPECT_TRUE(transaction.isValid());
+	EXPECT_FALSE(transaction.isCommitted());
+	const double valueOne = 1.0;
+	for (int i = 0; i < 10; ++i)
+	{
+		FieldConstant one = childFm.createFieldConstant(1, &valueOne);
+		EXPECT_EQ(RESULT_OK, one.setManaged(true));
+	}
+	Region child2 = region.createChild("child2");
+	EXPECT_TRUE(child2.isValid());
+	EXPECT_EQ(0, recordChange.eventCount);
+	EXPECT_EQ(0, regionChange.changeCount);
+	EXPECT_EQ(0.0, transaction.getTiming(Regiontransaction::TIMING_TOTAL));
+
+	// one merged event per notifier
+	EXPECT_EQ(RESULT_OK, transaction.commit());
+	EXPECT_TRUE(transaction.isCommitted());
+	EXPECT_EQ(1, recordChange.eventCount);
+	EXPECT_EQ(Field::CHANGE_FLAG_ADD, recordChange.lastEvent.getSummaryFieldChangeFlags());
+	EXPECT_EQ(1, regionChange.changeCount);
+	EXPECT_LE(1, transaction.getNumberOfFieldmoduleevents());
+	EXPECT_EQ(1, transaction.getNumberOfRegionevents());
+	const double totalTime = transaction.getTiming(Regiontransaction::TIMING_TOTAL);
+	EXPECT_LT(0.0, totalTime);
+	EXPECT_LE(0.0, transaction.getTiming(Regiontransaction::TIMING_FIELD_CHANGES));
+	EXPECT_LE(transaction.getTiming(Regiontransaction::TIMING_FIELD_CHANGES) +
+		transaction.getTiming(Regiontransaction::TIMING_FIELDMODULE_CALLBACKS) +
+		transaction.getTiming(Regiontransaction::TIMING_REGION_CALLBACKS), totalTime*1.000001);
+	EXPECT_EQ(0.0, transaction.getTiming(Regiontransaction::TIMING_INVALID));
+	EXPECT_EQ(RESULT_ERROR_ALREADY_EXISTS, transaction.commit());
+
+	// nested in hierarchical change: notifications deferred to outer end
+	EXPECT_EQ(RESULT_OK, region.beginHierarchicalChange());
+	Regiontransaction transaction2 = region.createRegiontransaction();
+	FieldConstant two = childFm.createFieldConstant(1, &valueOne);
+	EXPECT_EQ(RESULT_OK, two.setManaged(true));
+	EXPECT_EQ(RESULT_OK, transaction2.commit());
+	EXPECT_EQ(0.0, transaction2.getTiming(Regiontransaction::TIMING_TOTAL));
+	EXPECT_EQ(0, transaction2.getNumberOfFieldmoduleevents());
+	EXPECT_EQ(1, recordChange.eventCount);
+	EXPECT_EQ(RESULT_OK, region.endHierarchicalChange());
+	EXPECT_EQ(2, recordChange.eventCount);
+
+	// nested in change on ancestor region: timings not recorded
+	EXPECT_EQ(RESULT_OK, region.beginChange());
+	Regiontransaction childTransaction = child.createRegiontransaction();
+	FieldConstant four = childFm.createFieldConstant(1, &valueOne);
+	EXPECT_EQ(RESULT_OK, four.setManaged(true));
+	EXPECT_EQ(RESULT_OK, childTransaction.commit());
+	EXPECT_TRUE(childTransaction.isCommitted());
+	EXPECT_EQ(0.0, childTransaction.getTiming(Regiontransaction::TIMING_TOTAL));
+	EXPECT_EQ(0, childTransaction.getNumberOfFieldmoduleevents());
+	EXPECT_EQ(RESULT_OK, region.endChange());
+	const int eventCount = recordChange.eventCount;
+
+	// change ended with warning but not committed when last handle destroyed
+	{
+		Regiontransaction transaction3 = region.createRegiontransaction();
+		FieldConstant three = childFm.createFieldConstant(1, &valueOne);
+		EXPECT_EQ(RESULT_OK, three.setManaged(true));
+		EXPECT_EQ(eventCount, recordChange.eventCount);
+	}
+	EXPECT_EQ(eventCount + 1, recordChange.eventCount);
+	// region tree is no longer caching changes
+	FieldConstant five = childFm.createFieldConstant(1, &valueOne);
+	EXPECT_EQ(RESULT_OK, five.setManaged(true));
+	EXPECT_EQ(eventCount + 2, recordChange.eventCount);
+
+	Regiontransaction noTransaction = Region().createRegiontransaction();
+	EXPECT_FALSE(noTransaction.isValid());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, noTransaction.commit());
+	EXPECT_FALSE(noTransaction.isCommitted());
+	EXPECT_EQ(0.0, noTransaction.getTiming(Regiontransaction::TIMING_TOTAL));
+}
+
+// commit checks each field's sources once however many paths share them
+TEST(ZincRegiontransaction, commitSharedSourceFields)
+{
+	ZincTestSetupCpp zinc;
+
+	Region region = zinc.fm.getRegion();
+	const double valueOne = 1.0;
+	FieldConstant constant = zinc.fm.createFieldConstant(1, &valueOne);
+	EXPECT_TRUE(constant.isValid());
+	// each field adds the previous one to itself, giving 2^depth paths to constant
+	const int depth = 40;
+	Field field = constant;
+	for (int i = 0; i < depth; ++i)
+		field = zinc.fm.createFieldAdd(field, field);
+	EXPECT_TRUE(field.isValid());
+	Fieldmodulenotifier notifier = zinc.fm.createFieldmodulenotifier();
+	EXPECT_TRUE(notifier.isValid());
+	FieldmodulecallbackRecordChange recordChange;
+	EXPECT_EQ(RESULT_OK, notifier.setCallback(recordChange));
+
+	// unrelated change
+	Regiontransaction transaction = region.createRegiontransaction();
+	FieldConstant other = zinc.fm.createFieldConstant(1, &valueOne);
+	EXPECT_EQ(RESULT_OK, other.setManaged(true));
+	EXPECT_EQ(RESULT_OK, transaction.commit());
+	EXPECT_EQ(1, recordChange.eventCount);
+	EXPECT_EQ(Field::CHANGE_FLAG_NONE, recordChange.lastEvent.getFieldChangeFlags(field));
+
+	// change to shared source
+	Regiontransaction transaction2 = region.createRegiontransaction();
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	const double valueTwo = 2.0;
+	EXPECT_EQ(RESULT_OK, constant.assignReal(fieldcache, 1, &valueTwo));
+	EXPECT_EQ(RESULT_OK, transaction2.commit());
+	EXPECT_EQ(2, recordChange.eventCount);
+	EXPECT_NE(0, recordChange.lastEvent.getFieldChangeFlags(field) & Field::CHANGE_FLAG_RESULT);
+}
+
+TEST(ZincRegion, freezeConcurrentEvaluation)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(RESULT_OK, zinc.root_region.readFile(resourcePath("fieldmodule/cube.exformat").c_str()));
+	Region child = zinc.root_region.createChild("child");
+	EXPECT_TRUE(child.isValid());
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+	FieldMagnitude magnitude = zinc.fm.createFieldMagnitude(coordinates);
+	EXPECT_TRUE(magnitude.isValid());
+	Mesh mesh = zinc.fm.findMeshByDimension(3);
+	Element element = mesh.findElementByIdentifier(1);
+	EXPECT_TRUE(element.isValid());
+	Nodeset nodes = zinc.fm.findNodesetByFieldDomainType(Field::DOMAIN_TYPE_NODES);
+	Node node = nodes.findNodeByIdentifier(1);
+	EXPECT_TRUE(node.isValid());
+
+	const int pointCount = 2000;
+	// each thread gets its own element handle and field cache
+	auto evaluatePoints = [&](Element elementIn, double *values)
+	{
+		Fieldcache fieldcache = zinc.fm.createFieldcache();
+		for (int i = 0; i < pointCount; ++i)
+		{
+			const double xi[3] = { (i % 10)*0.1, ((i / 10) % 10)*0.1, (i / 100)*0.05 };
+			if ((RESULT_OK != fieldcache.setMeshLocation(elementIn, 3, xi)) ||
+				(RESULT_OK != magnitude.evaluateReal(fieldcache, 1, values + i)))
+				values[i] = -1.0;
+		}
+	};
+	std::vector<double> expectedValues(pointCount);
+	evaluatePoints(element, expectedValues.data());
+
+	EXPECT_FALSE(zinc.root_region.isFrozen());
+	EXPECT_EQ(RESULT_OK, zinc.root_region.beginFreeze());
+	EXPECT_TRUE(zinc.root_region.isFrozen());
+	EXPECT_TRUE(child.isFrozen());
+
+	const int threadCount = 4;
+	std::vector<std::vector<double> > threadValues(threadCount, std::vector<double>(pointCount));
+	std::vector<std::thread> threads;
+	for (int t = 0; t < threadCount; ++t)
+		threads.push_back(std::thread(evaluatePoints, element, threadValues[t].data()));
+	for (int t = 0; t < threadCount; ++t)
+		threads[t].join();
+	for (int t = 0; t < threadCount; ++t)
+		for (int i = 0; i < pointCount; ++i)
+			EXPECT_EQ(expectedValues[i], threadValues[t][i]);
+
+	// modifications fail while frozen
+	const double one = 1.0;
+	EXPECT_FALSE(zinc.fm.createFieldConstant(1, &one).isValid());
+	Fieldcache fieldcache = zinc.fm.createFieldcache();
+	EXPECT_EQ(RESULT_OK, fieldcache.setNode(node));
+	const double x[3] = { 1.0, 2.0, 3.0 };
+	EXPECT_EQ(RESULT_ERROR_IN_USE, coordinates.assignReal(fieldcache, 3, x));
+	Nodetemplate nodetemplate = nodes.createNodetemplate();
+	EXPECT_FALSE(nodes.createNode(100, nodetemplate).isValid());
+	EXPECT_EQ(RESULT_ERROR_IN_USE, nodes.destroyNode(node));
+	EXPECT_EQ(RESULT_ERROR_IN_USE, mesh.destroyElement(element));
+	EXPECT_FALSE(zinc.root_region.createChild("bob").isValid());
+	EXPECT_EQ(RESULT_ERROR_IN_USE, child.setName("bob"));
+	EXPECT_EQ(RESULT_ERROR_IN_USE, zinc.root_region.removeChild(child));
+
+	// frozen by ancestor only
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, child.endFreeze());
+	EXPECT_EQ(RESULT_OK, zinc.root_region.endFreeze());
+	EXPECT_FALSE(zinc.root_region.isFrozen());
+	EXPECT_FALSE(child.isFrozen());
+	EXPECT_EQ(RESULT_ERROR_ARGUMENT, zinc.root_region.endFreeze());
+
+	// cannot freeze while caching changes
+	EXPECT_EQ(RESULT_OK, zinc.root_region.beginChange());
+	EXPECT_EQ(RESULT_ERROR_IN_USE, zinc.root_region.beginFreeze());
+	EXPECT_EQ(RESULT_OK, zinc.root_region.endChange());
+
+	EXPECT_TRUE(zinc.fm.createFieldConstant(1, &one).isValid());
+	EXPECT_EQ(RESULT_OK, coordinates.assignReal(fieldcache, 3, x));
+	EXPECT_EQ(RESULT_OK, child.setName("bob"));
+}
@@ -15,13 +15,49 @@
 #include "cmlibs/zinc/fieldarithmeticoperators.hpp"
 #include "cmlibs/zinc/fieldconstant.hpp"
 #include "cmlibs/zinc/graphics.hpp"
+#include "cmlibs/zinc/material.hpp"
 #include "cmlibs/zinc/spectrum.hpp"
+#include "cmlibs/zinc/stream.hpp"
+#include "cmlibs/zinc/streamscene.hpp"
 
 #include "zinctestsetup.hpp"
 #include "zinctestsetupcpp.hpp"
 
 #include "test_resources.h"
 
+#include <cstdlib>
+#include <cstring>
+#include <string>
+#include <vector>
+
+namespace {
+
+/** Parse numbers from "name" : [ ... ] array in threejs JSON output. */
+std::vector<double> getThreejsArray(const std::string& json, const char *name)
+{
+	std::vector<double> values;
+	const std::string key = std::string("\"") + name + "\" : [";
+	const size_t start = json.find(key);
+	if (start == std::string::npos)
+		return values;
+	const char *text = json.c_str() + start + key.size();
+	while (true)
+	{
+		while ((*text == ',') || (*text == ' ') || (*text == '\t') || (*text == '\n'))
+			++text;
+		if ((*text == ']') || (*text == '\0'))
+			break;
+		char *end = nullptr;
+		values.push_back(strtod(text, &end));
+		if (end == text)
+			break;
+		text = end;
+	}
+	return values;
+}
+
+}
+
 
 TEST(cmzn_spectrummodule_api, valid_args)
 {
@@ -665,3 +701,130 @@ TEST(ZincSpectrum, autorange)
 	EXPECT_NEAR(-1.23, sc6.getRangeMinimum(), tolerance);
 	EXPECT_NEAR(4.56, sc6.getRangeMaximum(), tolerance);
 }
+
+// Test per-vertex colours converted from data by spectrum in one pass for export
+TEST(ZincSpectrum, exportVertexColours)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(OK, zinc.root_region.readFile(resourcePath("fieldmodule/cube.exformat").c_str()));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	Spectrummodule sm = zinc.context.getSpectrummodule();
+	Spectrum spectrum = sm.createSpectrum();
+	EXPECT_TRUE(spectrum.isValid());
+	EXPECT_EQ(OK, spectrum.setMaterialOverwrite(true));
+	const Spectrumcomponent::ColourMappingType colourMappingTypes[3] = {
+		Spectrumcomponent::COLOUR_MAPPING_TYPE_RED,
+		Spectrumcomponent::COLOUR_MAPPING_TYPE_GREEN,
+		Spectrumcomponent::COLOUR_MAPPING_TYPE_BLUE };
+	for (int c = 0; c < 3; ++c)
+	{
+		Spectrumcomponent component = spectrum.createSpectrumcomponent();
+		EXPECT_TRUE(component.isValid());
+		EXPECT_EQ(OK, component.setFieldComponent(c + 1));
+		EXPECT_EQ(OK, component.setColourMappingType(colourMappingTypes[c]));
+		EXPECT_EQ(OK, component.setRangeMinimum(0.0));
+		EXPECT_EQ(OK, component.setRangeMaximum(1.0));
+	}
+
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_EQ(OK, surfaces.setCoordinateField(coordinates));
+	EXPECT_EQ(OK, surfaces.setDataField(coordinates));
+	EXPECT_EQ(OK, surfaces.setSpectrum(spectrum));
+
+	StreaminformationScene si = zinc.scene.createStreaminformationScene();
+	EXPECT_TRUE(si.isValid());
+	EXPECT_EQ(OK, si.setIOFormat(StreaminformationScene::IO_FORMAT_THREEJS));
+	EXPECT_EQ(2, si.getNumberOfResourcesRequired());
+	StreamresourceMemory metadataResource = si.createStreamresourceMemory();
+	StreamresourceMemory surfacesResource = si.createStreamresourceMemory();
+	EXPECT_EQ(OK, zinc.scene.write(si));
+	const char *buffer = nullptr;
+	unsigned int size = 0;
+	EXPECT_EQ(OK, surfacesResource.getBuffer((const void**)&buffer, &size));
+	const std::string json(buffer, size);
+
+	const std::vector<double> vertices = getThreejsArray(json, "vertices");
+	const std::vector<double> colours = getThreejsArray(json, "colors");
+	EXPECT_LT(0U, colours.size());
+	EXPECT_EQ(vertices.size(), 3*colours.size());
+	// data is coordinates so red, green, blue are x, y, z
+	for (size_t i = 0; (i < colours.size()) && (3*i + 2 < vertices.size()); ++i)
+	{
+		const int hex = static_cast<int>(colours[i]);
+		const int rgb[3] = { (hex >> 16) & 255, (hex >> 8) & 255, hex & 255 };
+		for (int c = 0; c < 3; ++c)
+			EXPECT_NEAR(255.0*vertices[3*i + c], static_cast<double>(rgb[c]), 1.0);
+	}
+}
+
+// Test non-overwrite spectrum colours start from the material colour for
+// each vertex, including where components do not apply
+TEST(ZincSpectrum, exportNonOverwriteVertexColours)
+{
+	ZincTestSetupCpp zinc;
+
+	EXPECT_EQ(OK, zinc.root_region.readFile(resourcePath("fieldmodule/cube.exformat").c_str()));
+	Field coordinates = zinc.fm.findFieldByName("coordinates");
+	EXPECT_TRUE(coordinates.isValid());
+
+	Materialmodule mm = zinc.context.getMaterialmodule();
+	Material material = mm.createMaterial();
+	EXPECT_TRUE(material.isValid());
+	const double diffuse[3] = { 0.2, 0.4, 0.6 };
+	EXPECT_EQ(OK, material.setAttributeReal3(Material::ATTRIBUTE_DIFFUSE, diffuse));
+
+	Spectrummodule sm = zinc.context.getSpectrummodule();
+	Spectrum spectrum = sm.createSpectrum();
+	EXPECT_TRUE(spectrum.isValid());
+	EXPECT_EQ(OK, spectrum.setMaterialOverwrite(false));
+	// red from x over [0, 0.5], leaving material red above
+	Spectrumcomponent component = spectrum.createSpectrumcomponent();
+	EXPECT_TRUE(component.isValid());
+	EXPECT_EQ(OK, component.setFieldComponent(1));
+	EXPECT_EQ(OK, component.setColourMappingType(Spectrumcomponent::COLOUR_MAPPING_TYPE_RED));
+	EXPECT_EQ(OK, component.setRangeMinimum(0.0));
+	EXPECT_EQ(OK, component.setRangeMaximum(0.5));
+	EXPECT_EQ(OK, component.setExtendAbove(false));
+
+	GraphicsSurfaces surfaces = zinc.scene.createGraphicsSurfaces();
+	EXPECT_TRUE(surfaces.isValid());
+	EXPECT_EQ(OK, surfaces.setCoordinateField(coordinates));
+	EXPECT_EQ(OK, surfaces.setDataField(coordinates));
+	EXPECT_EQ(OK, surfaces.setMaterial(material));
+	EXPECT_EQ(OK, surfaces.setSpectrum(spectrum));
+
+	StreaminformationScene si = zinc.scene.createStreaminformationScene();
+	EXPECT_TRUE(si.isValid());
+	EXPECT_EQ(OK, si.setIOFormat(StreaminformationScene::IO_FORMAT_THREEJS));
+	EXPECT_EQ(2, si.getNumberOfResourcesRequired());
+	StreamresourceMemory metadataResource = si.createStreamresourceMemory();
+	StreamresourceMemory surfacesResource = si.createStreamresourceMemory();
+	EXPECT_EQ(OK, zinc.scene.write(si));
+	const char *buffer = nullptr;
+	unsigned int size = 0;
+	EXPECT_EQ(OK, surfacesResource.getBuffer((const void**)&buffer, &size));
+	const std::string json(buffer, size);
+
+	const std::vector<double> vertices = getThreejsArray(json, "vertices");
+	const std::vector<double> colours = getThreejsArray(json, "colors");
+	EXPECT_LT(0U, colours.size());
+	EXPECT_EQ(vertices.size(), 3*colours.size());
+	int aboveCount = 0;
+	for (size_t i = 0; (i < colours.size()) && (3*i + 2 < vertices.size()); ++i)
+	{
+		const int hex = static_cast<int>(colours[i]);
+		const int rgb[3] = { (hex >> 16) & 255, (hex >> 8) & 255, hex & 255 };
+		const double x = vertices[3*i];
+		const double red = (x <= 0.5) ? 2.0*x : diffuse[0];
+		if (x > 0.5)
+			++aboveCount;
+		EXPECT_NEAR(255.0*red, static_cast<double>(rgb[0]), 1.0);
+		EXPECT_NEAR(255.0*diffuse[1], static_cast<double>(rgb[1]), 1.0);
+		EXPECT_NEAR(255.0*diffuse[2], static_cast<double>(rgb[2]), 1.0);
+	}
+	EXPECT_LT(0, aboveCount);
+}